@@ -251,6 +251,20 @@
  */
 #define ESP_PANEL_DRIVERS_BACKLIGHT_COMPILE_UNUSED_DRIVERS     (1)
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////// Profiler Configurations ////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/**
+ * @brief Boot profiler
+ *
+ * Record the time spent in each stage of `Board::init()` and `Board::begin()`, including the stage callbacks, the LCD
+ * reset and each vendor initialization command. The records can be got by `Board::getBootProfile()` and printed by
+ * `Board::printBootProfile()`.
+ * Set to `1` to enable, `0` to disable. When disabled, the profiling code is not compiled.
+ */
+#define ESP_PANEL_DRIVERS_ENABLE_PROFILER               (0)
+#define ESP_PANEL_DRIVERS_PROFILER_MAX_RECORDS          (256)   // Records beyond it are dropped, ~32 bytes each
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 /////////////////////////////////////////////// File Version ///////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: CC0-1.0
  */
 
+#include <algorithm>
 #include "freertos/FreeRTOS.h"
 
 #include "esp_timer.h"
@@ -14,13 +15,19 @@
 
 using namespace esp_panel::drivers;
 
-#define LVGL_PORT_ENABLE_ROTATION_OPTIMIZED     (1)
 #define LVGL_PORT_BUFFER_NUM_MAX                (2)
 
 static SemaphoreHandle_t lvgl_mux = nullptr;                  // LVGL mutex
 static TaskHandle_t lvgl_task_handle = nullptr;
 static esp_timer_handle_t lvgl_tick_timer = NULL;
 static void *lvgl_buf[LVGL_PORT_BUFFER_NUM_MAX] = {};
+static int lvgl_buf_size = 0;                                 // Size of each buffer in pixels, `0` to use the default
+static int lvgl_buf_num = LVGL_PORT_BUFFER_NUM;
+static uint32_t lvgl_buf_caps = LVGL_PORT_BUFFER_MALLOC_CAPS;
+static esp_panel::utils::LatencyTracker *lvgl_latency_tracker = nullptr;
+static esp_panel::utils::FramePacer *lvgl_frame_pacer = nullptr;
+static esp_timer_handle_t lvgl_pacing_timer = nullptr;
+static SemaphoreHandle_t lvgl_pacing_sem = nullptr;
 
 #if LVGL_PORT_ROTATION_DEGREE != 0
 static void *get_next_frame_buffer(LCD *lcd)
@@ -39,339 +46,136 @@ static void *get_next_frame_buffer(LCD *lcd)
     return next_fb;
 }
 
-__attribute__((always_inline))
-static inline void copy_pixel_8bpp(uint8_t *to, const uint8_t *from)
-{
-    *to++ = *from++;
-}
+#if LV_COLOR_DEPTH == 32
+#define LVGL_PORT_PIXEL_FORMAT                  (esp_panel::utils::PixelFormat::ARGB8888)
+#elif (LV_COLOR_DEPTH == 16) && LV_COLOR_16_SWAP
+#define LVGL_PORT_PIXEL_FORMAT                  (esp_panel::utils::PixelFormat::RGB565_SWAP)
+#elif LV_COLOR_DEPTH == 16
+#define LVGL_PORT_PIXEL_FORMAT                  (esp_panel::utils::PixelFormat::RGB565)
+#else
+// Not supported by the blitter, only use the rotator
+#define LVGL_PORT_PIXEL_FORMAT                  (esp_panel::utils::PixelFormat::MAX)
+#endif
 
-__attribute__((always_inline))
-static inline void copy_pixel_16bpp(uint8_t *to, const uint8_t *from)
-{
-    *(uint16_t *)to++ = *(const uint16_t *)from++;
-}
+static esp_panel::utils::Rotator rotator;
+static std::shared_ptr<esp_panel::utils::Blitter> blitter = nullptr;
 
-__attribute__((always_inline))
-static inline void copy_pixel_24bpp(uint8_t *to, const uint8_t *from)
+/**
+ * @brief Configure the rotator for the LVGL buffer, only when the parameters are changed
+ */
+static inline void config_rotator(uint16_t w, uint16_t h, uint16_t rotate)
 {
-    *to++ = *from++;
-    *to++ = *from++;
-    *to++ = *from++;
-}
-
-#define _COPY_PIXEL(_bpp, to, from) copy_pixel_##_bpp##bpp(to, from)
-#define COPY_PIXEL(_bpp, to, from)  _COPY_PIXEL(_bpp, to, from)
-
-#define ROTATE_90_ALL_BPP() \
-    { \
-        to_bytes_per_line = h * to_bytes_per_piexl; \
-        to_index_const = (w - x_start - 1) * to_bytes_per_line; \
-        for (int from_y = y_start; from_y < y_end + 1; from_y++) { \
-            from_index = from_y * from_bytes_per_line + x_start * from_bytes_per_piexl; \
-            to_index = to_index_const + from_y * to_bytes_per_piexl; \
-            for (int from_x = x_start; from_x < x_end + 1; from_x++) { \
-                COPY_PIXEL(LV_COLOR_DEPTH, to + to_index, from + from_index); \
-                from_index += from_bytes_per_piexl; \
-                to_index -= to_bytes_per_line; \
-            } \
-        } \
+    auto &config = rotator.getConfig();
+    if ((config.width != w) || (config.height != h) || (config.degree != rotate)) {
+        rotator.setConfig({
+            .width = w,
+            .height = h,
+            .bytes_per_pixel = LV_COLOR_DEPTH >> 3,
+            .degree = rotate,
+        });
     }
+}
 
 /**
- * @brief Optimized transpose function for RGB565 format.
+ * @brief Rotate and copy the area `[x_start, x_end] x [y_start, y_end]` of the LVGL buffer to the frame buffer
  *
- * @note  ESP32-P4 1024x600 full-screen: 738ms -> 34ms
- * @note  ESP32-S3 480x480  full-screen: 380ms -> 37ms
+ * @note The copy runs on the PPA of ESP32-P4 if available, otherwise on the tiled kernels of the CPU
  */
-#define ROTATE_90_OPTIMIZED_16BPP(block_w, block_h) \
-    { \
-        for (int i = 0; i < h; i += block_h) { \
-            max_height = (i + block_h > h) ? h : (i + block_h); \
-            for (int j = 0; j < w; j += block_w) { \
-                max_width = (j + block_w > w) ? w : (j + block_w); \
-                start_y = w - 1 - j;   \
-                for (int x = i; x < max_height; x++) { \
-                    from_next = (uint16_t *)from + x * w; \
-                    for (int y = j, mirrored_y = start_y; y < max_width; y += 4, mirrored_y -= 4) { \
-                        ((uint16_t *)to)[(mirrored_y) * h + x] = *((uint32_t *)(from_next + y)) & 0xFFFF; \
-                        ((uint16_t *)to)[(mirrored_y - 1) * h + x] = (*((uint32_t *)(from_next + y)) >> 16) & 0xFFFF; \
-                        ((uint16_t *)to)[(mirrored_y - 2) * h + x] = *((uint32_t *)(from_next + y + 2)) & 0xFFFF; \
-                        ((uint16_t *)to)[(mirrored_y - 3) * h + x] = (*((uint32_t *)(from_next + y + 2)) >> 16) & 0xFFFF; \
-                    } \
-                } \
-            } \
-        } \
-    }
-
-#define ROTATE_180_ALL_BPP() \
-    { \
-        to_bytes_per_line = w * to_bytes_per_piexl; \
-        to_index_const = (h - 1) * to_bytes_per_line + (w - x_start - 1) * to_bytes_per_piexl; \
-        for (int from_y = y_start; from_y < y_end + 1; from_y++) { \
-            from_index = from_y * from_bytes_per_line + x_start * from_bytes_per_piexl; \
-            to_index = to_index_const - from_y * to_bytes_per_line; \
-            for (int from_x = x_start; from_x < x_end + 1; from_x++) { \
-                COPY_PIXEL(LV_COLOR_DEPTH, to + to_index, from + from_index); \
-                from_index += from_bytes_per_piexl; \
-                to_index -= to_bytes_per_piexl; \
-            } \
-        } \
-    }
-
-#define ROTATE_270_OPTIMIZED_16BPP(block_w, block_h) \
-    { \
-        for (int i = 0; i < h; i += block_h) { \
-            max_height = i + block_h > h ? h : i + block_h; \
-            for (int j = 0; j < w; j += block_w) { \
-                max_width = j + block_w > w ? w : j + block_w; \
-                for (int x = i; x < max_height; x++) { \
-                    from_next = (uint16_t *)from + x * w; \
-                    for (int y = j; y < max_width; y += 4) { \
-                        ((uint16_t *)to)[y * h + (h - 1 - x)] = *((uint32_t *)(from_next + y)) & 0xFFFF; \
-                        ((uint16_t *)to)[(y + 1) * h + (h - 1 - x)] = (*((uint32_t *)(from_next + y)) >> 16) & 0xFFFF; \
-                        ((uint16_t *)to)[(y + 2) * h + (h - 1 - x)] = *((uint32_t *)(from_next + y + 2)) & 0xFFFF; \
-                        ((uint16_t *)to)[(y + 3) * h + (h - 1 - x)] = (*((uint32_t *)(from_next + y + 2)) >> 16) & 0xFFFF; \
-                    } \
-                } \
-            } \
-        } \
-    }
-
-#define ROTATE_270_ALL_BPP() \
-    { \
-        to_bytes_per_line = h * to_bytes_per_piexl; \
-        from_index_const = x_start * from_bytes_per_piexl; \
-        to_index_const = x_start * to_bytes_per_line + (h - 1) * to_bytes_per_piexl; \
-        for (int from_y = y_start; from_y < y_end + 1; from_y++) { \
-            from_index = from_y * from_bytes_per_line + from_index_const; \
-            to_index = to_index_const - from_y * to_bytes_per_piexl; \
-            for (int from_x = x_start; from_x < x_end + 1; from_x++) { \
-                COPY_PIXEL(LV_COLOR_DEPTH, to + to_index, from + from_index); \
-                from_index += from_bytes_per_piexl; \
-                to_index += to_bytes_per_line; \
-            } \
-        } \
-    }
-
-__attribute__((always_inline))
-IRAM_ATTR static inline void rotate_copy_pixel(
+static inline void rotate_copy_pixel(
     const uint8_t *from, uint8_t *to, uint16_t x_start, uint16_t y_start, uint16_t x_end, uint16_t y_end, uint16_t w,
     uint16_t h, uint16_t rotate
 )
 {
-    int from_bytes_per_piexl = sizeof(lv_color_t);
-    int from_bytes_per_line = w * from_bytes_per_piexl;
-    int from_index = 0;
+    using Blitter = esp_panel::utils::Blitter;
 
-    int to_bytes_per_piexl = LV_COLOR_DEPTH >> 3;
-    int to_bytes_per_line;
-    int to_index = 0;
-    int to_index_const = 0;
-
-#if (LV_COLOR_DEPTH == 16) && LVGL_PORT_ENABLE_ROTATION_OPTIMIZED
-    int max_height = 0;
-    int max_width = 0;
-    int start_y = 0;
-    uint16_t *from_next = NULL;
-#endif
-
-    // uint32_t time = esp_log_timestamp();
-    switch (rotate) {
-    case 90:
-#if (LV_COLOR_DEPTH == 16) && LVGL_PORT_ENABLE_ROTATION_OPTIMIZED
-        ROTATE_90_OPTIMIZED_16BPP(32, 256);
-#else
-        ROTATE_90_ALL_BPP();
-#endif
-        break;
-    case 180:
-        ROTATE_180_ALL_BPP();
-        break;
-    case 270:
-#if (LV_COLOR_DEPTH == 16) && LVGL_PORT_ENABLE_ROTATION_OPTIMIZED
-        ROTATE_270_OPTIMIZED_16BPP(32, 256);
-#else
-        int from_index_const = 0;
-        ROTATE_270_ALL_BPP();
-#endif
-        break;
-    default:
-        break;
+    config_rotator(w, h, rotate);
+    Blitter::Rect rect = {x_start, y_start, x_end - x_start + 1, y_end - y_start + 1};
+    if (blitter == nullptr) {
+        rotator.copy(from, to, rect.x, rect.y, rect.width, rect.height);
+        return;
     }
-    // ESP_LOGI(TAG, "rotate: end, time used:%d", (int)(esp_log_timestamp() - time));
+
+    int x = rect.x;
+    int y = rect.y;
+    int width = rect.width;
+    int height = rect.height;
+    rotator.rotateArea(x, y, width, height);
+    Blitter::Surface src = {
+        .data = const_cast<uint8_t *>(from), .width = w, .height = h, .format = LVGL_PORT_PIXEL_FORMAT
+    };
+    Blitter::Surface dst = {
+        .data = to, .width = rotator.getDestWidth(), .height = rotator.getDestHeight(), .format = LVGL_PORT_PIXEL_FORMAT
+    };
+    blitter->rotate(src, rect, dst, x, y, rotate);
 }
 #endif /* LVGL_PORT_ROTATION_DEGREE */
 
 #if LVGL_PORT_AVOID_TEAR
 #if LVGL_PORT_DIRECT_MODE
 #if LVGL_PORT_ROTATION_DEGREE != 0
-typedef struct {
-    uint16_t inv_p;
-    uint8_t inv_area_joined[LV_INV_BUF_SIZE];
-    lv_area_t inv_areas[LV_INV_BUF_SIZE];
-} lv_port_dirty_area_t;
-
-static lv_port_dirty_area_t dirty_area;
-
-static void flush_dirty_save(lv_port_dirty_area_t *dirty_area)
-{
-    lv_disp_t *disp = _lv_refr_get_disp_refreshing();
-    dirty_area->inv_p = disp->inv_p;
-    for (int i = 0; i < disp->inv_p; i++) {
-        dirty_area->inv_area_joined[i] = disp->inv_area_joined[i];
-        dirty_area->inv_areas[i] = disp->inv_areas[i];
-    }
-}
-
-typedef enum {
-    FLUSH_STATUS_PART,
-    FLUSH_STATUS_FULL
-} lv_port_flush_status_t;
-
-typedef enum {
-    FLUSH_PROBE_PART_COPY,
-    FLUSH_PROBE_SKIP_COPY,
-    FLUSH_PROBE_FULL_COPY,
-} lv_port_flush_probe_t;
-
 /**
- * @brief Probe dirty area to copy
+ * @brief Bring the next frame buffer up to date, then rotate and copy the dirty areas into it
  *
  * @note This function is used to avoid tearing effect, and only work with LVGL direct-mode.
+ * @note Only the tiles which are drawn into the other frame buffer since the last time are copied from it
  */
-static lv_port_flush_probe_t flush_copy_probe(lv_disp_drv_t *drv)
-{
-    static lv_port_flush_status_t prev_status = FLUSH_STATUS_PART;
-    lv_port_flush_status_t cur_status;
-    lv_port_flush_probe_t probe_result;
-    lv_disp_t *disp_refr = _lv_refr_get_disp_refreshing();
-
-    uint32_t flush_ver = 0;
-    uint32_t flush_hor = 0;
-    for (int i = 0; i < disp_refr->inv_p; i++) {
-        if (disp_refr->inv_area_joined[i] == 0) {
-            flush_ver = (disp_refr->inv_areas[i].y2 + 1 - disp_refr->inv_areas[i].y1);
-            flush_hor = (disp_refr->inv_areas[i].x2 + 1 - disp_refr->inv_areas[i].x1);
-            break;
-        }
-    }
-    /* Check if the current full screen refreshes */
-    cur_status = ((flush_ver == drv->ver_res) && (flush_hor == drv->hor_res)) ? (FLUSH_STATUS_FULL) : (FLUSH_STATUS_PART);
+static void flush_dirty_sync(LCD *lcd, void *next_fb, lv_color_t *color_map)
+{
+    static esp_panel::utils::FrameBufferSync fb_sync;
+    lv_disp_t *disp = _lv_refr_get_disp_refreshing();
 
-    if (prev_status == FLUSH_STATUS_FULL) {
-        if ((cur_status == FLUSH_STATUS_PART)) {
-            probe_result = FLUSH_PROBE_FULL_COPY;
-        } else {
-            probe_result = FLUSH_PROBE_SKIP_COPY;
-        }
-    } else {
-        probe_result = FLUSH_PROBE_PART_COPY;
+    if (fb_sync.getConfig().width == 0) {
+        fb_sync.setConfig({
+            .width = lcd->getFrameWidth(),
+            .height = lcd->getFrameHeight(),
+            .bytes_per_pixel = LV_COLOR_DEPTH >> 3,
+            .buffer_num = 2,
+            .buffers = {(uint8_t *)lcd->getFrameBufferByIndex(0), (uint8_t *)lcd->getFrameBufferByIndex(1)},
+        });
     }
-    prev_status = cur_status;
+    config_rotator(LV_HOR_RES, LV_VER_RES, LVGL_PORT_ROTATION_DEGREE);
 
-    return probe_result;
-}
-
-static inline void *flush_get_next_buf(LCD *lcd)
-{
-    return get_next_frame_buffer(lcd);
-}
-
-/**
- * @brief Copy dirty area
- *
- * @note This function is used to avoid tearing effect, and only work with LVGL direct-mode.
- */
-static void flush_dirty_copy(void *dst, void *src, lv_port_dirty_area_t *dirty_area)
-{
-    lv_coord_t x_start, x_end, y_start, y_end;
-    for (int i = 0; i < dirty_area->inv_p; i++) {
+    fb_sync.beginFrame((next_fb == lcd->getFrameBufferByIndex(0)) ? 0 : 1);
+    for (int i = 0; i < disp->inv_p; i++) {
         /* Refresh the unjoined areas*/
-        if (dirty_area->inv_area_joined[i] == 0) {
-            x_start = dirty_area->inv_areas[i].x1;
-            x_end = dirty_area->inv_areas[i].x2;
-            y_start = dirty_area->inv_areas[i].y1;
-            y_end = dirty_area->inv_areas[i].y2;
+        if (disp->inv_area_joined[i] == 0) {
+            int x = disp->inv_areas[i].x1;
+            int y = disp->inv_areas[i].y1;
+            int w = lv_area_get_width(&disp->inv_areas[i]);
+            int h = lv_area_get_height(&disp->inv_areas[i]);
+            rotator.rotateArea(x, y, w, h);
+            fb_sync.addDirtyArea(x, y, w, h);
+        }
+    }
+    fb_sync.syncFrame();
 
+    for (int i = 0; i < disp->inv_p; i++) {
+        if (disp->inv_area_joined[i] == 0) {
             rotate_copy_pixel(
-                (uint8_t *)src, (uint8_t *)dst, x_start, y_start, x_end, y_end, LV_HOR_RES, LV_VER_RES,
-                LVGL_PORT_ROTATION_DEGREE
+                (uint8_t *)color_map, (uint8_t *)next_fb, disp->inv_areas[i].x1, disp->inv_areas[i].y1,
+                disp->inv_areas[i].x2, disp->inv_areas[i].y2, LV_HOR_RES, LV_VER_RES, LVGL_PORT_ROTATION_DEGREE
             );
         }
     }
+    fb_sync.endFrame();
 }
 
 static void flush_callback(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_map)
 {
     LCD *lcd = (LCD *)drv->user_data;
-    const int offsetx1 = area->x1;
-    const int offsetx2 = area->x2;
-    const int offsety1 = area->y1;
-    const int offsety2 = area->y2;
-    void *next_fb = NULL;
-    lv_port_flush_probe_t probe_result = FLUSH_PROBE_PART_COPY;
-    lv_disp_t *disp = lv_disp_get_default();
 
     /* Action after last area refresh */
     if (lv_disp_flush_is_last(drv)) {
-        /* Check if the `full_refresh` flag has been triggered */
-        if (drv->full_refresh) {
-            /* Reset flag */
-            drv->full_refresh = 0;
-
-            // Rotate and copy data from the whole screen LVGL's buffer to the next frame buffer
-            next_fb = flush_get_next_buf(lcd);
-            rotate_copy_pixel(
-                (uint8_t *)color_map, (uint8_t *)next_fb, offsetx1, offsety1, offsetx2, offsety2,
-                LV_HOR_RES, LV_VER_RES, LVGL_PORT_ROTATION_DEGREE
-            );
+        /* Update the dirty areas of the next frame buffer */
+        void *next_fb = get_next_frame_buffer(lcd);
+        flush_dirty_sync(lcd, next_fb, color_map);
 
-            /* Switch the current LCD frame buffer to `next_fb` */
-            lcd->switchFrameBufferTo(next_fb);
+        /* Switch the current LCD frame buffer to `next_fb` */
+        lcd->switchFrameBufferTo(next_fb);
 
-            /* Waiting for the current frame buffer to complete transmission */
-            ulTaskNotifyValueClear(NULL, ULONG_MAX);
-            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-
-            /* Synchronously update the dirty area for another frame buffer */
-            flush_dirty_copy(flush_get_next_buf(lcd), color_map, &dirty_area);
-            flush_get_next_buf(lcd);
-        } else {
-            /* Probe the copy method for the current dirty area */
-            probe_result = flush_copy_probe(drv);
-
-            if (probe_result == FLUSH_PROBE_FULL_COPY) {
-                /* Save current dirty area for next frame buffer */
-                flush_dirty_save(&dirty_area);
-
-                /* Set LVGL full-refresh flag and set flush ready in advance */
-                drv->full_refresh = 1;
-                disp->rendering_in_progress = false;
-                lv_disp_flush_ready(drv);
-
-                /* Force to refresh whole screen, and will invoke `flush_callback` recursively */
-                lv_refr_now(_lv_refr_get_disp_refreshing());
-            } else {
-                /* Update current dirty area for next frame buffer */
-                next_fb = flush_get_next_buf(lcd);
-                flush_dirty_save(&dirty_area);
-                flush_dirty_copy(next_fb, color_map, &dirty_area);
-
-                /* Switch the current LCD frame buffer to `next_fb` */
-                lcd->switchFrameBufferTo(next_fb);
-
-                /* Waiting for the current frame buffer to complete transmission */
-                ulTaskNotifyValueClear(NULL, ULONG_MAX);
-                ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-
-                if (probe_result == FLUSH_PROBE_PART_COPY) {
-                    /* Synchronously update the dirty area for another frame buffer */
-                    flush_dirty_save(&dirty_area);
-                    flush_dirty_copy(flush_get_next_buf(lcd), color_map, &dirty_area);
-                    flush_get_next_buf(lcd);
-                }
-            }
-        }
+        /* Waiting for the current frame buffer to complete transmission */
+        ulTaskNotifyValueClear(NULL, ULONG_MAX);
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
     }
 
     lv_disp_flush_ready(drv);
@@ -569,9 +373,9 @@ static lv_disp_t *display_init(LCD *lcd)
     ESP_UTILS_LOGD("Malloc memory for LVGL buffer");
 #if !LVGL_PORT_AVOID_TEAR
     // Avoid tearing function is disabled
-    buffer_size = lcd_width * LVGL_PORT_BUFFER_SIZE_HEIGHT;
-    for (int i = 0; (i < LVGL_PORT_BUFFER_NUM) && (i < LVGL_PORT_BUFFER_NUM_MAX); i++) {
-        lvgl_buf[i] = heap_caps_malloc(buffer_size * sizeof(lv_color_t), LVGL_PORT_BUFFER_MALLOC_CAPS);
+    buffer_size = (lvgl_buf_size > 0) ? lvgl_buf_size : (lcd_width * LVGL_PORT_BUFFER_SIZE_HEIGHT);
+    for (int i = 0; (i < lvgl_buf_num) && (i < LVGL_PORT_BUFFER_NUM_MAX); i++) {
+        lvgl_buf[i] = heap_caps_malloc(buffer_size * sizeof(lv_color_t), lvgl_buf_caps);
         assert(lvgl_buf[i]);
         ESP_UTILS_LOGD("Buffer[%d] address: %p, size: %d", i, lvgl_buf[i], buffer_size * sizeof(lv_color_t));
     }
@@ -727,12 +531,42 @@ static bool tick_deinit(void)
 }
 #endif
 
+static void frame_pacing_timer_callback(void *arg)
+{
+    xSemaphoreGive(lvgl_pacing_sem);
+}
+
+/**
+ * Sleep until the next frame should be rendered. The earliest start is decided by the LVGL timers, then it's moved
+ * as late as possible before the next vsync by the pacer
+ */
+static void frame_pacing_delay(uint32_t render_start_us, uint32_t task_delay_ms)
+{
+    static esp_panel::utils::FramePacer::Plan plan = {};
+
+    uint32_t now_us = esp_timer_get_time();
+    lvgl_frame_pacer->notifyRender(plan, render_start_us, now_us);
+    plan = lvgl_frame_pacer->schedule(now_us + task_delay_ms * 1000);
+    if (!plan.is_paced) {
+        vTaskDelay(pdMS_TO_TICKS(task_delay_ms));
+        return;
+    }
+
+    int32_t wait_us = static_cast<int32_t>(plan.start_us - static_cast<uint32_t>(esp_timer_get_time()));
+    if ((wait_us > 0) && (esp_timer_start_once(lvgl_pacing_timer, wait_us) == ESP_OK)) {
+        xSemaphoreTake(lvgl_pacing_sem, portMAX_DELAY);
+    } else {
+        vTaskDelay(pdMS_TO_TICKS(LVGL_PORT_TASK_MIN_DELAY_MS));
+    }
+}
+
 static void lvgl_port_task(void *arg)
 {
     ESP_UTILS_LOGD("Starting LVGL task");
 
     uint32_t task_delay_ms = LVGL_PORT_TASK_MAX_DELAY_MS;
     while (1) {
+        uint32_t render_start_us = esp_timer_get_time();
         if (lvgl_port_lock(-1)) {
             task_delay_ms = lv_timer_handler();
             lvgl_port_unlock();
@@ -742,7 +576,11 @@ static void lvgl_port_task(void *arg)
         } else if (task_delay_ms < LVGL_PORT_TASK_MIN_DELAY_MS) {
             task_delay_ms = LVGL_PORT_TASK_MIN_DELAY_MS;
         }
-        vTaskDelay(pdMS_TO_TICKS(task_delay_ms));
+        if (lvgl_frame_pacer != nullptr) {
+            frame_pacing_delay(render_start_us, task_delay_ms);
+        } else {
+            vTaskDelay(pdMS_TO_TICKS(task_delay_ms));
+        }
     }
 }
 
@@ -755,6 +593,73 @@ IRAM_ATTR bool onDrawBitmapFinishCallback(void *user_data)
     return false;
 }
 
+bool lvgl_port_config_memory_plan(const esp_panel::utils::MemoryPlanner::Plan &plan)
+{
+    ESP_UTILS_CHECK_FALSE_RETURN(lvgl_mux == nullptr, false, "Should be called before `lvgl_port_init()`");
+
+#if !LVGL_PORT_AVOID_TEAR
+    ESP_UTILS_CHECK_FALSE_RETURN(plan.draw_buffer_size_px > 0, false, "Plan has no draw buffer");
+    ESP_UTILS_LOGI(
+        "Use memory plan: buffer size(%d), num(%d), in PSRAM(%d), PSRAM headroom(%d%%)", plan.draw_buffer_size_px,
+        plan.draw_buffer_num, plan.draw_buffer_in_psram, plan.headroom_percent
+    );
+    lvgl_buf_size = plan.draw_buffer_size_px;
+    lvgl_buf_num = std::min(std::max(plan.draw_buffer_num, 1), LVGL_PORT_BUFFER_NUM_MAX);
+    lvgl_buf_caps = plan.draw_buffer_in_psram ? MALLOC_CAP_SPIRAM : (MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+#else
+    // The frame buffers are used as the draw buffers, they are planned by the bus
+    ESP_UTILS_LOGI("Use memory plan: PSRAM headroom(%d%%)", plan.headroom_percent);
+#endif
+
+    return true;
+}
+
+bool lvgl_port_attach_latency_tracker(esp_panel::utils::LatencyTracker *tracker)
+{
+    ESP_UTILS_CHECK_FALSE_RETURN(lvgl_mux == nullptr, false, "Should be called before `lvgl_port_init()`");
+
+    lvgl_latency_tracker = tracker;
+
+    return true;
+}
+
+bool lvgl_port_report_latency(void)
+{
+    ESP_UTILS_CHECK_NULL_RETURN(lvgl_latency_tracker, false, "Latency tracker is not attached");
+
+    using Stage = esp_panel::utils::LatencyTracker::Stage;
+    char line[128];
+    for (int i = 0; i < static_cast<int>(Stage::MAX); i++) {
+        lvgl_latency_tracker->formatStage(static_cast<Stage>(i), line, sizeof(line));
+        ESP_UTILS_LOGI("%s", line);
+    }
+    ESP_UTILS_LOGI("Dropped frames: %d", static_cast<int>(lvgl_latency_tracker->getDroppedNum()));
+
+    return true;
+}
+
+bool lvgl_port_attach_frame_pacer(esp_panel::utils::FramePacer *pacer)
+{
+    ESP_UTILS_CHECK_FALSE_RETURN(lvgl_mux == nullptr, false, "Should be called before `lvgl_port_init()`");
+
+    lvgl_frame_pacer = pacer;
+
+    return true;
+}
+
+bool lvgl_port_report_frame_pacing(void)
+{
+    ESP_UTILS_CHECK_NULL_RETURN(lvgl_frame_pacer, false, "Frame pacer is not attached");
+
+    ESP_UTILS_LOGI(
+        "Frame pacing: period(%d us), render(%d us), missed(%d/%d)", static_cast<int>(lvgl_frame_pacer->getPeriodUs()),
+        static_cast<int>(lvgl_frame_pacer->getRenderEstimateUs()), static_cast<int>(lvgl_frame_pacer->getMissedNum()),
+        static_cast<int>(lvgl_frame_pacer->getFrameNum())
+    );
+
+    return true;
+}
+
 bool lvgl_port_init(LCD *lcd, Touch *tp)
 {
     ESP_UTILS_CHECK_FALSE_RETURN(lcd != nullptr, false, "Invalid LCD device");
@@ -773,6 +678,14 @@ bool lvgl_port_init(LCD *lcd, Touch *tp)
     lv_disp_t *disp = nullptr;
     lv_indev_t *indev = nullptr;
 
+#if LVGL_PORT_ROTATION_DEGREE != 0
+    if (LVGL_PORT_PIXEL_FORMAT != esp_panel::utils::PixelFormat::MAX) {
+        ESP_UTILS_LOGD("Create blitter for rotation");
+        blitter = esp_panel::utils::createBlitter();
+        ESP_UTILS_CHECK_NULL_RETURN(blitter, false, "Create blitter failed");
+    }
+#endif
+
     lv_init();
 #if !LV_TICK_CUSTOM
     ESP_UTILS_CHECK_FALSE_RETURN(tick_init(), false, "Initialize LVGL tick failed");
@@ -789,6 +702,31 @@ bool lvgl_port_init(LCD *lcd, Touch *tp)
         ESP_UTILS_LOGD("Attach refresh finish callback to LCD");
         lcd->attachDrawBitmapFinishCallback(onDrawBitmapFinishCallback, (void *)disp->driver);
     }
+    if (lvgl_latency_tracker != nullptr) {
+        ESP_UTILS_LOGD("Attach latency tracker to LCD and touch");
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            lcd->attachLatencyTracker(lvgl_latency_tracker), false, "Attach latency tracker to LCD failed"
+        );
+        if (tp != nullptr) {
+            tp->attachLatencyTracker(lvgl_latency_tracker);
+        }
+    }
+
+    if (lvgl_frame_pacer != nullptr) {
+        ESP_UTILS_LOGD("Attach frame pacer to LCD");
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            lcd->attachFramePacer(lvgl_frame_pacer), false, "Attach frame pacer to LCD failed"
+        );
+        lvgl_pacing_sem = xSemaphoreCreateBinary();
+        ESP_UTILS_CHECK_NULL_RETURN(lvgl_pacing_sem, false, "Create frame pacing semaphore failed");
+        const esp_timer_create_args_t pacing_timer_args = {
+            .callback = &frame_pacing_timer_callback,
+            .name = "LVGL pacing"
+        };
+        ESP_UTILS_CHECK_ERROR_RETURN(
+            esp_timer_create(&pacing_timer_args, &lvgl_pacing_timer), false, "Create frame pacing timer failed"
+        );
+    }
 
     if (tp != nullptr) {
         ESP_UTILS_LOGD("Initialize LVGL input driver");
@@ -863,17 +801,29 @@ bool lvgl_port_deinit(void)
     ESP_UTILS_LOGW("LVGL memory is custom, `lv_deinit()` will not work");
 #endif
 #if !LVGL_PORT_AVOID_TEAR
-    for (int i = 0; i < LVGL_PORT_BUFFER_NUM; i++) {
+    for (int i = 0; i < LVGL_PORT_BUFFER_NUM_MAX; i++) {
         if (lvgl_buf[i] != nullptr) {
             free(lvgl_buf[i]);
             lvgl_buf[i] = nullptr;
         }
     }
 #endif
+    if (lvgl_pacing_timer != nullptr) {
+        esp_timer_stop(lvgl_pacing_timer);
+        esp_timer_delete(lvgl_pacing_timer);
+        lvgl_pacing_timer = nullptr;
+    }
+    if (lvgl_pacing_sem != nullptr) {
+        vSemaphoreDelete(lvgl_pacing_sem);
+        lvgl_pacing_sem = nullptr;
+    }
     if (lvgl_mux != nullptr) {
         vSemaphoreDelete(lvgl_mux);
         lvgl_mux = nullptr;
     }
+#if LVGL_PORT_ROTATION_DEGREE != 0
+    blitter = nullptr;
+#endif
 
     return true;
 }
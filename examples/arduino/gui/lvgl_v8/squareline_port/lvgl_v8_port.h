@@ -134,6 +134,53 @@
 extern "C" {
 #endif
 
+/**
+ * @brief Configure the LVGL buffers by a memory plan instead of the `LVGL_PORT_BUFFER_*` macros. This function should
+ *        be called before `lvgl_port_init()`.
+ *
+ *  (The plan is useless if the avoid tearing function is enabled, since the frame buffers are used)
+ *
+ * @param plan The plan from `esp_panel::utils::MemoryPlanner`
+ *
+ * @return true if success, otherwise false
+ */
+bool lvgl_port_config_memory_plan(const esp_panel::utils::MemoryPlanner::Plan &plan);
+
+/**
+ * @brief Attach a tracker of the touch-to-photon latency, which is attached to the LCD and touch panel by
+ *        `lvgl_port_init()`. This function should be called before `lvgl_port_init()`.
+ *
+ * @param tracker The pointer to the tracker, it should be valid until the LCD and touch panel are deleted
+ *
+ * @return true if success, otherwise false
+ */
+bool lvgl_port_attach_latency_tracker(esp_panel::utils::LatencyTracker *tracker);
+
+/**
+ * @brief Print the latency histograms of the attached tracker, e.g. periodically or after a touch test.
+ *
+ * @return true if success, otherwise false
+ */
+bool lvgl_port_report_latency(void);
+
+/**
+ * @brief Attach a pacer of the frame rendering, which is attached to the LCD by `lvgl_port_init()`. The LVGL task
+ *        then starts each frame as late as possible before the next vsync instead of sleeping for a fixed delay.
+ *        This function should be called before `lvgl_port_init()`.
+ *
+ * @param pacer The pointer to the pacer, it should be valid until the LCD is deleted
+ *
+ * @return true if success, otherwise false
+ */
+bool lvgl_port_attach_frame_pacer(esp_panel::utils::FramePacer *pacer);
+
+/**
+ * @brief Print the refresh period, the predicted render time and the missed deadlines of the attached pacer.
+ *
+ * @return true if success, otherwise false
+ */
+bool lvgl_port_report_frame_pacing(void);
+
 /**
  * @brief Porting LVGL with LCD and touch panel. This function should be called after the initialization of the LCD and touch panel.
  *
@@ -12,6 +12,9 @@
 #include "lv_demos.h"
 
 #define EXAMPLE_LCD_USE_EXTERNAL_INIT_CMD   (0)
+#define EXAMPLE_SRAM_RESERVED_SIZE          (64 * 1024) // SRAM kept for the application when planning the buffers
+#define EXAMPLE_LATENCY_REPORT_INTERVAL_MS  (0)         // Interval to print the touch-to-photon latency, `0` to disable
+#define EXAMPLE_ENABLE_FRAME_PACING         (0)         // Pace the LVGL rendering by the vsync of the LCD
 
 using namespace esp_panel::drivers;
 using namespace esp_panel::board;
@@ -26,6 +29,12 @@ static const esp_panel_lcd_vendor_init_cmd_t external_init_cmd[] = {
     // ...
 };
 #endif // EXAMPLE_LCD_USE_EXTERNAL_INIT_CMD
+#if EXAMPLE_LATENCY_REPORT_INTERVAL_MS > 0
+static esp_panel::utils::LatencyTracker latency_tracker;
+#endif
+#if EXAMPLE_ENABLE_FRAME_PACING
+static esp_panel::utils::FramePacer frame_pacer;
+#endif
 
 extern "C" void app_main()
 {
@@ -40,19 +49,41 @@ extern "C" void app_main()
         auto lcd = board->getLCD();
         // When avoid tearing function is enabled, the frame buffer number should be set in the board driver
         lcd->configFrameBufferNumber(LVGL_PORT_DISP_BUFFER_NUM);
-#   if ESP_PANEL_DRIVERS_BUS_ENABLE_RGB && CONFIG_IDF_TARGET_ESP32S3
-        auto lcd_bus = lcd->getBus();
+    }
+#endif // LVGL_PORT_AVOID_TEARING_MODE
+
+#if ESP_PANEL_DRIVERS_BUS_ENABLE_RGB && CONFIG_IDF_TARGET_ESP32S3
+    {
+        auto lcd_bus = board->getLCD()->getBus();
         /**
-         * As the anti-tearing feature typically consumes more PSRAM bandwidth, for the ESP32-S3, we need to utilize the
-         * "bounce buffer" functionality to enhance the RGB data bandwidth.
-         * This feature will consume `bounce_buffer_size * bytes_per_pixel * 2` of SRAM memory.
+         * The RGB bus reads the frame buffers in PSRAM continuously while LVGL writes them, so plan the frame buffers,
+         * the "bounce buffer" and the LVGL buffers together to keep enough PSRAM bandwidth.
+         * The bounce buffer will consume `bounce_buffer_size * bytes_per_pixel * 2` of SRAM memory.
          */
         if (lcd_bus->getBasicAttributes().type == ESP_PANEL_BUS_TYPE_RGB) {
-            static_cast<BusRGB *>(lcd_bus)->configRGB_BounceBufferSize(lcd->getFrameWidth() * 10);
+            auto rgb_bus = static_cast<BusRGB *>(lcd_bus);
+            esp_panel::utils::MemoryPlanner::Config plan_config = {};
+            rgb_bus->getMemoryPlannerConfig(plan_config);
+#if LVGL_PORT_AVOID_TEAR
+            plan_config.draw_buffer_lines = 0;
+#else
+            plan_config.draw_buffer_lines = LVGL_PORT_BUFFER_SIZE_HEIGHT;
+            plan_config.draw_buffer_num = LVGL_PORT_BUFFER_NUM;
+#endif
+            plan_config.psram_free_size = heap_caps_get_largest_free_block(MALLOC_CAP_SPIRAM);
+            plan_config.sram_free_size = static_cast<int>(heap_caps_get_free_size(MALLOC_CAP_INTERNAL)) -
+                                         EXAMPLE_SRAM_RESERVED_SIZE;
+            esp_panel::utils::MemoryPlanner planner(plan_config);
+            auto &plan = planner.getPlan();
+            ESP_LOGI(
+                TAG, "Memory plan: feasible(%d), PSRAM headroom(%d%%), max pclk(%d Hz)", plan.is_feasible,
+                plan.headroom_percent, plan.pclk_hz_max
+            );
+            ESP_UTILS_CHECK_FALSE_EXIT(rgb_bus->configRGB_MemoryPlan(plan), "Config memory plan failed");
+            ESP_UTILS_CHECK_FALSE_EXIT(lvgl_port_config_memory_plan(plan), "Config LVGL memory plan failed");
         }
-#   endif
     }
-#endif // LVGL_PORT_AVOID_TEARING_MODE
+#endif
 
 #if EXAMPLE_LCD_USE_EXTERNAL_INIT_CMD
     ESP_LOGI(TAG, "Using external LCD init command");
@@ -71,6 +102,13 @@ extern "C" void app_main()
 
     ESP_UTILS_CHECK_FALSE_EXIT(board->begin(), "Board begin failed");
 
+#if EXAMPLE_LATENCY_REPORT_INTERVAL_MS > 0
+    ESP_UTILS_CHECK_FALSE_EXIT(lvgl_port_attach_latency_tracker(&latency_tracker), "Attach latency tracker failed");
+#endif
+#if EXAMPLE_ENABLE_FRAME_PACING
+    ESP_UTILS_CHECK_FALSE_EXIT(lvgl_port_attach_frame_pacer(&frame_pacer), "Attach frame pacer failed");
+#endif
+
     ESP_LOGI(TAG, "Initializing LVGL");
     ESP_UTILS_CHECK_FALSE_EXIT(lvgl_port_init(board->getLCD(), board->getTouch()), "LVGL init failed");
 
@@ -85,4 +123,14 @@ extern "C" void app_main()
 
     /* Release the mutex */
     lvgl_port_unlock();
+
+#if EXAMPLE_LATENCY_REPORT_INTERVAL_MS > 0
+    while (1) {
+        vTaskDelay(pdMS_TO_TICKS(EXAMPLE_LATENCY_REPORT_INTERVAL_MS));
+        lvgl_port_report_latency();
+#if EXAMPLE_ENABLE_FRAME_PACING
+        lvgl_port_report_frame_pacing();
+#endif
+    }
+#endif
 }
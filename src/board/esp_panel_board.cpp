@@ -4,10 +4,15 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <future>
 #include <memory>
+#include <thread>
 #include "utils/esp_panel_utils_log.h"
+#include "utils/esp_panel_utils_profiler.h"
+#include "utils/esp_panel_utils_thread.hpp"
 #include "drivers/io_expander/esp_panel_io_expander_adapter.hpp"
 #include "esp_panel_board.hpp"
+#include "esp_panel_board_drivers.hpp"
 #include "esp_panel_board_private.hpp"
 #include "esp_panel_board_default_config.hpp"
 
@@ -16,16 +21,85 @@
 #define _TO_DRIVERS_CLASS(type, name)  drivers::type ## name
 #define TO_DRIVERS_CLASS(type, name)   _TO_DRIVERS_CLASS(type, name)
 
-#undef _TO_STR
-#undef TO_STR
-#define _TO_STR(name) #name
-#define TO_STR(name) _TO_STR(name)
+#define BOOT_PROFILE_PRINT_RECORDS_NUM  (8)
 
 namespace esp_panel::board {
 
+/**
+ * @brief Get the key of the bus host, the buses with the same key share the host
+ *
+ * @return Key of the host, `-1` if the bus doesn't use a shared host
+ */
+static int get_bus_host_key(drivers::Bus *bus)
+{
+    if (bus == nullptr) {
+        return -1;
+    }
+
+    // Both SPI and QSPI buses use the SPI hosts
+    switch (bus->getBasicAttributes().type) {
+#if ESP_PANEL_DRIVERS_BUS_ENABLE_SPI
+    case ESP_PANEL_BUS_TYPE_SPI:
+        return (ESP_PANEL_BUS_TYPE_SPI << 8) | static_cast<drivers::BusSPI *>(bus)->getConfig().host_id;
+#endif
+#if ESP_PANEL_DRIVERS_BUS_ENABLE_QSPI
+    case ESP_PANEL_BUS_TYPE_QSPI:
+        return (ESP_PANEL_BUS_TYPE_SPI << 8) | static_cast<drivers::BusQSPI *>(bus)->getConfig().host_id;
+#endif
+#if ESP_PANEL_DRIVERS_BUS_ENABLE_I2C
+    case ESP_PANEL_BUS_TYPE_I2C:
+        return (ESP_PANEL_BUS_TYPE_I2C << 8) | static_cast<drivers::BusI2C *>(bus)->getConfig().host_id;
+#endif
+    default:
+        return -1;
+    }
+}
+
+/**
+ * @brief Create a thread, the exception is caught if enabled
+ */
+template <typename Function>
+static bool create_thread(std::thread &thread, Function &&function)
+{
+    ESP_UTILS_CHECK_EXCEPTION_RETURN(
+        thread = std::thread(std::forward<Function>(function)), false, "Create thread failed"
+    );
+
+    return true;
+}
+
 #if ESP_PANEL_BOARD_USE_DEFAULT
+// The default devices are resolved at compile time, so the factories are not linked
+#if ESP_PANEL_BOARD_USE_LCD
+using DefaultLCD = BoardBusDevice <
+                   TO_DRIVERS_CLASS(Bus, ESP_PANEL_BOARD_LCD_BUS_NAME),
+                   TO_DRIVERS_CLASS(LCD_, ESP_PANEL_BOARD_LCD_CONTROLLER)
+                   >;
+#else
+using DefaultLCD = void;
+#endif
+#if ESP_PANEL_BOARD_USE_TOUCH
+using DefaultTouch = BoardBusDevice <
+                     TO_DRIVERS_CLASS(Bus, ESP_PANEL_BOARD_TOUCH_BUS_NAME),
+                     TO_DRIVERS_CLASS(Touch, ESP_PANEL_BOARD_TOUCH_CONTROLLER)
+                     >;
+#else
+using DefaultTouch = void;
+#endif
+#if ESP_PANEL_BOARD_USE_BACKLIGHT
+using DefaultBacklight = TO_DRIVERS_CLASS(Backlight, ESP_PANEL_BOARD_BACKLIGHT_NAME);
+#else
+using DefaultBacklight = void;
+#endif
+#if ESP_PANEL_BOARD_USE_EXPANDER
+using DefaultIO_Expander = drivers::IO_ExpanderAdapter<esp_expander::ESP_PANEL_BOARD_EXPANDER_CHIP>;
+#else
+using DefaultIO_Expander = void;
+#endif
+using DefaultDrivers = BoardDrivers<DefaultLCD, DefaultTouch, DefaultBacklight, DefaultIO_Expander>;
+
 Board::Board():
-    Board(ESP_PANEL_BOARD_DEFAULT_CONFIG)
+    Board(ESP_PANEL_BOARD_DEFAULT_CONFIG, DefaultDrivers())
 {
     _use_default_config = true;
 }
@@ -64,6 +138,10 @@ bool Board::init()
     }
 
     ESP_UTILS_LOGI("Initializing board (%s)", _config.name);
+    ESP_PANEL_PROFILER_CLEAR();
+    ESP_PANEL_PROFILER_SCOPE("board_init");
+
+    ESP_UTILS_CHECK_NULL_RETURN(_device_creators, false, "Device creators are not configured");
 
     // Create LCD device if it is used
     std::shared_ptr<drivers::Bus> lcd_bus = nullptr;
@@ -72,34 +150,9 @@ bool Board::init()
         auto &lcd_config = _config.lcd.value();
         ESP_UTILS_LOGD("Creating LCD (%s)", lcd_config.device_name);
 
-#if ESP_PANEL_BOARD_USE_DEFAULT && ESP_PANEL_BOARD_USE_LCD
-        // If the LCD is configured by default, it will be created by the constructor
-        if (_use_default_config) {
-            using Bus_Class = TO_DRIVERS_CLASS(Bus, ESP_PANEL_BOARD_LCD_BUS_NAME);
-            using LCD_Class = TO_DRIVERS_CLASS(LCD_, ESP_PANEL_BOARD_LCD_CONTROLLER);
-
-            ESP_UTILS_CHECK_FALSE_RETURN(
-                std::holds_alternative<Bus_Class::Config>(lcd_config.bus_config), false,
-                "LCD bus config is not a " TO_STR(ESP_PANEL_BOARD_LCD_BUS_NAME) " bus config"
-            );
-            ESP_UTILS_CHECK_EXCEPTION_RETURN(
-                (lcd_bus = utils::make_shared<Bus_Class>(std::get<Bus_Class::Config>(lcd_config.bus_config))), false,
-                "Create LCD bus failed"
-            );
-            ESP_UTILS_CHECK_EXCEPTION_RETURN(
-                (lcd_device = utils::make_shared<LCD_Class>(lcd_bus.get(), lcd_config.device_config)), false,
-                "Create LCD device failed"
-            );
-        }
-#endif // ESP_PANEL_BOARD_USE_DEFAULT && ESP_PANEL_BOARD_USE_LCD
-
-        // If the LCD is not configured by default, it will be created by the factory function
-        if (!_use_default_config) {
-            lcd_device =
-                drivers::LCD_Factory::create(lcd_config.device_name, lcd_config.bus_config, lcd_config.device_config);
-            ESP_UTILS_CHECK_NULL_RETURN(lcd_device, false, "Create LCD device failed");
-        }
-
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            _device_creators->create_lcd(lcd_config, lcd_bus, lcd_device), false, "Create LCD device failed"
+        );
         ESP_UTILS_CHECK_NULL_RETURN(lcd_device, false, "Create LCD failed");
         ESP_UTILS_LOGD("LCD create success");
     }
@@ -111,36 +164,9 @@ bool Board::init()
         auto &touch_config = _config.touch.value();
         ESP_UTILS_LOGD("Creating touch (%s)", touch_config.device_name);
 
-#if ESP_PANEL_BOARD_USE_DEFAULT && ESP_PANEL_BOARD_USE_TOUCH
-        // If the touch is configured by default, it will be created by the constructor
-        if (_use_default_config) {
-            using Bus_Class = TO_DRIVERS_CLASS(Bus, ESP_PANEL_BOARD_TOUCH_BUS_NAME);
-            using Touch_Class = TO_DRIVERS_CLASS(Touch, ESP_PANEL_BOARD_TOUCH_CONTROLLER);
-
-            ESP_UTILS_CHECK_FALSE_RETURN(
-                std::holds_alternative<Bus_Class::Config>(touch_config.bus_config), false,
-                "Touch bus config is not a " TO_STR(ESP_PANEL_BOARD_TOUCH_BUS_NAME) " bus config"
-            );
-            ESP_UTILS_CHECK_EXCEPTION_RETURN(
-                (touch_bus = utils::make_shared<Bus_Class>(std::get<Bus_Class::Config>(touch_config.bus_config))),
-                false, "Create touch bus failed"
-            );
-            ESP_UTILS_CHECK_EXCEPTION_RETURN(
-                (touch_device = utils::make_shared<Touch_Class>(touch_bus.get(), touch_config.device_config)),
-                false, "Create touch device failed"
-            );
-        }
-#endif // ESP_PANEL_BOARD_USE_DEFAULT && ESP_PANEL_BOARD_USE_TOUCH
-
-        // If the touch is not configured by default, it will be created by the factory function
-        if (!_use_default_config) {
-            touch_device =
-                drivers::TouchFactory::create(
-                    touch_config.device_name, touch_config.bus_config, touch_config.device_config
-                );
-            ESP_UTILS_CHECK_NULL_RETURN(touch_device, false, "Create touch device failed");
-        }
-
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            _device_creators->create_touch(touch_config, touch_bus, touch_device), false, "Create touch device failed"
+        );
         ESP_UTILS_CHECK_NULL_RETURN(touch_device, false, "Create touch failed");
         ESP_UTILS_LOGD("Touch create success");
     }
@@ -149,44 +175,16 @@ bool Board::init()
     std::shared_ptr<drivers::Backlight> backlight = nullptr;
     if (isBacklightUsed()) {
         auto &backlight_config = _config.backlight.value();
-        auto type = drivers::BacklightFactory::getConfigType(backlight_config.config);
-        ESP_UTILS_LOGD("Creating backlight (%s[%d])", drivers::BacklightFactory::getTypeNameString(type).c_str(), type);
+        ESP_UTILS_LOGD("Creating backlight");
 
         // If the backlight is a custom backlight, the user data should be set to the board instance `this`
-        if (type == ESP_PANEL_BACKLIGHT_TYPE_CUSTOM) {
-            using BacklightConfig = drivers::BacklightCustom::Config;
-
-            ESP_UTILS_CHECK_FALSE_RETURN(
-                std::holds_alternative<BacklightConfig>(backlight_config.config), false,
-                "Backlight config is not a custom backlight config"
-            );
-            auto &config = std::get<BacklightConfig>(backlight_config.config);
-            config.user_data = this;
-        }
-
-#if ESP_PANEL_BOARD_USE_DEFAULT && ESP_PANEL_BOARD_USE_BACKLIGHT
-        // If the backlight is configured by default, it will be created by the constructor
-        if (_use_default_config) {
-            using BacklightClass = TO_DRIVERS_CLASS(Backlight, ESP_PANEL_BOARD_BACKLIGHT_NAME);
-
-            ESP_UTILS_CHECK_FALSE_RETURN(
-                std::holds_alternative<BacklightClass::Config>(backlight_config.config), false,
-                "Backlight config is not a " TO_STR(ESP_PANEL_BOARD_BACKLIGHT_NAME) " backlight config"
-            );
-            ESP_UTILS_CHECK_EXCEPTION_RETURN(
-                (backlight =
-                     utils::make_shared<BacklightClass>(std::get<BacklightClass::Config>(backlight_config.config))),
-                false, "Create backlight device failed"
-            );
-        }
-#endif // ESP_PANEL_BOARD_USE_DEFAULT && ESP_PANEL_BOARD_USE_BACKLIGHT
-
-        // If the backlight is not configured by default, it will be created by the factory function
-        if (!_use_default_config) {
-            backlight = drivers::BacklightFactory::create(backlight_config.config);
-            ESP_UTILS_CHECK_NULL_RETURN(backlight, false, "Create backlight device failed");
+        if (std::holds_alternative<drivers::BacklightCustom::Config>(backlight_config.config)) {
+            std::get<drivers::BacklightCustom::Config>(backlight_config.config).user_data = this;
         }
 
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            _device_creators->create_backlight(backlight_config, backlight), false, "Create backlight device failed"
+        );
         ESP_UTILS_CHECK_NULL_RETURN(backlight, false, "Create backlight failed");
         ESP_UTILS_LOGD("Backlight create success");
     }
@@ -198,28 +196,11 @@ bool Board::init()
         auto &expander_config = _config.io_expander.value();
         ESP_UTILS_LOGD("Creating IO Expander (%s)", expander_config.name);
 
-#if ESP_PANEL_BOARD_USE_DEFAULT && ESP_PANEL_BOARD_USE_EXPANDER
-        // If the IO expander is configured by default, it will be created by the default constructor
-        if (_use_default_config) {
-            using IO_ExpanderClass = drivers::IO_ExpanderAdapter<esp_expander::ESP_PANEL_BOARD_EXPANDER_CHIP>;
-            ESP_UTILS_CHECK_EXCEPTION_RETURN(
-                (io_expander =
-                     utils::make_shared<IO_ExpanderClass>(
-                         drivers::IO_Expander::BasicAttributes{TO_STR(ESP_PANEL_BOARD_EXPANDER_CHIP)},
-                         expander_config.config
-                     )), false, "Create IO expander device failed"
-            );
-        }
-#endif // ESP_PANEL_BOARD_USE_DEFAULT && ESP_PANEL_BOARD_USE_EXPANDER
-
-        // If the IO expander is not configured by default, it will be created by the factory function
-        if (!_use_default_config) {
-            io_expander = drivers::IO_ExpanderFactory::create(expander_config.name, expander_config.config);
-            ESP_UTILS_CHECK_NULL_RETURN(io_expander, false, "Create IO expander device failed");
-        }
-
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            _device_creators->create_io_expander(expander_config, io_expander), false,
+            "Create IO expander device failed"
+        );
         ESP_UTILS_CHECK_NULL_RETURN(io_expander, false, "Create IO expander failed");
-
         ESP_UTILS_LOGD("IO Expander create success");
     }
 
@@ -251,23 +232,471 @@ bool Board::begin()
     }
 
     ESP_UTILS_LOGI("Beginning board (%s)", _config.name);
+    // Begin after `init()`, which clears the records
+    ESP_PANEL_PROFILER_SCOPE("board_begin");
 
     auto &config = getConfig();
     if (config.stage_callbacks[BoardConfig::STAGE_CALLBACK_PRE_BOARD_BEGIN] != nullptr) {
         ESP_UTILS_LOGD("Board pre-begin");
+        ESP_PANEL_PROFILER_SCOPE("pre_board_begin_cb");
         ESP_UTILS_CHECK_FALSE_RETURN(
             config.stage_callbacks[BoardConfig::STAGE_CALLBACK_PRE_BOARD_BEGIN](this), false, "Board pre-begin failed"
         );
     }
 
+    if (_parallel_begin_config.has_value()) {
+        ESP_UTILS_CHECK_FALSE_RETURN(beginDevicesParallel(), false, "Begin devices in parallel failed");
+    } else {
+        ESP_UTILS_CHECK_FALSE_RETURN(beginIO_Expander(), false, "Begin IO expander failed");
+        ESP_UTILS_CHECK_FALSE_RETURN(beginLCD(), false, "Begin LCD failed");
+        ESP_UTILS_CHECK_FALSE_RETURN(beginTouch(), false, "Begin touch failed");
+        ESP_UTILS_CHECK_FALSE_RETURN(beginBacklight(), false, "Begin backlight failed");
+    }
+
+    if (config.stage_callbacks[BoardConfig::STAGE_CALLBACK_POST_BOARD_BEGIN] != nullptr) {
+        ESP_UTILS_LOGD("Board post-begin");
+        ESP_PANEL_PROFILER_SCOPE("post_board_begin_cb");
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            config.stage_callbacks[BoardConfig::STAGE_CALLBACK_POST_BOARD_BEGIN](this), false, "Board post-begin failed"
+        );
+    }
+
+    setState(State::BEGIN);
+
+    ESP_UTILS_LOGI("Board begin success");
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool Board::del()
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    auto &config = getConfig();
+
+    if (!isOverState(State::INIT)) {
+        goto end;
+    }
+
+    ESP_UTILS_LOGI("Deleting board (%s)", config.name);
+
+    ESP_UTILS_CHECK_FALSE_RETURN(stopPowerManager(), false, "Stop power manager failed");
+
+    if (isOverState(State::BEGIN) && config.stage_callbacks[BoardConfig::STAGE_CALLBACK_PRE_BOARD_DEL] != nullptr) {
+        ESP_UTILS_LOGD("Board pre-delete");
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            config.stage_callbacks[BoardConfig::STAGE_CALLBACK_PRE_BOARD_DEL](this), false, "Board pre-delete failed"
+        );
+    }
+
+    _backlight = nullptr;
+    _lcd_device = nullptr;
+    _lcd_bus = nullptr;
+    _touch_device = nullptr;
+    _touch_bus = nullptr;
+    _io_expander = nullptr;
+
+    if (isOverState(State::BEGIN) && config.stage_callbacks[BoardConfig::STAGE_CALLBACK_POST_BOARD_DEL] != nullptr) {
+        ESP_UTILS_LOGD("Board post-delete");
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            config.stage_callbacks[BoardConfig::STAGE_CALLBACK_POST_BOARD_DEL](this), false, "Board post-delete failed"
+        );
+    }
+
+    setState(State::DEINIT);
+
+    ESP_UTILS_LOGI("Board delete success");
+
+end:
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool Board::startPowerManager(const PowerManagerConfig &config)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(isOverState(State::BEGIN), false, "Not begun");
+    ESP_UTILS_CHECK_FALSE_RETURN(!isPowerManagerRunning(), false, "Already running");
+
+    ESP_UTILS_LOGD(
+        "Param: dim(%d ms), display_off(%d ms), touch_sleep(%d ms), static(%d ms), active_frame_rate(%d), "
+        "dim_brightness(%d), fade_ms(%d), static_pclk_hz(%d), poll_interval_ms(%d)", config.policy.dim_timeout_ms,
+        config.policy.display_off_timeout_ms, config.policy.touch_sleep_timeout_ms, config.policy.static_timeout_ms,
+        config.policy.active_frame_rate, config.dim_brightness, config.fade_ms, config.static_pclk_hz,
+        config.poll_interval_ms
+    );
+    ESP_UTILS_CHECK_FALSE_RETURN(config.poll_interval_ms > 0, false, "Invalid poll interval");
+
+    std::shared_ptr<PowerManager> manager = nullptr;
+    ESP_UTILS_CHECK_EXCEPTION_RETURN(
+        manager = utils::make_shared<PowerManager>(), false, "Create power manager failed"
+    );
+    manager->config = config;
+    manager->policy = utils::PowerPolicy(config.policy);
+    manager->policy.reset(esp_timer_get_time());
+    if ((getBacklight() != nullptr) && (getBacklight()->getBrightness() > 0)) {
+        manager->active_brightness = getBacklight()->getBrightness();
+    }
+    if (getTouch() != nullptr) {
+        manager->last_touch_time_us = getTouch()->getLastTouchTimeUs();
+    }
+    if (getLCD() != nullptr) {
+        manager->last_draw_count = getLCD()->getDrawBitmapCount();
+    }
+
+    esp_timer_create_args_t timer_args = {
+        .callback = onPowerTimer,
+        .arg = this,
+        .dispatch_method = ESP_TIMER_TASK,
+        .name = "board_power",
+        .skip_unhandled_events = true,
+    };
+    ESP_UTILS_CHECK_ERROR_RETURN(esp_timer_create(&timer_args, &manager->timer), false, "Create power timer failed");
+    std::atomic_store(&_power_manager, manager);
+
+    esp_err_t ret = esp_timer_start_periodic(manager->timer, config.poll_interval_ms * 1000);
+    if (ret != ESP_OK) {
+        std::atomic_store(&_power_manager, std::shared_ptr<PowerManager>(nullptr));
+        esp_timer_delete(manager->timer);
+        ESP_UTILS_CHECK_ERROR_RETURN(ret, false, "Start power timer failed");
+    }
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool Board::stopPowerManager()
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    // Stop and delete the timer before detaching the manager. The timer callback may be running, which keeps its own
+    // reference of the manager
+    auto manager = std::atomic_load(&_power_manager);
+    if (manager == nullptr) {
+        goto end;
+    }
+
+    esp_timer_stop(manager->timer);
+    ESP_UTILS_CHECK_ERROR_RETURN(esp_timer_delete(manager->timer), false, "Delete power timer failed");
+    manager->timer = nullptr;
+    std::atomic_store(&_power_manager, std::shared_ptr<PowerManager>(nullptr));
+    {
+        // Wait for the running update, then restore the devices. The later updates are skipped by `is_stopped`
+        std::lock_guard lock(manager->mutex);
+        manager->is_stopped = true;
+        applyContentStatic(*manager, false);
+        applyPowerState(*manager, manager->policy.getState(), PowerState::ACTIVE);
+    }
+
+end:
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool Board::notifyUserActivity()
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    auto manager = std::atomic_load(&_power_manager);
+    ESP_UTILS_CHECK_NULL_RETURN(manager, false, "Power manager is not running");
+
+    updatePower(*manager, true);
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool Board::attachPowerEventCallback(FunctionPowerEventCallback callback, void *user_data)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    auto manager = std::atomic_load(&_power_manager);
+    ESP_UTILS_CHECK_NULL_RETURN(manager, false, "Power manager is not running");
+
+    ESP_UTILS_LOGD("Param: callback(%p), user_data(%p)", callback, user_data);
+    std::lock_guard lock(manager->mutex);
+    manager->callback = callback;
+    manager->user_data = user_data;
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+Board::PowerState Board::getPowerState()
+{
+    auto manager = std::atomic_load(&_power_manager);
+    if (manager == nullptr) {
+        return PowerState::ACTIVE;
+    }
+
+    std::lock_guard lock(manager->mutex);
+
+    return manager->policy.getState();
+}
+
+int64_t Board::getPowerStateTimeUs(PowerState state)
+{
+    auto manager = std::atomic_load(&_power_manager);
+    if (manager == nullptr) {
+        return 0;
+    }
+
+    std::lock_guard lock(manager->mutex);
+
+    return manager->policy.getStateTimeUs(state, esp_timer_get_time());
+}
+
+void Board::updatePower(PowerManager &manager, bool is_activity)
+{
+    PowerEvent event = {};
+    FunctionPowerEventCallback callback = nullptr;
+    void *user_data = nullptr;
+
+    {
+        std::lock_guard lock(manager.mutex);
+        if (manager.is_stopped) {
+            return;
+        }
+        int64_t now_us = esp_timer_get_time();
+        auto &policy = manager.policy;
+
+        if (is_activity) {
+            policy.notifyActivity(now_us);
+        }
+        auto touch = getTouch();
+        if (touch != nullptr) {
+            int64_t touch_time_us = touch->getLastTouchTimeUs();
+            if (touch_time_us > manager.last_touch_time_us) {
+                policy.notifyActivity(touch_time_us);
+                manager.last_touch_time_us = touch_time_us;
+            }
+        }
+        auto lcd = getLCD();
+        if (lcd != nullptr) {
+            uint32_t draw_count = lcd->getDrawBitmapCount();
+            policy.notifyFrames(now_us, static_cast<int>(draw_count - manager.last_draw_count));
+            manager.last_draw_count = draw_count;
+        }
+
+        PowerState from = policy.getState();
+        bool is_static = policy.isContentStatic();
+        if (!policy.update(now_us)) {
+            return;
+        }
+
+        PowerState to = policy.getState();
+        if (to != from) {
+            ESP_UTILS_LOGI(
+                "Power state: %s -> %s", utils::PowerPolicy::getStateName(from), utils::PowerPolicy::getStateName(to)
+            );
+            applyPowerState(manager, from, to);
+        }
+        if (policy.isContentStatic() != is_static) {
+            ESP_UTILS_LOGD("Content static: %d", policy.isContentStatic());
+            applyContentStatic(manager, policy.isContentStatic());
+        }
+
+        event = PowerEvent{
+            .from = from,
+            .to = to,
+            .is_content_static = policy.isContentStatic(),
+            .frame_rate = policy.getFrameRate(),
+            .time_us = now_us,
+        };
+        callback = manager.callback;
+        user_data = manager.user_data;
+    }
+
+    // Call it without the lock, so the callback can query the power manager
+    if (callback != nullptr) {
+        callback(event, user_data);
+    }
+}
+
+void Board::applyPowerState(PowerManager &manager, PowerState from, PowerState to)
+{
+    auto &config = manager.config;
+    auto lcd = getLCD();
+    auto touch = getTouch();
+    auto backlight = getBacklight();
+    bool is_display_on = (to < PowerState::DISPLAY_OFF);
+    bool is_display_changed = (is_display_on != (from < PowerState::DISPLAY_OFF));
+    bool is_display_supported =
+        (lcd != nullptr) && lcd->isFunctionSupported(drivers::LCD::BasicBusSpecification::FUNC_DISPLAY_ON_OFF);
+
+    // Keep the brightness adjusted by the application in the active state
+    if ((from == PowerState::ACTIVE) && (backlight != nullptr) && !backlight->isFading() &&
+            (backlight->getBrightness() > 0)) {
+        manager.active_brightness = backlight->getBrightness();
+    }
+
+    // Wake up in the order: touch -> display -> backlight, so the uninitialized content is not shown
+    if ((to != PowerState::TOUCH_SLEEP) && (touch != nullptr) && touch->isSleeping() && !touch->exitSleep()) {
+        ESP_UTILS_LOGE("Touch exit sleep failed");
+    }
+    if (is_display_on && is_display_changed && is_display_supported && !lcd->setDisplayOnOff(true)) {
+        ESP_UTILS_LOGE("LCD display on failed");
+    }
+
+    if (backlight != nullptr) {
+        bool ret = true;
+        switch (to) {
+        case PowerState::ACTIVE:
+            ret = backlight->fadeTo(manager.active_brightness, config.fade_ms);
+            break;
+        case PowerState::DIMMED:
+            ret = backlight->fadeTo(std::min(config.dim_brightness, manager.active_brightness), config.fade_ms);
+            break;
+        default:
+            // The display is turned off right after, so don't fade
+            ret = backlight->fadeTo(0, 0);
+            break;
+        }
+        if (!ret) {
+            ESP_UTILS_LOGE("Backlight fade failed");
+        }
+    }
+
+    // Sleep in the reverse order: backlight -> display -> touch
+    if (!is_display_on && is_display_changed && is_display_supported && !lcd->setDisplayOnOff(false)) {
+        ESP_UTILS_LOGE("LCD display off failed");
+    }
+    if ((to == PowerState::TOUCH_SLEEP) && (touch != nullptr) && touch->isSleepSupported() && !touch->enterSleep()) {
+        ESP_UTILS_LOGE("Touch enter sleep failed");
+    }
+}
+
+void Board::applyContentStatic(PowerManager &manager, bool is_static)
+{
+    auto lcd = getLCD();
+    if ((manager.config.static_pclk_hz <= 0) || (lcd == nullptr) ||
+            (lcd->getBus()->getBasicAttributes().type != ESP_PANEL_BUS_TYPE_RGB) ||
+            (is_static == manager.is_pclk_lowered)) {
+        return;
+    }
+
+    if (!lcd->setPixelClockHz(is_static ? manager.config.static_pclk_hz : 0)) {
+        ESP_UTILS_LOGE("Set pixel clock failed");
+        return;
+    }
+    manager.is_pclk_lowered = is_static;
+}
+
+void Board::onPowerTimer(void *arg)
+{
+    auto board = static_cast<Board *>(arg);
+    auto manager = std::atomic_load(&board->_power_manager);
+    if (manager != nullptr) {
+        board->updatePower(*manager, false);
+    }
+}
+
+#if ESP_PANEL_DRIVERS_ENABLE_PROFILER
+const utils::Profiler &Board::getBootProfile() const
+{
+    return utils::getBootProfiler();
+}
+
+void Board::printBootProfile() const
+{
+    auto &profiler = getBootProfile();
+    utils::Profiler::Record records[BOOT_PROFILE_PRINT_RECORDS_NUM];
+    char line[128];
+
+    int records_num = profiler.getRecords(records, 1);
+    if (records_num == 0) {
+        ESP_UTILS_LOGI("No boot profile of board (%s)", _config.name);
+        return;
+    }
+
+    int64_t base_us = records[0].start_us;
+    ESP_UTILS_LOGI(
+        "Boot profile of board (%s), %d records, %d dropped:", _config.name, profiler.getRecordsNum(),
+        profiler.getDroppedNum()
+    );
+    ESP_UTILS_LOGI("  Start time |    Duration | Stage");
+    for (int offset = 0; (records_num = profiler.getRecords(records, BOOT_PROFILE_PRINT_RECORDS_NUM, offset)) > 0;
+            offset += records_num) {
+        for (int i = 0; i < records_num; i++) {
+            utils::Profiler::formatRecord(records[i], base_us, line, sizeof(line));
+            ESP_UTILS_LOGI("%s", line);
+        }
+    }
+}
+#endif // ESP_PANEL_DRIVERS_ENABLE_PROFILER
+
+bool Board::configIO_Expander(drivers::IO_Expander *expander)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(!isOverState(State::INIT), false, "Already initialized");
+
+    _io_expander = std::shared_ptr<drivers::IO_Expander>(expander, [](drivers::IO_Expander * expander) {
+        ESP_UTILS_LOGD("Skip delete IO expander");
+    });
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool Board::configCallback(board::BoardConfig::StageCallbackType type, BoardConfig::FunctionStageCallback callback)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(!isOverState(State::INIT), false, "Already initialized");
+    ESP_UTILS_CHECK_FALSE_RETURN(type < BoardConfig::STAGE_CALLBACK_MAX, false, "Invalid callback type");
+
+    _config.stage_callbacks[type] = callback;
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool Board::configParallelBegin(const ParallelBeginConfig &config)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(!isOverState(State::BEGIN), false, "Already begun");
+
+    ESP_UTILS_LOGD(
+        "Param: task_priority(%d), task_stack_size(%d), task_core_id(%d)", config.task_priority,
+        config.task_stack_size, config.task_core_id
+    );
+    ESP_UTILS_CHECK_FALSE_RETURN(config.task_stack_size > 0, false, "Invalid task stack size");
+
+    _parallel_begin_config = config;
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool Board::beginIO_Expander()
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    auto &config = getConfig();
+
     // Begin the IO expander if it is used
     // If the IO expander is already begun, it will not be begun again
     auto io_expander = getIO_Expander();
     if (io_expander != nullptr && !io_expander->isOverState(esp_expander::Base::State::BEGIN)) {
         ESP_UTILS_LOGD("Beginning IO Expander");
+        ESP_PANEL_PROFILER_SCOPE("expander_begin");
 
         if (config.stage_callbacks[BoardConfig::STAGE_CALLBACK_PRE_EXPANDER_BEGIN] != nullptr) {
             ESP_UTILS_LOGD("IO expander pre-begin");
+            ESP_PANEL_PROFILER_SCOPE("pre_expander_begin_cb");
             ESP_UTILS_CHECK_FALSE_RETURN(
                 config.stage_callbacks[BoardConfig::STAGE_CALLBACK_PRE_EXPANDER_BEGIN](this), false,
                 "IO expander pre-begin failed"
@@ -278,6 +707,7 @@ bool Board::begin()
 
         if (config.stage_callbacks[BoardConfig::STAGE_CALLBACK_POST_EXPANDER_BEGIN] != nullptr) {
             ESP_UTILS_LOGD("IO expander post-begin");
+            ESP_PANEL_PROFILER_SCOPE("post_expander_begin_cb");
             ESP_UTILS_CHECK_FALSE_RETURN(
                 config.stage_callbacks[BoardConfig::STAGE_CALLBACK_POST_EXPANDER_BEGIN](this), false,
                 "IO expander post-begin failed"
@@ -287,19 +717,33 @@ bool Board::begin()
         ESP_UTILS_LOGD("IO expander begin success");
     }
 
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool Board::beginLCD()
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    auto &config = getConfig();
+
     // Begin the LCD if it is used
     auto lcd_device = getLCD();
     if (lcd_device != nullptr) {
         ESP_UTILS_LOGD("Beginning LCD");
+        ESP_PANEL_PROFILER_SCOPE("lcd_begin");
 
         if (config.stage_callbacks[BoardConfig::STAGE_CALLBACK_PRE_LCD_BEGIN] != nullptr) {
             ESP_UTILS_LOGD("LCD pre-begin");
+            ESP_PANEL_PROFILER_SCOPE("pre_lcd_begin_cb");
             ESP_UTILS_CHECK_FALSE_RETURN(
                 config.stage_callbacks[BoardConfig::STAGE_CALLBACK_PRE_LCD_BEGIN](this), false, "LCD pre-begin failed"
             );
         }
 
 #if ESP_PANEL_DRIVERS_BUS_ENABLE_RGB
+        auto io_expander = getIO_Expander();
         drivers::Bus *lcd_bus = lcd_device->getBus();
         // When using "3-wire SPI + RGB" LCD, the IO expander should be configured first
         if ((lcd_bus->getBasicAttributes().type == ESP_PANEL_BUS_TYPE_RGB) &&
@@ -361,6 +805,7 @@ bool Board::begin()
 
         if (config.stage_callbacks[BoardConfig::STAGE_CALLBACK_POST_LCD_BEGIN] != nullptr) {
             ESP_UTILS_LOGD("LCD post-begin");
+            ESP_PANEL_PROFILER_SCOPE("post_lcd_begin_cb");
             ESP_UTILS_CHECK_FALSE_RETURN(
                 config.stage_callbacks[BoardConfig::STAGE_CALLBACK_POST_LCD_BEGIN](this), false, "LCD post-begin failed"
             );
@@ -369,13 +814,26 @@ bool Board::begin()
         ESP_UTILS_LOGD("LCD begin success");
     }
 
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool Board::beginTouch()
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    auto &config = getConfig();
+
     // Begin the touch if it is used
     auto touch_device = getTouch();
     if (touch_device != nullptr) {
         ESP_UTILS_LOGD("Beginning touch");
+        ESP_PANEL_PROFILER_SCOPE("touch_begin");
 
         if (config.stage_callbacks[BoardConfig::STAGE_CALLBACK_PRE_TOUCH_BEGIN] != nullptr) {
             ESP_UTILS_LOGD("Touch pre-begin");
+            ESP_PANEL_PROFILER_SCOPE("pre_touch_begin_cb");
             ESP_UTILS_CHECK_FALSE_RETURN(
                 config.stage_callbacks[BoardConfig::STAGE_CALLBACK_PRE_TOUCH_BEGIN](this), false,
                 "Touch pre-begin failed"
@@ -397,6 +855,7 @@ bool Board::begin()
 
         if (config.stage_callbacks[BoardConfig::STAGE_CALLBACK_POST_TOUCH_BEGIN] != nullptr) {
             ESP_UTILS_LOGD("Touch post-begin");
+            ESP_PANEL_PROFILER_SCOPE("post_touch_begin_cb");
             ESP_UTILS_CHECK_FALSE_RETURN(
                 config.stage_callbacks[BoardConfig::STAGE_CALLBACK_POST_TOUCH_BEGIN](this), false,
                 "Touch post-begin failed"
@@ -406,13 +865,26 @@ bool Board::begin()
         ESP_UTILS_LOGD("Touch begin success");
     }
 
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool Board::beginBacklight()
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    auto &config = getConfig();
+
     // Begin the backlight if it is used
     auto backlight = getBacklight();
     if (backlight != nullptr) {
         ESP_UTILS_LOGD("Beginning backlight");
+        ESP_PANEL_PROFILER_SCOPE("backlight_begin");
 
         if (config.stage_callbacks[BoardConfig::STAGE_CALLBACK_PRE_BACKLIGHT_BEGIN] != nullptr) {
             ESP_UTILS_LOGD("Backlight pre-begin");
+            ESP_PANEL_PROFILER_SCOPE("pre_backlight_begin_cb");
             ESP_UTILS_CHECK_FALSE_RETURN(
                 config.stage_callbacks[BoardConfig::STAGE_CALLBACK_PRE_BACKLIGHT_BEGIN](this), false,
                 "Backlight pre-begin failed"
@@ -421,9 +893,9 @@ bool Board::begin()
 
         auto &backlight_config = _config.backlight.value();
 #if ESP_PANEL_DRIVERS_BACKLIGHT_ENABLE_SWITCH_EXPANDER
+        auto io_expander = getIO_Expander();
         // If the backlight is a switch expander, the IO expander should be configured
-        if (drivers::BacklightFactory::getConfigType(backlight_config.config) ==
-                ESP_PANEL_BACKLIGHT_TYPE_SWITCH_EXPANDER) {
+        if (std::holds_alternative<drivers::BacklightSwitchExpander::Config>(backlight_config.config)) {
             auto *temp_backlight = static_cast<drivers::BacklightSwitchExpander *>(backlight);
             // Only configure the IO expander if it is not already configured
             if (temp_backlight->getIO_Expander() == nullptr) {
@@ -442,6 +914,7 @@ bool Board::begin()
 
         if (config.stage_callbacks[BoardConfig::STAGE_CALLBACK_POST_BACKLIGHT_BEGIN] != nullptr) {
             ESP_UTILS_LOGD("Backlight post-begin");
+            ESP_PANEL_PROFILER_SCOPE("post_backlight_begin_cb");
             ESP_UTILS_CHECK_FALSE_RETURN(
                 config.stage_callbacks[BoardConfig::STAGE_CALLBACK_POST_BACKLIGHT_BEGIN](this), false,
                 "Backlight post-begin failed"
@@ -451,92 +924,100 @@ bool Board::begin()
         ESP_UTILS_LOGD("Backlight begin success");
     }
 
-    if (config.stage_callbacks[BoardConfig::STAGE_CALLBACK_POST_BOARD_BEGIN] != nullptr) {
-        ESP_UTILS_LOGD("Board post-begin");
-        ESP_UTILS_CHECK_FALSE_RETURN(
-            config.stage_callbacks[BoardConfig::STAGE_CALLBACK_POST_BOARD_BEGIN](this), false, "Board post-begin failed"
-        );
-    }
-
-    setState(State::BEGIN);
-
-    ESP_UTILS_LOGI("Board begin success");
-
     ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
 
     return true;
 }
 
-bool Board::del()
+bool Board::beginDevicesParallel()
 {
     ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
 
-    auto &config = getConfig();
+    using BeginFunction = bool (Board::*)();
+    const std::array<BeginFunction, BEGIN_STAGE_MAX> functions = {
+        &Board::beginIO_Expander, &Board::beginLCD, &Board::beginTouch, &Board::beginBacklight,
+    };
+    std::array<std::promise<bool>, BEGIN_STAGE_MAX> results;
+    std::array<std::shared_future<bool>, BEGIN_STAGE_MAX> futures;
+    std::array<std::thread, BEGIN_STAGE_MAX> threads;
 
-    if (!isOverState(State::INIT)) {
-        goto end;
+    for (int i = 0; i < BEGIN_STAGE_MAX; i++) {
+        futures[i] = results[i].get_future().share();
     }
 
-    ESP_UTILS_LOGI("Deleting board (%s)", config.name);
-
-    if (isOverState(State::BEGIN) && config.stage_callbacks[BoardConfig::STAGE_CALLBACK_PRE_BOARD_DEL] != nullptr) {
-        ESP_UTILS_LOGD("Board pre-delete");
-        ESP_UTILS_CHECK_FALSE_RETURN(
-            config.stage_callbacks[BoardConfig::STAGE_CALLBACK_PRE_BOARD_DEL](this), false, "Board pre-delete failed"
-        );
+    {
+        auto &parallel_config = _parallel_begin_config.value();
+        utils::ThreadConfigGuard thread_config_guard({
+            .name = "board_begin",
+            .priority = parallel_config.task_priority,
+            .stack_size = parallel_config.task_stack_size,
+            .core_id = parallel_config.task_core_id,
+        });
+        // Each stage runs in its own thread and waits for the stages it depends on, the stages are created in the
+        // topological order, so a stage never waits for one which is not created
+        for (int i = 0; i < BEGIN_STAGE_MAX; i++) {
+            uint32_t dependencies = getBeginDependencies(static_cast<BeginStage>(i));
+            ESP_UTILS_LOGD("Begin stage(%d) depends on mask(0x%02X)", i, static_cast<int>(dependencies));
+
+            auto run_stage = [this, i, dependencies, &functions, &results, &futures]() {
+                bool is_ready = true;
+                for (int j = 0; j < BEGIN_STAGE_MAX; j++) {
+                    if ((dependencies & (1U << j)) && !futures[j].get()) {
+                        is_ready = false;
+                    }
+                }
+                results[i].set_value(is_ready && (this->*functions[i])());
+            };
+            if (!create_thread(threads[i], run_stage)) {
+                results[i].set_value(false);
+            }
+        }
     }
 
-    _backlight = nullptr;
-    _lcd_device = nullptr;
-    _lcd_bus = nullptr;
-    _touch_device = nullptr;
-    _touch_bus = nullptr;
-    _io_expander = nullptr;
-
-    if (isOverState(State::BEGIN) && config.stage_callbacks[BoardConfig::STAGE_CALLBACK_POST_BOARD_DEL] != nullptr) {
-        ESP_UTILS_LOGD("Board post-delete");
-        ESP_UTILS_CHECK_FALSE_RETURN(
-            config.stage_callbacks[BoardConfig::STAGE_CALLBACK_POST_BOARD_DEL](this), false, "Board post-delete failed"
-        );
+    bool ret = true;
+    for (int i = 0; i < BEGIN_STAGE_MAX; i++) {
+        if (threads[i].joinable()) {
+            threads[i].join();
+        }
+        if (!futures[i].get()) {
+            ESP_UTILS_LOGE("Begin stage(%d) failed", i);
+            ret = false;
+        }
     }
 
-    setState(State::DEINIT);
-
-    ESP_UTILS_LOGI("Board delete success");
-
-end:
     ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
 
-    return true;
+    return ret;
 }
 
-bool Board::configIO_Expander(drivers::IO_Expander *expander)
+uint32_t Board::getBeginDependencies(BeginStage stage)
 {
-    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
-
-    ESP_UTILS_CHECK_FALSE_RETURN(!isOverState(State::INIT), false, "Already initialized");
-
-    _io_expander = std::shared_ptr<drivers::IO_Expander>(expander, [](drivers::IO_Expander * expander) {
-        ESP_UTILS_LOGD("Skip delete IO expander");
-    });
-
-    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
-
-    return true;
-}
-
-bool Board::configCallback(board::BoardConfig::StageCallbackType type, BoardConfig::FunctionStageCallback callback)
-{
-    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
-
-    ESP_UTILS_CHECK_FALSE_RETURN(!isOverState(State::INIT), false, "Already initialized");
-    ESP_UTILS_CHECK_FALSE_RETURN(type < BoardConfig::STAGE_CALLBACK_MAX, false, "Invalid callback type");
-
-    _config.stage_callbacks[type] = callback;
-
-    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+    uint32_t dependencies = 0;
+
+    switch (stage) {
+    case BEGIN_STAGE_LCD:
+        // The IO expander may be used by the LCD, e.g. "3-wire SPI + RGB" LCD or the stage callbacks
+        dependencies = (1U << BEGIN_STAGE_IO_EXPANDER);
+        break;
+    case BEGIN_STAGE_TOUCH: {
+        dependencies = (1U << BEGIN_STAGE_IO_EXPANDER);
+        // The bus hosts are not thread-safe when being created, so the devices on the same host are serialized
+        int touch_host_key = get_bus_host_key((getTouch() != nullptr) ? getTouch()->getBus() : nullptr);
+        int lcd_host_key = get_bus_host_key((getLCD() != nullptr) ? getLCD()->getBus() : nullptr);
+        if ((touch_host_key >= 0) && (touch_host_key == lcd_host_key)) {
+            dependencies |= (1U << BEGIN_STAGE_LCD);
+        }
+        break;
+    }
+    case BEGIN_STAGE_BACKLIGHT:
+        // Turn on the backlight after the LCD is ready, otherwise the random content may be shown
+        dependencies = (1U << BEGIN_STAGE_IO_EXPANDER) | (1U << BEGIN_STAGE_LCD);
+        break;
+    default:
+        break;
+    }
 
-    return true;
+    return dependencies;
 }
 
 } // namespace esp_panel
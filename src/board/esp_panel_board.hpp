@@ -6,9 +6,14 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include "esp_timer.h"
 #include "esp_panel_types.h"
 #include "utils/esp_panel_utils_cxx.hpp"
+#include "utils/esp_panel_utils_power.hpp"
+#include "utils/esp_panel_utils_profiler.hpp"
 #include "esp_panel_board_conf_internal.h"
 #include "esp_panel_board_config.hpp"
 
@@ -30,6 +35,72 @@ public:
         BEGIN,         /*!< Board is started */
     };
 
+    /**
+     * @brief Configuration of the parallel begin, see `configParallelBegin()`
+     */
+    struct ParallelBeginConfig {
+        int task_priority = 5;              /*!< Priority of the threads to begin the devices */
+        int task_stack_size = 6 * 1024;     /*!< Stack size of each thread in bytes */
+        int task_core_id = -1;              /*!< Core of the threads, `-1` means no affinity */
+    };
+
+    /**
+     * @brief Power state of the board, see `utils::PowerPolicy::State`
+     */
+    using PowerState = utils::PowerPolicy::State;
+
+    /**
+     * @brief Configuration of the power manager, see `startPowerManager()`
+     */
+    struct PowerManagerConfig {
+        utils::PowerPolicy::Config policy = {}; /*!< Timeouts of the power states and the frame thresholds */
+        int dim_brightness = 20;            /*!< Backlight brightness percent in the dimmed state */
+        int fade_ms = 300;                  /*!< Duration of the backlight fades between the states */
+        int static_pclk_hz = 0;             /*!< RGB pixel clock when the content is static, `0` to keep it */
+        int poll_interval_ms = 100;         /*!< Interval to check the touch activity and the frame submissions */
+    };
+
+    /**
+     * @brief Event of the power manager, fired when the power state or the static flag changes
+     */
+    struct PowerEvent {
+        PowerState from = PowerState::ACTIVE;   /*!< State before the event */
+        PowerState to = PowerState::ACTIVE;     /*!< State after the event, the same as `from` for a static change */
+        bool is_content_static = false;         /*!< Whether the content is static after the event */
+        int frame_rate = 0;                     /*!< Frame rate of the last second */
+        int64_t time_us = 0;                    /*!< Time of the event from `esp_timer_get_time()` */
+    };
+
+    /**
+     * @brief Function pointer type for the power event callback
+     *
+     * @param[in] event Power event
+     * @param[in] user_data User data passed to `attachPowerEventCallback()`
+     */
+    using FunctionPowerEventCallback = void (*)(const PowerEvent &event, void *user_data);
+
+    /**
+     * @brief Functions to create the devices in `init()`
+     *
+     * The devices are created by the factories for a runtime configuration, or by the concrete classes for
+     * `BoardDrivers`. Each function returns `true` if successful, `false` otherwise.
+     */
+    struct DeviceCreators {
+        bool (*create_lcd)(
+            BoardConfig::LCD_Config &config, std::shared_ptr<drivers::Bus> &bus, std::shared_ptr<drivers::LCD> &device
+        ) = nullptr;
+        bool (*create_touch)(
+            BoardConfig::TouchConfig &config, std::shared_ptr<drivers::Bus> &bus,
+            std::shared_ptr<drivers::Touch> &device
+        ) = nullptr;
+        bool (*create_backlight)(
+            BoardConfig::BacklightConfig &config, std::shared_ptr<drivers::Backlight> &device
+        ) = nullptr;
+        bool (*create_io_expander)(
+            BoardConfig::IO_ExpanderConfig &config, std::shared_ptr<drivers::IO_Expander> &device
+        ) = nullptr;
+    };
+
     /**
      * @brief Default constructor, initializes the board with default configuration.
      *
@@ -42,11 +113,31 @@ public:
     Board();
 
     /**
-     * @brief Constructor with configuration
+     * @brief Constructor with configuration, the devices are created by the factories according to their names
      *
      * @param[in] config Board configuration structure
      */
-    Board(const BoardConfig &config): _config(config) {}
+    Board(const BoardConfig &config):
+        _config(config),
+        _device_creators(&FACTORY_DEVICE_CREATORS)
+    {
+    }
+
+    /**
+     * @brief Constructor with configuration and the driver classes resolved at compile time
+     *
+     * The devices are created by the classes of `drivers` directly, so the factories and the unused drivers are not
+     * linked. See `BoardDrivers` in `esp_panel_board_drivers.hpp`.
+     *
+     * @param[in] config Board configuration structure
+     * @param[in] drivers `BoardDrivers` type of the board, only the type is used
+     */
+    template <typename Drivers>
+    Board(const BoardConfig &config, Drivers drivers):
+        _config(config),
+        _device_creators(&Drivers::DEVICE_CREATORS)
+    {
+    }
 
     /**
      * @brief Destructor
@@ -71,6 +162,34 @@ public:
      */
     bool configCallback(board::BoardConfig::StageCallbackType type, BoardConfig::FunctionStageCallback callback);
 
+    /**
+     * @brief Begin the independent devices concurrently in `begin()`
+     *
+     * Each device is begun in its own thread after the devices it depends on:
+     *  - The IO expander is begun first, since its pins may be used by the others
+     *  - The touch is begun during the LCD, e.g. during the sleep-out delay of the vendor initialization, unless they
+     *    share the same SPI or I2C host, then the touch is begun after the LCD
+     *  - The backlight is begun after the LCD, so the uninitialized content is not shown
+     *
+     * @param[in] config Configuration of the parallel begin
+     * @return `true` if successful, `false` otherwise
+     * @note This function should be called before `begin()`
+     * @note The stage callbacks of the devices are called in their threads, so they should not access the same
+     *       resource without protection
+     */
+    bool configParallelBegin(const ParallelBeginConfig &config);
+
+    /**
+     * @brief Begin the independent devices concurrently in `begin()` with the default configuration
+     *
+     * @return `true` if successful, `false` otherwise
+     * @note This function should be called before `begin()`
+     */
+    bool configParallelBegin()
+    {
+        return configParallelBegin(ParallelBeginConfig{});
+    }
+
     /**
      * @brief Initialize the panel device
      *
@@ -101,6 +220,90 @@ public:
      */
     bool del();
 
+    /**
+     * @brief Start the power manager, which moves the board through `active -> dimmed -> display-off -> touch-sleep`
+     *        when idle, and back to active on activity
+     *
+     * The activity is detected from the time of the last touch (`drivers::Touch::getLastTouchTimeUs()`, so the touch
+     * should be read by the application or the sampling task), the rate of the LCD drawings, and
+     * `notifyUserActivity()`. In each state:
+     *  - active: display on, touch awake, backlight at the brightness when the state is left last time
+     *  - dimmed: backlight faded to `dim_brightness`
+     *  - display-off: backlight and display off
+     *  - touch-sleep: touch in the sleep mode, if it is supported
+     *
+     * Besides, if `static_pclk_hz` is set and the LCD uses the RGB bus, the pixel clock is lowered while no frame is
+     * drawn for `policy.static_timeout_ms`.
+     *
+     * @param[in] config Configuration of the power manager
+     * @return `true` if successful, `false` otherwise
+     * @note This function should be called after `begin()`
+     * @note The devices are controlled in the `esp_timer` task
+     * @note In the touch-sleep state, most controllers can't report touches, so `notifyUserActivity()` should be
+     *       called by another wakeup source (e.g. a button or the touch interrupt)
+     */
+    bool startPowerManager(const PowerManagerConfig &config);
+
+    /**
+     * @brief Start the power manager with the default configuration
+     *
+     * @return `true` if successful, `false` otherwise
+     */
+    bool startPowerManager()
+    {
+        return startPowerManager(PowerManagerConfig{});
+    }
+
+    /**
+     * @brief Stop the power manager and restore the active state
+     *
+     * @return `true` if successful, `false` otherwise
+     */
+    bool stopPowerManager();
+
+    /**
+     * @brief Notify a user activity from the application, the board returns to the active state immediately
+     *
+     * @return `true` if successful, `false` otherwise
+     */
+    bool notifyUserActivity();
+
+    /**
+     * @brief Attach a callback function to observe the power events
+     *
+     * @param[in] callback Function to be called on each event, `nullptr` to detach
+     * @param[in] user_data User data to pass to callback function
+     * @return `true` if successful, `false` otherwise
+     * @note The callback is called after the devices are switched, from the `esp_timer` task or the caller of
+     *       `notifyUserActivity()`
+     */
+    bool attachPowerEventCallback(FunctionPowerEventCallback callback, void *user_data = nullptr);
+
+    /**
+     * @brief Get the current power state
+     *
+     * @return Power state, `PowerState::ACTIVE` if the power manager is not running
+     */
+    PowerState getPowerState();
+
+    /**
+     * @brief Get the total time spent in a power state since `startPowerManager()`, to measure the energy savings
+     *
+     * @param[in] state Power state to query
+     * @return Time in microseconds, `0` if the power manager is not running
+     */
+    int64_t getPowerStateTimeUs(PowerState state);
+
+    /**
+     * @brief Check if the power manager is running
+     *
+     * @return `true` if running, `false` otherwise
+     */
+    bool isPowerManagerRunning() const
+    {
+        return (std::atomic_load(&_power_manager) != nullptr);
+    }
+
     /**
      * @brief Check if current state is greater than or equal to given state
      *
@@ -162,6 +365,26 @@ public:
         return _config;
     }
 
+#if ESP_PANEL_DRIVERS_ENABLE_PROFILER
+    /**
+     * @brief Get the boot profile
+     *
+     * The records are cleared at the start of `init()`, then the stages of `init()` and `begin()` are recorded,
+     * including the stage callbacks, the LCD reset and each vendor initialization command.
+     *
+     * @return Reference to the profiler, use `utils::Profiler::getRecords()` to read the records
+     * @note Only available when `ESP_PANEL_DRIVERS_ENABLE_PROFILER` is enabled
+     */
+    const utils::Profiler &getBootProfile() const;
+
+    /**
+     * @brief Print the boot profile as a tree, one stage per line
+     *
+     * @note Only available when `ESP_PANEL_DRIVERS_ENABLE_PROFILER` is enabled
+     */
+    void printBootProfile() const;
+#endif // ESP_PANEL_DRIVERS_ENABLE_PROFILER
+
     /**
      * @brief Alias for backward compatibility
      * @deprecated Use `configIO_Expander()` instead
@@ -213,6 +436,104 @@ public:
     }
 
 private:
+    /**
+     * @brief Stages to begin the devices, in the topological order of the dependencies
+     */
+    enum BeginStage : uint8_t {
+        BEGIN_STAGE_IO_EXPANDER = 0,
+        BEGIN_STAGE_LCD,
+        BEGIN_STAGE_TOUCH,
+        BEGIN_STAGE_BACKLIGHT,
+        BEGIN_STAGE_MAX,
+    };
+
+    /**
+     * @brief Begin the IO expander if it is used and not begun
+     *
+     * @return `true` if successful, `false` otherwise
+     */
+    bool beginIO_Expander();
+
+    /**
+     * @brief Begin the LCD if it is used
+     *
+     * @return `true` if successful, `false` otherwise
+     */
+    bool beginLCD();
+
+    /**
+     * @brief Begin the touch if it is used
+     *
+     * @return `true` if successful, `false` otherwise
+     */
+    bool beginTouch();
+
+    /**
+     * @brief Begin the backlight if it is used
+     *
+     * @return `true` if successful, `false` otherwise
+     */
+    bool beginBacklight();
+
+    /**
+     * @brief Begin all stages in parallel threads according to their dependencies
+     *
+     * @return `true` if all stages are successful, `false` otherwise
+     */
+    bool beginDevicesParallel();
+
+    /**
+     * @brief State of the power manager
+     */
+    struct PowerManager {
+        PowerManagerConfig config = {};
+        utils::PowerPolicy policy;
+        std::mutex mutex;
+        esp_timer_handle_t timer = nullptr;
+        FunctionPowerEventCallback callback = nullptr;
+        void *user_data = nullptr;
+        int active_brightness = 100;
+        int64_t last_touch_time_us = -1;
+        uint32_t last_draw_count = 0;
+        bool is_pclk_lowered = false;
+        bool is_stopped = false;
+    };
+
+    /**
+     * @brief Update the power policy and switch the devices if the state changes
+     *
+     * @param[in] manager Power manager
+     * @param[in] is_activity Whether to record a user activity before the update
+     */
+    void updatePower(PowerManager &manager, bool is_activity);
+
+    /**
+     * @brief Switch the devices to a power state
+     *
+     * @param[in] manager Power manager
+     * @param[in] from Current power state
+     * @param[in] to Target power state
+     */
+    void applyPowerState(PowerManager &manager, PowerState from, PowerState to);
+
+    /**
+     * @brief Set the RGB pixel clock according to the static flag
+     *
+     * @param[in] manager Power manager
+     * @param[in] is_static Whether the content is static
+     */
+    void applyContentStatic(PowerManager &manager, bool is_static);
+
+    static void onPowerTimer(void *arg);
+
+    /**
+     * @brief Get the stages which should be finished before a stage
+     *
+     * @param[in] stage Stage to check
+     * @return Bit mask of the stages
+     */
+    uint32_t getBeginDependencies(BeginStage stage);
+
     /**
      * @brief Set the current board state
      *
@@ -263,15 +584,22 @@ private:
         return _config.io_expander.has_value();
     }
 
+    // Defined in `esp_panel_board_factory.cpp`, which is only linked if the factories are used
+    static const DeviceCreators FACTORY_DEVICE_CREATORS;
+
     BoardConfig _config = {};
+    const DeviceCreators *_device_creators = nullptr;
     bool _use_default_config = false;
     State _state = State::DEINIT;
+    std::optional<ParallelBeginConfig> _parallel_begin_config;
     std::shared_ptr<drivers::Bus> _lcd_bus = nullptr;
     std::shared_ptr<drivers::LCD> _lcd_device = nullptr;
     std::shared_ptr<drivers::Backlight> _backlight = nullptr;
     std::shared_ptr<drivers::Bus> _touch_bus = nullptr;
     std::shared_ptr<drivers::Touch> _touch_device = nullptr;
     std::shared_ptr<drivers::IO_Expander> _io_expander = nullptr;
+    // Accessed by `std::atomic_load()` and `std::atomic_store()`, since it's also read by the timer task
+    std::shared_ptr<PowerManager> _power_manager = nullptr;
 };
 
 } // namespace esp_panel
@@ -0,0 +1,177 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <memory>
+#include <type_traits>
+#include <variant>
+#include "utils/esp_panel_utils_log.h"
+#include "utils/esp_panel_utils_cxx.hpp"
+#include "drivers/io_expander/esp_panel_io_expander_adapter.hpp"
+#include "esp_panel_board.hpp"
+
+namespace esp_panel::board {
+
+/**
+ * @brief Check if a type is one of the alternatives of a variant
+ */
+template <typename T, typename Variant>
+struct IsVariantAlternative;
+
+template <typename T, typename... Types>
+struct IsVariantAlternative<T, std::variant<Types...>>: std::disjunction<std::is_same<T, Types>...> {};
+
+/**
+ * @brief Bus and device classes of a device created on a bus, e.g. the LCD or the touch
+ *
+ * @tparam BusClass Class of the bus, e.g. `drivers::BusSPI`
+ * @tparam DeviceClass Class of the device, e.g. `drivers::LCD_ST7789` or `drivers::TouchGT911`
+ */
+template <class BusClass, class DeviceClass>
+struct BoardBusDevice {
+    using Bus = BusClass;
+    using Device = DeviceClass;
+};
+
+/**
+ * @brief Driver classes of a board, resolved at compile time
+ *
+ * The devices are created by their concrete classes instead of the name lookups of the factories, so only the
+ * specified drivers are linked. Use it when the board is known at compile time:
+ *
+ * @code{.cpp}
+ * using MyDrivers = BoardDrivers<
+ *     BoardBusDevice<drivers::BusSPI, drivers::LCD_ST7789>, BoardBusDevice<drivers::BusI2C, drivers::TouchGT911>,
+ *     drivers::BacklightPWM_LEDC
+ * >;
+ * Board board(MY_BOARD_CONFIG, MyDrivers());
+ * @endcode
+ *
+ * @tparam LCD `BoardBusDevice` of the LCD, `void` if not used
+ * @tparam Touch `BoardBusDevice` of the touch, `void` if not used
+ * @tparam BacklightClass Class of the backlight, e.g. `drivers::BacklightPWM_LEDC`, `void` if not used
+ * @tparam IO_ExpanderClass Class of the IO expander, e.g. `drivers::IO_ExpanderAdapter<esp_expander::TCA95XX_8BIT>`,
+ *                          `void` if not used
+ * @note The configurations in `BoardConfig` should match the classes, which is checked in `Board::init()`
+ */
+template <class LCD = void, class Touch = void, class BacklightClass = void, class IO_ExpanderClass = void>
+struct BoardDrivers {
+    static bool createLCD(
+        BoardConfig::LCD_Config &config, std::shared_ptr<drivers::Bus> &bus, std::shared_ptr<drivers::LCD> &device
+    )
+    {
+        if constexpr (std::is_void_v<LCD>) {
+            ESP_UTILS_CHECK_FALSE_RETURN(false, false, "LCD driver is not specified");
+        } else {
+            using BusConfig = typename LCD::Bus::Config;
+            static_assert(
+                IsVariantAlternative<BusConfig, drivers::BusFactory::Config>::value, "LCD bus config is not supported"
+            );
+            static_assert(std::is_base_of_v<drivers::LCD, typename LCD::Device>, "LCD class is not an LCD driver");
+
+            ESP_UTILS_CHECK_FALSE_RETURN(
+                std::holds_alternative<BusConfig>(config.bus_config), false, "LCD bus config mismatches the bus class"
+            );
+            ESP_UTILS_CHECK_EXCEPTION_RETURN(
+                (bus = utils::make_shared<typename LCD::Bus>(std::get<BusConfig>(config.bus_config))), false,
+                "Create LCD bus failed"
+            );
+            ESP_UTILS_CHECK_EXCEPTION_RETURN(
+                (device = utils::make_shared<typename LCD::Device>(bus.get(), config.device_config)), false,
+                "Create LCD device failed"
+            );
+        }
+
+        return true;
+    }
+
+    static bool createTouch(
+        BoardConfig::TouchConfig &config, std::shared_ptr<drivers::Bus> &bus, std::shared_ptr<drivers::Touch> &device
+    )
+    {
+        if constexpr (std::is_void_v<Touch>) {
+            ESP_UTILS_CHECK_FALSE_RETURN(false, false, "Touch driver is not specified");
+        } else {
+            using BusConfig = typename Touch::Bus::Config;
+            static_assert(
+                IsVariantAlternative<BusConfig, drivers::BusFactory::Config>::value, "Touch bus config is not supported"
+            );
+            static_assert(
+                std::is_base_of_v<drivers::Touch, typename Touch::Device>, "Touch class is not a touch driver"
+            );
+
+            ESP_UTILS_CHECK_FALSE_RETURN(
+                std::holds_alternative<BusConfig>(config.bus_config), false,
+                "Touch bus config mismatches the bus class"
+            );
+            ESP_UTILS_CHECK_EXCEPTION_RETURN(
+                (bus = utils::make_shared<typename Touch::Bus>(std::get<BusConfig>(config.bus_config))), false,
+                "Create touch bus failed"
+            );
+            ESP_UTILS_CHECK_EXCEPTION_RETURN(
+                (device = utils::make_shared<typename Touch::Device>(bus.get(), config.device_config)), false,
+                "Create touch device failed"
+            );
+        }
+
+        return true;
+    }
+
+    static bool createBacklight(BoardConfig::BacklightConfig &config, std::shared_ptr<drivers::Backlight> &device)
+    {
+        if constexpr (std::is_void_v<BacklightClass>) {
+            ESP_UTILS_CHECK_FALSE_RETURN(false, false, "Backlight driver is not specified");
+        } else {
+            using DeviceConfig = typename BacklightClass::Config;
+            static_assert(
+                IsVariantAlternative<DeviceConfig, drivers::BacklightFactory::Config>::value,
+                "Backlight config is not supported"
+            );
+
+            ESP_UTILS_CHECK_FALSE_RETURN(
+                std::holds_alternative<DeviceConfig>(config.config), false,
+                "Backlight config mismatches the backlight class"
+            );
+            ESP_UTILS_CHECK_EXCEPTION_RETURN(
+                (device = utils::make_shared<BacklightClass>(std::get<DeviceConfig>(config.config))), false,
+                "Create backlight device failed"
+            );
+        }
+
+        return true;
+    }
+
+    static bool createIO_Expander(
+        BoardConfig::IO_ExpanderConfig &config, std::shared_ptr<drivers::IO_Expander> &device
+    )
+    {
+        if constexpr (std::is_void_v<IO_ExpanderClass>) {
+            ESP_UTILS_CHECK_FALSE_RETURN(false, false, "IO expander driver is not specified");
+        } else {
+            static_assert(
+                std::is_base_of_v<drivers::IO_Expander, IO_ExpanderClass>,
+                "IO expander class is not an IO expander driver"
+            );
+
+            ESP_UTILS_CHECK_EXCEPTION_RETURN(
+                (device = utils::make_shared<IO_ExpanderClass>(
+                              drivers::IO_Expander::BasicAttributes{config.name}, config.config
+                          )), false, "Create IO expander device failed"
+            );
+        }
+
+        return true;
+    }
+
+    static constexpr Board::DeviceCreators DEVICE_CREATORS = {
+        .create_lcd = createLCD,
+        .create_touch = createTouch,
+        .create_backlight = createBacklight,
+        .create_io_expander = createIO_Expander,
+    };
+};
+
+} // namespace esp_panel::board
@@ -0,0 +1,67 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "utils/esp_panel_utils_log.h"
+#include "esp_panel_board.hpp"
+
+/**
+ * The factories are only referenced by this file, which is only linked if `Board(const BoardConfig &config)` is used.
+ * So the name tables of the factories and all the drivers in them are dropped from the images using `BoardDrivers`.
+ */
+
+namespace esp_panel::board {
+
+static bool create_lcd(
+    BoardConfig::LCD_Config &config, std::shared_ptr<drivers::Bus> &bus, std::shared_ptr<drivers::LCD> &device
+)
+{
+    // The bus is created and owned by the LCD device
+    bus = nullptr;
+    device = drivers::LCD_Factory::create(config.device_name, config.bus_config, config.device_config);
+    ESP_UTILS_CHECK_NULL_RETURN(device, false, "Create LCD device failed");
+
+    return true;
+}
+
+static bool create_touch(
+    BoardConfig::TouchConfig &config, std::shared_ptr<drivers::Bus> &bus, std::shared_ptr<drivers::Touch> &device
+)
+{
+    // The bus is created and owned by the touch device
+    bus = nullptr;
+    device = drivers::TouchFactory::create(config.device_name, config.bus_config, config.device_config);
+    ESP_UTILS_CHECK_NULL_RETURN(device, false, "Create touch device failed");
+
+    return true;
+}
+
+static bool create_backlight(BoardConfig::BacklightConfig &config, std::shared_ptr<drivers::Backlight> &device)
+{
+    auto type = drivers::BacklightFactory::getConfigType(config.config);
+    ESP_UTILS_LOGD("Backlight type: %s[%d]", drivers::BacklightFactory::getTypeNameString(type).c_str(), type);
+
+    device = drivers::BacklightFactory::create(config.config);
+    ESP_UTILS_CHECK_NULL_RETURN(device, false, "Create backlight device failed");
+
+    return true;
+}
+
+static bool create_io_expander(BoardConfig::IO_ExpanderConfig &config, std::shared_ptr<drivers::IO_Expander> &device)
+{
+    device = drivers::IO_ExpanderFactory::create(config.name, config.config);
+    ESP_UTILS_CHECK_NULL_RETURN(device, false, "Create IO expander device failed");
+
+    return true;
+}
+
+const Board::DeviceCreators Board::FACTORY_DEVICE_CREATORS = {
+    .create_lcd = create_lcd,
+    .create_touch = create_touch,
+    .create_backlight = create_backlight,
+    .create_io_expander = create_io_expander,
+};
+
+} // namespace esp_panel::board
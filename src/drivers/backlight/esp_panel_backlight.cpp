@@ -1,14 +1,67 @@
 /*
- * SPDX-FileCopyrightText: 2023-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2023-2025 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <cmath>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
 #include "utils/esp_panel_utils_log.h"
 #include "esp_panel_backlight_factory.hpp"
 
 namespace esp_panel::drivers {
 
+/**
+ * @brief Wait until the callback running in the esp_timer task returns
+ *
+ * The callbacks of the timers dispatched by `ESP_TIMER_TASK` are run one by one in the esp_timer task, so the running
+ * one has returned once a later dispatched callback is run.
+ */
+static void wait_timer_task_callback()
+{
+    if (xTaskGetCurrentTaskHandle() == xTaskGetHandle("esp_timer")) {
+        return;
+    }
+
+    StaticSemaphore_t sem_buffer;
+    SemaphoreHandle_t sem = xSemaphoreCreateBinaryStatic(&sem_buffer);
+    esp_timer_create_args_t timer_args = {
+        .callback = [](void *arg) {
+            xSemaphoreGive(static_cast<SemaphoreHandle_t>(arg));
+        },
+        .arg = sem,
+        .dispatch_method = ESP_TIMER_TASK,
+        .name = "backlight_sync",
+        .skip_unhandled_events = false,
+    };
+    esp_timer_handle_t timer = nullptr;
+    if ((esp_timer_create(&timer_args, &timer) == ESP_OK) && (esp_timer_start_once(timer, 1) == ESP_OK)) {
+        xSemaphoreTake(sem, portMAX_DELAY);
+    } else {
+        ESP_UTILS_LOGE("Start sync timer failed");
+    }
+    if (timer != nullptr) {
+        esp_timer_delete(timer);
+    }
+    vSemaphoreDelete(sem);
+}
+
+Backlight::~Backlight()
+{
+    if (_fade_timer != nullptr) {
+        {
+            std::lock_guard<std::mutex> lock(_fade_mutex);
+            esp_timer_stop(_fade_timer);
+            _fade.is_running = false;
+        }
+        // The callback may be still running, wait for it before deleting the timer and destroying the members
+        wait_timer_task_callback();
+        esp_timer_delete(_fade_timer);
+    }
+}
+
 bool Backlight::on()
 {
     ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
@@ -35,4 +88,147 @@ bool Backlight::off()
     return true;
 }
 
+bool Backlight::fadeTo(
+    int percent, int duration_ms, FadeCurve curve, FunctionFadeFinishCallback callback, void *user_data
+)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(isOverState(State::BEGIN), false, "Not begun");
+
+    ESP_UTILS_LOGD(
+        "Param: percent(%d), duration_ms(%d), curve(%d), callback(%p), user_data(%p)", percent, duration_ms,
+        static_cast<int>(curve), callback, user_data
+    );
+
+    ESP_UTILS_CHECK_FALSE_RETURN(stopFade(), false, "Stop fade failed");
+
+    percent = std::clamp(percent, 0, 100);
+    if ((duration_ms <= 0) || (percent == getBrightness())) {
+        ESP_UTILS_CHECK_FALSE_RETURN(setBrightness(percent), false, "Set brightness failed");
+        if (callback != nullptr) {
+            callback(getBrightness(), user_data);
+        }
+        ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+        return true;
+    }
+
+    if (_fade_timer == nullptr) {
+        esp_timer_create_args_t timer_args = {
+            .callback = onFadeTimer,
+            .arg = this,
+            .dispatch_method = ESP_TIMER_TASK,
+            .name = "backlight_fade",
+            .skip_unhandled_events = true,
+        };
+        ESP_UTILS_CHECK_ERROR_RETURN(esp_timer_create(&timer_args, &_fade_timer), false, "Create fade timer failed");
+    }
+
+    // The hardware fades linearly, so only the gamma curve needs to be split into segments
+    bool is_hardware = isHardwareFadeSupported();
+    int step_num = std::max(duration_ms / FADE_SOFTWARE_INTERVAL_MS, 1);
+    if (is_hardware) {
+        step_num = (curve == FadeCurve::LINEAR) ? 1 : std::min(step_num, FADE_HARDWARE_GAMMA_SEGMENTS);
+    }
+
+    std::lock_guard<std::mutex> lock(_fade_mutex);
+    _fade = Fade{
+        .plan = utils::FadePlan(getBrightness(), percent, step_num, curve),
+        .step = 0,
+        .interval_ms = duration_ms / step_num,
+        .is_hardware = is_hardware,
+        .is_running = true,
+        .callback = callback,
+        .user_data = user_data,
+    };
+    ESP_UTILS_LOGD(
+        "Start %s fade with %d steps of %d ms", is_hardware ? "hardware" : "software", step_num, _fade.interval_ms
+    );
+
+    if (is_hardware && !startHardwareFade(_fade.plan.getLevel(1), _fade.interval_ms)) {
+        _fade.is_running = false;
+        ESP_UTILS_CHECK_FALSE_RETURN(false, false, "Start hardware fade failed");
+    }
+    esp_err_t ret = esp_timer_start_periodic(_fade_timer, _fade.interval_ms * 1000);
+    if (ret != ESP_OK) {
+        if (is_hardware) {
+            stopHardwareFade();
+        }
+        _fade.is_running = false;
+        ESP_UTILS_CHECK_ERROR_RETURN(ret, false, "Start fade timer failed");
+    }
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool Backlight::stopFade()
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    std::lock_guard<std::mutex> lock(_fade_mutex);
+    if (_fade.is_running) {
+        esp_timer_stop(_fade_timer);
+        _fade.is_running = false;
+        if (_fade.is_hardware) {
+            ESP_UTILS_CHECK_FALSE_RETURN(stopHardwareFade(), false, "Stop hardware fade failed");
+        }
+        ESP_UTILS_LOGD("Fade stopped at step %d/%d", _fade.step, _fade.plan.getStepNum());
+    }
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool Backlight::isFading()
+{
+    std::lock_guard<std::mutex> lock(_fade_mutex);
+
+    return _fade.is_running;
+}
+
+void Backlight::onFadeTimer(void *arg)
+{
+    auto backlight = static_cast<Backlight *>(arg);
+    FunctionFadeFinishCallback callback = nullptr;
+    void *user_data = nullptr;
+
+    {
+        std::lock_guard<std::mutex> lock(backlight->_fade_mutex);
+        auto &fade = backlight->_fade;
+        if (!fade.is_running) {
+            return;
+        }
+
+        fade.step++;
+        int percent = static_cast<int>(std::lround(fade.plan.getLevel(fade.step)));
+        bool is_finished = (fade.step >= fade.plan.getStepNum());
+        if (fade.is_hardware) {
+            // The segment has been done by the hardware, continue with the next one
+            backlight->setBrightnessValue(percent);
+            if (!is_finished && !backlight->startHardwareFade(fade.plan.getLevel(fade.step + 1), fade.interval_ms)) {
+                ESP_UTILS_LOGE("Start hardware fade failed, stop fade");
+                is_finished = true;
+            }
+        } else if ((percent != backlight->getBrightness()) && !backlight->setBrightness(percent)) {
+            ESP_UTILS_LOGE("Set brightness failed, stop fade");
+            is_finished = true;
+        }
+
+        if (is_finished) {
+            esp_timer_stop(backlight->_fade_timer);
+            fade.is_running = false;
+            callback = fade.callback;
+            user_data = fade.user_data;
+        }
+    }
+
+    // Call it without the lock, so the callback can start another fade
+    if (callback != nullptr) {
+        callback(backlight->getBrightness(), user_data);
+    }
+}
+
 } // namespace esp_panel::drivers
@@ -6,7 +6,10 @@
 #pragma once
 
 #include <algorithm>
+#include <mutex>
 #include <string>
+#include "esp_timer.h"
+#include "utils/esp_panel_utils_fade.hpp"
 #include "esp_panel_backlight_conf_internal.h"
 
 namespace esp_panel::drivers {
@@ -35,6 +38,22 @@ public:
         BEGIN,         ///< Driver is initialized and ready
     };
 
+    /**
+     * @brief Curve of the brightness fade, see `utils::FadeCurve`
+     */
+    using FadeCurve = utils::FadeCurve;
+
+    /**
+     * @brief Function pointer type for the fade finish callback
+     *
+     * @param[in] percent   The brightness percent (0-100) at the end of the fade
+     * @param[in] user_data User data passed to `fadeTo()`
+     */
+    using FunctionFadeFinishCallback = void (*)(int percent, void *user_data);
+
+    static constexpr int FADE_SOFTWARE_INTERVAL_MS = 20;
+    static constexpr int FADE_HARDWARE_GAMMA_SEGMENTS = 8;
+
     /**
      * @brief Construct a new backlight device
      *
@@ -45,7 +64,7 @@ public:
     /**
      * @brief Destroy the backlight device
      */
-    virtual ~Backlight() = default;
+    virtual ~Backlight();
 
     /**
      * @brief Initialize and start the backlight device
@@ -94,6 +113,48 @@ public:
      */
     bool off();
 
+    /**
+     * @brief Fade the brightness to the target percent without blocking
+     *
+     * If the device supports hardware fade (e.g. LEDC), the fade is done by the hardware: the linear curve is a single
+     * hardware fade, and the gamma curve is approximated by `FADE_HARDWARE_GAMMA_SEGMENTS` linear hardware fades.
+     * Otherwise, the brightness is set by a timer every `FADE_SOFTWARE_INTERVAL_MS` milliseconds, and only when the
+     * percent changes.
+     *
+     * @param[in] percent     The target brightness percent (0-100)
+     * @param[in] duration_ms The duration of the fade in milliseconds, `0` to set the brightness immediately
+     * @param[in] curve       The curve of the fade
+     * @param[in] callback    The callback function called when the fade finishes, `nullptr` if not used
+     * @param[in] user_data   The user data passed to the callback function
+     *
+     * @return `true` if successful, `false` otherwise
+     *
+     * @note This function should be called after `begin()`
+     * @note The running fade is stopped first, and its callback is not called
+     * @note The callback is called from the `esp_timer` task, or from the caller if `duration_ms` is `0`
+     * @note Calling `setBrightness()` during the fade doesn't stop it, call `stopFade()` first
+     */
+    bool fadeTo(
+        int percent, int duration_ms, FadeCurve curve = FadeCurve::GAMMA,
+        FunctionFadeFinishCallback callback = nullptr, void *user_data = nullptr
+    );
+
+    /**
+     * @brief Stop the running fade at the current brightness
+     *
+     * @return `true` if successful or no fade is running, `false` otherwise
+     *
+     * @note The fade finish callback is not called
+     */
+    bool stopFade();
+
+    /**
+     * @brief Check if a fade is running
+     *
+     * @return `true` if running, `false` otherwise
+     */
+    bool isFading();
+
     /**
      * @brief Check if the driver has reached or passed the specified state
      *
@@ -147,10 +208,59 @@ protected:
         _brightness = std::clamp(percent, 0, 100);
     }
 
+    /**
+     * @brief Check if the device supports hardware fade, the derived class should override it along with
+     *        `startHardwareFade()` and `stopHardwareFade()`
+     *
+     * @return `true` if supported, `false` otherwise
+     */
+    virtual bool isHardwareFadeSupported()
+    {
+        return false;
+    }
+
+    /**
+     * @brief Start a linear hardware fade from the current brightness without blocking
+     *
+     * @param[in] percent     The target brightness percent, which can be fractional
+     * @param[in] duration_ms The duration of the fade in milliseconds
+     *
+     * @return `true` if successful, `false` otherwise
+     */
+    virtual bool startHardwareFade(float percent, int duration_ms)
+    {
+        return false;
+    }
+
+    /**
+     * @brief Stop the running hardware fade
+     *
+     * @return `true` if successful, `false` otherwise
+     */
+    virtual bool stopHardwareFade()
+    {
+        return true;
+    }
+
 private:
+    struct Fade {
+        utils::FadePlan plan = utils::FadePlan(0, 0, 1, FadeCurve::LINEAR);
+        int step = 0;
+        int interval_ms = 0;
+        bool is_hardware = false;
+        bool is_running = false;
+        FunctionFadeFinishCallback callback = nullptr;
+        void *user_data = nullptr;
+    };
+
+    static void onFadeTimer(void *arg);
+
     State _state = State::DEINIT;               ///< Current driver state
     BasicAttributes _basic_attributes = {};     ///< Device basic attributes
     int _brightness = 0;                        ///< Current brightness percent (0-100)
+    std::mutex _fade_mutex;                     ///< Mutex to protect the fade
+    Fade _fade = {};                            ///< Running fade
+    esp_timer_handle_t _fade_timer = nullptr;   ///< Timer to run the fade steps
 };
 
 } // namespace esp_panel::drivers
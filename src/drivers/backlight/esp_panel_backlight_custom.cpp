@@ -51,6 +51,8 @@ bool BacklightCustom::del()
 {
     ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
 
+    ESP_UTILS_CHECK_FALSE_RETURN(stopFade(), false, "Stop fade failed");
+
     setState(State::DEINIT);
 
     ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
@@ -6,9 +6,18 @@
 
 #include "esp_panel_backlight_i2c.hpp"
 #include "utils/esp_panel_utils_log.h"
+#include "drivers/host/esp_panel_host_i2c.hpp"
 
 namespace esp_panel::drivers {
 
+static void on_async_write_finish(const utils::I2CQueue::Transaction &transaction, bool is_success, void *user_data)
+{
+    if (!is_success) {
+        ESP_UTILS_LOGE(
+            "Failed to write command(0x%02X) to I2C backlight(0x%02X)", transaction.write_data[0], transaction.address
+        );
+    }
+}
 
 
 BacklightI2C::BacklightI2C(const Config &config)
@@ -54,6 +63,8 @@ bool BacklightI2C::del()
 {
     ESP_UTILS_LOG_TRACE_ENTER();
 
+    ESP_UTILS_CHECK_FALSE_RETURN(stopFade(), false, "Stop fade failed");
+
     if (!_initialized) {
         ESP_UTILS_LOGW("Not initialized");
         ESP_UTILS_LOG_TRACE_EXIT();
@@ -85,6 +96,28 @@ bool BacklightI2C::setBrightness(int percent)
         return false;
     }
 
+    // Don't block the caller (e.g. the fade timer) if the host executes the transactions asynchronously
+    std::shared_ptr<HostI2C> host = HostI2C::getInstance(static_cast<int>(_config.i2c_config.i2c_port));
+    if ((host != nullptr) && host->isAsync()) {
+        ESP_UTILS_CHECK_FALSE_RETURN((percent >= 0) && (percent <= 100), false, "Invalid brightness percent");
+
+        utils::I2CQueue::Transaction transaction = {
+            .priority = utils::I2CQueue::Priority::BACKGROUND,
+            .address = _config.i2c_config.i2c_addr,
+            .write_size = 2,
+            .write_data = {
+                _config.i2c_config.brightness_cmd,
+                static_cast<uint8_t>((percent * _config.i2c_config.max_brightness) / 100)
+            },
+            .is_batchable = true,
+            .callback = on_async_write_finish,
+        };
+        ESP_UTILS_CHECK_FALSE_RETURN(host->submit(transaction), false, "Submit brightness failed");
+        setBrightnessValue(percent);
+        ESP_UTILS_LOG_TRACE_EXIT();
+        return true;
+    }
+
     esp_err_t ret = esp_panel_backlight_i2c_set_brightness(percent);
     if (ret == ESP_OK) {
         setBrightnessValue(percent);
@@ -66,6 +66,9 @@ public:
      * @param[in] percent The brightness percentage (0-100)
      *
      * @return `true` if successful, `false` otherwise
+     *
+     * @note If the I2C host of the port has started `HostI2C::startAsync()`, the command is submitted with the low
+     *       priority and this function returns without waiting for it
      */
     bool setBrightness(int percent) override;
 
@@ -7,11 +7,15 @@
 #include "esp_panel_backlight_conf_internal.h"
 #if ESP_PANEL_DRIVERS_BACKLIGHT_ENABLE_PWM_LEDC
 
+#include <cmath>
 #include "utils/esp_panel_utils_log.h"
 #include "esp_panel_backlight_pwm_ledc.hpp"
 
 namespace esp_panel::drivers {
 
+// The LEDC fade function is shared by all channels, so only install it once
+static bool is_fade_func_installed = false;
+
 void BacklightPWM_LEDC::Config::convertPartialToFull()
 {
     ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
@@ -183,6 +187,8 @@ bool BacklightPWM_LEDC::del()
 {
     ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
 
+    ESP_UTILS_CHECK_FALSE_RETURN(stopFade(), false, "Stop fade failed");
+
     if (isOverState(State::BEGIN)) {
 #if ESP_IDF_VERSION < ESP_IDF_VERSION_VAL(5, 3, 0)
         auto &channel_config = getLEDC_ChannelConfig();
@@ -237,6 +243,67 @@ bool BacklightPWM_LEDC::setBrightness(int percent)
     return true;
 }
 
+bool BacklightPWM_LEDC::startHardwareFade(float percent, int duration_ms)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(isOverState(State::BEGIN), false, "Not begun");
+
+    ESP_UTILS_LOGD("Param: percent(%.2f), duration_ms(%d)", percent, duration_ms);
+
+    if (!is_fade_func_installed) {
+        esp_err_t ret = ledc_fade_func_install(0);
+        // `ESP_ERR_INVALID_STATE` means it has been installed by others
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            (ret == ESP_OK) || (ret == ESP_ERR_INVALID_STATE), false, "LEDC fade function install failed(%s)",
+            esp_err_to_name(ret)
+        );
+        is_fade_func_installed = true;
+    }
+
+    percent = std::clamp(percent, 0.0f, 100.0f);
+    auto &channel_config = getLEDC_ChannelConfig();
+    auto &timer_config = getLEDC_TimerConfig();
+    uint32_t duty = static_cast<uint32_t>(std::lround((1ULL << timer_config.duty_resolution) * percent / 100));
+
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+    // Don't wait for the previous fade in `ledc_set_fade_with_time()`, the next one continues from the current duty
+    ESP_UTILS_CHECK_ERROR_RETURN(
+        ledc_fade_stop(channel_config.speed_mode, channel_config.channel), false, "LEDC stop fade failed"
+    );
+#endif // ESP_IDF_VERSION
+    ESP_UTILS_CHECK_ERROR_RETURN(
+        ledc_set_fade_with_time(channel_config.speed_mode, channel_config.channel, duty, duration_ms),
+        false, "LEDC set fade failed"
+    );
+    ESP_UTILS_CHECK_ERROR_RETURN(
+        ledc_fade_start(channel_config.speed_mode, channel_config.channel, LEDC_FADE_NO_WAIT),
+        false, "LEDC start fade failed"
+    );
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool BacklightPWM_LEDC::stopHardwareFade()
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+    if (is_fade_func_installed) {
+        auto &channel_config = getLEDC_ChannelConfig();
+        ESP_UTILS_CHECK_ERROR_RETURN(
+            ledc_fade_stop(channel_config.speed_mode, channel_config.channel), false, "LEDC stop fade failed"
+        );
+    }
+#endif // ESP_IDF_VERSION
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
 BacklightPWM_LEDC::LEDC_TimerFullConfig &BacklightPWM_LEDC::getLEDC_TimerConfig()
 {
     if (std::holds_alternative<LEDC_TimerPartialConfig>(_config.ledc_timer)) {
@@ -153,6 +153,45 @@ public:
     [[deprecated("Use other constructors instead")]]
     BacklightPWM_LEDC(int io_num, bool light_up_level, bool use_pwm): BacklightPWM_LEDC(io_num, light_up_level) {}
 
+protected:
+    /**
+     * @brief The LEDC fade engine is used for `fadeTo()`
+     *
+     * @return `true` for ESP-IDF >= v5.0, `false` otherwise since the running fade can't be stopped
+     */
+    bool isHardwareFadeSupported() override
+    {
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * @brief Start a linear LEDC hardware fade from the current duty without blocking
+     *
+     * @param[in] percent     The target brightness percent, which can be fractional
+     * @param[in] duration_ms The duration of the fade in milliseconds
+     *
+     * @return `true` if successful, `false` otherwise
+     *
+     * @note The LEDC fade function is installed on the first call, and is never uninstalled since it's shared by all
+     *       channels
+     * @note If the previous fade is not finished yet, it is stopped at the current duty first, since the LEDC fade
+     *       API waits until it finishes otherwise
+     */
+    bool startHardwareFade(float percent, int duration_ms) override;
+
+    /**
+     * @brief Stop the running LEDC hardware fade
+     *
+     * @return `true` if successful, `false` otherwise
+     *
+     * @note For ESP-IDF < v5.0, the fade can't be stopped and will run to the end
+     */
+    bool stopHardwareFade() override;
+
 private:
     /**
      * @brief Get mutable reference to LEDC timer configuration
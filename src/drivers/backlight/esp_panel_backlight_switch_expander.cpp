@@ -73,6 +73,8 @@ bool BacklightSwitchExpander::del()
 {
     ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
 
+    ESP_UTILS_CHECK_FALSE_RETURN(stopFade(), false, "Stop fade failed");
+
     if (_expander != nullptr) {
         ESP_UTILS_CHECK_FALSE_RETURN(_expander->pinMode(_config.io_num, INPUT), false, "Expander set pin mode failed");
     }
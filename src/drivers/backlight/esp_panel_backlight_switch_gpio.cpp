@@ -67,6 +67,8 @@ bool BacklightSwitchGPIO::del()
 {
     ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
 
+    ESP_UTILS_CHECK_FALSE_RETURN(stopFade(), false, "Stop fade failed");
+
     if (isOverState(State::BEGIN)) {
         ESP_UTILS_CHECK_ERROR_RETURN(gpio_reset_pin((gpio_num_t)_config.io_num), false, "GPIO reset pin failed");
         setState(State::DEINIT);
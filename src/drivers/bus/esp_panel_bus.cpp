@@ -4,7 +4,12 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <algorithm>
 #include <inttypes.h>
+#include <new>
+#include "esp_heap_caps.h"
+#include "esp_memory_utils.h"
+#include "freertos/task.h"
 #include "utils/esp_panel_utils_log.h"
 #include "esp_panel_bus.hpp"
 
@@ -55,10 +60,246 @@ bool Bus::writeColorData(uint32_t address, const void *color, uint32_t color_siz
     ESP_UTILS_LOGD(
         "Param: address(0x%" PRIx32 "), color(%p), color_size(%d)", address, color, static_cast<int>(color_size)
     );
+
+    // The queued path is only used when the bus supports it, the buffer can be accessed by DMA, and no other user
+    // (like the LCD driver) owns the color transfer
+    if (_color_trans_attributes.is_queued && (esp_ptr_dma_capable(color) || esp_ptr_dma_ext_capable(color)) &&
+            ((_color_trans == nullptr) || (_color_trans->on_other_done == nullptr))) {
+        ColorTransferToken token = 0;
+        if (writeColorDataAsync(address, color, color_size, nullptr, nullptr, &token)) {
+            ESP_UTILS_CHECK_FALSE_RETURN(waitColorDataFinish(token), false, "Wait color finish failed");
+            goto end;
+        }
+        ESP_UTILS_LOGW("Write color by the queued path failed, fall back to the polling path");
+    }
+
+    // The polling path is kept for the buses without the queued path (like the 3-wire SPI of the RGB bus) and the
+    // buffers which can't be accessed by DMA (like the ones on the flash)
     ESP_UTILS_CHECK_ERROR_RETURN(
         esp_lcd_panel_io_tx_param(control_panel, address, color, color_size), false, "Write color failed"
     );
 
+end:
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool Bus::writeColorDataAsync(
+    uint32_t address, const void *color, uint32_t color_size, FunctionColorTransferFinishCallback callback,
+    void *user_data, ColorTransferToken *token
+) const
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(isControlPanelValid(), false, "Invalid control panel");
+
+    ESP_UTILS_LOGD(
+        "Param: address(0x%" PRIx32 "), color(%p), color_size(%d), callback(@%p), user_data(@%p), token(@%p)",
+        address, color, static_cast<int>(color_size), callback, user_data, token
+    );
+    ESP_UTILS_CHECK_FALSE_RETURN(_color_trans_attributes.is_queued, false, "Queued color path is not supported");
+    ESP_UTILS_CHECK_FALSE_RETURN((color != nullptr) && (color_size > 0), false, "Invalid color data");
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        esp_ptr_dma_capable(color) || esp_ptr_dma_ext_capable(color), false,
+        "Color buffer(@%p) is not DMA-capable", color
+    );
+
+    if (_color_trans == nullptr) {
+        ESP_UTILS_CHECK_FALSE_RETURN(createColorTransfer(), false, "Create color transfer failed");
+    }
+    auto &trans = *_color_trans;
+
+    uint32_t max_size = _color_trans_attributes.max_transfer_size;
+    uint32_t chunk_size = ((max_size > 0) && (max_size < color_size)) ? max_size : color_size;
+    uint32_t chunks_num = (color_size + chunk_size - 1) / chunk_size;
+
+    // Transactions of different transfers can't be interleaved, otherwise the chunks can't be counted in order
+    std::lock_guard<std::mutex> submit_lock(trans.submit_mutex);
+
+    xSemaphoreTake(trans.slot_sem, portMAX_DELAY);
+    ColorTransferToken trans_token = 0;
+    bool is_owned_by_other = false;
+    portENTER_CRITICAL(&trans.lock);
+    // The completions can't tell their owners, so the bus can't queue transfers while another user owns the event
+    is_owned_by_other = (trans.on_other_done != nullptr);
+    if (!is_owned_by_other) {
+        int tail = (trans.head + trans.num) % trans.depth;
+        trans_token = ++trans.submitted;
+        trans.items[tail] = {
+            .token = trans_token,
+            .chunks_left = chunks_num,
+            .on_finish = callback,
+            .user_data = user_data,
+        };
+        trans.num++;
+    }
+    portEXIT_CRITICAL(&trans.lock);
+    if (is_owned_by_other) {
+        xSemaphoreGive(trans.slot_sem);
+    }
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        !is_owned_by_other, false, "Color transfer is owned by another user (like the LCD driver)"
+    );
+
+    // Only the first transaction sends `address`, the following ones continue the memory write. For QSPI, the
+    // command is placed in the middle of the address, so only its byte is replaced to keep the opcode
+    int continue_cmd = -1;
+    if (_color_trans_attributes.continue_cmd >= 0) {
+        uint32_t shift = _color_trans_attributes.continue_cmd_shift;
+        continue_cmd = static_cast<int>(
+                           (address & ~(static_cast<uint32_t>(0xFF) << shift)) |
+                           (static_cast<uint32_t>(_color_trans_attributes.continue_cmd) << shift)
+                       );
+    }
+    auto data = static_cast<const uint8_t *>(color);
+    for (uint32_t i = 0; i < chunks_num; i++) {
+        uint32_t offset = i * chunk_size;
+        uint32_t size = std::min(chunk_size, color_size - offset);
+        int lcd_cmd = (i == 0) ? static_cast<int>(address) : continue_cmd;
+        auto ret = esp_lcd_panel_io_tx_color(control_panel, lcd_cmd, data + offset, size);
+        if (ret != ESP_OK) {
+            cancelColorTransfer(trans_token, chunks_num - i);
+        }
+        ESP_UTILS_CHECK_ERROR_RETURN(
+            ret, false, "Write color chunk(%d/%d) failed", static_cast<int>(i), static_cast<int>(chunks_num)
+        );
+    }
+
+    if (token != nullptr) {
+        *token = trans_token;
+    }
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool Bus::isColorDataFinished(ColorTransferToken token) const
+{
+    if (_color_trans == nullptr) {
+        return true;
+    }
+
+    // Tokens are increased monotonically, compare them with the wrap-around considered
+    return static_cast<int32_t>(_color_trans->finished - token) >= 0;
+}
+
+bool Bus::waitColorDataFinish(ColorTransferToken token, int timeout_ms) const
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_LOGD("Param: token(%d), timeout_ms(%d)", static_cast<int>(token), timeout_ms);
+    if (_color_trans == nullptr) {
+        goto end;
+    }
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        static_cast<int32_t>(_color_trans->submitted - token) >= 0, false, "Invalid token(%d)",
+        static_cast<int>(token)
+    );
+
+    {
+        auto &trans = *_color_trans;
+        // Each waiter has its own semaphore, so a finished transfer can't wake up the waiter of another one
+        StaticSemaphore_t sem_buffer;
+        ColorTransfer::Waiter waiter = {
+            .token = token,
+            .sem = xSemaphoreCreateBinaryStatic(&sem_buffer),
+        };
+        bool is_waiting = false;
+        portENTER_CRITICAL(&trans.lock);
+        if (!isColorDataFinished(token)) {
+            waiter.next = trans.waiters;
+            trans.waiters = &waiter;
+            is_waiting = true;
+        }
+        portEXIT_CRITICAL(&trans.lock);
+
+        TickType_t timeout_tick = (timeout_ms < 0) ? portMAX_DELAY : pdMS_TO_TICKS(timeout_ms);
+        bool is_finished = !is_waiting || (xSemaphoreTake(waiter.sem, timeout_tick) == pdTRUE);
+        if (!is_finished) {
+            bool is_removed = false;
+            portENTER_CRITICAL(&trans.lock);
+            for (auto node = &trans.waiters; *node != nullptr; node = &(*node)->next) {
+                if (*node == &waiter) {
+                    *node = waiter.next;
+                    is_removed = true;
+                    break;
+                }
+            }
+            portEXIT_CRITICAL(&trans.lock);
+            // Already removed by the interrupt, so the semaphore is going to be given
+            if (!is_removed) {
+                xSemaphoreTake(waiter.sem, portMAX_DELAY);
+                is_finished = true;
+            }
+        }
+        vSemaphoreDelete(waiter.sem);
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            is_finished, false, "Wait color transfer(%d) finish timeout", static_cast<int>(token)
+        );
+    }
+
+end:
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool Bus::waitColorDataAllFinish(int timeout_ms) const
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    if (_color_trans != nullptr) {
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            waitColorDataFinish(_color_trans->submitted, timeout_ms), false, "Wait color finish failed"
+        );
+    }
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool Bus::registerColorTransferDoneCallback(esp_lcd_panel_io_color_trans_done_cb_t callback, void *user_ctx)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(isControlPanelValid(), false, "Invalid control panel");
+
+    ESP_UTILS_LOGD("Param: callback(@%p), user_ctx(@%p)", callback, user_ctx);
+    // No transfer is queued by the bus, so the event of the control panel is left to the user
+    if (!_color_trans_attributes.is_queued) {
+        esp_lcd_panel_io_callbacks_t io_cb = {
+            .on_color_trans_done = callback,
+        };
+        ESP_UTILS_CHECK_ERROR_RETURN(
+            esp_lcd_panel_io_register_event_callbacks(control_panel, &io_cb, user_ctx), false,
+            "Register control panel event callback failed"
+        );
+        goto end;
+    }
+
+    if (_color_trans == nullptr) {
+        ESP_UTILS_CHECK_FALSE_RETURN(createColorTransfer(), false, "Create color transfer failed");
+    }
+
+    {
+        // The completions are counted by the owner of the event, so the transfers of the bus should finish first
+        ESP_UTILS_CHECK_FALSE_RETURN(waitColorDataAllFinish(), false, "Wait color finish failed");
+        auto &trans = *_color_trans;
+        bool is_idle = false;
+        portENTER_CRITICAL(&trans.lock);
+        is_idle = (trans.num == 0);
+        if (is_idle) {
+            trans.on_other_done = callback;
+            trans.other_done_ctx = user_ctx;
+        }
+        portEXIT_CRITICAL(&trans.lock);
+        ESP_UTILS_CHECK_FALSE_RETURN(is_idle, false, "Color transfer is still in use");
+    }
+
+end:
     ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
 
     return true;
@@ -73,10 +314,162 @@ bool Bus::delControlPanel()
     ESP_UTILS_CHECK_ERROR_RETURN(esp_lcd_panel_io_del(control_panel), false, "Delete control panel failed");
     ESP_UTILS_LOGD("Delete control panel @%p", control_panel);
     control_panel = nullptr;
+    // The queue is bound to the event of the deleted control panel
+    _color_trans = nullptr;
 
     ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
 
     return true;
 }
 
+Bus::ColorTransfer::~ColorTransfer()
+{
+    if (slot_sem != nullptr) {
+        vSemaphoreDelete(slot_sem);
+    }
+    if (items != nullptr) {
+        heap_caps_free(items);
+    }
+}
+
+bool Bus::createColorTransfer() const
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(_color_trans == nullptr, false, "Already created");
+
+    int depth = _color_trans_attributes.trans_queue_depth;
+    ESP_UTILS_CHECK_FALSE_RETURN(depth > 0, false, "Invalid queue depth(%d)", depth);
+
+    // Accessed in the interrupt context, so it should be placed in internal RAM rather than PSRAM
+    void *trans_mem = heap_caps_malloc(sizeof(ColorTransfer), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    ESP_UTILS_CHECK_NULL_RETURN(trans_mem, false, "Malloc color transfer failed");
+    auto trans_deleter = [](ColorTransfer * trans) {
+        trans->~ColorTransfer();
+        heap_caps_free(trans);
+    };
+    std::shared_ptr<ColorTransfer> trans = nullptr;
+    ESP_UTILS_CHECK_EXCEPTION_RETURN(
+        trans = std::shared_ptr<ColorTransfer>(new (trans_mem) ColorTransfer(), trans_deleter), false,
+        "Create color transfer failed"
+    );
+    trans->items = static_cast<ColorTransfer::Item *>(
+                       heap_caps_calloc(depth, sizeof(ColorTransfer::Item), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT)
+                   );
+    ESP_UTILS_CHECK_NULL_RETURN(trans->items, false, "Malloc color transfer items failed");
+    trans->depth = depth;
+    trans->slot_sem = xSemaphoreCreateCounting(depth, depth);
+    ESP_UTILS_CHECK_NULL_RETURN(trans->slot_sem, false, "Create color transfer slot semaphore failed");
+
+    esp_lcd_panel_io_callbacks_t io_cb = {
+        .on_color_trans_done = onColorTransferDone,
+    };
+    ESP_UTILS_CHECK_ERROR_RETURN(
+        esp_lcd_panel_io_register_event_callbacks(control_panel, &io_cb, trans.get()), false,
+        "Register control panel event callback failed"
+    );
+    _color_trans = trans;
+    ESP_UTILS_LOGD("Color transfer created, depth(%d)", depth);
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+void Bus::cancelColorTransfer(ColorTransferToken token, uint32_t chunks_unsent) const
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    auto &trans = *_color_trans;
+    bool is_canceled = false;
+    portENTER_CRITICAL(&trans.lock);
+    // The transfer is the latest one since `submit_mutex` is held, drop the transactions which will never finish
+    if ((trans.num > 0) && (trans.submitted == token)) {
+        auto &item = trans.items[(trans.head + trans.num - 1) % trans.depth];
+        item.chunks_left -= std::min(item.chunks_left, chunks_unsent);
+        // If no transaction is queued, remove the whole transfer, otherwise it finishes with the queued ones
+        if (item.chunks_left == 0) {
+            trans.num--;
+            trans.submitted--;
+            is_canceled = true;
+        }
+    }
+    portEXIT_CRITICAL(&trans.lock);
+
+    if (is_canceled) {
+        xSemaphoreGive(trans.slot_sem);
+    }
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+}
+
+IRAM_ATTR bool Bus::onColorTransferDone(
+    esp_lcd_panel_io_handle_t panel_io, esp_lcd_panel_io_event_data_t *edata, void *user_ctx
+)
+{
+    auto trans = static_cast<ColorTransfer *>(user_ctx);
+    if (trans == nullptr) {
+        return false;
+    }
+
+    BaseType_t need_yield = pdFALSE;
+    ColorTransfer::Item item = {};
+    bool is_own = false;
+    bool is_finished = false;
+    ColorTransfer::Waiter *finished_waiters = nullptr;
+    esp_lcd_panel_io_color_trans_done_cb_t other_callback = nullptr;
+    void *other_ctx = nullptr;
+    portENTER_CRITICAL_SAFE(&trans->lock);
+    // The bus and the other user never queue transfers at the same time, see `registerColorTransferDoneCallback()`
+    if ((trans->on_other_done == nullptr) && (trans->num > 0)) {
+        // Count down the oldest transfer queued by the bus
+        auto &head_item = trans->items[trans->head];
+        is_own = true;
+        if (--head_item.chunks_left == 0) {
+            item = head_item;
+            if (++trans->head >= trans->depth) {
+                trans->head = 0;
+            }
+            trans->num--;
+            trans->finished = item.token;
+            is_finished = true;
+            // Take out the waiters of the finished transfers, their semaphores are given after the lock is released
+            for (auto node = &trans->waiters; *node != nullptr;) {
+                auto waiter = *node;
+                if (static_cast<int32_t>(item.token - waiter->token) >= 0) {
+                    *node = waiter->next;
+                    waiter->next = finished_waiters;
+                    finished_waiters = waiter;
+                } else {
+                    node = &waiter->next;
+                }
+            }
+        }
+    } else {
+        other_callback = trans->on_other_done;
+        other_ctx = trans->other_done_ctx;
+    }
+    portEXIT_CRITICAL_SAFE(&trans->lock);
+
+    // The transaction is not queued by the bus (like `esp_lcd_panel_draw_bitmap()`), pass it to the registered user
+    if (!is_own) {
+        return (other_callback != nullptr) ? other_callback(panel_io, edata, other_ctx) : false;
+    }
+
+    if (is_finished) {
+        if ((item.on_finish != nullptr) && item.on_finish(item.user_data)) {
+            need_yield = pdTRUE;
+        }
+        xSemaphoreGiveFromISR(trans->slot_sem, &need_yield);
+        while (finished_waiters != nullptr) {
+            // The waiter may leave once its semaphore is given, so get the next one before
+            auto waiter = finished_waiters;
+            finished_waiters = waiter->next;
+            xSemaphoreGiveFromISR(waiter->sem, &need_yield);
+        }
+    }
+
+    return (need_yield == pdTRUE);
+}
+
 } // namespace esp_panel::drivers
@@ -7,9 +7,14 @@
 #pragma once
 
 #include <bitset>
+#include <memory>
+#include <mutex>
 #include <string>
 #include "esp_lcd_types.h"
 #include "esp_lcd_panel_io.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "utils/esp_panel_utils_cxx.hpp"
 #include "esp_panel_bus_conf_internal.h"
 
 namespace esp_panel::drivers {
@@ -22,6 +27,16 @@ namespace esp_panel::drivers {
 class Bus {
 public:
     using ControlPanelHandle = esp_lcd_panel_io_handle_t;
+    using ColorTransferToken = uint32_t;
+
+    /**
+     * @brief Function pointer type for the color transfer finish callback
+     *
+     * @param[in] user_data User data passed to `writeColorDataAsync()`
+     * @return `true` if a higher priority task is woken, `false` otherwise
+     * @note This function is called in the interrupt context, so it should be placed in IRAM
+     */
+    using FunctionColorTransferFinishCallback = bool (*)(void *user_data);
 
     /**
      * @brief Basic attributes structure for bus configuration
@@ -31,6 +46,17 @@ public:
         const char *name = "";  /*!< Bus name string, defaults to `""` */
     };
 
+    /**
+     * @brief Attributes of the color transfer, set by derived classes when the control panel is created
+     */
+    struct ColorTransferAttributes {
+        bool is_queued = false;         /*!< Whether the color transactions are queued and reported one by one */
+        uint32_t max_transfer_size = 0; /*!< Maximum bytes of a color transaction, `0` means no limit */
+        int trans_queue_depth = 1;      /*!< Maximum number of in-flight color transfers */
+        int continue_cmd = -1;          /*!< Command of the rest transactions of a split transfer, `-1` means none */
+        int continue_cmd_shift = 0;     /*!< Bit offset of the command in the address, like `8` for QSPI */
+    };
+
     /**
      * @brief Driver state enumeration
      */
@@ -105,16 +131,93 @@ public:
     bool writeRegisterData(uint32_t address, const void *data, uint32_t data_size) const;
 
     /**
-     * @brief Write color data to display
+     * @brief Write color data to display and wait for it to finish
      *
      * @param[in] address Register address for color data
      * @param[in] color Color data buffer to write
      * @param[in] color_size Size of color data in bytes
      *
      * @return `true` if write succeeds, `false` otherwise
+     * @note If the bus supports the queued color path and the buffer is DMA-capable, it is sent like
+     *       `writeColorDataAsync()`. Otherwise, or if the queued path fails, it falls back to the polling path which
+     *       copies the data through the CPU
      */
     bool writeColorData(uint32_t address, const void *color, uint32_t color_size) const;
 
+    /**
+     * @brief Queue color data to display by the DMA path without waiting for it to finish
+     *
+     * The data is split into transactions of at most `getColorTransferAttributes().max_transfer_size` bytes. Only the
+     * first transaction carries `address`, the others continue the memory write with `continue_cmd`, which replaces
+     * the command byte of `address` at `continue_cmd_shift` (the opcode of QSPI is kept).
+     *
+     * @param[in] address Register address for color data
+     * @param[in] color Color data buffer to write, must be DMA-capable
+     * @param[in] color_size Size of color data in bytes
+     * @param[in] callback Callback function when the transfer finishes, set to `nullptr` if not used
+     * @param[in] user_data User data passed to the callback function
+     * @param[out] token Token of the transfer which can be used by `waitColorDataFinish()`, set to `nullptr` if not
+     *                   used
+     *
+     * @return `true` if the transfer is queued, `false` otherwise
+     * @note Only the buses with `getColorTransferAttributes().is_queued` set (like SPI/QSPI) support this function
+     * @note The buffer shouldn't be modified or freed until the transfer finishes
+     * @note This function blocks when the transfer queue is full
+     * @note The completions of the control panel can't tell their owners, so this function fails once another user
+     *       (like the LCD driver after `LCD::begin()`) has registered by `registerColorTransferDoneCallback()`
+     */
+    bool writeColorDataAsync(
+        uint32_t address, const void *color, uint32_t color_size,
+        FunctionColorTransferFinishCallback callback = nullptr, void *user_data = nullptr,
+        ColorTransferToken *token = nullptr
+    ) const;
+
+    /**
+     * @brief Check if a color transfer is finished
+     *
+     * @param[in] token Token returned by `writeColorDataAsync()`
+     *
+     * @return `true` if finished, `false` otherwise
+     */
+    bool isColorDataFinished(ColorTransferToken token) const;
+
+    /**
+     * @brief Wait for a color transfer to finish
+     *
+     * @param[in] token Token returned by `writeColorDataAsync()`
+     * @param[in] timeout_ms Maximum time to wait in milliseconds, set to `-1` to wait forever
+     *
+     * @return `true` if finished, `false` if timeout or failed
+     */
+    bool waitColorDataFinish(ColorTransferToken token, int timeout_ms = -1) const;
+
+    /**
+     * @brief Wait for all queued color transfers to finish
+     *
+     * @param[in] timeout_ms Maximum time to wait in milliseconds, set to `-1` to wait forever
+     *
+     * @return `true` if finished, `false` if timeout or failed
+     */
+    bool waitColorDataAllFinish(int timeout_ms = -1) const;
+
+    /**
+     * @brief Register the callback for the color transfers which are not queued by `writeColorData*()`
+     *
+     * The bus owns the `on_color_trans_done` event of the control panel to track its own transfers, so the other
+     * users (like the LCD driver calling `esp_lcd_panel_draw_bitmap()`) should register the callback here instead of
+     * calling `esp_lcd_panel_io_register_event_callbacks()`. If the bus has no queued color path, the callback is
+     * registered to the control panel directly.
+     *
+     * @param[in] callback Callback function, set to `nullptr` to unregister
+     * @param[in] user_ctx User context passed to the callback function
+     *
+     * @return `true` if successful, `false` otherwise
+     * @note This function should be called after `begin()`
+     * @note It waits for the transfers queued by `writeColorDataAsync()` to finish. After that, the bus doesn't queue
+     *       transfers until the callback is unregistered, and `writeColorData()` uses the polling path
+     */
+    bool registerColorTransferDoneCallback(esp_lcd_panel_io_color_trans_done_cb_t callback, void *user_ctx);
+
     /**
      * @brief Disable the LCD control panel handle
      *
@@ -147,6 +250,16 @@ public:
         return _basic_attributes;
     }
 
+    /**
+     * @brief Get the attributes of the color transfer
+     *
+     * @return Reference to the color transfer attributes
+     */
+    const ColorTransferAttributes &getColorTransferAttributes() const
+    {
+        return _color_trans_attributes;
+    }
+
     /**
      * @brief Get the LCD control panel handle
      *
@@ -189,11 +302,86 @@ protected:
         return (control_panel != nullptr);
     }
 
+    /**
+     * @brief Set the attributes of the color transfer
+     *
+     * @param[in] attributes Color transfer attributes
+     * @note This function should be called by derived classes before the first color transfer
+     */
+    void setColorTransferAttributes(const ColorTransferAttributes &attributes)
+    {
+        _color_trans_attributes = attributes;
+    }
+
     ControlPanelHandle control_panel = nullptr;  /*!< Control panel handle, created by derived classes */
 
 private:
+    /**
+     * @brief Queue of the in-flight color transfers
+     *
+     * Every transfer pushes an item before calling `esp_lcd_panel_io_tx_color()`, and each `on_color_trans_done`
+     * event counts down the chunks of the oldest one, since the control panel finishes the transactions in order.
+     */
+    struct ColorTransfer {
+        /**
+         * @brief In-flight transfer item
+         */
+        struct Item {
+            ColorTransferToken token = 0;         /*!< Token of the transfer */
+            uint32_t chunks_left = 0;             /*!< Number of the unfinished transactions */
+            FunctionColorTransferFinishCallback on_finish = nullptr; /*!< Finish callback */
+            void *user_data = nullptr;            /*!< User data of the finish callback */
+        };
+
+        /**
+         * @brief Task waiting for a transfer, which is placed on its stack
+         */
+        struct Waiter {
+            ColorTransferToken token = 0;         /*!< Token of the waited transfer */
+            SemaphoreHandle_t sem = nullptr;      /*!< Binary semaphore given when the transfer finishes */
+            Waiter *next = nullptr;               /*!< Next waiter in the list */
+        };
+
+        ~ColorTransfer();
+
+        Item *items = nullptr;                    /*!< Ring buffer of the in-flight items, in internal RAM */
+        int depth = 0;                            /*!< Maximum number of in-flight items */
+        int head = 0;                             /*!< Index of the oldest item */
+        int num = 0;                              /*!< Number of in-flight items */
+        ColorTransferToken submitted = 0;         /*!< Token of the latest submitted transfer */
+        ColorTransferToken finished = 0;          /*!< Token of the latest finished transfer */
+        portMUX_TYPE lock = portMUX_INITIALIZER_UNLOCKED; /*!< Lock of the items and tokens */
+        std::mutex submit_mutex;                  /*!< Keep the transactions of a transfer contiguous */
+        SemaphoreHandle_t slot_sem = nullptr;     /*!< Counting semaphore of the free slots */
+        Waiter *waiters = nullptr;                /*!< List of the waiting tasks, each one is woken up separately */
+        esp_lcd_panel_io_color_trans_done_cb_t on_other_done = nullptr; /*!< Callback of the other transfers */
+        void *other_done_ctx = nullptr;           /*!< User context of `on_other_done` */
+    };
+
+    /**
+     * @brief Create the queue of the color transfers and take over the event of the control panel
+     *
+     * @return `true` if successful, `false` otherwise
+     */
+    bool createColorTransfer() const;
+
+    /**
+     * @brief Cancel the latest color transfer whose transactions are not all queued
+     *
+     * @param[in] token Token of the transfer
+     * @param[in] chunks_unsent Number of the transactions which are not queued
+     */
+    void cancelColorTransfer(ColorTransferToken token, uint32_t chunks_unsent) const;
+
+    IRAM_ATTR static bool onColorTransferDone(
+        esp_lcd_panel_io_handle_t panel_io, esp_lcd_panel_io_event_data_t *edata, void *user_ctx
+    );
+
     State _state = State::DEINIT;              /*!< Current driver state */
     BasicAttributes _basic_attributes = {};     /*!< Bus basic attributes */
+    ColorTransferAttributes _color_trans_attributes = {}; /*!< Color transfer attributes */
+    // Created on the first color transfer, so it's mutable for the const write functions
+    mutable std::shared_ptr<ColorTransfer> _color_trans = nullptr; /*!< Queue of the color transfers */
 };
 
 } // namespace esp_panel::drivers
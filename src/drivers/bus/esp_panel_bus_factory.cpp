@@ -52,6 +52,7 @@ const utils::unordered_map<int, utils::string> BusFactory::_type_name_map = {
 #if ESP_PANEL_DRIVERS_BUS_ENABLE_MIPI_DSI
     TYPE_NAME_MAP_ITEM(DSI),
 #endif
+    TYPE_NAME_MAP_ITEM(Virtual),
 };
 
 const utils::unordered_map<int, BusFactory::FunctionDeviceConstructor> BusFactory::_type_constructor_map = {
@@ -18,6 +18,7 @@
 #include "esp_panel_bus_qspi.hpp"
 #include "esp_panel_bus_rgb.hpp"
 #include "esp_panel_bus_spi.hpp"
+#include "esp_panel_bus_virtual.hpp"
 
 namespace esp_panel::drivers {
 
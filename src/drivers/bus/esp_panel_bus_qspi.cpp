@@ -7,6 +7,8 @@
 #include "esp_panel_bus_conf_internal.h"
 #if ESP_PANEL_DRIVERS_BUS_ENABLE_QSPI
 
+#include <algorithm>
+#include "esp_lcd_panel_commands.h"
 #include "utils/esp_panel_utils_log.h"
 #include "drivers/host/esp_panel_host_spi.hpp"
 #include "esp_panel_bus_qspi.hpp"
@@ -304,6 +306,17 @@ bool BusQSPI::begin()
     );
     ESP_UTILS_LOGD("Create control panel @%p", control_panel);
 
+    // Chunk the color transfers by the host limit, so each of them is a single queued DMA transaction. The rest
+    // chunks are sent with "RAMWRC" in the command byte of the address (`opcode << 24 | cmd << 8`), like the vendor
+    // drivers, since the data without the opcode and address phases is ignored by the panel
+    setColorTransferAttributes({
+        .is_queued = true,
+        .max_transfer_size = getHostMaxTransferSize(),
+        .trans_queue_depth = static_cast<int>(getControlPanelFullConfig().trans_queue_depth),
+        .continue_cmd = LCD_CMD_RAMWRC,
+        .continue_cmd_shift = 8,
+    });
+
     setState(State::BEGIN);
 
     ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
@@ -338,6 +351,16 @@ bool BusQSPI::del()
     return true;
 }
 
+uint32_t BusQSPI::getHostMaxTransferSize()
+{
+    // The host initialized by others is assumed to use the maximum size of the hardware
+    if (isHostSkipInit() || (getHostFullConfig().max_transfer_sz <= 0)) {
+        return ESP_PANEL_HOST_SPI_MAX_TRANSFER_SIZE;
+    }
+
+    return std::min<uint32_t>(getHostFullConfig().max_transfer_sz, ESP_PANEL_HOST_SPI_MAX_TRANSFER_SIZE);
+}
+
 BusQSPI::ControlPanelFullConfig &BusQSPI::getControlPanelFullConfig()
 {
     if (std::holds_alternative<ControlPanelPartialConfig>(_config.control_panel)) {
@@ -268,6 +268,13 @@ private:
         return !_config.isHostConfigValid();
     }
 
+    /**
+     * @brief Get the maximum bytes of a transaction on the host
+     *
+     * @return Maximum bytes of a transaction
+     */
+    uint32_t getHostMaxTransferSize();
+
     /**
      * @brief Get mutable reference to control panel full configuration
      *
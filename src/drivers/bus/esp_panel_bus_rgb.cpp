@@ -480,6 +480,7 @@ bool BusRGB::configRGB_FrameBufferNumber(uint8_t num)
     ESP_UTILS_LOGD("Param: num(%d)", num);
     ESP_UTILS_CHECK_FALSE_RETURN(num > 0, false, "Frame buffer number must be greater than 0");
     getRefreshPanelFullConfig().num_fbs = num;
+    getRefreshPanelFullConfig().flags.no_fb = 0;
 
     ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
 
@@ -525,6 +526,80 @@ bool BusRGB::configRGB_BounceBufferSize(uint32_t size_in_pixel)
     return true;
 }
 
+bool BusRGB::configRGB_MemoryPlan(const utils::MemoryPlanner::Plan &plan)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(!isOverState(State::INIT), false, "Should be called before `init()`");
+
+    ESP_UTILS_LOGD(
+        "Param: plan(fb_num: %d, fb_in_psram: %d, bounce_buffer_size_px: %d)", plan.fb_num, plan.fb_in_psram,
+        plan.bounce_buffer_size_px
+    );
+    if (!plan.is_feasible) {
+        ESP_UTILS_LOGW("Memory plan is not feasible (headroom: %d%%), the screen may drift", plan.headroom_percent);
+    }
+
+    ESP_UTILS_CHECK_FALSE_RETURN(configRGB_FrameBufferNumber(plan.fb_num), false, "Config frame buffer number failed");
+    if (plan.bounce_buffer_size_px > 0) {
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            configRGB_BounceBufferSize(plan.bounce_buffer_size_px), false, "Config bounce buffer size failed"
+        );
+    } else {
+        getRefreshPanelFullConfig().bounce_buffer_size_px = 0;
+    }
+    getRefreshPanelFullConfig().flags.fb_in_psram = plan.fb_in_psram;
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool BusRGB::getMemoryPlannerConfig(utils::MemoryPlanner::Config &config)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    auto &refresh_config = getRefreshPanelFullConfig();
+    auto &timings = refresh_config.timings;
+    config.h_res = timings.h_res;
+    config.v_res = timings.v_res;
+    config.bits_per_pixel = refresh_config.bits_per_pixel;
+    config.h_blank = timings.hsync_pulse_width + timings.hsync_back_porch + timings.hsync_front_porch;
+    config.v_blank = timings.vsync_pulse_width + timings.vsync_back_porch + timings.vsync_front_porch;
+    config.pclk_hz = timings.pclk_hz;
+    config.fb_num = refresh_config.num_fbs;
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool BusRGB::configRGB_StreamMode(uint32_t lines)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(!isOverState(State::INIT), false, "Should be called before `init()`");
+
+    ESP_UTILS_LOGD("Param: lines(%d)", static_cast<int>(lines));
+
+    auto &config = getRefreshPanelFullConfig();
+    // The driver fills the two bounce buffers in turn, so a frame should be made of the pairs of them
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        (lines > 0) && (config.timings.v_res % (lines * 2) == 0), false,
+        "Invalid lines(%d), 2 * lines should divide the vertical resolution(%d)", static_cast<int>(lines),
+        static_cast<int>(config.timings.v_res)
+    );
+
+    config.num_fbs = 0;
+    config.bounce_buffer_size_px = config.timings.h_res * lines;
+    config.flags.no_fb = 1;
+    config.flags.fb_in_psram = 0;
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
 bool BusRGB::configRGB_TimingFlags(
     bool hsync_idle_low, bool vsync_idle_low, bool de_idle_high, bool pclk_active_neg, bool pclk_idle_high
 )
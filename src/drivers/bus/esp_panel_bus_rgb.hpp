@@ -14,6 +14,7 @@
 #include <variant>
 #include "esp_lcd_panel_rgb.h"
 #include "esp_io_expander.hpp"
+#include "utils/esp_panel_utils_memory_plan.hpp"
 #include "port/esp_lcd_panel_io_additions.h"
 #include "esp_panel_bus.hpp"
 
@@ -472,6 +473,51 @@ public:
      */
     bool configRGB_BounceBufferSize(uint32_t size_in_pixel);
 
+    /**
+     * @brief Configure the frame buffers and the bounce buffers by a memory plan
+     *
+     * @param[in] plan Plan from `utils::MemoryPlanner`, see `getMemoryPlannerConfig()`
+     *
+     * @return `true` if configuration succeeds, `false` otherwise
+     * @note This function should be called before `init()`
+     */
+    bool configRGB_MemoryPlan(const utils::MemoryPlanner::Plan &plan);
+
+    /**
+     * @brief Get the inputs of the memory planner from the current configuration
+     *
+     * The resolution, the format, the timing and the frame buffer number are filled, the GUI and the memory related
+     * fields keep the input values and should be filled by the caller.
+     *
+     * @param[in,out] config Inputs of the planner
+     *
+     * @return `true` if successful, `false` otherwise
+     */
+    bool getMemoryPlannerConfig(utils::MemoryPlanner::Config &config);
+
+    /**
+     * @brief Configure the stream mode, which doesn't allocate any frame buffer
+     *
+     * The bounce buffers are filled just in time by the line provider of the LCD (see `LCD::attachLineProvider()`),
+     * so the whole frame doesn't need to be resident in the memory. Each bounce buffer holds the whole lines.
+     *
+     * @param[in] lines Number of the lines per bounce buffer, `2 * lines` should divide the vertical resolution
+     *
+     * @return `true` if configuration succeeds, `false` otherwise
+     * @note This function should be called before `init()`, and `configRGB_FrameBufferNumber()` quits the mode
+     */
+    bool configRGB_StreamMode(uint32_t lines);
+
+    /**
+     * @brief Check if the stream mode is configured
+     *
+     * @return `true` if the bus has no frame buffer, `false` otherwise
+     */
+    bool isStreamMode()
+    {
+        return getRefreshPanelFullConfig().flags.no_fb;
+    }
+
     /**
      * @brief Configure RGB timing flags
      *
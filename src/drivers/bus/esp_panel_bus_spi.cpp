@@ -7,6 +7,7 @@
 #include "esp_panel_bus_conf_internal.h"
 #if ESP_PANEL_DRIVERS_BUS_ENABLE_SPI
 
+#include <algorithm>
 #include "utils/esp_panel_utils_log.h"
 #include "drivers/host/esp_panel_host_spi.hpp"
 #include "esp_panel_bus_spi.hpp"
@@ -330,6 +331,13 @@ bool BusSPI::begin()
     );
     ESP_UTILS_LOGD("Create control panel @%p", control_panel);
 
+    // Chunk the color transfers by the host limit, so each of them is a single queued DMA transaction
+    setColorTransferAttributes({
+        .is_queued = true,
+        .max_transfer_size = getHostMaxTransferSize(),
+        .trans_queue_depth = static_cast<int>(getControlPanelFullConfig().trans_queue_depth),
+    });
+
     ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
 
     setState(State::BEGIN);
@@ -371,6 +379,16 @@ BusSPI::HostFullConfig &BusSPI::getHostFullConfig()
     return std::get<HostFullConfig>(_config.host.value());
 }
 
+uint32_t BusSPI::getHostMaxTransferSize()
+{
+    // The host initialized by others is assumed to use the maximum size of the hardware
+    if (isHostSkipInit() || (getHostFullConfig().max_transfer_sz <= 0)) {
+        return ESP_PANEL_HOST_SPI_MAX_TRANSFER_SIZE;
+    }
+
+    return std::min<uint32_t>(getHostFullConfig().max_transfer_sz, ESP_PANEL_HOST_SPI_MAX_TRANSFER_SIZE);
+}
+
 BusSPI::ControlPanelFullConfig &BusSPI::getControlPanelFullConfig()
 {
     if (std::holds_alternative<ControlPanelPartialConfig>(_config.control_panel)) {
@@ -357,6 +357,13 @@ private:
      */
     HostFullConfig &getHostFullConfig();
 
+    /**
+     * @brief Get the maximum bytes of a transaction on the host
+     *
+     * @return Maximum bytes of a transaction
+     */
+    uint32_t getHostMaxTransferSize();
+
     /**
      * @brief Get mutable reference to control panel full configuration
      *
@@ -0,0 +1,556 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include "esp_rom_sys.h"
+#include "esp_lcd_panel_commands.h"
+#include "esp_lcd_panel_interface.h"
+#include "esp_lcd_panel_io_interface.h"
+#include "utils/esp_panel_utils_log.h"
+#include "esp_panel_bus_virtual.hpp"
+
+namespace esp_panel::drivers {
+
+/**
+ * @brief In-memory control panel, the `base` must be the first member so that the handle can be casted back
+ */
+struct BusVirtual::ControlPanel {
+    esp_lcd_panel_io_t base;
+    BusVirtual *bus;
+};
+
+void BusVirtual::Config::print() const
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_LOGI(
+        "\n\t{Virtual config}"
+        "\n\t\t-> [emulated_type]: %d"
+        "\n\t\t-> [clock_hz]: %d"
+        "\n\t\t-> [data_lines]: %d"
+        "\n\t\t-> [lcd_cmd_bits]: %d"
+        "\n\t\t-> [lcd_param_bits]: %d"
+        "\n\t\t-> [trans_queue_depth]: %d"
+        "\n\t\t-> [max_transfer_size]: %d"
+        "\n\t\t-> [trans_overhead_us]: %d"
+        "\n\t\t-> [h_blank_px]: %d"
+        "\n\t\t-> [v_blank_lines]: %d"
+        , static_cast<int>(emulated_type)
+        , static_cast<int>(clock_hz)
+        , static_cast<int>(data_lines)
+        , static_cast<int>(lcd_cmd_bits)
+        , static_cast<int>(lcd_param_bits)
+        , static_cast<int>(trans_queue_depth)
+        , static_cast<int>(max_transfer_size)
+        , static_cast<int>(trans_overhead_us)
+        , static_cast<int>(h_blank_px)
+        , static_cast<int>(v_blank_lines)
+    );
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+}
+
+BusVirtual::~BusVirtual()
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_EXIT(del(), "Delete failed");
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+}
+
+bool BusVirtual::configVirtual_TransQueueDepth(uint8_t depth)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(!isOverState(State::INIT), false, "Should be called before `init()`");
+
+    ESP_UTILS_LOGD("Param: depth(%d)", static_cast<int>(depth));
+    _config.trans_queue_depth = depth;
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool BusVirtual::configVirtual_MaxTransferSize(uint32_t size)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(!isOverState(State::INIT), false, "Should be called before `init()`");
+
+    ESP_UTILS_LOGD("Param: size(%d)", static_cast<int>(size));
+    _config.max_transfer_size = size;
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool BusVirtual::configVirtual_TransOverhead(uint32_t overhead_us)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(!isOverState(State::INIT), false, "Should be called before `init()`");
+
+    ESP_UTILS_LOGD("Param: overhead_us(%d)", static_cast<int>(overhead_us));
+    _config.trans_overhead_us = overhead_us;
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool BusVirtual::configVirtual_Blanking(uint32_t h_blank_px, uint32_t v_blank_lines)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(!isOverState(State::INIT), false, "Should be called before `init()`");
+
+    ESP_UTILS_LOGD(
+        "Param: h_blank_px(%d), v_blank_lines(%d)", static_cast<int>(h_blank_px), static_cast<int>(v_blank_lines)
+    );
+    _config.h_blank_px = h_blank_px;
+    _config.v_blank_lines = v_blank_lines;
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool BusVirtual::init()
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(!isOverState(State::INIT), false, "Already initialized");
+
+#if ESP_UTILS_CONF_LOG_LEVEL == ESP_UTILS_LOG_LEVEL_DEBUG
+    _config.print();
+#endif // ESP_UTILS_LOG_LEVEL_DEBUG
+
+    auto type = _config.emulated_type;
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        (type == ESP_PANEL_BUS_TYPE_SPI) || (type == ESP_PANEL_BUS_TYPE_QSPI) || (type == ESP_PANEL_BUS_TYPE_RGB) ||
+        (type == ESP_PANEL_BUS_TYPE_MIPI_DSI), false, "Invalid emulated bus type(%d)", type
+    );
+    ESP_UTILS_CHECK_FALSE_RETURN(_config.clock_hz > 0, false, "Invalid clock(%d)", _config.clock_hz);
+    ESP_UTILS_CHECK_FALSE_RETURN(_config.data_lines > 0, false, "Invalid data lines(%d)", _config.data_lines);
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        _config.trans_queue_depth > 0, false, "Invalid transaction queue depth(%d)", _config.trans_queue_depth
+    );
+
+    setState(State::INIT);
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool BusVirtual::begin()
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(!isOverState(State::BEGIN), false, "Already begun");
+
+    // Initialize the bus if not initialized
+    if (!isOverState(State::INIT)) {
+        ESP_UTILS_CHECK_FALSE_RETURN(init(), false, "Init failed");
+    }
+
+    // Create the transaction queue and the simulation timers
+    ESP_UTILS_CHECK_EXCEPTION_RETURN(
+        _trans_queue.resize(_config.trans_queue_depth), false, "Create transaction queue failed"
+    );
+    _trans_queue_head = 0;
+    _trans_queue_num = 0;
+    _bus_busy_until_us = 0;
+    _trans_slot_sem = xSemaphoreCreateCounting(_config.trans_queue_depth, _config.trans_queue_depth);
+    ESP_UTILS_CHECK_NULL_RETURN(_trans_slot_sem, false, "Create transaction slot semaphore failed");
+
+    esp_timer_create_args_t trans_timer_args = {
+        .callback = onTransTimerExpired,
+        .arg = this,
+        .dispatch_method = ESP_TIMER_TASK,
+        .name = "virtual_trans",
+        .skip_unhandled_events = false,
+    };
+    ESP_UTILS_CHECK_ERROR_RETURN(
+        esp_timer_create(&trans_timer_args, &_trans_timer), false, "Create transaction timer failed"
+    );
+    esp_timer_create_args_t refresh_timer_args = {
+        .callback = onRefreshTimerExpired,
+        .arg = this,
+        .dispatch_method = ESP_TIMER_TASK,
+        .name = "virtual_refresh",
+        .skip_unhandled_events = true,
+    };
+    ESP_UTILS_CHECK_ERROR_RETURN(
+        esp_timer_create(&refresh_timer_args, &_refresh_timer), false, "Create refresh timer failed"
+    );
+
+    // Create the in-memory control panel
+    auto panel = static_cast<ControlPanel *>(calloc(1, sizeof(ControlPanel)));
+    ESP_UTILS_CHECK_NULL_RETURN(panel, false, "Create control panel failed");
+    panel->bus = this;
+    panel->base.rx_param = onIO_RxParam;
+    panel->base.tx_param = onIO_TxParam;
+    panel->base.tx_color = onIO_TxColor;
+    panel->base.del = onIO_Delete;
+    panel->base.register_event_callbacks = onIO_RegisterEventCallbacks;
+    control_panel = &panel->base;
+    ESP_UTILS_LOGD("Create control panel @%p", control_panel);
+    // Split the color transfers like the emulated bus, see `BusSPI::begin()` and `BusQSPI::begin()`
+    setColorTransferAttributes({
+        .is_queued = true,
+        .max_transfer_size = static_cast<uint32_t>(_config.max_transfer_size),
+        .trans_queue_depth = _config.trans_queue_depth,
+        .continue_cmd = (_config.emulated_type == ESP_PANEL_BUS_TYPE_QSPI) ? LCD_CMD_RAMWRC : -1,
+        .continue_cmd_shift = (_config.emulated_type == ESP_PANEL_BUS_TYPE_QSPI) ? 8 : 0,
+    });
+
+    setState(State::BEGIN);
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool BusVirtual::del()
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    if (_refresh_timer != nullptr) {
+        esp_timer_stop(_refresh_timer);
+        ESP_UTILS_CHECK_ERROR_RETURN(esp_timer_delete(_refresh_timer), false, "Delete refresh timer failed");
+        _refresh_timer = nullptr;
+    }
+
+    // Drain the in-flight transactions before deleting the timer which finishes them
+    if (_trans_slot_sem != nullptr) {
+        ESP_UTILS_CHECK_FALSE_RETURN(waitQueueEmpty(), false, "Wait queue empty failed");
+    }
+    if (_trans_timer != nullptr) {
+        esp_timer_stop(_trans_timer);
+        ESP_UTILS_CHECK_ERROR_RETURN(esp_timer_delete(_trans_timer), false, "Delete transaction timer failed");
+        _trans_timer = nullptr;
+    }
+    if (_trans_slot_sem != nullptr) {
+        vSemaphoreDelete(_trans_slot_sem);
+        _trans_slot_sem = nullptr;
+    }
+    _trans_queue.clear();
+
+    // Delete the control panel if valid
+    if (isControlPanelValid()) {
+        ESP_UTILS_CHECK_FALSE_RETURN(delControlPanel(), false, "Delete control panel failed");
+    }
+
+    _on_color_trans_done = nullptr;
+    _on_color_trans_done_ctx = nullptr;
+    _on_refresh_finish = nullptr;
+    _on_refresh_finish_ctx = nullptr;
+
+    setState(State::DEINIT);
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool BusVirtual::registerRefreshFinishCallback(FunctionRefreshFinishCallback callback, void *user_ctx)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_LOGD("Param: callback(@%p), user_ctx(@%p)", callback, user_ctx);
+
+    portENTER_CRITICAL(&_lock);
+    _on_refresh_finish = callback;
+    _on_refresh_finish_ctx = user_ctx;
+    portEXIT_CRITICAL(&_lock);
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool BusVirtual::startRefresh(int h_res, int v_res, int bits_per_pixel)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(isOverState(State::BEGIN), false, "Not begun");
+
+    ESP_UTILS_LOGD("Param: h_res(%d), v_res(%d), bits_per_pixel(%d)", h_res, v_res, bits_per_pixel);
+
+    auto period_us = calculateRefreshPeriodUs(h_res, v_res, bits_per_pixel);
+    if (period_us == 0) {
+        ESP_UTILS_LOGD("Emulated bus doesn't refresh by itself, skip");
+        goto end;
+    }
+
+    esp_timer_stop(_refresh_timer);
+    ESP_UTILS_CHECK_ERROR_RETURN(
+        esp_timer_start_periodic(_refresh_timer, period_us), false, "Start refresh timer failed"
+    );
+    ESP_UTILS_LOGD("Start refresh with period(%d us)", static_cast<int>(period_us));
+
+end:
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool BusVirtual::stopRefresh()
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    if (_refresh_timer != nullptr) {
+        esp_timer_stop(_refresh_timer);
+    }
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+uint32_t BusVirtual::calculateTransferTimeUs(uint32_t bytes, bool with_command) const
+{
+    uint64_t time_us = _config.trans_overhead_us;
+
+    switch (_config.emulated_type) {
+    case ESP_PANEL_BUS_TYPE_SPI:
+    case ESP_PANEL_BUS_TYPE_QSPI: {
+        // The command phase is always transferred on a single line, while the data phase uses all the lines
+        uint64_t lines = _config.data_lines;
+        uint64_t line_bits = static_cast<uint64_t>(bytes) * 8 + (with_command ? _config.lcd_cmd_bits * lines : 0);
+        uint64_t divisor = static_cast<uint64_t>(_config.clock_hz) * lines;
+        time_us += (line_bits * 1000000 + divisor - 1) / divisor;
+        break;
+    }
+    default:
+        break;
+    }
+
+    return static_cast<uint32_t>(time_us);
+}
+
+uint32_t BusVirtual::calculateRefreshPeriodUs(int h_res, int v_res, int bits_per_pixel) const
+{
+    uint64_t total_pixels =
+        static_cast<uint64_t>(h_res + _config.h_blank_px) * static_cast<uint64_t>(v_res + _config.v_blank_lines);
+    uint64_t lines = _config.data_lines;
+    uint64_t clock_hz = _config.clock_hz;
+
+    switch (_config.emulated_type) {
+    case ESP_PANEL_BUS_TYPE_RGB: {
+        // A pixel takes several PCLK cycles when the data width is narrower than the color depth (e.g. serial RGB)
+        uint64_t cycles_per_pixel = (bits_per_pixel + lines - 1) / lines;
+        return static_cast<uint32_t>(total_pixels * cycles_per_pixel * 1000000 / clock_hz);
+    }
+    case ESP_PANEL_BUS_TYPE_MIPI_DSI:
+        return static_cast<uint32_t>(total_pixels * bits_per_pixel * 1000000 / (clock_hz * lines));
+    default:
+        break;
+    }
+
+    return 0;
+}
+
+void BusVirtual::resetStatistics()
+{
+    portENTER_CRITICAL(&_lock);
+    _statistics = {};
+    portEXIT_CRITICAL(&_lock);
+}
+
+BusVirtual::Statistics BusVirtual::getStatistics() const
+{
+    auto lock = const_cast<portMUX_TYPE *>(&_lock);
+
+    portENTER_CRITICAL(lock);
+    Statistics statistics = _statistics;
+    portEXIT_CRITICAL(lock);
+
+    return statistics;
+}
+
+bool BusVirtual::waitQueueEmpty()
+{
+    // Hold all the slots, which means there is no in-flight transaction, then release them
+    int depth = _config.trans_queue_depth;
+    for (int i = 0; i < depth; i++) {
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            xSemaphoreTake(_trans_slot_sem, portMAX_DELAY) == pdTRUE, false, "Take transaction slot failed"
+        );
+    }
+    for (int i = 0; i < depth; i++) {
+        xSemaphoreGive(_trans_slot_sem);
+    }
+
+    return true;
+}
+
+bool BusVirtual::transmitParam(uint32_t bytes)
+{
+    // Like the real drivers, the polling transaction waits for the queued color transactions first
+    ESP_UTILS_CHECK_FALSE_RETURN(waitQueueEmpty(), false, "Wait queue empty failed");
+
+    auto time_us = calculateTransferTimeUs(bytes);
+    portENTER_CRITICAL(&_lock);
+    _statistics.param_trans_num++;
+    _statistics.param_bytes += bytes;
+    _statistics.busy_time_us += time_us;
+    portEXIT_CRITICAL(&_lock);
+
+    if (time_us > 0) {
+        esp_rom_delay_us(time_us);
+    }
+
+    return true;
+}
+
+bool BusVirtual::transmitColor(int lcd_cmd, uint32_t bytes)
+{
+    // The command of QSPI is placed in the middle of the address, like `opcode << 24 | cmd << 8`
+    int cmd_shift = (_config.emulated_type == ESP_PANEL_BUS_TYPE_QSPI) ? 8 : 0;
+    bool is_continue = (lcd_cmd >= 0) && (((lcd_cmd >> cmd_shift) & 0xFF) == LCD_CMD_RAMWRC);
+
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        xSemaphoreTake(_trans_slot_sem, portMAX_DELAY) == pdTRUE, false, "Take transaction slot failed"
+    );
+
+    auto time_us = calculateTransferTimeUs(bytes);
+    auto now_us = esp_timer_get_time();
+    bool need_start_timer = false;
+    int64_t timeout_us = 0;
+
+    portENTER_CRITICAL(&_lock);
+    // The transaction starts when the bus becomes idle, so the queued transactions are transferred back-to-back
+    int64_t start_us = (_bus_busy_until_us > now_us) ? _bus_busy_until_us : now_us;
+    _bus_busy_until_us = start_us + time_us;
+    _trans_queue[(_trans_queue_head + _trans_queue_num) % _trans_queue.size()] = {
+        .end_time_us = _bus_busy_until_us,
+        .bytes = bytes,
+    };
+    _trans_queue_num++;
+    need_start_timer = (_trans_queue_num == 1);
+    timeout_us = _bus_busy_until_us - now_us;
+    _statistics.color_trans_num++;
+    _statistics.color_no_cmd_num += (lcd_cmd < 0) ? 1 : 0;
+    _statistics.color_continue_num += is_continue ? 1 : 0;
+    _statistics.color_bytes += bytes;
+    _statistics.busy_time_us += time_us;
+    if (_trans_queue_num > _statistics.queue_depth_max) {
+        _statistics.queue_depth_max = _trans_queue_num;
+    }
+    portEXIT_CRITICAL(&_lock);
+
+    // Only the head transaction has a running timer, the others are chained in `onTransTimerExpired()`
+    if (need_start_timer) {
+        ESP_UTILS_CHECK_ERROR_RETURN(
+            esp_timer_start_once(_trans_timer, (timeout_us > 0) ? timeout_us : 1), false, "Start timer failed"
+        );
+    }
+
+    return true;
+}
+
+esp_err_t BusVirtual::onIO_RxParam(esp_lcd_panel_io_t *io, int lcd_cmd, void *param, size_t param_size)
+{
+    auto bus = reinterpret_cast<ControlPanel *>(io)->bus;
+    if ((param != nullptr) && (param_size > 0)) {
+        memset(param, 0, param_size);
+    }
+
+    return bus->transmitParam(param_size) ? ESP_OK : ESP_FAIL;
+}
+
+esp_err_t BusVirtual::onIO_TxParam(esp_lcd_panel_io_t *io, int lcd_cmd, const void *param, size_t param_size)
+{
+    auto bus = reinterpret_cast<ControlPanel *>(io)->bus;
+
+    return bus->transmitParam(param_size) ? ESP_OK : ESP_FAIL;
+}
+
+esp_err_t BusVirtual::onIO_TxColor(esp_lcd_panel_io_t *io, int lcd_cmd, const void *color, size_t color_size)
+{
+    auto bus = reinterpret_cast<ControlPanel *>(io)->bus;
+
+    return bus->transmitColor(lcd_cmd, color_size) ? ESP_OK : ESP_FAIL;
+}
+
+esp_err_t BusVirtual::onIO_Delete(esp_lcd_panel_io_t *io)
+{
+    free(reinterpret_cast<ControlPanel *>(io));
+
+    return ESP_OK;
+}
+
+esp_err_t BusVirtual::onIO_RegisterEventCallbacks(
+    esp_lcd_panel_io_t *io, const esp_lcd_panel_io_callbacks_t *cbs, void *user_ctx
+)
+{
+    auto bus = reinterpret_cast<ControlPanel *>(io)->bus;
+
+    portENTER_CRITICAL(&bus->_lock);
+    bus->_on_color_trans_done = cbs->on_color_trans_done;
+    bus->_on_color_trans_done_ctx = user_ctx;
+    portEXIT_CRITICAL(&bus->_lock);
+
+    return ESP_OK;
+}
+
+void BusVirtual::onTransTimerExpired(void *arg)
+{
+    auto bus = static_cast<BusVirtual *>(arg);
+    auto now_us = esp_timer_get_time();
+    bool has_next = false;
+    int64_t next_timeout_us = 0;
+    esp_lcd_panel_io_color_trans_done_cb_t callback = nullptr;
+    void *callback_ctx = nullptr;
+
+    portENTER_CRITICAL(&bus->_lock);
+    if (bus->_trans_queue_num > 0) {
+        bus->_trans_queue_head = (bus->_trans_queue_head + 1) % bus->_trans_queue.size();
+        bus->_trans_queue_num--;
+        if (bus->_trans_queue_num > 0) {
+            // The callback may be late, so the next transaction may have already expired
+            has_next = true;
+            next_timeout_us = bus->_trans_queue[bus->_trans_queue_head].end_time_us - now_us;
+        }
+        callback = bus->_on_color_trans_done;
+        callback_ctx = bus->_on_color_trans_done_ctx;
+    }
+    portEXIT_CRITICAL(&bus->_lock);
+
+    if (has_next) {
+        esp_timer_start_once(bus->_trans_timer, std::max<int64_t>(next_timeout_us, 1));
+    }
+    if (callback != nullptr) {
+        callback(bus->control_panel, nullptr, callback_ctx);
+    }
+    xSemaphoreGive(bus->_trans_slot_sem);
+}
+
+void BusVirtual::onRefreshTimerExpired(void *arg)
+{
+    auto bus = static_cast<BusVirtual *>(arg);
+    FunctionRefreshFinishCallback callback = nullptr;
+    void *callback_ctx = nullptr;
+
+    portENTER_CRITICAL(&bus->_lock);
+    bus->_statistics.refresh_frames++;
+    callback = bus->_on_refresh_finish;
+    callback_ctx = bus->_on_refresh_finish_ctx;
+    portEXIT_CRITICAL(&bus->_lock);
+
+    if (callback != nullptr) {
+        callback(bus, nullptr, callback_ctx);
+    }
+}
+
+} // namespace esp_panel::drivers
@@ -0,0 +1,313 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <memory>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "esp_timer.h"
+#include "utils/esp_panel_utils_cxx.hpp"
+#include "esp_panel_bus_conf_internal.h"
+#include "esp_panel_bus.hpp"
+
+namespace esp_panel::drivers {
+
+/**
+ * @brief The virtual bus class for ESP Panel
+ *
+ * This class is derived from `Bus` class and provides an in-memory control panel (`esp_lcd_panel_io_t`) which
+ * doesn't touch any peripheral. Every transaction is accounted by a bandwidth model of the emulated bus
+ * (SPI/QSPI/RGB/MIPI-DSI), and the completion events are fired by `esp_timer` after the simulated transfer time.
+ *
+ * It is used together with `LCD_Virtual` to benchmark and regression-test the flush path without a real panel.
+ */
+class BusVirtual: public Bus {
+public:
+    /**
+     * @brief Default values for virtual bus configuration
+     */
+    static constexpr BasicAttributes BASIC_ATTRIBUTES_DEFAULT = {
+        .type = ESP_PANEL_BUS_TYPE_VIRTUAL,
+        .name = "Virtual",
+    };
+    static constexpr int CLOCK_HZ_DEFAULT = 40 * 1000 * 1000;
+    static constexpr int TRANS_QUEUE_DEPTH_DEFAULT = 10;
+
+    /**
+     * @brief Function pointer type for the simulated refresh finish event
+     *
+     * @param[in] bus Pointer of the virtual bus
+     * @param[in] edata Event data, always `nullptr`
+     * @param[in] user_ctx User context registered by `registerRefreshFinishCallback()`
+     * @return `true` if a context switch is required, `false` otherwise
+     */
+    using FunctionRefreshFinishCallback = bool (*)(void *bus, void *edata, void *user_ctx);
+
+    /**
+     * @brief The virtual bus configuration structure
+     */
+    struct Config {
+        /**
+         * @brief Print configuration for debugging
+         */
+        void print() const;
+
+        int emulated_type = ESP_PANEL_BUS_TYPE_SPI; ///< Emulated bus type, `ESP_PANEL_BUS_TYPE_SPI/QSPI/RGB/MIPI_DSI`
+        int clock_hz = CLOCK_HZ_DEFAULT;  ///< SCLK for SPI/QSPI, PCLK for RGB, per-lane bit rate for MIPI-DSI
+        int data_lines = 1;               ///< 1 for SPI, 4 for QSPI, data width for RGB, lane number for MIPI-DSI
+        int lcd_cmd_bits = 8;             ///< Bits for LCD commands
+        int lcd_param_bits = 8;           ///< Bits for LCD parameters
+        int trans_queue_depth = TRANS_QUEUE_DEPTH_DEFAULT;  ///< Maximum number of queued color transactions
+        int max_transfer_size = 0;        ///< Maximum bytes of a color transaction like SPI host, `0` means no limit
+        int trans_overhead_us = 0;        ///< Fixed setup cost of each transaction (driver + DMA), in microseconds
+        int h_blank_px = 0;               ///< Horizontal blanking (HSW + HBP + HFP) for RGB/MIPI-DSI, in pixels
+        int v_blank_lines = 0;            ///< Vertical blanking (VSW + VBP + VFP) for RGB/MIPI-DSI, in lines
+    };
+
+    /**
+     * @brief Statistics of the simulated transactions
+     */
+    struct Statistics {
+        uint32_t param_trans_num = 0;     ///< Number of command/parameter transactions
+        uint32_t color_trans_num = 0;     ///< Number of color transactions
+        uint32_t color_no_cmd_num = 0;    ///< Number of color transactions without command
+        uint32_t color_continue_num = 0;  ///< Number of color transactions with the command `LCD_CMD_RAMWRC`
+        uint64_t param_bytes = 0;         ///< Total bytes of commands and parameters
+        uint64_t color_bytes = 0;         ///< Total bytes of color data
+        uint64_t busy_time_us = 0;        ///< Total simulated bus busy time, in microseconds
+        uint32_t queue_depth_max = 0;     ///< Maximum number of in-flight color transactions observed
+        uint32_t refresh_frames = 0;      ///< Number of simulated refresh frames (RGB/MIPI-DSI only)
+    };
+
+// *INDENT-OFF*
+    /**
+     * @brief Construct a new virtual bus instance with individual parameters
+     *
+     * Uses default values for most configurations. Call `config*()` functions to modify the default settings
+     *
+     * @param[in] emulated_type Emulated bus type, `ESP_PANEL_BUS_TYPE_SPI/QSPI/RGB/MIPI_DSI`
+     * @param[in] clock_hz Bus clock, see `Config::clock_hz`
+     * @param[in] data_lines Data lines, see `Config::data_lines`
+     */
+    BusVirtual(int emulated_type, int clock_hz, int data_lines):
+        Bus(BASIC_ATTRIBUTES_DEFAULT),
+        _config{
+            .emulated_type = emulated_type,
+            .clock_hz = clock_hz,
+            .data_lines = data_lines,
+        }
+    {
+    }
+
+    /**
+     * @brief Construct a new virtual bus instance with complete configuration
+     *
+     * @param[in] config Complete virtual bus configuration
+     */
+    BusVirtual(const Config &config):
+        Bus(BASIC_ATTRIBUTES_DEFAULT),
+        _config(config)
+    {
+    }
+// *INDENT-ON*
+
+    /**
+     * @brief Destroy the virtual bus instance
+     */
+    ~BusVirtual() override;
+
+    /**
+     * @brief Configure the transaction queue depth
+     *
+     * @param[in] depth Queue depth for color transactions
+     * @return `true` if configuration succeeds, `false` otherwise
+     * @note This function should be called before `init()`
+     */
+    bool configVirtual_TransQueueDepth(uint8_t depth);
+
+    /**
+     * @brief Configure the maximum bytes of a color transaction, like the `max_transfer_sz` of the SPI host
+     *
+     * @param[in] size Maximum bytes, `0` means no limit
+     * @return `true` if configuration succeeds, `false` otherwise
+     * @note This function should be called before `init()`
+     */
+    bool configVirtual_MaxTransferSize(uint32_t size);
+
+    /**
+     * @brief Configure the fixed setup cost of each transaction
+     *
+     * @param[in] overhead_us Overhead in microseconds
+     * @return `true` if configuration succeeds, `false` otherwise
+     * @note This function should be called before `init()`
+     */
+    bool configVirtual_TransOverhead(uint32_t overhead_us);
+
+    /**
+     * @brief Configure the blanking of the emulated RGB/MIPI-DSI timing
+     *
+     * @param[in] h_blank_px Horizontal blanking in pixels
+     * @param[in] v_blank_lines Vertical blanking in lines
+     * @return `true` if configuration succeeds, `false` otherwise
+     * @note This function should be called before `init()`
+     */
+    bool configVirtual_Blanking(uint32_t h_blank_px, uint32_t v_blank_lines);
+
+    /**
+     * @brief Initialize the virtual bus
+     *
+     * @return `true` if initialization succeeds, `false` otherwise
+     */
+    bool init() override;
+
+    /**
+     * @brief Start the virtual bus operation
+     *
+     * @return `true` if startup succeeds, `false` otherwise
+     * @note This function creates the in-memory control panel and the simulation timers
+     */
+    bool begin() override;
+
+    /**
+     * @brief Delete the virtual bus instance and release resources
+     *
+     * @return `true` if deletion succeeds, `false` otherwise
+     */
+    bool del() override;
+
+    /**
+     * @brief Register the callback of the simulated refresh finish event
+     *
+     * @param[in] callback Callback function, `nullptr` to unregister
+     * @param[in] user_ctx User context passed to the callback
+     * @return `true` if successful, `false` otherwise
+     * @note The callback is called from the `esp_timer` task
+     */
+    bool registerRefreshFinishCallback(FunctionRefreshFinishCallback callback, void *user_ctx);
+
+    /**
+     * @brief Start the simulated frame refresh of RGB/MIPI-DSI bus
+     *
+     * @param[in] h_res Horizontal resolution in pixels
+     * @param[in] v_res Vertical resolution in pixels
+     * @param[in] bits_per_pixel Color depth in bits per pixel
+     * @return `true` if successful, `false` otherwise
+     * @note This function does nothing for SPI/QSPI bus which doesn't refresh the panel by itself
+     */
+    bool startRefresh(int h_res, int v_res, int bits_per_pixel);
+
+    /**
+     * @brief Stop the simulated frame refresh
+     *
+     * @return `true` if successful, `false` otherwise
+     */
+    bool stopRefresh();
+
+    /**
+     * @brief Calculate the simulated time to transfer data on the emulated bus
+     *
+     * @param[in] bytes Number of bytes to transfer
+     * @param[in] with_command Whether a command phase is transferred before the data
+     * @return Transfer time in microseconds, including `Config::trans_overhead_us`
+     * @note For RGB/MIPI-DSI bus, the color data is copied into the frame buffer by CPU (or DMA2D), so only the
+     *       overhead is counted
+     */
+    uint32_t calculateTransferTimeUs(uint32_t bytes, bool with_command = true) const;
+
+    /**
+     * @brief Calculate the simulated refresh period of the emulated RGB/MIPI-DSI bus
+     *
+     * @param[in] h_res Horizontal resolution in pixels
+     * @param[in] v_res Vertical resolution in pixels
+     * @param[in] bits_per_pixel Color depth in bits per pixel
+     * @return Refresh period in microseconds, `0` for SPI/QSPI bus
+     */
+    uint32_t calculateRefreshPeriodUs(int h_res, int v_res, int bits_per_pixel) const;
+
+    /**
+     * @brief Reset the statistics
+     */
+    void resetStatistics();
+
+    /**
+     * @brief Get the statistics of the simulated transactions
+     *
+     * @return Copy of the current statistics
+     */
+    Statistics getStatistics() const;
+
+    /**
+     * @brief Get the current bus configuration
+     *
+     * @return Reference to the current bus configuration
+     */
+    const Config &getConfig() const
+    {
+        return _config;
+    }
+
+private:
+    struct ControlPanel;
+
+    /**
+     * @brief Simulated transaction in the queue
+     */
+    struct Transaction {
+        int64_t end_time_us = 0;            ///< Absolute time when the transaction finishes
+        uint32_t bytes = 0;                 ///< Color bytes of the transaction
+    };
+
+    /**
+     * @brief Wait until all queued color transactions are finished
+     *
+     * @return `true` if successful, `false` otherwise
+     */
+    bool waitQueueEmpty();
+
+    /**
+     * @brief Account a blocking command/parameter transaction and busy wait for its simulated time
+     *
+     * @param[in] bytes Number of parameter bytes
+     * @return `true` if successful, `false` otherwise
+     */
+    bool transmitParam(uint32_t bytes);
+
+    /**
+     * @brief Queue a color transaction, block if the queue is full
+     *
+     * @param[in] lcd_cmd Command of the transaction, `-1` means no command
+     * @param[in] bytes Number of color bytes
+     * @return `true` if successful, `false` otherwise
+     */
+    bool transmitColor(int lcd_cmd, uint32_t bytes);
+
+    static esp_err_t onIO_RxParam(esp_lcd_panel_io_t *io, int lcd_cmd, void *param, size_t param_size);
+    static esp_err_t onIO_TxParam(esp_lcd_panel_io_t *io, int lcd_cmd, const void *param, size_t param_size);
+    static esp_err_t onIO_TxColor(esp_lcd_panel_io_t *io, int lcd_cmd, const void *color, size_t color_size);
+    static esp_err_t onIO_Delete(esp_lcd_panel_io_t *io);
+    static esp_err_t onIO_RegisterEventCallbacks(
+        esp_lcd_panel_io_t *io, const esp_lcd_panel_io_callbacks_t *cbs, void *user_ctx
+    );
+    static void onTransTimerExpired(void *arg);
+    static void onRefreshTimerExpired(void *arg);
+
+    Config _config = {};                                ///< Virtual bus configuration
+    Statistics _statistics = {};                        ///< Statistics of the simulated transactions
+    portMUX_TYPE _lock = portMUX_INITIALIZER_UNLOCKED;  ///< Lock for the queue and statistics
+    utils::vector<Transaction> _trans_queue;            ///< Ring buffer of in-flight color transactions
+    size_t _trans_queue_head = 0;                       ///< Index of the oldest transaction
+    size_t _trans_queue_num = 0;                        ///< Number of in-flight transactions
+    int64_t _bus_busy_until_us = 0;                     ///< Absolute time when the bus becomes idle
+    SemaphoreHandle_t _trans_slot_sem = nullptr;        ///< Counting semaphore of free queue slots
+    esp_timer_handle_t _trans_timer = nullptr;          ///< Timer to finish the head transaction
+    esp_timer_handle_t _refresh_timer = nullptr;        ///< Timer to simulate the frame refresh
+    esp_lcd_panel_io_color_trans_done_cb_t _on_color_trans_done = nullptr;  ///< Color transfer done callback
+    void *_on_color_trans_done_ctx = nullptr;           ///< User context of `_on_color_trans_done`
+    FunctionRefreshFinishCallback _on_refresh_finish = nullptr; ///< Refresh finish callback
+    void *_on_refresh_finish_ctx = nullptr;             ///< User context of `_on_refresh_finish`
+};
+
+} // namespace esp_panel::drivers
@@ -4,13 +4,22 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <stdlib.h>
 #include <string.h>
 
+#include "soc/soc_caps.h"
 #include "driver/gpio.h"
 #include "driver/spi_master.h"
+#if SOC_DEDICATED_GPIO_SUPPORTED
+#include "driver/dedic_gpio.h"
+#include "esp_rom_gpio.h"
+#include "soc/gpio_sig_map.h"
+#endif
+#include "esp_idf_version.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "esp_check.h"
+#include "esp_rom_sys.h"
 #include "esp_lcd_panel_io_interface.h"
 
 #include "utils/esp_panel_utils_log.h"
@@ -26,6 +35,11 @@
 #define WRITE_ORDER_LSB_MASK    (0x01)  // Bit mask for LSB first write order
 #define WRITE_ORDER_MSB_MASK    (0x80)  // Bit mask for MSB first write order
 
+#define LINE_NUM                (3)     // Number of SPI lines
+#define STEP_LEVELS_MASK        (0x07)  // Bit mask of the line levels in a step, bit n is the level of line n
+#define STEP_DELAY_FLAG         (0x80)  // Wait for half SCL period after the step
+#define PACKAGE_STEPS_MAX(bits) (4 + (bits) * 2) // Steps to write a package with the given number of bits
+
 /**
  * @brief Enumeration of SPI lines
  */
@@ -48,6 +62,16 @@ typedef struct {
     panel_io_type_t sda_io_type;            /*!< IO type of SDA line */
     int sda_io_num;                         /*!< GPIO used for SDA line */
     esp_io_expander_handle_t io_expander;   /*!< IO expander handle, set to NULL if not used */
+    uint32_t expander_line_masks[LINE_NUM]; /*!< IO expander pin mask of each line, 0 if the line is GPIO */
+    uint8_t gpio_lines;                     /*!< Bit mask of the lines using GPIO */
+    uint8_t expander_lines;                 /*!< Bit mask of the lines using IO expander */
+    uint8_t line_levels;                    /*!< Current levels of the lines, bit n is the level of line n */
+#if SOC_DEDICATED_GPIO_SUPPORTED
+    dedic_gpio_bundle_handle_t gpio_bundle; /*!< Dedicated GPIO bundle of the GPIO lines, NULL if not available */
+    uint32_t gpio_bundle_masks[LINE_NUM];   /*!< Bundle channel mask of each line, 0 if the line is not in bundle */
+    int gpio_bundle_core_id;                /*!< CPU core which the bundle is bound to */
+    portMUX_TYPE gpio_bundle_lock;          /*!< Lock to keep the task on the same core when writing the bundle */
+#endif
     uint32_t scl_half_period_us;            /*!< SCL half period in us */
     uint32_t lcd_cmd_bytes: 3;              /*!< Bytes of LCD command (1 ~ 4) */
     uint32_t cmd_dc_bit: 2;                 /*!< DC bit of command */
@@ -72,7 +96,10 @@ static esp_err_t panel_io_register_event_callbacks(esp_lcd_panel_io_handle_t io,
 
 static esp_err_t set_line_level(esp_lcd_panel_io_3wire_spi_t *panel_io, spi_line_t line, uint32_t level);
 static esp_err_t reset_line_io(esp_lcd_panel_io_3wire_spi_t *panel_io, spi_line_t line);
-static esp_err_t spi_write_package(esp_lcd_panel_io_3wire_spi_t *panel_io, bool is_cmd, uint32_t data);
+static void create_gpio_bundle(esp_lcd_panel_io_3wire_spi_t *panel_io);
+static esp_err_t delete_gpio_bundle(esp_lcd_panel_io_3wire_spi_t *panel_io);
+static size_t spi_build_package(esp_lcd_panel_io_3wire_spi_t *panel_io, bool is_cmd, uint32_t data, uint8_t *steps);
+static esp_err_t spi_write_steps(esp_lcd_panel_io_3wire_spi_t *panel_io, const uint8_t *steps, size_t step_num);
 
 esp_err_t esp_lcd_new_panel_io_3wire_spi(const esp_lcd_panel_io_3wire_spi_config_t *io_config, esp_lcd_panel_io_handle_t *ret_io)
 {
@@ -131,18 +158,27 @@ esp_err_t esp_lcd_new_panel_io_3wire_spi(const esp_lcd_panel_io_3wire_spi_config
     uint32_t expander_pin_mask = 0;
     if (panel_io->cs_io_type == IO_TYPE_GPIO) {
         gpio_mask |= BIT64(panel_io->cs_io_num);
+        panel_io->gpio_lines |= BIT(CS);
     } else {
         expander_pin_mask |= panel_io->cs_io_num;
+        panel_io->expander_lines |= BIT(CS);
+        panel_io->expander_line_masks[CS] = panel_io->cs_io_num;
     }
     if (panel_io->scl_io_type == IO_TYPE_GPIO) {
         gpio_mask |= BIT64(panel_io->scl_io_num);
+        panel_io->gpio_lines |= BIT(SCL);
     } else {
         expander_pin_mask |= panel_io->scl_io_num;
+        panel_io->expander_lines |= BIT(SCL);
+        panel_io->expander_line_masks[SCL] = panel_io->scl_io_num;
     }
     if (panel_io->sda_io_type == IO_TYPE_GPIO) {
         gpio_mask |= BIT64(panel_io->sda_io_num);
+        panel_io->gpio_lines |= BIT(SDA);
     } else {
         expander_pin_mask |= panel_io->sda_io_num;
+        panel_io->expander_lines |= BIT(SDA);
+        panel_io->expander_line_masks[SDA] = panel_io->sda_io_num;
     }
     // Configure GPIOs
     if (gpio_mask) {
@@ -166,6 +202,10 @@ esp_err_t esp_lcd_new_panel_io_3wire_spi(const esp_lcd_panel_io_3wire_spi_config
     ESP_GOTO_ON_ERROR(set_line_level(panel_io, CS, cs_idle_level), err, TAG, "Set CS level failed");
     ESP_GOTO_ON_ERROR(set_line_level(panel_io, SCL, sda_scl_idle_level), err, TAG, "Set SCL level failed");
     ESP_GOTO_ON_ERROR(set_line_level(panel_io, SDA, sda_scl_idle_level), err, TAG, "Set SDA level failed");
+    panel_io->line_levels = (cs_idle_level << CS) | (sda_scl_idle_level << SCL) | (sda_scl_idle_level << SDA);
+
+    // Drive the GPIO lines together by dedicated GPIO if possible, otherwise they are set one by one
+    create_gpio_bundle(panel_io);
 
     *ret_io = (esp_lcd_panel_io_handle_t)panel_io;
     return ESP_OK;
@@ -188,28 +228,36 @@ err:
 static esp_err_t panel_io_tx_param(esp_lcd_panel_io_t *io, int lcd_cmd, const void *param, size_t param_size)
 {
     esp_lcd_panel_io_3wire_spi_t *panel_io = __containerof(io, esp_lcd_panel_io_3wire_spi_t, base);
+    uint32_t param_bytes = panel_io->lcd_param_bytes;
+    size_t param_count = (param != NULL) ? param_size / param_bytes : 0;
+    size_t package_num = ((lcd_cmd >= 0) ? 1 : 0) + param_count;
+    if (package_num == 0) {
+        return ESP_OK;
+    }
 
-    // Send command
+    // Precompute the line levels of the whole command and parameters, so they can be written in batches
+    size_t package_bits = (LCD_CMD_BYTES_MAX > LCD_PARAM_BYTES_MAX ? LCD_CMD_BYTES_MAX : LCD_PARAM_BYTES_MAX) * 8 + 1;
+    uint8_t *steps = malloc(package_num * PACKAGE_STEPS_MAX(package_bits));
+    ESP_RETURN_ON_FALSE(steps, ESP_ERR_NO_MEM, TAG, "No memory for steps");
+    size_t step_num = 0;
+
+    // Command
     if (lcd_cmd >= 0) {
-        ESP_RETURN_ON_ERROR(spi_write_package(panel_io, true, lcd_cmd), TAG, "SPI write package failed");
+        step_num += spi_build_package(panel_io, true, lcd_cmd, steps + step_num);
     }
-
-    // Send parameter
-    if (param != NULL && param_size > 0) {
+    // Parameters
+    for (int i = 0; i < param_count; i++) {
         uint32_t param_data = 0;
-        uint32_t param_bytes = panel_io->lcd_param_bytes;
-        size_t param_count = param_size / param_bytes;
-
-        // Iteratively get parameter packages and send them one by one
-        for (int i = 0; i < param_count; i++) {
-            param_data = 0;
-            for (int j = 0; j < param_bytes; j++) {
-                param_data |= ((uint8_t *)param)[i * param_bytes + j] << (j * 8);
-            }
-            ESP_RETURN_ON_ERROR(spi_write_package(panel_io, false, param_data), TAG, "SPI write package failed");
+        for (int j = 0; j < param_bytes; j++) {
+            param_data |= ((uint8_t *)param)[i * param_bytes + j] << (j * 8);
         }
+        step_num += spi_build_package(panel_io, false, param_data, steps + step_num);
     }
 
+    esp_err_t ret = spi_write_steps(panel_io, steps, step_num);
+    free(steps);
+    ESP_RETURN_ON_ERROR(ret, TAG, "SPI write steps failed");
+
     return ESP_OK;
 }
 
@@ -217,6 +265,7 @@ static esp_err_t panel_io_del(esp_lcd_panel_io_t *io)
 {
     esp_lcd_panel_io_3wire_spi_t *panel_io = __containerof(io, esp_lcd_panel_io_3wire_spi_t, base);
 
+    ESP_RETURN_ON_ERROR(delete_gpio_bundle(panel_io), TAG, "Delete GPIO bundle failed");
     if (!panel_io->flags.del_keep_cs_inactive) {
         ESP_RETURN_ON_ERROR(reset_line_io(panel_io, CS), TAG, "Reset CS line failed");
     } else {
@@ -361,89 +410,299 @@ static void delay_us(uint32_t delay_us)
 }
 
 /**
- * @brief Write one byte to LCD panel
+ * @brief Create a dedicated GPIO bundle for the GPIO lines
+ *
+ * @note  The lines are still set by `gpio_set_level()` if the target doesn't support dedicated GPIO or there is no free
+ *        channel, so the failure is not an error.
+ * @note  The bundle can only be written from the core where it is created, so it is only created when the calling task
+ *        is pinned to a core.
+ *
+ * @param[in] panel_io Pointer to panel IO instance
+ *
+ */
+static void create_gpio_bundle(esp_lcd_panel_io_3wire_spi_t *panel_io)
+{
+#if SOC_DEDICATED_GPIO_SUPPORTED
+    const int line_gpios[LINE_NUM] = {panel_io->cs_io_num, panel_io->scl_io_num, panel_io->sda_io_num};
+    int bundle_gpios[LINE_NUM] = {0};
+    size_t bundle_size = 0;
+
+    if (__builtin_popcount(panel_io->gpio_lines) < 2) {
+        return;
+    }
+#if !CONFIG_FREERTOS_UNICORE
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 3, 0)
+    BaseType_t task_core_id = xTaskGetCoreID(NULL);
+#else
+    BaseType_t task_core_id = xTaskGetAffinity(NULL);
+#endif
+    if (task_core_id == tskNO_AFFINITY) {
+        ESP_LOGD(TAG, "Task is not pinned to a core, set GPIO lines one by one");
+        return;
+    }
+#endif
+    for (int i = 0; i < LINE_NUM; i++) {
+        if (panel_io->gpio_lines & BIT(i)) {
+            panel_io->gpio_bundle_masks[i] = BIT(bundle_size);
+            bundle_gpios[bundle_size++] = line_gpios[i];
+        }
+    }
+
+    dedic_gpio_bundle_config_t bundle_config = {
+        .gpio_array = bundle_gpios,
+        .array_size = bundle_size,
+        .flags = {
+            .out_en = 1,
+        },
+    };
+    // The bundle is bound to the current core
+    panel_io->gpio_bundle_core_id = xPortGetCoreID();
+    if (dedic_gpio_new_bundle(&bundle_config, &panel_io->gpio_bundle) != ESP_OK) {
+        ESP_LOGW(TAG, "Create GPIO bundle failed, set GPIO lines one by one");
+        panel_io->gpio_bundle = NULL;
+        memset(panel_io->gpio_bundle_masks, 0, sizeof(panel_io->gpio_bundle_masks));
+        return;
+    }
+    portMUX_INITIALIZE(&panel_io->gpio_bundle_lock);
+
+    // Sync the current levels to the bundle
+    uint32_t bundle_mask = 0;
+    uint32_t bundle_value = 0;
+    for (int i = 0; i < LINE_NUM; i++) {
+        bundle_mask |= panel_io->gpio_bundle_masks[i];
+        if (panel_io->line_levels & BIT(i)) {
+            bundle_value |= panel_io->gpio_bundle_masks[i];
+        }
+    }
+    dedic_gpio_bundle_write(panel_io->gpio_bundle, bundle_mask, bundle_value);
+#endif
+}
+
+/**
+ * @brief Delete the dedicated GPIO bundle and route the GPIO lines back to the GPIO output register
+ *
+ * @note  The dedicated GPIO bundle connects the pins to its own output signals, so `gpio_set_level()` doesn't drive
+ *        them until they are routed back to `SIG_GPIO_OUT_IDX`. The current levels are set first to avoid glitches.
  *
  * @param[in] panel_io Pointer to panel IO instance
- * @param[in] dc_bit   DC bit
- * @param[in] data     8-bit data to write
  *
  * @return
- *      - ESP_OK:              Success
- *      - ESP_ERR_INVALID_ARG: Invalid argument
+ *      - ESP_OK:              Success, or there is no bundle
  *      - Others:              Fail
  */
-static esp_err_t spi_write_byte(esp_lcd_panel_io_3wire_spi_t *panel_io, int dc_bit, uint8_t data)
+static esp_err_t delete_gpio_bundle(esp_lcd_panel_io_3wire_spi_t *panel_io)
 {
-    uint16_t data_temp = data;
-    uint8_t data_bits = (dc_bit != DATA_NO_DC_BIT) ? 9 : 8;
-    uint16_t write_order_mask = panel_io->write_order_mask;
-    uint32_t scl_active_befor_level = panel_io->flags.scl_active_rising_edge ? 0 : 1;
-    uint32_t scl_active_after_level = !scl_active_befor_level;
-    uint32_t scl_half_period_us = panel_io->scl_half_period_us;
+#if SOC_DEDICATED_GPIO_SUPPORTED
+    if (panel_io->gpio_bundle == NULL) {
+        return ESP_OK;
+    }
 
-    for (uint8_t i = 0; i < data_bits; i++) {
-        // Send DC bit first
-        if (data_bits == 9 && i == 0) {
-            ESP_RETURN_ON_ERROR(set_line_level(panel_io, SDA, dc_bit), TAG, "Set SDA level failed");
-        } else { // Then send data bit
-            // SDA set to data bit
-            ESP_RETURN_ON_ERROR(set_line_level(panel_io, SDA, data_temp & write_order_mask), TAG, "Set SDA level failed");
-            // Get next bit
-            data_temp = (write_order_mask == WRITE_ORDER_LSB_MASK) ? data_temp >> 1 : data_temp << 1;
+    const int line_gpios[LINE_NUM] = {panel_io->cs_io_num, panel_io->scl_io_num, panel_io->sda_io_num};
+    for (int i = 0; i < LINE_NUM; i++) {
+        if (panel_io->gpio_bundle_masks[i]) {
+            ESP_RETURN_ON_ERROR(gpio_set_level(line_gpios[i], (panel_io->line_levels & BIT(i)) ? 1 : 0), TAG,
+                                "Set GPIO level failed");
+        }
+    }
+    ESP_RETURN_ON_ERROR(dedic_gpio_del_bundle(panel_io->gpio_bundle), TAG, "Delete GPIO bundle failed");
+    panel_io->gpio_bundle = NULL;
+    for (int i = 0; i < LINE_NUM; i++) {
+        if (panel_io->gpio_bundle_masks[i]) {
+            esp_rom_gpio_connect_out_signal(line_gpios[i], SIG_GPIO_OUT_IDX, false, false);
+            panel_io->gpio_bundle_masks[i] = 0;
         }
-        // Generate SCL active edge
-        ESP_RETURN_ON_ERROR(set_line_level(panel_io, SCL, scl_active_befor_level), TAG, "Set SCL level failed");
-        delay_us(scl_half_period_us);
-        ESP_RETURN_ON_ERROR(set_line_level(panel_io, SCL, scl_active_after_level), TAG, "Set SCL level failed");
-        delay_us(scl_half_period_us);
     }
+#endif
 
     return ESP_OK;
 }
 
 /**
- * @brief Write a package of data to LCD panel in big-endian order
+ * @brief Write the levels of the GPIO lines
  *
  * @param[in] panel_io Pointer to panel IO instance
- * @param[in] is_cmd   True for command, false for data
- * @param[in] data     Data to write, with
+ * @param[in] levels   Target levels, bit n is the level of line n
+ * @param[in] lines    Bit mask of the lines to write
  *
  * @return
  *      - ESP_OK:              Success
- *      - ESP_ERR_INVALID_ARG: Invalid argument
  *      - Others:              Fail
  */
-static esp_err_t spi_write_package(esp_lcd_panel_io_3wire_spi_t *panel_io, bool is_cmd, uint32_t data)
+static esp_err_t write_gpio_lines(esp_lcd_panel_io_3wire_spi_t *panel_io, uint8_t levels, uint8_t lines)
+{
+    const int line_gpios[LINE_NUM] = {panel_io->cs_io_num, panel_io->scl_io_num, panel_io->sda_io_num};
+
+#if SOC_DEDICATED_GPIO_SUPPORTED
+    if (panel_io->gpio_bundle) {
+        uint32_t bundle_mask = 0;
+        uint32_t bundle_value = 0;
+        for (int i = 0; i < LINE_NUM; i++) {
+            if (lines & BIT(i)) {
+                bundle_mask |= panel_io->gpio_bundle_masks[i];
+                bundle_value |= (levels & BIT(i)) ? panel_io->gpio_bundle_masks[i] : 0;
+            }
+        }
+        // The task can't be moved to another core inside the critical section
+        bool is_written = false;
+        portENTER_CRITICAL(&panel_io->gpio_bundle_lock);
+        if (xPortGetCoreID() == panel_io->gpio_bundle_core_id) {
+            dedic_gpio_bundle_write(panel_io->gpio_bundle, bundle_mask, bundle_value);
+            is_written = true;
+        }
+        portEXIT_CRITICAL(&panel_io->gpio_bundle_lock);
+        if (is_written) {
+            return ESP_OK;
+        }
+        // Called from another core, fall back to `gpio_set_level()` from now on
+        ESP_LOGW(TAG, "Called from core %d but GPIO bundle is bound to core %d, set GPIO lines one by one",
+                 xPortGetCoreID(), panel_io->gpio_bundle_core_id);
+        ESP_RETURN_ON_ERROR(delete_gpio_bundle(panel_io), TAG, "Delete GPIO bundle failed");
+    }
+#endif
+
+    // SDA is set before SCL, so the data is ready at the clock edge even if the lines are not set at the same time
+    const spi_line_t line_order[LINE_NUM] = {SDA, SCL, CS};
+    for (int i = 0; i < LINE_NUM; i++) {
+        spi_line_t line = line_order[i];
+        if (lines & BIT(line)) {
+            ESP_RETURN_ON_ERROR(gpio_set_level(line_gpios[line], (levels & BIT(line)) ? 1 : 0), TAG,
+                                "Set GPIO level failed");
+        }
+    }
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Write the levels of the IO expander lines by a single output register write
+ *
+ * @note  The output register is read before writing, which is usually a shadow register in the driver, so the other
+ *        pins of the IO expander are not affected.
+ *
+ * @param[in] panel_io Pointer to panel IO instance
+ * @param[in] levels   Target levels, bit n is the level of line n
+ * @param[in] lines    Bit mask of the lines to write
+ *
+ * @return
+ *      - ESP_OK:              Success
+ *      - Others:              Fail
+ */
+static esp_err_t write_expander_lines(esp_lcd_panel_io_3wire_spi_t *panel_io, uint8_t levels, uint8_t lines)
+{
+    esp_io_expander_handle_t handle = panel_io->io_expander;
+    uint32_t output_reg = 0;
+    ESP_RETURN_ON_ERROR(handle->read_output_reg(handle, &output_reg), TAG, "Read output reg failed");
+
+    uint32_t new_output_reg = output_reg;
+    for (int i = 0; i < LINE_NUM; i++) {
+        if (!(lines & BIT(i))) {
+            continue;
+        }
+        bool is_bit_set = ((levels & BIT(i)) != 0) != handle->config.flags.output_high_bit_zero;
+        if (is_bit_set) {
+            new_output_reg |= panel_io->expander_line_masks[i];
+        } else {
+            new_output_reg &= ~panel_io->expander_line_masks[i];
+        }
+    }
+    if (new_output_reg != output_reg) {
+        ESP_RETURN_ON_ERROR(handle->write_output_reg(handle, new_output_reg), TAG, "Write output reg failed");
+    }
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Build the steps to write a package of data to LCD panel in big-endian order
+ *
+ * Each step is the levels of all lines, and the lines changed in a step are written together. The waveform is the
+ * same as setting the lines one by one, except that SDA changes together with the inactive edge of SCL.
+ *
+ * @param[in]  panel_io Pointer to panel IO instance
+ * @param[in]  is_cmd   True for command, false for data
+ * @param[in]  data     Data to write
+ * @param[out] steps    Buffer to store the steps, at least `PACKAGE_STEPS_MAX(33)` bytes
+ *
+ * @return Number of the steps
+ */
+static size_t spi_build_package(esp_lcd_panel_io_3wire_spi_t *panel_io, bool is_cmd, uint32_t data, uint8_t *steps)
 {
     uint32_t data_bytes = is_cmd ? panel_io->lcd_cmd_bytes : panel_io->lcd_param_bytes;
-    uint32_t cs_idle_level = panel_io->flags.cs_high_active ? 0 : 1;
-    uint32_t sda_scl_idle_level = panel_io->flags.sda_scl_idle_high ? 1 : 0;
-    uint32_t scl_active_befor_level = panel_io->flags.scl_active_rising_edge ? 0 : 1;
-    uint32_t time_us = panel_io->scl_half_period_us;
+    uint8_t cs_idle_level = panel_io->flags.cs_high_active ? 0 : 1;
+    uint8_t sda_scl_idle_level = panel_io->flags.sda_scl_idle_high ? 1 : 0;
+    uint8_t scl_active_befor_level = panel_io->flags.scl_active_rising_edge ? 0 : 1;
+    uint8_t scl_active_after_level = !scl_active_befor_level;
+    uint16_t write_order_mask = panel_io->write_order_mask;
     // Swap command bytes order due to different endianness
     uint32_t swap_data = SPI_SWAP_DATA_TX(data, data_bytes * 8);
     int data_dc_bit = is_cmd ? panel_io->cmd_dc_bit : panel_io->param_dc_bit;
+    uint8_t idle_levels = (sda_scl_idle_level << SCL) | (sda_scl_idle_level << SDA);
+    uint8_t cs_active = (!cs_idle_level) << CS;
+    size_t num = 0;
 
     // CS active
-    ESP_RETURN_ON_ERROR(set_line_level(panel_io, CS, !cs_idle_level), TAG, "Set CS level failed");
-    delay_us(time_us);
-    ESP_RETURN_ON_ERROR(set_line_level(panel_io, SCL, scl_active_befor_level), TAG, "Set SCL level failed");
-    // Send data byte by byte
+    steps[num++] = cs_active | idle_levels | STEP_DELAY_FLAG;
+    steps[num++] = cs_active | (scl_active_befor_level << SCL) | (sda_scl_idle_level << SDA);
+    // Send data byte by byte, only set DC bit for the first byte
     for (int i = 0; i < data_bytes; i++) {
-        // Only set DC bit for the first byte
-        if (i == 0) {
-            ESP_RETURN_ON_ERROR(spi_write_byte(panel_io, data_dc_bit, swap_data & 0xff), TAG, "SPI write byte failed");
-        } else {
-            ESP_RETURN_ON_ERROR(spi_write_byte(panel_io, DATA_NO_DC_BIT, swap_data & 0xff), TAG, "SPI write byte failed");
+        uint16_t data_temp = swap_data & 0xff;
+        bool has_dc_bit = (i == 0) && (data_dc_bit != DATA_NO_DC_BIT);
+        uint8_t data_bits = has_dc_bit ? 9 : 8;
+        for (int j = 0; j < data_bits; j++) {
+            uint8_t sda_level = 0;
+            if (has_dc_bit && (j == 0)) {
+                sda_level = data_dc_bit;
+            } else {
+                sda_level = (data_temp & write_order_mask) ? 1 : 0;
+                data_temp = (write_order_mask == WRITE_ORDER_LSB_MASK) ? data_temp >> 1 : data_temp << 1;
+            }
+            // Set SDA with the inactive edge, then generate the active edge
+            steps[num++] = cs_active | (scl_active_befor_level << SCL) | (sda_level << SDA) | STEP_DELAY_FLAG;
+            steps[num++] = cs_active | (scl_active_after_level << SCL) | (sda_level << SDA) | STEP_DELAY_FLAG;
         }
         swap_data >>= 8;
     }
-    ESP_RETURN_ON_ERROR(set_line_level(panel_io, SCL, sda_scl_idle_level), TAG, "Set SCL level failed");
-    ESP_RETURN_ON_ERROR(set_line_level(panel_io, SDA, sda_scl_idle_level), TAG, "Set SDA level failed");
-    delay_us(time_us);
+    steps[num++] = cs_active | idle_levels | STEP_DELAY_FLAG;
     // CS inactive
-    ESP_RETURN_ON_ERROR(set_line_level(panel_io, CS, cs_idle_level), TAG, "Set CS level failed");
-    delay_us(time_us);
+    steps[num++] = (cs_idle_level << CS) | idle_levels | STEP_DELAY_FLAG;
+
+    return num;
+}
+
+/**
+ * @brief Write the steps to the lines
+ *
+ * For each step, the changed GPIO lines are written together by the dedicated GPIO bundle, and the changed IO
+ * expander lines are written by a single output register write.
+ *
+ * @param[in] panel_io Pointer to panel IO instance
+ * @param[in] steps    Steps built by `spi_build_package()`
+ * @param[in] step_num Number of the steps
+ *
+ * @return
+ *      - ESP_OK:              Success
+ *      - Others:              Fail
+ */
+static esp_err_t spi_write_steps(esp_lcd_panel_io_3wire_spi_t *panel_io, const uint8_t *steps, size_t step_num)
+{
+    uint32_t scl_half_period_us = panel_io->scl_half_period_us;
+
+    for (size_t i = 0; i < step_num; i++) {
+        uint8_t levels = steps[i] & STEP_LEVELS_MASK;
+        uint8_t changed_lines = levels ^ panel_io->line_levels;
+        if (changed_lines & panel_io->gpio_lines) {
+            ESP_RETURN_ON_ERROR(write_gpio_lines(panel_io, levels, changed_lines & panel_io->gpio_lines), TAG,
+                                "Write GPIO lines failed");
+        }
+        if (changed_lines & panel_io->expander_lines) {
+            ESP_RETURN_ON_ERROR(write_expander_lines(panel_io, levels, changed_lines & panel_io->expander_lines), TAG,
+                                "Write IO expander lines failed");
+        }
+        panel_io->line_levels = levels;
+        if (steps[i] & STEP_DELAY_FLAG) {
+            delay_us(scl_half_period_us);
+        }
+    }
 
     return ESP_OK;
 }
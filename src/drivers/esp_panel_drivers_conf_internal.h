@@ -55,4 +55,26 @@
     #endif
 #endif // ESP_PANEL_DRIVERS_FILE_SKIP
 
+#ifndef ESP_PANEL_DRIVERS_INCLUDE_INSIDE
+    /**
+     * Define the profiler configuration
+     *
+     */
+    #ifndef ESP_PANEL_DRIVERS_ENABLE_PROFILER
+        #ifdef CONFIG_ESP_PANEL_DRIVERS_ENABLE_PROFILER
+            #define ESP_PANEL_DRIVERS_ENABLE_PROFILER CONFIG_ESP_PANEL_DRIVERS_ENABLE_PROFILER
+        #else
+            #define ESP_PANEL_DRIVERS_ENABLE_PROFILER (0)
+        #endif
+    #endif
+
+    #ifndef ESP_PANEL_DRIVERS_PROFILER_MAX_RECORDS
+        #ifdef CONFIG_ESP_PANEL_DRIVERS_PROFILER_MAX_RECORDS
+            #define ESP_PANEL_DRIVERS_PROFILER_MAX_RECORDS CONFIG_ESP_PANEL_DRIVERS_PROFILER_MAX_RECORDS
+        #else
+            #define ESP_PANEL_DRIVERS_PROFILER_MAX_RECORDS (256)
+        #endif
+    #endif
+#endif // ESP_PANEL_DRIVERS_INCLUDE_INSIDE
+
 // *INDENT-ON*
@@ -5,14 +5,47 @@
  */
 
 #include "utils/esp_panel_utils_log.h"
+#include "utils/esp_panel_utils_thread.hpp"
 #include "esp_panel_host_i2c.hpp"
 
 namespace esp_panel::drivers {
 
+constexpr int THREAD_CHECK_STOP_INTERVAL_MS = 100;
+
+static bool append_transaction(i2c_cmd_handle_t cmd, const utils::I2CQueue::Transaction &transaction)
+{
+    uint8_t address = transaction.address << 1;
+
+    if (transaction.write_size > 0) {
+        ESP_UTILS_CHECK_ERROR_RETURN(i2c_master_start(cmd), false, "Append start failed");
+        ESP_UTILS_CHECK_ERROR_RETURN(
+            i2c_master_write_byte(cmd, address | I2C_MASTER_WRITE, true), false, "Append address failed"
+        );
+        ESP_UTILS_CHECK_ERROR_RETURN(
+            i2c_master_write(cmd, transaction.write_data.data(), transaction.write_size, true), false,
+            "Append write failed"
+        );
+    }
+    if (transaction.read_size > 0) {
+        ESP_UTILS_CHECK_ERROR_RETURN(i2c_master_start(cmd), false, "Append start failed");
+        ESP_UTILS_CHECK_ERROR_RETURN(
+            i2c_master_write_byte(cmd, address | I2C_MASTER_READ, true), false, "Append address failed"
+        );
+        ESP_UTILS_CHECK_ERROR_RETURN(
+            i2c_master_read(cmd, transaction.read_buffer, transaction.read_size, I2C_MASTER_LAST_NACK), false,
+            "Append read failed"
+        );
+    }
+
+    return true;
+}
+
 HostI2C::~HostI2C()
 {
     ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
 
+    ESP_UTILS_CHECK_FALSE_EXIT(stopAsync(), "Stop async failed");
+
     if (isOverState(State::BEGIN)) {
         int id = getID();
         ESP_UTILS_CHECK_ERROR_EXIT(
@@ -53,6 +86,120 @@ end:
     return true;
 }
 
+bool HostI2C::startAsync(const AsyncConfig &config)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(isOverState(State::BEGIN), false, "Not begun");
+    ESP_UTILS_CHECK_FALSE_RETURN(!isAsync(), false, "Already started");
+
+    ESP_UTILS_LOGD(
+        "Param: task_name(%s), task_priority(%d), task_stack_size(%d), task_core_id(%d), timeout_ms(%d)",
+        config.task_name, config.task_priority, config.task_stack_size, config.task_core_id, config.timeout_ms
+    );
+    ESP_UTILS_CHECK_FALSE_RETURN(config.timeout_ms > 0, false, "Invalid timeout");
+    ESP_UTILS_CHECK_FALSE_RETURN(this->config.mode == I2C_MODE_MASTER, false, "Only master mode is supported");
+
+    std::shared_ptr<Async> async = nullptr;
+    ESP_UTILS_CHECK_EXCEPTION_RETURN(async = utils::make_shared<Async>(), false, "Create async failed");
+    ESP_UTILS_CHECK_FALSE_RETURN(async->queue.setConfig(config.queue_config), false, "Invalid queue config");
+    async->config = config;
+    async->submit_sem = xSemaphoreCreateBinaryStatic(&async->submit_sem_buffer);
+    ESP_UTILS_CHECK_NULL_RETURN(async->submit_sem, false, "Create semaphore failed");
+
+    {
+        utils::ThreadConfigGuard thread_config_guard({
+            .name = config.task_name,
+            .priority = config.task_priority,
+            .stack_size = config.task_stack_size,
+            .core_id = config.task_core_id,
+        });
+        ESP_UTILS_CHECK_EXCEPTION_RETURN(
+            async->thread = std::thread(&HostI2C::runAsync, this, std::ref(*async)), false,
+            "Create async thread failed"
+        );
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_async_mutex);
+        _async = async;
+    }
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool HostI2C::stopAsync()
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    // Detach it first, so no more transactions can be submitted. The ones not executed yet are dropped by the task,
+    // and their callbacks are called with failure
+    std::shared_ptr<Async> async = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(_async_mutex);
+        async.swap(_async);
+    }
+    if (async == nullptr) {
+        ESP_UTILS_LOGD("Not started");
+        return true;
+    }
+
+    async->is_stop = true;
+    xSemaphoreGive(async->submit_sem);
+    if (async->thread.joinable()) {
+        async->thread.join();
+    }
+    ESP_UTILS_LOGD(
+        "Async stopped, executed %d batches, batched %d transactions", static_cast<int>(async->batch_num.load()),
+        static_cast<int>(async->queue.getBatchedNum())
+    );
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool HostI2C::submit(const utils::I2CQueue::Transaction &transaction)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_LOGD(
+        "Param: priority(%d), address(0x%02X), write_size(%d), read_size(%d)",
+        static_cast<int>(transaction.priority), transaction.address, transaction.write_size,
+        static_cast<int>(transaction.read_size)
+    );
+
+    // Push under the lock, so the transaction can't be missed by the task which is being stopped
+    std::lock_guard<std::mutex> lock(_async_mutex);
+    ESP_UTILS_CHECK_NULL_RETURN(_async, false, "Not started");
+    ESP_UTILS_CHECK_FALSE_RETURN(_async->queue.push(transaction), false, "Push transaction failed");
+    xSemaphoreGive(_async->submit_sem);
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool HostI2C::isAsync() const
+{
+    std::lock_guard<std::mutex> lock(_async_mutex);
+    return (_async != nullptr);
+}
+
+uint32_t HostI2C::getAsyncBatchNum() const
+{
+    std::lock_guard<std::mutex> lock(_async_mutex);
+    return (_async != nullptr) ? _async->batch_num.load() : 0;
+}
+
+std::shared_ptr<const utils::I2CQueue> HostI2C::getAsyncQueue() const
+{
+    std::lock_guard<std::mutex> lock(_async_mutex);
+    return (_async != nullptr) ? std::shared_ptr<const utils::I2CQueue>(_async, &_async->queue) : nullptr;
+}
+
 bool HostI2C::calibrateConfig(const i2c_config_t &config)
 {
     if (memcmp(&config, &this->config, sizeof(i2c_config_t))) {
@@ -72,4 +219,61 @@ bool HostI2C::calibrateConfig(const i2c_config_t &config)
     return true;
 }
 
+bool HostI2C::executeBatch(Async &async, const utils::I2CQueue::Transaction batch[], int num)
+{
+    i2c_cmd_handle_t cmd = i2c_cmd_link_create_static(async.link_buffer.data(), async.link_buffer.size());
+    ESP_UTILS_CHECK_NULL_RETURN(cmd, false, "Create command link failed");
+
+    // All transactions are sent with repeated starts, so the bus is acquired only once
+    bool is_built = true;
+    for (int i = 0; (i < num) && is_built; i++) {
+        is_built = append_transaction(cmd, batch[i]);
+    }
+    is_built = is_built && (i2c_master_stop(cmd) == ESP_OK);
+    esp_err_t ret = ESP_FAIL;
+    if (is_built) {
+        ret = i2c_master_cmd_begin(static_cast<i2c_port_t>(getID()), cmd, pdMS_TO_TICKS(async.config.timeout_ms));
+    }
+    i2c_cmd_link_delete_static(cmd);
+
+    ESP_UTILS_CHECK_FALSE_RETURN(is_built, false, "Build command link failed");
+    ESP_UTILS_CHECK_ERROR_RETURN(ret, false, "Execute %d transactions failed", num);
+
+    return true;
+}
+
+void HostI2C::runAsync(Async &async)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    utils::I2CQueue::Transaction batch[utils::I2CQueue::BATCH_NUM_MAX];
+    while (!async.is_stop) {
+        int num = async.queue.pop(batch, utils::I2CQueue::BATCH_NUM_MAX);
+        if (num == 0) {
+            xSemaphoreTake(async.submit_sem, pdMS_TO_TICKS(THREAD_CHECK_STOP_INTERVAL_MS));
+            continue;
+        }
+
+        // A failed batch fails all its transactions, since it's not known which one is not acknowledged
+        bool is_success = executeBatch(async, batch, num);
+        async.batch_num++;
+        for (int i = 0; i < num; i++) {
+            if (batch[i].callback != nullptr) {
+                batch[i].callback(batch[i], is_success, batch[i].user_data);
+            }
+        }
+    }
+
+    // Drop the rest transactions without executing them, and notify their users with failure
+    for (int num = 0; (num = async.queue.pop(batch, utils::I2CQueue::BATCH_NUM_MAX)) > 0;) {
+        for (int i = 0; i < num; i++) {
+            if (batch[i].callback != nullptr) {
+                batch[i].callback(batch[i], false, batch[i].user_data);
+            }
+        }
+    }
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+}
+
 } // namespace esp_panel::drivers
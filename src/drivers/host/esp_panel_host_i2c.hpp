@@ -6,7 +6,15 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
 #include "driver/i2c.h"
+#include "utils/esp_panel_utils_i2c_queue.hpp"
 #include "esp_panel_host.hpp"
 
 namespace esp_panel::drivers {
@@ -22,6 +30,18 @@ public:
     template <class Instance, typename Config, int N>
     friend class Host;                                  // To access `del()`, `calibrateConfig()`
 
+    /**
+     * @brief Configuration of the asynchronous transactions
+     */
+    struct AsyncConfig {
+        utils::I2CQueue::Config queue_config = {};  /*!< Configuration of the transaction queue */
+        const char *task_name = "i2c_async";        /*!< Name of the task */
+        int task_priority = 5;                      /*!< Priority of the task */
+        int task_stack_size = 4 * 1024;             /*!< Stack size of the task in bytes */
+        int task_core_id = -1;                      /*!< Core to pin the task, -1 means no affinity */
+        int timeout_ms = 100;                       /*!< Timeout of each batch of transactions */
+    };
+
     /**
      * @brief Destroy the host
      */
@@ -34,7 +54,86 @@ public:
      */
     bool begin() override;
 
+    /**
+     * @brief Start a task to execute the submitted transactions by priority
+     *
+     * The task shares the port with the blocking users (e.g. the touch and the bus), which are served by the driver
+     * between the batches. So a blocking user waits at most one batch of the task.
+     *
+     * @param[in] config Configuration of the asynchronous transactions
+     * @return `true` if successful, `false` otherwise
+     *
+     * @note This function should be called after `begin()`
+     */
+    bool startAsync(const AsyncConfig &config);
+
+    /**
+     * @brief Start a task to execute the submitted transactions with the default configuration
+     *
+     * @return `true` if successful, `false` otherwise
+     */
+    bool startAsync()
+    {
+        return startAsync(AsyncConfig{});
+    }
+
+    /**
+     * @brief Stop the task
+     *
+     * The batch being executed is finished as usual. The pending transactions are dropped without being executed,
+     * and their callbacks are called with `is_success = false`, so the writes which must reach the device should be
+     * waited for before stopping.
+     *
+     * @return `true` if successful, `false` otherwise
+     *
+     * @note The transactions submitted during stopping are either dropped like above or rejected by `submit()`
+     */
+    bool stopAsync();
+
+    /**
+     * @brief Submit a transaction to the task without waiting
+     *
+     * @param[in] transaction Transaction to submit. Its callback is called from the task when finished
+     * @return `true` if successful, `false` if the task is not started, the transaction is invalid or the queue is full
+     * @note This function can be called from different tasks, even when the task is being stopped by `stopAsync()`
+     */
+    bool submit(const utils::I2CQueue::Transaction &transaction);
+
+    /**
+     * @brief Check if the task of the asynchronous transactions is running
+     *
+     * @return `true` if running, `false` otherwise
+     */
+    bool isAsync() const;
+
+    /**
+     * @brief Get the number of the batches executed by the task
+     *
+     * @return Number of the batches
+     */
+    uint32_t getAsyncBatchNum() const;
+
+    /**
+     * @brief Get the queue of the asynchronous transactions, which is used to get the counters
+     *
+     * @return Pointer to the queue, `nullptr` if the task is not started. It keeps the queue valid after the task is
+     *         stopped
+     */
+    std::shared_ptr<const utils::I2CQueue> getAsyncQueue() const;
+
 private:
+    struct Async {
+        AsyncConfig config = {};                                /*!< Task configuration */
+        utils::I2CQueue queue;                                  /*!< Queue of the submitted transactions */
+        std::thread thread;                                     /*!< Task thread */
+        std::atomic<bool> is_stop = false;                      /*!< Flag to stop the task */
+        std::atomic<uint32_t> batch_num = 0;                    /*!< Number of the executed batches */
+        SemaphoreHandle_t submit_sem = nullptr;                 /*!< Semaphore to wake up the task */
+        StaticSemaphore_t submit_sem_buffer = {};               /*!< Static buffer for semaphore */
+        /*!< Buffer of the command link, which is enough for a full batch of writes or a write-read */
+        std::array<uint8_t, I2C_LINK_RECOMMENDED_SIZE(utils::I2CQueue::BATCH_NUM_MAX)> link_buffer = {};
+    };
+
     /**
      * @brief Private constructor to prevent direct instantiation
      *
@@ -51,6 +150,12 @@ private:
      * @return `true` if successful, `false` otherwise
      */
     bool calibrateConfig(const i2c_config_t &config) override;
+
+    bool executeBatch(Async &async, const utils::I2CQueue::Transaction batch[], int num);
+    void runAsync(Async &async);
+
+    mutable std::mutex _async_mutex;            /*!< Mutex to protect `_async` */
+    std::shared_ptr<Async> _async = nullptr;    /*!< Asynchronous transactions */
 };
 
 } // namespace esp_panel::drivers
@@ -5,6 +5,7 @@
  */
 
 #include <algorithm>
+#include <cstring>
 #include <memory>
 #include <numeric>
 #include "sdkconfig.h"
@@ -12,8 +13,15 @@
 #include "esp_lcd_panel_ops.h"
 #include "esp_lcd_panel_io.h"
 #include "esp_memory_utils.h"
+#include "esp_rom_sys.h"
+#include "esp_timer.h"
+#include "esp_lcd_panel_commands.h"
+#include "freertos/task.h"
+#include "driver/gpio.h"
 #include "driver/spi_master.h"
 #include "utils/esp_panel_utils_log.h"
+#include "utils/esp_panel_utils_profiler.h"
+#include "port/esp_panel_lcd_vendor_init.h"
 #include "esp_panel_lcd.hpp"
 
 namespace esp_panel::drivers {
@@ -265,6 +273,10 @@ bool LCD::configVendorCommands(const esp_panel_lcd_vendor_init_cmd_t init_cmd[],
 
     ESP_UTILS_LOGD("Param: init_cmd(@%p), init_cmd_size(%d)", init_cmd, static_cast<int>(init_cmd_size));
     ESP_UTILS_CHECK_FALSE_RETURN((init_cmd == nullptr) || (init_cmd_size > 0), false, "Invalid arguments");
+    // Check the table now, otherwise the panel may be left half initialized by a bad command
+    ESP_UTILS_CHECK_ERROR_RETURN(
+        esp_panel_lcd_vendor_init_cmds_check(init_cmd, init_cmd_size), false, "Invalid initialization commands"
+    );
 
     auto &vendor_config = getVendorFullConfig();
     vendor_config.init_cmds = init_cmd;
@@ -401,6 +413,7 @@ bool LCD::begin()
 
     // Initialize the LCD if not initialized
     if (!isOverState(State::INIT)) {
+        ESP_PANEL_PROFILER_SCOPE("lcd_init");
         ESP_UTILS_CHECK_FALSE_RETURN(init(), false, "Init failed");
     }
 
@@ -408,7 +421,10 @@ bool LCD::begin()
     ESP_UTILS_CHECK_FALSE_RETURN(reset(), false, "Reset failed");
 
     /* Initialize refresh panel */
-    ESP_UTILS_CHECK_ERROR_RETURN(esp_lcd_panel_init(refresh_panel), false, "Init panel failed");
+    {
+        ESP_PANEL_PROFILER_SCOPE("lcd_panel_init");
+        ESP_UTILS_CHECK_ERROR_RETURN(esp_lcd_panel_init(refresh_panel), false, "Init panel failed");
+    }
     ESP_UTILS_LOGD("Refresh panel(@%p) initialized", refresh_panel);
 
     auto bus_type = getBus()->getBasicAttributes().type;
@@ -426,6 +442,9 @@ bool LCD::begin()
         _interruption.draw_bitmap_finish_sem =
             xSemaphoreCreateBinaryStatic(_interruption.on_draw_bitmap_finish_sem_buffer.get());
     }
+    if ((bus_type != ESP_PANEL_BUS_TYPE_RGB) && (_draw_bitmap_queue.depth == 0)) {
+        ESP_UTILS_CHECK_FALSE_RETURN(createDrawBitmapQueue(), false, "Create draw bitmap queue failed");
+    }
 
     /*  Register callback for different bus */
     _interruption.data.lcd_ptr = this;
@@ -447,6 +466,13 @@ bool LCD::begin()
             rgb_event_cb.on_bounce_frame_finish = (esp_lcd_rgb_panel_bounce_buf_finish_cb_t)onRefreshFinish;
         }
 #endif
+        // In the stream mode, there is no frame buffer, the bounce buffers are filled by the line provider
+        if (rgb_config->flags.no_fb) {
+            int bits_per_pixel = (rgb_config->bits_per_pixel > 0) ? rgb_config->bits_per_pixel : rgb_config->data_width;
+            _line_provider.line_pixels = rgb_config->timings.h_res;
+            _line_provider.line_bytes = rgb_config->timings.h_res * bits_per_pixel / 8;
+            rgb_event_cb.on_bounce_empty = (esp_lcd_rgb_panel_bounce_buf_fill_cb_t)onBounceEmpty;
+        }
         ESP_UTILS_CHECK_ERROR_RETURN(
             esp_lcd_rgb_panel_register_event_callbacks(refresh_panel, &rgb_event_cb, &_interruption.data), false,
             "Register RGB event callback failed"
@@ -467,18 +493,28 @@ bool LCD::begin()
         break;
     }
 #endif
+    case ESP_PANEL_BUS_TYPE_VIRTUAL:
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            static_cast<BusVirtual *>(getBus())->registerRefreshFinishCallback(onRefreshFinish, &_interruption.data),
+            false, "Register virtual refresh callback failed"
+        );
+        [[fallthrough]];
     default:
-        esp_lcd_panel_io_callbacks_t io_cb = {
-            .on_color_trans_done = (esp_lcd_panel_io_color_trans_done_cb_t)onDrawBitmapFinish,
-        };
-        ESP_UTILS_CHECK_ERROR_RETURN(
-            esp_lcd_panel_io_register_event_callbacks(getBus()->getControlPanelHandle(), &io_cb, &_interruption.data),
-            false, "Register control panel event callback failed"
+        // The bus owns the event of the control panel and passes the completions to here, it stops queuing its own
+        // transfers from now on, since they can't be told apart
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            getBus()->registerColorTransferDoneCallback(
+                (esp_lcd_panel_io_color_trans_done_cb_t)onDrawBitmapFinish, &_interruption.data
+            ), false, "Register color transfer done callback failed"
         );
         break;
     }
 
 end:
+    // The TE output is turned on again after the panel is initialized
+    if (_tearing_effect != nullptr) {
+        ESP_UTILS_CHECK_FALSE_RETURN(beginTearingEffect(), false, "Begin tearing effect failed");
+    }
     setState(State::BEGIN);
 
     ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
@@ -499,7 +535,10 @@ bool LCD::reset()
         goto end;
     }
 
-    ESP_UTILS_CHECK_ERROR_RETURN(esp_lcd_panel_reset(refresh_panel), false, "Reset panel failed");
+    {
+        ESP_PANEL_PROFILER_SCOPE("lcd_reset");
+        ESP_UTILS_CHECK_ERROR_RETURN(esp_lcd_panel_reset(refresh_panel), false, "Reset panel failed");
+    }
     ESP_UTILS_LOGD("Refresh panel(@%p) reset", refresh_panel);
 
 end:
@@ -517,6 +556,16 @@ bool LCD::del()
 {
     ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
 
+    // Give the color transfer of the control panel back to the bus, see `begin()`
+    auto bus_type = getBus()->getBasicAttributes().type;
+    if (isOverState(State::BEGIN) && (bus_type != ESP_PANEL_BUS_TYPE_RGB) &&
+            (bus_type != ESP_PANEL_BUS_TYPE_MIPI_DSI) && (getBus()->getControlPanelHandle() != nullptr)) {
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            getBus()->registerColorTransferDoneCallback(nullptr, nullptr), false,
+            "Unregister color transfer done callback failed"
+        );
+    }
+
     if (refresh_panel != nullptr) {
         ESP_UTILS_CHECK_ERROR_RETURN(
             esp_lcd_panel_del(refresh_panel), false, "Delete refresh panel(@%p) failed", refresh_panel
@@ -525,8 +574,21 @@ bool LCD::del()
         refresh_panel = nullptr;
     }
 
+    if (_tearing_effect != nullptr) {
+        ESP_UTILS_CHECK_FALSE_RETURN(endTearingEffect(), false, "End tearing effect failed");
+        _tearing_effect = nullptr;
+    }
+    if (_swap_chain != nullptr) {
+        ESP_UTILS_CHECK_FALSE_RETURN(disableSwapChain(), false, "Disable swap chain failed");
+    }
+    deleteDrawBitmapQueue();
     _transformation = {};
     _interruption = {};
+    _draw_bitmap_count = 0;
+    _pixel_clock_hz = 0;
+    _latency_tracker = nullptr;
+    _frame_pacer = nullptr;
+    _line_provider = {};
 
     setState(State::DEINIT);
 
@@ -545,57 +607,48 @@ bool LCD::drawBitmap(int x_start, int y_start, int width, int height, const uint
         "Param: x_start(%d), y_start(%d), width(%d), height(%d), color_data(@%p), timeout_ms(%d)",
         x_start, y_start, width, height, color_data, timeout_ms
     );
-
-    // Check basic parameters validity
-    ESP_UTILS_CHECK_FALSE_RETURN(
-        (x_start >= 0) && (y_start >= 0), false, "Invalid start coordinates: (%d,%d)", x_start, y_start
-    );
-    ESP_UTILS_CHECK_FALSE_RETURN((width >= 0) && (height >= 0), false, "Invalid dimensions: (%d,%d)", width, height);
     ESP_UTILS_CHECK_FALSE_RETURN(
-        ((width == 0) && (height == 0)) || (color_data != nullptr), false, "Invalid color_data"
+        checkDrawBitmapArea(x_start, y_start, width, height, color_data), false, "Invalid area"
     );
 
-    // Get display parameters
-    auto swap_xy = getTransformation().swap_xy;
-    auto frame_width = getFrameWidth();
-    auto frame_height = getFrameHeight();
-    auto x_align = getBasicAttributes().basic_bus_spec.x_coord_align;
-    auto y_align = getBasicAttributes().basic_bus_spec.y_coord_align;
-    auto x_end = x_start + width;
-    auto y_end = y_start + height;
-
-    // Check boundary limits
-    auto max_x = swap_xy ? frame_height : frame_width;
-    auto max_y = swap_xy ? frame_width : frame_height;
-    if (frame_width > 0) {
-        ESP_UTILS_CHECK_FALSE_RETURN(x_end <= max_x, false, "x_end(%d) exceeds display limit(%d)", x_end, max_x);
+    if ((_tearing_effect != nullptr) && (width > 0) && (height > 0)) {
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            waitTearingEffect(x_start, y_start, width, height), false, "Wait tearing effect failed"
+        );
     }
-    if (frame_height > 0) {
-        ESP_UTILS_CHECK_FALSE_RETURN(y_end <= max_y, false, "y_end(%d) exceeds display limit(%d)", y_end, max_y);
+
+    // Track the drawing in the in-flight queue, so its finish event won't be mixed up with `drawBitmapAsync()`
+    DrawBitmapToken token = 0;
+    bool is_queued = (_draw_bitmap_queue.depth > 0) && (width > 0) && (height > 0);
+    if (is_queued) {
+        if (timeout_ms != 0) {
+            // Clear the stale notification left by the previous timeout
+            xSemaphoreTake(_interruption.draw_bitmap_finish_sem, 0);
+        }
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            pushDrawBitmapQueue({.color_data = color_data, .need_notify = (timeout_ms != 0)}, -1, token), false,
+            "Push draw bitmap queue failed"
+        );
     }
 
-    // Check coordinate alignment
-    if (x_start & (x_align - 1)) {
-        ESP_UTILS_LOGW("x_start(%d) not aligned to %d", x_start, x_align);
-    } else if (width & (x_align - 1)) {
-        ESP_UTILS_LOGW("width(%d) not aligned to %d", width, x_align);
+    // Send data to the panel, the frame is submitted first since the transfer might be done before it returns
+    uint32_t frame_id = submitLatencyFrame();
+    auto ret = drawBitmapToPanel(x_start, y_start, width, height, color_data);
+    if ((ret != ESP_OK) && is_queued) {
+        cancelDrawBitmapQueue(token);
     }
-    if (y_start & (y_align - 1)) {
-        ESP_UTILS_LOGW("y_start(%d) not aligned to %d", y_start, y_align);
-    } else if (height & (y_align - 1)) {
-        ESP_UTILS_LOGW("height(%d) not aligned to %d", height, y_align);
+    if ((ret != ESP_OK) && (_latency_tracker != nullptr)) {
+        _latency_tracker->notifyCancel(frame_id);
     }
-
-    // Send data to the panel
-    ESP_UTILS_CHECK_ERROR_RETURN(
-        esp_lcd_panel_draw_bitmap(refresh_panel, x_start, y_start, x_end, y_end, color_data), false,
-        "Draw bitmap failed"
-    );
+    ESP_UTILS_CHECK_ERROR_RETURN(ret, false, "Draw bitmap failed");
+    _draw_bitmap_count++;
 
     // For RGB bus, since `drawBitmap()` uses `memcpy()` instead of DMA operation, doesn't need to wait for finish
-    if ((getBus()->getBasicAttributes().type == ESP_PANEL_BUS_TYPE_RGB) &&
-            (_interruption.on_draw_bitmap_finish != nullptr)) {
-        _interruption.on_draw_bitmap_finish(_interruption.data.user_data);
+    if (getBus()->getBasicAttributes().type == ESP_PANEL_BUS_TYPE_RGB) {
+        notifyLatencyTransferDone();
+        if (_interruption.on_draw_bitmap_finish != nullptr) {
+            _interruption.on_draw_bitmap_finish(_interruption.data.user_data);
+        }
     }
     /* Otherwise, wait for the semaphore to be given by the callback function */
     if ((_interruption.draw_bitmap_finish_sem != nullptr) && (timeout_ms != 0)) {
@@ -611,6 +664,347 @@ bool LCD::drawBitmap(int x_start, int y_start, int width, int height, const uint
     return true;
 }
 
+bool LCD::drawBitmapAsync(
+    int x_start, int y_start, int width, int height, const uint8_t *color_data, DrawBitmapToken *token, int timeout_ms
+)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(isOverState(State::BEGIN), false, "Not begun");
+
+    ESP_UTILS_LOGD(
+        "Param: x_start(%d), y_start(%d), width(%d), height(%d), color_data(@%p), token(@%p), timeout_ms(%d)",
+        x_start, y_start, width, height, color_data, token, timeout_ms
+    );
+    ESP_UTILS_CHECK_FALSE_RETURN((width > 0) && (height > 0), false, "Invalid dimensions: (%d,%d)", width, height);
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        checkDrawBitmapArea(x_start, y_start, width, height, color_data), false, "Invalid area"
+    );
+
+    if (_tearing_effect != nullptr) {
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            waitTearingEffect(x_start, y_start, width, height), false, "Wait tearing effect failed"
+        );
+    }
+
+    DrawBitmapToken draw_token = 0;
+    bool is_queued = (_draw_bitmap_queue.depth > 0);
+    if (is_queued) {
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            pushDrawBitmapQueue({.color_data = color_data, .is_async = true}, timeout_ms, draw_token), false,
+            "Push draw bitmap queue failed"
+        );
+    }
+
+    // Send data to the panel
+    uint32_t frame_id = submitLatencyFrame();
+    auto ret = drawBitmapToPanel(x_start, y_start, width, height, color_data);
+    if ((ret != ESP_OK) && is_queued) {
+        cancelDrawBitmapQueue(draw_token);
+    }
+    if ((ret != ESP_OK) && (_latency_tracker != nullptr)) {
+        _latency_tracker->notifyCancel(frame_id);
+    }
+    ESP_UTILS_CHECK_ERROR_RETURN(ret, false, "Draw bitmap failed");
+    _draw_bitmap_count++;
+
+    // For bus which not use DMA operation (like RGB), the bitmap has been copied when `esp_lcd_panel_draw_bitmap()`
+    // returns, so finish the drawing here
+    if (!is_queued) {
+        portENTER_CRITICAL(&_draw_bitmap_queue.lock);
+        draw_token = ++_draw_bitmap_queue.submitted;
+        _draw_bitmap_queue.finished = draw_token;
+        portEXIT_CRITICAL(&_draw_bitmap_queue.lock);
+
+        notifyLatencyTransferDone();
+        if (_interruption.on_draw_bitmap_finish != nullptr) {
+            _interruption.on_draw_bitmap_finish(_interruption.data.user_data);
+        }
+        if (_draw_bitmap_queue.on_recycle != nullptr) {
+            _draw_bitmap_queue.on_recycle(color_data, _draw_bitmap_queue.recycle_user_data);
+        }
+    }
+
+    if (token != nullptr) {
+        *token = draw_token;
+    }
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool LCD::isDrawBitmapFinished(DrawBitmapToken token)
+{
+    // Tokens are increased monotonically, compare them with the wrap-around considered
+    return static_cast<int32_t>(_draw_bitmap_queue.finished - token) >= 0;
+}
+
+bool LCD::waitDrawBitmapFinish(DrawBitmapToken token, int timeout_ms)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(isOverState(State::BEGIN), false, "Not begun");
+
+    ESP_UTILS_LOGD("Param: token(%d), timeout_ms(%d)", static_cast<int>(token), timeout_ms);
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        static_cast<int32_t>(_draw_bitmap_queue.submitted - token) >= 0, false, "Invalid token(%d)",
+        static_cast<int>(token)
+    );
+
+    {
+        auto &queue = _draw_bitmap_queue;
+        // Each waiter has its own semaphore (like `Bus::waitColorDataFinish()`), so the waiters in different tasks
+        // (e.g. the user and `waitTearingEffect()`) can't steal the wakeups of each other
+        StaticSemaphore_t sem_buffer;
+        DrawBitmapQueue::Waiter waiter = {
+            .token = token,
+            .sem = xSemaphoreCreateBinaryStatic(&sem_buffer),
+        };
+        bool is_waiting = false;
+        portENTER_CRITICAL(&queue.lock);
+        if (!isDrawBitmapFinished(token)) {
+            waiter.next = queue.waiters;
+            queue.waiters = &waiter;
+            is_waiting = true;
+        }
+        portEXIT_CRITICAL(&queue.lock);
+
+        TickType_t timeout_tick = (timeout_ms < 0) ? portMAX_DELAY : pdMS_TO_TICKS(timeout_ms);
+        bool is_finished = !is_waiting || (xSemaphoreTake(waiter.sem, timeout_tick) == pdTRUE);
+        if (!is_finished) {
+            bool is_removed = false;
+            portENTER_CRITICAL(&queue.lock);
+            for (auto node = &queue.waiters; *node != nullptr; node = &(*node)->next) {
+                if (*node == &waiter) {
+                    *node = waiter.next;
+                    is_removed = true;
+                    break;
+                }
+            }
+            portEXIT_CRITICAL(&queue.lock);
+            // Already removed by the interrupt, so the semaphore is going to be given
+            if (!is_removed) {
+                xSemaphoreTake(waiter.sem, portMAX_DELAY);
+                is_finished = true;
+            }
+        }
+        vSemaphoreDelete(waiter.sem);
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            is_finished, false, "Wait draw bitmap(%d) finish timeout", static_cast<int>(token)
+        );
+    }
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool LCD::waitDrawBitmapAllFinish(int timeout_ms)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        waitDrawBitmapFinish(_draw_bitmap_queue.submitted, timeout_ms), false, "Wait draw bitmap finish failed"
+    );
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool LCD::configDirtyAreaTransferOverhead(uint32_t pixels)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        _dirty_area_merger.getAreaNum() == 0, false, "Should be called when there are no pending dirty areas"
+    );
+
+    ESP_UTILS_LOGD("Param: pixels(%d)", static_cast<int>(pixels));
+    _dirty_area_overhead_px = pixels;
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool LCD::addDirtyArea(int x_start, int y_start, int width, int height)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(isOverState(State::BEGIN), false, "Not begun");
+
+    ESP_UTILS_LOGD("Param: x_start(%d), y_start(%d), width(%d), height(%d)", x_start, y_start, width, height);
+
+    // The frame size may be changed by `swapXY()`, so configure the merger when there are no pending areas
+    if (_dirty_area_merger.getAreaNum() == 0) {
+        auto swap_xy = getTransformation().swap_xy;
+        utils::DirtyAreaMerger::Config config = {
+            .width = swap_xy ? getFrameHeight() : getFrameWidth(),
+            .height = swap_xy ? getFrameWidth() : getFrameHeight(),
+            .x_align = getBasicAttributes().basic_bus_spec.x_coord_align,
+            .y_align = getBasicAttributes().basic_bus_spec.y_coord_align,
+            .transfer_overhead_px = _dirty_area_overhead_px,
+        };
+        ESP_UTILS_CHECK_FALSE_RETURN(_dirty_area_merger.setConfig(config), false, "Config dirty area merger failed");
+    }
+
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        _dirty_area_merger.add(x_start, y_start, width, height), false, "Invalid area: (%d,%d,%d,%d)", x_start,
+        y_start, width, height
+    );
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool LCD::flushDirtyAreas(const uint8_t *frame_buffer, uint8_t *trans_buffer, size_t trans_buffer_size, int timeout_ms)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(isOverState(State::BEGIN), false, "Not begun");
+
+    ESP_UTILS_LOGD(
+        "Param: frame_buffer(@%p), trans_buffer(@%p), trans_buffer_size(%d), timeout_ms(%d)", frame_buffer,
+        trans_buffer, static_cast<int>(trans_buffer_size), timeout_ms
+    );
+    ESP_UTILS_CHECK_NULL_RETURN(frame_buffer, false, "Invalid frame buffer");
+
+    // Without the transfer buffer, only the contiguous rows can be sent, so expand the areas to the full width
+    utils::DirtyAreaMerger full_width_merger;
+    const utils::DirtyAreaMerger *merger = &_dirty_area_merger;
+    if ((trans_buffer == nullptr) && (_dirty_area_merger.getAreaNum() > 0)) {
+        auto config = _dirty_area_merger.getConfig();
+        config.x_align = config.width;
+        full_width_merger.setConfig(config);
+        for (auto &area : _dirty_area_merger) {
+            full_width_merger.add(area.x1, area.y1, area.getWidth(), area.getHeight());
+        }
+        merger = &full_width_merger;
+    }
+
+    int frame_width = merger->getConfig().width;
+    size_t bytes_per_pixel = (getFrameColorBits() + 7) / 8;
+    size_t frame_stride = frame_width * bytes_per_pixel;
+    size_t half_size = trans_buffer_size / 2;
+    DrawBitmapToken half_tokens[2] = {_draw_bitmap_queue.submitted, _draw_bitmap_queue.submitted};
+    int half_index = 0;
+    for (auto &area : *merger) {
+        const uint8_t *area_data = frame_buffer + area.y1 * frame_stride + area.x1 * bytes_per_pixel;
+
+        // The rows of a full-width area are contiguous in the frame buffer, send them directly
+        if (area.getWidth() == frame_width) {
+            ESP_UTILS_CHECK_FALSE_RETURN(
+                drawBitmapAsync(area.x1, area.y1, area.getWidth(), area.getHeight(), area_data, nullptr, timeout_ms),
+                false, "Draw area(%d,%d,%d,%d) failed", area.x1, area.y1, area.x2, area.y2
+            );
+            continue;
+        }
+
+        size_t line_size = area.getWidth() * bytes_per_pixel;
+        int max_lines = half_size / line_size;
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            max_lines > 0, false, "Transfer buffer is too small for the area width(%d)", area.getWidth()
+        );
+        for (int y = area.y1; y < area.y2; y += max_lines) {
+            int lines = std::min(max_lines, area.y2 - y);
+            uint8_t *half_buffer = trans_buffer + half_index * half_size;
+
+            // Wait until the previous transfer of this half is finished before overwriting it
+            ESP_UTILS_CHECK_FALSE_RETURN(
+                waitDrawBitmapFinish(half_tokens[half_index], timeout_ms), false, "Wait transfer buffer failed"
+            );
+            for (int i = 0; i < lines; i++) {
+                memcpy(half_buffer + i * line_size, area_data + (y - area.y1 + i) * frame_stride, line_size);
+            }
+            ESP_UTILS_CHECK_FALSE_RETURN(
+                drawBitmapAsync(area.x1, y, area.getWidth(), lines, half_buffer, &half_tokens[half_index], timeout_ms),
+                false, "Draw area(%d,%d,%d,%d) failed", area.x1, y, area.x2, y + lines
+            );
+            half_index ^= 1;
+        }
+    }
+    _dirty_area_merger.reset();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(waitDrawBitmapAllFinish(timeout_ms), false, "Wait all transfers finish failed");
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool LCD::drawBitmapConverted(
+    int x_start, int y_start, int width, int height, const uint8_t *color_data, utils::PixelFormat format,
+    uint8_t *trans_buffer, size_t trans_buffer_size, int timeout_ms
+)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(isOverState(State::BEGIN), false, "Not begun");
+
+    ESP_UTILS_LOGD(
+        "Param: x_start(%d), y_start(%d), width(%d), height(%d), color_data(@%p), format(%s), trans_buffer(@%p), "
+        "trans_buffer_size(%d), timeout_ms(%d)", x_start, y_start, width, height, color_data,
+        utils::PixelConverter::getFormatName(format), trans_buffer, static_cast<int>(trans_buffer_size), timeout_ms
+    );
+
+    auto frame_format = getFramePixelFormat();
+    ESP_UTILS_CHECK_FALSE_RETURN(frame_format != utils::PixelFormat::MAX, false, "Unsupported frame pixel format");
+    if (format == frame_format) {
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            drawBitmap(x_start, y_start, width, height, color_data, timeout_ms), false, "Draw bitmap failed"
+        );
+        ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+        return true;
+    }
+
+    utils::PixelConverter converter;
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        converter.setConfig({.src_format = format, .dst_format = frame_format}), false, "Invalid pixel format"
+    );
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        checkDrawBitmapArea(x_start, y_start, width, height, color_data), false, "Invalid draw area"
+    );
+    ESP_UTILS_CHECK_NULL_RETURN(trans_buffer, false, "Invalid transfer buffer");
+
+    size_t src_line_size = width * utils::PixelConverter::getBytesPerPixel(format);
+    size_t dst_line_size = width * utils::PixelConverter::getBytesPerPixel(frame_format);
+    // Keep the second half aligned to 4 bytes, so both halves can use the register kernels
+    size_t half_size = (trans_buffer_size / 2) & ~static_cast<size_t>(3);
+    int max_lines = (dst_line_size > 0) ? (half_size / dst_line_size) : 0;
+    ESP_UTILS_CHECK_FALSE_RETURN(max_lines > 0, false, "Transfer buffer is too small for the width(%d)", width);
+
+    DrawBitmapToken half_tokens[2] = {_draw_bitmap_queue.submitted, _draw_bitmap_queue.submitted};
+    int half_index = 0;
+    for (int y = 0; y < height; y += max_lines) {
+        int lines = std::min(max_lines, height - y);
+        uint8_t *half_buffer = trans_buffer + half_index * half_size;
+
+        // Wait until the previous transfer of this half is finished before overwriting it
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            waitDrawBitmapFinish(half_tokens[half_index], timeout_ms), false, "Wait transfer buffer failed"
+        );
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            converter.convert(color_data + y * src_line_size, half_buffer, width * lines), false, "Convert failed"
+        );
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            drawBitmapAsync(x_start, y_start + y, width, lines, half_buffer, &half_tokens[half_index], timeout_ms),
+            false, "Draw lines(%d,%d) failed", y_start + y, y_start + y + lines
+        );
+        half_index ^= 1;
+    }
+
+    for (auto &token : half_tokens) {
+        ESP_UTILS_CHECK_FALSE_RETURN(waitDrawBitmapFinish(token, timeout_ms), false, "Wait transfer finish failed");
+    }
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
 bool LCD::mirrorX(bool en)
 {
     ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
@@ -745,33 +1139,108 @@ bool LCD::setDisplayOnOff(bool enable_on)
     return true;
 }
 
-bool LCD::attachDrawBitmapFinishCallback(FunctionDrawBitmapFinishCallback callback, void *user_data)
+bool LCD::setPixelClockHz(int hz)
 {
     ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
 
-    ESP_UTILS_LOGD("Param: callback(@%p), user_data(@%p)", callback, user_data);
-    if ((_interruption.data.user_data != nullptr) && (_interruption.data.user_data != user_data)) {
-        ESP_UTILS_LOGW("The previous user_data(@%p) is existed, will overwrite it", _interruption.data.user_data);
+    ESP_UTILS_CHECK_FALSE_RETURN(isOverState(State::BEGIN), false, "Not begun");
+    ESP_UTILS_CHECK_FALSE_RETURN(hz >= 0, false, "Invalid pixel clock(%d)", hz);
+
+    ESP_UTILS_LOGD("Param: hz(%d)", hz);
+
+    switch (getBus()->getBasicAttributes().type) {
+#if ESP_PANEL_DRIVERS_BUS_ENABLE_RGB
+    case ESP_PANEL_BUS_TYPE_RGB: {
+        auto rgb_config = getBusRGB_RefreshPanelFullConfig();
+        ESP_UTILS_CHECK_NULL_RETURN(rgb_config, false, "Invalid RGB config");
+
+        int target_hz = (hz > 0) ? hz : static_cast<int>(rgb_config->timings.pclk_hz);
+        if (target_hz == getPixelClockHz()) {
+            break;
+        }
+        ESP_UTILS_CHECK_ERROR_RETURN(
+            esp_lcd_rgb_panel_set_pclk(refresh_panel, target_hz), false, "Set RGB pixel clock failed"
+        );
+        _pixel_clock_hz = hz;
+        ESP_UTILS_LOGD("Set RGB pixel clock to %d Hz", target_hz);
+        break;
+    }
+#endif // ESP_PANEL_DRIVERS_BUS_ENABLE_RGB
+    default:
+        ESP_UTILS_CHECK_FALSE_RETURN(false, false, "Only valid for RGB bus");
     }
-    _interruption.data.user_data = user_data;
-    _interruption.on_draw_bitmap_finish = callback;
 
     ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
 
     return true;
 }
 
-bool LCD::attachRefreshFinishCallback(FunctionRefreshFinishCallback callback, void *user_data)
+int LCD::getPixelClockHz()
 {
-    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
-
-    auto bus_type = getBus()->getBasicAttributes().type;
-    ESP_UTILS_CHECK_FALSE_RETURN(
-        (bus_type == ESP_PANEL_BUS_TYPE_RGB) || (bus_type == ESP_PANEL_BUS_TYPE_MIPI_DSI), false,
-        "Only valid for RGB and MIPI-DSI bus"
-    );
+    switch (getBus()->getBasicAttributes().type) {
+#if ESP_PANEL_DRIVERS_BUS_ENABLE_RGB
+    case ESP_PANEL_BUS_TYPE_RGB: {
+        auto rgb_config = getBusRGB_RefreshPanelFullConfig();
+        ESP_UTILS_CHECK_NULL_RETURN(rgb_config, -1, "Invalid RGB config");
 
-    ESP_UTILS_LOGD("Param: callback(@%p), user_data(@%p)", callback, user_data);
+        return (_pixel_clock_hz > 0) ? _pixel_clock_hz : static_cast<int>(rgb_config->timings.pclk_hz);
+    }
+#endif // ESP_PANEL_DRIVERS_BUS_ENABLE_RGB
+#if ESP_PANEL_DRIVERS_BUS_ENABLE_MIPI_DSI
+    case ESP_PANEL_BUS_TYPE_MIPI_DSI: {
+        auto dpi_config = getBusDSI_RefreshPanelFullConfig();
+        ESP_UTILS_CHECK_NULL_RETURN(dpi_config, -1, "Invalid MIPI DPI config");
+
+        return static_cast<int>(dpi_config->dpi_clock_freq_mhz * 1000 * 1000);
+    }
+#endif // ESP_PANEL_DRIVERS_BUS_ENABLE_MIPI_DSI
+    default:
+        return -1;
+    }
+}
+
+bool LCD::attachDrawBitmapFinishCallback(FunctionDrawBitmapFinishCallback callback, void *user_data)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_LOGD("Param: callback(@%p), user_data(@%p)", callback, user_data);
+    if ((_interruption.data.user_data != nullptr) && (_interruption.data.user_data != user_data)) {
+        ESP_UTILS_LOGW("The previous user_data(@%p) is existed, will overwrite it", _interruption.data.user_data);
+    }
+    _interruption.data.user_data = user_data;
+    _interruption.on_draw_bitmap_finish = callback;
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool LCD::attachDrawBitmapRecycleCallback(FunctionDrawBitmapRecycleCallback callback, void *user_data)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_LOGD("Param: callback(@%p), user_data(@%p)", callback, user_data);
+    portENTER_CRITICAL(&_draw_bitmap_queue.lock);
+    _draw_bitmap_queue.recycle_user_data = user_data;
+    _draw_bitmap_queue.on_recycle = callback;
+    portEXIT_CRITICAL(&_draw_bitmap_queue.lock);
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool LCD::attachRefreshFinishCallback(FunctionRefreshFinishCallback callback, void *user_data)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    auto bus_type = getBus()->getBasicAttributes().type;
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        (bus_type == ESP_PANEL_BUS_TYPE_RGB) || (bus_type == ESP_PANEL_BUS_TYPE_MIPI_DSI) ||
+        (bus_type == ESP_PANEL_BUS_TYPE_VIRTUAL), false, "Only valid for RGB, MIPI-DSI and virtual bus"
+    );
+
+    ESP_UTILS_LOGD("Param: callback(@%p), user_data(@%p)", callback, user_data);
 
     /* Check the callback function and user data placement */
     // For MIPI-DSI bus, when `CONFIG_LCD_DSI_ISR_IRAM_SAFE` is set, the callback function and user data should be
@@ -816,16 +1285,350 @@ bool LCD::switchFrameBufferTo(void *frame_buffer)
 
     ESP_UTILS_LOGD("Param: frame_buffer(@%p)", frame_buffer);
 
-    ESP_UTILS_CHECK_ERROR_RETURN(
-        esp_lcd_panel_draw_bitmap(refresh_panel, 0, 0, getFrameWidth(), getFrameHeight(), frame_buffer), false,
-        "Switch to frame buffer failed"
+    uint32_t frame_id = submitLatencyFrame();
+    auto ret = esp_lcd_panel_draw_bitmap(refresh_panel, 0, 0, getFrameWidth(), getFrameHeight(), frame_buffer);
+    if ((ret != ESP_OK) && (_latency_tracker != nullptr)) {
+        _latency_tracker->notifyCancel(frame_id);
+    }
+    ESP_UTILS_CHECK_ERROR_RETURN(ret, false, "Switch to frame buffer failed");
+    _draw_bitmap_count++;
+
+    // For RGB bus, the frame buffer is switched without transfer, while MIPI-DSI bus reports it by the event
+    if (getBus()->getBasicAttributes().type == ESP_PANEL_BUS_TYPE_RGB) {
+        notifyLatencyTransferDone();
+    }
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool LCD::enableSwapChain(utils::SwapChain::PresentMode mode)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(isOverState(State::BEGIN), false, "Not begun");
+
+    ESP_UTILS_LOGD("Param: mode(%d)", static_cast<int>(mode));
+
+    // The swap chain is updated by the refresh ISR, but its functions are not placed in IRAM
+#if (ESP_PANEL_DRIVERS_BUS_ENABLE_MIPI_DSI && defined(CONFIG_LCD_DSI_ISR_IRAM_SAFE)) || \
+    (ESP_PANEL_DRIVERS_BUS_ENABLE_RGB && defined(CONFIG_LCD_RGB_ISR_IRAM_SAFE))
+    ESP_UTILS_CHECK_FALSE_RETURN(false, false, "Not supported when the ISR is IRAM-safe");
+#endif
+
+    int buffer_num = 0;
+    auto bus_type = getBus()->getBasicAttributes().type;
+    switch (bus_type) {
+#if ESP_PANEL_DRIVERS_BUS_ENABLE_RGB
+    case ESP_PANEL_BUS_TYPE_RGB: {
+        auto rgb_config = getBusRGB_RefreshPanelFullConfig();
+        ESP_UTILS_CHECK_NULL_RETURN(rgb_config, false, "Invalid RGB config");
+        buffer_num = rgb_config->num_fbs;
+        break;
+    }
+#endif
+#if ESP_PANEL_DRIVERS_BUS_ENABLE_MIPI_DSI
+    case ESP_PANEL_BUS_TYPE_MIPI_DSI: {
+        auto dsi_config = getBusDSI_RefreshPanelFullConfig();
+        ESP_UTILS_CHECK_NULL_RETURN(dsi_config, false, "Invalid MIPI-DSI config");
+        buffer_num = dsi_config->num_fbs;
+        break;
+    }
+#endif
+    default:
+        ESP_UTILS_CHECK_FALSE_RETURN(false, false, "Only valid for RGB and MIPI-DSI bus");
+    }
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        (buffer_num >= 2) && (buffer_num <= FRAME_BUFFER_MAX_NUM), false,
+        "Invalid frame buffer number(%d), should be in range [2, %d]", buffer_num, FRAME_BUFFER_MAX_NUM
+    );
+
+    if (_swap_chain != nullptr) {
+        ESP_UTILS_CHECK_FALSE_RETURN(disableSwapChain(), false, "Disable swap chain failed");
+    }
+
+    auto swap_chain = utils::make_shared<SwapChainContext>();
+    ESP_UTILS_CHECK_NULL_RETURN(swap_chain, false, "Create swap chain failed");
+    for (int i = 0; i < buffer_num; i++) {
+        swap_chain->buffers[i] = getFrameBufferByIndex(i);
+        ESP_UTILS_CHECK_NULL_RETURN(swap_chain->buffers[i], false, "Get frame buffer(%d) failed", i);
+    }
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        swap_chain->chain.setConfig({.buffer_num = buffer_num, .mode = mode, .front_index = 0}), false,
+        "Config swap chain failed"
+    );
+    swap_chain->refresh_sem = xSemaphoreCreateBinary();
+    ESP_UTILS_CHECK_NULL_RETURN(swap_chain->refresh_sem, false, "Create swap chain refresh semaphore failed");
+
+    portENTER_CRITICAL(&_swap_chain_lock);
+    _swap_chain = swap_chain;
+    portEXIT_CRITICAL(&_swap_chain_lock);
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool LCD::disableSwapChain()
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    // Detach it from the refresh ISR first, then it can be deleted safely
+    std::shared_ptr<SwapChainContext> swap_chain = nullptr;
+    portENTER_CRITICAL(&_swap_chain_lock);
+    swap_chain.swap(_swap_chain);
+    portEXIT_CRITICAL(&_swap_chain_lock);
+
+    if ((swap_chain != nullptr) && (swap_chain->refresh_sem != nullptr)) {
+        vSemaphoreDelete(swap_chain->refresh_sem);
+        swap_chain->refresh_sem = nullptr;
+    }
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+void *LCD::acquireSwapChainBuffer(int timeout_ms)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_NULL_RETURN(_swap_chain, nullptr, "Swap chain not enabled");
+
+    ESP_UTILS_LOGD("Param: timeout_ms(%d)", timeout_ms);
+
+    TickType_t start_tick = xTaskGetTickCount();
+    int index = -1;
+    // A buffer is only released by the refresh finish event, so check it again after each event
+    while ((index = _swap_chain->chain.acquire()) < 0) {
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            waitSwapChainRefresh(start_tick, timeout_ms), nullptr, "Wait for free frame buffer timeout"
+        );
+    }
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return _swap_chain->buffers[index];
+}
+
+bool LCD::presentSwapChainBuffer(void *frame_buffer, int timeout_ms)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_NULL_RETURN(_swap_chain, false, "Swap chain not enabled");
+
+    ESP_UTILS_LOGD("Param: frame_buffer(@%p), timeout_ms(%d)", frame_buffer, timeout_ms);
+    int index = getSwapChainBufferIndex(frame_buffer);
+    ESP_UTILS_CHECK_FALSE_RETURN(index >= 0, false, "Invalid frame buffer");
+
+    // In the FIFO mode, the last presented buffer should be shown before switching to the next one
+    TickType_t start_tick = xTaskGetTickCount();
+    auto &chain = _swap_chain->chain;
+    while (!chain.canPresent()) {
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            waitSwapChainRefresh(start_tick, timeout_ms), false, "Wait for last presented frame buffer timeout"
+        );
+    }
+
+    // Switch the panel first, so the buffer is never released before the panel stops scanning it
+    ESP_UTILS_CHECK_FALSE_RETURN(switchFrameBufferTo(frame_buffer), false, "Switch frame buffer failed");
+    int replaced_index = -1;
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        chain.present(index, &replaced_index), false, "Frame buffer(%d) is not acquired", index
     );
+    if (replaced_index >= 0) {
+        ESP_UTILS_LOGD("Frame buffer(%d) is replaced before shown", replaced_index);
+    }
 
     ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
 
     return true;
 }
 
+bool LCD::releaseSwapChainBuffer(void *frame_buffer)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_NULL_RETURN(_swap_chain, false, "Swap chain not enabled");
+
+    ESP_UTILS_LOGD("Param: frame_buffer(@%p)", frame_buffer);
+    int index = getSwapChainBufferIndex(frame_buffer);
+    ESP_UTILS_CHECK_FALSE_RETURN(index >= 0, false, "Invalid frame buffer");
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        _swap_chain->chain.release(index), false, "Frame buffer(%d) is not acquired", index
+    );
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool LCD::waitSwapChainPresented(int timeout_ms)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_NULL_RETURN(_swap_chain, false, "Swap chain not enabled");
+
+    ESP_UTILS_LOGD("Param: timeout_ms(%d)", timeout_ms);
+
+    TickType_t start_tick = xTaskGetTickCount();
+    while (_swap_chain->chain.getPendingIndex() >= 0) {
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            waitSwapChainRefresh(start_tick, timeout_ms), false, "Wait for presented frame buffer timeout"
+        );
+    }
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool LCD::attachLatencyTracker(utils::LatencyTracker *tracker)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(isOverState(State::BEGIN), false, "Not begun");
+
+    ESP_UTILS_LOGD("Param: tracker(@%p)", tracker);
+
+    auto bus_type = getBus()->getBasicAttributes().type;
+    _has_refresh_event = (bus_type == ESP_PANEL_BUS_TYPE_RGB) || (bus_type == ESP_PANEL_BUS_TYPE_MIPI_DSI) ||
+                         (bus_type == ESP_PANEL_BUS_TYPE_VIRTUAL);
+    _last_frame_id = 0;
+    _latency_tracker = tracker;
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool LCD::attachFramePacer(utils::FramePacer *pacer)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(isOverState(State::BEGIN), false, "Not begun");
+
+    ESP_UTILS_LOGD("Param: pacer(@%p)", pacer);
+
+    auto bus_type = getBus()->getBasicAttributes().type;
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        (pacer == nullptr) || (bus_type == ESP_PANEL_BUS_TYPE_RGB) || (bus_type == ESP_PANEL_BUS_TYPE_MIPI_DSI) ||
+        (bus_type == ESP_PANEL_BUS_TYPE_VIRTUAL) || (_tearing_effect != nullptr), false,
+        "Only valid for RGB, MIPI-DSI and virtual bus, or with the TE signal"
+    );
+
+    _frame_pacer = pacer;
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool LCD::attachLineProvider(FunctionLineProviderCallback callback, void *user_data)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(isOverState(State::BEGIN), false, "Not begun");
+    ESP_UTILS_CHECK_FALSE_RETURN(_line_provider.line_bytes > 0, false, "Only valid for RGB bus in the stream mode");
+
+    ESP_UTILS_LOGD("Param: callback(@%p), user_data(@%p)", callback, user_data);
+
+    /* Check the callback function and user data placement, the same as `attachRefreshFinishCallback()` */
+#if ESP_PANEL_DRIVERS_BUS_ENABLE_RGB && defined(CONFIG_LCD_RGB_ISR_IRAM_SAFE) && \
+    !(defined(CONFIG_SPIRAM_RODATA) && defined(CONFIG_SPIRAM_FETCH_INSTRUCTIONS))
+    if (callback != nullptr) {
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            esp_ptr_in_iram(reinterpret_cast<const void *>(callback)), false,
+            "Callback function should be placed in IRAM, add `IRAM_ATTR` before the function"
+        );
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            esp_ptr_internal(user_data), false, "User data should be placed in SRAM, add `DRAM_ATTR` before the data"
+        );
+    }
+#endif
+
+    portENTER_CRITICAL(&_line_provider.lock);
+    _line_provider.callback = callback;
+    _line_provider.user_data = user_data;
+    _line_provider.store = nullptr;
+    portEXIT_CRITICAL(&_line_provider.lock);
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool LCD::attachLineStore(utils::CompressedLineStore *store)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(isOverState(State::BEGIN), false, "Not begun");
+    ESP_UTILS_CHECK_FALSE_RETURN(_line_provider.line_bytes > 0, false, "Only valid for RGB bus in the stream mode");
+
+    ESP_UTILS_LOGD("Param: store(@%p)", store);
+
+    // The store is read by the ISR, but its functions are not placed in IRAM
+#if ESP_PANEL_DRIVERS_BUS_ENABLE_RGB && defined(CONFIG_LCD_RGB_ISR_IRAM_SAFE)
+    ESP_UTILS_CHECK_FALSE_RETURN(store == nullptr, false, "Not supported when the ISR is IRAM-safe");
+#endif
+    if (store != nullptr) {
+        auto &store_config = store->getConfig();
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            (store_config.width == _line_provider.line_pixels) && (store_config.height == getFrameHeight()) &&
+            (store_config.width * store_config.bytes_per_pixel == _line_provider.line_bytes), false,
+            "Store config(%dx%d, %d bytes per pixel) doesn't match the frame", store_config.width,
+            store_config.height, store_config.bytes_per_pixel
+        );
+    }
+
+    portENTER_CRITICAL(&_line_provider.lock);
+    _line_provider.callback = (store != nullptr) ? utils::CompressedLineStore::provideLines : nullptr;
+    _line_provider.user_data = store;
+    _line_provider.store = store;
+    portEXIT_CRITICAL(&_line_provider.lock);
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool LCD::configTearingEffect(const TearingEffectConfig &config)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(!isOverState(State::BEGIN), false, "Should be called before `begin()`");
+
+    auto bus_type = getBus()->getBasicAttributes().type;
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        (bus_type == ESP_PANEL_BUS_TYPE_SPI) || (bus_type == ESP_PANEL_BUS_TYPE_QSPI) ||
+        (bus_type == ESP_PANEL_BUS_TYPE_I80), false, "Only valid for SPI, QSPI and I80 bus"
+    );
+
+    ESP_UTILS_LOGD(
+        "Param: config(gpio_num: %d, mode: %d, scanline: %d, blank_lines: %d, margin_lines: %d, period_us: %d, "
+        "flags_active_low: %d)", config.gpio_num, config.mode, config.scanline, config.blank_lines,
+        config.margin_lines, static_cast<int>(config.period_us), config.flags_active_low
+    );
+
+    if (config.gpio_num < 0) {
+        _tearing_effect = nullptr;
+        goto end;
+    }
+    ESP_UTILS_CHECK_FALSE_RETURN(GPIO_IS_VALID_GPIO(config.gpio_num), false, "Invalid TE GPIO(%d)", config.gpio_num);
+
+    if (_tearing_effect == nullptr) {
+        _tearing_effect = utils::make_shared<TearingEffect>();
+        ESP_UTILS_CHECK_NULL_RETURN(_tearing_effect, false, "Create tearing effect failed");
+    }
+    _tearing_effect->config = config;
+
+end:
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
 bool LCD::colorBarTest(uint16_t width, uint16_t height)
 {
     ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
@@ -961,15 +1764,49 @@ int LCD::getFrameColorBits()
         }
         break;
     }
-#endif /* ESP_PANEL_DRIVERS_BUS_ENABLE_MIPI_DSI */
-    default:
-        bits_per_pixel = getConfig().getDeviceFullConfig()->bits_per_pixel;
+#endif /* ESP_PANEL_DRIVERS_BUS_ENABLE_MIPI_DSI */
+    default:
+        bits_per_pixel = getConfig().getDeviceFullConfig()->bits_per_pixel;
+        break;
+    }
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return bits_per_pixel;
+}
+
+utils::PixelFormat LCD::getFramePixelFormat()
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(isBusValid(), utils::PixelFormat::MAX, "Invalid bus");
+
+    int bus_type = getBus()->getBasicAttributes().type;
+    if (bus_type == ESP_PANEL_BUS_TYPE_VIRTUAL) {
+        bus_type = static_cast<BusVirtual *>(getBus())->getConfig().emulated_type;
+    }
+    // The SPI/QSPI/I80 bus sends the bytes in the memory order, so the pixels should be MSB first
+    bool is_msb_first = (bus_type == ESP_PANEL_BUS_TYPE_SPI) || (bus_type == ESP_PANEL_BUS_TYPE_QSPI) ||
+                        (bus_type == ESP_PANEL_BUS_TYPE_I80);
+
+    utils::PixelFormat format = utils::PixelFormat::MAX;
+    switch (getFrameColorBits()) {
+    case 16:
+        format = is_msb_first ? utils::PixelFormat::RGB565_SWAP : utils::PixelFormat::RGB565;
+        break;
+    case 18:
+        format = utils::PixelFormat::RGB666;
         break;
+    case 24:
+        format = is_msb_first ? utils::PixelFormat::RGB888 : utils::PixelFormat::BGR888;
+        break;
+    default:
+        ESP_UTILS_CHECK_FALSE_RETURN(false, utils::PixelFormat::MAX, "Unsupported color bits(%d)", getFrameColorBits());
     }
 
     ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
 
-    return bits_per_pixel;
+    return format;
 }
 
 void *LCD::getFrameBufferByIndex(uint8_t index)
@@ -1098,6 +1935,9 @@ bool LCD::processDeviceOnInit(const BasicBusSpecificationMap &bus_specs)
     case ESP_PANEL_BUS_TYPE_QSPI:
         vendor_config.flags.use_qspi_interface = 1;
         break;
+    case ESP_PANEL_BUS_TYPE_VIRTUAL:
+        // The virtual panel doesn't care about the interface flags
+        break;
 #if ESP_PANEL_DRIVERS_BUS_ENABLE_RGB
     /* Retrieve RGB configuration from the bus and register it into the vendor configuration */
     case ESP_PANEL_BUS_TYPE_RGB: {
@@ -1158,6 +1998,174 @@ bool LCD::processDeviceOnInit(const BasicBusSpecificationMap &bus_specs)
     return true;
 }
 
+int LCD::getBusTransQueueDepth()
+{
+    auto bus = getBus();
+    auto bus_type = bus->getBasicAttributes().type;
+    switch (bus_type) {
+    case ESP_PANEL_BUS_TYPE_SPI: {
+        auto &config = static_cast<BusSPI *>(bus)->getConfig();
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            std::holds_alternative<BusSPI::ControlPanelFullConfig>(config.control_panel), 0, "Config is not full"
+        );
+        return std::get<BusSPI::ControlPanelFullConfig>(config.control_panel).trans_queue_depth;
+    }
+    case ESP_PANEL_BUS_TYPE_QSPI: {
+        auto &config = static_cast<BusQSPI *>(bus)->getConfig();
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            std::holds_alternative<BusQSPI::ControlPanelFullConfig>(config.control_panel), 0, "Config is not full"
+        );
+        return std::get<BusQSPI::ControlPanelFullConfig>(config.control_panel).trans_queue_depth;
+    }
+    case ESP_PANEL_BUS_TYPE_VIRTUAL:
+        return static_cast<BusVirtual *>(bus)->getConfig().trans_queue_depth;
+    case ESP_PANEL_BUS_TYPE_RGB:
+        // The bitmap is copied to the frame buffer by `memcpy()`, no transaction queue
+        return 0;
+    default:
+        // Other buses (like I2C and MIPI-DSI) finish the drawings one by one
+        return 1;
+    }
+}
+
+bool LCD::createDrawBitmapQueue()
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(_draw_bitmap_queue.depth == 0, false, "Already created");
+
+    int depth = getBusTransQueueDepth();
+    ESP_UTILS_CHECK_FALSE_RETURN(depth > 0, false, "Invalid queue depth(%d)", depth);
+
+    ESP_UTILS_CHECK_EXCEPTION_RETURN(
+        _draw_bitmap_queue.buffer.resize(depth), false, "Create draw bitmap queue buffer failed"
+    );
+    _draw_bitmap_queue.slot_sem = xSemaphoreCreateCounting(depth, depth);
+    ESP_UTILS_CHECK_NULL_RETURN(_draw_bitmap_queue.slot_sem, false, "Create draw bitmap slot semaphore failed");
+
+    portENTER_CRITICAL(&_draw_bitmap_queue.lock);
+    _draw_bitmap_queue.items = _draw_bitmap_queue.buffer.data();
+    _draw_bitmap_queue.head = 0;
+    _draw_bitmap_queue.num = 0;
+    _draw_bitmap_queue.finished = _draw_bitmap_queue.submitted;
+    _draw_bitmap_queue.depth = depth;
+    portEXIT_CRITICAL(&_draw_bitmap_queue.lock);
+    ESP_UTILS_LOGD("Draw bitmap queue created, depth(%d)", depth);
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+void LCD::deleteDrawBitmapQueue()
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    portENTER_CRITICAL(&_draw_bitmap_queue.lock);
+    _draw_bitmap_queue.depth = 0;
+    _draw_bitmap_queue.num = 0;
+    _draw_bitmap_queue.items = nullptr;
+    portEXIT_CRITICAL(&_draw_bitmap_queue.lock);
+
+    if (_draw_bitmap_queue.slot_sem != nullptr) {
+        vSemaphoreDelete(_draw_bitmap_queue.slot_sem);
+    }
+    _draw_bitmap_queue = {};
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+}
+
+bool LCD::pushDrawBitmapQueue(const DrawBitmapQueue::Item &item, int timeout_ms, DrawBitmapToken &token)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_NULL_RETURN(_draw_bitmap_queue.slot_sem, false, "Queue not created");
+
+    TickType_t timeout_tick = (timeout_ms < 0) ? portMAX_DELAY : pdMS_TO_TICKS(timeout_ms);
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        xSemaphoreTake(_draw_bitmap_queue.slot_sem, timeout_tick) == pdTRUE, false, "Wait for free slot timeout"
+    );
+
+    portENTER_CRITICAL(&_draw_bitmap_queue.lock);
+    int tail = (_draw_bitmap_queue.head + _draw_bitmap_queue.num) % _draw_bitmap_queue.depth;
+    _draw_bitmap_queue.items[tail] = item;
+    _draw_bitmap_queue.num++;
+    token = ++_draw_bitmap_queue.submitted;
+    portEXIT_CRITICAL(&_draw_bitmap_queue.lock);
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+void LCD::cancelDrawBitmapQueue(DrawBitmapToken token)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    bool is_canceled = false;
+    portENTER_CRITICAL(&_draw_bitmap_queue.lock);
+    // Only the latest item which hasn't been finished can be canceled
+    if ((_draw_bitmap_queue.num > 0) && (_draw_bitmap_queue.submitted == token) && !isDrawBitmapFinished(token)) {
+        _draw_bitmap_queue.num--;
+        _draw_bitmap_queue.submitted--;
+        is_canceled = true;
+    }
+    portEXIT_CRITICAL(&_draw_bitmap_queue.lock);
+
+    if (is_canceled) {
+        xSemaphoreGive(_draw_bitmap_queue.slot_sem);
+    } else {
+        ESP_UTILS_LOGW("Draw bitmap(%d) can't be canceled", static_cast<int>(token));
+    }
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+}
+
+bool LCD::checkDrawBitmapArea(int x_start, int y_start, int width, int height, const uint8_t *color_data)
+{
+    // Check basic parameters validity
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        (x_start >= 0) && (y_start >= 0), false, "Invalid start coordinates: (%d,%d)", x_start, y_start
+    );
+    ESP_UTILS_CHECK_FALSE_RETURN((width >= 0) && (height >= 0), false, "Invalid dimensions: (%d,%d)", width, height);
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        ((width == 0) && (height == 0)) || (color_data != nullptr), false, "Invalid color_data"
+    );
+
+    // Get display parameters
+    auto swap_xy = getTransformation().swap_xy;
+    auto frame_width = getFrameWidth();
+    auto frame_height = getFrameHeight();
+    auto x_align = getBasicAttributes().basic_bus_spec.x_coord_align;
+    auto y_align = getBasicAttributes().basic_bus_spec.y_coord_align;
+    auto x_end = x_start + width;
+    auto y_end = y_start + height;
+
+    // Check boundary limits
+    auto max_x = swap_xy ? frame_height : frame_width;
+    auto max_y = swap_xy ? frame_width : frame_height;
+    if (frame_width > 0) {
+        ESP_UTILS_CHECK_FALSE_RETURN(x_end <= max_x, false, "x_end(%d) exceeds display limit(%d)", x_end, max_x);
+    }
+    if (frame_height > 0) {
+        ESP_UTILS_CHECK_FALSE_RETURN(y_end <= max_y, false, "y_end(%d) exceeds display limit(%d)", y_end, max_y);
+    }
+
+    // Check coordinate alignment
+    if (x_start & (x_align - 1)) {
+        ESP_UTILS_LOGW("x_start(%d) not aligned to %d", x_start, x_align);
+    } else if (width & (x_align - 1)) {
+        ESP_UTILS_LOGW("width(%d) not aligned to %d", width, x_align);
+    }
+    if (y_start & (y_align - 1)) {
+        ESP_UTILS_LOGW("y_start(%d) not aligned to %d", y_start, y_align);
+    } else if (height & (y_align - 1)) {
+        ESP_UTILS_LOGW("height(%d) not aligned to %d", height, y_align);
+    }
+
+    return true;
+}
+
 LCD::DeviceFullConfig &LCD::getDeviceFullConfig()
 {
     if (!std::holds_alternative<DeviceFullConfig>(_config.device)) {
@@ -1218,6 +2226,255 @@ const BusDSI::RefreshPanelFullConfig *LCD::getBusDSI_RefreshPanelFullConfig()
 }
 #endif
 
+uint32_t LCD::submitLatencyFrame()
+{
+    if (_latency_tracker == nullptr) {
+        return 0;
+    }
+
+    uint32_t frame_id = _latency_tracker->notifySubmit(static_cast<uint32_t>(esp_timer_get_time()));
+    _last_frame_id = frame_id;
+
+    return frame_id;
+}
+
+esp_err_t LCD::drawBitmapToPanel(int x_start, int y_start, int width, int height, const uint8_t *color_data)
+{
+    // In the RGB stream mode, the bitmap is written to the line store, which is read by the bounce buffers
+    if (_line_provider.store != nullptr) {
+        if ((width <= 0) || (height <= 0)) {
+            return ESP_OK;
+        }
+        return _line_provider.store->writeArea(x_start, y_start, width, height, color_data) ? ESP_OK : ESP_FAIL;
+    }
+
+    return esp_lcd_panel_draw_bitmap(refresh_panel, x_start, y_start, x_start + width, y_start + height, color_data);
+}
+
+int LCD::getSwapChainBufferIndex(void *frame_buffer)
+{
+    for (int i = 0; i < _swap_chain->chain.getConfig().buffer_num; i++) {
+        if (_swap_chain->buffers[i] == frame_buffer) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+bool LCD::waitSwapChainRefresh(TickType_t start_tick, int timeout_ms)
+{
+    TickType_t timeout_tick = (timeout_ms < 0) ? portMAX_DELAY : pdMS_TO_TICKS(timeout_ms);
+    TickType_t elapsed_tick = xTaskGetTickCount() - start_tick;
+    if ((timeout_ms >= 0) && (elapsed_tick >= timeout_tick)) {
+        return false;
+    }
+    // The semaphore might be given by an earlier event, so the caller should check its condition again
+    xSemaphoreTake(_swap_chain->refresh_sem, (timeout_ms < 0) ? portMAX_DELAY : (timeout_tick - elapsed_tick));
+
+    return true;
+}
+
+bool LCD::beginTearingEffect()
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    auto &tearing = *_tearing_effect;
+    auto &config = tearing.config;
+    auto bus_type = getBus()->getBasicAttributes().type;
+    // The QSPI panels take the command in the address phase after the write opcode
+    auto get_cmd_address = [bus_type](uint8_t cmd) {
+        return (bus_type == ESP_PANEL_BUS_TYPE_QSPI) ?
+               ((TearingEffect::QSPI_OPCODE_WRITE_CMD << 24) | (static_cast<uint32_t>(cmd) << 8)) :
+               static_cast<uint32_t>(cmd);
+    };
+
+    if (config.scanline >= 0) {
+        uint8_t scanline[2] = {static_cast<uint8_t>(config.scanline >> 8), static_cast<uint8_t>(config.scanline)};
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            getBus()->writeRegisterData(get_cmd_address(LCD_CMD_STE), scanline, sizeof(scanline)), false,
+            "Set TE scanline failed"
+        );
+    }
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        getBus()->writeRegisterData(get_cmd_address(LCD_CMD_TEON), &config.mode, 1), false, "Turn on TE failed"
+    );
+
+    // The scheduler, the timer and the ISR are kept when the panel is begun again after reset
+    if (tearing.is_isr_added) {
+        goto end;
+    }
+
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        tearing.scheduler.setConfig({
+            .height = getFrameHeight(),
+            .blank_lines = config.blank_lines,
+            .te_line = config.scanline,
+            .margin_lines = config.margin_lines,
+            .period_us = config.period_us,
+        }), false, "Invalid TE config"
+    );
+
+    if (tearing.start_sem == nullptr) {
+        tearing.start_sem = xSemaphoreCreateBinary();
+        ESP_UTILS_CHECK_NULL_RETURN(tearing.start_sem, false, "Create TE start semaphore failed");
+    }
+    if (tearing.start_timer == nullptr) {
+        esp_timer_create_args_t timer_args = {
+            .callback = onTearingEffectTimer,
+            .arg = &tearing,
+            .dispatch_method = ESP_TIMER_TASK,
+            .name = "lcd_te",
+            .skip_unhandled_events = false,
+        };
+        ESP_UTILS_CHECK_ERROR_RETURN(
+            esp_timer_create(&timer_args, &tearing.start_timer), false, "Create TE start timer failed"
+        );
+    }
+
+    {
+        gpio_config_t io_config = {
+            .pin_bit_mask = BIT64(config.gpio_num),
+            .mode = GPIO_MODE_INPUT,
+            .pull_up_en = GPIO_PULLUP_DISABLE,
+            .pull_down_en = GPIO_PULLDOWN_DISABLE,
+            .intr_type = config.flags_active_low ? GPIO_INTR_NEGEDGE : GPIO_INTR_POSEDGE,
+        };
+        ESP_UTILS_CHECK_ERROR_RETURN(gpio_config(&io_config), false, "Config TE GPIO failed");
+        // The ISR service might be installed by others
+        auto ret = gpio_install_isr_service(0);
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            (ret == ESP_OK) || (ret == ESP_ERR_INVALID_STATE), false, "Install GPIO ISR service failed"
+        );
+        ESP_UTILS_CHECK_ERROR_RETURN(
+            gpio_isr_handler_add(static_cast<gpio_num_t>(config.gpio_num), onTearingEffect, this), false,
+            "Add TE GPIO ISR failed"
+        );
+        tearing.is_isr_added = true;
+    }
+
+end:
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool LCD::endTearingEffect()
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    auto &tearing = *_tearing_effect;
+    if (tearing.is_isr_added) {
+        ESP_UTILS_CHECK_ERROR_RETURN(
+            gpio_isr_handler_remove(static_cast<gpio_num_t>(tearing.config.gpio_num)), false,
+            "Remove TE GPIO ISR failed"
+        );
+        gpio_reset_pin(static_cast<gpio_num_t>(tearing.config.gpio_num));
+        tearing.is_isr_added = false;
+    }
+    if (tearing.start_timer != nullptr) {
+        esp_timer_stop(tearing.start_timer);
+        ESP_UTILS_CHECK_ERROR_RETURN(esp_timer_delete(tearing.start_timer), false, "Delete TE start timer failed");
+        tearing.start_timer = nullptr;
+    }
+    if (tearing.start_sem != nullptr) {
+        vSemaphoreDelete(tearing.start_sem);
+        tearing.start_sem = nullptr;
+    }
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool LCD::waitTearingEffect(int x_start, int y_start, int width, int height)
+{
+    auto &tearing = *_tearing_effect;
+    if (!tearing.is_isr_added) {
+        return true;
+    }
+
+    // The schedule assumes the transfer starts immediately, so wait for the drawings in flight
+    auto &queue = _draw_bitmap_queue;
+    if ((queue.depth > 0) && !isDrawBitmapFinished(queue.submitted)) {
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            waitDrawBitmapFinish(queue.submitted, TearingEffect::WAIT_TIMEOUT_MS), false,
+            "Wait for the drawings in flight timeout"
+        );
+    }
+    // Learn the bus speed from the last scheduled drawing, the latest finish event is its finish
+    if ((tearing.last_bytes > 0) && isDrawBitmapFinished(tearing.last_token)) {
+        tearing.scheduler.notifyTransfer(tearing.last_bytes, tearing.finish_us - tearing.last_start_us);
+        tearing.last_bytes = 0;
+    }
+
+    // Get the lines on the panel written by the drawing, the axes are swapped and mirrored by the commands
+    using WriteOrder = utils::TearingScheduler::WriteOrder;
+    int line_start = _transformation.swap_xy ? (x_start + _transformation.gap_x) : (y_start + _transformation.gap_y);
+    int lines = _transformation.swap_xy ? width : height;
+    WriteOrder order = _transformation.swap_xy ? WriteOrder::COLUMNS :
+                       (_transformation.mirror_y ? WriteOrder::BOTTOM_TO_TOP : WriteOrder::TOP_TO_BOTTOM);
+    if (_transformation.mirror_y && !_transformation.swap_xy) {
+        line_start = getFrameHeight() - line_start - lines;
+    }
+    uint32_t bytes = width * height * ((getFrameColorBits() + 7) / 8);
+
+    auto plan = tearing.scheduler.schedule(
+                    line_start, lines, bytes, static_cast<uint32_t>(esp_timer_get_time()), order
+                );
+    int32_t wait_us = static_cast<int32_t>(plan.start_us - static_cast<uint32_t>(esp_timer_get_time()));
+    if (wait_us >= TearingEffect::WAIT_MIN_US) {
+        xSemaphoreTake(tearing.start_sem, 0);
+        ESP_UTILS_CHECK_ERROR_RETURN(
+            esp_timer_start_once(tearing.start_timer, wait_us), false, "Start TE start timer failed"
+        );
+        ESP_UTILS_CHECK_FALSE_RETURN(
+            xSemaphoreTake(
+                tearing.start_sem, pdMS_TO_TICKS(wait_us / 1000 + TearingEffect::WAIT_TIMEOUT_MS)
+            ) == pdTRUE, false, "Wait TE start timer timeout"
+        );
+    } else if (wait_us > 0) {
+        esp_rom_delay_us(wait_us);
+    }
+
+    // The drawing is pushed right after this, so its token is the next one
+    tearing.last_token = queue.submitted + 1;
+    tearing.last_bytes = (queue.depth > 0) ? bytes : 0;
+    tearing.last_start_us = static_cast<uint32_t>(esp_timer_get_time());
+
+    return true;
+}
+
+IRAM_ATTR void LCD::onTearingEffect(void *arg)
+{
+    LCD *lcd_ptr = static_cast<LCD *>(arg);
+    uint32_t time_us = static_cast<uint32_t>(esp_timer_get_time());
+    lcd_ptr->_tearing_effect->scheduler.notifyTE(time_us);
+
+    utils::FramePacer *pacer = lcd_ptr->_frame_pacer;
+    if (pacer != nullptr) {
+        pacer->notifyVsync(time_us);
+    }
+}
+
+void LCD::onTearingEffectTimer(void *arg)
+{
+    xSemaphoreGive(static_cast<TearingEffect *>(arg)->start_sem);
+}
+
+IRAM_ATTR void LCD::notifyLatencyTransferDone()
+{
+    if (_latency_tracker == nullptr) {
+        return;
+    }
+
+    uint32_t time_us = static_cast<uint32_t>(esp_timer_get_time());
+    _latency_tracker->notifyTransferDone(time_us);
+    if (!_has_refresh_event) {
+        _latency_tracker->notifyVsync(time_us);
+    }
+}
+
 IRAM_ATTR bool LCD::onDrawBitmapFinish(void *panel_io, void *edata, void *user_ctx)
 {
     Interruption::CallbackData *callback_data = (Interruption::CallbackData *)user_ctx;
@@ -1230,18 +2487,100 @@ IRAM_ATTR bool LCD::onDrawBitmapFinish(void *panel_io, void *edata, void *user_c
         return false;
     }
 
+    lcd_ptr->notifyLatencyTransferDone();
+    if (lcd_ptr->_tearing_effect != nullptr) {
+        lcd_ptr->_tearing_effect->finish_us = static_cast<uint32_t>(esp_timer_get_time());
+    }
+
     BaseType_t need_yield = pdFALSE;
     if (lcd_ptr->_interruption.on_draw_bitmap_finish != nullptr) {
         need_yield =
             lcd_ptr->_interruption.on_draw_bitmap_finish(lcd_ptr->_interruption.data.user_data) ? pdTRUE : need_yield;
     }
-    if (lcd_ptr->_interruption.draw_bitmap_finish_sem != nullptr) {
+
+    // Pop the oldest in-flight drawing, since the bus finishes the color transactions in order
+    auto &queue = lcd_ptr->_draw_bitmap_queue;
+    DrawBitmapQueue::Item item = {};
+    bool is_popped = false;
+    DrawBitmapQueue::Waiter *finished_waiters = nullptr;
+    portENTER_CRITICAL_SAFE(&queue.lock);
+    if (queue.num > 0) {
+        item = queue.items[queue.head];
+        if (++queue.head >= queue.depth) {
+            queue.head = 0;
+        }
+        queue.num--;
+        queue.finished++;
+        is_popped = true;
+        // Take out the waiters of the finished drawings, their semaphores are given after the lock is released
+        for (auto node = &queue.waiters; *node != nullptr;) {
+            auto waiter = *node;
+            if (static_cast<int32_t>(queue.finished - waiter->token) >= 0) {
+                *node = waiter->next;
+                waiter->next = finished_waiters;
+                finished_waiters = waiter;
+            } else {
+                node = &waiter->next;
+            }
+        }
+    }
+    portEXIT_CRITICAL_SAFE(&queue.lock);
+
+    // The drawing is not tracked by the queue (like `switchFrameBufferTo()`), notify `drawBitmap()` as usual
+    if (!is_popped) {
+        if (lcd_ptr->_interruption.draw_bitmap_finish_sem != nullptr) {
+            xSemaphoreGiveFromISR(lcd_ptr->_interruption.draw_bitmap_finish_sem, &need_yield);
+        }
+        return (need_yield == pdTRUE);
+    }
+
+    if (item.is_async && (queue.on_recycle != nullptr)) {
+        need_yield = queue.on_recycle(item.color_data, queue.recycle_user_data) ? pdTRUE : need_yield;
+    }
+    if (item.need_notify && (lcd_ptr->_interruption.draw_bitmap_finish_sem != nullptr)) {
         xSemaphoreGiveFromISR(lcd_ptr->_interruption.draw_bitmap_finish_sem, &need_yield);
     }
+    while (finished_waiters != nullptr) {
+        // The waiter may leave once its semaphore is given, so get the next one before
+        auto waiter = finished_waiters;
+        finished_waiters = waiter->next;
+        xSemaphoreGiveFromISR(waiter->sem, &need_yield);
+    }
+    xSemaphoreGiveFromISR(queue.slot_sem, &need_yield);
 
     return (need_yield == pdTRUE);
 }
 
+IRAM_ATTR bool LCD::onBounceEmpty(void *panel, void *bounce_buf, int pos_px, int len_bytes, void *user_ctx)
+{
+    Interruption::CallbackData *callback_data = (Interruption::CallbackData *)user_ctx;
+    if (callback_data == nullptr) {
+        return false;
+    }
+
+    LCD *lcd_ptr = (LCD *)callback_data->lcd_ptr;
+    if (lcd_ptr == nullptr) {
+        return false;
+    }
+
+    auto &provider = lcd_ptr->_line_provider;
+    portENTER_CRITICAL_SAFE(&provider.lock);
+    FunctionLineProviderCallback callback = provider.callback;
+    void *user_data = provider.user_data;
+    portEXIT_CRITICAL_SAFE(&provider.lock);
+
+    // Show black lines if no provider is attached
+    if ((callback == nullptr) || (provider.line_bytes <= 0)) {
+        memset(bounce_buf, 0, len_bytes);
+        return false;
+    }
+
+    return callback(
+               pos_px / provider.line_pixels, len_bytes / provider.line_bytes, static_cast<uint8_t *>(bounce_buf),
+               user_data
+           );
+}
+
 IRAM_ATTR bool LCD::onRefreshFinish(void *panel_io, void *edata, void *user_ctx)
 {
     Interruption::CallbackData *callback_data = (Interruption::CallbackData *)user_ctx;
@@ -1254,7 +2593,24 @@ IRAM_ATTR bool LCD::onRefreshFinish(void *panel_io, void *edata, void *user_ctx)
         return false;
     }
 
+    uint32_t time_us = static_cast<uint32_t>(esp_timer_get_time());
+    if (lcd_ptr->_latency_tracker != nullptr) {
+        lcd_ptr->_latency_tracker->notifyVsync(time_us);
+    }
+    utils::FramePacer *pacer = lcd_ptr->_frame_pacer;
+    if (pacer != nullptr) {
+        pacer->notifyVsync(time_us);
+    }
+
     BaseType_t need_yield = pdFALSE;
+    // The pending frame buffer of the swap chain is latched right after this event
+    portENTER_CRITICAL_SAFE(&lcd_ptr->_swap_chain_lock);
+    SwapChainContext *swap_chain = lcd_ptr->_swap_chain.get();
+    if ((swap_chain != nullptr) && swap_chain->chain.notifyRefresh()) {
+        xSemaphoreGiveFromISR(swap_chain->refresh_sem, &need_yield);
+    }
+    portEXIT_CRITICAL_SAFE(&lcd_ptr->_swap_chain_lock);
+
     if (lcd_ptr->_interruption.on_refresh_finish != nullptr) {
         need_yield =
             lcd_ptr->_interruption.on_refresh_finish(lcd_ptr->_interruption.data.user_data) ? pdTRUE : need_yield;
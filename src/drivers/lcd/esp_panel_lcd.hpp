@@ -6,15 +6,24 @@
 
 #pragma once
 
+#include <atomic>
 #include <variant>
 #include <map>
 #include <memory>
 #include "soc/soc_caps.h"
 #include "esp_lcd_panel_ops.h"
 #include "esp_lcd_panel_vendor.h"
+#include "esp_timer.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/semphr.h"
 #include "utils/esp_panel_utils_cxx.hpp"
+#include "utils/esp_panel_utils_dirty_area.hpp"
+#include "utils/esp_panel_utils_frame_pacer.hpp"
+#include "utils/esp_panel_utils_latency.hpp"
+#include "utils/esp_panel_utils_line_store.hpp"
+#include "utils/esp_panel_utils_pixel_convert.hpp"
+#include "utils/esp_panel_utils_swap_chain.hpp"
+#include "utils/esp_panel_utils_tearing.hpp"
 #include "drivers/bus/esp_panel_bus_factory.hpp"
 #include "port/esp_panel_lcd_vendor_types.h"
 #include "esp_panel_lcd_conf_internal.h"
@@ -58,6 +67,31 @@ public:
      */
     using FunctionRefreshFinishCallback = bool (*)(void *user_data);
 
+    /**
+     * @brief Function pointer type for bitmap buffer recycle callback
+     *
+     * @param[in] color_data Pointer of the color data which is no longer accessed by the bus
+     * @param[in] user_data User provided data pointer that will be passed to the callback
+     * @return `true` if a context switch is required, `false` otherwise
+     */
+    using FunctionDrawBitmapRecycleCallback = bool (*)(const uint8_t *color_data, void *user_data);
+
+    /**
+     * @brief Function pointer type for line provider callback, which fills the bounce buffer in the RGB stream mode
+     *
+     * @param[in] y_start Index of the first line
+     * @param[in] lines Number of the lines
+     * @param[out] buffer Buffer of the packed pixels of the lines
+     * @param[in] user_data User provided data pointer that will be passed to the callback
+     * @return `true` if a context switch is required, `false` otherwise
+     */
+    using FunctionLineProviderCallback = bool (*)(int y_start, int lines, uint8_t *buffer, void *user_data);
+
+    /**
+     * @brief Token type to track the completion of a bitmap drawing
+     */
+    using DrawBitmapToken = uint32_t;
+
     /**
      * @brief Basic bus specification structure for LCD devices
      */
@@ -167,6 +201,19 @@ public:
     using VendorFullConfig = esp_panel_lcd_vendor_config_t;
     using VendorConfig = std::variant<VendorPartialConfig, VendorFullConfig>;
 
+    /**
+     * @brief Configuration of the tearing effect (TE) signal, see `configTearingEffect()`
+     */
+    struct TearingEffectConfig {
+        int gpio_num = -1;              /*!< GPIO of the TE signal, `-1` to disable */
+        uint8_t mode = 0;               /*!< Parameter of the TE ON command (0x35), `0` outputs the V-blanking only */
+        int scanline = -1;              /*!< Scanline of the TE signal set by the command (0x44), `-1` to not send */
+        int blank_lines = 0;            /*!< Lines of the vertical blanking of the panel */
+        int margin_lines = 2;           /*!< Lines kept between the scanline and the written lines */
+        uint32_t period_us = 0;         /*!< Refresh period, `0` to learn from the TE signal */
+        bool flags_active_low = 0;      /*!< The TE signal is active low */
+    };
+
     /**
      * @brief Configuration structure for LCD device
      */
@@ -440,6 +487,266 @@ public:
      */
     bool drawBitmap(int x_start, int y_start, int width, int height, const uint8_t *color_data, int timeout_ms = 0);
 
+    /**
+     * @brief Queue the bitmap to be drawn to the LCD and return immediately
+     *
+     * Multiple bitmaps can be in flight at the same time, so the caller can render the next region while the
+     * previous ones are being transferred. The in-flight queue is bounded by the transaction queue depth of the bus
+     * (e.g. `BusSPI::configSPI_TransQueueDepth()`), this function blocks when the queue is full.
+     *
+     * @param[in] x_start X coordinate of the start point, the range is [0, lcd_width - 1]
+     * @param[in] y_start Y coordinate of the start point, the range is [0, lcd_height - 1]
+     * @param[in] width Width of the bitmap, the range is [1, lcd_width - x_start]
+     * @param[in] height Height of the bitmap, the range is [1, lcd_height - y_start]
+     * @param[in] color_data Pointer of the color data array
+     * @param[out] token Token of the drawing which can be used by `waitDrawBitmapFinish()`, set to `nullptr` if not
+     *                   needed
+     * @param[in] timeout_ms Wait timeout for a free slot of the in-flight queue in milliseconds, default is -1 which
+     *                       means wait forever
+     * @return `true` if successful, `false` otherwise
+     * @note This function should be called after `begin()`
+     * @note The bitmap data should not be modified until the drawing is finished, use
+     *       `attachDrawBitmapRecycleCallback()` or `waitDrawBitmapFinish()` to know when it can be reused
+     * @note For bus which not use DMA operation (like RGB), the drawing is finished when this function returns
+     */
+    bool drawBitmapAsync(
+        int x_start, int y_start, int width, int height, const uint8_t *color_data, DrawBitmapToken *token = nullptr,
+        int timeout_ms = -1
+    );
+
+    /**
+     * @brief Check if the drawing of the specified token is finished
+     *
+     * @param[in] token Token returned by `drawBitmapAsync()`
+     * @return `true` if finished, `false` otherwise
+     */
+    bool isDrawBitmapFinished(DrawBitmapToken token);
+
+    /**
+     * @brief Wait for the drawing of the specified token to finish
+     *
+     * Since the bitmaps are transferred in order, all drawings queued before the token are finished as well.
+     *
+     * @param[in] token Token returned by `drawBitmapAsync()`
+     * @param[in] timeout_ms Wait timeout in milliseconds, default is -1 which means wait forever
+     * @return `true` if finished, `false` if timeout or failed
+     * @note This function should be called after `begin()`
+     */
+    bool waitDrawBitmapFinish(DrawBitmapToken token, int timeout_ms = -1);
+
+    /**
+     * @brief Wait for all queued drawings to finish
+     *
+     * @param[in] timeout_ms Wait timeout in milliseconds, default is -1 which means wait forever
+     * @return `true` if finished, `false` if timeout or failed
+     * @note This function should be called after `begin()`
+     */
+    bool waitDrawBitmapAllFinish(int timeout_ms = -1);
+
+    /**
+     * @brief Get the maximum number of in-flight drawings of `drawBitmapAsync()`
+     *
+     * @return Depth of the in-flight queue, `0` if the bus doesn't need it (like RGB) or not begun
+     */
+    int getDrawBitmapQueueDepth() const
+    {
+        return _draw_bitmap_queue.depth;
+    }
+
+    /**
+     * @brief Get the number of the submitted drawings, e.g. to estimate the frame rate
+     *
+     * @return Number of the successful `drawBitmap()`, `drawBitmapAsync()` and `switchFrameBufferTo()`, which
+     *         wraps around
+     */
+    uint32_t getDrawBitmapCount() const
+    {
+        return _draw_bitmap_count;
+    }
+
+    /**
+     * @brief Attach a tracker of the touch-to-photon latency
+     *
+     * Each drawing of `drawBitmap()`, `drawBitmapAsync()` and `switchFrameBufferTo()` is submitted to the tracker as a
+     * frame, and completed by the transfer done and the refresh finish events. For the buses without the refresh
+     * event (e.g. SPI), the refresh is treated as finished when the transfer is done.
+     *
+     * @param[in] tracker Pointer to the tracker, `nullptr` to detach. It should be valid until detached
+     * @return `true` if success, otherwise false
+     * @note This function should be called after `begin()` and when no drawing is in flight
+     * @note The tracker is called by the ISRs, so it should be placed in internal RAM when the ISR of the bus is
+     *       IRAM-safe (e.g. `CONFIG_SPI_MASTER_ISR_IN_IRAM` for SPI/QSPI bus)
+     */
+    bool attachLatencyTracker(utils::LatencyTracker *tracker);
+
+    /**
+     * @brief Attach a pacer of the frame rendering, which is fed by the vsync events
+     *
+     * The refresh finish event is used as the vsync for the RGB/MIPI-DSI bus, and the TE signal is used for the
+     * buses configured by `configTearingEffect()`.
+     *
+     * @param[in] pacer Pointer to the pacer, `nullptr` to detach. It should be valid until detached
+     * @return `true` if success, otherwise false
+     * @note This function should be called after `begin()`
+     * @note The pacer is called by the ISRs, so it should be placed in internal RAM when the ISR is IRAM-safe
+     */
+    bool attachFramePacer(utils::FramePacer *pacer);
+
+    /**
+     * @brief Attach a callback to provide the lines in the RGB stream mode (see `BusRGB::configRGB_StreamMode()`)
+     *
+     * The callback is called by the bounce buffer ISR just in time, so the whole frame doesn't need to be resident
+     * in the memory. The lines are black if no callback is attached.
+     *
+     * @param[in] callback The callback function, `nullptr` to detach. It should finish before the bounce buffer is
+     *                     sent, so it usually renders the lines from a compact representation (e.g. tiles or runs)
+     * @param[in] user_data User data passed to the callback
+     * @return `true` if success, otherwise false
+     * @note This function should be called after `begin()`, and it detaches the line store
+     */
+    bool attachLineProvider(FunctionLineProviderCallback callback, void *user_data);
+
+    /**
+     * @brief Attach a line store in the RGB stream mode (see `BusRGB::configRGB_StreamMode()`)
+     *
+     * The bounce buffers are filled from the store, and `drawBitmap()` and `drawBitmapAsync()` write the store
+     * instead of the frame buffer, so the GUIs work without any frame buffer.
+     *
+     * @param[in] store Pointer to the store, `nullptr` to detach. Its resolution and pixel size should be the same
+     *                  as the frame, and it should be valid until detached
+     * @return `true` if success, otherwise false
+     * @note This function should be called after `begin()`
+     * @note The mirror and swap of the axes are not applied to the bitmaps written to the store
+     */
+    bool attachLineStore(utils::CompressedLineStore *store);
+
+    /**
+     * @brief Configure the tearing effect (TE) signal of the panel, only valid for SPI, QSPI and I80 bus
+     *
+     * `begin()` turns on the TE output by the commands and listens to it by the GPIO interrupt. Then each drawing of
+     * `drawBitmap()` and `drawBitmapAsync()` is delayed to a start time, when the transferred lines are written
+     * between two scans of the panel, either racing ahead of the scanline or following behind it. So the partial
+     * refreshes are tear-free without double buffering. The period and the bus speed are learned from the TE signal
+     * and the finished drawings, and the drawings start immediately until they are learned.
+     *
+     * @param[in] config TE configuration, set `gpio_num` to `-1` to disable
+     * @return `true` if success, otherwise false
+     * @note This function should be called before `begin()`
+     * @note The drawings in flight are waited before scheduling, since the schedule assumes the transfer starts
+     *       immediately
+     */
+    bool configTearingEffect(const TearingEffectConfig &config);
+
+    /**
+     * @brief Get the scheduler of the tearing effect, e.g. to check the learned period and the tearing number
+     *
+     * @return Pointer to the scheduler, `nullptr` if the TE signal is not configured
+     */
+    const utils::TearingScheduler *getTearingScheduler() const
+    {
+        return (_tearing_effect != nullptr) ? &_tearing_effect->scheduler : nullptr;
+    }
+
+    /**
+     * @brief Get the sequence ID of the last drawing submitted to the latency tracker
+     *
+     * @return Sequence ID of `utils::LatencyTracker::notifySubmit()`, `0` if no tracker is attached
+     */
+    uint32_t getLastFrameID() const
+    {
+        return _last_frame_id;
+    }
+
+    /**
+     * @brief Configure the cost of one transfer used to merge the dirty areas, in pixels
+     *
+     * Every transfer costs a command sequence (CASET/RASET/RAMWR) and a transaction setup besides the pixels. The
+     * dirty areas added by `addDirtyArea()` are merged when sending the bounding box costs less than sending them
+     * separately.
+     *
+     * @param[in] pixels Cost of one transfer in pixels, default is
+     *                   `utils::DirtyAreaMerger::TRANSFER_OVERHEAD_PX_DEFAULT`
+     * @return `true` if successful, `false` otherwise
+     * @note This function should be called when there are no pending dirty areas
+     */
+    bool configDirtyAreaTransferOverhead(uint32_t pixels);
+
+    /**
+     * @brief Add a dirty area which will be sent by `flushDirtyAreas()`
+     *
+     * The area is expanded to the coordinate alignment of the LCD and merged with the pending areas if it reduces
+     * the total cost of the transfers.
+     *
+     * @param[in] x_start X coordinate of the start point, the range is [0, lcd_width - 1]
+     * @param[in] y_start Y coordinate of the start point, the range is [0, lcd_height - 1]
+     * @param[in] width Width of the area
+     * @param[in] height Height of the area
+     * @return `true` if successful, `false` otherwise
+     * @note This function should be called after `begin()`
+     */
+    bool addDirtyArea(int x_start, int y_start, int width, int height);
+
+    /**
+     * @brief Send the pending dirty areas from a full frame buffer and clear them
+     *
+     * The areas which span the full frame width are sent from the frame buffer directly since their rows are
+     * contiguous. The others are copied row by row into the two halves of the transfer buffer in turn, so the copy of
+     * one half overlaps the transfer of the other.
+     *
+     * @param[in] frame_buffer Full frame buffer, the stride is the current frame width (swapped when `swapXY()` is
+     *                         enabled)
+     * @param[in] trans_buffer Transfer buffer which is split into two halves, set to `nullptr` to expand all areas to
+     *                         the full frame width and send them from the frame buffer directly
+     * @param[in] trans_buffer_size Size of the transfer buffer in bytes, each half should hold at least one row of
+     *                              the widest area
+     * @param[in] timeout_ms Wait timeout for each transfer in milliseconds, default is -1 which means wait forever
+     * @return `true` if successful, `false` otherwise
+     * @note This function should be called after `begin()`
+     * @note All transfers are finished when this function returns
+     * @note For bus which uses DMA operation, the buffers which are sent directly should be DMA capable
+     */
+    bool flushDirtyAreas(
+        const uint8_t *frame_buffer, uint8_t *trans_buffer = nullptr, size_t trans_buffer_size = 0, int timeout_ms = -1
+    );
+
+    /**
+     * @brief Get the merger of the pending dirty areas
+     *
+     * @return Reference to the merger
+     */
+    const utils::DirtyAreaMerger &getDirtyAreaMerger() const
+    {
+        return _dirty_area_merger;
+    }
+
+    /**
+     * @brief Draw a bitmap in another pixel format, which is converted to the format sent to the LCD on the fly
+     *
+     * The bitmap is converted by lines into the two halves of the transfer buffer in turn, so the conversion of one
+     * half overlaps the transfer of the other. If the format is the same as `getFramePixelFormat()`, the bitmap is
+     * sent by `drawBitmap()` directly and the transfer buffer is not used.
+     *
+     * @param[in] x_start X coordinate of the start point, the range is [0, lcd_width - 1]
+     * @param[in] y_start Y coordinate of the start point, the range is [0, lcd_height - 1]
+     * @param[in] width Width of the bitmap
+     * @param[in] height Height of the bitmap
+     * @param[in] color_data Bitmap data in `format`
+     * @param[in] format Pixel format of the bitmap
+     * @param[in] trans_buffer Transfer buffer which is split into two halves, 4-byte aligned halves allow the faster
+     *                         conversion kernels
+     * @param[in] trans_buffer_size Size of the transfer buffer in bytes, each half should hold at least one line of
+     *                              the converted bitmap
+     * @param[in] timeout_ms Wait timeout for each transfer in milliseconds, default is -1 which means wait forever
+     * @return `true` if successful, `false` otherwise
+     * @note This function should be called after `begin()`
+     * @note All transfers are finished when this function returns
+     * @note For bus which uses DMA operation, the transfer buffer should be DMA capable
+     */
+    bool drawBitmapConverted(
+        int x_start, int y_start, int width, int height, const uint8_t *color_data, utils::PixelFormat format,
+        uint8_t *trans_buffer, size_t trans_buffer_size, int timeout_ms = -1
+    );
+
     /**
      * @brief Mirror the X axis
      *
@@ -510,6 +817,24 @@ public:
      */
     bool setDisplayOnOff(bool enable_on);
 
+    /**
+     * @brief Set the pixel clock of the refresh, e.g. to lower the refresh rate when the content is static
+     *
+     * @param[in] hz Pixel clock in Hz, `0` to restore the configured one
+     * @return `true` if successful, `false` otherwise
+     * @note This function should be called after `begin()`
+     * @note Only valid for RGB bus, since the MIPI-DSI driver can't change the refresh rate at runtime
+     * @note The new clock takes effect from the next frame
+     */
+    bool setPixelClockHz(int hz);
+
+    /**
+     * @brief Get the current pixel clock of the refresh
+     *
+     * @return Pixel clock in Hz, `-1` if the bus doesn't refresh by the pixel clock (like SPI)
+     */
+    int getPixelClockHz();
+
     /**
      * @brief Attach a callback function to be called when bitmap drawing finishes
      *
@@ -521,6 +846,17 @@ public:
      */
     bool attachDrawBitmapFinishCallback(FunctionDrawBitmapFinishCallback callback, void *user_data = nullptr);
 
+    /**
+     * @brief Attach a callback function to be called when the bitmap buffer of `drawBitmapAsync()` can be reused
+     *
+     * @param[in] callback Function to be called with the color data which is no longer accessed by the bus
+     * @param[in] user_data User data to pass to callback function
+     * @return `true` if successful, `false` otherwise
+     * @note For bus which not use DMA operation (like RGB), callback is called at end of `drawBitmapAsync()`
+     * @note For other bus types, callback is called in the same context as the draw finish callback
+     */
+    bool attachDrawBitmapRecycleCallback(FunctionDrawBitmapRecycleCallback callback, void *user_data = nullptr);
+
     /**
      * @brief Attach a callback function to be called when frame buffer refresh finishes
      *
@@ -545,6 +881,81 @@ public:
      */
     bool switchFrameBufferTo(void *frame_buffer);
 
+    /**
+     * @brief Enable the swap chain over the frame buffers, which replaces the manual `switchFrameBufferTo()`
+     *
+     * The frame buffer scanned by the panel is released at the refresh finish event after it's switched away, so
+     * `acquireSwapChainBuffer()` only blocks until a buffer is actually free. A typical loop with triple buffering is:
+     *
+     * 1. `acquireSwapChainBuffer()` to get a free frame buffer
+     * 2. Draw the whole frame into it (or sync the stale areas by `utils::FrameBufferSync`)
+     * 3. `presentSwapChainBuffer()` to show it at the next refresh
+     *
+     * @param[in] mode Present mode. `FIFO` shows every presented buffer, `MAILBOX` replaces the pending buffer by the
+     *                 newly presented one, which has the lowest latency but drops frames
+     * @return `true` if successful, `false` otherwise
+     * @note This function should be called after `begin()`
+     * @note This function is only valid for RGB/MIPI-DSI bus with at least 2 frame buffers, see
+     *       `configFrameBufferNumber()`
+     * @note The frame buffer `0` is assumed to be scanned at the beginning, don't call `switchFrameBufferTo()` while
+     *       the swap chain is enabled
+     * @note The functions of the swap chain should be called from one task
+     */
+    bool enableSwapChain(utils::SwapChain::PresentMode mode = utils::SwapChain::PresentMode::FIFO);
+
+    /**
+     * @brief Disable the swap chain
+     *
+     * @return `true` if successful, `false` otherwise
+     */
+    bool disableSwapChain();
+
+    /**
+     * @brief Acquire a free frame buffer from the swap chain to draw
+     *
+     * @param[in] timeout_ms Wait timeout in milliseconds, -1 means wait forever
+     * @return Frame buffer pointer, or `nullptr` if failed or timeout
+     * @note The frame buffer should be presented by `presentSwapChainBuffer()` or given back by
+     *       `releaseSwapChainBuffer()`
+     */
+    void *acquireSwapChainBuffer(int timeout_ms = -1);
+
+    /**
+     * @brief Present an acquired frame buffer, it's shown from the next refresh
+     *
+     * @param[in] frame_buffer Frame buffer acquired by `acquireSwapChainBuffer()`
+     * @param[in] timeout_ms Wait timeout in milliseconds, -1 means wait forever. Only the `FIFO` mode waits, until
+     *                       the last presented buffer is shown
+     * @return `true` if successful, `false` otherwise
+     */
+    bool presentSwapChainBuffer(void *frame_buffer, int timeout_ms = -1);
+
+    /**
+     * @brief Give back an acquired frame buffer without presenting it
+     *
+     * @param[in] frame_buffer Frame buffer acquired by `acquireSwapChainBuffer()`
+     * @return `true` if successful, `false` otherwise
+     */
+    bool releaseSwapChainBuffer(void *frame_buffer);
+
+    /**
+     * @brief Wait until the last presented frame buffer is shown, which is the vsync of the presented frame
+     *
+     * @param[in] timeout_ms Wait timeout in milliseconds, -1 means wait forever
+     * @return `true` if successful, `false` otherwise
+     */
+    bool waitSwapChainPresented(int timeout_ms = -1);
+
+    /**
+     * @brief Get the states of the swap chain, e.g. to check the shown and dropped frames
+     *
+     * @return Pointer to the swap chain, `nullptr` if not enabled
+     */
+    const utils::SwapChain *getSwapChain() const
+    {
+        return (_swap_chain != nullptr) ? &_swap_chain->chain : nullptr;
+    }
+
     /**
      * @brief Draw color bars for testing
      *
@@ -624,6 +1035,16 @@ public:
      */
     int getFrameColorBits();
 
+    /**
+     * @brief Get the pixel format of the data sent to the LCD, decided by the color depth and the bus type
+     *
+     * The 16-bit data is byte-swapped for the SPI/QSPI/I80 bus which sends the MSB first, and the 24-bit data is in
+     * `R, G, B` order for them, while the RGB/MIPI-DSI bus takes the little-endian pixels.
+     *
+     * @return Pixel format, or `PixelFormat::MAX` if failed
+     */
+    utils::PixelFormat getFramePixelFormat();
+
     /**
      * @brief Get frame buffer by index
      *
@@ -894,6 +1315,133 @@ private:
         std::shared_ptr<StaticSemaphore_t> on_draw_bitmap_finish_sem_buffer = nullptr; /*!< Semaphore buffer */
     };
 
+    /**
+     * @brief In-flight queue of the bitmap drawings on the bus with DMA operation
+     *
+     * Every drawing pushes an item before calling `esp_lcd_panel_draw_bitmap()`, and the draw finish event pops the
+     * oldest one, since the bus always finishes the color transactions in order.
+     */
+    struct DrawBitmapQueue {
+        /**
+         * @brief In-flight drawing item
+         */
+        struct Item {
+            const uint8_t *color_data = nullptr;  /*!< Color data of the drawing */
+            bool is_async = false;                /*!< Whether queued by `drawBitmapAsync()` */
+            bool need_notify = false;             /*!< Whether `drawBitmap()` is waiting for the finish */
+        };
+
+        /**
+         * @brief Task waiting for a drawing, which is placed on its stack
+         */
+        struct Waiter {
+            DrawBitmapToken token = 0;            /*!< Token of the waited drawing */
+            SemaphoreHandle_t sem = nullptr;      /*!< Binary semaphore given when the drawing finishes */
+            Waiter *next = nullptr;               /*!< Next waiter in the list */
+        };
+
+        utils::vector<Item> buffer;               /*!< Ring buffer of the in-flight items */
+        Item *items = nullptr;                    /*!< Raw pointer of `buffer`, used in the interrupt context */
+        int depth = 0;                            /*!< Maximum number of in-flight items */
+        int head = 0;                             /*!< Index of the oldest item */
+        int num = 0;                              /*!< Number of in-flight items */
+        DrawBitmapToken submitted = 0;            /*!< Token of the latest submitted drawing */
+        DrawBitmapToken finished = 0;             /*!< Token of the latest finished drawing */
+        portMUX_TYPE lock = portMUX_INITIALIZER_UNLOCKED; /*!< Lock of the items and tokens */
+        SemaphoreHandle_t slot_sem = nullptr;     /*!< Counting semaphore of the free slots */
+        Waiter *waiters = nullptr;                /*!< List of the waiting tasks, each one is woken up separately */
+        FunctionDrawBitmapRecycleCallback on_recycle = nullptr; /*!< Buffer recycle callback */
+        void *recycle_user_data = nullptr;        /*!< User data of the buffer recycle callback */
+    };
+
+    /**
+     * @brief States of the tearing effect (TE) signal
+     */
+    struct TearingEffect {
+        static constexpr uint32_t QSPI_OPCODE_WRITE_CMD = 0x02; /*!< Opcode of the QSPI panels to write a command */
+        static constexpr int WAIT_MIN_US = 50;    /*!< Shorter waits are done by the busy loop instead of the timer */
+        static constexpr int WAIT_TIMEOUT_MS = 100; /*!< Extra timeout of the waits */
+
+        TearingEffectConfig config = {};          /*!< TE configuration */
+        utils::TearingScheduler scheduler;        /*!< Scheduler of the drawings */
+        esp_timer_handle_t start_timer = nullptr; /*!< One-shot timer to start the drawing */
+        SemaphoreHandle_t start_sem = nullptr;    /*!< Binary semaphore given by the timer */
+        bool is_isr_added = false;                /*!< Whether the GPIO ISR is added */
+        DrawBitmapToken last_token = 0;           /*!< Token of the last scheduled drawing */
+        uint32_t last_bytes = 0;                  /*!< Bytes of the last scheduled drawing, `0` if learned */
+        uint32_t last_start_us = 0;               /*!< Start time of the last scheduled drawing */
+        std::atomic<uint32_t> finish_us = 0;      /*!< Time of the latest draw finish event */
+    };
+
+    /**
+     * @brief Swap chain over the frame buffers
+     */
+    struct SwapChainContext {
+        utils::SwapChain chain;                   /*!< States of the frame buffers */
+        void *buffers[FRAME_BUFFER_MAX_NUM] = {}; /*!< Frame buffers */
+        SemaphoreHandle_t refresh_sem = nullptr;  /*!< Binary semaphore given when a buffer is shown or released */
+    };
+
+    /**
+     * @brief Provider of the lines in the RGB stream mode, which is read by the bounce buffer ISR
+     */
+    struct LineProvider {
+        FunctionLineProviderCallback callback = nullptr; /*!< Line provider callback */
+        void *user_data = nullptr;                /*!< User data of the callback */
+        utils::CompressedLineStore *store = nullptr; /*!< Line store written by the drawings, `nullptr` if not used */
+        int line_pixels = 0;                      /*!< Pixels of a line, `0` if not in the stream mode */
+        int line_bytes = 0;                       /*!< Bytes of a line, `0` if not in the stream mode */
+        portMUX_TYPE lock = portMUX_INITIALIZER_UNLOCKED; /*!< Lock of the callback and user data */
+    };
+
+    /**
+     * @brief Get the transaction queue depth of the bus
+     *
+     * @return Queue depth, `0` if the bus doesn't use DMA operation (like RGB)
+     */
+    int getBusTransQueueDepth();
+
+    /**
+     * @brief Create the in-flight queue of the bitmap drawings
+     *
+     * @return `true` if successful, `false` otherwise
+     */
+    bool createDrawBitmapQueue();
+
+    /**
+     * @brief Delete the in-flight queue of the bitmap drawings
+     */
+    void deleteDrawBitmapQueue();
+
+    /**
+     * @brief Push an item into the in-flight queue, block if the queue is full
+     *
+     * @param[in] item Item to push
+     * @param[in] timeout_ms Wait timeout for a free slot in milliseconds, -1 means wait forever
+     * @param[out] token Token of the pushed item
+     * @return `true` if successful, `false` otherwise
+     */
+    bool pushDrawBitmapQueue(const DrawBitmapQueue::Item &item, int timeout_ms, DrawBitmapToken &token);
+
+    /**
+     * @brief Cancel the latest pushed item if the drawing failed to start
+     *
+     * @param[in] token Token of the item to cancel
+     */
+    void cancelDrawBitmapQueue(DrawBitmapToken token);
+
+    /**
+     * @brief Check the area of the bitmap to draw
+     *
+     * @param[in] x_start X coordinate of the start point
+     * @param[in] y_start Y coordinate of the start point
+     * @param[in] width Width of the bitmap
+     * @param[in] height Height of the bitmap
+     * @param[in] color_data Pointer of the color data array
+     * @return `true` if valid, `false` otherwise
+     */
+    bool checkDrawBitmapArea(int x_start, int y_start, int width, int height, const uint8_t *color_data);
+
     /**
      * @brief Get device full configuration
      *
@@ -930,8 +1478,19 @@ private:
     const BusDSI::RefreshPanelFullConfig *getBusDSI_RefreshPanelFullConfig();
 #endif
 
+    uint32_t submitLatencyFrame();
+    int getSwapChainBufferIndex(void *frame_buffer);
+    bool waitSwapChainRefresh(TickType_t start_tick, int timeout_ms);
+    esp_err_t drawBitmapToPanel(int x_start, int y_start, int width, int height, const uint8_t *color_data);
+    bool beginTearingEffect();
+    bool endTearingEffect();
+    bool waitTearingEffect(int x_start, int y_start, int width, int height);
+    IRAM_ATTR static void onTearingEffect(void *arg);
+    static void onTearingEffectTimer(void *arg);
+    IRAM_ATTR void notifyLatencyTransferDone();
     IRAM_ATTR static bool onDrawBitmapFinish(void *panel_io, void *edata, void *user_ctx);
     IRAM_ATTR static bool onRefreshFinish(void *panel_io, void *edata, void *user_ctx);
+    IRAM_ATTR static bool onBounceEmpty(void *panel, void *bounce_buf, int pos_px, int len_bytes, void *user_ctx);
 
     BasicAttributes _basic_attributes = {};     /*!< Basic device attributes */
     std::shared_ptr<Bus> _bus = nullptr;        /*!< Bus interface pointer */
@@ -939,6 +1498,19 @@ private:
     State _state = State::DEINIT;               /*!< Current driver state */
     Transformation _transformation = {};        /*!< Coordinate transformation settings */
     Interruption _interruption = {};            /*!< Interrupt handling */
+    DrawBitmapQueue _draw_bitmap_queue = {};    /*!< In-flight queue of the bitmap drawings */
+    std::atomic<uint32_t> _draw_bitmap_count = 0; /*!< Number of the submitted drawings */
+    int _pixel_clock_hz = 0;                    /*!< Pixel clock set by `setPixelClockHz()`, `0` if not set */
+    utils::DirtyAreaMerger _dirty_area_merger;  /*!< Merger of the pending dirty areas */
+    uint32_t _dirty_area_overhead_px = utils::DirtyAreaMerger::TRANSFER_OVERHEAD_PX_DEFAULT;
+    utils::LatencyTracker *_latency_tracker = nullptr; /*!< Tracker of the touch-to-photon latency */
+    std::atomic<utils::FramePacer *> _frame_pacer = nullptr; /*!< Pacer of the frame rendering */
+    bool _has_refresh_event = false;            /*!< Whether the bus reports the refresh finish */
+    std::atomic<uint32_t> _last_frame_id = 0;   /*!< Sequence ID of the last drawing in the tracker */
+    LineProvider _line_provider = {};           /*!< Provider of the lines in the RGB stream mode */
+    std::shared_ptr<TearingEffect> _tearing_effect = nullptr; /*!< TE states, `nullptr` if not configured */
+    std::shared_ptr<SwapChainContext> _swap_chain = nullptr; /*!< Swap chain, `nullptr` if not enabled */
+    portMUX_TYPE _swap_chain_lock = portMUX_INITIALIZER_UNLOCKED; /*!< Lock of `_swap_chain` with the refresh ISR */
 };
 
 } // namespace esp_panel::drivers
@@ -32,6 +32,7 @@
 #include "esp_panel_lcd_st77916.hpp"
 #include "esp_panel_lcd_st77922.hpp"
 #include "esp_panel_lcd_simple.hpp"
+#include "esp_panel_lcd_virtual.hpp"
 
 namespace esp_panel::drivers {
 
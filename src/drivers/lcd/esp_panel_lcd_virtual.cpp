@@ -0,0 +1,298 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_lcd_panel_interface.h"
+#include "esp_lcd_panel_commands.h"
+#include "utils/esp_panel_utils_log.h"
+#include "esp_panel_lcd_virtual.hpp"
+
+namespace esp_panel::drivers {
+
+// *INDENT-OFF*
+const LCD::BasicBusSpecificationMap LCD_Virtual::_bus_specifications = {
+    {
+        ESP_PANEL_BUS_TYPE_VIRTUAL, BasicBusSpecification{
+            .color_bits = (1U << BasicBusSpecification::COLOR_BITS_RGB565_16) |
+                          (1U << BasicBusSpecification::COLOR_BITS_RGB666_18) |
+                          (1U << BasicBusSpecification::COLOR_BITS_RGB888_24),
+            .functions = (1U << BasicBusSpecification::FUNC_INVERT_COLOR) |
+                         (1U << BasicBusSpecification::FUNC_MIRROR_X) |
+                         (1U << BasicBusSpecification::FUNC_MIRROR_Y) |
+                         (1U << BasicBusSpecification::FUNC_SWAP_XY) |
+                         (1U << BasicBusSpecification::FUNC_GAP) |
+                         (1U << BasicBusSpecification::FUNC_DISPLAY_ON_OFF),
+        },
+    },
+};
+// *INDENT-ON*
+
+namespace {
+
+/**
+ * @brief In-memory refresh panel, the `base` must be the first member so that the handle can be casted back
+ */
+struct VirtualPanel {
+    esp_lcd_panel_t base;
+    esp_lcd_panel_io_handle_t io;
+    BusVirtual *bus;
+    int h_res;
+    int v_res;
+    int bits_per_pixel;
+    int bytes_per_pixel;
+    int x_gap;
+    int y_gap;
+    uint8_t madctl_val;     // Current value of `LCD_CMD_MADCTL` register
+    uint8_t *gram;
+    const esp_panel_lcd_vendor_init_cmd_t *init_cmds;
+    unsigned int init_cmds_size;
+};
+
+esp_err_t panel_virtual_del(esp_lcd_panel_t *panel)
+{
+    auto virtual_panel = reinterpret_cast<VirtualPanel *>(panel);
+
+    virtual_panel->bus->stopRefresh();
+    free(virtual_panel->gram);
+    free(virtual_panel);
+
+    return ESP_OK;
+}
+
+esp_err_t panel_virtual_reset(esp_lcd_panel_t *panel)
+{
+    auto virtual_panel = reinterpret_cast<VirtualPanel *>(panel);
+
+    // There is no reset pin, always perform software reset. The waiting time is skipped since nothing is powered
+    return esp_lcd_panel_io_tx_param(virtual_panel->io, LCD_CMD_SWRESET, nullptr, 0);
+}
+
+esp_err_t panel_virtual_init(esp_lcd_panel_t *panel)
+{
+    auto virtual_panel = reinterpret_cast<VirtualPanel *>(panel);
+    auto io = virtual_panel->io;
+
+    ESP_UTILS_CHECK_ERROR_RETURN(
+        esp_lcd_panel_io_tx_param(io, LCD_CMD_SLPOUT, nullptr, 0), ESP_FAIL, "Send command failed"
+    );
+    for (unsigned int i = 0; i < virtual_panel->init_cmds_size; i++) {
+        auto &cmd = virtual_panel->init_cmds[i];
+        ESP_UTILS_CHECK_ERROR_RETURN(
+            esp_lcd_panel_io_tx_param(io, cmd.cmd, cmd.data, cmd.data_bytes), ESP_FAIL, "Send command failed"
+        );
+        if ((cmd.cmd == LCD_CMD_MADCTL) && (cmd.data_bytes > 0)) {
+            virtual_panel->madctl_val = static_cast<const uint8_t *>(cmd.data)[0];
+        }
+        if (cmd.delay_ms > 0) {
+            vTaskDelay(pdMS_TO_TICKS(cmd.delay_ms));
+        }
+    }
+
+    // The RGB/MIPI-DSI bus starts to refresh the panel once the panel is initialized
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        virtual_panel->bus->startRefresh(virtual_panel->h_res, virtual_panel->v_res, virtual_panel->bits_per_pixel),
+        ESP_FAIL, "Start refresh failed"
+    );
+
+    return ESP_OK;
+}
+
+esp_err_t panel_virtual_draw_bitmap(
+    esp_lcd_panel_t *panel, int x_start, int y_start, int x_end, int y_end, const void *color_data
+)
+{
+    auto virtual_panel = reinterpret_cast<VirtualPanel *>(panel);
+    auto io = virtual_panel->io;
+    auto bytes_per_pixel = virtual_panel->bytes_per_pixel;
+
+    // Keep the pixels in GRAM before the transfer, just like the RGB/MIPI-DSI drivers copy them into frame buffer
+    if (virtual_panel->gram != nullptr) {
+        int stride = (virtual_panel->madctl_val & LCD_CMD_MV_BIT) ? virtual_panel->v_res : virtual_panel->h_res;
+        size_t line_bytes = (x_end - x_start) * bytes_per_pixel;
+        auto src = static_cast<const uint8_t *>(color_data);
+        for (int y = y_start; y < y_end; y++) {
+            memcpy(virtual_panel->gram + (y * stride + x_start) * bytes_per_pixel, src, line_bytes);
+            src += line_bytes;
+        }
+    }
+
+    x_start += virtual_panel->x_gap;
+    x_end += virtual_panel->x_gap;
+    y_start += virtual_panel->y_gap;
+    y_end += virtual_panel->y_gap;
+    uint8_t caset[] = {
+        static_cast<uint8_t>((x_start >> 8) & 0xFF), static_cast<uint8_t>(x_start & 0xFF),
+        static_cast<uint8_t>(((x_end - 1) >> 8) & 0xFF), static_cast<uint8_t>((x_end - 1) & 0xFF),
+    };
+    uint8_t raset[] = {
+        static_cast<uint8_t>((y_start >> 8) & 0xFF), static_cast<uint8_t>(y_start & 0xFF),
+        static_cast<uint8_t>(((y_end - 1) >> 8) & 0xFF), static_cast<uint8_t>((y_end - 1) & 0xFF),
+    };
+    ESP_UTILS_CHECK_ERROR_RETURN(
+        esp_lcd_panel_io_tx_param(io, LCD_CMD_CASET, caset, 4), ESP_FAIL, "Send command failed"
+    );
+    ESP_UTILS_CHECK_ERROR_RETURN(
+        esp_lcd_panel_io_tx_param(io, LCD_CMD_RASET, raset, 4), ESP_FAIL, "Send command failed"
+    );
+
+    size_t len = (x_end - x_start) * (y_end - y_start) * bytes_per_pixel;
+    return esp_lcd_panel_io_tx_color(io, LCD_CMD_RAMWR, color_data, len);
+}
+
+esp_err_t panel_virtual_invert_color(esp_lcd_panel_t *panel, bool invert_color_data)
+{
+    auto virtual_panel = reinterpret_cast<VirtualPanel *>(panel);
+
+    return esp_lcd_panel_io_tx_param(
+        virtual_panel->io, invert_color_data ? LCD_CMD_INVON : LCD_CMD_INVOFF, nullptr, 0
+    );
+}
+
+esp_err_t panel_virtual_mirror(esp_lcd_panel_t *panel, bool mirror_x, bool mirror_y)
+{
+    auto virtual_panel = reinterpret_cast<VirtualPanel *>(panel);
+
+    if (mirror_x) {
+        virtual_panel->madctl_val |= LCD_CMD_MX_BIT;
+    } else {
+        virtual_panel->madctl_val &= ~LCD_CMD_MX_BIT;
+    }
+    if (mirror_y) {
+        virtual_panel->madctl_val |= LCD_CMD_MY_BIT;
+    } else {
+        virtual_panel->madctl_val &= ~LCD_CMD_MY_BIT;
+    }
+
+    return esp_lcd_panel_io_tx_param(virtual_panel->io, LCD_CMD_MADCTL, &virtual_panel->madctl_val, 1);
+}
+
+esp_err_t panel_virtual_swap_xy(esp_lcd_panel_t *panel, bool swap_axes)
+{
+    auto virtual_panel = reinterpret_cast<VirtualPanel *>(panel);
+
+    if (swap_axes) {
+        virtual_panel->madctl_val |= LCD_CMD_MV_BIT;
+    } else {
+        virtual_panel->madctl_val &= ~LCD_CMD_MV_BIT;
+    }
+
+    return esp_lcd_panel_io_tx_param(virtual_panel->io, LCD_CMD_MADCTL, &virtual_panel->madctl_val, 1);
+}
+
+esp_err_t panel_virtual_set_gap(esp_lcd_panel_t *panel, int x_gap, int y_gap)
+{
+    auto virtual_panel = reinterpret_cast<VirtualPanel *>(panel);
+
+    virtual_panel->x_gap = x_gap;
+    virtual_panel->y_gap = y_gap;
+
+    return ESP_OK;
+}
+
+esp_err_t panel_virtual_disp_on_off(esp_lcd_panel_t *panel, bool on_off)
+{
+    auto virtual_panel = reinterpret_cast<VirtualPanel *>(panel);
+
+#if ESP_IDF_VERSION < ESP_IDF_VERSION_VAL(5, 0, 0)
+    // The `disp_off` callback passes `off` instead of `on`
+    on_off = !on_off;
+#endif
+    return esp_lcd_panel_io_tx_param(virtual_panel->io, on_off ? LCD_CMD_DISPON : LCD_CMD_DISPOFF, nullptr, 0);
+}
+
+} // namespace
+
+LCD_Virtual::~LCD_Virtual()
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_EXIT(del(), "Delete failed");
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+}
+
+bool LCD_Virtual::configVirtual_GRAM(bool en)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(!isOverState(State::INIT), false, "Should be called before `init()`");
+
+    ESP_UTILS_LOGD("Param: en(%d)", en);
+    _use_gram = en;
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool LCD_Virtual::init()
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(!isOverState(State::INIT), false, "Already initialized");
+
+    // Process the device on initialization
+    ESP_UTILS_CHECK_FALSE_RETURN(processDeviceOnInit(_bus_specifications), false, "Process device on init failed");
+
+    // Create refresh panel
+    auto device_config = getConfig().getDeviceFullConfig();
+    auto vendor_config = getConfig().getVendorFullConfig();
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        (vendor_config->hor_res > 0) && (vendor_config->ver_res > 0), false, "Invalid resolution(%dx%d)",
+        vendor_config->hor_res, vendor_config->ver_res
+    );
+
+    auto panel = static_cast<VirtualPanel *>(calloc(1, sizeof(VirtualPanel)));
+    ESP_UTILS_CHECK_NULL_RETURN(panel, false, "Create refresh panel failed");
+    panel->io = getBus()->getControlPanelHandle();
+    panel->bus = static_cast<BusVirtual *>(getBus());
+    panel->h_res = vendor_config->hor_res;
+    panel->v_res = vendor_config->ver_res;
+    panel->bits_per_pixel = device_config->bits_per_pixel;
+    panel->bytes_per_pixel = (device_config->bits_per_pixel + 7) / 8;
+    panel->init_cmds = vendor_config->init_cmds;
+    panel->init_cmds_size = vendor_config->init_cmds_size;
+    if (_use_gram) {
+        panel->gram = static_cast<uint8_t *>(calloc(panel->h_res * panel->v_res, panel->bytes_per_pixel));
+        if (panel->gram == nullptr) {
+            free(panel);
+            ESP_UTILS_CHECK_FALSE_RETURN(false, false, "Create GRAM failed");
+        }
+    }
+    panel->base.del = panel_virtual_del;
+    panel->base.reset = panel_virtual_reset;
+    panel->base.init = panel_virtual_init;
+    panel->base.draw_bitmap = panel_virtual_draw_bitmap;
+    panel->base.invert_color = panel_virtual_invert_color;
+    panel->base.set_gap = panel_virtual_set_gap;
+    panel->base.mirror = panel_virtual_mirror;
+    panel->base.swap_xy = panel_virtual_swap_xy;
+#if ESP_IDF_VERSION < ESP_IDF_VERSION_VAL(5, 0, 0)
+    panel->base.disp_off = panel_virtual_disp_on_off;
+#else
+    panel->base.disp_on_off = panel_virtual_disp_on_off;
+#endif
+    refresh_panel = &panel->base;
+    ESP_UTILS_LOGD("Create refresh panel(@%p)", refresh_panel);
+
+    setState(State::INIT);
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+const uint8_t *LCD_Virtual::getVirtualGRAM()
+{
+    ESP_UTILS_CHECK_FALSE_RETURN(isOverState(State::INIT), nullptr, "Not initialized");
+
+    return reinterpret_cast<VirtualPanel *>(refresh_panel)->gram;
+}
+
+} // namespace esp_panel::drivers
@@ -0,0 +1,99 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include "esp_panel_lcd_conf_internal.h"
+#include "esp_panel_lcd.hpp"
+
+namespace esp_panel::drivers {
+
+/**
+ * @brief LCD driver class for the virtual panel
+ *
+ * The refresh panel (`esp_lcd_panel_t`) is implemented in memory and talks to `BusVirtual` with the same command
+ * sequence as a typical MIPI-DCS controller (CASET/RASET/RAMWR), so the flush path can be measured without hardware.
+ * Optionally, the drawn pixels are kept in a GRAM buffer which can be used to verify the output.
+ *
+ * @note Only works with `BusVirtual`
+ */
+class LCD_Virtual: public LCD {
+public:
+    /**
+     * @brief Default basic attributes for virtual LCD
+     */
+    static constexpr BasicAttributes BASIC_ATTRIBUTES_DEFAULT = {
+        .name = "Virtual",
+    };
+
+    /**
+     * @brief Construct the LCD device with individual parameters
+     *
+     * @param[in] bus Virtual bus for communicating with the LCD device
+     * @param[in] width Width of the panel (horizontal, in pixels)
+     * @param[in] height Height of the panel (vertical, in pixels)
+     * @param[in] color_bits Color depth in bits per pixel (16 for RGB565, 18 for RGB666, 24 for RGB888)
+     * @param[in] rst_io Not used, only for the same signature with other LCD drivers
+     * @note This constructor uses default values for most configuration parameters. Use config*() functions to
+     *       customize
+     */
+    LCD_Virtual(Bus *bus, int width, int height, int color_bits, int rst_io = -1):
+        LCD(BASIC_ATTRIBUTES_DEFAULT, bus, width, height, color_bits, rst_io)
+    {
+    }
+
+    /**
+     * @brief Construct the LCD device with full configuration
+     *
+     * @param[in] bus Virtual bus for communicating with the LCD device
+     * @param[in] config Complete LCD configuration structure
+     */
+    LCD_Virtual(Bus *bus, const Config &config):
+        LCD(BASIC_ATTRIBUTES_DEFAULT, bus, config)
+    {
+    }
+
+    /**
+     * @brief Destroy the LCD device and free resources
+     */
+    ~LCD_Virtual() override;
+
+    /**
+     * @brief Configure whether to keep the drawn pixels in a GRAM buffer
+     *
+     * @param[in] en true: enable, false: disable
+     * @return `true` if successful, `false` otherwise
+     * @note This function should be called before `init()`
+     * @note The GRAM is allocated from the default heap with the size of `width * height * bytes_per_pixel`. The
+     *       copy costs CPU time, so keep it disabled when benchmarking the SPI/QSPI flush path
+     */
+    bool configVirtual_GRAM(bool en);
+
+    /**
+     * @brief Initialize the LCD device
+     *
+     * @return `true` if initialization successful, `false` otherwise
+     * @note This function must be called after bus interface is initialized
+     * @note Creates the in-memory refresh panel internally
+     */
+    bool init() override;
+
+    /**
+     * @brief Get the GRAM buffer which keeps the drawn pixels
+     *
+     * @return Pointer of the GRAM buffer if enabled by `configVirtual_GRAM()`, `nullptr` otherwise
+     * @note The pixels are stored in the order they were drawn, with the stride of the current frame width
+     *       (swapped when `swapXY()` is enabled)
+     */
+    const uint8_t *getVirtualGRAM();
+
+private:
+    static const BasicBusSpecificationMap _bus_specifications;
+
+    bool _use_gram = false;
+};
+
+} // namespace esp_panel::drivers
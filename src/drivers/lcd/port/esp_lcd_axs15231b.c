@@ -25,6 +25,7 @@
 #include "utils/esp_panel_utils_log.h"
 #include "esp_utils_helpers.h"
 #include "esp_panel_lcd_vendor_types.h"
+#include "esp_panel_lcd_vendor_init.h"
 
 #define LCD_OPCODE_WRITE_CMD                (0x02ULL)
 #define LCD_OPCODE_READ_CMD                 (0x0BULL)
@@ -252,6 +253,7 @@ static esp_err_t panel_axs15231b_init(esp_lcd_panel_t *panel)
     }
 
     bool is_cmd_overwritten = false;
+    esp_panel_lcd_vendor_init_seq_t init_seq = ESP_PANEL_LCD_VENDOR_INIT_SEQ_DEFAULT();
     for (int i = 0; i < init_cmds_size; i++) {
         // Check if the command has been used or conflicts with the internal
         switch (init_cmds[i].cmd) {
@@ -271,9 +273,11 @@ static esp_err_t panel_axs15231b_init(esp_lcd_panel_t *panel)
         if (is_cmd_overwritten) {
             ESP_LOGW(TAG, "The %02Xh command has been used and will be overwritten by external initialization sequence", init_cmds[i].cmd);
         }
+        esp_panel_lcd_vendor_init_seq_wait(&init_seq);
         ESP_RETURN_ON_ERROR(tx_param(axs15231b, io, init_cmds[i].cmd, init_cmds[i].data, init_cmds[i].data_bytes), TAG, "send command failed");
-        vTaskDelay(pdMS_TO_TICKS(init_cmds[i].delay_ms));
+        esp_panel_lcd_vendor_init_seq_done(&init_seq, &init_cmds[i]);
     }
+    esp_panel_lcd_vendor_init_seq_wait(&init_seq);
     ESP_LOGI(TAG, "send init commands success");
 
     return ESP_OK;
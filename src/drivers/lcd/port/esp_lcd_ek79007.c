@@ -25,6 +25,7 @@
 #include "utils/esp_panel_utils_log.h"
 #include "esp_utils_helpers.h"
 #include "esp_panel_lcd_vendor_types.h"
+#include "esp_panel_lcd_vendor_init.h"
 
 #define EK79007_PAD_CONTROL     (0xB2)
 #define EK79007_DSI_2_LANE      (0x10)
@@ -163,6 +164,7 @@ static esp_err_t panel_ek79007_send_init_cmds(ek79007_panel_t *ek79007)
         init_cmds_size = sizeof(vendor_specific_init_default) / sizeof(esp_panel_lcd_vendor_init_cmd_t);
     }
 
+    esp_panel_lcd_vendor_init_seq_t init_seq = ESP_PANEL_LCD_VENDOR_INIT_SEQ_DEFAULT();
     for (int i = 0; i < init_cmds_size; i++) {
         // Check if the command has been used or conflicts with the internal
         if (init_cmds[i].data_bytes > 0) {
@@ -184,9 +186,9 @@ static esp_err_t panel_ek79007_send_init_cmds(ek79007_panel_t *ek79007)
         }
 
         // Send command
-        ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(io, init_cmds[i].cmd, init_cmds[i].data, init_cmds[i].data_bytes), TAG, "send command failed");
-        vTaskDelay(pdMS_TO_TICKS(init_cmds[i].delay_ms));
+        ESP_RETURN_ON_ERROR(esp_panel_lcd_vendor_init_seq_send(&init_seq, io, &init_cmds[i]), TAG, "send command failed");
     }
+    esp_panel_lcd_vendor_init_seq_wait(&init_seq);
 
     ESP_LOGD(TAG, "send init commands success");
 
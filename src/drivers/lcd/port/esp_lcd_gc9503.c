@@ -26,6 +26,7 @@
 #include "utils/esp_panel_utils_log.h"
 #include "esp_utils_helpers.h"
 #include "esp_panel_lcd_vendor_types.h"
+#include "esp_panel_lcd_vendor_init.h"
 
 #define GC9503_CMD_MADCTL           (0xB1)      // Memory data access control
 #define GC9503_CMD_MADCTL_DEFAULT   (0x10)      // Default value of Memory data access control
@@ -269,6 +270,7 @@ static esp_err_t panel_gc9503_send_init_cmds(gc9503_panel_t *gc9503)
     }
 
     bool is_cmd_overwritten = false;
+    esp_panel_lcd_vendor_init_seq_t init_seq = ESP_PANEL_LCD_VENDOR_INIT_SEQ_DEFAULT();
     for (int i = 0; i < init_cmds_size; i++) {
         // Check if the command has been used or conflicts with the internal
         switch (init_cmds[i].cmd) {
@@ -290,10 +292,9 @@ static esp_err_t panel_gc9503_send_init_cmds(gc9503_panel_t *gc9503)
                      init_cmds[i].cmd);
         }
 
-        ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(io, init_cmds[i].cmd, init_cmds[i].data, init_cmds[i].data_bytes),
-                            TAG, "send command failed");
-        vTaskDelay(pdMS_TO_TICKS(init_cmds[i].delay_ms));
+        ESP_RETURN_ON_ERROR(esp_panel_lcd_vendor_init_seq_send(&init_seq, io, &init_cmds[i]), TAG, "send command failed");
     }
+    esp_panel_lcd_vendor_init_seq_wait(&init_seq);
     ESP_LOGD(TAG, "send init commands success");
 
     return ESP_OK;
@@ -26,6 +26,7 @@
 #include "utils/esp_panel_utils_log.h"
 #include "esp_utils_helpers.h"
 #include "esp_panel_lcd_vendor_types.h"
+#include "esp_panel_lcd_vendor_init.h"
 
 #define LCD_OPCODE_WRITE_CMD        (0x02ULL)
 #define LCD_OPCODE_READ_CMD         (0x03ULL)
@@ -283,6 +284,7 @@ static esp_err_t panel_gc9b71_init(esp_lcd_panel_t *panel)
         init_cmds_size = sizeof(vendor_specific_init_default) / sizeof(esp_panel_lcd_vendor_init_cmd_t);
     }
 
+    esp_panel_lcd_vendor_init_seq_t init_seq = ESP_PANEL_LCD_VENDOR_INIT_SEQ_DEFAULT();
     for (int i = 0; i < init_cmds_size; i++) {
         // Check if the command has been used or conflicts with the internal
         switch (init_cmds[i].cmd) {
@@ -303,10 +305,11 @@ static esp_err_t panel_gc9b71_init(esp_lcd_panel_t *panel)
             ESP_LOGW(TAG, "The %02Xh command has been used and will be overwritten by external initialization sequence", init_cmds[i].cmd);
         }
 
-        ESP_RETURN_ON_ERROR(tx_param(gc9b71, io, init_cmds[i].cmd, init_cmds[i].data, init_cmds[i].data_bytes), TAG,
-                            "send command failed");
-        vTaskDelay(pdMS_TO_TICKS(init_cmds[i].delay_ms));
+        esp_panel_lcd_vendor_init_seq_wait(&init_seq);
+        ESP_RETURN_ON_ERROR(tx_param(gc9b71, io, init_cmds[i].cmd, init_cmds[i].data, init_cmds[i].data_bytes), TAG, "send command failed");
+        esp_panel_lcd_vendor_init_seq_done(&init_seq, &init_cmds[i]);
     }
+    esp_panel_lcd_vendor_init_seq_wait(&init_seq);
     ESP_LOGD(TAG, "send init commands success");
 
     return ESP_OK;
@@ -25,6 +25,7 @@
 #include "utils/esp_panel_utils_log.h"
 #include "esp_utils_helpers.h"
 #include "esp_panel_lcd_vendor_types.h"
+#include "esp_panel_lcd_vendor_init.h"
 
 #define HX8399_CMD_DSI_INT0     (0xBA)
 #define HX8399_DSI_1_LANE       (0x00)
@@ -233,6 +234,7 @@ static esp_err_t panel_hx8399_init(esp_lcd_panel_t *panel)
         init_cmds_size = sizeof(vendor_specific_init_code_default) / sizeof(esp_panel_lcd_vendor_init_cmd_t);
     }
 
+    esp_panel_lcd_vendor_init_seq_t init_seq = ESP_PANEL_LCD_VENDOR_INIT_SEQ_DEFAULT();
     for (int i = 0; i < init_cmds_size; i++) {
         // Check if the command has been used or conflicts with the internal
         if (init_cmds[i].data_bytes > 0) {
@@ -258,9 +260,9 @@ static esp_err_t panel_hx8399_init(esp_lcd_panel_t *panel)
         }
 
         // Send command
-        ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(io, init_cmds[i].cmd, init_cmds[i].data, init_cmds[i].data_bytes), TAG, "send command failed");
-        vTaskDelay(pdMS_TO_TICKS(init_cmds[i].delay_ms));
+        ESP_RETURN_ON_ERROR(esp_panel_lcd_vendor_init_seq_send(&init_seq, io, &init_cmds[i]), TAG, "send command failed");
     }
+    esp_panel_lcd_vendor_init_seq_wait(&init_seq);
 
     ESP_LOGD(TAG, "send init commands success");
 
@@ -32,6 +32,7 @@
 #include "utils/esp_panel_utils_log.h"
 #include "esp_utils_helpers.h"
 #include "esp_panel_lcd_vendor_types.h"
+#include "esp_panel_lcd_vendor_init.h"
 
 #define ST77903_CMD_BPC             (0xB5)
 #define ST77903_CMD_DISCN           (0xB6)
@@ -273,6 +274,7 @@ static esp_err_t panel_st77903_rgb_send_init_cmds(st77903_panel_t *st77903)
 
     bool is_cmd_overwritten = false;
     bool is_cmd_conflicting = false;
+    esp_panel_lcd_vendor_init_seq_t init_seq = ESP_PANEL_LCD_VENDOR_INIT_SEQ_DEFAULT();
     for (int i = 0; i < init_cmds_size; i++) {
         // Check if the command has been used or conflicts with the internal
         switch (init_cmds[i].cmd) {
@@ -306,11 +308,10 @@ static esp_err_t panel_st77903_rgb_send_init_cmds(st77903_panel_t *st77903)
 
         // Only send the command if it is not conflicted
         if (!is_cmd_conflicting) {
-            ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(io, init_cmds[i].cmd, init_cmds[i].data, init_cmds[i].data_bytes),
-                                TAG, "send command failed");
-            vTaskDelay(pdMS_TO_TICKS(init_cmds[i].delay_ms));
+            ESP_RETURN_ON_ERROR(esp_panel_lcd_vendor_init_seq_send(&init_seq, io, &init_cmds[i]), TAG, "send command failed");
         }
     }
+    esp_panel_lcd_vendor_init_seq_wait(&init_seq);
     ESP_LOGD(TAG, "send init commands success");
 
     return ESP_OK;
@@ -26,6 +26,7 @@
 #include "utils/esp_panel_utils_log.h"
 #include "esp_utils_helpers.h"
 #include "esp_panel_lcd_vendor_types.h"
+#include "esp_panel_lcd_vendor_init.h"
 
 static const char *TAG = "st77922_general";
 
@@ -280,6 +281,7 @@ static esp_err_t panel_st77922_init(esp_lcd_panel_t *panel)
         init_cmds_size = sizeof(vendor_specific_init_default) / sizeof(esp_panel_lcd_vendor_init_cmd_t);
     }
 
+    esp_panel_lcd_vendor_init_seq_t init_seq = ESP_PANEL_LCD_VENDOR_INIT_SEQ_DEFAULT();
     for (int i = 0; i < init_cmds_size; i++) {
         // Check if the command has been used or conflicts with the internal
         if (is_command1_enable && (init_cmds[i].data_bytes > 0)) {
@@ -304,8 +306,9 @@ static esp_err_t panel_st77922_init(esp_lcd_panel_t *panel)
         }
 
         // Send command
+        esp_panel_lcd_vendor_init_seq_wait(&init_seq);
         ESP_RETURN_ON_ERROR(tx_param(st77922, io, init_cmds[i].cmd, init_cmds[i].data, init_cmds[i].data_bytes), TAG, "send command failed");
-        vTaskDelay(pdMS_TO_TICKS(init_cmds[i].delay_ms));
+        esp_panel_lcd_vendor_init_seq_done(&init_seq, &init_cmds[i]);
 
         // Check if the current cmd is the command1 enable cmd
         if ((init_cmds[i].cmd == ST77922_PAGE_CMD2 || init_cmds[i].cmd == ST77922_PAGE_CMD3) && init_cmds[i].data_bytes > 0) {
@@ -314,6 +317,7 @@ static esp_err_t panel_st77922_init(esp_lcd_panel_t *panel)
             is_command1_enable = true;
         }
     }
+    esp_panel_lcd_vendor_init_seq_wait(&init_seq);
     ESP_LOGD(TAG, "send init commands success");
 
     return ESP_OK;
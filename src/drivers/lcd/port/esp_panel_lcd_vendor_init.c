@@ -0,0 +1,94 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_check.h"
+#include "esp_rom_sys.h"
+#include "esp_timer.h"
+
+#include "utils/esp_panel_utils_profiler.h"
+#include "esp_panel_lcd_vendor_init.h"
+
+#define TICK_PERIOD_US  (1000000 / configTICK_RATE_HZ)
+
+static const char *TAG = "lcd_vendor_init";
+
+esp_err_t esp_panel_lcd_vendor_init_cmds_check(const esp_panel_lcd_vendor_init_cmd_t *init_cmds, size_t init_cmds_size)
+{
+    ESP_RETURN_ON_FALSE((init_cmds != NULL) || (init_cmds_size == 0), ESP_ERR_INVALID_ARG, TAG, "Invalid commands");
+
+    for (size_t i = 0; i < init_cmds_size; i++) {
+        ESP_RETURN_ON_FALSE(
+            init_cmds[i].cmd >= 0, ESP_ERR_INVALID_ARG, TAG, "Invalid code of command[%d]: %d", (int)i, init_cmds[i].cmd
+        );
+        ESP_RETURN_ON_FALSE(
+            (init_cmds[i].data_bytes == 0) || (init_cmds[i].data != NULL), ESP_ERR_INVALID_ARG, TAG,
+            "Command[%d](%02Xh) has %d bytes parameters without data", (int)i, init_cmds[i].cmd,
+            (int)init_cmds[i].data_bytes
+        );
+    }
+
+    return ESP_OK;
+}
+
+void esp_panel_lcd_vendor_init_seq_wait(esp_panel_lcd_vendor_init_seq_t *seq)
+{
+    int64_t now_us = esp_timer_get_time();
+    int64_t remain_us = seq->ready_time_us - now_us;
+    if (remain_us <= 0) {
+#if ESP_PANEL_DRIVERS_ENABLE_PROFILER
+        seq->send_time_us = now_us;
+#endif
+        return;
+    }
+
+    // `vTaskDelay(n)` returns within (n - 1, n] ticks, so it never oversleeps here
+    TickType_t ticks = remain_us / TICK_PERIOD_US;
+    if (ticks > 0) {
+        vTaskDelay(ticks);
+    }
+    while ((remain_us = seq->ready_time_us - esp_timer_get_time()) > 0) {
+        esp_rom_delay_us((uint32_t)remain_us);
+    }
+
+#if ESP_PANEL_DRIVERS_ENABLE_PROFILER
+    seq->send_time_us = esp_timer_get_time();
+    ESP_PANEL_PROFILER_ADD("lcd_cmd_delay", -1, now_us, seq->send_time_us);
+#endif
+}
+
+void esp_panel_lcd_vendor_init_seq_done(
+    esp_panel_lcd_vendor_init_seq_t *seq, const esp_panel_lcd_vendor_init_cmd_t *init_cmd
+)
+{
+    int64_t now_us = esp_timer_get_time();
+    ESP_PANEL_PROFILER_ADD("lcd_cmd", init_cmd->cmd, seq->send_time_us, now_us);
+
+    if (init_cmd->delay_ms == 0) {
+        return;
+    }
+
+    // Delays without a command in between are summed up
+    if (seq->ready_time_us < now_us) {
+        seq->ready_time_us = now_us;
+    }
+    seq->ready_time_us += (int64_t)init_cmd->delay_ms * 1000;
+}
+
+esp_err_t esp_panel_lcd_vendor_init_seq_send(
+    esp_panel_lcd_vendor_init_seq_t *seq, esp_lcd_panel_io_handle_t io, const esp_panel_lcd_vendor_init_cmd_t *init_cmd
+)
+{
+    esp_panel_lcd_vendor_init_seq_wait(seq);
+    ESP_RETURN_ON_ERROR(
+        esp_lcd_panel_io_tx_param(io, init_cmd->cmd, init_cmd->data, init_cmd->data_bytes), TAG,
+        "Send command(%02Xh) failed", init_cmd->cmd
+    );
+    esp_panel_lcd_vendor_init_seq_done(seq, init_cmd);
+
+    return ESP_OK;
+}
@@ -0,0 +1,95 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "esp_err.h"
+#include "esp_lcd_panel_io.h"
+#include "esp_panel_lcd_vendor_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Sequencer of the LCD vendor initialization commands
+ *
+ * The delay after a command is recorded as the time when the next command can be sent instead of being waited
+ * immediately, so:
+ *  - Consecutive commands without delay are sent back-to-back, without yielding to the scheduler
+ *  - Consecutive delays are summed up into one wait
+ *  - The wait is precise to microseconds, instead of being rounded down to the tick period by `pdMS_TO_TICKS()`
+ *
+ * The usage of each command is `esp_panel_lcd_vendor_init_seq_wait()` -> send the command ->
+ * `esp_panel_lcd_vendor_init_seq_done()`, or `esp_panel_lcd_vendor_init_seq_send()` for all of them. Call
+ * `esp_panel_lcd_vendor_init_seq_wait()` again after the last command.
+ *
+ * When the profiler is enabled, each command and each wait are recorded.
+ */
+typedef struct {
+    int64_t ready_time_us;  /*!< Time when the next command can be sent, in `esp_timer_get_time()` microseconds */
+    int64_t send_time_us;   /*!< Time when the current command starts to be sent, only used by the profiler */
+} esp_panel_lcd_vendor_init_seq_t;
+
+/**
+ * @brief Default initializer of the sequencer
+ */
+#define ESP_PANEL_LCD_VENDOR_INIT_SEQ_DEFAULT() \
+    {                                           \
+        .ready_time_us = 0,                     \
+        .send_time_us = 0,                      \
+    }
+
+/**
+ * @brief Check the initialization commands before sending any of them
+ *
+ * @param[in] init_cmds      Initialization commands
+ * @param[in] init_cmds_size Number of the commands
+ *
+ * @return
+ *      - ESP_OK: Success
+ *      - ESP_ERR_INVALID_ARG: A command has a negative code, or has parameters without data
+ */
+esp_err_t esp_panel_lcd_vendor_init_cmds_check(const esp_panel_lcd_vendor_init_cmd_t *init_cmds, size_t init_cmds_size);
+
+/**
+ * @brief Wait until the delay of the previous commands is elapsed
+ *
+ * The whole ticks are slept, and the rest is busy waited.
+ *
+ * @param[in] seq Sequencer
+ */
+void esp_panel_lcd_vendor_init_seq_wait(esp_panel_lcd_vendor_init_seq_t *seq);
+
+/**
+ * @brief Mark a command as sent and add its delay before the next command
+ *
+ * @param[in] seq      Sequencer
+ * @param[in] init_cmd Sent initialization command
+ */
+void esp_panel_lcd_vendor_init_seq_done(
+    esp_panel_lcd_vendor_init_seq_t *seq, const esp_panel_lcd_vendor_init_cmd_t *init_cmd
+);
+
+/**
+ * @brief Wait for the previous delay, send a command by `esp_lcd_panel_io_tx_param()` and add its delay
+ *
+ * @param[in] seq      Sequencer
+ * @param[in] io       LCD panel IO handle
+ * @param[in] init_cmd Initialization command
+ *
+ * @return
+ *      - ESP_OK: Success
+ *      - Others: Error codes of `esp_lcd_panel_io_tx_param()`
+ */
+esp_err_t esp_panel_lcd_vendor_init_seq_send(
+    esp_panel_lcd_vendor_init_seq_t *seq, esp_lcd_panel_io_handle_t io, const esp_panel_lcd_vendor_init_cmd_t *init_cmd
+);
+
+#ifdef __cplusplus
+}
+#endif
@@ -4,7 +4,10 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <chrono>
+#include "esp_timer.h"
 #include "utils/esp_panel_utils_log.h"
+#include "utils/esp_panel_utils_thread.hpp"
 #include "esp_panel_touch.hpp"
 
 namespace esp_panel::drivers {
@@ -199,6 +202,8 @@ bool Touch::del()
 {
     ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
 
+    ESP_UTILS_CHECK_FALSE_RETURN(stopSampling(), false, "Stop sampling failed");
+
     if (touch_panel != nullptr) {
         ESP_UTILS_CHECK_ERROR_RETURN(
             esp_lcd_touch_del(touch_panel), false, "Delete touch panel(@%p) failed", touch_panel
@@ -211,6 +216,7 @@ bool Touch::del()
     _points.clear();
     _buttons.clear();
     _interruption = nullptr;
+    _filter = nullptr;
 
     setState(State::DEINIT);
 
@@ -235,6 +241,100 @@ bool Touch::attachInterruptCallback(FunctionInterruptCallback callback, void *us
     return true;
 }
 
+bool Touch::attachFilter(const utils::TouchFilter::Config &config)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(isOverState(State::INIT), false, "Not initialized");
+
+    ESP_UTILS_LOGD(
+        "Param: median_window(%d), smooth_weight(%d), dead_zone(%d), prediction(%d), prediction_ms(%d)",
+        config.median_window, config.smooth_weight, config.dead_zone, static_cast<int>(config.prediction),
+        config.prediction_ms
+    );
+    auto filter_config = config;
+    // Clamp the outputs to the panel by default, since the prediction may overshoot
+    if ((filter_config.x_max == 0) && (filter_config.y_max == 0)) {
+        auto &device_config = getDeviceFullConfig();
+        filter_config.x_max = _transformation.swap_xy ? device_config.y_max : device_config.x_max;
+        filter_config.y_max = _transformation.swap_xy ? device_config.x_max : device_config.y_max;
+    }
+
+    std::shared_ptr<utils::TouchFilter> filter = nullptr;
+    ESP_UTILS_CHECK_EXCEPTION_RETURN(
+        filter = utils::make_shared<utils::TouchFilter>(), false, "Create filter failed"
+    );
+    ESP_UTILS_CHECK_FALSE_RETURN(filter->setConfig(filter_config), false, "Invalid filter config");
+
+    std::lock_guard lock(_resource_mutex);
+    _filter = filter;
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool Touch::detachFilter()
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    std::lock_guard lock(_resource_mutex);
+    _filter = nullptr;
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool Touch::enterSleep()
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(isOverState(State::BEGIN), false, "Not begun");
+    ESP_UTILS_CHECK_FALSE_RETURN(isSleepSupported(), false, "Sleep mode is not supported");
+
+    if (isSleeping()) {
+        ESP_UTILS_LOGD("Already sleeping");
+        goto end;
+    }
+
+    // Set the flag first, so the reads won't access the controller after it sleeps
+    _is_sleeping = true;
+    if (esp_lcd_touch_enter_sleep(touch_panel) != ESP_OK) {
+        _is_sleeping = false;
+        ESP_UTILS_CHECK_FALSE_RETURN(false, false, "Enter sleep failed");
+    }
+
+end:
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool Touch::exitSleep()
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(isOverState(State::BEGIN), false, "Not begun");
+
+    if (!isSleeping()) {
+        ESP_UTILS_LOGD("Not sleeping");
+        goto end;
+    }
+
+    ESP_UTILS_CHECK_ERROR_RETURN(esp_lcd_touch_exit_sleep(touch_panel), false, "Exit sleep failed");
+    // Drop the interrupt raised by the wakeup, otherwise a stale frame may be read
+    if (isInterruptEnabled()) {
+        xSemaphoreTake(_interruption->on_active_sem, 0);
+    }
+    _is_sleeping = false;
+
+end:
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
 bool Touch::swapXY(bool en)
 {
     ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
@@ -288,7 +388,19 @@ bool Touch::readRawData(int points_num, int buttons_num, int timeout_ms)
 
     ESP_UTILS_LOGD("Param: points_num(%d), buttons_num(%d), timeout_ms(%d)", points_num, buttons_num, timeout_ms);
 
+    // The data is kept up to date by the sampling task
+    if (isSampling()) {
+        ESP_UTILS_LOGD("Use the data of the sampling task");
+        return true;
+    }
+
+    if (isSleeping()) {
+        ESP_UTILS_LOGD("Sleeping, keep the last data");
+        return true;
+    }
+
     // Wait for the interruption if it is enabled, then read the raw data
+    int64_t timestamp_us = -1;
     if (isInterruptEnabled()  && (timeout_ms != 0)) {
         ESP_UTILS_LOGD("Wait for interruption");
         BaseType_t timeout_ticks = (timeout_ms < 0) ? portMAX_DELAY : pdMS_TO_TICKS(timeout_ms);
@@ -296,13 +408,18 @@ bool Touch::readRawData(int points_num, int buttons_num, int timeout_ms)
             ESP_UTILS_LOGD("Wait timeout");
             return true;
         }
+        // Tag the report with the time of the interrupt, which is closer to the touch than the read
+        timestamp_us = _interruption->active_time_us;
     }
 
     // Read the raw data
+    if (timestamp_us < 0) {
+        timestamp_us = esp_timer_get_time();
+    }
     ESP_UTILS_CHECK_ERROR_RETURN(esp_lcd_touch_read_data(touch_panel), false, "Read data failed");
 
     // Get the points
-    ESP_UTILS_CHECK_FALSE_RETURN(readRawDataPoints(points_num), false, "Read points failed");
+    ESP_UTILS_CHECK_FALSE_RETURN(readRawDataPoints(points_num, timestamp_us), false, "Read points failed");
 
 #if CONFIG_ESP_LCD_TOUCH_MAX_BUTTONS > 0
     // Get the buttons
@@ -314,6 +431,93 @@ bool Touch::readRawData(int points_num, int buttons_num, int timeout_ms)
     return true;
 }
 
+bool Touch::startSampling(const SamplingConfig &config)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(isOverState(State::BEGIN), false, "Not begun");
+    ESP_UTILS_CHECK_FALSE_RETURN(!isSampling(), false, "Already sampling");
+
+    ESP_UTILS_LOGD(
+        "Param: task_name(%s), task_priority(%d), task_stack_size(%d), task_core_id(%d), poll_interval_ms(%d)",
+        config.task_name, config.task_priority, config.task_stack_size, config.task_core_id, config.poll_interval_ms
+    );
+    ESP_UTILS_CHECK_FALSE_RETURN(
+        isInterruptEnabled() || (config.poll_interval_ms > 0), false, "Invalid poll interval"
+    );
+
+    std::shared_ptr<Sampling> sampling = nullptr;
+    ESP_UTILS_CHECK_EXCEPTION_RETURN(
+        sampling = utils::make_shared<Sampling>(), false, "Create sampling failed"
+    );
+    sampling->config = config;
+
+    // Drop the interrupt before sampling, otherwise the first frame may be stale
+    if (isInterruptEnabled()) {
+        xSemaphoreTake(_interruption->on_active_sem, 0);
+    }
+
+    {
+        utils::ThreadConfigGuard thread_config_guard({
+            .name = config.task_name,
+            .priority = config.task_priority,
+            .stack_size = config.task_stack_size,
+            .core_id = config.task_core_id,
+        });
+        ESP_UTILS_CHECK_EXCEPTION_RETURN(
+            sampling->thread = std::thread(&Touch::runSampling, this, std::ref(*sampling)), false,
+            "Create sampling thread failed"
+        );
+    }
+
+    _sampling = sampling;
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool Touch::stopSampling()
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    if (_sampling == nullptr) {
+        ESP_UTILS_LOGD("Not sampling");
+        return true;
+    }
+
+    // The task checks the flag at least every `THREAD_CHECK_STOP_INTERVAL_MS` when waiting for the interrupt
+    _sampling->is_stop = true;
+    if (_sampling->thread.joinable()) {
+        _sampling->thread.join();
+    }
+    ESP_UTILS_LOGD("Sampling stopped, dropped %d frames", static_cast<int>(_sampling->dropped_num.load()));
+    _sampling = nullptr;
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+int Touch::readFrames(TouchFrame frames[], int num)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(isSampling(), -1, "Not sampling");
+
+    ESP_UTILS_LOGD("Param: frames(@%p), num(%d)", frames, num);
+    ESP_UTILS_CHECK_FALSE_RETURN((num == 0) || (frames != nullptr), -1, "Invalid frames or num");
+
+    int i = 0;
+    while ((i < num) && _sampling->frames.pop(frames[i])) {
+        i++;
+    }
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return i;
+}
+
 int Touch::getPoints(TouchPoint points[], uint8_t num)
 {
     ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
@@ -524,6 +728,32 @@ int Touch::readButtonState(uint8_t index, int timeout_ms)
     return ret_state;
 }
 
+bool Touch::getBusStats(esp_lcd_touch_stats_t &stats) const
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(isOverState(State::BEGIN), false, "Not begun");
+
+    ESP_UTILS_CHECK_ERROR_RETURN(esp_lcd_touch_get_stats(touch_panel, &stats), false, "Get stats failed");
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool Touch::resetBusStats()
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(isOverState(State::BEGIN), false, "Not begun");
+
+    ESP_UTILS_CHECK_ERROR_RETURN(esp_lcd_touch_reset_stats(touch_panel), false, "Reset stats failed");
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
 bool Touch::isInterruptEnabled() const
 {
     if (std::holds_alternative<DeviceFullConfig>(_config.device)) {
@@ -546,11 +776,11 @@ Touch::DeviceFullConfig &Touch::getDeviceFullConfig()
     return std::get<DeviceFullConfig>(_config.device);
 }
 
-bool Touch::readRawDataPoints(int points_num)
+bool Touch::readRawDataPoints(int points_num, int64_t timestamp_us)
 {
     ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
 
-    ESP_UTILS_LOGD("Param: points_num(%d)", points_num);
+    ESP_UTILS_LOGD("Param: points_num(%d), timestamp_us(%lld)", points_num, static_cast<long long>(timestamp_us));
 
     // If less than 0, use the default points number
     if (points_num < 0) {
@@ -580,6 +810,13 @@ bool Touch::readRawDataPoints(int points_num)
     // Get the point coordinates from the raw data
     esp_lcd_touch_get_coordinates(touch_panel, x_buf, y_buf, strength_buf, &ret_points_num, points_num);
     ESP_UTILS_LOGD("Get %d points number", ret_points_num);
+    if (ret_points_num > 0) {
+        _last_touch_time_us = timestamp_us;
+        auto tracker = _latency_tracker.load();
+        if (tracker != nullptr) {
+            tracker->notifyTouch(static_cast<uint32_t>(timestamp_us));
+        }
+    }
 
     // Update the points
     std::unique_lock lock(_resource_mutex);
@@ -587,6 +824,19 @@ bool Touch::readRawDataPoints(int points_num)
     for (int i = 0; i < ret_points_num; i++) {
         _points.emplace_back(static_cast<int>(x_buf[i]), static_cast<int>(y_buf[i]), static_cast<int>(strength_buf[i]));
     }
+    if (_filter != nullptr) {
+        int filter_x[POINTS_MAX_NUM] = {};
+        int filter_y[POINTS_MAX_NUM] = {};
+        for (int i = 0; i < ret_points_num; i++) {
+            filter_x[i] = _points[i].x;
+            filter_y[i] = _points[i].y;
+        }
+        _filter->process(filter_x, filter_y, ret_points_num, timestamp_us);
+        for (int i = 0; i < ret_points_num; i++) {
+            _points[i].x = filter_x[i];
+            _points[i].y = filter_y[i];
+        }
+    }
     lock.unlock();
 
 #if ESP_UTILS_CONF_LOG_LEVEL == ESP_UTILS_LOG_LEVEL_DEBUG
@@ -655,6 +905,78 @@ bool Touch::readRawDataButtons(int buttons_num)
     return true;
 }
 
+bool Touch::readSamplingFrame(Sampling &sampling, int64_t timestamp_us)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    // Read the raw data
+    ESP_UTILS_CHECK_ERROR_RETURN(esp_lcd_touch_read_data(touch_panel), false, "Read data failed");
+    ESP_UTILS_CHECK_FALSE_RETURN(readRawDataPoints(-1, timestamp_us), false, "Read points failed");
+#if CONFIG_ESP_LCD_TOUCH_MAX_BUTTONS > 0
+    ESP_UTILS_CHECK_FALSE_RETURN(readRawDataButtons(-1), false, "Read buttons failed");
+#endif
+
+    TouchFrame frame = {};
+    frame.timestamp_us = timestamp_us;
+    std::unique_lock lock(_resource_mutex);
+    for (auto &point : _points) {
+        if (frame.points_num >= POINTS_MAX_NUM) {
+            break;
+        }
+        frame.points[frame.points_num++] = point;
+    }
+    lock.unlock();
+
+    // Only keep the first report after a release, the followings are the same
+    if ((frame.points_num == 0) && (sampling.last_points_num == 0)) {
+        return true;
+    }
+    sampling.last_points_num = frame.points_num;
+
+    frame.sequence = sampling.sequence++;
+    if (!sampling.frames.push(frame)) {
+        ESP_UTILS_LOGD("Ring buffer is full, drop frame(%d)", static_cast<int>(frame.sequence));
+        sampling.dropped_num++;
+    }
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+void Touch::runSampling(Sampling &sampling)
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_LOGD("Sampling task start");
+
+    while (!sampling.is_stop) {
+        int64_t timestamp_us = 0;
+        if (isInterruptEnabled()) {
+            if (xSemaphoreTake(
+                        _interruption->on_active_sem, pdMS_TO_TICKS(THREAD_CHECK_STOP_INTERVAL_MS)
+                    ) != pdTRUE) {
+                continue;
+            }
+            // The semaphore orders the time written by the interrupt before this read
+            timestamp_us = _interruption->active_time_us;
+        } else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(sampling.config.poll_interval_ms));
+            timestamp_us = esp_timer_get_time();
+        }
+        if (isSleeping()) {
+            continue;
+        }
+        if (!readSamplingFrame(sampling, timestamp_us)) {
+            ESP_UTILS_LOGE("Read sampling frame failed");
+        }
+    }
+
+    ESP_UTILS_LOGD("Sampling task stop");
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+}
+
 void Touch::onInterruptActive(PanelHandle panel)
 {
     if ((panel == nullptr) || (panel->config.user_data == nullptr)) {
@@ -671,6 +993,8 @@ void Touch::onInterruptActive(PanelHandle panel)
         return;
     }
 
+    interruption->active_time_us = esp_timer_get_time();
+
     BaseType_t need_yield = pdFALSE;
     if (interruption->on_active_callback != nullptr) {
         need_yield = interruption->on_active_callback(interruption->data.user_data) ? pdTRUE : need_yield;
@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <thread>
 #include <variant>
 #include <vector>
@@ -14,6 +16,9 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/semphr.h"
 #include "utils/esp_panel_utils_cxx.hpp"
+#include "utils/esp_panel_utils_latency.hpp"
+#include "utils/esp_panel_utils_ring_buffer.hpp"
+#include "utils/esp_panel_utils_touch_filter.hpp"
 #include "drivers/bus/esp_panel_bus_factory.hpp"
 #include "port/esp_lcd_touch.h"
 #include "esp_panel_touch_conf_internal.h"
@@ -66,6 +71,18 @@ struct TouchPoint {
  */
 using TouchButton = std::pair<int, uint8_t>;
 
+/**
+ * @brief Touch frame data structure
+ *
+ * Contains a timestamped snapshot of the touch points, which is produced by the sampling task
+ */
+struct TouchFrame {
+    int64_t timestamp_us = 0;   /*!< Time of the report in microseconds, from the interrupt if it is enabled */
+    uint32_t sequence = 0;      /*!< Sequence number of the frame, a gap means some frames are dropped */
+    int points_num = 0;         /*!< Number of the valid points */
+    std::array<TouchPoint, ESP_PANEL_DRIVERS_TOUCH_MAX_POINTS> points = {}; /*!< Touch points */
+};
+
 /**
  * @brief Base class for all touch screen devices
  *
@@ -83,6 +100,11 @@ public:
     static constexpr int POINTS_MAX_NUM = ESP_PANEL_DRIVERS_TOUCH_MAX_POINTS;
     static constexpr int BUTTONS_MAX_NUM = ESP_PANEL_DRIVERS_TOUCH_MAX_BUTTONS;
 
+    /**
+     * @brief Number of the frames buffered by the sampling task, should be a power of 2
+     */
+    static constexpr int SAMPLING_FRAMES_NUM = 16;
+
     /**
      * @brief Panel handle type definition
      */
@@ -159,6 +181,17 @@ public:
         bool mirror_y = false;    /*!< Mirror Y coordinate */
     };
 
+    /**
+     * @brief Configuration structure for the sampling task
+     */
+    struct SamplingConfig {
+        const char *task_name = "touch_sampling";   /*!< Name of the task */
+        int task_priority = 5;                      /*!< Priority of the task */
+        int task_stack_size = 4 * 1024;             /*!< Stack size of the task in bytes */
+        int task_core_id = -1;                      /*!< Core to pin the task, -1 means no affinity */
+        int poll_interval_ms = 10;                  /*!< Polling interval, only used if interrupt is disabled */
+    };
+
     /**
      * @brief The driver state enumeration
      */
@@ -276,6 +309,47 @@ public:
      */
     bool attachInterruptCallback(FunctionInterruptCallback callback, void *user_data = nullptr);
 
+    /**
+     * @brief Attach a filter pipeline to the touch points
+     *
+     * The points read afterwards are passed through the median, smoothing, dead zone and prediction stages enabled
+     * by the configuration. Only the first `utils::TouchFilter::SLOTS_MAX` points are filtered.
+     *
+     * @param[in] config Filter configuration, if both `x_max` and `y_max` are `0`, they are set to the panel size
+     *                   under the current transformation
+     * @return `true` if successful, `false` otherwise
+     *
+     * @note This function should be called after `init()`, and after `swapXY()` if the panel size is used
+     */
+    bool attachFilter(const utils::TouchFilter::Config &config);
+
+    /**
+     * @brief Detach the filter pipeline, the points are not filtered afterwards
+     *
+     * @return `true` if successful, `false` otherwise
+     */
+    bool detachFilter();
+
+    /**
+     * @brief Put the touch controller into the sleep mode
+     *
+     * @return `true` if successful, `false` otherwise
+     *
+     * @note This function should be called after `begin()`
+     * @note While sleeping, `readRawData()` and the sampling task don't access the controller, and the points are
+     *       kept as the last read
+     */
+    bool enterSleep();
+
+    /**
+     * @brief Wake up the touch controller from the sleep mode
+     *
+     * @return `true` if successful, `false` otherwise
+     *
+     * @note This function should be called after `begin()`
+     */
+    bool exitSleep();
+
     /**
      * @brief Swap X and Y coordinates
      *
@@ -320,6 +394,50 @@ public:
      */
     bool readRawData(int points_num, int max_buttons_num, int timeout_ms);
 
+    /**
+     * @brief Start the background sampling task
+     *
+     * The task is woken by the interrupt (or polls the device if interrupt is disabled), reads the device and pushes
+     * a timestamped frame into a lock-free ring buffer for each report, so no report is lost between two reads of
+     * the consumer. The reports without points are skipped except the first one after a release.
+     *
+     * @param[in] config Sampling task configuration
+     * @return `true` if successful, `false` otherwise
+     *
+     * @note This function should be called after `begin()`
+     * @note While sampling, `readRawData()` and the read functions return the latest data updated by the task
+     *       immediately, without accessing the device
+     */
+    bool startSampling(const SamplingConfig &config);
+
+    /**
+     * @brief Start the background sampling task with the default configuration
+     *
+     * @return `true` if successful, `false` otherwise
+     */
+    bool startSampling()
+    {
+        return startSampling(SamplingConfig());
+    }
+
+    /**
+     * @brief Stop the background sampling task and drop the buffered frames
+     *
+     * @return `true` if successful, `false` otherwise
+     */
+    bool stopSampling();
+
+    /**
+     * @brief Pop the buffered frames in order
+     *
+     * @param[out] frames Buffer to store frames
+     * @param[in] num Maximum number of frames to store
+     * @return Number of frames read if successful, -1 on failure
+     *
+     * @note This function should be called after `startSampling()`, and only from one task at a time
+     */
+    int readFrames(TouchFrame frames[], int num);
+
     /**
      * @brief Get touch points from raw data
      *
@@ -466,6 +584,27 @@ public:
      */
     int readButtonState(uint8_t index, int timeout_ms);
 
+    /**
+     * @brief Get the counters of the bus transactions, which are used to measure the cost of each poll
+     *
+     * @param[out] stats Counters since the device is created or the last `resetBusStats()`
+     * @return `true` if successful, `false` otherwise
+     *
+     * @note This function should be called after `begin()`
+     * @note The counters include the transactions of `begin()`, call `resetBusStats()` before measuring
+     * @note The transactions of each poll is `stats.transactions / stats.polls`
+     */
+    bool getBusStats(esp_lcd_touch_stats_t &stats) const;
+
+    /**
+     * @brief Reset the counters of the bus transactions
+     *
+     * @return `true` if successful, `false` otherwise
+     *
+     * @note This function should be called after `begin()`
+     */
+    bool resetBusStats();
+
     /**
      * @brief Reset touch points data
      */
@@ -500,6 +639,71 @@ public:
      */
     bool isInterruptEnabled() const;
 
+    /**
+     * @brief Check if the sampling task is running
+     *
+     * @return `true` if running, `false` otherwise
+     */
+    bool isSampling() const
+    {
+        return (_sampling != nullptr);
+    }
+
+    /**
+     * @brief Check if the controller supports the sleep mode
+     *
+     * @return `true` if supported, `false` otherwise
+     */
+    bool isSleepSupported() const
+    {
+        return (touch_panel != nullptr) && (touch_panel->enter_sleep != nullptr) &&
+               (touch_panel->exit_sleep != nullptr);
+    }
+
+    /**
+     * @brief Check if the controller is in the sleep mode
+     *
+     * @return `true` if sleeping, `false` otherwise
+     */
+    bool isSleeping() const
+    {
+        return _is_sleeping;
+    }
+
+    /**
+     * @brief Get the time of the last report with at least one point, from `readRawData()` or the sampling task
+     *
+     * @return Time in microseconds of `esp_timer_get_time()`, `-1` if never touched
+     */
+    int64_t getLastTouchTimeUs() const
+    {
+        return _last_touch_time_us;
+    }
+
+    /**
+     * @brief Attach a tracker of the touch-to-photon latency
+     *
+     * Each report with at least one point is notified to the tracker with its timestamp, which is the time of the
+     * interrupt if it is enabled, or the time of the read otherwise.
+     *
+     * @param[in] tracker Pointer to the tracker, `nullptr` to detach. It should be valid until detached
+     * @note Usually the same tracker is attached to the LCD by `LCD::attachLatencyTracker()`
+     */
+    void attachLatencyTracker(utils::LatencyTracker *tracker)
+    {
+        _latency_tracker = tracker;
+    }
+
+    /**
+     * @brief Get the number of the frames dropped because the ring buffer is full
+     *
+     * @return Number of the dropped frames since `startSampling()`
+     */
+    uint32_t getSamplingDroppedNum() const
+    {
+        return (_sampling != nullptr) ? _sampling->dropped_num.load() : 0;
+    }
+
     /**
      * @brief Get touch basic attributes
      *
@@ -701,11 +905,27 @@ private:
         FunctionInterruptCallback on_active_callback = nullptr; /*!< Interrupt callback function */
         SemaphoreHandle_t on_active_sem = nullptr;              /*!< Semaphore for interrupt sync */
         StaticSemaphore_t on_active_sem_buffer = {};            /*!< Static buffer for semaphore */
+        volatile int64_t active_time_us = 0;                    /*!< Time of the last interrupt */
+    };
+
+    /**
+     * @brief Sampling task structure
+     */
+    struct Sampling {
+        SamplingConfig config = {};                             /*!< Task configuration */
+        std::thread thread;                                     /*!< Task thread */
+        std::atomic<bool> is_stop = false;                      /*!< Flag to stop the task */
+        std::atomic<uint32_t> dropped_num = 0;                  /*!< Number of the dropped frames */
+        uint32_t sequence = 0;                                  /*!< Sequence number of the next frame */
+        int last_points_num = 0;                                /*!< Number of the points in the last frame */
+        utils::RingBuffer<TouchFrame, SAMPLING_FRAMES_NUM> frames; /*!< Frames from the task to the consumer */
     };
 
     DeviceFullConfig &getDeviceFullConfig();
-    bool readRawDataPoints(int points_num);
+    bool readRawDataPoints(int points_num, int64_t timestamp_us);
     bool readRawDataButtons(int max_buttons_num);
+    bool readSamplingFrame(Sampling &sampling, int64_t timestamp_us);
+    void runSampling(Sampling &sampling);
     static void onInterruptActive(PanelHandle handle);
 
     BasicAttributes _basic_attributes = {};                 /*!< Basic device attributes */
@@ -718,6 +938,11 @@ private:
     utils::vector<TouchPoint> _points;                      /*!< Touch points buffer */
     utils::vector<TouchButton> _buttons;                    /*!< Touch buttons buffer */
     std::shared_ptr<Interruption> _interruption = nullptr;  /*!< Interrupt handling */
+    std::shared_ptr<Sampling> _sampling = nullptr;          /*!< Background sampling */
+    std::shared_ptr<utils::TouchFilter> _filter = nullptr;  /*!< Filter of the touch points */
+    std::atomic<bool> _is_sleeping = false;                 /*!< Whether the controller is sleeping */
+    std::atomic<int64_t> _last_touch_time_us = -1;          /*!< Time of the last report with points */
+    std::atomic<utils::LatencyTracker *> _latency_tracker = nullptr; /*!< Tracker of the touch-to-photon latency */
 };
 
 } // namespace esp_panel::drivers
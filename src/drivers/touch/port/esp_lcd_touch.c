@@ -5,6 +5,7 @@
  */
 
 #include <stdlib.h>
+#include <string.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "driver/gpio.h"
@@ -55,6 +56,10 @@ esp_err_t esp_lcd_touch_read_data(esp_lcd_touch_handle_t tp)
     assert(tp != NULL);
     assert(tp->read_data != NULL);
 
+    portENTER_CRITICAL(&tp->data.lock);
+    tp->stats.polls++;
+    portEXIT_CRITICAL(&tp->data.lock);
+
     return tp->read_data(tp);
 }
 
@@ -264,3 +269,50 @@ esp_err_t esp_lcd_touch_register_interrupt_callback_with_data(esp_lcd_touch_hand
     tp->config.user_data = user_data;
     return esp_lcd_touch_register_interrupt_callback(tp, callback);
 }
+
+esp_err_t esp_lcd_touch_io_rx_param(esp_lcd_touch_handle_t tp, int reg, void *data, size_t len)
+{
+    assert(tp != NULL);
+
+    portENTER_CRITICAL(&tp->data.lock);
+    tp->stats.transactions++;
+    tp->stats.bytes += len;
+    portEXIT_CRITICAL(&tp->data.lock);
+
+    return esp_lcd_panel_io_rx_param(tp->io, reg, data, len);
+}
+
+esp_err_t esp_lcd_touch_io_tx_param(esp_lcd_touch_handle_t tp, int reg, const void *data, size_t len)
+{
+    assert(tp != NULL);
+
+    portENTER_CRITICAL(&tp->data.lock);
+    tp->stats.transactions++;
+    tp->stats.bytes += len;
+    portEXIT_CRITICAL(&tp->data.lock);
+
+    return esp_lcd_panel_io_tx_param(tp->io, reg, data, len);
+}
+
+esp_err_t esp_lcd_touch_get_stats(esp_lcd_touch_handle_t tp, esp_lcd_touch_stats_t *stats)
+{
+    assert(tp != NULL);
+    assert(stats != NULL);
+
+    portENTER_CRITICAL(&tp->data.lock);
+    *stats = tp->stats;
+    portEXIT_CRITICAL(&tp->data.lock);
+
+    return ESP_OK;
+}
+
+esp_err_t esp_lcd_touch_reset_stats(esp_lcd_touch_handle_t tp)
+{
+    assert(tp != NULL);
+
+    portENTER_CRITICAL(&tp->data.lock);
+    memset(&tp->stats, 0, sizeof(tp->stats));
+    portEXIT_CRITICAL(&tp->data.lock);
+
+    return ESP_OK;
+}
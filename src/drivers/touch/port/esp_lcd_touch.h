@@ -97,6 +97,16 @@ typedef struct {
     portMUX_TYPE lock; /*!< Lock for read/write */
 } esp_lcd_touch_data_t;
 
+/**
+ * @brief Counters of the bus transactions, used to measure the cost of each poll
+ *
+ */
+typedef struct {
+    uint32_t polls;         /*!< Count of `esp_lcd_touch_read_data()` calls */
+    uint32_t transactions;  /*!< Count of transactions by `esp_lcd_touch_io_rx_param()` and `_tx_param()` */
+    uint32_t bytes;         /*!< Count of parameter bytes of the transactions, excluding the address and register */
+} esp_lcd_touch_stats_t;
+
 /**
  * @brief Declare of Touch Type
  *
@@ -262,6 +272,11 @@ struct esp_lcd_touch_s {
      * @brief Data structure
      */
     esp_lcd_touch_data_t data;
+
+    /**
+     * @brief Counters of the bus transactions, protected by the lock of `data`
+     */
+    esp_lcd_touch_stats_t stats;
 };
 
 /**
@@ -433,6 +448,56 @@ esp_err_t esp_lcd_touch_enter_sleep(esp_lcd_touch_handle_t tp);
  */
 esp_err_t esp_lcd_touch_exit_sleep(esp_lcd_touch_handle_t tp);
 
+/**
+ * @brief Read parameters from touch controller and count the transaction
+ *
+ * @note Drivers should use this function instead of `esp_lcd_panel_io_rx_param()`, so the cost of each poll can be
+ *       got by `esp_lcd_touch_get_stats()`.
+ *
+ * @param tp: Touch handler
+ * @param reg: Register to read, `-1` if no register
+ * @param data: Buffer to store the parameters
+ * @param len: Length of the parameters
+ *
+ * @return
+ *      - ESP_OK on success, otherwise returns ESP_ERR_xxx
+ */
+esp_err_t esp_lcd_touch_io_rx_param(esp_lcd_touch_handle_t tp, int reg, void *data, size_t len);
+
+/**
+ * @brief Write parameters to touch controller and count the transaction
+ *
+ * @param tp: Touch handler
+ * @param reg: Register to write, `-1` if no register
+ * @param data: Parameters to write (can be NULL)
+ * @param len: Length of the parameters
+ *
+ * @return
+ *      - ESP_OK on success, otherwise returns ESP_ERR_xxx
+ */
+esp_err_t esp_lcd_touch_io_tx_param(esp_lcd_touch_handle_t tp, int reg, const void *data, size_t len);
+
+/**
+ * @brief Get counters of the bus transactions
+ *
+ * @param tp: Touch handler
+ * @param stats: Counters since the touch is created or the last `esp_lcd_touch_reset_stats()`
+ *
+ * @return
+ *      - ESP_OK on success
+ */
+esp_err_t esp_lcd_touch_get_stats(esp_lcd_touch_handle_t tp, esp_lcd_touch_stats_t *stats);
+
+/**
+ * @brief Reset counters of the bus transactions
+ *
+ * @param tp: Touch handler
+ *
+ * @return
+ *      - ESP_OK on success
+ */
+esp_err_t esp_lcd_touch_reset_stats(esp_lcd_touch_handle_t tp);
+
 #ifdef __cplusplus
 }
 #endif
@@ -183,14 +183,14 @@ static esp_err_t i2c_read_bytes(esp_lcd_touch_handle_t tp, int reg, uint8_t *dat
 {
     ESP_RETURN_ON_FALSE(data, ESP_ERR_INVALID_ARG, TAG, "Invalid data");
 
-    return esp_lcd_panel_io_rx_param(tp->io, reg, data, len);
+    return esp_lcd_touch_io_rx_param(tp, reg, data, len);
 }
 
 static esp_err_t i2c_write_bytes(esp_lcd_touch_handle_t tp, int reg, const uint8_t *data, uint8_t len)
 {
     ESP_RETURN_ON_FALSE(data, ESP_ERR_INVALID_ARG, TAG, "Invalid data");
 
-    return esp_lcd_panel_io_tx_param(tp->io, reg, data, len);
+    return esp_lcd_touch_io_tx_param(tp, reg, data, len);
 }
 
 #endif // ESP_PANEL_DRIVERS_TOUCH_ENABLE_AXS15231B
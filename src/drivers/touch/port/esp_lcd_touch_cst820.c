@@ -208,7 +208,7 @@ static esp_err_t i2c_read_bytes(esp_lcd_touch_handle_t tp, uint16_t reg, uint8_t
 {
     ESP_RETURN_ON_FALSE(data, ESP_ERR_INVALID_ARG, TAG, "Invalid data");
 
-    return esp_lcd_panel_io_rx_param(tp->io, reg, data, len);
+    return esp_lcd_touch_io_rx_param(tp, reg, data, len);
 }
 
 #endif // ESP_PANEL_DRIVERS_TOUCH_ENABLE_CST820
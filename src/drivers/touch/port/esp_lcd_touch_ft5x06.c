@@ -325,7 +325,7 @@ static esp_err_t touch_ft5x06_i2c_write(esp_lcd_touch_handle_t tp, uint8_t reg,
 
     // *INDENT-OFF*
     /* Write data */
-    return esp_lcd_panel_io_tx_param(tp->io, reg, (uint8_t[]){data}, 1);
+    return esp_lcd_touch_io_tx_param(tp, reg, (uint8_t[]){data}, 1);
     // *INDENT-ON*
 }
 
@@ -335,7 +335,7 @@ static esp_err_t touch_ft5x06_i2c_read(esp_lcd_touch_handle_t tp, uint8_t reg, u
     assert(data != NULL);
 
     /* Read data */
-    return esp_lcd_panel_io_rx_param(tp->io, reg, data, len);
+    return esp_lcd_touch_io_rx_param(tp, reg, data, len);
 }
 
 #endif // ESP_PANEL_DRIVERS_TOUCH_ENABLE_FT5x06
@@ -36,6 +36,17 @@ static const char *TAG = "GT911";
 /* GT911 support key num */
 #define ESP_GT911_TOUCH_MAX_BUTTONS         (4)
 
+/* Points read from the controller, only the ones which can be saved are read */
+#define ESP_GT911_TOUCH_MAX_POINTS          \
+    ((CONFIG_ESP_LCD_TOUCH_MAX_POINTS < 5) ? (CONFIG_ESP_LCD_TOUCH_MAX_POINTS) : 5)
+/* Length of the status and the data of points, each point has 8 bytes */
+#define ESP_GT911_TOUCH_DATA_LEN(points)    (1 + (points) * 8)
+
+typedef struct {
+    esp_lcd_touch_t base;
+    uint8_t burst_points;   /*!< Points read with the status in one transaction, which is the count of the last poll */
+} esp_lcd_touch_gt911_t;
+
 /*******************************************************************************
 * Function definitions
 *******************************************************************************/
@@ -75,8 +86,11 @@ esp_err_t esp_lcd_touch_new_i2c_gt911(const esp_lcd_panel_io_handle_t io, const
 
     /* Prepare main structure */
     // Use `calloc` instead of `heap_caps_calloc` for MicroPython compatibility
-    esp_lcd_touch_handle_t esp_lcd_touch_gt911 = calloc(1, sizeof(esp_lcd_touch_t));
-    ESP_GOTO_ON_FALSE(esp_lcd_touch_gt911, ESP_ERR_NO_MEM, err, TAG, "no mem for GT911 controller");
+    esp_lcd_touch_handle_t esp_lcd_touch_gt911 = NULL;
+    esp_lcd_touch_gt911_t *gt911 = calloc(1, sizeof(esp_lcd_touch_gt911_t));
+    ESP_GOTO_ON_FALSE(gt911, ESP_ERR_NO_MEM, err, TAG, "no mem for GT911 controller");
+    gt911->burst_points = 1;
+    esp_lcd_touch_gt911 = &gt911->base;
 
     /* Communication interface */
     esp_lcd_touch_gt911->io = io;
@@ -218,20 +232,23 @@ static esp_err_t esp_lcd_touch_gt911_exit_sleep(esp_lcd_touch_handle_t tp)
 
 static esp_err_t esp_lcd_touch_gt911_read_data(esp_lcd_touch_handle_t tp)
 {
+    esp_lcd_touch_gt911_t *gt911 = __containerof(tp, esp_lcd_touch_gt911_t, base);
     esp_err_t err;
-    uint8_t buf[41];
+    uint8_t buf[ESP_GT911_TOUCH_DATA_LEN(ESP_GT911_TOUCH_MAX_POINTS)];
     uint8_t touch_cnt = 0;
+    uint8_t burst_cnt = gt911->burst_points;
     uint8_t clear = 0;
     size_t i = 0;
 
     assert(tp != NULL);
 
-    err = touch_gt911_i2c_read(tp, ESP_LCD_TOUCH_GT911_READ_XY_REG, buf, 1);
+    /* Read the status and the points expected by the last poll in one transaction */
+    err = touch_gt911_i2c_read(tp, ESP_LCD_TOUCH_GT911_READ_XY_REG, buf, ESP_GT911_TOUCH_DATA_LEN(burst_cnt));
     ESP_RETURN_ON_ERROR(err, TAG, "I2C read error!");
 
-    /* Any touch data? */
+    /* Any touch data? The buffer is not updated until cleared, so only clear it when it's ready */
     if ((buf[0] & 0x80) == 0x00) {
-        touch_gt911_i2c_write(tp, ESP_LCD_TOUCH_GT911_READ_XY_REG, clear);
+        return ESP_OK;
 #if (CONFIG_ESP_LCD_TOUCH_MAX_BUTTONS > 0)
     } else if ((buf[0] & 0x10) == 0x10) {
         /* Read all keys */
@@ -241,7 +258,7 @@ static esp_err_t esp_lcd_touch_gt911_read_data(esp_lcd_touch_handle_t tp)
         ESP_RETURN_ON_ERROR(err, TAG, "I2C read error!");
 
         /* Clear all */
-        touch_gt911_i2c_write(tp, ESP_LCD_TOUCH_GT911_READ_XY_REG, clear);
+        err = touch_gt911_i2c_write(tp, ESP_LCD_TOUCH_GT911_READ_XY_REG, clear);
         ESP_RETURN_ON_ERROR(err, TAG, "I2C write error!");
 
         portENTER_CRITICAL(&tp->data.lock);
@@ -265,22 +282,32 @@ static esp_err_t esp_lcd_touch_gt911_read_data(esp_lcd_touch_handle_t tp)
         /* Count of touched points */
         touch_cnt = buf[0] & 0x0f;
         if (touch_cnt > 5 || touch_cnt == 0) {
-            touch_gt911_i2c_write(tp, ESP_LCD_TOUCH_GT911_READ_XY_REG, clear);
+            gt911->burst_points = 1;
+            err = touch_gt911_i2c_write(tp, ESP_LCD_TOUCH_GT911_READ_XY_REG, clear);
+            ESP_RETURN_ON_ERROR(err, TAG, "I2C write error!");
             return ESP_OK;
         }
 
-        /* Read all points */
-        err = touch_gt911_i2c_read(tp, ESP_LCD_TOUCH_GT911_READ_XY_REG + 1, &buf[1], touch_cnt * 8);
-        ESP_RETURN_ON_ERROR(err, TAG, "I2C read error!");
+        /* The points which can't be saved are not read */
+        touch_cnt = (touch_cnt > ESP_GT911_TOUCH_MAX_POINTS ? ESP_GT911_TOUCH_MAX_POINTS : touch_cnt);
+        gt911->burst_points = touch_cnt;
+
+        /* Read the rest points if more than expected */
+        if (touch_cnt > burst_cnt) {
+            err = touch_gt911_i2c_read(
+                      tp, ESP_LCD_TOUCH_GT911_READ_XY_REG + ESP_GT911_TOUCH_DATA_LEN(burst_cnt),
+                      &buf[ESP_GT911_TOUCH_DATA_LEN(burst_cnt)], (touch_cnt - burst_cnt) * 8
+                  );
+            ESP_RETURN_ON_ERROR(err, TAG, "I2C read error!");
+        }
 
         /* Clear all */
         err = touch_gt911_i2c_write(tp, ESP_LCD_TOUCH_GT911_READ_XY_REG, clear);
-        ESP_RETURN_ON_ERROR(err, TAG, "I2C read error!");
+        ESP_RETURN_ON_ERROR(err, TAG, "I2C write error!");
 
         portENTER_CRITICAL(&tp->data.lock);
 
         /* Number of touched points */
-        touch_cnt = (touch_cnt > CONFIG_ESP_LCD_TOUCH_MAX_POINTS ? CONFIG_ESP_LCD_TOUCH_MAX_POINTS : touch_cnt);
         tp->data.points = touch_cnt;
 
         /* Fill all coordinates */
@@ -433,8 +460,8 @@ static void DFRobot_GT911_Send_Cfg(esp_lcd_touch_handle_t tp, uint8_t mode){
       temp[0] += GT911_Cfg[i];
     }
     temp[0] = (~temp[0])+1;
-    esp_lcd_panel_io_tx_param(tp->io, ESP_LCD_TOUCH_GT911_CONFIG_REG, GT911_Cfg, sizeof(GT911_Cfg));
-    esp_lcd_panel_io_tx_param(tp->io, DFROBOT_TOUCH_GT911_CHECK_REG, temp, 2);
+    esp_lcd_touch_io_tx_param(tp, ESP_LCD_TOUCH_GT911_CONFIG_REG, GT911_Cfg, sizeof(GT911_Cfg));
+    esp_lcd_touch_io_tx_param(tp, DFROBOT_TOUCH_GT911_CHECK_REG, temp, 2);
     
   }
 
@@ -469,7 +496,7 @@ static esp_err_t touch_gt911_i2c_read(esp_lcd_touch_handle_t tp, uint16_t reg, u
     assert(data != NULL);
 
     /* Read data */
-    return esp_lcd_panel_io_rx_param(tp->io, reg, data, len);
+    return esp_lcd_touch_io_rx_param(tp, reg, data, len);
 }
 
 static esp_err_t touch_gt911_i2c_write(esp_lcd_touch_handle_t tp, uint16_t reg, uint8_t data)
@@ -478,7 +505,7 @@ static esp_err_t touch_gt911_i2c_write(esp_lcd_touch_handle_t tp, uint16_t reg,
 
     // *INDENT-OFF*
     /* Write data */
-    return esp_lcd_panel_io_tx_param(tp->io, reg, (uint8_t[]){data}, 1);
+    return esp_lcd_touch_io_tx_param(tp, reg, (uint8_t[]){data}, 1);
     // *INDENT-ON*
 }
 
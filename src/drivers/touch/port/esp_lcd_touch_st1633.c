@@ -211,7 +211,7 @@ static esp_err_t i2c_read_bytes(esp_lcd_touch_handle_t tp, uint16_t reg, uint8_t
 {
     ESP_RETURN_ON_FALSE((len == 0) || (data != NULL), ESP_ERR_INVALID_ARG, TAG, "Invalid data");
 
-    ESP_RETURN_ON_ERROR(esp_lcd_panel_io_rx_param(tp->io, reg, data, len), TAG, "Read param failed");
+    ESP_RETURN_ON_ERROR(esp_lcd_touch_io_rx_param(tp, reg, data, len), TAG, "Read param failed");
 
     return ESP_OK;
 }
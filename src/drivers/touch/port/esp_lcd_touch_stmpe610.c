@@ -352,7 +352,7 @@ static esp_err_t touch_stmpe610_read(esp_lcd_touch_handle_t tp, uint8_t reg, uin
     assert(data != NULL);
 
     /* Read data */
-    return esp_lcd_panel_io_rx_param(tp->io, (0x80 | reg), data, len);
+    return esp_lcd_touch_io_rx_param(tp, (0x80 | reg), data, len);
 }
 
 static esp_err_t touch_stmpe610_write(esp_lcd_touch_handle_t tp, uint8_t reg, uint8_t data)
@@ -361,7 +361,7 @@ static esp_err_t touch_stmpe610_write(esp_lcd_touch_handle_t tp, uint8_t reg, ui
 
     // *INDENT-OFF*
     /* Write data */
-    return esp_lcd_panel_io_tx_param(tp->io, reg, (uint8_t[]){data}, 1);
+    return esp_lcd_touch_io_tx_param(tp, reg, (uint8_t[]){data}, 1);
     // *INDENT-ON*
 }
 
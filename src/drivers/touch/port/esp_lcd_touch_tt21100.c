@@ -356,7 +356,7 @@ static esp_err_t touch_tt21100_i2c_read(esp_lcd_touch_handle_t tp, uint8_t *data
     assert(data != NULL);
 
     /* Read data */
-    return esp_lcd_panel_io_rx_param(tp->io, -1, data, len);
+    return esp_lcd_touch_io_rx_param(tp, -1, data, len);
 }
 
 static esp_err_t touch_tt21100_i2c_write(esp_lcd_touch_handle_t tp, uint16_t reg, uint8_t *data, uint16_t len)
@@ -364,7 +364,7 @@ static esp_err_t touch_tt21100_i2c_write(esp_lcd_touch_handle_t tp, uint16_t reg
     assert(tp != NULL);
     assert(data != NULL);
 
-    return esp_lcd_panel_io_tx_param(tp->io, reg, data, len);
+    return esp_lcd_touch_io_tx_param(tp, reg, data, len);
 }
 
 #endif // ESP_PANEL_DRIVERS_TOUCH_ENABLE_TT21100
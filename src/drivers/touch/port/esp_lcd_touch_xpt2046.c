@@ -162,7 +162,7 @@ static esp_err_t xpt2046_del(esp_lcd_touch_handle_t tp)
 static inline esp_err_t xpt2046_read_register(esp_lcd_touch_handle_t tp, uint8_t reg, uint16_t *value)
 {
     uint8_t buf[2] = {0, 0};
-    ESP_RETURN_ON_ERROR(esp_lcd_panel_io_rx_param(tp->io, reg, buf, 2), TAG, "XPT2046 read error!");
+    ESP_RETURN_ON_ERROR(esp_lcd_touch_io_rx_param(tp, reg, buf, 2), TAG, "XPT2046 read error!");
     *value = ((buf[0] << 8) | (buf[1]));
     return ESP_OK;
 }
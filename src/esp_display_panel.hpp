@@ -11,7 +11,23 @@
 #include "esp_panel_conf_internal.h"
 
 /* Utils */
+#include "utils/esp_panel_utils_blitter.hpp"
+#include "utils/esp_panel_utils_blitter_ppa.hpp"
 #include "utils/esp_panel_utils_cxx.hpp"
+#include "utils/esp_panel_utils_dirty_area.hpp"
+#include "utils/esp_panel_utils_frame_pacer.hpp"
+#include "utils/esp_panel_utils_frame_sync.hpp"
+#include "utils/esp_panel_utils_i2c_queue.hpp"
+#include "utils/esp_panel_utils_latency.hpp"
+#include "utils/esp_panel_utils_line_store.hpp"
+#include "utils/esp_panel_utils_memory_plan.hpp"
+#include "utils/esp_panel_utils_pixel_convert.hpp"
+#include "utils/esp_panel_utils_profiler.hpp"
+#include "utils/esp_panel_utils_ring_buffer.hpp"
+#include "utils/esp_panel_utils_rotate.hpp"
+#include "utils/esp_panel_utils_swap_chain.hpp"
+#include "utils/esp_panel_utils_tearing.hpp"
+#include "utils/esp_panel_utils_touch_filter.hpp"
 
 /* Drivers */
 #include "drivers/bus/esp_panel_bus_factory.hpp"
@@ -22,3 +38,4 @@
 
 /* Board */
 #include "board/esp_panel_board.hpp"
+#include "board/esp_panel_board_drivers.hpp"
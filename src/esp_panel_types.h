@@ -18,6 +18,7 @@
 #define ESP_PANEL_BUS_TYPE_I2C              (3)
 #define ESP_PANEL_BUS_TYPE_I80              (4)
 #define ESP_PANEL_BUS_TYPE_MIPI_DSI         (5)
+#define ESP_PANEL_BUS_TYPE_VIRTUAL          (6)
 
 /**
  * @brief  Macros for LCD color format bits
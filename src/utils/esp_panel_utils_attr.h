@@ -0,0 +1,19 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+/**
+ * @note This file is pure C++ and doesn't depend on ESP-IDF, so it can be tested on the host.
+ */
+
+#if __has_include("esp_attr.h")
+#include "esp_attr.h"
+#endif
+
+// The functions called by the IRAM-safe ISRs are marked by `IRAM_ATTR`, which is a no-op on the host
+#ifndef IRAM_ATTR
+#define IRAM_ATTR
+#endif
@@ -0,0 +1,323 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include "esp_panel_utils_blitter.hpp"
+
+namespace esp_panel::utils {
+
+namespace {
+
+constexpr int ROTATE_TILE_SIZE = 32;
+
+using Surface = Blitter::Surface;
+using Rect = Blitter::Rect;
+
+/**
+ * @brief Round `value / 255` to the nearest integer, exact for `value` in [0, 65535]
+ */
+inline uint32_t divide255(uint32_t value)
+{
+    value += 128;
+
+    return (value + (value >> 8)) >> 8;
+}
+
+/**
+ * @brief Blend two ARGB8888 pixels, the alpha of the result is `a + bg_alpha * (1 - a)`
+ *
+ * The R/B and A/G components are processed in pairs of 16-bit lanes of 32-bit registers, each lane is rounded as
+ * `divide255()`.
+ */
+inline uint32_t blendPixel(uint32_t fg, uint32_t bg, uint32_t alpha)
+{
+    uint32_t inv_alpha = 255 - alpha;
+    uint32_t rb = (fg & 0x00FF00FF) * alpha + (bg & 0x00FF00FF) * inv_alpha + 0x00800080;
+    uint32_t ag = ((fg >> 8) & 0x000000FF) * alpha + ((bg >> 8) & 0x00FF00FF) * inv_alpha + 0x00800080;
+    rb = ((rb + ((rb >> 8) & 0x00FF00FF)) >> 8) & 0x00FF00FF;
+    ag = ((ag + ((ag >> 8) & 0x00FF00FF)) >> 8) & 0x00FF00FF;
+
+    // The A lane only takes the background, the blended alpha is added at last
+    return (rb | (ag << 8)) + (alpha << 24);
+}
+
+template <int BYTES>
+void rotatePixels(const Surface &src, const Rect &rect, const Surface &dst, int x, int y, int degree)
+{
+    // The destination of the first source pixel, and the steps along a source row and a source column
+    ptrdiff_t dst_stride = dst.getStride();
+    uint8_t *origin = nullptr;
+    ptrdiff_t step_x = 0;
+    ptrdiff_t step_y = 0;
+    switch (degree) {
+    case 90:
+        origin = dst.getPixel(x, y + rect.width - 1);
+        step_x = -dst_stride;
+        step_y = BYTES;
+        break;
+    case 180:
+        origin = dst.getPixel(x + rect.width - 1, y + rect.height - 1);
+        step_x = -BYTES;
+        step_y = -dst_stride;
+        break;
+    case 270:
+        origin = dst.getPixel(x + rect.height - 1, y);
+        step_x = dst_stride;
+        step_y = -BYTES;
+        break;
+    default:
+        origin = dst.getPixel(x, y);
+        step_x = BYTES;
+        step_y = dst_stride;
+        break;
+    }
+
+    // Walk by tiles, so the columns written by the 90/270 degree rotations stay in the cache
+    for (int tile_y = 0; tile_y < rect.height; tile_y += ROTATE_TILE_SIZE) {
+        int tile_y_end = std::min(tile_y + ROTATE_TILE_SIZE, rect.height);
+        for (int tile_x = 0; tile_x < rect.width; tile_x += ROTATE_TILE_SIZE) {
+            int tile_width = std::min(ROTATE_TILE_SIZE, rect.width - tile_x);
+            for (int j = tile_y; j < tile_y_end; j++) {
+                const uint8_t *from = src.getPixel(rect.x + tile_x, rect.y + j);
+                uint8_t *to = origin + j * step_y + tile_x * step_x;
+                for (int i = 0; i < tile_width; i++) {
+                    memcpy(to, from, BYTES);
+                    from += BYTES;
+                    to += step_x;
+                }
+            }
+        }
+    }
+}
+
+template <int BYTES>
+void scaleRow(const uint8_t *from, uint8_t *to, const int *offsets, int width)
+{
+    for (int i = 0; i < width; i++) {
+        memcpy(to, from + offsets[i], BYTES);
+        to += BYTES;
+    }
+}
+
+/**
+ * @brief Get the source coordinate sampled by the destination pixel `index`, at the center of the pixel
+ */
+inline int getScaleSource(int index, int src_size, int dst_size)
+{
+    return static_cast<int>(((2LL * index + 1) * src_size) / (2LL * dst_size));
+}
+
+} // namespace
+
+bool Blitter::checkRect(const Surface &surface, const Rect &rect)
+{
+    int bytes_per_pixel = PixelConverter::getBytesPerPixel(surface.format);
+    if ((surface.data == nullptr) || (bytes_per_pixel == 0) || (surface.width <= 0) || (surface.height <= 0) ||
+            (surface.getStride() < surface.width * bytes_per_pixel)) {
+        return false;
+    }
+
+    return (rect.width > 0) && (rect.height > 0) && (rect.x >= 0) && (rect.y >= 0) &&
+           (rect.x + rect.width <= surface.width) && (rect.y + rect.height <= surface.height);
+}
+
+bool BlitterCPU::fill(const Surface &dst, const Rect &rect, uint32_t argb)
+{
+    if (!checkRect(dst, rect)) {
+        return false;
+    }
+
+    uint8_t pixel[4] = {};
+    PixelConverter converter({.src_format = PixelFormat::ARGB8888, .dst_format = dst.format});
+    converter.convert(reinterpret_cast<const uint8_t *>(&argb), pixel, 1);
+
+    // Fill the first row by doubling the filled part, then copy it to the other rows
+    int bytes_per_pixel = PixelConverter::getBytesPerPixel(dst.format);
+    size_t row_size = static_cast<size_t>(rect.width) * bytes_per_pixel;
+    uint8_t *first_row = dst.getPixel(rect.x, rect.y);
+    memcpy(first_row, pixel, bytes_per_pixel);
+    for (size_t filled = bytes_per_pixel; filled < row_size;) {
+        size_t size = std::min(filled, row_size - filled);
+        memcpy(first_row + filled, first_row, size);
+        filled += size;
+    }
+    for (int j = 1; j < rect.height; j++) {
+        memcpy(first_row + j * dst.getStride(), first_row, row_size);
+    }
+    _last_backend = Backend::CPU;
+
+    return true;
+}
+
+bool BlitterCPU::copy(const Surface &src, const Rect &src_rect, const Surface &dst, int x, int y)
+{
+    if (!checkRect(src, src_rect) || !checkRect(dst, {x, y, src_rect.width, src_rect.height})) {
+        return false;
+    }
+
+    const uint8_t *from = src.getPixel(src_rect.x, src_rect.y);
+    uint8_t *to = dst.getPixel(x, y);
+    int src_stride = src.getStride();
+    int dst_stride = dst.getStride();
+    if (src.format == dst.format) {
+        size_t row_size = static_cast<size_t>(src_rect.width) * PixelConverter::getBytesPerPixel(src.format);
+        if ((src_stride == dst_stride) && (row_size == static_cast<size_t>(src_stride))) {
+            memmove(to, from, row_size * src_rect.height);
+        } else if (reinterpret_cast<uintptr_t>(to) > reinterpret_cast<uintptr_t>(from)) {
+            // Copy from the bottom, so the overlapped rows below are read before written
+            for (int j = src_rect.height - 1; j >= 0; j--) {
+                memmove(to + j * dst_stride, from + j * src_stride, row_size);
+            }
+        } else {
+            for (int j = 0; j < src_rect.height; j++) {
+                memmove(to + j * dst_stride, from + j * src_stride, row_size);
+            }
+        }
+    } else {
+        PixelConverter converter({.src_format = src.format, .dst_format = dst.format});
+        for (int j = 0; j < src_rect.height; j++) {
+            converter.convert(from + j * src_stride, to + j * dst_stride, src_rect.width);
+        }
+    }
+    _last_backend = Backend::CPU;
+
+    return true;
+}
+
+bool BlitterCPU::rotate(const Surface &src, const Rect &src_rect, const Surface &dst, int x, int y, int degree)
+{
+    if ((src.format != dst.format) || (degree % 90 != 0) || (degree < 0) || (degree > 270)) {
+        return false;
+    }
+    bool is_swapped = (degree == 90) || (degree == 270);
+    Rect dst_rect = {
+        x, y, is_swapped ? src_rect.height : src_rect.width, is_swapped ? src_rect.width : src_rect.height
+    };
+    if (!checkRect(src, src_rect) || !checkRect(dst, dst_rect)) {
+        return false;
+    }
+
+    // The rotations between the whole packed frames have the layout of `Rotator`, which has the register kernels
+    int bytes_per_pixel = PixelConverter::getBytesPerPixel(src.format);
+    if (src.isPacked() && dst.isPacked()) {
+        auto &config = _rotator.getConfig();
+        if ((config.width != src.width) || (config.height != src.height) ||
+                (config.bytes_per_pixel != bytes_per_pixel) || (config.degree != degree)) {
+            _rotator.setConfig({
+                .width = src.width,
+                .height = src.height,
+                .bytes_per_pixel = bytes_per_pixel,
+                .degree = degree,
+            });
+        }
+        int area_x = src_rect.x;
+        int area_y = src_rect.y;
+        int area_width = src_rect.width;
+        int area_height = src_rect.height;
+        _rotator.rotateArea(area_x, area_y, area_width, area_height);
+        if ((_rotator.getDestWidth() == dst.width) && (_rotator.getDestHeight() == dst.height) &&
+                (area_x == x) && (area_y == y) &&
+                _rotator.copy(src.data, dst.data, src_rect.x, src_rect.y, src_rect.width, src_rect.height)) {
+            _last_backend = Backend::CPU;
+            return true;
+        }
+    }
+
+    switch (bytes_per_pixel) {
+    case 2:
+        rotatePixels<2>(src, src_rect, dst, x, y, degree);
+        break;
+    case 3:
+        rotatePixels<3>(src, src_rect, dst, x, y, degree);
+        break;
+    default:
+        rotatePixels<4>(src, src_rect, dst, x, y, degree);
+        break;
+    }
+    _last_backend = Backend::CPU;
+
+    return true;
+}
+
+bool BlitterCPU::scale(const Surface &src, const Rect &src_rect, const Surface &dst, const Rect &dst_rect)
+{
+    if ((src.format != dst.format) || !checkRect(src, src_rect) || !checkRect(dst, dst_rect)) {
+        return false;
+    }
+
+    int bytes_per_pixel = PixelConverter::getBytesPerPixel(src.format);
+    _scale_offsets.resize(dst_rect.width);
+    for (int i = 0; i < dst_rect.width; i++) {
+        _scale_offsets[i] = getScaleSource(i, src_rect.width, dst_rect.width) * bytes_per_pixel;
+    }
+
+    size_t row_size = static_cast<size_t>(dst_rect.width) * bytes_per_pixel;
+    int last_src_y = -1;
+    for (int j = 0; j < dst_rect.height; j++) {
+        int src_y = src_rect.y + getScaleSource(j, src_rect.height, dst_rect.height);
+        uint8_t *to = dst.getPixel(dst_rect.x, dst_rect.y + j);
+        // The enlarged rows are the same as the previous one
+        if (src_y == last_src_y) {
+            memcpy(to, to - dst.getStride(), row_size);
+            continue;
+        }
+
+        const uint8_t *from = src.getPixel(src_rect.x, src_y);
+        switch (bytes_per_pixel) {
+        case 2:
+            scaleRow<2>(from, to, _scale_offsets.data(), dst_rect.width);
+            break;
+        case 3:
+            scaleRow<3>(from, to, _scale_offsets.data(), dst_rect.width);
+            break;
+        default:
+            scaleRow<4>(from, to, _scale_offsets.data(), dst_rect.width);
+            break;
+        }
+        last_src_y = src_y;
+    }
+    _last_backend = Backend::CPU;
+
+    return true;
+}
+
+bool BlitterCPU::blend(const Surface &fg, const Rect &fg_rect, const Surface &dst, int x, int y, uint8_t opa)
+{
+    if (!checkRect(fg, fg_rect) || !checkRect(dst, {x, y, fg_rect.width, fg_rect.height})) {
+        return false;
+    }
+    _last_backend = Backend::CPU;
+    if (opa == 0) {
+        return true;
+    }
+
+    _fg_line.resize(fg_rect.width);
+    _bg_line.resize(fg_rect.width);
+    auto fg_line = reinterpret_cast<uint8_t *>(_fg_line.data());
+    auto bg_line = reinterpret_cast<uint8_t *>(_bg_line.data());
+    PixelConverter fg_to_argb({.src_format = fg.format, .dst_format = PixelFormat::ARGB8888});
+    PixelConverter dst_to_argb({.src_format = dst.format, .dst_format = PixelFormat::ARGB8888});
+    PixelConverter argb_to_dst({.src_format = PixelFormat::ARGB8888, .dst_format = dst.format});
+    for (int j = 0; j < fg_rect.height; j++) {
+        uint8_t *dst_row = dst.getPixel(x, y + j);
+        fg_to_argb.convert(fg.getPixel(fg_rect.x, fg_rect.y + j), fg_line, fg_rect.width);
+        dst_to_argb.convert(dst_row, bg_line, fg_rect.width);
+        for (int i = 0; i < fg_rect.width; i++) {
+            uint32_t alpha = divide255((_fg_line[i] >> 24) * opa);
+            if (alpha == 255) {
+                _bg_line[i] = _fg_line[i];
+            } else if (alpha > 0) {
+                _bg_line[i] = blendPixel(_fg_line[i], _bg_line[i], alpha);
+            }
+        }
+        argb_to_dst.convert(bg_line, dst_row, fg_rect.width);
+    }
+
+    return true;
+}
+
+} // namespace esp_panel::utils
@@ -0,0 +1,208 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "esp_panel_utils_pixel_convert.hpp"
+#include "esp_panel_utils_rotate.hpp"
+
+/**
+ * @note This file is pure C++ and doesn't depend on ESP-IDF, so it can be tested on the host.
+ */
+
+namespace esp_panel::utils {
+
+/**
+ * @brief Interface of the 2D operations on the frame buffers
+ *
+ * The operations are synchronous, they return after the destination is written. The hardware backends (e.g.
+ * `BlitterPPA`) block the calling task while the engine is running, so the CPU is free for the other tasks, and they
+ * fall back to `BlitterCPU` for the operations not supported by the engine.
+ */
+class Blitter {
+public:
+    /**
+     * @brief Backend which runs the operations
+     */
+    enum class Backend {
+        NONE = 0,
+        CPU,
+        PPA,
+    };
+
+    /**
+     * @brief Frame buffer or a part of it
+     */
+    struct Surface {
+        /**
+         * @brief Get the bytes of a row
+         *
+         * @return Stride in bytes
+         */
+        int getStride() const
+        {
+            return (stride > 0) ? stride : width * PixelConverter::getBytesPerPixel(format);
+        }
+
+        /**
+         * @brief Get the address of a pixel
+         *
+         * @param[in] x X coordinate of the pixel
+         * @param[in] y Y coordinate of the pixel
+         * @return Address of the pixel
+         */
+        uint8_t *getPixel(int x, int y) const
+        {
+            return data + y * getStride() + x * PixelConverter::getBytesPerPixel(format);
+        }
+
+        /**
+         * @brief Check if the rows are contiguous
+         *
+         * @return `true` if the stride equals the bytes of the pixels in a row, `false` otherwise
+         */
+        bool isPacked() const
+        {
+            return getStride() == width * PixelConverter::getBytesPerPixel(format);
+        }
+
+        uint8_t *data = nullptr;                    ///< Address of the pixel `(0, 0)`
+        int width = 0;                              ///< Width in pixels
+        int height = 0;                             ///< Height in pixels
+        int stride = 0;                             ///< Bytes of a row, `0` means `width * bytes_per_pixel`
+        PixelFormat format = PixelFormat::RGB565;   ///< Pixel format
+    };
+
+    /**
+     * @brief Rectangle in a surface
+     */
+    struct Rect {
+        int x = 0;          ///< X coordinate of the top-left pixel
+        int y = 0;          ///< Y coordinate of the top-left pixel
+        int width = 0;      ///< Width in pixels
+        int height = 0;     ///< Height in pixels
+    };
+
+    virtual ~Blitter() = default;
+
+    /**
+     * @brief Fill a rectangle with a color
+     *
+     * @param[in] dst Destination surface
+     * @param[in] rect Rectangle to fill
+     * @param[in] argb Color in `0xAARRGGBB`, the alpha is only written to the ARGB8888 surfaces
+     * @return `true` if successful, `false` if the parameters are invalid
+     */
+    virtual bool fill(const Surface &dst, const Rect &rect, uint32_t argb) = 0;
+
+    /**
+     * @brief Copy a rectangle, and convert the pixels if the formats are different
+     *
+     * @param[in] src Source surface
+     * @param[in] src_rect Rectangle to copy
+     * @param[in] dst Destination surface
+     * @param[in] x X coordinate of the copied rectangle in the destination
+     * @param[in] y Y coordinate of the copied rectangle in the destination
+     * @return `true` if successful, `false` if the parameters are invalid
+     * @note The rectangles can overlap only if the formats are the same
+     */
+    virtual bool copy(const Surface &src, const Rect &src_rect, const Surface &dst, int x, int y) = 0;
+
+    /**
+     * @brief Copy a rectangle with rotation
+     *
+     * The rotation is counter-clockwise as `Rotator`, so a rectangle is `height * width` after rotating 90/270
+     * degrees.
+     *
+     * @param[in] src Source surface
+     * @param[in] src_rect Rectangle to rotate
+     * @param[in] dst Destination surface, the format should be the same as the source
+     * @param[in] x X coordinate of the rotated rectangle in the destination
+     * @param[in] y Y coordinate of the rotated rectangle in the destination
+     * @param[in] degree Rotation degree, only supports 0, 90, 180 and 270
+     * @return `true` if successful, `false` if the parameters are invalid
+     * @note The surfaces should not overlap
+     */
+    virtual bool rotate(const Surface &src, const Rect &src_rect, const Surface &dst, int x, int y, int degree) = 0;
+
+    /**
+     * @brief Copy a rectangle with scaling by the nearest pixels
+     *
+     * @param[in] src Source surface
+     * @param[in] src_rect Rectangle to scale
+     * @param[in] dst Destination surface, the format should be the same as the source
+     * @param[in] dst_rect Rectangle of the scaled pixels in the destination
+     * @return `true` if successful, `false` if the parameters are invalid
+     * @note The surfaces should not overlap
+     */
+    virtual bool scale(const Surface &src, const Rect &src_rect, const Surface &dst, const Rect &dst_rect) = 0;
+
+    /**
+     * @brief Blend a foreground rectangle over the destination
+     *
+     * Each pixel is `fg * a + dst * (1 - a)`, where `a` is the alpha of the foreground (`0xFF` if it isn't ARGB8888)
+     * multiplied by `opa`.
+     *
+     * @param[in] fg Foreground surface
+     * @param[in] fg_rect Rectangle to blend
+     * @param[in] dst Destination surface, which is also the background
+     * @param[in] x X coordinate of the blended rectangle in the destination
+     * @param[in] y Y coordinate of the blended rectangle in the destination
+     * @param[in] opa Opacity of the foreground, `255` means opaque
+     * @return `true` if successful, `false` if the parameters are invalid
+     * @note The surfaces should not overlap
+     */
+    virtual bool blend(const Surface &fg, const Rect &fg_rect, const Surface &dst, int x, int y, uint8_t opa = 255) = 0;
+
+    /**
+     * @brief Get the backend used by the last operation
+     *
+     * @return Backend type
+     */
+    Backend getLastBackend() const
+    {
+        return _last_backend;
+    }
+
+    /**
+     * @brief Check if a rectangle is non-empty and inside a surface
+     *
+     * @param[in] surface Surface
+     * @param[in] rect Rectangle
+     * @return `true` if valid, `false` otherwise
+     * @note The empty rectangles are invalid
+     */
+    static bool checkRect(const Surface &surface, const Rect &rect);
+
+protected:
+    Backend _last_backend = Backend::NONE;
+};
+
+/**
+ * @brief Blitter on the CPU, which is also the reference of the hardware backends
+ *
+ * The copies without conversion are done by rows with `memmove()`, the conversions by `PixelConverter` and the
+ * rotations between the whole packed frames by `Rotator`, so they use the 32-bit register kernels when aligned. The
+ * other rotations use the tiled per-pixel kernels, and the blending converts the rows to ARGB8888 in the internal
+ * line buffers.
+ */
+class BlitterCPU: public Blitter {
+public:
+    bool fill(const Surface &dst, const Rect &rect, uint32_t argb) override;
+    bool copy(const Surface &src, const Rect &src_rect, const Surface &dst, int x, int y) override;
+    bool rotate(const Surface &src, const Rect &src_rect, const Surface &dst, int x, int y, int degree) override;
+    bool scale(const Surface &src, const Rect &src_rect, const Surface &dst, const Rect &dst_rect) override;
+    bool blend(const Surface &fg, const Rect &fg_rect, const Surface &dst, int x, int y, uint8_t opa = 255) override;
+
+private:
+    Rotator _rotator;
+    std::vector<uint32_t> _fg_line;
+    std::vector<uint32_t> _bg_line;
+    std::vector<int> _scale_offsets;
+};
+
+} // namespace esp_panel::utils
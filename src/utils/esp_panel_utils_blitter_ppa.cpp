@@ -0,0 +1,329 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <algorithm>
+#include <utility>
+#include "esp_panel_utils_log.h"
+#include "esp_panel_utils_memory.hpp"
+#include "esp_panel_utils_blitter_ppa.hpp"
+#if ESP_PANEL_UTILS_BLITTER_PPA_SUPPORTED
+#include "esp_cache.h"
+#include "esp_heap_caps.h"
+#endif
+
+namespace esp_panel::utils {
+
+#if ESP_PANEL_UTILS_BLITTER_PPA_SUPPORTED
+namespace {
+
+/**
+ * @brief Get the color mode of the PPA, the SRM/blend/fill modes have the same values
+ *
+ * @return `true` if the format is supported by the PPA, `false` otherwise
+ */
+bool getColorMode(PixelFormat format, ppa_srm_color_mode_t &mode)
+{
+    switch (format) {
+    case PixelFormat::RGB565:
+        mode = PPA_SRM_COLOR_MODE_RGB565;
+        break;
+    case PixelFormat::BGR888:
+        mode = PPA_SRM_COLOR_MODE_RGB888;
+        break;
+    case PixelFormat::ARGB8888:
+        mode = PPA_SRM_COLOR_MODE_ARGB8888;
+        break;
+    default:
+        return false;
+    }
+
+    return true;
+}
+
+ppa_srm_rotation_angle_t getRotationAngle(int degree)
+{
+    // Both of the PPA and `Rotator` rotate counter-clockwise
+    switch (degree) {
+    case 90:
+        return PPA_SRM_ROTATION_ANGLE_90;
+    case 180:
+        return PPA_SRM_ROTATION_ANGLE_180;
+    case 270:
+        return PPA_SRM_ROTATION_ANGLE_270;
+    default:
+        return PPA_SRM_ROTATION_ANGLE_0;
+    }
+}
+
+/**
+ * @brief Check if the scaling factor is a multiple of the PPA step (1/16), so the PPA outputs exactly `dst_size`
+ */
+bool isScaleExact(int src_size, int dst_size)
+{
+    return ((dst_size * 16) % src_size) == 0;
+}
+
+} // namespace
+
+BlitterPPA::~BlitterPPA()
+{
+    ESP_UTILS_CHECK_FALSE_EXIT(del(), "Delete failed");
+}
+
+bool BlitterPPA::begin()
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    ESP_UTILS_CHECK_FALSE_RETURN(!isBegun(), false, "Already begun");
+
+    // The PPA writes back and invalidates the whole output buffer, so it should be aligned to the cache line
+    size_t internal_align = 0;
+    size_t psram_align = 0;
+    ESP_UTILS_CHECK_ERROR_RETURN(
+        esp_cache_get_alignment(MALLOC_CAP_DMA, &internal_align), false, "Get internal cache alignment failed"
+    );
+    ESP_UTILS_CHECK_ERROR_RETURN(
+        esp_cache_get_alignment(MALLOC_CAP_SPIRAM, &psram_align), false, "Get PSRAM cache alignment failed"
+    );
+    _cache_align = std::max<size_t>({internal_align, psram_align, 1});
+
+    const std::pair<ppa_operation_t, ppa_client_handle_t *> clients[] = {
+        {PPA_OPERATION_SRM, &_srm_client},
+        {PPA_OPERATION_BLEND, &_blend_client},
+        {PPA_OPERATION_FILL, &_fill_client},
+    };
+    for (auto &[type, client] : clients) {
+        ppa_client_config_t client_config = {
+            .oper_type = type,
+            .max_pending_trans_num = 1,
+        };
+        if (ppa_register_client(&client_config, client) != ESP_OK) {
+            ESP_UTILS_CHECK_FALSE_RETURN(del(), false, "Delete failed");
+            ESP_UTILS_CHECK_FALSE_RETURN(false, false, "Register PPA client(%d) failed", static_cast<int>(type));
+        }
+    }
+    ESP_UTILS_LOGD(
+        "Begin PPA blitter (cache align: %d, min pixels: %d)", static_cast<int>(_cache_align), _config.min_pixels
+    );
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool BlitterPPA::del()
+{
+    ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS();
+
+    for (auto client : {&_srm_client, &_blend_client, &_fill_client}) {
+        if (*client != nullptr) {
+            ESP_UTILS_CHECK_ERROR_RETURN(ppa_unregister_client(*client), false, "Unregister PPA client failed");
+            *client = nullptr;
+        }
+    }
+
+    ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS();
+
+    return true;
+}
+
+bool BlitterPPA::fill(const Surface &dst, const Rect &rect, uint32_t argb)
+{
+    ppa_out_pic_blk_config_t out = {};
+    if (!isBegun() || (rect.width * rect.height < _config.min_pixels) || !checkRect(dst, rect) ||
+            !getOutBlock(dst, rect, out)) {
+        return BlitterCPU::fill(dst, rect, argb);
+    }
+
+    ppa_fill_oper_config_t config = {
+        .out = out,
+        .fill_block_w = static_cast<uint32_t>(rect.width),
+        .fill_block_h = static_cast<uint32_t>(rect.height),
+        .fill_argb_color = {
+            .val = argb,
+        },
+        .mode = PPA_TRANS_MODE_BLOCKING,
+    };
+    ESP_UTILS_CHECK_ERROR_RETURN(
+        ppa_do_fill(_fill_client, &config), BlitterCPU::fill(dst, rect, argb), "Fill failed"
+    );
+    _last_backend = Backend::PPA;
+
+    return true;
+}
+
+bool BlitterPPA::copy(const Surface &src, const Rect &src_rect, const Surface &dst, int x, int y)
+{
+    if (src.data == dst.data) {
+        return BlitterCPU::copy(src, src_rect, dst, x, y);
+    }
+
+    return doSRM(src, src_rect, dst, {x, y, src_rect.width, src_rect.height}, 0, 1.0f, 1.0f) ||
+           BlitterCPU::copy(src, src_rect, dst, x, y);
+}
+
+bool BlitterPPA::rotate(const Surface &src, const Rect &src_rect, const Surface &dst, int x, int y, int degree)
+{
+    if ((src.format != dst.format) || (degree % 90 != 0) || (degree < 0) || (degree > 270)) {
+        return false;
+    }
+
+    bool is_swapped = (degree == 90) || (degree == 270);
+    Rect dst_rect = {
+        x, y, is_swapped ? src_rect.height : src_rect.width, is_swapped ? src_rect.width : src_rect.height
+    };
+
+    return doSRM(src, src_rect, dst, dst_rect, degree, 1.0f, 1.0f) ||
+           BlitterCPU::rotate(src, src_rect, dst, x, y, degree);
+}
+
+bool BlitterPPA::scale(const Surface &src, const Rect &src_rect, const Surface &dst, const Rect &dst_rect)
+{
+    if ((src.format != dst.format) || !checkRect(src, src_rect) || !checkRect(dst, dst_rect)) {
+        return false;
+    }
+    if (!isScaleExact(src_rect.width, dst_rect.width) || !isScaleExact(src_rect.height, dst_rect.height)) {
+        return BlitterCPU::scale(src, src_rect, dst, dst_rect);
+    }
+
+    float scale_x = static_cast<float>(dst_rect.width) / src_rect.width;
+    float scale_y = static_cast<float>(dst_rect.height) / src_rect.height;
+
+    return doSRM(src, src_rect, dst, dst_rect, 0, scale_x, scale_y) ||
+           BlitterCPU::scale(src, src_rect, dst, dst_rect);
+}
+
+bool BlitterPPA::blend(const Surface &fg, const Rect &fg_rect, const Surface &dst, int x, int y, uint8_t opa)
+{
+    Rect dst_rect = {x, y, fg_rect.width, fg_rect.height};
+    ppa_in_pic_blk_config_t in_fg = {};
+    ppa_in_pic_blk_config_t in_bg = {};
+    ppa_out_pic_blk_config_t out = {};
+    if (!isBegun() || (opa == 0) || (fg_rect.width * fg_rect.height < _config.min_pixels) ||
+            !checkRect(fg, fg_rect) || !checkRect(dst, dst_rect) || !getInBlock(fg, fg_rect, in_fg) ||
+            !getInBlock(dst, dst_rect, in_bg) || !getOutBlock(dst, dst_rect, out)) {
+        return BlitterCPU::blend(fg, fg_rect, dst, x, y, opa);
+    }
+
+    // The background is also the output
+    ppa_blend_oper_config_t config = {
+        .in_bg = in_bg,
+        .in_fg = in_fg,
+        .out = out,
+        .bg_alpha_update_mode = PPA_ALPHA_NO_CHANGE,
+        .fg_alpha_update_mode = (opa == 255) ? PPA_ALPHA_NO_CHANGE : PPA_ALPHA_SCALE,
+        .mode = PPA_TRANS_MODE_BLOCKING,
+    };
+    if (opa != 255) {
+        config.fg_alpha_scale_ratio = opa / 255.0f;
+    }
+    ESP_UTILS_CHECK_ERROR_RETURN(
+        ppa_do_blend(_blend_client, &config), BlitterCPU::blend(fg, fg_rect, dst, x, y, opa), "Blend failed"
+    );
+    _last_backend = Backend::PPA;
+
+    return true;
+}
+
+bool BlitterPPA::getInBlock(const Surface &surface, const Rect &rect, ppa_in_pic_blk_config_t &block) const
+{
+    ppa_srm_color_mode_t mode = {};
+    int bytes_per_pixel = PixelConverter::getBytesPerPixel(surface.format);
+    if (!getColorMode(surface.format, mode) || (surface.getStride() % bytes_per_pixel != 0)) {
+        return false;
+    }
+
+    // The picture width is the stride in pixels, so the padding of the rows is skipped
+    block = {
+        .buffer = surface.data,
+        .pic_w = static_cast<uint32_t>(surface.getStride() / bytes_per_pixel),
+        .pic_h = static_cast<uint32_t>(surface.height),
+        .block_w = static_cast<uint32_t>(rect.width),
+        .block_h = static_cast<uint32_t>(rect.height),
+        .block_offset_x = static_cast<uint32_t>(rect.x),
+        .block_offset_y = static_cast<uint32_t>(rect.y),
+        .srm_cm = mode,
+    };
+
+    return true;
+}
+
+bool BlitterPPA::getOutBlock(const Surface &surface, const Rect &rect, ppa_out_pic_blk_config_t &block) const
+{
+    ppa_srm_color_mode_t mode = {};
+    int bytes_per_pixel = PixelConverter::getBytesPerPixel(surface.format);
+    size_t buffer_size = static_cast<size_t>(surface.getStride()) * surface.height;
+    if (!getColorMode(surface.format, mode) || (surface.getStride() % bytes_per_pixel != 0) ||
+            (reinterpret_cast<uintptr_t>(surface.data) % _cache_align != 0) || (buffer_size % _cache_align != 0)) {
+        return false;
+    }
+
+    block = {
+        .buffer = surface.data,
+        .buffer_size = static_cast<uint32_t>(buffer_size),
+        .pic_w = static_cast<uint32_t>(surface.getStride() / bytes_per_pixel),
+        .pic_h = static_cast<uint32_t>(surface.height),
+        .block_offset_x = static_cast<uint32_t>(rect.x),
+        .block_offset_y = static_cast<uint32_t>(rect.y),
+        .srm_cm = mode,
+    };
+
+    return true;
+}
+
+bool BlitterPPA::doSRM(
+    const Surface &src, const Rect &src_rect, const Surface &dst, const Rect &dst_rect, int degree, float scale_x,
+    float scale_y
+)
+{
+    ppa_in_pic_blk_config_t in = {};
+    ppa_out_pic_blk_config_t out = {};
+    if (!isBegun() || (dst_rect.width * dst_rect.height < _config.min_pixels) || !checkRect(src, src_rect) ||
+            !checkRect(dst, dst_rect) || !getInBlock(src, src_rect, in) || !getOutBlock(dst, dst_rect, out)) {
+        return false;
+    }
+
+    ppa_srm_oper_config_t config = {
+        .in = in,
+        .out = out,
+        .rotation_angle = getRotationAngle(degree),
+        .scale_x = scale_x,
+        .scale_y = scale_y,
+        .mode = PPA_TRANS_MODE_BLOCKING,
+    };
+    ESP_UTILS_CHECK_ERROR_RETURN(ppa_do_scale_rotate_mirror(_srm_client, &config), false, "SRM failed");
+    _last_backend = Backend::PPA;
+
+    return true;
+}
+#endif // ESP_PANEL_UTILS_BLITTER_PPA_SUPPORTED
+
+std::shared_ptr<Blitter> createBlitter()
+{
+    ESP_UTILS_LOG_TRACE_ENTER();
+
+#if ESP_PANEL_UTILS_BLITTER_PPA_SUPPORTED
+    std::shared_ptr<BlitterPPA> ppa_blitter = nullptr;
+    ESP_UTILS_CHECK_EXCEPTION_RETURN(
+        (ppa_blitter = utils::make_shared<BlitterPPA>()), nullptr, "Create PPA blitter failed"
+    );
+    if (ppa_blitter->begin()) {
+        ESP_UTILS_LOG_TRACE_EXIT();
+        return ppa_blitter;
+    }
+    ESP_UTILS_LOGW("Begin PPA blitter failed, use CPU instead");
+#endif
+
+    std::shared_ptr<Blitter> blitter = nullptr;
+    ESP_UTILS_CHECK_EXCEPTION_RETURN(
+        (blitter = utils::make_shared<BlitterCPU>()), nullptr, "Create CPU blitter failed"
+    );
+
+    ESP_UTILS_LOG_TRACE_EXIT();
+
+    return blitter;
+}
+
+} // namespace esp_panel::utils
@@ -0,0 +1,117 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <memory>
+#include "soc/soc_caps.h"
+#include "esp_idf_version.h"
+#include "esp_panel_utils_blitter.hpp"
+
+#if SOC_PPA_SUPPORTED && (ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 3, 0))
+#define ESP_PANEL_UTILS_BLITTER_PPA_SUPPORTED   (1)
+#include "driver/ppa.h"
+#else
+#define ESP_PANEL_UTILS_BLITTER_PPA_SUPPORTED   (0)
+#endif
+
+namespace esp_panel::utils {
+
+#if ESP_PANEL_UTILS_BLITTER_PPA_SUPPORTED
+/**
+ * @brief Blitter on the PPA (Pixel-Processing Accelerator) of ESP32-P4, which moves the pixels by its 2D-DMA
+ *
+ * The operations block the calling task until the PPA finishes, so the CPU runs the other tasks meanwhile. They fall
+ * back to `BlitterCPU` when:
+ *
+ *  - The formats are not RGB565, BGR888 or ARGB8888, which are the RGB565, RGB888 and ARGB8888 of the PPA
+ *  - The rectangle has fewer pixels than `min_pixels`, which is faster on the CPU than setting up the PPA
+ *  - The destination buffer or its size is not aligned to the cache line, which is required by the PPA
+ *  - The stride is not a multiple of the pixel size, or the copy is inside the same buffer
+ *  - The scaling factor isn't a multiple of 1/16, which is the step of the PPA
+ *
+ * @note The PPA scales the pixels by its own sampling, so the results might differ slightly from `BlitterCPU`
+ */
+class BlitterPPA: public BlitterCPU {
+public:
+    static constexpr int MIN_PIXELS_DEFAULT = 64 * 64;
+
+    /**
+     * @brief Configuration of the PPA blitter
+     */
+    struct Config {
+        int min_pixels = MIN_PIXELS_DEFAULT;    ///< Minimum pixels of the rectangles processed by the PPA
+    };
+
+    /**
+     * @brief Construct a PPA blitter with the default configuration, call `begin()` before using the PPA
+     */
+    BlitterPPA() = default;
+
+    /**
+     * @brief Construct a PPA blitter, call `begin()` before using the PPA
+     *
+     * @param[in] config PPA blitter configuration
+     */
+    BlitterPPA(const Config &config):
+        _config(config)
+    {
+    }
+
+    /**
+     * @brief Destroy the PPA blitter, release the PPA clients
+     */
+    ~BlitterPPA() override;
+
+    /**
+     * @brief Register the PPA clients
+     *
+     * @return `true` if successful, `false` otherwise
+     * @note All operations run on the CPU before this function succeeds
+     */
+    bool begin();
+
+    /**
+     * @brief Unregister the PPA clients
+     *
+     * @return `true` if successful, `false` otherwise
+     */
+    bool del();
+
+    bool fill(const Surface &dst, const Rect &rect, uint32_t argb) override;
+    bool copy(const Surface &src, const Rect &src_rect, const Surface &dst, int x, int y) override;
+    bool rotate(const Surface &src, const Rect &src_rect, const Surface &dst, int x, int y, int degree) override;
+    bool scale(const Surface &src, const Rect &src_rect, const Surface &dst, const Rect &dst_rect) override;
+    bool blend(const Surface &fg, const Rect &fg_rect, const Surface &dst, int x, int y, uint8_t opa = 255) override;
+
+private:
+    bool isBegun() const
+    {
+        return (_srm_client != nullptr) && (_blend_client != nullptr) && (_fill_client != nullptr);
+    }
+
+    bool getInBlock(const Surface &surface, const Rect &rect, ppa_in_pic_blk_config_t &block) const;
+    bool getOutBlock(const Surface &surface, const Rect &rect, ppa_out_pic_blk_config_t &block) const;
+    bool doSRM(
+        const Surface &src, const Rect &src_rect, const Surface &dst, const Rect &dst_rect, int degree, float scale_x,
+        float scale_y
+    );
+
+    Config _config = {};
+    size_t _cache_align = 0;
+    ppa_client_handle_t _srm_client = nullptr;
+    ppa_client_handle_t _blend_client = nullptr;
+    ppa_client_handle_t _fill_client = nullptr;
+};
+#endif // ESP_PANEL_UTILS_BLITTER_PPA_SUPPORTED
+
+/**
+ * @brief Create the fastest blitter of the chip
+ *
+ * @return Begun `BlitterPPA` on the chips with the PPA, otherwise `BlitterCPU`. `nullptr` if failed
+ */
+std::shared_ptr<Blitter> createBlitter();
+
+} // namespace esp_panel::utils
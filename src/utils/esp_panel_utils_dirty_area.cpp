@@ -0,0 +1,128 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <algorithm>
+#include "esp_panel_utils_dirty_area.hpp"
+
+namespace esp_panel::utils {
+
+DirtyAreaMerger::Area DirtyAreaMerger::Area::getUnion(const Area &other) const
+{
+    if (isEmpty()) {
+        return other;
+    }
+    if (other.isEmpty()) {
+        return *this;
+    }
+
+    return Area{
+        .x1 = std::min(x1, other.x1),
+        .y1 = std::min(y1, other.y1),
+        .x2 = std::max(x2, other.x2),
+        .y2 = std::max(y2, other.y2),
+    };
+}
+
+bool DirtyAreaMerger::setConfig(const Config &config)
+{
+    if ((config.width <= 0) || (config.height <= 0) || (config.x_align <= 0) || (config.y_align <= 0)) {
+        return false;
+    }
+
+    _config = config;
+    reset();
+
+    return true;
+}
+
+bool DirtyAreaMerger::add(int x_start, int y_start, int width, int height)
+{
+    if ((x_start < 0) || (y_start < 0) || (width <= 0) || (height <= 0) ||
+            (x_start >= _config.width) || (y_start >= _config.height)) {
+        return false;
+    }
+
+    // Expand to the alignment, then clip to the frame
+    Area area = {
+        .x1 = x_start / _config.x_align * _config.x_align,
+        .y1 = y_start / _config.y_align * _config.y_align,
+        .x2 = (x_start + width + _config.x_align - 1) / _config.x_align * _config.x_align,
+        .y2 = (y_start + height + _config.y_align - 1) / _config.y_align * _config.y_align,
+    };
+    area.x2 = std::min(area.x2, _config.width);
+    area.y2 = std::min(area.y2, _config.height);
+
+    if (_area_num < AREA_MAX_NUM) {
+        _areas[_area_num++] = area;
+        mergeFrom(_area_num - 1);
+
+        return true;
+    }
+
+    // No free slot, merge into the area with the least cost increase
+    int best_index = 0;
+    int64_t best_increase = INT64_MAX;
+    for (int i = 0; i < _area_num; i++) {
+        int64_t increase = static_cast<int64_t>(_areas[i].getUnion(area).getSize()) - _areas[i].getSize();
+        if (increase < best_increase) {
+            best_increase = increase;
+            best_index = i;
+        }
+    }
+    _areas[best_index] = _areas[best_index].getUnion(area);
+    mergeFrom(best_index);
+
+    return true;
+}
+
+uint32_t DirtyAreaMerger::getCost() const
+{
+    uint32_t cost = 0;
+    for (int i = 0; i < _area_num; i++) {
+        cost += getCost(_areas[i]);
+    }
+
+    return cost;
+}
+
+void DirtyAreaMerger::mergeFrom(int index)
+{
+    // The other areas can't be merged with each other, so only the pairs with the changed area need to be checked
+    while (true) {
+        int best_index = -1;
+        int64_t best_gain = -1;
+        for (int i = 0; i < _area_num; i++) {
+            if (i == index) {
+                continue;
+            }
+            int64_t gain = static_cast<int64_t>(getCost(_areas[index])) + getCost(_areas[i]) -
+                           getCost(_areas[index].getUnion(_areas[i]));
+            if (gain > best_gain) {
+                best_gain = gain;
+                best_index = i;
+            }
+        }
+        if (best_index < 0) {
+            break;
+        }
+
+        _areas[index] = _areas[index].getUnion(_areas[best_index]);
+        remove(best_index);
+        if (best_index < index) {
+            index--;
+        }
+    }
+}
+
+void DirtyAreaMerger::remove(int index)
+{
+    for (int i = index; i < _area_num - 1; i++) {
+        _areas[i] = _areas[i + 1];
+    }
+    _area_num--;
+}
+
+} // namespace esp_panel::utils
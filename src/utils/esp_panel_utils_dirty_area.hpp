@@ -0,0 +1,241 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+/**
+ * @note This file is pure C++ and doesn't depend on ESP-IDF, so it can be tested on the host.
+ */
+
+namespace esp_panel::utils {
+
+/**
+ * @brief Merger of the dirty areas in a frame
+ *
+ * Every transfer to a SPI/QSPI panel costs a command sequence (CASET/RASET/RAMWR) besides the pixels. This class
+ * collects the dirty areas of a frame and merges them when sending the bounding box costs less than sending them
+ * separately, so the frame is flushed with the minimum set of transfers.
+ *
+ * The cost of a transfer is `transfer_overhead_px + width * height`, in pixels.
+ */
+class DirtyAreaMerger {
+public:
+    static constexpr int AREA_MAX_NUM = 16;
+    static constexpr uint32_t TRANSFER_OVERHEAD_PX_DEFAULT = 128;
+
+    /**
+     * @brief Rectangle area, the end coordinates are exclusive
+     */
+    struct Area {
+        /**
+         * @brief Get the width of the area
+         *
+         * @return Width in pixels
+         */
+        int getWidth() const
+        {
+            return x2 - x1;
+        }
+
+        /**
+         * @brief Get the height of the area
+         *
+         * @return Height in pixels
+         */
+        int getHeight() const
+        {
+            return y2 - y1;
+        }
+
+        /**
+         * @brief Get the number of pixels in the area
+         *
+         * @return Number of pixels
+         */
+        uint32_t getSize() const
+        {
+            return isEmpty() ? 0 : static_cast<uint32_t>(getWidth()) * static_cast<uint32_t>(getHeight());
+        }
+
+        /**
+         * @brief Check if the area is empty
+         *
+         * @return `true` if empty, `false` otherwise
+         */
+        bool isEmpty() const
+        {
+            return (x2 <= x1) || (y2 <= y1);
+        }
+
+        /**
+         * @brief Check if the area fully contains another one
+         *
+         * @param[in] other The other area
+         * @return `true` if contains, `false` otherwise
+         */
+        bool isContain(const Area &other) const
+        {
+            return (other.x1 >= x1) && (other.y1 >= y1) && (other.x2 <= x2) && (other.y2 <= y2);
+        }
+
+        /**
+         * @brief Get the bounding box of this area and another one
+         *
+         * @param[in] other The other area
+         * @return The bounding box
+         */
+        Area getUnion(const Area &other) const;
+
+        int x1 = 0;     ///< Start X coordinate, inclusive
+        int y1 = 0;     ///< Start Y coordinate, inclusive
+        int x2 = 0;     ///< End X coordinate, exclusive
+        int y2 = 0;     ///< End Y coordinate, exclusive
+    };
+
+    /**
+     * @brief Configuration of the merger
+     */
+    struct Config {
+        int width = 0;                  ///< Width of the frame in pixels
+        int height = 0;                 ///< Height of the frame in pixels
+        int x_align = 1;                ///< Alignment of the X coordinates and width, typically `x_coord_align`
+        int y_align = 1;                ///< Alignment of the Y coordinates and height, typically `y_coord_align`
+        uint32_t transfer_overhead_px = TRANSFER_OVERHEAD_PX_DEFAULT; ///< Cost of one transfer besides the pixels
+    };
+
+    /**
+     * @brief Construct a merger without configuration, call `setConfig()` before adding areas
+     */
+    DirtyAreaMerger() = default;
+
+    /**
+     * @brief Construct a merger with configuration
+     *
+     * @param[in] config Merger configuration
+     */
+    DirtyAreaMerger(const Config &config)
+    {
+        setConfig(config);
+    }
+
+    /**
+     * @brief Set the configuration and clear all areas
+     *
+     * @param[in] config Merger configuration
+     * @return `true` if successful, `false` if the configuration is invalid
+     */
+    bool setConfig(const Config &config);
+
+    /**
+     * @brief Add a dirty area
+     *
+     * The area is expanded to the alignment and clipped to the frame, then merged with the existing areas if it
+     * reduces the total cost. When the areas are full, it is always merged into the cheapest one.
+     *
+     * @param[in] x_start X coordinate of the start point
+     * @param[in] y_start Y coordinate of the start point
+     * @param[in] width Width of the area
+     * @param[in] height Height of the area
+     * @return `true` if successful, `false` if the area is invalid or outside the frame
+     */
+    bool add(int x_start, int y_start, int width, int height);
+
+    /**
+     * @brief Clear all areas
+     */
+    void reset()
+    {
+        _area_num = 0;
+    }
+
+    /**
+     * @brief Get the number of merged areas
+     *
+     * @return Number of areas, which is also the number of transfers
+     */
+    int getAreaNum() const
+    {
+        return _area_num;
+    }
+
+    /**
+     * @brief Get the merged area by index
+     *
+     * @param[in] index Index of the area, the range is [0, `getAreaNum()` - 1]
+     * @return Reference to the area
+     */
+    const Area &getArea(int index) const
+    {
+        return _areas[index];
+    }
+
+    /**
+     * @brief Get the iterator of the first merged area
+     */
+    const Area *begin() const
+    {
+        return _areas.data();
+    }
+
+    /**
+     * @brief Get the iterator after the last merged area
+     */
+    const Area *end() const
+    {
+        return _areas.data() + _area_num;
+    }
+
+    /**
+     * @brief Get the total cost to send all merged areas
+     *
+     * @return Cost in pixels
+     */
+    uint32_t getCost() const;
+
+    /**
+     * @brief Get the cost to send an area
+     *
+     * @param[in] area The area
+     * @return Cost in pixels
+     */
+    uint32_t getCost(const Area &area) const
+    {
+        return _config.transfer_overhead_px + area.getSize();
+    }
+
+    /**
+     * @brief Get the current configuration
+     *
+     * @return Reference to the configuration
+     */
+    const Config &getConfig() const
+    {
+        return _config;
+    }
+
+private:
+    /**
+     * @brief Merge the area at `index` with the others until no merge reduces the cost
+     *
+     * @param[in] index Index of the area which is added or grown
+     */
+    void mergeFrom(int index);
+
+    /**
+     * @brief Remove the area at `index`
+     *
+     * @param[in] index Index of the area
+     */
+    void remove(int index);
+
+    Config _config = {};
+    std::array<Area, AREA_MAX_NUM> _areas = {};
+    int _area_num = 0;
+};
+
+} // namespace esp_panel::utils
@@ -0,0 +1,68 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <algorithm>
+#include <cmath>
+#include "esp_panel_utils_fade.hpp"
+
+namespace esp_panel::utils {
+
+// Lightness where the CIE 1931 formula switches from the linear part to the cubic part
+static constexpr float LIGHTNESS_LINEAR_MAX = 8.0f;
+static constexpr float LIGHTNESS_LINEAR_SCALE = 903.3f;
+
+float convertLightnessToLuminance(float lightness)
+{
+    lightness = std::clamp(lightness, 0.0f, 100.0f);
+    if (lightness <= LIGHTNESS_LINEAR_MAX) {
+        return lightness * 100.0f / LIGHTNESS_LINEAR_SCALE;
+    }
+    float value = (lightness + 16.0f) / 116.0f;
+
+    return std::min(value * value * value * 100.0f, 100.0f);
+}
+
+float convertLuminanceToLightness(float luminance)
+{
+    luminance = std::clamp(luminance, 0.0f, 100.0f);
+    if (luminance <= LIGHTNESS_LINEAR_MAX * 100.0f / LIGHTNESS_LINEAR_SCALE) {
+        return luminance * LIGHTNESS_LINEAR_SCALE / 100.0f;
+    }
+
+    return std::min(116.0f * std::cbrt(luminance / 100.0f) - 16.0f, 100.0f);
+}
+
+FadePlan::FadePlan(float from, float to, int step_num, FadeCurve curve):
+    _from(std::clamp(from, 0.0f, 100.0f)),
+    _to(std::clamp(to, 0.0f, 100.0f)),
+    _step_num(std::max(step_num, 1)),
+    _curve(curve)
+{
+}
+
+float FadePlan::getLevel(int step) const
+{
+    step = std::clamp(step, 0, _step_num);
+    // Return the exact endpoints to avoid the rounding error of the conversions
+    if (step == 0) {
+        return _from;
+    }
+    if (step == _step_num) {
+        return _to;
+    }
+
+    float progress = static_cast<float>(step) / _step_num;
+    if (_curve == FadeCurve::GAMMA) {
+        float from = convertLuminanceToLightness(_from);
+        float to = convertLuminanceToLightness(_to);
+
+        return convertLightnessToLuminance(from + (to - from) * progress);
+    }
+
+    return _from + (_to - _from) * progress;
+}
+
+} // namespace esp_panel::utils
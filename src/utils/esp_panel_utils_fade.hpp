@@ -0,0 +1,83 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @note This file is pure C++ and doesn't depend on ESP-IDF, so it can be tested on the host.
+ */
+
+namespace esp_panel::utils {
+
+/**
+ * @brief Curve of a fade
+ */
+enum class FadeCurve : uint8_t {
+    LINEAR = 0,     ///< Linear in the output level, e.g. PWM duty
+    GAMMA,          ///< Gamma-corrected, linear in the perceived lightness (CIE 1931)
+};
+
+/**
+ * @brief Convert the perceived lightness to the luminance by the CIE 1931 formula
+ *
+ * @param[in] lightness Lightness in percent, the range is [0, 100]
+ * @return Luminance in percent, the range is [0, 100]
+ */
+float convertLightnessToLuminance(float lightness);
+
+/**
+ * @brief Convert the luminance to the perceived lightness, the inverse of `convertLightnessToLuminance()`
+ *
+ * @param[in] luminance Luminance in percent, the range is [0, 100]
+ * @return Lightness in percent, the range is [0, 100]
+ */
+float convertLuminanceToLightness(float luminance);
+
+/**
+ * @brief Planner of the levels of a fade which is split into steps
+ *
+ * The levels are the output levels (e.g. PWM duty) in percent. For the gamma curve, the steps are uniform in the
+ * perceived lightness, so the level changes slowly near the dark end and fast near the bright end.
+ */
+class FadePlan {
+public:
+    /**
+     * @brief Construct a plan
+     *
+     * @param[in] from Level at the start in percent
+     * @param[in] to Level at the end in percent
+     * @param[in] step_num Number of the steps, `1` is used if less than `1`
+     * @param[in] curve Curve of the fade
+     */
+    FadePlan(float from, float to, int step_num, FadeCurve curve);
+
+    /**
+     * @brief Get the level at the end of a step
+     *
+     * @param[in] step Index of the step, `0` means the start and `getStepNum()` means the end, clamped to the range
+     * @return Level in percent
+     */
+    float getLevel(int step) const;
+
+    /**
+     * @brief Get the number of the steps
+     *
+     * @return Number of the steps
+     */
+    int getStepNum() const
+    {
+        return _step_num;
+    }
+
+private:
+    float _from = 0;
+    float _to = 0;
+    int _step_num = 1;
+    FadeCurve _curve = FadeCurve::LINEAR;
+};
+
+} // namespace esp_panel::utils
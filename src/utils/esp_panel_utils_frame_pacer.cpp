@@ -0,0 +1,95 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <algorithm>
+#include "esp_panel_utils_frame_pacer.hpp"
+
+namespace esp_panel::utils {
+
+bool FramePacer::setConfig(const Config &config)
+{
+    if ((config.period_us != 0) && ((config.period_us < PERIOD_MIN_US) || (config.period_us > PERIOD_MAX_US))) {
+        return false;
+    }
+    if (config.margin_us >= PERIOD_MAX_US) {
+        return false;
+    }
+
+    _config = config;
+    _render_history.fill(0);
+    _render_index = 0;
+    _render_estimate_us = 0;
+    _frame_num = 0;
+    _missed_num = 0;
+    _period_us.store(config.period_us, std::memory_order_relaxed);
+    _vsync_num.store(0, std::memory_order_relaxed);
+    _has_vsync.store(false, std::memory_order_relaxed);
+
+    return true;
+}
+
+IRAM_ATTR void FramePacer::notifyVsync(uint32_t time_us)
+{
+    // Learn the period by a low-pass filter, unless it's configured
+    if ((_config.period_us == 0) && _has_vsync.load(std::memory_order_relaxed)) {
+        uint32_t interval = time_us - _vsync_us.load(std::memory_order_relaxed);
+        uint32_t period = _period_us.load(std::memory_order_relaxed);
+        if ((interval >= PERIOD_MIN_US) && (interval <= PERIOD_MAX_US) && ((period == 0) ||
+                (interval <= period + period / 2))) {
+            int32_t diff = static_cast<int32_t>(interval - period);
+            period = (period == 0) ? interval : (period + (diff >> PERIOD_FILTER_SHIFT));
+            _period_us.store(period, std::memory_order_relaxed);
+        }
+    }
+    _vsync_us.store(time_us, std::memory_order_relaxed);
+    _vsync_num.fetch_add(1, std::memory_order_relaxed);
+    _has_vsync.store(true, std::memory_order_release);
+}
+
+FramePacer::Plan FramePacer::schedule(uint32_t earliest_us) const
+{
+    Plan plan = {.start_us = earliest_us, .deadline_us = earliest_us, .is_paced = false};
+    if (!isReady()) {
+        return plan;
+    }
+
+    // Use the times relative to the last vsync, the race with the ISR only makes the deadline one period later
+    uint32_t vsync_us = _vsync_us.load(std::memory_order_acquire);
+    int64_t period = _period_us.load(std::memory_order_relaxed);
+    int64_t earliest = static_cast<int32_t>(earliest_us - vsync_us);
+    if (earliest > period * STALE_PERIODS) {
+        return plan;
+    }
+
+    // The vsync `k` is at `k * period`, find the first one which can be met by starting at `earliest`
+    int64_t need = static_cast<int64_t>(_render_estimate_us) + _config.margin_us;
+    int64_t k = earliest + need;
+    k = (k >= 0) ? ((k + period - 1) / period) : -((-k) / period);
+    int64_t deadline = k * period;
+
+    plan.deadline_us = vsync_us + static_cast<uint32_t>(deadline);
+    plan.start_us = vsync_us + static_cast<uint32_t>(std::max(deadline - need, earliest));
+    plan.is_paced = true;
+
+    return plan;
+}
+
+void FramePacer::notifyRender(const Plan &plan, uint32_t start_us, uint32_t finish_us)
+{
+    // Use the longest recent render time, so a frame rarely misses the deadline after a short one
+    _render_history[_render_index] = finish_us - start_us;
+    _render_index = (_render_index + 1) % RENDER_HISTORY_NUM;
+    _render_estimate_us = *std::max_element(_render_history.begin(), _render_history.end());
+
+    if (!plan.is_paced) {
+        return;
+    }
+    _frame_num++;
+    if (static_cast<int32_t>(finish_us - plan.deadline_us) > 0) {
+        _missed_num++;
+    }
+}
+
+} // namespace esp_panel::utils
@@ -0,0 +1,199 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include "esp_panel_utils_attr.h"
+
+/**
+ * @note This file is pure C++ and doesn't depend on ESP-IDF, so it can be tested on the host.
+ */
+
+namespace esp_panel::utils {
+
+/**
+ * @brief Pacer of the frame rendering by the vsync (refresh finish) events of the panel
+ *
+ * The pacer learns the refresh period from the vsync events and the render time from the recent frames, then
+ * schedules each frame to start as late as possible while still finishing before a vsync. So the rendered content is
+ * the freshest when it's shown, and the frame rate is locked to the refresh rate (or its divisor) instead of beating
+ * against it.
+ *
+ * The usage of each frame is:
+ *
+ * 1. `schedule()` with the earliest time to render, then sleep until the planned start
+ * 2. Render and flush the frame
+ * 3. `notifyRender()` with the plan and the finish time, which counts the missed deadlines
+ *
+ * `notifyVsync()` only uses 32-bit atomic operations and is placed in IRAM, so it can be called from the refresh ISR
+ * (even the IRAM-safe one, as long as the pacer is in internal RAM). The other functions should be called from one
+ * task.
+ */
+class FramePacer {
+public:
+    static constexpr uint32_t PERIOD_MIN_US = 4000;
+    static constexpr uint32_t PERIOD_MAX_US = 100000;
+    static constexpr int PERIOD_FILTER_SHIFT = 3;
+    static constexpr int STALE_PERIODS = 4;
+    static constexpr int RENDER_HISTORY_NUM = 16;
+
+    /**
+     * @brief Configuration of the pacer
+     */
+    struct Config {
+        uint32_t margin_us = 1000;      ///< Time kept between the render finish and the vsync
+        uint32_t period_us = 0;         ///< Refresh period, `0` to learn from the vsync events
+    };
+
+    /**
+     * @brief Schedule of a frame
+     */
+    struct Plan {
+        uint32_t start_us = 0;          ///< Time to start rendering
+        uint32_t deadline_us = 0;       ///< Time of the vsync which the frame should be finished before
+        bool is_paced = false;          ///< Whether the plan is aligned to the vsync, `false` if not ready
+    };
+
+    /**
+     * @brief Construct a pacer with the default configuration
+     */
+    FramePacer() = default;
+
+    /**
+     * @brief Construct a pacer with configuration
+     *
+     * @param[in] config Pacer configuration
+     */
+    FramePacer(const Config &config)
+    {
+        setConfig(config);
+    }
+
+    /**
+     * @brief Set the configuration and clear the learned states and counters
+     *
+     * @param[in] config Pacer configuration
+     * @return `true` if successful, `false` if the configuration is invalid
+     */
+    bool setConfig(const Config &config);
+
+    /**
+     * @brief Notify the vsync event
+     *
+     * The intervals out of [`PERIOD_MIN_US`, `PERIOD_MAX_US`] or longer than 1.5 periods (e.g. the refresh is paused)
+     * are not used to learn the period.
+     *
+     * @param[in] time_us Time of the event
+     */
+    void notifyVsync(uint32_t time_us);
+
+    /**
+     * @brief Schedule a frame
+     *
+     * The deadline is the first vsync which can be met by starting at `earliest_us`, and the start is moved as late
+     * as possible before it by the predicted render time.
+     *
+     * @param[in] earliest_us Earliest time to start rendering, e.g. now or when the GUI timers are due
+     * @return Plan of the frame. If the pacer is not ready or the last vsync event is older than `STALE_PERIODS`
+     *         periods, it starts at `earliest_us` without pacing
+     */
+    Plan schedule(uint32_t earliest_us) const;
+
+    /**
+     * @brief Notify a finished frame to learn the render time and check the deadline
+     *
+     * @param[in] plan Plan of the frame returned by `schedule()`
+     * @param[in] start_us Actual start time of rendering
+     * @param[in] finish_us Finish time of rendering
+     */
+    void notifyRender(const Plan &plan, uint32_t start_us, uint32_t finish_us);
+
+    /**
+     * @brief Check if the period and the time of the vsync are known
+     *
+     * @return `true` if ready, `false` otherwise
+     */
+    bool isReady() const
+    {
+        return (_period_us.load(std::memory_order_relaxed) > 0) && _has_vsync.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Get the refresh period
+     *
+     * @return Period in microseconds, `0` if not learned
+     */
+    uint32_t getPeriodUs() const
+    {
+        return _period_us.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get the predicted render time, which is the longest one of the recent `RENDER_HISTORY_NUM` frames
+     *
+     * @return Render time in microseconds
+     */
+    uint32_t getRenderEstimateUs() const
+    {
+        return _render_estimate_us;
+    }
+
+    /**
+     * @brief Get the number of the paced frames
+     *
+     * @return Number of the frames
+     */
+    uint32_t getFrameNum() const
+    {
+        return _frame_num;
+    }
+
+    /**
+     * @brief Get the number of the paced frames finished after their deadlines
+     *
+     * @return Number of the frames
+     */
+    uint32_t getMissedNum() const
+    {
+        return _missed_num;
+    }
+
+    /**
+     * @brief Get the number of the vsync events
+     *
+     * @return Number of the events
+     */
+    uint32_t getVsyncNum() const
+    {
+        return _vsync_num.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get the current configuration
+     *
+     * @return Reference to the configuration
+     */
+    const Config &getConfig() const
+    {
+        return _config;
+    }
+
+private:
+    Config _config = {};
+    std::array<uint32_t, RENDER_HISTORY_NUM> _render_history = {};
+    int _render_index = 0;
+    uint32_t _render_estimate_us = 0;
+    uint32_t _frame_num = 0;
+    uint32_t _missed_num = 0;
+    std::atomic<uint32_t> _vsync_us = 0;
+    std::atomic<uint32_t> _period_us = 0;
+    std::atomic<uint32_t> _vsync_num = 0;
+    std::atomic<bool> _has_vsync = false;
+};
+
+} // namespace esp_panel::utils
@@ -0,0 +1,188 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <algorithm>
+#include <cstring>
+#include "esp_panel_utils_frame_sync.hpp"
+
+namespace esp_panel::utils {
+
+bool FrameBufferSync::setConfig(const Config &config)
+{
+    if ((config.width <= 0) || (config.height <= 0) || (config.bytes_per_pixel <= 0) ||
+            (config.tile_width <= 0) || (config.tile_height <= 0)) {
+        return false;
+    }
+    if ((config.buffer_num < 2) || (config.buffer_num > BUFFER_NUM_MAX)) {
+        return false;
+    }
+    for (int i = 0; i < config.buffer_num; i++) {
+        if (config.buffers[i] == nullptr) {
+            return false;
+        }
+    }
+
+    _config = config;
+    _tile_cols = (config.width + config.tile_width - 1) / config.tile_width;
+    _tile_rows = (config.height + config.tile_height - 1) / config.tile_height;
+
+    size_t mask_words = (_tile_cols * _tile_rows + 31) / 32;
+    for (auto &mask : _stale_masks) {
+        mask.assign(mask_words, 0);
+    }
+    _covered_mask.assign(mask_words, 0);
+    _draw_index = -1;
+    _latest_index = -1;
+
+    return true;
+}
+
+bool FrameBufferSync::beginFrame(int index)
+{
+    if ((_tile_cols == 0) || (index < 0) || (index >= _config.buffer_num) || (_draw_index >= 0)) {
+        return false;
+    }
+
+    _draw_index = index;
+    std::fill(_covered_mask.begin(), _covered_mask.end(), 0);
+
+    return true;
+}
+
+bool FrameBufferSync::addDirtyArea(int x_start, int y_start, int width, int height)
+{
+    if ((_draw_index < 0) || (x_start < 0) || (y_start < 0) || (width <= 0) || (height <= 0) ||
+            (x_start + width > _config.width) || (y_start + height > _config.height)) {
+        return false;
+    }
+
+    int x_end = x_start + width;
+    int y_end = y_start + height;
+    int col_start = x_start / _config.tile_width;
+    int col_end = (x_end - 1) / _config.tile_width;
+    int row_start = y_start / _config.tile_height;
+    int row_end = (y_end - 1) / _config.tile_height;
+    for (int row = row_start; row <= row_end; row++) {
+        int tile_y = row * _config.tile_height;
+        bool is_row_covered = (tile_y >= y_start) && (std::min(tile_y + _config.tile_height, _config.height) <= y_end);
+        for (int col = col_start; col <= col_end; col++) {
+            int tile = row * _tile_cols + col;
+            for (int i = 0; i < _config.buffer_num; i++) {
+                if (i != _draw_index) {
+                    setMaskBit(_stale_masks[i], tile);
+                }
+            }
+
+            // The tiles at the frame edge may be smaller than the tile size
+            int tile_x = col * _config.tile_width;
+            if (is_row_covered && (tile_x >= x_start) &&
+                    (std::min(tile_x + _config.tile_width, _config.width) <= x_end)) {
+                setMaskBit(_covered_mask, tile);
+            }
+        }
+    }
+
+    return true;
+}
+
+bool FrameBufferSync::syncFrame(size_t *copied_bytes)
+{
+    if (_draw_index < 0) {
+        return false;
+    }
+
+    size_t total_bytes = 0;
+    Mask &stale_mask = _stale_masks[_draw_index];
+    if ((_latest_index >= 0) && (_latest_index != _draw_index)) {
+        for (int row = 0; row < _tile_rows; row++) {
+            int col = 0;
+            while (col < _tile_cols) {
+                int tile = row * _tile_cols + col;
+                if (!getMaskBit(stale_mask, tile) || getMaskBit(_covered_mask, tile)) {
+                    col++;
+                    continue;
+                }
+                // Extend the span over the adjacent tiles to copy
+                int col_end = col + 1;
+                while ((col_end < _tile_cols) && getMaskBit(stale_mask, tile + col_end - col) &&
+                        !getMaskBit(_covered_mask, tile + col_end - col)) {
+                    col_end++;
+                }
+                total_bytes += copyTiles(row, col, col_end);
+                col = col_end;
+            }
+        }
+    }
+    // The tiles which are not copied will be fully drawn
+    std::fill(stale_mask.begin(), stale_mask.end(), 0);
+
+    if (copied_bytes != nullptr) {
+        *copied_bytes = total_bytes;
+    }
+
+    return true;
+}
+
+bool FrameBufferSync::endFrame()
+{
+    if (_draw_index < 0) {
+        return false;
+    }
+
+    _latest_index = _draw_index;
+    _draw_index = -1;
+
+    return true;
+}
+
+int FrameBufferSync::getStaleTileNum(int index) const
+{
+    if ((index < 0) || (index >= _config.buffer_num)) {
+        return 0;
+    }
+
+    int num = 0;
+    for (auto word : _stale_masks[index]) {
+        num += __builtin_popcount(word);
+    }
+
+    return num;
+}
+
+size_t FrameBufferSync::copyTiles(int row, int col_start, int col_end)
+{
+    size_t stride = _config.width * _config.bytes_per_pixel;
+    int x = col_start * _config.tile_width;
+    int width = std::min(col_end * _config.tile_width, _config.width) - x;
+    int y = row * _config.tile_height;
+    int height = std::min(y + _config.tile_height, _config.height) - y;
+    const uint8_t *src = _config.buffers[_latest_index] + y * stride + x * _config.bytes_per_pixel;
+    uint8_t *dst = _config.buffers[_draw_index] + y * stride + x * _config.bytes_per_pixel;
+
+    auto copy = [this](void *to, const void *from, size_t size) {
+        if (_config.copy_func != nullptr) {
+            _config.copy_func(to, from, size, _config.copy_user_data);
+        } else {
+            memcpy(to, from, size);
+        }
+    };
+
+    // The rows are contiguous when the span covers the full width
+    if (width == _config.width) {
+        copy(dst, src, height * stride);
+
+        return height * stride;
+    }
+
+    size_t line_size = width * _config.bytes_per_pixel;
+    for (int i = 0; i < height; i++) {
+        copy(dst + i * stride, src + i * stride, line_size);
+    }
+
+    return height * line_size;
+}
+
+} // namespace esp_panel::utils
@@ -0,0 +1,184 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @note This file is pure C++ and doesn't depend on ESP-IDF, so it can be tested on the host.
+ */
+
+namespace esp_panel::utils {
+
+/**
+ * @brief Synchronizer of the dirty areas between multiple frame buffers
+ *
+ * When the frame buffers are switched to avoid tearing, an area drawn in one buffer is stale in the others. This
+ * class splits the frame into tiles and keeps a stale mask per buffer, so before a buffer is drawn, only its stale
+ * tiles are copied from the latest finished buffer, and the tiles which will be fully redrawn are skipped.
+ *
+ * The usage of each frame is:
+ *
+ * 1. `beginFrame()` with the index of the buffer to be drawn
+ * 2. `addDirtyArea()` for each area to be drawn
+ * 3. `syncFrame()` to copy the stale tiles
+ * 4. Draw the areas into the buffer
+ * 5. `endFrame()`, then the buffer becomes the latest one
+ */
+class FrameBufferSync {
+public:
+    static constexpr int BUFFER_NUM_MAX = 3;
+    static constexpr int TILE_SIZE_DEFAULT = 32;
+
+    /**
+     * @brief Function to copy a span of the frame buffer, should finish the copy before returning
+     *
+     * @param[out] dst Destination address
+     * @param[in] src Source address
+     * @param[in] size Size in bytes
+     * @param[in] user_data User data
+     */
+    using CopyFunction = void (*)(void *dst, const void *src, size_t size, void *user_data);
+
+    /**
+     * @brief Configuration of the synchronizer
+     */
+    struct Config {
+        int width = 0;                  ///< Width of the frame buffers in pixels
+        int height = 0;                 ///< Height of the frame buffers in pixels
+        int bytes_per_pixel = 2;        ///< Bytes per pixel
+        int buffer_num = 2;             ///< Number of the frame buffers, the range is [2, `BUFFER_NUM_MAX`]
+        std::array<uint8_t *, BUFFER_NUM_MAX> buffers = {}; ///< Frame buffers
+        int tile_width = TILE_SIZE_DEFAULT;     ///< Width of the tiles in pixels
+        int tile_height = TILE_SIZE_DEFAULT;    ///< Height of the tiles in pixels
+        CopyFunction copy_func = nullptr;       ///< Function to copy spans, `nullptr` to use `memcpy()`
+        void *copy_user_data = nullptr;         ///< User data of `copy_func`
+    };
+
+    /**
+     * @brief Construct a synchronizer without configuration, call `setConfig()` before using
+     */
+    FrameBufferSync() = default;
+
+    /**
+     * @brief Construct a synchronizer with configuration
+     *
+     * @param[in] config Synchronizer configuration
+     */
+    FrameBufferSync(const Config &config)
+    {
+        setConfig(config);
+    }
+
+    /**
+     * @brief Set the configuration and mark all buffers as synchronized
+     *
+     * @param[in] config Synchronizer configuration
+     * @return `true` if successful, `false` if the configuration is invalid
+     */
+    bool setConfig(const Config &config);
+
+    /**
+     * @brief Begin to draw a frame into the buffer
+     *
+     * @param[in] index Index of the buffer to be drawn
+     * @return `true` if successful, `false` if the index is invalid or a frame is in progress
+     */
+    bool beginFrame(int index);
+
+    /**
+     * @brief Add an area to be drawn in the current frame
+     *
+     * The area becomes stale in the other buffers. The tiles fully covered by the area are skipped by `syncFrame()`,
+     * so all areas should be added before it.
+     *
+     * @param[in] x_start X coordinate of the start point
+     * @param[in] y_start Y coordinate of the start point
+     * @param[in] width Width of the area
+     * @param[in] height Height of the area
+     * @return `true` if successful, `false` if no frame is in progress or the area is invalid
+     */
+    bool addDirtyArea(int x_start, int y_start, int width, int height);
+
+    /**
+     * @brief Copy the stale tiles of the current buffer from the latest finished buffer
+     *
+     * The adjacent stale tiles in a tile row are copied as one span per pixel row, or one span for the whole tile row
+     * if they cover the full width.
+     *
+     * @param[out] copied_bytes Number of the copied bytes, set to `nullptr` if not needed
+     * @return `true` if successful, `false` if no frame is in progress
+     */
+    bool syncFrame(size_t *copied_bytes = nullptr);
+
+    /**
+     * @brief End the current frame, the buffer becomes the latest one
+     *
+     * @return `true` if successful, `false` if no frame is in progress
+     */
+    bool endFrame();
+
+    /**
+     * @brief Get the number of the stale tiles in a buffer
+     *
+     * @param[in] index Index of the buffer
+     * @return Number of the stale tiles, `0` if the index is invalid
+     */
+    int getStaleTileNum(int index) const;
+
+    /**
+     * @brief Get the index of the latest finished buffer
+     *
+     * @return Index of the buffer, `-1` if no frame is finished
+     */
+    int getLatestIndex() const
+    {
+        return _latest_index;
+    }
+
+    /**
+     * @brief Get the current configuration
+     *
+     * @return Reference to the configuration
+     */
+    const Config &getConfig() const
+    {
+        return _config;
+    }
+
+private:
+    using Mask = std::vector<uint32_t>;
+
+    static bool getMaskBit(const Mask &mask, int bit)
+    {
+        return (mask[bit / 32] >> (bit % 32)) & 1;
+    }
+
+    static void setMaskBit(Mask &mask, int bit)
+    {
+        mask[bit / 32] |= (1UL << (bit % 32));
+    }
+
+    /**
+     * @brief Copy the tiles `[col_start, col_end)` of the tile row from the latest buffer to the current one
+     *
+     * @return Number of the copied bytes
+     */
+    size_t copyTiles(int row, int col_start, int col_end);
+
+    Config _config = {};
+    int _tile_cols = 0;
+    int _tile_rows = 0;
+    std::array<Mask, BUFFER_NUM_MAX> _stale_masks = {};
+    Mask _covered_mask;
+    int _draw_index = -1;
+    int _latest_index = -1;
+};
+
+} // namespace esp_panel::utils
@@ -0,0 +1,157 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "esp_panel_utils_i2c_queue.hpp"
+
+namespace esp_panel::utils {
+
+static bool is_before(uint32_t a, uint32_t b)
+{
+    return static_cast<int32_t>(a - b) < 0;
+}
+
+bool I2CQueue::setConfig(const Config &config)
+{
+    if (config.starvation_limit < 0) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    _config = config;
+    _skipped_num.fill(0);
+
+    return true;
+}
+
+bool I2CQueue::push(const Transaction &transaction)
+{
+    if ((transaction.priority >= Priority::MAX) || (transaction.address > 0x7f) ||
+            (transaction.write_size > WRITE_SIZE_MAX)) {
+        return false;
+    }
+    if (((transaction.write_size == 0) && (transaction.read_size == 0)) ||
+            ((transaction.read_size > 0) && (transaction.read_buffer == nullptr))) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_size >= TRANSACTION_NUM_MAX) {
+        _rejected_num++;
+        return false;
+    }
+    for (auto &slot : _slots) {
+        if (!slot.is_used) {
+            slot = {.transaction = transaction, .sequence = _sequence++, .is_used = true};
+            break;
+        }
+    }
+    _size++;
+    _pushed_num++;
+
+    return true;
+}
+
+int I2CQueue::pop(Transaction batch[], int num)
+{
+    if ((batch == nullptr) || (num < 1) || (num > BATCH_NUM_MAX)) {
+        return 0;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_size == 0) {
+        return 0;
+    }
+
+    // Serve the highest priority, unless a lower one has been skipped too many times
+    std::array<int, static_cast<int>(Priority::MAX)> queued_num = {};
+    for (auto &slot : _slots) {
+        if (slot.is_used) {
+            queued_num[static_cast<int>(slot.transaction.priority)]++;
+        }
+    }
+    int served = static_cast<int>(Priority::MAX) - 1;
+    while (queued_num[served] == 0) {
+        served--;
+    }
+    if (_config.starvation_limit > 0) {
+        for (int i = 0; i < served; i++) {
+            if ((queued_num[i] > 0) && (_skipped_num[i] >= _config.starvation_limit)) {
+                served = i;
+                break;
+            }
+        }
+    }
+    for (int i = 0; i < static_cast<int>(Priority::MAX); i++) {
+        _skipped_num[i] = ((i == served) || (queued_num[i] == 0)) ? 0 : (_skipped_num[i] + 1);
+    }
+
+    Slot *slot = &_slots[findOldest(served)];
+    int count = 0;
+    while (true) {
+        batch[count++] = slot->transaction;
+        slot->is_used = false;
+        _size--;
+        if ((count >= num) || !isBatchable(slot->transaction)) {
+            break;
+        }
+
+        // The next transaction to the same device, which should be batchable too
+        Slot *next = nullptr;
+        for (auto &candidate : _slots) {
+            if (candidate.is_used && (candidate.transaction.address == slot->transaction.address) &&
+                    is_before(slot->sequence, candidate.sequence) &&
+                    ((next == nullptr) || is_before(candidate.sequence, next->sequence))) {
+                next = &candidate;
+            }
+        }
+        if ((next == nullptr) || !isBatchable(next->transaction)) {
+            break;
+        }
+        slot = next;
+        _batched_num++;
+    }
+
+    return count;
+}
+
+int I2CQueue::getSize() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _size;
+}
+
+uint32_t I2CQueue::getPushedNum() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _pushed_num;
+}
+
+uint32_t I2CQueue::getRejectedNum() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _rejected_num;
+}
+
+uint32_t I2CQueue::getBatchedNum() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _batched_num;
+}
+
+int I2CQueue::findOldest(int priority) const
+{
+    int oldest = -1;
+    for (int i = 0; i < TRANSACTION_NUM_MAX; i++) {
+        const Slot &slot = _slots[i];
+        if (slot.is_used && (static_cast<int>(slot.transaction.priority) == priority) &&
+                ((oldest < 0) || is_before(slot.sequence, _slots[oldest].sequence))) {
+            oldest = i;
+        }
+    }
+
+    return oldest;
+}
+
+} // namespace esp_panel::utils
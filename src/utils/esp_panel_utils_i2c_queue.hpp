@@ -0,0 +1,186 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+/**
+ * @note This file is pure C++ and doesn't depend on ESP-IDF, so it can be tested on the host.
+ */
+
+namespace esp_panel::utils {
+
+/**
+ * @brief Prioritized queue of the I2C transactions of one port
+ *
+ * The transactions are served by priority, and by the submitted order in the same priority. To keep the waiting time
+ * of the low priorities bounded, a non-empty priority is served once it has been skipped `starvation_limit` times in a
+ * row.
+ *
+ * A batchable write can be sent together with the batchable writes submitted after it to the same device, until a
+ * non-batchable transaction to the device is met. So the device sees the writes in the submitted order, and the bus
+ * is acquired only once for the batch.
+ *
+ * All functions are protected by a mutex, so they can be called from different tasks, but not from the ISR.
+ */
+class I2CQueue {
+public:
+    static constexpr int TRANSACTION_NUM_MAX = 32;
+    static constexpr int WRITE_SIZE_MAX = 16;
+    static constexpr int BATCH_NUM_MAX = 8;
+
+    /**
+     * @brief Priority of the transactions, from the lowest to the highest
+     *
+     * @note `LOW` and `HIGH` are not used since they are macros in Arduino
+     */
+    enum class Priority : uint8_t {
+        BACKGROUND = 0, ///< E.g. the writes of the backlight and the IO expander, which are not urgent
+        NORMAL,         ///< Default priority
+        URGENT,         ///< E.g. the reads of the touch, which affect the latency of the input
+        MAX,
+    };
+
+    struct Transaction;
+
+    /**
+     * @brief Callback of a finished transaction, called from the task which executes it
+     *
+     * @param[in] transaction Finished transaction
+     * @param[in] is_success Whether the transaction is successful
+     * @param[in] user_data User data of the transaction
+     */
+    using Callback = void (*)(const Transaction &transaction, bool is_success, void *user_data);
+
+    /**
+     * @brief An I2C transaction, which writes and then reads with a repeated start
+     */
+    struct Transaction {
+        Priority priority = Priority::NORMAL;   ///< Priority of the transaction
+        uint8_t address = 0;                    ///< 7-bit address of the device
+        uint8_t write_size = 0;                 ///< Number of the bytes to write, including the register
+        std::array<uint8_t, WRITE_SIZE_MAX> write_data = {}; ///< Bytes to write
+        uint8_t *read_buffer = nullptr;         ///< Buffer of the bytes to read, should be valid until finished
+        size_t read_size = 0;                   ///< Number of the bytes to read, `0` to only write
+        bool is_batchable = false;              ///< Whether it can be batched, only used for the writes
+        Callback callback = nullptr;            ///< Callback when finished, `nullptr` to ignore
+        void *user_data = nullptr;              ///< User data passed to the callback
+    };
+
+    /**
+     * @brief Configuration of the queue
+     */
+    struct Config {
+        int starvation_limit = 8;   ///< Times a non-empty priority can be skipped, `0` to always serve by priority
+    };
+
+    /**
+     * @brief Construct a queue with the default configuration
+     */
+    I2CQueue() = default;
+
+    /**
+     * @brief Construct a queue with configuration
+     *
+     * @param[in] config Queue configuration
+     */
+    I2CQueue(const Config &config)
+    {
+        setConfig(config);
+    }
+
+    /**
+     * @brief Set the configuration, the queued transactions are kept
+     *
+     * @param[in] config Queue configuration
+     * @return `true` if successful, `false` if the configuration is invalid
+     */
+    bool setConfig(const Config &config);
+
+    /**
+     * @brief Push a transaction
+     *
+     * @param[in] transaction Transaction to push
+     * @return `true` if successful, `false` if the transaction is invalid or the queue is full
+     */
+    bool push(const Transaction &transaction);
+
+    /**
+     * @brief Pop the next transaction, together with the writes batched with it
+     *
+     * @param[out] batch Array to store the transactions in the order to execute
+     * @param[in] num Size of the array, the range is [1, `BATCH_NUM_MAX`]
+     * @return Number of the popped transactions, `0` if the queue is empty
+     */
+    int pop(Transaction batch[], int num);
+
+    /**
+     * @brief Get the number of the queued transactions
+     *
+     * @return Number of the transactions
+     */
+    int getSize() const;
+
+    /**
+     * @brief Get the number of the pushed transactions
+     *
+     * @return Number of the transactions
+     */
+    uint32_t getPushedNum() const;
+
+    /**
+     * @brief Get the number of the transactions rejected because the queue is full
+     *
+     * @return Number of the transactions
+     */
+    uint32_t getRejectedNum() const;
+
+    /**
+     * @brief Get the number of the transactions popped together with an earlier one in a batch
+     *
+     * @return Number of the transactions
+     */
+    uint32_t getBatchedNum() const;
+
+    /**
+     * @brief Get the current configuration
+     *
+     * @return Reference to the configuration
+     */
+    const Config &getConfig() const
+    {
+        return _config;
+    }
+
+private:
+    struct Slot {
+        Transaction transaction;
+        uint32_t sequence;
+        bool is_used;
+    };
+
+    static bool isBatchable(const Transaction &transaction)
+    {
+        return transaction.is_batchable && (transaction.read_size == 0);
+    }
+
+    int findOldest(int priority) const;
+
+    Config _config = {};
+    mutable std::mutex _mutex;
+    std::array<Slot, TRANSACTION_NUM_MAX> _slots = {};
+    std::array<int, static_cast<int>(Priority::MAX)> _skipped_num = {};
+    int _size = 0;
+    uint32_t _sequence = 0;
+    uint32_t _pushed_num = 0;
+    uint32_t _rejected_num = 0;
+    uint32_t _batched_num = 0;
+};
+
+} // namespace esp_panel::utils
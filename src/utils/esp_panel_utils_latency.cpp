@@ -0,0 +1,215 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include "esp_panel_utils_latency.hpp"
+
+namespace esp_panel::utils {
+
+IRAM_ATTR void LatencyHistogram::record(uint32_t value_us)
+{
+    _buckets[getBucketIndex(value_us)].fetch_add(1, std::memory_order_relaxed);
+    _count.fetch_add(1, std::memory_order_relaxed);
+
+    uint32_t max_us = _max_us.load(std::memory_order_relaxed);
+    while ((value_us > max_us) && !_max_us.compare_exchange_weak(max_us, value_us, std::memory_order_relaxed)) {
+    }
+}
+
+void LatencyHistogram::reset()
+{
+    for (auto &bucket : _buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    _count.store(0, std::memory_order_relaxed);
+    _max_us.store(0, std::memory_order_relaxed);
+}
+
+uint32_t LatencyHistogram::getPercentile(int percent) const
+{
+    // Sum the buckets instead of using `_count`, so the target is consistent with the buckets read below
+    std::array<uint32_t, BUCKETS_NUM> buckets = {};
+    uint64_t total = 0;
+    for (int i = 0; i < BUCKETS_NUM; i++) {
+        buckets[i] = _buckets[i].load(std::memory_order_relaxed);
+        total += buckets[i];
+    }
+    if (total == 0) {
+        return 0;
+    }
+
+    percent = std::clamp(percent, 0, 100);
+    uint64_t target = std::max<uint64_t>((total * percent + 99) / 100, 1);
+    uint64_t sum = 0;
+    int index = BUCKETS_NUM - 1;
+    for (int i = 0; i < BUCKETS_NUM; i++) {
+        sum += buckets[i];
+        if (sum >= target) {
+            index = i;
+            break;
+        }
+    }
+
+    return std::min(getBucketLowerBound(index + 1) - 1, getMax());
+}
+
+IRAM_ATTR int LatencyHistogram::getBucketIndex(uint32_t value_us)
+{
+    value_us = std::min(value_us, VALUE_MAX_US);
+    if (value_us < SUB_BUCKETS_NUM) {
+        return static_cast<int>(value_us);
+    }
+
+    int msb = 31 - __builtin_clz(value_us);
+    int sub = (value_us >> (msb - SUB_BUCKETS_BITS)) & (SUB_BUCKETS_NUM - 1);
+
+    return (msb - SUB_BUCKETS_BITS + 1) * SUB_BUCKETS_NUM + sub;
+}
+
+uint32_t LatencyHistogram::getBucketLowerBound(int index)
+{
+    if (index < SUB_BUCKETS_NUM) {
+        return static_cast<uint32_t>(std::max(index, 0));
+    }
+
+    int group = index / SUB_BUCKETS_NUM;
+    int sub = index % SUB_BUCKETS_NUM;
+
+    return static_cast<uint32_t>(SUB_BUCKETS_NUM + sub) << (group - 1);
+}
+
+void LatencyTracker::notifyTouch(uint32_t time_us)
+{
+    // Keep the earliest touch before the submission, the later ones are shown by the same frame
+    if (!_has_touch.load(std::memory_order_acquire)) {
+        _touch_us.store(time_us, std::memory_order_relaxed);
+        _has_touch.store(true, std::memory_order_release);
+    }
+}
+
+uint32_t LatencyTracker::notifySubmit(uint32_t time_us)
+{
+    uint32_t id = _submit_seq.load(std::memory_order_relaxed);
+    Frame &frame = _frames[id % FRAMES_MAX];
+    if (frame.state.load(std::memory_order_acquire) != FRAME_STATE_FREE) {
+        _dropped_num.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    frame.id = id;
+    frame.submit_us = time_us;
+    frame.has_touch = false;
+    if (_has_touch.exchange(false, std::memory_order_acquire)) {
+        uint32_t touch_us = _touch_us.load(std::memory_order_relaxed);
+        // A stale touch didn't cause this frame
+        if (time_us - touch_us <= _touch_timeout_us) {
+            frame.has_touch = true;
+            frame.touch_us = touch_us;
+            recordStage(Stage::TOUCH_TO_SUBMIT, touch_us, time_us);
+        }
+    }
+    frame.state.store(FRAME_STATE_SUBMITTED, std::memory_order_release);
+    _submit_seq.store(id + 1, std::memory_order_release);
+
+    return id;
+}
+
+IRAM_ATTR void LatencyTracker::notifyTransferDone(uint32_t time_us)
+{
+    uint32_t submit_seq = _submit_seq.load(std::memory_order_acquire);
+    uint32_t seq = _done_seq.load(std::memory_order_relaxed);
+    // The frames overwritten by the submissions are already counted as dropped
+    if (submit_seq - seq > FRAMES_MAX) {
+        seq = submit_seq - FRAMES_MAX;
+    }
+
+    // Complete the oldest submitted frame, and skip the cancelled ones
+    for (; seq != submit_seq; seq++) {
+        Frame &frame = _frames[seq % FRAMES_MAX];
+        if ((frame.id == seq) && (frame.state.load(std::memory_order_acquire) == FRAME_STATE_SUBMITTED)) {
+            frame.done_us = time_us;
+            recordStage(Stage::SUBMIT_TO_DONE, frame.submit_us, time_us);
+            frame.state.store(FRAME_STATE_DONE, std::memory_order_release);
+            seq++;
+            break;
+        }
+    }
+    _done_seq.store(seq, std::memory_order_release);
+}
+
+void LatencyTracker::notifyCancel(uint32_t id)
+{
+    Frame &frame = _frames[id % FRAMES_MAX];
+    uint32_t state = FRAME_STATE_SUBMITTED;
+    if (frame.id == id) {
+        frame.state.compare_exchange_strong(state, FRAME_STATE_FREE, std::memory_order_acq_rel);
+    }
+}
+
+IRAM_ATTR void LatencyTracker::notifyVsync(uint32_t time_us)
+{
+    uint32_t done_seq = _done_seq.load(std::memory_order_acquire);
+    uint32_t seq = _vsync_seq.load(std::memory_order_relaxed);
+    if (done_seq - seq > FRAMES_MAX) {
+        seq = done_seq - FRAMES_MAX;
+    }
+
+    for (; seq != done_seq; seq++) {
+        Frame &frame = _frames[seq % FRAMES_MAX];
+        if ((frame.id != seq) || (frame.state.load(std::memory_order_acquire) != FRAME_STATE_DONE)) {
+            continue;
+        }
+        recordStage(Stage::DONE_TO_VSYNC, frame.done_us, time_us);
+        if (frame.has_touch) {
+            recordStage(Stage::TOUCH_TO_VSYNC, frame.touch_us, time_us);
+        }
+        frame.state.store(FRAME_STATE_FREE, std::memory_order_release);
+    }
+    _vsync_seq.store(done_seq, std::memory_order_relaxed);
+}
+
+IRAM_ATTR void LatencyTracker::recordStage(Stage stage, uint32_t start_us, uint32_t end_us)
+{
+    _histograms[static_cast<int>(stage)].record(end_us - start_us);
+}
+
+void LatencyTracker::reset()
+{
+    for (auto &histogram : _histograms) {
+        histogram.reset();
+    }
+    _dropped_num.store(0, std::memory_order_relaxed);
+}
+
+int LatencyTracker::formatStage(Stage stage, char *buf, size_t size) const
+{
+    auto &histogram = getHistogram(stage);
+
+    return snprintf(
+               buf, size, "%-14s | n %7u | p50 %7u us | p90 %7u us | p99 %7u us | max %7u us", getStageName(stage),
+               static_cast<unsigned>(histogram.getCount()), static_cast<unsigned>(histogram.getPercentile(50)),
+               static_cast<unsigned>(histogram.getPercentile(90)), static_cast<unsigned>(histogram.getPercentile(99)),
+               static_cast<unsigned>(histogram.getMax())
+           );
+}
+
+const char *LatencyTracker::getStageName(Stage stage)
+{
+    switch (stage) {
+    case Stage::TOUCH_TO_SUBMIT:
+        return "touch->submit";
+    case Stage::SUBMIT_TO_DONE:
+        return "submit->done";
+    case Stage::DONE_TO_VSYNC:
+        return "done->vsync";
+    case Stage::TOUCH_TO_VSYNC:
+        return "touch->vsync";
+    default:
+        return "unknown";
+    }
+}
+
+} // namespace esp_panel::utils
@@ -0,0 +1,259 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "esp_panel_utils_attr.h"
+
+/**
+ * @note This file is pure C++ and doesn't depend on ESP-IDF, so it can be tested on the host.
+ */
+
+namespace esp_panel::utils {
+
+/**
+ * @brief Histogram of latencies in microseconds
+ *
+ * The buckets are log-spaced: each power of two is split into `SUB_BUCKETS_NUM` linear buckets, so the relative error
+ * of the percentiles is within 25%. The values beyond `VALUE_MAX_US` are counted in the last bucket.
+ *
+ * `record()` only uses 32-bit atomic operations and is placed in IRAM, so it can be called from ISRs (even the
+ * IRAM-safe ones) and multiple threads. The reads are not synchronized with `record()`, so they might miss the values
+ * recorded at the same time.
+ */
+class LatencyHistogram {
+public:
+    static constexpr int SUB_BUCKETS_BITS = 2;
+    static constexpr int SUB_BUCKETS_NUM = 1 << SUB_BUCKETS_BITS;
+    static constexpr int VALUE_BITS = 24;
+    static constexpr uint32_t VALUE_MAX_US = (1UL << VALUE_BITS) - 1;
+    static constexpr int BUCKETS_NUM = (VALUE_BITS - SUB_BUCKETS_BITS + 1) * SUB_BUCKETS_NUM;
+
+    /**
+     * @brief Record a latency
+     *
+     * @param[in] value_us Latency in microseconds
+     */
+    void record(uint32_t value_us);
+
+    /**
+     * @brief Clear all the records
+     */
+    void reset();
+
+    /**
+     * @brief Get a percentile of the recorded latencies
+     *
+     * @param[in] percent Percentile in [0, 100], e.g. `99` for p99
+     * @return Upper bound of the bucket containing the percentile, limited by the maximum. `0` if no record
+     */
+    uint32_t getPercentile(int percent) const;
+
+    /**
+     * @brief Get the number of the records
+     *
+     * @return Number of the records
+     */
+    uint32_t getCount() const
+    {
+        return _count.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get the maximum of the recorded latencies
+     *
+     * @return Maximum in microseconds, `0` if no record
+     */
+    uint32_t getMax() const
+    {
+        return _max_us.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get the index of the bucket of a value
+     *
+     * @param[in] value_us Value in microseconds
+     * @return Index of the bucket
+     */
+    static int getBucketIndex(uint32_t value_us);
+
+    /**
+     * @brief Get the smallest value of a bucket
+     *
+     * @param[in] index Index of the bucket
+     * @return Value in microseconds
+     */
+    static uint32_t getBucketLowerBound(int index);
+
+private:
+    std::array<std::atomic<uint32_t>, BUCKETS_NUM> _buckets = {};
+    std::atomic<uint32_t> _count = 0;
+    std::atomic<uint32_t> _max_us = 0;
+};
+
+/**
+ * @brief Tracker of the touch-to-photon latency
+ *
+ * The latency of a frame is split into the stages between these events:
+ *
+ *  - Touch: a touch report is read, tagged with the time of the interrupt or the read
+ *  - Submit: a frame is submitted by `drawBitmap()` or `switchFrameBufferTo()`, which gets a sequence ID
+ *  - Transfer done: the frame is transferred to the LCD or the frame buffer
+ *  - Vsync: the LCD starts to show the frame. For the LCDs without the refresh event (e.g. SPI), it's the same as the
+ *    transfer done
+ *
+ * A touch is attributed to the next frame submitted within `touch_timeout_us`, and the earlier touches are preferred
+ * if several reports arrive before the submission. The transfers are completed in the submission order, and a vsync
+ * completes all the transferred frames.
+ *
+ * Each notification is called from one context at a time, e.g. the submissions from the GUI task and the transfer
+ * done from the ISR. They only use 32-bit atomic operations, and the ones of the transfer done and the vsync are placed
+ * in IRAM, so they can be called from the IRAM-safe ISRs as long as the tracker is in internal RAM. The timestamps are
+ * provided by the caller, and wrap around every ~71 minutes, which is fine for the differences.
+ */
+class LatencyTracker {
+public:
+    static constexpr int FRAMES_MAX = 8;
+    static constexpr uint32_t TOUCH_TIMEOUT_US_DEFAULT = 200 * 1000;
+
+    /**
+     * @brief Measured stages
+     */
+    enum class Stage : uint8_t {
+        TOUCH_TO_SUBMIT = 0,    ///< From the touch to the submission of the frame
+        SUBMIT_TO_DONE,         ///< From the submission to the end of the transfer
+        DONE_TO_VSYNC,          ///< From the end of the transfer to the vsync
+        TOUCH_TO_VSYNC,         ///< Total latency from the touch to the vsync
+        MAX,
+    };
+
+    /**
+     * @brief Construct a tracker
+     *
+     * @param[in] touch_timeout_us Maximum time from a touch to the submission of the frame caused by it
+     */
+    LatencyTracker(uint32_t touch_timeout_us = TOUCH_TIMEOUT_US_DEFAULT):
+        _touch_timeout_us(touch_timeout_us)
+    {
+    }
+
+    /**
+     * @brief Record a touch report
+     *
+     * @param[in] time_us Time of the touch in microseconds
+     */
+    void notifyTouch(uint32_t time_us);
+
+    /**
+     * @brief Record a frame submission
+     *
+     * @param[in] time_us Time of the submission in microseconds
+     * @return Sequence ID of the frame
+     */
+    uint32_t notifySubmit(uint32_t time_us);
+
+    /**
+     * @brief Record the end of the transfer of the oldest submitted frame
+     *
+     * @param[in] time_us Time of the end in microseconds
+     */
+    void notifyTransferDone(uint32_t time_us);
+
+    /**
+     * @brief Cancel a submitted frame which is not transferred, e.g. the submission failed
+     *
+     * @param[in] id Sequence ID returned by `notifySubmit()`
+     */
+    void notifyCancel(uint32_t id);
+
+    /**
+     * @brief Record a vsync, which completes all the transferred frames
+     *
+     * @param[in] time_us Time of the vsync in microseconds
+     */
+    void notifyVsync(uint32_t time_us);
+
+    /**
+     * @brief Clear the histograms and the counters
+     *
+     * @note The frames in flight are not affected
+     */
+    void reset();
+
+    /**
+     * @brief Get the histogram of a stage
+     *
+     * @param[in] stage Stage to query
+     * @return Histogram of the stage
+     */
+    const LatencyHistogram &getHistogram(Stage stage) const
+    {
+        return _histograms[static_cast<int>(stage) % static_cast<int>(Stage::MAX)];
+    }
+
+    /**
+     * @brief Get the number of the frames dropped without a transfer done or a vsync, e.g. too many frames in flight
+     *
+     * @return Number of the dropped frames since `reset()`
+     */
+    uint32_t getDroppedNum() const
+    {
+        return _dropped_num.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Format the statistics of a stage as a line of the report, the line is like:
+     *
+     *     "touch->submit  | n     123 | p50    4096 us | p90    6144 us | p99   10240 us | max   11000 us"
+     *
+     * @param[in] stage Stage to format
+     * @param[out] buf Buffer to store the line
+     * @param[in] size Size of the buffer
+     * @return Same as `snprintf()`
+     */
+    int formatStage(Stage stage, char *buf, size_t size) const;
+
+    /**
+     * @brief Get the name of a stage
+     *
+     * @param[in] stage Stage
+     * @return Name of the stage
+     */
+    static const char *getStageName(Stage stage);
+
+private:
+    enum FrameState : uint32_t {
+        FRAME_STATE_FREE = 0,
+        FRAME_STATE_SUBMITTED,
+        FRAME_STATE_DONE,
+    };
+
+    struct Frame {
+        std::atomic<uint32_t> state = FRAME_STATE_FREE;
+        uint32_t id = 0;
+        uint32_t touch_us = 0;
+        uint32_t submit_us = 0;
+        uint32_t done_us = 0;
+        bool has_touch = false;
+    };
+
+    void recordStage(Stage stage, uint32_t start_us, uint32_t end_us);
+
+    uint32_t _touch_timeout_us = TOUCH_TIMEOUT_US_DEFAULT;
+    std::atomic<uint32_t> _touch_us = 0;
+    std::atomic<bool> _has_touch = false;
+    std::atomic<uint32_t> _submit_seq = 0;
+    std::atomic<uint32_t> _done_seq = 0;
+    std::atomic<uint32_t> _vsync_seq = 0;
+    std::atomic<uint32_t> _dropped_num = 0;
+    std::array<Frame, FRAMES_MAX> _frames = {};
+    std::array<LatencyHistogram, static_cast<int>(Stage::MAX)> _histograms = {};
+};
+
+} // namespace esp_panel::utils
@@ -0,0 +1,285 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include "esp_panel_utils_line_store.hpp"
+
+namespace esp_panel::utils {
+
+namespace {
+
+constexpr uint16_t RUN_LITERAL_FLAG = 0x8000;
+
+inline uint16_t readHeader(const uint8_t *data)
+{
+    uint16_t header = 0;
+    memcpy(&header, data, sizeof(header));
+    return header;
+}
+
+inline void writeHeader(uint8_t *data, uint16_t header)
+{
+    memcpy(data, &header, sizeof(header));
+}
+
+/**
+ * @brief Fill `count` pixels with the pixel at `src`, by the widest stores of the pixel size
+ */
+inline void fillPixels(uint8_t *dst, const uint8_t *src, int count, int bytes_per_pixel)
+{
+    switch (bytes_per_pixel) {
+    case 1:
+        memset(dst, src[0], count);
+        break;
+    case 2: {
+        uint16_t pixel = 0;
+        memcpy(&pixel, src, sizeof(pixel));
+        if ((pixel & 0xFF) == (pixel >> 8)) {
+            memset(dst, pixel & 0xFF, count * 2);
+        } else if ((reinterpret_cast<uintptr_t>(dst) & 1) == 0) {
+            std::fill_n(reinterpret_cast<uint16_t *>(dst), count, pixel);
+        } else {
+            for (int i = 0; i < count; i++, dst += 2) {
+                memcpy(dst, &pixel, sizeof(pixel));
+            }
+        }
+        break;
+    }
+    case 4: {
+        uint32_t pixel = 0;
+        memcpy(&pixel, src, sizeof(pixel));
+        if ((reinterpret_cast<uintptr_t>(dst) & 3) == 0) {
+            std::fill_n(reinterpret_cast<uint32_t *>(dst), count, pixel);
+        } else {
+            for (int i = 0; i < count; i++, dst += 4) {
+                memcpy(dst, &pixel, sizeof(pixel));
+            }
+        }
+        break;
+    }
+    default:
+        for (int i = 0; i < count; i++, dst += bytes_per_pixel) {
+            memcpy(dst, src, bytes_per_pixel);
+        }
+        break;
+    }
+}
+
+} // namespace
+
+bool CompressedLineStore::setConfig(const Config &config)
+{
+    if ((config.width <= 0) || (config.height <= 0) || (config.bytes_per_pixel < 1) ||
+            (config.bytes_per_pixel > 4)) {
+        return false;
+    }
+
+    _config = config;
+    _line_bytes = config.width * config.bytes_per_pixel;
+    _line_buffer.assign(_line_bytes, 0);
+    // Every pixel with its own header is the worst case
+    _encode_buffer.assign(config.width * (config.bytes_per_pixel + sizeof(uint16_t)), 0);
+
+    _blank_line_size = encodeLine(_line_buffer.data(), _encode_buffer.data());
+    _blank_line.reset(new (std::nothrow) uint8_t[_blank_line_size]);
+    if (_blank_line == nullptr) {
+        return false;
+    }
+    memcpy(_blank_line.get(), _encode_buffer.data(), _blank_line_size);
+
+    _lines.reset(new (std::nothrow) std::atomic<const uint8_t *>[config.height]);
+    if (_lines == nullptr) {
+        return false;
+    }
+    for (int i = 0; i < config.height; i++) {
+        _lines[i].store(_blank_line.get(), std::memory_order_relaxed);
+    }
+    _owned_lines.clear();
+    _owned_lines.resize(config.height);
+    _line_sizes.assign(config.height, _blank_line_size);
+    _encoded_size = _blank_line_size;
+    _retired.clear();
+
+    return true;
+}
+
+bool CompressedLineStore::writeArea(int x_start, int y_start, int width, int height, const uint8_t *data)
+{
+    if ((_lines == nullptr) || (data == nullptr) || (width <= 0) || (height <= 0) || (x_start < 0) ||
+            (y_start < 0) || (x_start + width > _config.width) || (y_start + height > _config.height)) {
+        return false;
+    }
+
+    releaseLines();
+
+    int bpp = _config.bytes_per_pixel;
+    int area_line_bytes = width * bpp;
+    for (int y = y_start; y < y_start + height; y++, data += area_line_bytes) {
+        const uint8_t *pixels = data;
+        // Only the lines partly written need to be decoded
+        if (width < _config.width) {
+            decodeLine(_lines[y].load(std::memory_order_relaxed), _line_buffer.data());
+            memcpy(_line_buffer.data() + x_start * bpp, data, area_line_bytes);
+            pixels = _line_buffer.data();
+        }
+        if (!replaceLine(y, pixels)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool CompressedLineStore::readLines(int y_start, int lines, uint8_t *buffer)
+{
+    if ((_lines == nullptr) || (buffer == nullptr) || (lines <= 0) || (y_start < 0) ||
+            (y_start + lines > _config.height)) {
+        return false;
+    }
+
+    _is_reading.store(true);
+    for (int y = y_start; y < y_start + lines; y++, buffer += _line_bytes) {
+        decodeLine(_lines[y].load(std::memory_order_acquire), buffer);
+    }
+    _read_seq.fetch_add(1);
+    _is_reading.store(false);
+
+    return true;
+}
+
+bool CompressedLineStore::provideLines(int y_start, int lines, uint8_t *buffer, void *user_data)
+{
+    static_cast<CompressedLineStore *>(user_data)->readLines(y_start, lines, buffer);
+
+    return false;
+}
+
+void CompressedLineStore::collect()
+{
+    releaseLines();
+}
+
+size_t CompressedLineStore::encodeLine(const uint8_t *pixels, uint8_t *encoded) const
+{
+    int bpp = _config.bytes_per_pixel;
+    int width = _config.width;
+    uint8_t *out = encoded;
+    int literal_start = 0;
+    int literal_num = 0;
+
+    auto flush_literal = [&]() {
+        while (literal_num > 0) {
+            int num = std::min(literal_num, RUN_LENGTH_MAX);
+            writeHeader(out, static_cast<uint16_t>(RUN_LITERAL_FLAG | num));
+            memcpy(out + sizeof(uint16_t), pixels + literal_start * bpp, num * bpp);
+            out += sizeof(uint16_t) + num * bpp;
+            literal_start += num;
+            literal_num -= num;
+        }
+    };
+
+    int x = 0;
+    while (x < width) {
+        const uint8_t *pixel = pixels + x * bpp;
+        int repeat = 1;
+        while ((x + repeat < width) && (repeat < RUN_LENGTH_MAX) &&
+                (memcmp(pixel, pixel + repeat * bpp, bpp) == 0)) {
+            repeat++;
+        }
+
+        if (repeat >= REPEAT_LENGTH_MIN) {
+            flush_literal();
+            writeHeader(out, static_cast<uint16_t>(repeat));
+            memcpy(out + sizeof(uint16_t), pixel, bpp);
+            out += sizeof(uint16_t) + bpp;
+            literal_start = x + repeat;
+        } else {
+            literal_num += repeat;
+        }
+        x += repeat;
+    }
+    flush_literal();
+
+    return out - encoded;
+}
+
+void CompressedLineStore::decodeLine(const uint8_t *encoded, uint8_t *pixels) const
+{
+    int bpp = _config.bytes_per_pixel;
+    int remaining = _config.width;
+
+    while (remaining > 0) {
+        uint16_t header = readHeader(encoded);
+        int num = header & RUN_LENGTH_MAX;
+        encoded += sizeof(uint16_t);
+        if (header & RUN_LITERAL_FLAG) {
+            memcpy(pixels, encoded, num * bpp);
+            encoded += num * bpp;
+        } else {
+            fillPixels(pixels, encoded, num, bpp);
+            encoded += bpp;
+        }
+        pixels += num * bpp;
+        remaining -= num;
+    }
+}
+
+bool CompressedLineStore::replaceLine(int y, const uint8_t *pixels)
+{
+    size_t size = encodeLine(pixels, _encode_buffer.data());
+    const uint8_t *old_line = _lines[y].load(std::memory_order_relaxed);
+    if ((size == _line_sizes[y]) && (memcmp(old_line, _encode_buffer.data(), size) == 0)) {
+        return true;
+    }
+
+    EncodedLine new_line = nullptr;
+    const uint8_t *new_ptr = nullptr;
+    if ((size == _blank_line_size) && (memcmp(_blank_line.get(), _encode_buffer.data(), size) == 0)) {
+        new_ptr = _blank_line.get();
+    } else {
+        new_line.reset(new (std::nothrow) uint8_t[size]);
+        if (new_line == nullptr) {
+            return false;
+        }
+        memcpy(new_line.get(), _encode_buffer.data(), size);
+        new_ptr = new_line.get();
+        _encoded_size += size;
+    }
+
+    // Publish the new line first, then the old one can't be loaded by the readings started after this
+    _lines[y].store(new_ptr, std::memory_order_seq_cst);
+    if (_owned_lines[y] != nullptr) {
+        _encoded_size -= _line_sizes[y];
+        RetiredLine retired = {std::move(_owned_lines[y]), 0};
+        if (_is_reading.load()) {
+            // The reading in progress might still use the old line, release it after the reading is finished
+            retired.read_seq = _read_seq.load();
+            _retired.push_back(std::move(retired));
+        }
+    }
+    _owned_lines[y] = std::move(new_line);
+    _line_sizes[y] = size;
+
+    return true;
+}
+
+void CompressedLineStore::releaseLines()
+{
+    if (_retired.empty()) {
+        return;
+    }
+
+    bool is_reading = _is_reading.load();
+    uint32_t read_seq = _read_seq.load();
+    _retired.erase(
+        std::remove_if(_retired.begin(), _retired.end(), [&](const RetiredLine & line) {
+            return !is_reading || (line.read_seq != read_seq);
+        }), _retired.end()
+    );
+}
+
+} // namespace esp_panel::utils
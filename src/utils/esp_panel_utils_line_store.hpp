@@ -0,0 +1,181 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * @note This file is pure C++ and doesn't depend on ESP-IDF, so it can be tested on the host.
+ */
+
+namespace esp_panel::utils {
+
+/**
+ * @brief Frame store which keeps each line compressed by the run-length encoding
+ *
+ * It replaces the full frame buffer of the RGB panels in the stream mode, where the bounce buffers are filled line by
+ * line just in time. The mostly static UIs (e.g. solid backgrounds, texts and icons) are compressed to a small part
+ * of the frame, so the whole frame can be kept in SRAM without PSRAM.
+ *
+ * A line is encoded as runs, each run starts with a 16-bit header:
+ *
+ *  - Bit 15 is `0`: a repeated run, the header is followed by one pixel which is repeated by the count
+ *  - Bit 15 is `1`: a literal run, the header is followed by the count of pixels
+ *  - Bits 0-14 are the count of pixels, the range is [1, `RUN_LENGTH_MAX`]
+ *
+ * There should be only one writer (e.g. `writeArea()` from the drawing task) and one reader (e.g. `readLines()` from
+ * the bounce buffer ISR). The writer publishes the new encoded line by an atomic pointer, and releases the old one
+ * when the reader is idle or has finished a reading since then, so `readLines()` never allocates or blocks.
+ */
+class CompressedLineStore {
+public:
+    static constexpr int RUN_LENGTH_MAX = 0x7FFF;
+    static constexpr int REPEAT_LENGTH_MIN = 4;
+
+    /**
+     * @brief Configuration of the store
+     */
+    struct Config {
+        int width = 0;              ///< Width of the frame in pixels
+        int height = 0;             ///< Height of the frame in pixels
+        int bytes_per_pixel = 2;    ///< Bytes per pixel, the range is [1, 4]
+    };
+
+    /**
+     * @brief Construct a store without configuration, call `setConfig()` before using
+     */
+    CompressedLineStore() = default;
+
+    /**
+     * @brief Construct a store with configuration
+     *
+     * @param[in] config Store configuration
+     */
+    CompressedLineStore(const Config &config)
+    {
+        setConfig(config);
+    }
+
+    CompressedLineStore(const CompressedLineStore &) = delete;
+    CompressedLineStore &operator=(const CompressedLineStore &) = delete;
+
+    /**
+     * @brief Set the configuration and clear all pixels to `0`
+     *
+     * @param[in] config Store configuration
+     * @return `true` if successful, `false` if the configuration is invalid
+     * @note This function should not be called while the reader is running
+     */
+    bool setConfig(const Config &config);
+
+    /**
+     * @brief Write the pixels of an area, the changed lines are encoded again
+     *
+     * @param[in] x_start X coordinate of the start point
+     * @param[in] y_start Y coordinate of the start point
+     * @param[in] width Width of the area
+     * @param[in] height Height of the area
+     * @param[in] data Packed pixels of the area
+     * @return `true` if successful, `false` if the parameters are invalid or the memory is not enough
+     */
+    bool writeArea(int x_start, int y_start, int width, int height, const uint8_t *data);
+
+    /**
+     * @brief Decode the packed pixels of the lines
+     *
+     * @param[in] y_start Index of the first line
+     * @param[in] lines Number of the lines
+     * @param[out] buffer Buffer of at least `lines * width * bytes_per_pixel` bytes
+     * @return `true` if successful, `false` if the parameters are invalid
+     * @note This function doesn't allocate or block, so it can be called from the ISRs
+     */
+    bool readLines(int y_start, int lines, uint8_t *buffer);
+
+    /**
+     * @brief Adapter of `readLines()` for the line provider callbacks
+     *
+     * @param[in] y_start Index of the first line
+     * @param[in] lines Number of the lines
+     * @param[out] buffer Buffer of the pixels
+     * @param[in] user_data Pointer to the store
+     * @return `false`, since no task needs to be woken up
+     */
+    static bool provideLines(int y_start, int lines, uint8_t *buffer, void *user_data);
+
+    /**
+     * @brief Release the old encoded lines which are not read anymore
+     *
+     * It's called by `writeArea()`, so it's only needed when the memory should be released without writing.
+     */
+    void collect();
+
+    /**
+     * @brief Get the bytes of all encoded lines
+     *
+     * @return Encoded size in bytes, the blank lines share one encoded line. The old lines waiting to be released
+     *         are not included
+     */
+    size_t getEncodedSize() const
+    {
+        return _encoded_size;
+    }
+
+    /**
+     * @brief Get the number of the old encoded lines waiting to be released
+     *
+     * @return Number of the lines
+     */
+    size_t getRetiredNum() const
+    {
+        return _retired.size();
+    }
+
+    /**
+     * @brief Get the current configuration
+     *
+     * @return Reference to the configuration
+     */
+    const Config &getConfig() const
+    {
+        return _config;
+    }
+
+private:
+    using EncodedLine = std::unique_ptr<uint8_t[]>;
+
+    /**
+     * @brief Old encoded line, which is released when the read sequence is changed from `read_seq`
+     */
+    struct RetiredLine {
+        EncodedLine data;
+        uint32_t read_seq = 0;
+    };
+
+    size_t encodeLine(const uint8_t *pixels, uint8_t *encoded) const;
+    void decodeLine(const uint8_t *encoded, uint8_t *pixels) const;
+    bool replaceLine(int y, const uint8_t *pixels);
+    void releaseLines();
+
+    Config _config = {};
+    int _line_bytes = 0;
+    std::unique_ptr<std::atomic<const uint8_t *>[]> _lines;
+    std::vector<EncodedLine> _owned_lines;      ///< Encoded lines, `nullptr` for the blank ones
+    std::vector<size_t> _line_sizes;
+    EncodedLine _blank_line;                    ///< Encoded line of the `0` pixels, shared by the blank lines
+    size_t _blank_line_size = 0;
+    size_t _encoded_size = 0;
+    std::vector<RetiredLine> _retired;
+    std::vector<uint8_t> _line_buffer;
+    std::vector<uint8_t> _encode_buffer;
+    std::atomic<bool> _is_reading = false;
+    std::atomic<uint32_t> _read_seq = 0;
+};
+
+} // namespace esp_panel::utils
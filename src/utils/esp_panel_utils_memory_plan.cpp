@@ -0,0 +1,151 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <algorithm>
+#include "esp_panel_utils_memory_plan.hpp"
+
+namespace esp_panel::utils {
+
+MemoryPlanner::MemoryPlanner(const Config &config):
+    _config(config)
+{
+    const int bytes_per_pixel = getBytesPerPixel();
+    const int64_t frame_px = static_cast<int64_t>(std::max(_config.h_res, 0)) * std::max(_config.v_res, 0);
+    const bool has_psram = (_config.psram_bandwidth > 0) && (_config.psram_free_size > 0);
+    int64_t sram_free_size = std::max(_config.sram_free_size, 0);
+    int64_t psram_free_size = has_psram ? _config.psram_free_size : 0;
+    bool is_fit = (frame_px > 0);
+
+    // Frame buffers, prefer PSRAM since they are too large for the SRAM of most chips
+    _plan.fb_num = std::max(_config.fb_num, 0);
+    _plan.fb_size = static_cast<int>(frame_px * bytes_per_pixel);
+    int64_t fb_total_size = static_cast<int64_t>(_plan.fb_size) * _plan.fb_num;
+    if (fb_total_size > 0) {
+        if (fb_total_size <= psram_free_size) {
+            _plan.fb_in_psram = true;
+            psram_free_size -= fb_total_size;
+        } else if (fb_total_size <= sram_free_size) {
+            sram_free_size -= fb_total_size;
+        } else {
+            is_fit = false;
+        }
+    }
+
+    // Bounce buffers, only needed when the frame buffers in PSRAM are scanned out continuously
+    const bool gui_in_fb = (_config.draw_buffer_lines <= 0) || (_config.draw_buffer_num <= 0);
+    if (_plan.fb_in_psram && (_config.pclk_hz > 0) && (_config.bounce_buffer_lines != 0)) {
+        bool is_needed = (_config.bounce_buffer_lines > 0);
+        if (!is_needed) {
+            int64_t rate = getScanoutRate(false, _config.pclk_hz) + getGUI_Rate(gui_in_fb);
+            int64_t budget = static_cast<int64_t>(_config.psram_bandwidth) * (100 - _config.headroom_min_percent);
+            is_needed = (rate * 100 > budget);
+        }
+        int lines = is_needed ? getBounceBufferLines(std::min<int64_t>(sram_free_size, INT32_MAX)) : 0;
+        if (lines > 0) {
+            _plan.bounce_buffer_size_px = _config.h_res * lines;
+            sram_free_size -= 2LL * _plan.bounce_buffer_size_px * bytes_per_pixel;
+        }
+    }
+
+    // Draw buffers, prefer SRAM and shrink them down to `DRAW_BUFFER_LINES_MIN` lines before falling back to PSRAM
+    if (!gui_in_fb) {
+        int lines = std::min(_config.draw_buffer_lines, _config.v_res);
+        int64_t line_size = static_cast<int64_t>(_config.h_res) * bytes_per_pixel * _config.draw_buffer_num;
+        int64_t lines_fit = (line_size > 0) ? (sram_free_size / line_size) : 0;
+        if (lines_fit >= std::min(lines, DRAW_BUFFER_LINES_MIN)) {
+            lines = static_cast<int>(std::min<int64_t>(lines, lines_fit));
+            sram_free_size -= line_size * lines;
+        } else if (line_size * lines <= psram_free_size) {
+            _plan.draw_buffer_in_psram = true;
+            psram_free_size -= line_size * lines;
+        } else {
+            is_fit = false;
+        }
+        _plan.draw_buffer_size_px = _config.h_res * lines;
+        _plan.draw_buffer_num = _config.draw_buffer_num;
+    }
+
+    _plan.sram_used_size = static_cast<int>(std::max(_config.sram_free_size, 0) - sram_free_size);
+    _plan.psram_used_size = static_cast<int>((has_psram ? _config.psram_free_size : 0) - psram_free_size);
+
+    // Bandwidth
+    const bool use_bounce_buffer = (_plan.bounce_buffer_size_px > 0);
+    const bool render_in_psram = _plan.draw_buffer_in_psram || (gui_in_fb && _plan.fb_in_psram);
+    int64_t read_rate = _plan.fb_in_psram ? getScanoutRate(use_bounce_buffer, _config.pclk_hz) : 0;
+    int64_t write_rate = getGUI_Rate(render_in_psram);
+    _plan.psram_read_rate = static_cast<int>(read_rate);
+    _plan.psram_write_rate = static_cast<int>(write_rate);
+    if (_config.psram_bandwidth > 0) {
+        _plan.headroom_percent = static_cast<int>(100 - (read_rate + write_rate) * 100 / _config.psram_bandwidth);
+    } else if (read_rate + write_rate > 0) {
+        _plan.headroom_percent = -100;
+    }
+
+    _plan.pclk_hz_max = -1;
+    if (_plan.fb_in_psram && (_config.pclk_hz > 0) && (_config.psram_bandwidth > 0)) {
+        int64_t budget = static_cast<int64_t>(_config.psram_bandwidth) * (100 - _config.headroom_min_percent) / 100 -
+                         write_rate;
+        int64_t rate_per_mhz = getScanoutRate(use_bounce_buffer, 1000 * 1000);
+        _plan.pclk_hz_max = (budget > 0) ? static_cast<int>(budget * 1000 * 1000 / rate_per_mhz) : 0;
+    }
+
+    _plan.is_feasible = is_fit && (_plan.headroom_percent >= _config.headroom_min_percent);
+}
+
+int MemoryPlanner::getBytesPerPixel() const
+{
+    return (std::max(_config.bits_per_pixel, 1) + 7) / 8;
+}
+
+int64_t MemoryPlanner::getScanoutRate(bool use_bounce_buffer, int pclk_hz) const
+{
+    int64_t rate = static_cast<int64_t>(pclk_hz) * getBytesPerPixel();
+    if (!use_bounce_buffer) {
+        return rate;
+    }
+
+    // The bounce buffers are also filled during the blanking, so only the average rate is needed
+    int64_t active_px = static_cast<int64_t>(_config.h_res) * _config.v_res;
+    int64_t total_px = static_cast<int64_t>(_config.h_res + std::max(_config.h_blank, 0)) *
+                       (_config.v_res + std::max(_config.v_blank, 0));
+
+    return (total_px > 0) ? (rate * active_px / total_px) : rate;
+}
+
+int64_t MemoryPlanner::getGUI_Rate(bool render_in_psram) const
+{
+    int64_t frame_rate = static_cast<int64_t>(_plan.fb_size) * std::max(_config.gui_fps, 0);
+    int64_t rate = 0;
+    // Each updated frame is written to the frame buffer once
+    if (_plan.fb_in_psram) {
+        rate += frame_rate;
+    }
+    // The blending reads back what it renders
+    if (render_in_psram) {
+        rate += frame_rate;
+    }
+
+    return rate;
+}
+
+int MemoryPlanner::getBounceBufferLines(int sram_free_size) const
+{
+    const int bytes_per_pixel = getBytesPerPixel();
+    const int64_t half_frame_px = static_cast<int64_t>(_config.h_res) * _config.v_res / 2;
+    int target_lines = (_config.bounce_buffer_lines > 0) ? _config.bounce_buffer_lines : BOUNCE_BUFFER_LINES_DEFAULT;
+
+    // The same alignment as `BusRGB::configRGB_BounceBufferSize()`, so the size is not adjusted when applied
+    for (int lines = std::min(target_lines, _config.v_res); lines > 0; lines--) {
+        int64_t size_px = static_cast<int64_t>(_config.h_res) * lines;
+        if ((half_frame_px % size_px == 0) && (2 * size_px * bytes_per_pixel <= sram_free_size)) {
+            return lines;
+        }
+    }
+
+    return 0;
+}
+
+} // namespace esp_panel::utils
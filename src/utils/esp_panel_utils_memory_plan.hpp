@@ -0,0 +1,121 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @note This file is pure C++ and doesn't depend on ESP-IDF, so it can be tested on the host.
+ */
+
+namespace esp_panel::utils {
+
+/**
+ * @brief Planner of the display memory: the frame buffers, the bounce buffers and the GUI draw buffers
+ *
+ * The RGB interface reads the frame buffers continuously at `pclk_hz`, so when they are in PSRAM, the PSRAM
+ * bandwidth is shared by the scanout and the GUI writes. The screen drifts if the scanout can't get enough bandwidth.
+ * The planner places the buffers in PSRAM or SRAM, sizes the bounce buffers and the draw buffers, and predicts the
+ * PSRAM bandwidth headroom:
+ *
+ *  - Without bounce buffers, the DMA reads the PSRAM at the peak rate `pclk_hz * bytes_per_pixel` during the active
+ *    area. With bounce buffers, the CPU fills them from the PSRAM during the blanking too, so only the average rate
+ *    is needed.
+ *  - The GUI writes each updated frame to the frame buffer once when it renders into the draw buffers in SRAM, or
+ *    twice (read-modify-write of the blending) when it renders into PSRAM directly.
+ *
+ * The SRAM budget is spent on the bounce buffers first, since they prevent the drift, and then on the draw buffers.
+ */
+class MemoryPlanner {
+public:
+    static constexpr int BOUNCE_BUFFER_LINES_DEFAULT = 10;
+    static constexpr int DRAW_BUFFER_LINES_MIN = 10;
+    // Effective bandwidth of the octal PSRAM of ESP32-S3 at 80 MHz, should be measured for the other chips
+    static constexpr int PSRAM_BANDWIDTH_DEFAULT = 80 * 1000 * 1000;
+
+    /**
+     * @brief Inputs of the planner
+     */
+    struct Config {
+        int h_res = 0;                      ///< Horizontal resolution
+        int v_res = 0;                      ///< Vertical resolution
+        int bits_per_pixel = 16;            ///< Bits per pixel of the frame buffers
+        int h_blank = 0;                    ///< Horizontal blanking in pixels (pulse width + porches)
+        int v_blank = 0;                    ///< Vertical blanking in lines (pulse width + porches)
+        int pclk_hz = 0;                    ///< Pixel clock, `0` if the frame buffers are not scanned out continuously
+        int fb_num = 1;                     ///< Number of the frame buffers
+        int bounce_buffer_lines = -1;       ///< Lines of each bounce buffer, `-1` to decide by the bandwidth, `0`
+                                            ///< to disable
+        int draw_buffer_lines = 20;         ///< Lines of each GUI draw buffer, `0` if the GUI renders into the
+                                            ///< frame buffers directly (e.g. the anti-tearing modes)
+        int draw_buffer_num = 2;            ///< Number of the GUI draw buffers
+        int gui_fps = 30;                   ///< Full-screen updates per second of the GUI in the worst case
+        int psram_bandwidth = PSRAM_BANDWIDTH_DEFAULT; ///< Effective PSRAM bandwidth in bytes per second, `0`
+                                                       ///< if no PSRAM
+        int psram_free_size = 0;            ///< Free PSRAM for the buffers in bytes
+        int sram_free_size = 0;             ///< Free SRAM for the buffers in bytes, excluding the reserved memory
+        int headroom_min_percent = 20;      ///< Minimum bandwidth headroom for a feasible plan
+    };
+
+    /**
+     * @brief Outputs of the planner
+     */
+    struct Plan {
+        bool is_feasible = false;           ///< Whether the buffers fit the memory and the headroom is enough
+        int fb_num = 0;                     ///< Number of the frame buffers
+        int fb_size = 0;                    ///< Size of each frame buffer in bytes
+        bool fb_in_psram = false;           ///< Whether the frame buffers are in PSRAM
+        int bounce_buffer_size_px = 0;      ///< Size of each bounce buffer in pixels, `0` if disabled
+        int draw_buffer_size_px = 0;        ///< Size of each GUI draw buffer in pixels, `0` if not used
+        int draw_buffer_num = 0;            ///< Number of the GUI draw buffers
+        bool draw_buffer_in_psram = false;  ///< Whether the GUI draw buffers are in PSRAM
+        int sram_used_size = 0;             ///< Total SRAM used by the buffers in bytes
+        int psram_used_size = 0;            ///< Total PSRAM used by the buffers in bytes
+        int psram_read_rate = 0;            ///< Predicted PSRAM read rate of the scanout in bytes per second
+        int psram_write_rate = 0;           ///< Predicted PSRAM access rate of the GUI in bytes per second
+        int headroom_percent = 100;         ///< Predicted PSRAM bandwidth headroom, negative if overloaded
+        int pclk_hz_max = -1;               ///< Maximum pixel clock for `headroom_min_percent`, `-1` if not
+                                            ///< limited by the PSRAM
+    };
+
+    /**
+     * @brief Construct a planner and calculate the plan
+     *
+     * @param[in] config Inputs of the planner
+     */
+    MemoryPlanner(const Config &config);
+
+    /**
+     * @brief Get the calculated plan
+     *
+     * @return Plan
+     */
+    const Plan &getPlan() const
+    {
+        return _plan;
+    }
+
+    /**
+     * @brief Get the inputs of the planner
+     *
+     * @return Inputs
+     */
+    const Config &getConfig() const
+    {
+        return _config;
+    }
+
+private:
+    int getBytesPerPixel() const;
+    int64_t getScanoutRate(bool use_bounce_buffer, int pclk_hz) const;
+    int64_t getGUI_Rate(bool render_in_psram) const;
+    int getBounceBufferLines(int sram_free_size) const;
+
+    Config _config = {};
+    Plan _plan = {};
+};
+
+} // namespace esp_panel::utils
@@ -0,0 +1,366 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cstring>
+#include "esp_panel_utils_pixel_convert.hpp"
+
+// The register kernels load the pixels as little-endian words
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "Only little-endian targets are supported");
+
+namespace esp_panel::utils {
+
+namespace {
+
+struct Color {
+    uint8_t r;
+    uint8_t g;
+    uint8_t b;
+};
+
+using ScalarKernel = void (*)(const uint8_t *src, uint8_t *dst, int pixel_num);
+
+constexpr int getFormatBytes(PixelFormat format)
+{
+    switch (format) {
+    case PixelFormat::RGB565:
+    case PixelFormat::RGB565_SWAP:
+        return 2;
+    case PixelFormat::RGB666:
+    case PixelFormat::RGB888:
+    case PixelFormat::BGR888:
+        return 3;
+    case PixelFormat::ARGB8888:
+        return 4;
+    default:
+        return 0;
+    }
+}
+
+inline Color decodeRGB565(uint16_t value)
+{
+    uint8_t r = value >> 11;
+    uint8_t g = (value >> 5) & 0x3F;
+    uint8_t b = value & 0x1F;
+
+    // Replicate the upper bits into the lower bits, so the full range is kept
+    return {static_cast<uint8_t>((r << 3) | (r >> 2)), static_cast<uint8_t>((g << 2) | (g >> 4)),
+            static_cast<uint8_t>((b << 3) | (b >> 2))};
+}
+
+inline uint16_t encodeRGB565(const Color &color)
+{
+    return ((color.r >> 3) << 11) | ((color.g >> 2) << 5) | (color.b >> 3);
+}
+
+inline uint8_t expand6Bits(uint8_t value)
+{
+    return (value & 0xFC) | (value >> 6);
+}
+
+template <PixelFormat Format>
+inline Color readPixel(const uint8_t *pixel)
+{
+    if constexpr (Format == PixelFormat::RGB565) {
+        return decodeRGB565(pixel[0] | (pixel[1] << 8));
+    } else if constexpr (Format == PixelFormat::RGB565_SWAP) {
+        return decodeRGB565((pixel[0] << 8) | pixel[1]);
+    } else if constexpr (Format == PixelFormat::RGB666) {
+        return {expand6Bits(pixel[0]), expand6Bits(pixel[1]), expand6Bits(pixel[2])};
+    } else if constexpr (Format == PixelFormat::RGB888) {
+        return {pixel[0], pixel[1], pixel[2]};
+    } else {
+        // `BGR888` and `ARGB8888`
+        return {pixel[2], pixel[1], pixel[0]};
+    }
+}
+
+template <PixelFormat Format>
+inline void writePixel(uint8_t *pixel, const Color &color)
+{
+    if constexpr (Format == PixelFormat::RGB565) {
+        uint16_t value = encodeRGB565(color);
+        pixel[0] = value & 0xFF;
+        pixel[1] = value >> 8;
+    } else if constexpr (Format == PixelFormat::RGB565_SWAP) {
+        uint16_t value = encodeRGB565(color);
+        pixel[0] = value >> 8;
+        pixel[1] = value & 0xFF;
+    } else if constexpr (Format == PixelFormat::RGB666) {
+        pixel[0] = color.r & 0xFC;
+        pixel[1] = color.g & 0xFC;
+        pixel[2] = color.b & 0xFC;
+    } else if constexpr (Format == PixelFormat::RGB888) {
+        pixel[0] = color.r;
+        pixel[1] = color.g;
+        pixel[2] = color.b;
+    } else {
+        pixel[0] = color.b;
+        pixel[1] = color.g;
+        pixel[2] = color.r;
+        if constexpr (Format == PixelFormat::ARGB8888) {
+            pixel[3] = 0xFF;
+        }
+    }
+}
+
+template <PixelFormat Src, PixelFormat Dst>
+void convertScalar(const uint8_t *src, uint8_t *dst, int pixel_num)
+{
+    constexpr int SRC_BYTES = getFormatBytes(Src);
+    constexpr int DST_BYTES = getFormatBytes(Dst);
+
+    // Each pixel is read before written, so it works in place if the destination pixel is not larger
+    for (int i = 0; i < pixel_num; i++) {
+        writePixel<Dst>(dst + i * DST_BYTES, readPixel<Src>(src + i * SRC_BYTES));
+    }
+}
+
+template <PixelFormat Src>
+ScalarKernel getScalarKernel(PixelFormat dst)
+{
+    switch (dst) {
+    case PixelFormat::RGB565:
+        return convertScalar<Src, PixelFormat::RGB565>;
+    case PixelFormat::RGB565_SWAP:
+        return convertScalar<Src, PixelFormat::RGB565_SWAP>;
+    case PixelFormat::RGB666:
+        return convertScalar<Src, PixelFormat::RGB666>;
+    case PixelFormat::RGB888:
+        return convertScalar<Src, PixelFormat::RGB888>;
+    case PixelFormat::BGR888:
+        return convertScalar<Src, PixelFormat::BGR888>;
+    case PixelFormat::ARGB8888:
+        return convertScalar<Src, PixelFormat::ARGB8888>;
+    default:
+        return nullptr;
+    }
+}
+
+ScalarKernel getScalarKernel(PixelFormat src, PixelFormat dst)
+{
+    switch (src) {
+    case PixelFormat::RGB565:
+        return getScalarKernel<PixelFormat::RGB565>(dst);
+    case PixelFormat::RGB565_SWAP:
+        return getScalarKernel<PixelFormat::RGB565_SWAP>(dst);
+    case PixelFormat::RGB666:
+        return getScalarKernel<PixelFormat::RGB666>(dst);
+    case PixelFormat::RGB888:
+        return getScalarKernel<PixelFormat::RGB888>(dst);
+    case PixelFormat::BGR888:
+        return getScalarKernel<PixelFormat::BGR888>(dst);
+    case PixelFormat::ARGB8888:
+        return getScalarKernel<PixelFormat::ARGB8888>(dst);
+    default:
+        return nullptr;
+    }
+}
+
+/**
+ * Swap the bytes of the two 16-bit pixels in each word
+ */
+void swap16SWAR(const uint32_t *src, uint32_t *dst, int word_num)
+{
+    for (int i = 0; i < word_num; i++) {
+        uint32_t word = src[i];
+        dst[i] = ((word & 0x00FF00FF) << 8) | ((word >> 8) & 0x00FF00FF);
+    }
+}
+
+/**
+ * Transformation of a 24-bit pixel held in the lower bytes of a register, in the memory order
+ */
+struct Transform24 {
+    bool swap_rb;
+    bool truncate_666;
+    bool expand_666;
+
+    inline uint32_t operator()(uint32_t value) const
+    {
+        if (swap_rb) {
+            value = (value & 0x00FF00) | ((value >> 16) & 0xFF) | ((value & 0xFF) << 16);
+        }
+        if (truncate_666) {
+            value &= 0xFCFCFC;
+        } else if (expand_666) {
+            value |= (value >> 6) & 0x030303;
+        }
+        return value;
+    }
+};
+
+/**
+ * Convert groups of 4 pixels between the 24-bit formats, each group is 3 words
+ */
+void convert24SWAR(const uint32_t *src, uint32_t *dst, int group_num, const Transform24 &transform)
+{
+    for (int i = 0; i < group_num; i++, src += 3, dst += 3) {
+        uint32_t w0 = src[0];
+        uint32_t w1 = src[1];
+        uint32_t w2 = src[2];
+        uint32_t p0 = transform(w0 & 0xFFFFFF);
+        uint32_t p1 = transform((w0 >> 24) | ((w1 & 0xFFFF) << 8));
+        uint32_t p2 = transform((w1 >> 16) | ((w2 & 0xFF) << 16));
+        uint32_t p3 = transform(w2 >> 8);
+        dst[0] = p0 | (p1 << 24);
+        dst[1] = (p1 >> 8) | (p2 << 16);
+        dst[2] = (p2 >> 16) | (p3 << 8);
+    }
+}
+
+/**
+ * Pack groups of 4 ARGB8888 pixels into 3 words of the 24-bit formats
+ */
+void pack32To24SWAR(const uint32_t *src, uint32_t *dst, int group_num, const Transform24 &transform)
+{
+    for (int i = 0; i < group_num; i++, src += 4, dst += 3) {
+        uint32_t p0 = transform(src[0] & 0xFFFFFF);
+        uint32_t p1 = transform(src[1] & 0xFFFFFF);
+        uint32_t p2 = transform(src[2] & 0xFFFFFF);
+        uint32_t p3 = transform(src[3] & 0xFFFFFF);
+        dst[0] = p0 | (p1 << 24);
+        dst[1] = (p1 >> 8) | (p2 << 16);
+        dst[2] = (p2 >> 16) | (p3 << 8);
+    }
+}
+
+/**
+ * Unpack groups of 4 pixels of the 24-bit formats into ARGB8888
+ */
+void unpack24To32SWAR(const uint32_t *src, uint32_t *dst, int group_num, const Transform24 &transform)
+{
+    for (int i = 0; i < group_num; i++, src += 3, dst += 4) {
+        uint32_t w0 = src[0];
+        uint32_t w1 = src[1];
+        uint32_t w2 = src[2];
+        dst[0] = transform(w0 & 0xFFFFFF) | 0xFF000000;
+        dst[1] = transform((w0 >> 24) | ((w1 & 0xFFFF) << 8)) | 0xFF000000;
+        dst[2] = transform((w1 >> 16) | ((w2 & 0xFF) << 16)) | 0xFF000000;
+        dst[3] = transform(w2 >> 8) | 0xFF000000;
+    }
+}
+
+inline bool isBGR_Order(PixelFormat format)
+{
+    return (format == PixelFormat::BGR888) || (format == PixelFormat::ARGB8888);
+}
+
+inline bool is24Bits(PixelFormat format)
+{
+    return getFormatBytes(format) == 3;
+}
+
+} // namespace
+
+bool PixelConverter::setConfig(const Config &config)
+{
+    if ((getFormatBytes(config.src_format) == 0) || (getFormatBytes(config.dst_format) == 0)) {
+        return false;
+    }
+
+    _config = config;
+    _is_configured = true;
+
+    return true;
+}
+
+bool PixelConverter::convert(const uint8_t *src, uint8_t *dst, int pixel_num)
+{
+    if ((src == nullptr) || (dst == nullptr) || !_is_configured || (pixel_num < 0)) {
+        return false;
+    }
+
+    if (isCopy()) {
+        if (src != dst) {
+            memmove(dst, src, static_cast<size_t>(pixel_num) * getFormatBytes(_config.src_format));
+        }
+        _last_kernel = Kernel::COPY;
+
+        return true;
+    }
+
+    // The register kernels convert the most pixels, and the per-pixel kernel converts the rest
+    int done_num = 0;
+    _last_kernel = Kernel::SCALAR;
+    if (_config.enable_swar && ((reinterpret_cast<uintptr_t>(src) & 3) == 0) &&
+            ((reinterpret_cast<uintptr_t>(dst) & 3) == 0)) {
+        done_num = convertSWAR(src, dst, pixel_num);
+        if (done_num > 0) {
+            _last_kernel = Kernel::SWAR;
+        }
+    }
+    if (done_num < pixel_num) {
+        getScalarKernel(_config.src_format, _config.dst_format)(
+            src + done_num * getFormatBytes(_config.src_format), dst + done_num * getFormatBytes(_config.dst_format),
+            pixel_num - done_num
+        );
+    }
+
+    return true;
+}
+
+int PixelConverter::getBytesPerPixel(PixelFormat format)
+{
+    return getFormatBytes(format);
+}
+
+const char *PixelConverter::getFormatName(PixelFormat format)
+{
+    switch (format) {
+    case PixelFormat::RGB565:
+        return "RGB565";
+    case PixelFormat::RGB565_SWAP:
+        return "RGB565_SWAP";
+    case PixelFormat::RGB666:
+        return "RGB666";
+    case PixelFormat::RGB888:
+        return "RGB888";
+    case PixelFormat::BGR888:
+        return "BGR888";
+    case PixelFormat::ARGB8888:
+        return "ARGB8888";
+    default:
+        return "unknown";
+    }
+}
+
+int PixelConverter::convertSWAR(const uint8_t *src, uint8_t *dst, int pixel_num)
+{
+    auto src_words = reinterpret_cast<const uint32_t *>(src);
+    auto dst_words = reinterpret_cast<uint32_t *>(dst);
+    PixelFormat src_format = _config.src_format;
+    PixelFormat dst_format = _config.dst_format;
+
+    // The byte swap of RGB565 in both directions
+    if ((getFormatBytes(src_format) == 2) && (getFormatBytes(dst_format) == 2)) {
+        swap16SWAR(src_words, dst_words, pixel_num / 2);
+        return pixel_num / 2 * 2;
+    }
+
+    bool is_src_24 = is24Bits(src_format);
+    bool is_dst_24 = is24Bits(dst_format);
+    Transform24 transform = {
+        .swap_rb = (isBGR_Order(src_format) != isBGR_Order(dst_format)),
+        .truncate_666 = (dst_format == PixelFormat::RGB666),
+        .expand_666 = (src_format == PixelFormat::RGB666),
+    };
+    int group_num = pixel_num / 4;
+    if (is_src_24 && is_dst_24) {
+        convert24SWAR(src_words, dst_words, group_num, transform);
+    } else if ((src_format == PixelFormat::ARGB8888) && is_dst_24) {
+        pack32To24SWAR(src_words, dst_words, group_num, transform);
+    } else if (is_src_24 && (dst_format == PixelFormat::ARGB8888)) {
+        transform.truncate_666 = false;
+        unpack24To32SWAR(src_words, dst_words, group_num, transform);
+    } else {
+        // The conversions between RGB565 and the others are not common on the LCD path
+        return 0;
+    }
+
+    return group_num * 4;
+}
+
+} // namespace esp_panel::utils
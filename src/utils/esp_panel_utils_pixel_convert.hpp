@@ -0,0 +1,146 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @note This file is pure C++ and doesn't depend on ESP-IDF, so it can be tested on the host.
+ */
+
+namespace esp_panel::utils {
+
+/**
+ * @brief Pixel formats, named by their layout in memory
+ */
+enum class PixelFormat : uint8_t {
+    RGB565 = 0,     ///< 16-bit little-endian `RRRRRGGG GGGBBBBB`, the native format of the GUI libraries
+    RGB565_SWAP,    ///< 16-bit big-endian, the format of the LCDs on the SPI/QSPI bus which sends the MSB first
+    RGB666,         ///< 3 bytes `R, G, B`, each component in the upper 6 bits
+    RGB888,         ///< 3 bytes `R, G, B`, the 24-bit format of the LCDs on the SPI/QSPI bus
+    BGR888,         ///< 3 bytes `B, G, R` (little-endian `0xRRGGBB`), the 24-bit format of the RGB/MIPI-DSI bus
+    ARGB8888,       ///< 32-bit little-endian `0xAARRGGBB`, the 32-bit format of the GUI libraries
+    MAX,
+};
+
+/**
+ * @brief Converter of the pixel formats
+ *
+ * The common conversions on the LCD path move several pixels through 32-bit registers when the buffers are 4-byte
+ * aligned, they are the byte swap of RGB565, the R/B swap of the 24-bit formats, the truncation to RGB666 and the
+ * packing of ARGB8888. The others and the unaligned pixels use the portable per-pixel kernels.
+ */
+class PixelConverter {
+public:
+    /**
+     * @brief Kernel used by the last conversion, mainly for the benchmark
+     */
+    enum class Kernel {
+        NONE = 0,
+        COPY,
+        SCALAR,
+        SWAR,
+    };
+
+    /**
+     * @brief Configuration of the converter
+     */
+    struct Config {
+        PixelFormat src_format = PixelFormat::RGB565;   ///< Format of the source pixels
+        PixelFormat dst_format = PixelFormat::RGB565;   ///< Format of the destination pixels
+        bool enable_swar = true;                        ///< Whether to use the 32-bit register kernels when aligned
+    };
+
+    /**
+     * @brief Construct a converter without configuration, call `setConfig()` before converting
+     */
+    PixelConverter() = default;
+
+    /**
+     * @brief Construct a converter with configuration
+     *
+     * @param[in] config Converter configuration
+     */
+    PixelConverter(const Config &config)
+    {
+        setConfig(config);
+    }
+
+    /**
+     * @brief Set the configuration
+     *
+     * @param[in] config Converter configuration
+     * @return `true` if successful, `false` if the configuration is invalid
+     */
+    bool setConfig(const Config &config);
+
+    /**
+     * @brief Convert pixels
+     *
+     * @param[in] src Source pixels
+     * @param[out] dst Destination pixels
+     * @param[in] pixel_num Number of the pixels
+     * @return `true` if successful, `false` if not configured or the parameters are invalid
+     * @note The conversion can be done in place (`src == dst`) if the destination pixel is not larger than the
+     *       source pixel, otherwise the buffers should not overlap
+     */
+    bool convert(const uint8_t *src, uint8_t *dst, int pixel_num);
+
+    /**
+     * @brief Check if the conversion is a plain copy
+     *
+     * @return `true` if the source and destination formats are the same, `false` otherwise
+     */
+    bool isCopy() const
+    {
+        return _config.src_format == _config.dst_format;
+    }
+
+    /**
+     * @brief Get the kernel used by the last conversion
+     *
+     * @return Kernel type
+     */
+    Kernel getLastKernel() const
+    {
+        return _last_kernel;
+    }
+
+    /**
+     * @brief Get the current configuration
+     *
+     * @return Reference to the configuration
+     */
+    const Config &getConfig() const
+    {
+        return _config;
+    }
+
+    /**
+     * @brief Get the bytes per pixel of a format
+     *
+     * @param[in] format Pixel format
+     * @return Bytes per pixel, `0` if the format is invalid
+     */
+    static int getBytesPerPixel(PixelFormat format);
+
+    /**
+     * @brief Get the name of a format
+     *
+     * @param[in] format Pixel format
+     * @return Name of the format
+     */
+    static const char *getFormatName(PixelFormat format);
+
+private:
+    int convertSWAR(const uint8_t *src, uint8_t *dst, int pixel_num);
+
+    Config _config = {};
+    bool _is_configured = false;
+    Kernel _last_kernel = Kernel::NONE;
+};
+
+} // namespace esp_panel::utils
@@ -0,0 +1,125 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <algorithm>
+#include "esp_panel_utils_power.hpp"
+
+namespace esp_panel::utils {
+
+void PowerPolicy::reset(int64_t now_us)
+{
+    _state = State::ACTIVE;
+    _is_static = false;
+    _activity_us = now_us;
+    _frame_us = now_us;
+    _state_enter_us = now_us;
+    _window_start_us = now_us;
+    _window_frames = 0;
+    _frame_rate = 0;
+    _state_time_us.fill(0);
+    _state_enter_num.fill(0);
+    _state_enter_num[static_cast<int>(State::ACTIVE)] = 1;
+}
+
+void PowerPolicy::notifyActivity(int64_t time_us)
+{
+    _activity_us = std::max(_activity_us, time_us);
+}
+
+void PowerPolicy::notifyFrames(int64_t time_us, int num)
+{
+    if (num <= 0) {
+        return;
+    }
+    _frame_us = std::max(_frame_us, time_us);
+    _window_frames += num;
+}
+
+bool PowerPolicy::update(int64_t now_us)
+{
+    // Close the elapsed windows, the rate is `0` if no frame is notified in the last one
+    constexpr int64_t window_us = FRAME_RATE_WINDOW_MS * 1000LL;
+    if (now_us - _window_start_us >= window_us) {
+        int64_t windows_num = (now_us - _window_start_us) / window_us;
+        _frame_rate = (windows_num == 1) ? static_cast<int>(_window_frames * 1000LL / FRAME_RATE_WINDOW_MS) : 0;
+        _window_frames = 0;
+        _window_start_us += windows_num * window_us;
+        if ((_config.active_frame_rate > 0) && (_frame_rate >= _config.active_frame_rate)) {
+            notifyActivity(now_us);
+        }
+    }
+
+    bool is_static = (_config.static_timeout_ms > 0) && (now_us - _frame_us >= _config.static_timeout_ms * 1000LL);
+    bool is_changed = (is_static != _is_static);
+    _is_static = is_static;
+
+    // Enter the deepest state whose timeout is reached
+    const int timeouts_ms[] = {
+        0, _config.dim_timeout_ms, _config.display_off_timeout_ms, _config.touch_sleep_timeout_ms
+    };
+    int64_t idle_us = now_us - _activity_us;
+    State state = State::ACTIVE;
+    for (int i = static_cast<int>(State::DIMMED); i < static_cast<int>(State::MAX); i++) {
+        if ((timeouts_ms[i] > 0) && (idle_us >= timeouts_ms[i] * 1000LL)) {
+            state = static_cast<State>(i);
+        }
+    }
+    if (state != _state) {
+        enterState(state, now_us);
+        is_changed = true;
+    }
+
+    return is_changed;
+}
+
+int64_t PowerPolicy::getStateTimeUs(State state, int64_t now_us) const
+{
+    if ((state < State::ACTIVE) || (state >= State::MAX)) {
+        return 0;
+    }
+
+    int64_t time_us = _state_time_us[static_cast<int>(state)];
+    if (state == _state) {
+        time_us += now_us - _state_enter_us;
+    }
+
+    return time_us;
+}
+
+uint32_t PowerPolicy::getStateEnterNum(State state) const
+{
+    if ((state < State::ACTIVE) || (state >= State::MAX)) {
+        return 0;
+    }
+
+    return _state_enter_num[static_cast<int>(state)];
+}
+
+const char *PowerPolicy::getStateName(State state)
+{
+    switch (state) {
+    case State::ACTIVE:
+        return "active";
+    case State::DIMMED:
+        return "dimmed";
+    case State::DISPLAY_OFF:
+        return "display-off";
+    case State::TOUCH_SLEEP:
+        return "touch-sleep";
+    default:
+        return "unknown";
+    }
+}
+
+void PowerPolicy::enterState(State state, int64_t now_us)
+{
+    _state_time_us[static_cast<int>(_state)] += now_us - _state_enter_us;
+    _state_enter_num[static_cast<int>(state)]++;
+    _state_enter_us = now_us;
+    _state = state;
+}
+
+} // namespace esp_panel::utils
@@ -0,0 +1,173 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+/**
+ * @note This file is pure C++ and doesn't depend on ESP-IDF, so it can be tested on the host.
+ */
+
+namespace esp_panel::utils {
+
+/**
+ * @brief Policy of the power states of a display, driven by the user activity and the frame submissions
+ *
+ * The state is decided by the idle time since the last activity, the deeper state is entered when its timeout is
+ * reached: `ACTIVE -> DIMMED -> DISPLAY_OFF -> TOUCH_SLEEP`. Any activity returns to `ACTIVE`. Besides the touches,
+ * a frame rate higher than `active_frame_rate` (e.g. a video) is also counted as activity.
+ *
+ * Independently of the state, the content is static when no frame is submitted for `static_timeout_ms`, then the
+ * refresh rate can be reduced.
+ *
+ * The functions are not thread-safe. The timestamps are provided by the caller.
+ */
+class PowerPolicy {
+public:
+    static constexpr int FRAME_RATE_WINDOW_MS = 1000;
+
+    /**
+     * @brief Power state
+     */
+    enum class State : uint8_t {
+        ACTIVE = 0,     ///< Full brightness
+        DIMMED,         ///< Reduced brightness
+        DISPLAY_OFF,    ///< Backlight and display are off
+        TOUCH_SLEEP,    ///< Display is off and the touch is sleeping
+        MAX,
+    };
+
+    /**
+     * @brief Configuration of the policy, a timeout less than or equal to `0` disables the state
+     *
+     * @note The timeouts are counted from the last activity, so they should be increasing
+     */
+    struct Config {
+        int dim_timeout_ms = 30 * 1000;             ///< Idle time to enter `DIMMED`
+        int display_off_timeout_ms = 60 * 1000;     ///< Idle time to enter `DISPLAY_OFF`
+        int touch_sleep_timeout_ms = 0;             ///< Idle time to enter `TOUCH_SLEEP`
+        int static_timeout_ms = 1000;               ///< Time without frames to treat the content as static
+        int active_frame_rate = 0;                  ///< Frame rate counted as activity, `0` to ignore the frames
+    };
+
+    /**
+     * @brief Construct a policy with the default configuration, call `reset()` before using
+     */
+    PowerPolicy() = default;
+
+    /**
+     * @brief Construct a policy with configuration, call `reset()` before using
+     *
+     * @param[in] config Policy configuration
+     */
+    PowerPolicy(const Config &config):
+        _config(config)
+    {
+    }
+
+    /**
+     * @brief Enter `ACTIVE` and clear the statistics
+     *
+     * @param[in] now_us Current time in microseconds
+     */
+    void reset(int64_t now_us);
+
+    /**
+     * @brief Record a user activity, e.g. a touch
+     *
+     * @param[in] time_us Time of the activity in microseconds
+     */
+    void notifyActivity(int64_t time_us);
+
+    /**
+     * @brief Record the submitted frames
+     *
+     * @param[in] time_us Time of the last frame in microseconds
+     * @param[in] num Number of the frames since the last call
+     */
+    void notifyFrames(int64_t time_us, int num = 1);
+
+    /**
+     * @brief Update the state and the static flag
+     *
+     * @param[in] now_us Current time in microseconds
+     * @return `true` if the state or the static flag is changed, `false` otherwise
+     */
+    bool update(int64_t now_us);
+
+    /**
+     * @brief Get the current state
+     *
+     * @return Current state
+     */
+    State getState() const
+    {
+        return _state;
+    }
+
+    /**
+     * @brief Check if the content is static
+     *
+     * @return `true` if static, `false` otherwise
+     */
+    bool isContentStatic() const
+    {
+        return _is_static;
+    }
+
+    /**
+     * @brief Get the frame rate of the last complete window of `FRAME_RATE_WINDOW_MS`
+     *
+     * @return Frame rate in frames per second
+     */
+    int getFrameRate() const
+    {
+        return _frame_rate;
+    }
+
+    /**
+     * @brief Get the total time spent in a state since `reset()`, including the current one
+     *
+     * @param[in] state State to query
+     * @param[in] now_us Current time in microseconds
+     * @return Time in microseconds
+     */
+    int64_t getStateTimeUs(State state, int64_t now_us) const;
+
+    /**
+     * @brief Get the number of the times a state is entered since `reset()`
+     *
+     * @param[in] state State to query
+     * @return Number of the times
+     */
+    uint32_t getStateEnterNum(State state) const;
+
+    /**
+     * @brief Get the name of a state
+     *
+     * @param[in] state State
+     * @return Name of the state
+     */
+    static const char *getStateName(State state);
+
+private:
+    void enterState(State state, int64_t now_us);
+
+    Config _config = {};
+    State _state = State::ACTIVE;
+    bool _is_static = false;
+    int64_t _activity_us = 0;
+    int64_t _frame_us = 0;
+    int64_t _state_enter_us = 0;
+    int64_t _window_start_us = 0;
+    int _window_frames = 0;
+    int _frame_rate = 0;
+    std::array<int64_t, static_cast<int>(State::MAX)> _state_time_us = {};
+    std::array<uint32_t, static_cast<int>(State::MAX)> _state_enter_num = {};
+};
+
+} // namespace esp_panel::utils
@@ -0,0 +1,114 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include "esp_panel_utils_profiler.hpp"
+
+namespace esp_panel::utils {
+
+// Nesting depth of the calling thread, shared by all profilers
+static thread_local int current_depth = 0;
+
+Profiler::Profiler(int records_max):
+    _records_max(std::max(records_max, 0))
+{
+    _records.reserve(_records_max);
+}
+
+int Profiler::begin(const char *name, int arg, int64_t time_us)
+{
+    int id = addRecord({name, arg, current_depth, time_us, -1});
+    current_depth++;
+
+    return id;
+}
+
+void Profiler::end(int id, int64_t time_us)
+{
+    if (current_depth > 0) {
+        current_depth--;
+    }
+    if (id < 0) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (id < static_cast<int>(_records.size())) {
+        _records[id].end_us = time_us;
+    }
+}
+
+void Profiler::add(const char *name, int arg, int64_t start_us, int64_t end_us)
+{
+    addRecord({name, arg, current_depth, start_us, end_us});
+}
+
+void Profiler::clear()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _records.clear();
+    _dropped_num = 0;
+}
+
+int Profiler::getRecords(Record records[], int num, int offset) const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if ((offset < 0) || (offset >= static_cast<int>(_records.size()))) {
+        return 0;
+    }
+    int copy_num = std::min(num, static_cast<int>(_records.size()) - offset);
+    std::copy(_records.begin() + offset, _records.begin() + offset + copy_num, records);
+
+    return copy_num;
+}
+
+int Profiler::getRecordsNum() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    return static_cast<int>(_records.size());
+}
+
+int Profiler::getDroppedNum() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    return _dropped_num;
+}
+
+int Profiler::formatRecord(const Record &record, int64_t base_us, char *buf, size_t size)
+{
+    char duration[24] = "unfinished";
+    if (record.end_us >= 0) {
+        snprintf(duration, sizeof(duration), "%8" PRId64 " us", record.getDurationUs());
+    }
+
+    char arg[16] = "";
+    if (record.arg != ARG_NONE) {
+        snprintf(arg, sizeof(arg), "[0x%02X]", record.arg);
+    }
+
+    return snprintf(
+               buf, size, "+%8" PRId64 " us | %11s | %*s%s%s", record.start_us - base_us, duration, record.depth * 2,
+               "", (record.name != nullptr) ? record.name : "?", arg
+           );
+}
+
+int Profiler::addRecord(const Record &record)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (static_cast<int>(_records.size()) >= _records_max) {
+        _dropped_num++;
+        return -1;
+    }
+    _records.push_back(record);
+
+    return static_cast<int>(_records.size()) - 1;
+}
+
+} // namespace esp_panel::utils
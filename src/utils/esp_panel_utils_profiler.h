@@ -0,0 +1,113 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+/**
+ * @brief Hooks of the boot profiler for both C and C++
+ *
+ * The stages are recorded into a global profiler with the time of `esp_timer_get_time()`. When
+ * `ESP_PANEL_DRIVERS_ENABLE_PROFILER` is disabled, all hooks are expanded to nothing.
+ *
+ * @note This file shouldn't be included in the public header file.
+ */
+
+#include <stdint.h>
+#include "drivers/esp_panel_drivers_conf_internal.h"
+
+#if ESP_PANEL_DRIVERS_ENABLE_PROFILER
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Begin a stage, see `esp_panel::utils::Profiler::begin()`
+ *
+ * @param[in] name Name of the stage, should be a string literal
+ * @param[in] arg Argument of the stage, `-1` if not used
+ * @return ID of the record for `esp_panel_utils_profiler_end()`
+ */
+int esp_panel_utils_profiler_begin(const char *name, int arg);
+
+/**
+ * @brief End a stage, see `esp_panel::utils::Profiler::end()`
+ *
+ * @param[in] id ID returned by `esp_panel_utils_profiler_begin()`
+ */
+void esp_panel_utils_profiler_end(int id);
+
+/**
+ * @brief Add a finished stage, see `esp_panel::utils::Profiler::add()`
+ *
+ * @param[in] name Name of the stage, should be a string literal
+ * @param[in] arg Argument of the stage, `-1` if not used
+ * @param[in] start_us Start time in `esp_timer_get_time()` microseconds
+ * @param[in] end_us End time in `esp_timer_get_time()` microseconds
+ */
+void esp_panel_utils_profiler_add(const char *name, int arg, int64_t start_us, int64_t end_us);
+
+/**
+ * @brief Remove all records
+ */
+void esp_panel_utils_profiler_clear(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#define ESP_PANEL_PROFILER_ADD(name, arg, start_us, end_us) \
+    esp_panel_utils_profiler_add(name, arg, start_us, end_us)
+#define ESP_PANEL_PROFILER_CLEAR() esp_panel_utils_profiler_clear()
+
+#ifdef __cplusplus
+#include "esp_panel_utils_profiler.hpp"
+
+namespace esp_panel::utils {
+
+/**
+ * @brief Get the global profiler used by the hooks
+ *
+ * @return Reference to the profiler
+ */
+Profiler &getBootProfiler();
+
+/**
+ * @brief Record the stage of the enclosing scope
+ */
+class ProfilerScope {
+public:
+    ProfilerScope(const char *name, int arg = Profiler::ARG_NONE):
+        _id(esp_panel_utils_profiler_begin(name, arg))
+    {
+    }
+
+    ~ProfilerScope()
+    {
+        esp_panel_utils_profiler_end(_id);
+    }
+
+    ProfilerScope(const ProfilerScope &) = delete;
+    ProfilerScope &operator=(const ProfilerScope &) = delete;
+
+private:
+    int _id;
+};
+
+} // namespace esp_panel::utils
+
+#define _ESP_PANEL_PROFILER_SCOPE_NAME(line) _profiler_scope_ ## line
+#define ESP_PANEL_PROFILER_SCOPE_NAME(line) _ESP_PANEL_PROFILER_SCOPE_NAME(line)
+#define ESP_PANEL_PROFILER_SCOPE(name) \
+    esp_panel::utils::ProfilerScope ESP_PANEL_PROFILER_SCOPE_NAME(__LINE__)(name)
+#endif // __cplusplus
+
+#else
+
+#define ESP_PANEL_PROFILER_ADD(name, arg, start_us, end_us)
+#define ESP_PANEL_PROFILER_CLEAR()
+#define ESP_PANEL_PROFILER_SCOPE(name)
+
+#endif // ESP_PANEL_DRIVERS_ENABLE_PROFILER
@@ -0,0 +1,142 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+/**
+ * @note This file is pure C++ and doesn't depend on ESP-IDF, so it can be tested on the host.
+ */
+
+namespace esp_panel::utils {
+
+/**
+ * @brief Recorder of the time spent in nested stages
+ *
+ * The stages are recorded in the order they begin, with the nesting depth of the calling thread, so the records can
+ * be printed as a tree. The memory of the records is allocated once at construction, and the records beyond the
+ * capacity are dropped and counted.
+ *
+ * All functions are thread-safe. The timestamps are provided by the caller.
+ */
+class Profiler {
+public:
+    static constexpr int RECORDS_MAX_DEFAULT = 128;
+    static constexpr int ARG_NONE = -1;
+
+    /**
+     * @brief Record of a stage
+     */
+    struct Record {
+        const char *name = nullptr; ///< Name of the stage, should be a string literal
+        int arg = ARG_NONE;         ///< Argument to distinguish the stages with the same name, e.g. command code
+        int depth = 0;              ///< Nesting depth, `0` means the top level
+        int64_t start_us = 0;       ///< Start time in microseconds
+        int64_t end_us = -1;        ///< End time in microseconds, `-1` if the stage is not ended
+
+        /**
+         * @brief Get the duration of the stage
+         *
+         * @return Duration in microseconds, `-1` if the stage is not ended
+         */
+        int64_t getDurationUs() const
+        {
+            return (end_us < 0) ? -1 : (end_us - start_us);
+        }
+    };
+
+    /**
+     * @brief Construct a profiler
+     *
+     * @param[in] records_max Maximum number of the records
+     */
+    Profiler(int records_max = RECORDS_MAX_DEFAULT);
+
+    /**
+     * @brief Begin a stage, which is nested in the unfinished stages of the calling thread
+     *
+     * @param[in] name Name of the stage, should be a string literal
+     * @param[in] arg Argument of the stage, `ARG_NONE` if not used
+     * @param[in] time_us Current time in microseconds
+     * @return ID of the record for `end()`, `-1` if the record is dropped
+     */
+    int begin(const char *name, int arg, int64_t time_us);
+
+    /**
+     * @brief End a stage
+     *
+     * @param[in] id ID returned by `begin()`, `-1` is accepted to keep the nesting depth
+     * @param[in] time_us Current time in microseconds
+     */
+    void end(int id, int64_t time_us);
+
+    /**
+     * @brief Add a finished stage at the current nesting depth of the calling thread
+     *
+     * @param[in] name Name of the stage, should be a string literal
+     * @param[in] arg Argument of the stage, `ARG_NONE` if not used
+     * @param[in] start_us Start time in microseconds
+     * @param[in] end_us End time in microseconds
+     */
+    void add(const char *name, int arg, int64_t start_us, int64_t end_us);
+
+    /**
+     * @brief Remove all records
+     *
+     * @note The nesting depth of the threads is not changed, so the unfinished stages should be ended before calling
+     */
+    void clear();
+
+    /**
+     * @brief Copy the records
+     *
+     * @param[out] records Buffer to store the records
+     * @param[in] num Maximum number of the records to copy
+     * @param[in] offset Index of the first record to copy
+     * @return Number of the copied records
+     */
+    int getRecords(Record records[], int num, int offset = 0) const;
+
+    /**
+     * @brief Get the number of the records
+     *
+     * @return Number of the records
+     */
+    int getRecordsNum() const;
+
+    /**
+     * @brief Get the number of the dropped records since the last `clear()`
+     *
+     * @return Number of the dropped records
+     */
+    int getDroppedNum() const;
+
+    /**
+     * @brief Format a record as a line of the report, the line is like:
+     *
+     *     "+    1234 us |      567 us | name[0x11]", and the name is indented by the depth
+     *
+     * @param[in] record Record to format
+     * @param[in] base_us Base time of the start offsets, usually the start time of the first record
+     * @param[out] buf Buffer to store the line
+     * @param[in] size Size of the buffer
+     * @return Same as `snprintf()`
+     */
+    static int formatRecord(const Record &record, int64_t base_us, char *buf, size_t size);
+
+private:
+    int addRecord(const Record &record);
+
+    mutable std::mutex _mutex;
+    std::vector<Record> _records;
+    int _records_max = 0;
+    int _dropped_num = 0;
+};
+
+} // namespace esp_panel::utils
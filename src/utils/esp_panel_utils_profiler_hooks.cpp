@@ -0,0 +1,45 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "esp_panel_utils_profiler.h"
+#if ESP_PANEL_DRIVERS_ENABLE_PROFILER
+
+#include "esp_timer.h"
+
+namespace esp_panel::utils {
+
+Profiler &getBootProfiler()
+{
+    static Profiler profiler(ESP_PANEL_DRIVERS_PROFILER_MAX_RECORDS);
+
+    return profiler;
+}
+
+} // namespace esp_panel::utils
+
+using esp_panel::utils::getBootProfiler;
+
+extern "C" int esp_panel_utils_profiler_begin(const char *name, int arg)
+{
+    return getBootProfiler().begin(name, arg, esp_timer_get_time());
+}
+
+extern "C" void esp_panel_utils_profiler_end(int id)
+{
+    getBootProfiler().end(id, esp_timer_get_time());
+}
+
+extern "C" void esp_panel_utils_profiler_add(const char *name, int arg, int64_t start_us, int64_t end_us)
+{
+    getBootProfiler().add(name, arg, start_us, end_us);
+}
+
+extern "C" void esp_panel_utils_profiler_clear(void)
+{
+    getBootProfiler().clear();
+}
+
+#endif // ESP_PANEL_DRIVERS_ENABLE_PROFILER
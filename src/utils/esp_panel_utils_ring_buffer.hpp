@@ -0,0 +1,114 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @note This file is pure C++ and doesn't depend on ESP-IDF, so it can be tested on the host.
+ */
+
+namespace esp_panel::utils {
+
+/**
+ * @brief Lock-free ring buffer for a single producer and a single consumer
+ *
+ * The producer only writes the head index and the consumer only writes the tail index, so `push()` can be called
+ * from one task while `pop()` is called from another without any lock. The indexes run freely and are masked when
+ * accessing the items, so all `N` slots are usable.
+ *
+ * @tparam T Type of the items, should be copy assignable
+ * @tparam N Number of the items, should be a power of 2
+ */
+template <typename T, size_t N>
+class RingBuffer {
+public:
+    static_assert((N > 0) && ((N & (N - 1)) == 0), "The size should be a power of 2");
+
+    /**
+     * @brief Push an item, only called by the producer
+     *
+     * @param[in] item Item to push
+     * @return `true` if successful, `false` if the buffer is full
+     */
+    bool push(const T &item)
+    {
+        uint32_t head = _head.load(std::memory_order_relaxed);
+        if (head - _tail.load(std::memory_order_acquire) >= N) {
+            return false;
+        }
+        _items[head & (N - 1)] = item;
+        _head.store(head + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    /**
+     * @brief Pop the oldest item, only called by the consumer
+     *
+     * @param[out] item Popped item
+     * @return `true` if successful, `false` if the buffer is empty
+     */
+    bool pop(T &item)
+    {
+        uint32_t tail = _tail.load(std::memory_order_relaxed);
+        if (tail == _head.load(std::memory_order_acquire)) {
+            return false;
+        }
+        item = _items[tail & (N - 1)];
+        _tail.store(tail + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    /**
+     * @brief Drop all items, only called by the consumer
+     */
+    void clear()
+    {
+        _tail.store(_head.load(std::memory_order_acquire), std::memory_order_release);
+    }
+
+    /**
+     * @brief Get the number of the items, may be outdated once returned if the other side is running
+     *
+     * @return Number of the items
+     */
+    size_t size() const
+    {
+        return _head.load(std::memory_order_acquire) - _tail.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Check if the buffer is empty
+     *
+     * @return `true` if empty, `false` otherwise
+     */
+    bool empty() const
+    {
+        return (size() == 0);
+    }
+
+    /**
+     * @brief Get the capacity of the buffer
+     *
+     * @return Number of the items
+     */
+    static constexpr size_t capacity()
+    {
+        return N;
+    }
+
+private:
+    std::array<T, N> _items = {};
+    std::atomic<uint32_t> _head = 0;
+    std::atomic<uint32_t> _tail = 0;
+};
+
+} // namespace esp_panel::utils
@@ -0,0 +1,354 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <algorithm>
+#include <cstring>
+#include "esp_panel_utils_rotate.hpp"
+
+namespace esp_panel::utils {
+
+namespace {
+
+struct Pixel24 {
+    uint8_t data[3];
+};
+
+struct Frame {
+    const uint8_t *src;
+    uint8_t *dst;
+    int width;
+    int height;
+};
+
+struct Area {
+    int x1;
+    int y1;
+    int x2;
+    int y2;
+};
+
+/**
+ * Transpose a 4x4 block of bytes, `row[i]` holds the bytes `(0..3, i)` and `col[k]` gets the bytes `(k, 0..3)`
+ */
+inline void transpose4x4Bytes(uint32_t row0, uint32_t row1, uint32_t row2, uint32_t row3, uint32_t col[4])
+{
+    uint32_t even01 = (row0 & 0x00FF00FF) | ((row1 & 0x00FF00FF) << 8);
+    uint32_t odd01 = ((row0 >> 8) & 0x00FF00FF) | (row1 & 0xFF00FF00);
+    uint32_t even23 = (row2 & 0x00FF00FF) | ((row3 & 0x00FF00FF) << 8);
+    uint32_t odd23 = ((row2 >> 8) & 0x00FF00FF) | (row3 & 0xFF00FF00);
+
+    col[0] = (even01 & 0x0000FFFF) | (even23 << 16);
+    col[1] = (odd01 & 0x0000FFFF) | (odd23 << 16);
+    col[2] = (even01 >> 16) | (even23 & 0xFFFF0000);
+    col[3] = (odd01 >> 16) | (odd23 & 0xFFFF0000);
+}
+
+template <typename T>
+void rotate180Scalar(const Frame &frame, const Area &area)
+{
+    auto src = reinterpret_cast<const T *>(frame.src);
+    auto dst = reinterpret_cast<T *>(frame.dst);
+    for (int y = area.y1; y < area.y2; y++) {
+        const T *from = src + y * frame.width + area.x1;
+        T *to = dst + (frame.height - 1 - y) * frame.width + (frame.width - 1 - area.x1);
+        for (int x = area.x1; x < area.x2; x++) {
+            *to-- = *from++;
+        }
+    }
+}
+
+template <typename T, bool IS_270>
+void rotateTiledScalar(const Frame &frame, const Area &area, int tile_size)
+{
+    auto src = reinterpret_cast<const T *>(frame.src);
+    auto dst = reinterpret_cast<T *>(frame.dst);
+    for (int tile_y = area.y1; tile_y < area.y2; tile_y += tile_size) {
+        int tile_y_end = std::min(tile_y + tile_size, area.y2);
+        for (int tile_x = area.x1; tile_x < area.x2; tile_x += tile_size) {
+            int tile_x_end = std::min(tile_x + tile_size, area.x2);
+            // Each source column of the tile becomes a destination row, which is written sequentially
+            for (int x = tile_x; x < tile_x_end; x++) {
+                const T *from = src + tile_y * frame.width + x;
+                if constexpr (IS_270) {
+                    T *to = dst + x * frame.height + (frame.height - 1 - tile_y);
+                    for (int y = tile_y; y < tile_y_end; y++, from += frame.width) {
+                        *to-- = *from;
+                    }
+                } else {
+                    T *to = dst + (frame.width - 1 - x) * frame.height + tile_y;
+                    for (int y = tile_y; y < tile_y_end; y++, from += frame.width) {
+                        *to++ = *from;
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Move 2x2 blocks of 16-bit pixels, each source row pair is loaded as two words and stored as two words
+ */
+template <bool IS_270>
+void rotateTiledSWAR_16bpp(const Frame &frame, const Area &area, int tile_size)
+{
+    auto src = reinterpret_cast<const uint32_t *>(frame.src);
+    auto dst = reinterpret_cast<uint32_t *>(frame.dst);
+    int src_stride = frame.width / 2;
+    int dst_stride = frame.height / 2;
+    for (int tile_y = area.y1; tile_y < area.y2; tile_y += tile_size) {
+        int tile_y_end = std::min(tile_y + tile_size, area.y2);
+        for (int tile_x = area.x1; tile_x < area.x2; tile_x += tile_size) {
+            int tile_x_end = std::min(tile_x + tile_size, area.x2);
+            for (int x = tile_x; x < tile_x_end; x += 2) {
+                const uint32_t *from = src + tile_y * src_stride + x / 2;
+                if constexpr (IS_270) {
+                    uint32_t *to0 = dst + x * dst_stride + (frame.height - 2 - tile_y) / 2;
+                    uint32_t *to1 = to0 + dst_stride;
+                    for (int y = tile_y; y < tile_y_end; y += 2, from += 2 * src_stride) {
+                        uint32_t row0 = from[0];
+                        uint32_t row1 = from[src_stride];
+                        *to0-- = (row1 & 0x0000FFFF) | (row0 << 16);
+                        *to1-- = (row1 >> 16) | (row0 & 0xFFFF0000);
+                    }
+                } else {
+                    uint32_t *to0 = dst + (frame.width - 1 - x) * dst_stride + tile_y / 2;
+                    uint32_t *to1 = to0 - dst_stride;
+                    for (int y = tile_y; y < tile_y_end; y += 2, from += 2 * src_stride) {
+                        uint32_t row0 = from[0];
+                        uint32_t row1 = from[src_stride];
+                        *to0++ = (row0 & 0x0000FFFF) | (row1 << 16);
+                        *to1++ = (row0 >> 16) | (row1 & 0xFFFF0000);
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Move 4x4 blocks of 8-bit pixels, each source row quad is loaded as four words and transposed in registers
+ */
+template <bool IS_270>
+void rotateTiledSWAR_8bpp(const Frame &frame, const Area &area, int tile_size)
+{
+    auto src = reinterpret_cast<const uint32_t *>(frame.src);
+    auto dst = reinterpret_cast<uint32_t *>(frame.dst);
+    int src_stride = frame.width / 4;
+    int dst_stride = frame.height / 4;
+    uint32_t col[4];
+    for (int tile_y = area.y1; tile_y < area.y2; tile_y += tile_size) {
+        int tile_y_end = std::min(tile_y + tile_size, area.y2);
+        for (int tile_x = area.x1; tile_x < area.x2; tile_x += tile_size) {
+            int tile_x_end = std::min(tile_x + tile_size, area.x2);
+            for (int x = tile_x; x < tile_x_end; x += 4) {
+                const uint32_t *from = src + tile_y * src_stride + x / 4;
+                if constexpr (IS_270) {
+                    uint32_t *to = dst + x * dst_stride + (frame.height - 4 - tile_y) / 4;
+                    for (int y = tile_y; y < tile_y_end; y += 4, from += 4 * src_stride, to--) {
+                        // Reverse the rows so that the destination columns are reversed
+                        transpose4x4Bytes(
+                            from[3 * src_stride], from[2 * src_stride], from[src_stride], from[0], col
+                        );
+                        to[0] = col[0];
+                        to[dst_stride] = col[1];
+                        to[2 * dst_stride] = col[2];
+                        to[3 * dst_stride] = col[3];
+                    }
+                } else {
+                    uint32_t *to = dst + (frame.width - 1 - x) * dst_stride + tile_y / 4;
+                    for (int y = tile_y; y < tile_y_end; y += 4, from += 4 * src_stride, to++) {
+                        transpose4x4Bytes(
+                            from[0], from[src_stride], from[2 * src_stride], from[3 * src_stride], col
+                        );
+                        to[0] = col[0];
+                        to[-dst_stride] = col[1];
+                        to[-2 * dst_stride] = col[2];
+                        to[-3 * dst_stride] = col[3];
+                    }
+                }
+            }
+        }
+    }
+}
+
+template <int BYTES_PER_PIXEL>
+void rotate180SWAR(const Frame &frame, const Area &area)
+{
+    auto src = reinterpret_cast<const uint32_t *>(frame.src);
+    auto dst = reinterpret_cast<uint32_t *>(frame.dst);
+    int stride = frame.width * BYTES_PER_PIXEL / 4;
+    for (int y = area.y1; y < area.y2; y++) {
+        const uint32_t *from = src + y * stride + area.x1 * BYTES_PER_PIXEL / 4;
+        uint32_t *to = dst + (frame.height - 1 - y) * stride + (frame.width - area.x1) * BYTES_PER_PIXEL / 4 - 1;
+        for (int x = area.x1; x < area.x2; x += 4 / BYTES_PER_PIXEL) {
+            uint32_t word = *from++;
+            if constexpr (BYTES_PER_PIXEL == 1) {
+                *to-- = __builtin_bswap32(word);
+            } else {
+                *to-- = (word >> 16) | (word << 16);
+            }
+        }
+    }
+}
+
+template <typename T>
+void rotateScalar(const Frame &frame, const Area &area, int degree, int tile_size)
+{
+    switch (degree) {
+    case 90:
+        rotateTiledScalar<T, false>(frame, area, tile_size);
+        break;
+    case 180:
+        rotate180Scalar<T>(frame, area);
+        break;
+    case 270:
+        rotateTiledScalar<T, true>(frame, area, tile_size);
+        break;
+    default:
+        break;
+    }
+}
+
+} // namespace
+
+bool Rotator::setConfig(const Config &config)
+{
+    if ((config.width <= 0) || (config.height <= 0) || (config.bytes_per_pixel < 1) || (config.bytes_per_pixel > 4) ||
+            (config.degree % 90 != 0) || (config.degree < 0) || (config.degree > 270)) {
+        return false;
+    }
+    // The tiles should hold whole blocks of the register kernels
+    if ((config.tile_size < 4) || (config.tile_size % 4 != 0)) {
+        return false;
+    }
+
+    _config = config;
+
+    return true;
+}
+
+bool Rotator::copy(const uint8_t *src, uint8_t *dst, int x_start, int y_start, int area_width, int area_height)
+{
+    if ((src == nullptr) || (dst == nullptr) || (_config.width <= 0)) {
+        return false;
+    }
+    if ((x_start < 0) || (y_start < 0) || (area_width <= 0) || (area_height <= 0) ||
+            (x_start + area_width > _config.width) || (y_start + area_height > _config.height)) {
+        return false;
+    }
+
+    Frame frame = {src, dst, _config.width, _config.height};
+    Area area = {x_start, y_start, x_start + area_width, y_start + area_height};
+    int bytes_per_pixel = _config.bytes_per_pixel;
+
+    if (_config.degree == 0) {
+        size_t stride = _config.width * bytes_per_pixel;
+        size_t offset = x_start * bytes_per_pixel;
+        for (int y = area.y1; y < area.y2; y++) {
+            memcpy(dst + y * stride + offset, src + y * stride + offset, area_width * bytes_per_pixel);
+        }
+        _last_kernel = Kernel::COPY;
+
+        return true;
+    }
+
+    if (isSWAR_Usable(src, dst, x_start, y_start, area_width, area_height)) {
+        bool is_8bpp = (bytes_per_pixel == 1);
+        switch (_config.degree) {
+        case 90:
+            if (is_8bpp) {
+                rotateTiledSWAR_8bpp<false>(frame, area, _config.tile_size);
+            } else {
+                rotateTiledSWAR_16bpp<false>(frame, area, _config.tile_size);
+            }
+            break;
+        case 180:
+            if (is_8bpp) {
+                rotate180SWAR<1>(frame, area);
+            } else {
+                rotate180SWAR<2>(frame, area);
+            }
+            break;
+        case 270:
+            if (is_8bpp) {
+                rotateTiledSWAR_8bpp<true>(frame, area, _config.tile_size);
+            } else {
+                rotateTiledSWAR_16bpp<true>(frame, area, _config.tile_size);
+            }
+            break;
+        default:
+            break;
+        }
+        _last_kernel = Kernel::SWAR;
+
+        return true;
+    }
+
+    switch (bytes_per_pixel) {
+    case 1:
+        rotateScalar<uint8_t>(frame, area, _config.degree, _config.tile_size);
+        break;
+    case 2:
+        rotateScalar<uint16_t>(frame, area, _config.degree, _config.tile_size);
+        break;
+    case 3:
+        rotateScalar<Pixel24>(frame, area, _config.degree, _config.tile_size);
+        break;
+    default:
+        rotateScalar<uint32_t>(frame, area, _config.degree, _config.tile_size);
+        break;
+    }
+    _last_kernel = Kernel::SCALAR;
+
+    return true;
+}
+
+void Rotator::rotateArea(int &x_start, int &y_start, int &area_width, int &area_height) const
+{
+    int x = x_start;
+    int y = y_start;
+    switch (_config.degree) {
+    case 90:
+        x_start = y;
+        y_start = _config.width - (x + area_width);
+        std::swap(area_width, area_height);
+        break;
+    case 180:
+        x_start = _config.width - (x + area_width);
+        y_start = _config.height - (y + area_height);
+        break;
+    case 270:
+        x_start = _config.height - (y + area_height);
+        y_start = x;
+        std::swap(area_width, area_height);
+        break;
+    default:
+        break;
+    }
+}
+
+bool Rotator::isSWAR_Usable(
+    const uint8_t *src, uint8_t *dst, int x_start, int y_start, int area_width, int area_height
+) const
+{
+    if (!_config.enable_swar || ((_config.bytes_per_pixel != 1) && (_config.bytes_per_pixel != 2))) {
+        return false;
+    }
+    if ((reinterpret_cast<uintptr_t>(src) % 4 != 0) || (reinterpret_cast<uintptr_t>(dst) % 4 != 0)) {
+        return false;
+    }
+
+    // A word holds a block side of pixels, so all rows and the area should start and end on the block boundary
+    int block_size = 4 / _config.bytes_per_pixel;
+    auto is_aligned = [block_size](int value) {
+        return (value % block_size) == 0;
+    };
+
+    return is_aligned(_config.width) && is_aligned(_config.height) && is_aligned(x_start) && is_aligned(y_start) &&
+           is_aligned(area_width) && is_aligned(area_height);
+}
+
+} // namespace esp_panel::utils
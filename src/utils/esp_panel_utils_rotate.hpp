@@ -0,0 +1,169 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @note This file is pure C++ and doesn't depend on ESP-IDF, so it can be tested on the host.
+ */
+
+namespace esp_panel::utils {
+
+/**
+ * @brief Copy pixels between frames with rotation
+ *
+ * The rotation follows the LVGL port, a pixel `(x, y)` of a `width * height` source frame is copied to:
+ *
+ * - 0: `(x, y)` of a `width * height` destination frame
+ * - 90: `(y, width - 1 - x)` of a `height * width` destination frame
+ * - 180: `(width - 1 - x, height - 1 - y)` of a `width * height` destination frame
+ * - 270: `(height - 1 - y, x)` of a `height * width` destination frame
+ *
+ * The 90/270 degree rotations are transposes which read one frame by columns, so they are split into tiles which
+ * fit in the cache. When the frame and the area are aligned, the 8/16 bpp kernels move 2x2 or 4x4 pixel blocks
+ * through 32-bit registers, otherwise the portable per-pixel kernels are used.
+ */
+class Rotator {
+public:
+    static constexpr int TILE_SIZE_DEFAULT = 32;
+
+    /**
+     * @brief Kernel used by the last copy, mainly for the benchmark
+     */
+    enum class Kernel {
+        NONE = 0,
+        COPY,
+        SCALAR,
+        SWAR,
+    };
+
+    /**
+     * @brief Configuration of the rotator
+     */
+    struct Config {
+        int width = 0;                  ///< Width of the source frame in pixels
+        int height = 0;                 ///< Height of the source frame in pixels
+        int bytes_per_pixel = 2;        ///< Bytes per pixel, only supports 1, 2, 3 and 4
+        int degree = 0;                 ///< Rotation degree, only supports 0, 90, 180 and 270
+        int tile_size = TILE_SIZE_DEFAULT; ///< Side length of the square tiles in pixels for the 90/270 degree
+        bool enable_swar = true;        ///< Whether to use the 32-bit register kernels when aligned
+    };
+
+    /**
+     * @brief Construct a rotator without configuration, call `setConfig()` before copying
+     */
+    Rotator() = default;
+
+    /**
+     * @brief Construct a rotator with configuration
+     *
+     * @param[in] config Rotator configuration
+     */
+    Rotator(const Config &config)
+    {
+        setConfig(config);
+    }
+
+    /**
+     * @brief Set the configuration
+     *
+     * @param[in] config Rotator configuration
+     * @return `true` if successful, `false` if the configuration is invalid
+     */
+    bool setConfig(const Config &config);
+
+    /**
+     * @brief Copy an area of the source frame to the destination frame with rotation
+     *
+     * @param[in] src Source frame, the stride is `width * bytes_per_pixel`
+     * @param[out] dst Destination frame, the stride is the width of the rotated frame
+     * @param[in] x_start X coordinate of the area in the source frame
+     * @param[in] y_start Y coordinate of the area in the source frame
+     * @param[in] area_width Width of the area
+     * @param[in] area_height Height of the area
+     * @return `true` if successful, `false` if not configured or the area is invalid
+     * @note The source and destination frames should not overlap
+     */
+    bool copy(const uint8_t *src, uint8_t *dst, int x_start, int y_start, int area_width, int area_height);
+
+    /**
+     * @brief Copy the whole source frame to the destination frame with rotation
+     *
+     * @param[in] src Source frame
+     * @param[out] dst Destination frame
+     * @return `true` if successful, `false` otherwise
+     */
+    bool copy(const uint8_t *src, uint8_t *dst)
+    {
+        return copy(src, dst, 0, 0, _config.width, _config.height);
+    }
+
+    /**
+     * @brief Convert an area of the source frame to the destination frame
+     *
+     * @param[in,out] x_start X coordinate of the area
+     * @param[in,out] y_start Y coordinate of the area
+     * @param[in,out] area_width Width of the area
+     * @param[in,out] area_height Height of the area
+     */
+    void rotateArea(int &x_start, int &y_start, int &area_width, int &area_height) const;
+
+    /**
+     * @brief Get the width of the destination frame
+     *
+     * @return Width in pixels
+     */
+    int getDestWidth() const
+    {
+        return ((_config.degree == 90) || (_config.degree == 270)) ? _config.height : _config.width;
+    }
+
+    /**
+     * @brief Get the height of the destination frame
+     *
+     * @return Height in pixels
+     */
+    int getDestHeight() const
+    {
+        return ((_config.degree == 90) || (_config.degree == 270)) ? _config.width : _config.height;
+    }
+
+    /**
+     * @brief Get the kernel used by the last copy
+     *
+     * @return Kernel type
+     */
+    Kernel getLastKernel() const
+    {
+        return _last_kernel;
+    }
+
+    /**
+     * @brief Get the current configuration
+     *
+     * @return Reference to the configuration
+     */
+    const Config &getConfig() const
+    {
+        return _config;
+    }
+
+private:
+    /**
+     * @brief Check if the 32-bit register kernels can be used for the area
+     *
+     * @return `true` if the frames and the area are aligned to the register blocks, `false` otherwise
+     */
+    bool isSWAR_Usable(
+        const uint8_t *src, uint8_t *dst, int x_start, int y_start, int area_width, int area_height
+    ) const;
+
+    Config _config = {};
+    Kernel _last_kernel = Kernel::NONE;
+};
+
+} // namespace esp_panel::utils
@@ -0,0 +1,139 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "esp_panel_utils_swap_chain.hpp"
+
+namespace esp_panel::utils {
+
+bool SwapChain::setConfig(const Config &config)
+{
+    if ((config.buffer_num < 2) || (config.buffer_num > BUFFER_NUM_MAX) || (config.front_index < 0) ||
+            (config.front_index >= config.buffer_num)) {
+        return false;
+    }
+
+    _config = config;
+    _dropped_num = 0;
+    _shown_num.store(0, std::memory_order_relaxed);
+    _state.store(makeState(config.front_index, INDEX_NONE, 0, 0), std::memory_order_release);
+
+    return true;
+}
+
+int SwapChain::acquire()
+{
+    uint32_t state = _state.load(std::memory_order_acquire);
+    int index = -1;
+    do {
+        uint32_t free_mask = getFreeMask(state);
+        if (free_mask == 0) {
+            return -1;
+        }
+        index = __builtin_ctz(free_mask);
+    } while (!_state.compare_exchange_weak(
+                 state, makeState(
+                     getFront(state), getPending(state), getAcquiredMask(state) | (1U << index), getReplacedMask(state)
+                 ),
+                 std::memory_order_acq_rel, std::memory_order_acquire
+             ));
+
+    return index;
+}
+
+bool SwapChain::release(int index)
+{
+    if ((index < 0) || (index >= _config.buffer_num)) {
+        return false;
+    }
+
+    uint32_t state = _state.load(std::memory_order_acquire);
+    do {
+        if ((getAcquiredMask(state) & (1U << index)) == 0) {
+            return false;
+        }
+    } while (!_state.compare_exchange_weak(
+                 state, makeState(
+                     getFront(state), getPending(state), getAcquiredMask(state) & ~(1U << index), getReplacedMask(state)
+                 ),
+                 std::memory_order_acq_rel, std::memory_order_acquire
+             ));
+
+    return true;
+}
+
+bool SwapChain::canPresent() const
+{
+    return (_config.mode == PresentMode::MAILBOX) ||
+           (getPending(_state.load(std::memory_order_acquire)) == INDEX_NONE);
+}
+
+bool SwapChain::present(int index, int *replaced_index)
+{
+    if ((index < 0) || (index >= _config.buffer_num)) {
+        return false;
+    }
+
+    uint32_t state = _state.load(std::memory_order_acquire);
+    int pending = INDEX_NONE;
+    uint32_t replaced_mask = 0;
+    do {
+        pending = getPending(state);
+        if (((getAcquiredMask(state) & (1U << index)) == 0) ||
+                ((_config.mode == PresentMode::FIFO) && (pending != INDEX_NONE))) {
+            return false;
+        }
+        replaced_mask = getReplacedMask(state) | ((pending == INDEX_NONE) ? 0 : (1U << pending));
+    } while (!_state.compare_exchange_weak(
+                 state, makeState(getFront(state), index, getAcquiredMask(state) & ~(1U << index), replaced_mask),
+                 std::memory_order_acq_rel, std::memory_order_acquire
+             ));
+
+    if (pending != INDEX_NONE) {
+        _dropped_num++;
+    }
+    if (replaced_index != nullptr) {
+        *replaced_index = (pending == INDEX_NONE) ? -1 : pending;
+    }
+
+    return true;
+}
+
+bool SwapChain::notifyRefresh()
+{
+    uint32_t state = _state.load(std::memory_order_acquire);
+    int pending = INDEX_NONE;
+    do {
+        pending = getPending(state);
+        if ((pending == INDEX_NONE) && (getReplacedMask(state) == 0)) {
+            return false;
+        }
+    } while (!_state.compare_exchange_weak(
+                 state, makeState(
+                     (pending == INDEX_NONE) ? getFront(state) : pending, INDEX_NONE, getAcquiredMask(state), 0
+                 ), std::memory_order_acq_rel, std::memory_order_acquire
+             ));
+    if (pending != INDEX_NONE) {
+        _shown_num.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    return true;
+}
+
+int SwapChain::getFreeNum() const
+{
+    return __builtin_popcount(getFreeMask(_state.load(std::memory_order_acquire)));
+}
+
+uint32_t SwapChain::getFreeMask(uint32_t state) const
+{
+    uint32_t used_mask = getAcquiredMask(state) | getReplacedMask(state) | (1U << getFront(state));
+    if (getPending(state) != INDEX_NONE) {
+        used_mask |= 1U << getPending(state);
+    }
+
+    return ((1U << _config.buffer_num) - 1) & ~used_mask;
+}
+
+} // namespace esp_panel::utils
@@ -0,0 +1,218 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @note This file is pure C++ and doesn't depend on ESP-IDF, so it can be tested on the host.
+ */
+
+namespace esp_panel::utils {
+
+/**
+ * @brief States of a swap chain over the frame buffers of a panel which keeps scanning one of them
+ *
+ * Each buffer is in one of the states:
+ *
+ *  - Front: scanned by the panel
+ *  - Pending: switched to, and becomes the front at the next refresh event
+ *  - Acquired: drawn by the application
+ *  - Free: can be acquired
+ *
+ * The panel is switched to a buffer before `present()` is called, so if the refresh event comes in between, the old
+ * front is still released one refresh later, which is on the safe side. For the same reason, the pending buffer
+ * replaced in the mailbox mode might have been latched by the panel, so it's released at the next refresh event.
+ *
+ * All states are packed into one atomic word, so `notifyRefresh()` can be called from the refresh ISR, while the
+ * other functions should be called from one task.
+ */
+class SwapChain {
+public:
+    static constexpr int BUFFER_NUM_MAX = 3;
+
+    /**
+     * @brief Mode of presenting the buffers
+     */
+    enum class PresentMode {
+        FIFO = 0,   ///< Every presented buffer is shown, a buffer can't be presented until the last one is shown
+        MAILBOX,    ///< The pending buffer is replaced by the newly presented one, which has the lowest latency
+    };
+
+    /**
+     * @brief Configuration of the swap chain
+     */
+    struct Config {
+        int buffer_num = 2;                     ///< Number of the buffers, the range is [2, `BUFFER_NUM_MAX`]
+        PresentMode mode = PresentMode::FIFO;   ///< Present mode
+        int front_index = 0;                    ///< Index of the buffer scanned at the beginning
+    };
+
+    /**
+     * @brief Construct a swap chain without configuration, call `setConfig()` before using
+     */
+    SwapChain() = default;
+
+    /**
+     * @brief Construct a swap chain with configuration
+     *
+     * @param[in] config Swap chain configuration
+     */
+    SwapChain(const Config &config)
+    {
+        setConfig(config);
+    }
+
+    /**
+     * @brief Set the configuration and release all buffers except the front one
+     *
+     * @param[in] config Swap chain configuration
+     * @return `true` if successful, `false` if the configuration is invalid
+     */
+    bool setConfig(const Config &config);
+
+    /**
+     * @brief Acquire a free buffer to draw
+     *
+     * @return Index of the buffer, `-1` if no buffer is free
+     */
+    int acquire();
+
+    /**
+     * @brief Release an acquired buffer without presenting it
+     *
+     * @param[in] index Index of the buffer
+     * @return `true` if successful, `false` if the buffer is not acquired
+     */
+    bool release(int index);
+
+    /**
+     * @brief Check if a buffer can be presented now, which is always `true` in the mailbox mode
+     *
+     * @return `true` if no buffer is pending or in the mailbox mode, `false` otherwise
+     */
+    bool canPresent() const;
+
+    /**
+     * @brief Mark an acquired buffer as pending, should be called after the panel is switched to it
+     *
+     * @param[in] index Index of the buffer
+     * @param[out] replaced_index Index of the pending buffer replaced in the mailbox mode, `-1` if none. It's
+     *                            released at the next refresh event
+     * @return `true` if successful, `false` if the buffer is not acquired or it can't be presented now
+     */
+    bool present(int index, int *replaced_index = nullptr);
+
+    /**
+     * @brief Notify the refresh event of the panel, the pending buffer becomes the front one
+     *
+     * @return `true` if any buffer is released, `false` otherwise
+     */
+    bool notifyRefresh();
+
+    /**
+     * @brief Get the index of the front buffer
+     *
+     * @return Index of the buffer
+     */
+    int getFrontIndex() const
+    {
+        return getFront(_state.load(std::memory_order_acquire));
+    }
+
+    /**
+     * @brief Get the index of the pending buffer
+     *
+     * @return Index of the buffer, `-1` if none
+     */
+    int getPendingIndex() const
+    {
+        int pending = getPending(_state.load(std::memory_order_acquire));
+        return (pending == INDEX_NONE) ? -1 : pending;
+    }
+
+    /**
+     * @brief Get the number of the free buffers
+     *
+     * @return Number of the buffers
+     */
+    int getFreeNum() const;
+
+    /**
+     * @brief Get the number of the buffers which became the front one
+     *
+     * @return Number of the buffers
+     */
+    uint32_t getShownNum() const
+    {
+        return _shown_num.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get the number of the buffers replaced before shown in the mailbox mode
+     *
+     * @return Number of the buffers
+     */
+    uint32_t getDroppedNum() const
+    {
+        return _dropped_num;
+    }
+
+    /**
+     * @brief Get the current configuration
+     *
+     * @return Reference to the configuration
+     */
+    const Config &getConfig() const
+    {
+        return _config;
+    }
+
+private:
+    // Bits [0, 1] are the front index, bits [2, 3] are the pending index, bits [4, 6] are the acquired mask and
+    // bits [7, 9] are the mask of the replaced buffers
+    static constexpr int INDEX_NONE = 3;
+    static constexpr int PENDING_SHIFT = 2;
+    static constexpr int ACQUIRED_SHIFT = 4;
+    static constexpr int REPLACED_SHIFT = 7;
+    static constexpr uint32_t BUFFER_MASK = (1U << BUFFER_NUM_MAX) - 1;
+
+    static int getFront(uint32_t state)
+    {
+        return state & 0x3;
+    }
+
+    static int getPending(uint32_t state)
+    {
+        return (state >> PENDING_SHIFT) & 0x3;
+    }
+
+    static uint32_t getAcquiredMask(uint32_t state)
+    {
+        return (state >> ACQUIRED_SHIFT) & BUFFER_MASK;
+    }
+
+    static uint32_t getReplacedMask(uint32_t state)
+    {
+        return (state >> REPLACED_SHIFT) & BUFFER_MASK;
+    }
+
+    static uint32_t makeState(int front, int pending, uint32_t acquired_mask, uint32_t replaced_mask)
+    {
+        return front | (pending << PENDING_SHIFT) | (acquired_mask << ACQUIRED_SHIFT) |
+               (replaced_mask << REPLACED_SHIFT);
+    }
+
+    uint32_t getFreeMask(uint32_t state) const;
+
+    Config _config = {};
+    uint32_t _dropped_num = 0;
+    std::atomic<uint32_t> _state = makeState(0, INDEX_NONE, 0, 0);
+    std::atomic<uint32_t> _shown_num = 0;
+};
+
+} // namespace esp_panel::utils
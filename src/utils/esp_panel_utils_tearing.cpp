@@ -0,0 +1,129 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <algorithm>
+#include <cmath>
+#include "esp_panel_utils_tearing.hpp"
+
+namespace esp_panel::utils {
+
+bool TearingScheduler::setConfig(const Config &config)
+{
+    if ((config.height <= 0) || (config.blank_lines < 0) || (config.te_line >= config.height + config.blank_lines) ||
+            (config.margin_lines < 0) || (config.bytes_per_us < 0)) {
+        return false;
+    }
+    if ((config.period_us != 0) && ((config.period_us < PERIOD_MIN_US) || (config.period_us > PERIOD_MAX_US))) {
+        return false;
+    }
+
+    _config = config;
+    _bytes_per_us = config.bytes_per_us;
+    _tearing_num = 0;
+    _period_us.store(config.period_us, std::memory_order_relaxed);
+    _has_te.store(false, std::memory_order_relaxed);
+
+    return true;
+}
+
+void TearingScheduler::notifyTE(uint32_t time_us)
+{
+    // Learn the period by a low-pass filter, unless it's configured
+    if ((_config.period_us == 0) && _has_te.load(std::memory_order_relaxed)) {
+        uint32_t interval = time_us - _te_us.load(std::memory_order_relaxed);
+        uint32_t period = _period_us.load(std::memory_order_relaxed);
+        if ((interval >= PERIOD_MIN_US) && (interval <= PERIOD_MAX_US) && ((period == 0) ||
+                (interval <= period + period / 2))) {
+            int32_t diff = static_cast<int32_t>(interval - period);
+            period = (period == 0) ? interval : (period + (diff >> PERIOD_FILTER_SHIFT));
+            _period_us.store(period, std::memory_order_relaxed);
+        }
+    }
+    _te_us.store(time_us, std::memory_order_relaxed);
+    _has_te.store(true, std::memory_order_release);
+}
+
+void TearingScheduler::notifyTransfer(uint32_t bytes, uint32_t duration_us)
+{
+    if ((bytes == 0) || (duration_us == 0)) {
+        return;
+    }
+
+    // The short transfers are dominated by the setup time, so the speed is underestimated, which is on the safe side
+    float bytes_per_us = static_cast<float>(bytes) / duration_us;
+    _bytes_per_us = (_bytes_per_us <= 0) ? bytes_per_us : (_bytes_per_us + (bytes_per_us - _bytes_per_us) / 4);
+}
+
+TearingScheduler::Plan TearingScheduler::schedule(
+    int y_start, int height, uint32_t bytes, uint32_t now_us, WriteOrder order
+)
+{
+    Plan plan = {.start_us = now_us, .is_tear_free = false};
+    if (!isReady() || (height <= 0)) {
+        return plan;
+    }
+
+    // Use the times relative to the last TE signal, the race with the ISR only makes the schedule one period later
+    uint32_t te_us = _te_us.load(std::memory_order_acquire);
+    float period = static_cast<float>(_period_us.load(std::memory_order_relaxed));
+    float now = static_cast<float>(static_cast<int32_t>(now_us - te_us));
+    if (now > period * STALE_PERIODS) {
+        return plan;
+    }
+
+    // The line `r` is scanned at `k * period + first_scan + r * line_time` in the period `k`
+    int total_lines = _config.height + _config.blank_lines;
+    int te_line = (_config.te_line < 0) ? _config.height : _config.te_line;
+    float line_time = period / total_lines;
+    float first_scan = ((total_lines - te_line) % total_lines) * line_time;
+    float margin = _config.margin_lines * line_time;
+    float write_time = (static_cast<float>(bytes) / height) / _bytes_per_us;
+
+    // The line `r` is written during `[start + begin(r), start + end(r)]`, which should be after the scan of it in
+    // the period `k - 1` and before the scan in the period `k`. Both are linear, so only the end lines are checked.
+    int y_end = y_start + height - 1;
+    auto get_write_begin = [&](int r) {
+        switch (order) {
+        case WriteOrder::TOP_TO_BOTTOM:
+            return (r - y_start) * write_time;
+        case WriteOrder::BOTTOM_TO_TOP:
+            return (y_end - r) * write_time;
+        default:
+            return 0.0f;
+        }
+    };
+    auto get_write_end = [&](int r) {
+        return (order == WriteOrder::COLUMNS) ? (height * write_time) : (get_write_begin(r) + write_time);
+    };
+    auto get_scan = [&](int k, int r) {
+        return k * period + first_scan + r * line_time;
+    };
+
+    // The lower and upper bounds of the start in the period `0`, they are moved by one period for each `k`
+    float lower = -INFINITY;
+    float upper = INFINITY;
+    for (int r : {y_start, y_end}) {
+        lower = std::max(lower, get_scan(-1, r) + margin - get_write_begin(r));
+        upper = std::min(upper, get_scan(0, r) - margin - get_write_end(r));
+    }
+
+    float start = now;
+    if (lower <= upper) {
+        int k = static_cast<int>(std::ceil((now - upper) / period));
+        start = std::max(lower + k * period, now);
+        plan.is_tear_free = true;
+    } else {
+        // Follow the scanline to reduce the tearing
+        int r = (order == WriteOrder::TOP_TO_BOTTOM) ? y_start : y_end;
+        int k = static_cast<int>(std::ceil((now - get_scan(0, r) - margin) / period));
+        start = get_scan(k, r) + margin;
+        _tearing_num++;
+    }
+    plan.start_us = te_us + static_cast<uint32_t>(static_cast<int32_t>(std::lround(std::ceil(start))));
+
+    return plan;
+}
+
+} // namespace esp_panel::utils
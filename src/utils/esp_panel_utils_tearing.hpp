@@ -0,0 +1,185 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @note This file is pure C++ and doesn't depend on ESP-IDF, so it can be tested on the host.
+ */
+
+namespace esp_panel::utils {
+
+/**
+ * @brief Scheduler of the transfers by the tearing effect (TE) signal, which avoids tearing without double buffering
+ *
+ * The panel scans the lines from its GRAM at a constant speed, and outputs the TE signal at a fixed scanline in each
+ * refresh period. The scheduler learns the period from the TE signal and the speed of the bus from the finished
+ * transfers, then finds the earliest start time of a transfer, where each transferred line is written between two
+ * scans of it in the adjacent periods. So the panel shows either the old or the new content of the whole area:
+ *
+ *  - Racing: the transfer starts before the scanline reaches the area, and stays ahead of it
+ *  - Following: the transfer starts right after the scanline passes, and finishes before the next scan reaches it
+ *
+ * `notifyTE()` only uses 32-bit atomic operations, so it can be called from the TE ISR. The other functions should be
+ * called from one task. The timestamps are provided by the caller, and wrap around every ~71 minutes, which is fine
+ * for the differences.
+ */
+class TearingScheduler {
+public:
+    static constexpr uint32_t PERIOD_MIN_US = 4000;
+    static constexpr uint32_t PERIOD_MAX_US = 100000;
+    static constexpr int PERIOD_FILTER_SHIFT = 3;
+    static constexpr int STALE_PERIODS = 4;
+
+    /**
+     * @brief Order of the lines written by a transfer
+     */
+    enum class WriteOrder {
+        TOP_TO_BOTTOM = 0,  ///< Lines are written from the top, which is the scan direction
+        BOTTOM_TO_TOP,      ///< Lines are written from the bottom, e.g. mirrored by the command
+        COLUMNS,            ///< All lines are written during the whole transfer, e.g. the axes are swapped
+    };
+
+    /**
+     * @brief Configuration of the scheduler
+     */
+    struct Config {
+        int height = 0;             ///< Vertical resolution of the panel in lines
+        int blank_lines = 0;        ///< Lines of the vertical blanking, which are scanned without output
+        int te_line = -1;           ///< Scanline of the TE signal, `-1` means the start of the vertical blanking
+        int margin_lines = 2;       ///< Lines kept between the scanline and the written lines
+        uint32_t period_us = 0;     ///< Refresh period, `0` to learn from the TE signal
+        float bytes_per_us = 0;     ///< Initial speed of the bus, `0` to learn from `notifyTransfer()`
+    };
+
+    /**
+     * @brief Schedule of a transfer
+     */
+    struct Plan {
+        uint32_t start_us = 0;      ///< Time to start the transfer
+        bool is_tear_free = false;  ///< Whether the transfer avoids tearing, `false` if the speed is too slow
+    };
+
+    /**
+     * @brief Construct a scheduler without configuration, call `setConfig()` before using
+     */
+    TearingScheduler() = default;
+
+    /**
+     * @brief Construct a scheduler with configuration
+     *
+     * @param[in] config Scheduler configuration
+     */
+    TearingScheduler(const Config &config)
+    {
+        setConfig(config);
+    }
+
+    /**
+     * @brief Set the configuration and clear the learned states
+     *
+     * @param[in] config Scheduler configuration
+     * @return `true` if successful, `false` if the configuration is invalid
+     */
+    bool setConfig(const Config &config);
+
+    /**
+     * @brief Notify the TE signal
+     *
+     * The intervals out of [`PERIOD_MIN_US`, `PERIOD_MAX_US`] or longer than 1.5 periods (e.g. missed signals) are
+     * not used to learn the period.
+     *
+     * @param[in] time_us Time of the signal
+     */
+    void notifyTE(uint32_t time_us);
+
+    /**
+     * @brief Notify a finished transfer to learn the speed of the bus
+     *
+     * @param[in] bytes Bytes of the transfer
+     * @param[in] duration_us Duration from the start to the finish of the transfer
+     */
+    void notifyTransfer(uint32_t bytes, uint32_t duration_us);
+
+    /**
+     * @brief Schedule a transfer
+     *
+     * @param[in] y_start Index of the first line of the area on the panel
+     * @param[in] height Number of the lines of the area
+     * @param[in] bytes Bytes of the transfer
+     * @param[in] now_us Current time
+     * @param[in] order Order of the written lines
+     * @return Plan of the transfer. If no tear-free start is found (e.g. the bus is too slow for the area), it starts
+     *         right after the scanline passes the area. If the scheduler is not ready or the last TE signal is older
+     *         than `STALE_PERIODS` periods, it starts now
+     */
+    Plan schedule(
+        int y_start, int height, uint32_t bytes, uint32_t now_us, WriteOrder order = WriteOrder::TOP_TO_BOTTOM
+    );
+
+    /**
+     * @brief Check if the period, the time of the TE signal and the speed of the bus are known
+     *
+     * @return `true` if ready, `false` otherwise
+     */
+    bool isReady() const
+    {
+        return (_period_us.load(std::memory_order_relaxed) > 0) && _has_te.load(std::memory_order_acquire) &&
+               (_bytes_per_us > 0);
+    }
+
+    /**
+     * @brief Get the refresh period
+     *
+     * @return Period in microseconds, `0` if not learned
+     */
+    uint32_t getPeriodUs() const
+    {
+        return _period_us.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get the speed of the bus
+     *
+     * @return Speed in bytes per microsecond, `0` if not learned
+     */
+    float getBytesPerUs() const
+    {
+        return _bytes_per_us;
+    }
+
+    /**
+     * @brief Get the number of the scheduled transfers which can't avoid tearing
+     *
+     * @return Number of the transfers
+     */
+    uint32_t getTearingNum() const
+    {
+        return _tearing_num;
+    }
+
+    /**
+     * @brief Get the current configuration
+     *
+     * @return Reference to the configuration
+     */
+    const Config &getConfig() const
+    {
+        return _config;
+    }
+
+private:
+    Config _config = {};
+    float _bytes_per_us = 0;
+    uint32_t _tearing_num = 0;
+    std::atomic<uint32_t> _te_us = 0;
+    std::atomic<uint32_t> _period_us = 0;
+    std::atomic<bool> _has_te = false;
+};
+
+} // namespace esp_panel::utils
@@ -0,0 +1,50 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include "freertos/FreeRTOS.h"
+#include "esp_pthread.h"
+
+namespace esp_panel::utils {
+
+/**
+ * @brief Apply the configuration to the threads created by the current task, and restore it when out of scope
+ */
+class ThreadConfigGuard {
+public:
+    struct Config {
+        const char *name;
+        int priority;
+        int stack_size;
+        int core_id;
+    };
+
+    ThreadConfigGuard(const Config &config)
+    {
+        _old_config = esp_pthread_get_default_config();
+        esp_pthread_get_cfg(&_old_config);
+
+        esp_pthread_cfg_t new_config = esp_pthread_get_default_config();
+        new_config.thread_name = config.name;
+        new_config.prio = config.priority;
+        new_config.stack_size = config.stack_size;
+        new_config.pin_to_core = (config.core_id < 0) ? tskNO_AFFINITY : config.core_id;
+        esp_pthread_set_cfg(&new_config);
+    }
+
+    ~ThreadConfigGuard()
+    {
+        esp_pthread_set_cfg(&_old_config);
+    }
+
+    ThreadConfigGuard(const ThreadConfigGuard &) = delete;
+    ThreadConfigGuard &operator=(const ThreadConfigGuard &) = delete;
+
+private:
+    esp_pthread_cfg_t _old_config = {};
+};
+
+} // namespace esp_panel::utils
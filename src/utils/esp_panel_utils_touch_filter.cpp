@@ -0,0 +1,136 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <algorithm>
+#include "esp_panel_utils_touch_filter.hpp"
+
+namespace esp_panel::utils {
+
+/**
+ * @brief Convert a Q8 value to the nearest integer, rounding half away from zero
+ */
+static int fixed_to_int(int64_t value)
+{
+    return (value >= 0) ? static_cast<int>((value + TouchFilter::FIXED_ONE / 2) / TouchFilter::FIXED_ONE) :
+           -static_cast<int>((-value + TouchFilter::FIXED_ONE / 2) / TouchFilter::FIXED_ONE);
+}
+
+bool TouchFilter::setConfig(const Config &config)
+{
+    if ((config.median_window < 1) || (config.median_window > MEDIAN_WINDOW_MAX) ||
+            ((config.median_window % 2) == 0)) {
+        return false;
+    }
+    if ((config.smooth_weight <= 0) || (config.smooth_weight > FIXED_ONE) || (config.dead_zone < 0)) {
+        return false;
+    }
+    if ((config.prediction_ms < 0) || (config.alpha < 0) || (config.alpha > FIXED_ONE) || (config.beta < 0) ||
+            (config.beta > FIXED_ONE) || (config.reset_interval_ms <= 0)) {
+        return false;
+    }
+    if ((config.x_max < 0) || (config.y_max < 0)) {
+        return false;
+    }
+
+    _config = config;
+    reset();
+
+    return true;
+}
+
+void TouchFilter::process(int x[], int y[], int num, int64_t timestamp_us)
+{
+    for (int i = 0; i < SLOTS_MAX; i++) {
+        Slot &slot = _slots[i];
+        if (i >= num) {
+            slot.is_active = false;
+            continue;
+        }
+
+        bool is_first = !slot.is_active;
+        int64_t dt_us = timestamp_us - slot.last_time_us;
+        // A long gap or a wrong timestamp only resets the velocity
+        if (is_first || (dt_us <= 0) || (dt_us > static_cast<int64_t>(_config.reset_interval_ms) * 1000)) {
+            dt_us = 0;
+        }
+        slot.history_index = is_first ? 0 : (slot.history_index + 1) % _config.median_window;
+        x[i] = processAxis(slot.x, x[i], slot.history_index, dt_us, is_first, _config.x_max);
+        y[i] = processAxis(slot.y, y[i], slot.history_index, dt_us, is_first, _config.y_max);
+        slot.is_active = true;
+        slot.last_time_us = timestamp_us;
+    }
+}
+
+void TouchFilter::reset()
+{
+    for (auto &slot : _slots) {
+        slot.is_active = false;
+    }
+}
+
+int TouchFilter::processAxis(Axis &axis, int value, int history_index, int64_t dt_us, bool is_first, int max) const
+{
+    if (is_first) {
+        axis.history.fill(value);
+        axis.smooth = value * FIXED_ONE;
+        axis.hold = axis.smooth;
+    }
+
+    // Median
+    int32_t position = value;
+    if (_config.median_window > 1) {
+        axis.history[history_index] = value;
+        std::array<int, MEDIAN_WINDOW_MAX> sorted = axis.history;
+        auto middle = sorted.begin() + _config.median_window / 2;
+        std::nth_element(sorted.begin(), middle, sorted.begin() + _config.median_window);
+        position = *middle;
+    }
+    position *= FIXED_ONE;
+
+    // Exponential smoothing
+    axis.smooth += (static_cast<int64_t>(position - axis.smooth) * _config.smooth_weight) / FIXED_ONE;
+    position = axis.smooth;
+
+    // Dead zone, the held position is dragged by the edge of the zone
+    if (_config.dead_zone > 0) {
+        int32_t dead_zone = _config.dead_zone * FIXED_ONE;
+        if (position > axis.hold + dead_zone) {
+            axis.hold = position - dead_zone;
+        } else if (position < axis.hold - dead_zone) {
+            axis.hold = position + dead_zone;
+        }
+        position = axis.hold;
+    }
+
+    // Prediction
+    int64_t output = position;
+    if (dt_us == 0) {
+        axis.last = position;
+        axis.estimate = position;
+        axis.velocity = 0;
+    } else if (_config.prediction == Prediction::LINEAR) {
+        axis.velocity = (static_cast<int64_t>(position - axis.last) * 1000) / dt_us;
+        axis.last = position;
+    } else if (_config.prediction == Prediction::ALPHA_BETA) {
+        int64_t predicted = axis.estimate + (static_cast<int64_t>(axis.velocity) * dt_us) / 1000;
+        int64_t residual = position - predicted;
+        axis.estimate = predicted + (residual * _config.alpha) / FIXED_ONE;
+        axis.velocity += (residual * _config.beta * 1000) / (static_cast<int64_t>(FIXED_ONE) * dt_us);
+        output = axis.estimate;
+    }
+    if (_config.prediction != Prediction::NONE) {
+        output += static_cast<int64_t>(axis.velocity) * _config.prediction_ms;
+    }
+
+    int result = fixed_to_int(output);
+    if (max > 0) {
+        result = std::clamp(result, 0, max - 1);
+    }
+
+    return result;
+}
+
+} // namespace esp_panel::utils
@@ -0,0 +1,135 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+/**
+ * @note This file is pure C++ and doesn't depend on ESP-IDF, so it can be tested on the host.
+ */
+
+namespace esp_panel::utils {
+
+/**
+ * @brief Filter pipeline of the touch coordinates
+ *
+ * Each point is passed through the enabled stages in order:
+ *
+ * 1. Median of the last `median_window` samples, removes the single-sample spikes
+ * 2. Exponential smoothing, reduces the noise
+ * 3. Dead zone, holds the output until the point moves out of the zone, so a still finger doesn't jitter
+ * 4. Prediction, extrapolates the point by `prediction_ms` to compensate the latency of the display path
+ *
+ * All stages use Q8 fixed-point and no dynamic memory. The state is kept per slot, which is the index of the point
+ * reported by the controller, and a slot is reset when its point is released.
+ */
+class TouchFilter {
+public:
+    static constexpr int SLOTS_MAX = 10;
+    static constexpr int MEDIAN_WINDOW_MAX = 7;
+    static constexpr int FIXED_ONE = 256;
+
+    /**
+     * @brief Prediction method
+     */
+    enum class Prediction {
+        NONE = 0,       ///< No prediction
+        LINEAR,         ///< Extrapolate with the velocity of the last two samples
+        ALPHA_BETA,     ///< Extrapolate with the velocity tracked by an alpha-beta (steady-state Kalman) filter
+    };
+
+    /**
+     * @brief Configuration of the filter
+     */
+    struct Config {
+        int median_window = 1;                      ///< Samples of the median stage, should be odd, `1` to disable
+        int smooth_weight = FIXED_ONE;              ///< Weight of the new sample in 1/256, `256` to disable
+        int dead_zone = 0;                          ///< Half size of the dead zone in pixels, `0` to disable
+        Prediction prediction = Prediction::NONE;   ///< Prediction method
+        int prediction_ms = 0;                      ///< Time to predict ahead in milliseconds
+        int alpha = FIXED_ONE / 2;                  ///< Position gain of the alpha-beta filter in 1/256
+        int beta = FIXED_ONE / 8;                   ///< Velocity gain of the alpha-beta filter in 1/256
+        int reset_interval_ms = 100;                ///< Reset the velocity if the samples are farther apart
+        int x_max = 0;                              ///< Clamp the X outputs to `[0, x_max)`, `0` to disable
+        int y_max = 0;                              ///< Clamp the Y outputs to `[0, y_max)`, `0` to disable
+    };
+
+    /**
+     * @brief Construct a filter which passes all points through
+     */
+    TouchFilter() = default;
+
+    /**
+     * @brief Construct a filter with configuration
+     *
+     * @param[in] config Filter configuration
+     */
+    TouchFilter(const Config &config)
+    {
+        setConfig(config);
+    }
+
+    /**
+     * @brief Set the configuration and reset all slots
+     *
+     * @param[in] config Filter configuration
+     * @return `true` if successful, `false` if the configuration is invalid
+     */
+    bool setConfig(const Config &config);
+
+    /**
+     * @brief Filter the points of a report in place
+     *
+     * The points with index `>= SLOTS_MAX` are passed through. The slots from `num` are released.
+     *
+     * @param[in,out] x X coordinates of the points
+     * @param[in,out] y Y coordinates of the points
+     * @param[in] num Number of the points, `0` means all points are released
+     * @param[in] timestamp_us Time of the report in microseconds
+     */
+    void process(int x[], int y[], int num, int64_t timestamp_us);
+
+    /**
+     * @brief Reset all slots
+     */
+    void reset();
+
+    /**
+     * @brief Get the current configuration
+     *
+     * @return Reference to the configuration
+     */
+    const Config &getConfig() const
+    {
+        return _config;
+    }
+
+private:
+    struct Axis {
+        std::array<int, MEDIAN_WINDOW_MAX> history = {};
+        int32_t smooth = 0;     // Q8
+        int32_t hold = 0;       // Q8
+        int32_t last = 0;       // Q8, the last input of the prediction
+        int32_t estimate = 0;   // Q8
+        int32_t velocity = 0;   // Q8 pixels per millisecond
+    };
+
+    struct Slot {
+        bool is_active = false;
+        int history_index = 0;
+        int64_t last_time_us = 0;
+        Axis x;
+        Axis y;
+    };
+
+    int processAxis(Axis &axis, int value, int history_index, int64_t dt_us, bool is_first, int max) const;
+
+    Config _config = {};
+    std::array<Slot, SLOTS_MAX> _slots = {};
+};
+
+} // namespace esp_panel::utils
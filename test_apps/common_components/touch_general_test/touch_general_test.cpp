@@ -14,6 +14,7 @@
 #define TEST_TOUCH_ENABLE_INTERRUPT_CALLBACK   (1)
 #define TEST_TOUCH_READ_PERIOD_MS           (30)
 #define TEST_TOUCH_READ_TIME_MS             (5000)
+#define TEST_TOUCH_SAMPLING_TIME_MS         (5000)
 
 #define delay(x)     vTaskDelay(pdMS_TO_TICKS(x))
 
@@ -72,4 +73,31 @@ void touch_general_test(Touch *touch)
     if (touch_thread.joinable()) {
         touch_thread.join();
     }
+
+    ESP_LOGI(TAG, "Reading touch_device frames by sampling...");
+    TEST_ASSERT_TRUE_MESSAGE(touch->startSampling(), "Start touch sampling failed");
+
+    uint32_t t = 0;
+    uint32_t next_sequence = 0;
+    TouchFrame frames[Touch::SAMPLING_FRAMES_NUM];
+    while (t++ < TEST_TOUCH_SAMPLING_TIME_MS / TEST_TOUCH_READ_PERIOD_MS) {
+        delay(TEST_TOUCH_READ_PERIOD_MS);
+        int frames_num = touch->readFrames(frames, Touch::SAMPLING_FRAMES_NUM);
+        TEST_ASSERT_TRUE_MESSAGE(frames_num >= 0, "Read touch frames failed");
+        for (int i = 0; i < frames_num; i++) {
+            auto &frame = frames[i];
+            // The frames are in order, a gap means some frames are dropped
+            TEST_ASSERT_TRUE_MESSAGE(frame.sequence >= next_sequence, "Touch frames out of order");
+            next_sequence = frame.sequence + 1;
+            ESP_LOGI(
+                TAG, "Frame(%d): %lld us, %d points", static_cast<int>(frame.sequence),
+                static_cast<long long>(frame.timestamp_us), frame.points_num
+            );
+            for (int j = 0; j < frame.points_num; j++) {
+                ESP_LOGI(TAG, "Point(%d): x(%d), y(%d)", j, frame.points[j].x, frame.points[j].y);
+            }
+        }
+    }
+    ESP_LOGI(TAG, "Dropped %d frames", static_cast<int>(touch->getSamplingDroppedNum()));
+    TEST_ASSERT_TRUE_MESSAGE(touch->stopSampling(), "Stop touch sampling failed");
 }
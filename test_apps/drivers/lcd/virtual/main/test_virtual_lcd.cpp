@@ -0,0 +1,419 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+#include <memory>
+#include <cstring>
+#include <cinttypes>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_rom_sys.h"
+#include "esp_lcd_panel_commands.h"
+#include "unity.h"
+#include "unity_test_runner.h"
+#include "esp_display_panel.hpp"
+#include "lcd_general_test.hpp"
+
+using namespace std;
+using namespace esp_panel::drivers;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////// Please update the following configuration according to the emulated LCD ///////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+#define TEST_LCD_WIDTH                  (320)
+#define TEST_LCD_HEIGHT                 (240)
+#define TEST_LCD_COLOR_BITS             (16)
+#define TEST_LCD_SPI_FREQ_HZ            (40 * 1000 * 1000)
+#define TEST_LCD_QSPI_FREQ_HZ           (40 * 1000 * 1000)
+#define TEST_LCD_RGB_FREQ_HZ            (16 * 1000 * 1000)
+#define TEST_LCD_RGB_DATA_WIDTH         (16)
+#define TEST_LCD_RGB_H_BLANK_PX         (40 + 40 + 48)
+#define TEST_LCD_RGB_V_BLANK_LINES      (23 + 32 + 13)
+#define TEST_LCD_TRANS_OVERHEAD_US      (20)
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////// Please update the following configuration according to the benchmark //////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+#define TEST_BENCH_FRAME_NUM            (20)
+#define TEST_BENCH_STRIP_LINES          (TEST_LCD_HEIGHT / 10)
+#define TEST_BENCH_TOLERANCE_PERCENT    (10)
+#define TEST_BUS_MAX_TRANSFER_SIZE      (4096)
+
+static const char *TAG = "test_virtual_lcd";
+
+static shared_ptr<BusVirtual> init_bus(int emulated_type, int clock_hz, int data_lines)
+{
+    ESP_LOGI(TAG, "Create virtual bus (emulated type: %d)", emulated_type);
+    auto bus = make_shared<BusVirtual>(emulated_type, clock_hz, data_lines);
+    TEST_ASSERT_NOT_NULL_MESSAGE(bus, "Create bus object failed");
+
+    TEST_ASSERT_TRUE_MESSAGE(bus->configVirtual_TransOverhead(TEST_LCD_TRANS_OVERHEAD_US), "Config overhead failed");
+    if (emulated_type == ESP_PANEL_BUS_TYPE_RGB) {
+        TEST_ASSERT_TRUE_MESSAGE(
+            bus->configVirtual_Blanking(TEST_LCD_RGB_H_BLANK_PX, TEST_LCD_RGB_V_BLANK_LINES), "Config blanking failed"
+        );
+    }
+    TEST_ASSERT_TRUE_MESSAGE(bus->begin(), "Bus begin failed");
+
+    return bus;
+}
+
+static shared_ptr<LCD_Virtual> init_lcd(Bus *bus, bool use_gram)
+{
+    auto lcd = make_shared<LCD_Virtual>(bus, TEST_LCD_WIDTH, TEST_LCD_HEIGHT, TEST_LCD_COLOR_BITS);
+    TEST_ASSERT_NOT_NULL_MESSAGE(lcd, "Create LCD object failed");
+
+    TEST_ASSERT_TRUE_MESSAGE(lcd->configVirtual_GRAM(use_gram), "LCD config GRAM failed");
+    TEST_ASSERT_TRUE_MESSAGE(lcd->init(), "LCD init failed");
+    TEST_ASSERT_TRUE_MESSAGE(lcd->reset(), "LCD reset failed");
+    TEST_ASSERT_TRUE_MESSAGE(lcd->begin(), "LCD begin failed");
+    TEST_ASSERT_TRUE_MESSAGE(lcd->setDisplayOnOff(true), "LCD display on failed");
+
+    return lcd;
+}
+
+static void run_benchmark(shared_ptr<BusVirtual> bus, shared_ptr<LCD_Virtual> lcd)
+{
+    int bytes_per_pixel = (TEST_LCD_COLOR_BITS + 7) / 8;
+    size_t strip_size = TEST_LCD_WIDTH * TEST_BENCH_STRIP_LINES * bytes_per_pixel;
+    uint8_t *strip = (uint8_t *)heap_caps_malloc(strip_size, MALLOC_CAP_DMA | MALLOC_CAP_8BIT);
+    TEST_ASSERT_NOT_NULL_MESSAGE(strip, "Malloc strip buffer failed");
+    memset(strip, 0x5A, strip_size);
+
+    // Model the expected time of one frame
+    int strip_num = TEST_LCD_HEIGHT / TEST_BENCH_STRIP_LINES;
+    uint32_t expected_frame_us = 0;
+    for (int i = 0; i < strip_num; i++) {
+        // CASET + RASET + RAMWR with color data
+        expected_frame_us += 2 * bus->calculateTransferTimeUs(4) + bus->calculateTransferTimeUs(strip_size);
+    }
+
+    bus->resetStatistics();
+    int64_t start_us = esp_timer_get_time();
+    for (int frame = 0; frame < TEST_BENCH_FRAME_NUM; frame++) {
+        for (int y = 0; y < TEST_LCD_HEIGHT; y += TEST_BENCH_STRIP_LINES) {
+            TEST_ASSERT_TRUE_MESSAGE(
+                lcd->drawBitmap(0, y, TEST_LCD_WIDTH, TEST_BENCH_STRIP_LINES, strip, -1), "Draw bitmap failed"
+            );
+        }
+    }
+    int64_t elapsed_us = esp_timer_get_time() - start_us;
+    auto stats = bus->getStatistics();
+
+    uint32_t frame_us = elapsed_us / TEST_BENCH_FRAME_NUM;
+    ESP_LOGI(
+        TAG, "Flush: %" PRIu32 " us/frame (model: %" PRIu32 " us), %" PRIu32 " fps, %" PRIu32 " KB/s",
+        frame_us, expected_frame_us, 1000000 / frame_us, (uint32_t)(stats.color_bytes * 1000 / elapsed_us)
+    );
+    ESP_LOGI(
+        TAG, "Transactions: param(%" PRIu32 "), color(%" PRIu32 "), max in-flight(%" PRIu32 "), busy(%" PRIu64 " us)",
+        stats.param_trans_num, stats.color_trans_num, stats.queue_depth_max, stats.busy_time_us
+    );
+    TEST_ASSERT_EQUAL_UINT32(TEST_BENCH_FRAME_NUM * strip_num, stats.color_trans_num);
+    TEST_ASSERT_EQUAL_UINT64((uint64_t)TEST_BENCH_FRAME_NUM * strip_num * strip_size, stats.color_bytes);
+    // The measured time can't be shorter than the model, and should be close to it when the CPU keeps up
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(expected_frame_us, frame_us + 1);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(expected_frame_us * (100 + TEST_BENCH_TOLERANCE_PERCENT) / 100, frame_us);
+
+    heap_caps_free(strip);
+}
+
+TEST_CASE("Test virtual LCD (SPI) to draw color bar", "[lcd][virtual][spi]")
+{
+    auto bus = init_bus(ESP_PANEL_BUS_TYPE_SPI, TEST_LCD_SPI_FREQ_HZ, 1);
+    auto lcd = init_lcd(bus.get(), false);
+
+    lcd_general_test(lcd.get());
+}
+
+TEST_CASE("Test virtual LCD (SPI) flush benchmark", "[lcd][virtual][spi][benchmark]")
+{
+    auto bus = init_bus(ESP_PANEL_BUS_TYPE_SPI, TEST_LCD_SPI_FREQ_HZ, 1);
+    auto lcd = init_lcd(bus.get(), false);
+
+    run_benchmark(bus, lcd);
+}
+
+TEST_CASE("Test virtual LCD (QSPI) flush benchmark", "[lcd][virtual][qspi][benchmark]")
+{
+    auto bus = init_bus(ESP_PANEL_BUS_TYPE_QSPI, TEST_LCD_QSPI_FREQ_HZ, 4);
+    auto lcd = init_lcd(bus.get(), false);
+
+    run_benchmark(bus, lcd);
+}
+
+static int recycle_count = 0;
+
+static bool on_recycle(const uint8_t *color_data, void *user_data)
+{
+    recycle_count++;
+
+    return false;
+}
+
+static uint32_t run_render_and_flush(shared_ptr<LCD_Virtual> lcd, uint8_t *bufs[2], size_t buf_size, bool use_async)
+{
+    LCD::DrawBitmapToken tokens[2] = {};
+    uint32_t render_us = static_cast<BusVirtual *>(lcd->getBus())->calculateTransferTimeUs(buf_size);
+
+    int64_t start_us = esp_timer_get_time();
+    for (int frame = 0; frame < TEST_BENCH_FRAME_NUM; frame++) {
+        for (int y = 0, i = 0; y < TEST_LCD_HEIGHT; y += TEST_BENCH_STRIP_LINES, i ^= 1) {
+            if (use_async) {
+                // Wait until the buffer is no longer accessed by the bus
+                TEST_ASSERT_TRUE_MESSAGE(lcd->waitDrawBitmapFinish(tokens[i]), "Wait draw bitmap finish failed");
+            }
+            // Simulate the rendering which takes about the same time as the transfer
+            esp_rom_delay_us(render_us);
+            memset(bufs[i], frame + y, buf_size);
+            if (use_async) {
+                TEST_ASSERT_TRUE_MESSAGE(
+                    lcd->drawBitmapAsync(0, y, TEST_LCD_WIDTH, TEST_BENCH_STRIP_LINES, bufs[i], &tokens[i]),
+                    "Draw bitmap async failed"
+                );
+            } else {
+                TEST_ASSERT_TRUE_MESSAGE(
+                    lcd->drawBitmap(0, y, TEST_LCD_WIDTH, TEST_BENCH_STRIP_LINES, bufs[i], -1), "Draw bitmap failed"
+                );
+            }
+        }
+    }
+    if (use_async) {
+        TEST_ASSERT_TRUE_MESSAGE(lcd->waitDrawBitmapAllFinish(), "Wait all draw bitmap finish failed");
+    }
+
+    return (esp_timer_get_time() - start_us) / TEST_BENCH_FRAME_NUM;
+}
+
+TEST_CASE("Test virtual LCD (SPI) async flush to overlap rendering", "[lcd][virtual][spi][async]")
+{
+    auto bus = init_bus(ESP_PANEL_BUS_TYPE_SPI, TEST_LCD_SPI_FREQ_HZ, 1);
+    auto lcd = init_lcd(bus.get(), false);
+    TEST_ASSERT_EQUAL_INT(BusVirtual::TRANS_QUEUE_DEPTH_DEFAULT, lcd->getDrawBitmapQueueDepth());
+
+    size_t buf_size = TEST_LCD_WIDTH * TEST_BENCH_STRIP_LINES * ((TEST_LCD_COLOR_BITS + 7) / 8);
+    uint8_t *bufs[2] = {
+        (uint8_t *)heap_caps_malloc(buf_size, MALLOC_CAP_DMA | MALLOC_CAP_8BIT),
+        (uint8_t *)heap_caps_malloc(buf_size, MALLOC_CAP_DMA | MALLOC_CAP_8BIT),
+    };
+    TEST_ASSERT_NOT_NULL_MESSAGE(bufs[0], "Malloc buffer failed");
+    TEST_ASSERT_NOT_NULL_MESSAGE(bufs[1], "Malloc buffer failed");
+
+    recycle_count = 0;
+    TEST_ASSERT_TRUE_MESSAGE(lcd->attachDrawBitmapRecycleCallback(on_recycle), "Attach recycle callback failed");
+
+    uint32_t sync_frame_us = run_render_and_flush(lcd, bufs, buf_size, false);
+    TEST_ASSERT_EQUAL_INT(0, recycle_count);
+    uint32_t async_frame_us = run_render_and_flush(lcd, bufs, buf_size, true);
+    TEST_ASSERT_EQUAL_INT(TEST_BENCH_FRAME_NUM * (TEST_LCD_HEIGHT / TEST_BENCH_STRIP_LINES), recycle_count);
+
+    ESP_LOGI(
+        TAG, "Render + flush: sync %" PRIu32 " us/frame, async %" PRIu32 " us/frame", sync_frame_us, async_frame_us
+    );
+    // Rendering and transfer take about the same time, so the overlap should save at least a quarter
+    TEST_ASSERT_LESS_THAN_UINT32(sync_frame_us * 3 / 4, async_frame_us);
+
+    heap_caps_free(bufs[0]);
+    heap_caps_free(bufs[1]);
+}
+
+static int color_finish_count = 0;
+
+static bool on_color_finish(void *user_data)
+{
+    color_finish_count++;
+
+    return false;
+}
+
+TEST_CASE("Test virtual bus (SPI) to write color data by DMA path", "[lcd][virtual][spi][bus]")
+{
+    auto bus = make_shared<BusVirtual>(ESP_PANEL_BUS_TYPE_SPI, TEST_LCD_SPI_FREQ_HZ, 1);
+    TEST_ASSERT_NOT_NULL_MESSAGE(bus, "Create bus object failed");
+    TEST_ASSERT_TRUE_MESSAGE(
+        bus->configVirtual_MaxTransferSize(TEST_BUS_MAX_TRANSFER_SIZE), "Config max transfer size failed"
+    );
+    TEST_ASSERT_TRUE_MESSAGE(bus->begin(), "Bus begin failed");
+
+    size_t buf_size = TEST_LCD_WIDTH * TEST_BENCH_STRIP_LINES * ((TEST_LCD_COLOR_BITS + 7) / 8);
+    uint8_t *buf = (uint8_t *)heap_caps_malloc(buf_size, MALLOC_CAP_DMA | MALLOC_CAP_8BIT);
+    TEST_ASSERT_NOT_NULL_MESSAGE(buf, "Malloc buffer failed");
+    memset(buf, 0xA5, buf_size);
+    uint32_t chunk_num = (buf_size + TEST_BUS_MAX_TRANSFER_SIZE - 1) / TEST_BUS_MAX_TRANSFER_SIZE;
+
+    // The transfer is split by the maximum transfer size, and the callback is called once when all chunks finish
+    color_finish_count = 0;
+    bus->resetStatistics();
+    Bus::ColorTransferToken token = 0;
+    TEST_ASSERT_TRUE_MESSAGE(
+        bus->writeColorDataAsync(LCD_CMD_RAMWR, buf, buf_size, on_color_finish, nullptr, &token),
+        "Write color data async failed"
+    );
+    TEST_ASSERT_TRUE_MESSAGE(bus->waitColorDataFinish(token, 1000), "Wait color data finish failed");
+    TEST_ASSERT_TRUE(bus->isColorDataFinished(token));
+    TEST_ASSERT_EQUAL_INT(1, color_finish_count);
+    auto stats = bus->getStatistics();
+    TEST_ASSERT_EQUAL_UINT32(chunk_num, stats.color_trans_num);
+    TEST_ASSERT_EQUAL_UINT64(buf_size, stats.color_bytes);
+    // Like the SPI host, the rest chunks are sent without command
+    TEST_ASSERT_EQUAL_UINT32(chunk_num - 1, stats.color_no_cmd_num);
+
+    // The blocking write uses the same path
+    TEST_ASSERT_TRUE_MESSAGE(bus->writeColorData(LCD_CMD_RAMWR, buf, buf_size), "Write color data failed");
+    TEST_ASSERT_EQUAL_UINT32(chunk_num * 2, bus->getStatistics().color_trans_num);
+
+    // Once the LCD owns the color transfer, the bus can't queue its own ones, and the blocking write uses the polling
+    // path. The drawings of the LCD are passed through the bus, so they still finish as usual
+    auto lcd = init_lcd(bus.get(), false);
+    TEST_ASSERT_FALSE(bus->writeColorDataAsync(LCD_CMD_RAMWR, buf, buf_size, on_color_finish, nullptr, &token));
+    bus->resetStatistics();
+    TEST_ASSERT_TRUE_MESSAGE(bus->writeColorData(LCD_CMD_RAMWR, buf, buf_size), "Write color data failed");
+    stats = bus->getStatistics();
+    TEST_ASSERT_EQUAL_UINT32(0, stats.color_trans_num);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.param_trans_num);
+    TEST_ASSERT_TRUE_MESSAGE(
+        lcd->drawBitmap(0, 0, TEST_LCD_WIDTH, TEST_BENCH_STRIP_LINES, buf, 1000), "Draw bitmap failed"
+    );
+    TEST_ASSERT_EQUAL_INT(1, color_finish_count);
+
+    // The color transfer is given back when the LCD is deleted
+    TEST_ASSERT_TRUE_MESSAGE(lcd->del(), "LCD delete failed");
+    TEST_ASSERT_TRUE_MESSAGE(
+        bus->writeColorDataAsync(LCD_CMD_RAMWR, buf, buf_size, on_color_finish, nullptr, &token),
+        "Write color data async failed"
+    );
+    TEST_ASSERT_TRUE_MESSAGE(bus->waitColorDataFinish(token, 1000), "Wait color data finish failed");
+    TEST_ASSERT_EQUAL_INT(2, color_finish_count);
+
+    heap_caps_free(buf);
+}
+
+TEST_CASE("Test virtual bus (QSPI) to split color data with the continue command", "[lcd][virtual][qspi][bus]")
+{
+    auto bus = make_shared<BusVirtual>(ESP_PANEL_BUS_TYPE_QSPI, TEST_LCD_QSPI_FREQ_HZ, 4);
+    TEST_ASSERT_NOT_NULL_MESSAGE(bus, "Create bus object failed");
+    TEST_ASSERT_TRUE_MESSAGE(
+        bus->configVirtual_MaxTransferSize(TEST_BUS_MAX_TRANSFER_SIZE), "Config max transfer size failed"
+    );
+    TEST_ASSERT_TRUE_MESSAGE(bus->begin(), "Bus begin failed");
+
+    size_t buf_size = TEST_LCD_WIDTH * TEST_BENCH_STRIP_LINES * ((TEST_LCD_COLOR_BITS + 7) / 8);
+    uint8_t *buf = (uint8_t *)heap_caps_malloc(buf_size, MALLOC_CAP_DMA | MALLOC_CAP_8BIT);
+    TEST_ASSERT_NOT_NULL_MESSAGE(buf, "Malloc buffer failed");
+    memset(buf, 0xA5, buf_size);
+    uint32_t chunk_num = (buf_size + TEST_BUS_MAX_TRANSFER_SIZE - 1) / TEST_BUS_MAX_TRANSFER_SIZE;
+    TEST_ASSERT_GREATER_THAN_UINT32(1, chunk_num);
+
+    // The QSPI address is `opcode << 24 | cmd << 8`, each rest chunk should carry "RAMWRC" to keep the opcode phase
+    bus->resetStatistics();
+    TEST_ASSERT_TRUE_MESSAGE(
+        bus->writeColorData((0x32 << 24) | (LCD_CMD_RAMWR << 8), buf, buf_size), "Write color data failed"
+    );
+    auto stats = bus->getStatistics();
+    TEST_ASSERT_EQUAL_UINT32(chunk_num, stats.color_trans_num);
+    TEST_ASSERT_EQUAL_UINT64(buf_size, stats.color_bytes);
+    TEST_ASSERT_EQUAL_UINT32(chunk_num - 1, stats.color_continue_num);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.color_no_cmd_num);
+
+    heap_caps_free(buf);
+}
+
+TEST_CASE("Test virtual LCD (RGB) refresh rate", "[lcd][virtual][rgb]")
+{
+    auto bus = init_bus(ESP_PANEL_BUS_TYPE_RGB, TEST_LCD_RGB_FREQ_HZ, TEST_LCD_RGB_DATA_WIDTH);
+    auto lcd = init_lcd(bus.get(), false);
+
+    uint32_t period_us = bus->calculateRefreshPeriodUs(TEST_LCD_WIDTH, TEST_LCD_HEIGHT, TEST_LCD_COLOR_BITS);
+    ESP_LOGI(TAG, "Modeled refresh period: %" PRIu32 " us", period_us);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, period_us);
+
+    bus->resetStatistics();
+    vTaskDelay(pdMS_TO_TICKS(1000));
+    auto frames = bus->getStatistics().refresh_frames;
+    uint32_t expected_frames = 1000000 / period_us;
+    ESP_LOGI(TAG, "Refresh frames in 1s: %" PRIu32 " (model: %" PRIu32 ")", frames, expected_frames);
+    TEST_ASSERT_UINT32_WITHIN(expected_frames * TEST_BENCH_TOLERANCE_PERCENT / 100 + 1, expected_frames, frames);
+}
+
+TEST_CASE("Test virtual LCD to keep pixels in GRAM", "[lcd][virtual][gram]")
+{
+    auto bus = init_bus(ESP_PANEL_BUS_TYPE_SPI, TEST_LCD_SPI_FREQ_HZ, 1);
+    auto lcd = init_lcd(bus.get(), true);
+
+    const uint8_t *gram = lcd->getVirtualGRAM();
+    TEST_ASSERT_NOT_NULL_MESSAGE(gram, "Get GRAM failed");
+
+    int bytes_per_pixel = (TEST_LCD_COLOR_BITS + 7) / 8;
+    uint16_t pixels[4 * 2] = {
+        0x0001, 0x0002, 0x0003, 0x0004,
+        0x0005, 0x0006, 0x0007, 0x0008,
+    };
+    const int x = 10;
+    const int y = 20;
+    TEST_ASSERT_TRUE_MESSAGE(lcd->drawBitmap(x, y, 4, 2, (const uint8_t *)pixels, -1), "Draw bitmap failed");
+
+    for (int row = 0; row < 2; row++) {
+        const uint8_t *line = gram + ((y + row) * TEST_LCD_WIDTH + x) * bytes_per_pixel;
+        TEST_ASSERT_EQUAL_MEMORY(&pixels[row * 4], line, 4 * bytes_per_pixel);
+    }
+}
+
+static void check_gram_area(const uint8_t *gram, const uint8_t *frame_buffer, int x, int y, int width, int height)
+{
+    int bytes_per_pixel = (TEST_LCD_COLOR_BITS + 7) / 8;
+    for (int row = y; row < y + height; row++) {
+        size_t offset = (row * TEST_LCD_WIDTH + x) * bytes_per_pixel;
+        TEST_ASSERT_EQUAL_MEMORY(frame_buffer + offset, gram + offset, width * bytes_per_pixel);
+    }
+}
+
+TEST_CASE("Test virtual LCD (SPI) to flush merged dirty areas", "[lcd][virtual][spi][dirty_area]")
+{
+    auto bus = init_bus(ESP_PANEL_BUS_TYPE_SPI, TEST_LCD_SPI_FREQ_HZ, 1);
+    auto lcd = init_lcd(bus.get(), true);
+
+    const uint8_t *gram = lcd->getVirtualGRAM();
+    TEST_ASSERT_NOT_NULL_MESSAGE(gram, "Get GRAM failed");
+
+    int bytes_per_pixel = (TEST_LCD_COLOR_BITS + 7) / 8;
+    size_t frame_size = TEST_LCD_WIDTH * TEST_LCD_HEIGHT * bytes_per_pixel;
+    size_t trans_size = TEST_LCD_WIDTH * 8 * bytes_per_pixel;
+    uint8_t *frame_buffer = (uint8_t *)heap_caps_malloc(frame_size, MALLOC_CAP_DMA | MALLOC_CAP_8BIT);
+    uint8_t *trans_buffer = (uint8_t *)heap_caps_malloc(trans_size, MALLOC_CAP_DMA | MALLOC_CAP_8BIT);
+    TEST_ASSERT_NOT_NULL_MESSAGE(frame_buffer, "Malloc frame buffer failed");
+    TEST_ASSERT_NOT_NULL_MESSAGE(trans_buffer, "Malloc transfer buffer failed");
+    for (size_t i = 0; i < frame_size; i++) {
+        frame_buffer[i] = i * 7;
+    }
+
+    // Overlapping areas should be merged into one transfer, the far one should be sent separately
+    TEST_ASSERT_TRUE_MESSAGE(lcd->addDirtyArea(10, 10, 40, 30), "Add dirty area failed");
+    TEST_ASSERT_TRUE_MESSAGE(lcd->addDirtyArea(30, 20, 40, 30), "Add dirty area failed");
+    TEST_ASSERT_TRUE_MESSAGE(lcd->addDirtyArea(250, 180, 20, 20), "Add dirty area failed");
+    TEST_ASSERT_EQUAL_INT(2, lcd->getDirtyAreaMerger().getAreaNum());
+
+    bus->resetStatistics();
+    TEST_ASSERT_TRUE_MESSAGE(lcd->flushDirtyAreas(frame_buffer, trans_buffer, trans_size), "Flush dirty areas failed");
+    TEST_ASSERT_EQUAL_INT(0, lcd->getDirtyAreaMerger().getAreaNum());
+    auto stats = bus->getStatistics();
+    ESP_LOGI(TAG, "Flush with transfer buffer: color transactions(%" PRIu32 ")", stats.color_trans_num);
+    check_gram_area(gram, frame_buffer, 10, 10, 60, 40);
+    check_gram_area(gram, frame_buffer, 250, 180, 20, 20);
+
+    // Without the transfer buffer, the areas are expanded to the full width and sent from the frame buffer
+    for (size_t i = 0; i < frame_size; i++) {
+        frame_buffer[i] = ~frame_buffer[i];
+    }
+    TEST_ASSERT_TRUE_MESSAGE(lcd->addDirtyArea(10, 10, 40, 30), "Add dirty area failed");
+    TEST_ASSERT_TRUE_MESSAGE(lcd->addDirtyArea(250, 180, 20, 20), "Add dirty area failed");
+    TEST_ASSERT_TRUE_MESSAGE(lcd->flushDirtyAreas(frame_buffer), "Flush dirty areas failed");
+    check_gram_area(gram, frame_buffer, 0, 10, TEST_LCD_WIDTH, 30);
+    check_gram_area(gram, frame_buffer, 0, 180, TEST_LCD_WIDTH, 20);
+
+    heap_caps_free(frame_buffer);
+    heap_caps_free(trans_buffer);
+}
@@ -0,0 +1,25 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+#include <stdio.h>
+#include "unity.h"
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+extern "C" void app_main(void)
+{
+    printf("==============================\r\n");
+    printf("       HOST UTILS TEST        \r\n");
+    printf("==============================\r\n");
+    UNITY_BEGIN();
+    unity_run_all_tests();
+    UNITY_END();
+}
@@ -0,0 +1,258 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <vector>
+#include "unity.h"
+#include "utils/esp_panel_utils_blitter.hpp"
+
+using namespace esp_panel::utils;
+using Surface = Blitter::Surface;
+using Rect = Blitter::Rect;
+
+#define TEST_BENCHMARK_WIDTH    (1024)
+#define TEST_BENCHMARK_HEIGHT   (600)
+#define TEST_BENCHMARK_LOOPS    (10)
+
+/**
+ * Surface with its own buffer, the padding of the rows is filled with a guard pattern
+ */
+struct TestSurface {
+    TestSurface(int width, int height, PixelFormat format, int padding = 0)
+    {
+        int stride = width * PixelConverter::getBytesPerPixel(format) + padding;
+        buffer.resize(stride * height + 4);
+        surface = {.data = buffer.data(), .width = width, .height = height, .stride = stride, .format = format};
+        for (auto &byte : buffer) {
+            byte = rand() & 0xFF;
+        }
+    }
+
+    uint32_t readARGB(int x, int y) const
+    {
+        uint32_t argb = 0;
+        PixelConverter converter({.src_format = surface.format, .dst_format = PixelFormat::ARGB8888});
+        converter.convert(surface.getPixel(x, y), reinterpret_cast<uint8_t *>(&argb), 1);
+        return argb;
+    }
+
+    std::vector<uint8_t> buffer;
+    Surface surface;
+};
+
+static bool is_same_pixel(const Surface &a, int ax, int ay, const Surface &b, int bx, int by)
+{
+    return memcmp(a.getPixel(ax, ay), b.getPixel(bx, by), PixelConverter::getBytesPerPixel(a.format)) == 0;
+}
+
+TEST_CASE("test blitter fill and copy", "[utils][blitter]")
+{
+    BlitterCPU blitter;
+
+    for (auto format : {PixelFormat::RGB565, PixelFormat::BGR888, PixelFormat::ARGB8888}) {
+        TestSurface dst(40, 30, format, 6);
+        TestSurface expected = dst;
+        expected.surface.data = expected.buffer.data();
+        Rect rect = {3, 5, 33, 21};
+        TEST_ASSERT_TRUE(blitter.fill(dst.surface, rect, 0xFF123456));
+        TEST_ASSERT_TRUE(blitter.getLastBackend() == Blitter::Backend::CPU);
+        for (int y = 0; y < dst.surface.height; y++) {
+            for (int x = 0; x < dst.surface.width; x++) {
+                bool is_inside = (x >= rect.x) && (x < rect.x + rect.width) && (y >= rect.y) &&
+                                 (y < rect.y + rect.height);
+                if (is_inside) {
+                    uint32_t argb = dst.readARGB(x, y);
+                    TEST_ASSERT_EQUAL_HEX32((format == PixelFormat::RGB565) ? 0xFF103452 : 0xFF123456, argb);
+                } else {
+                    TEST_ASSERT_TRUE(is_same_pixel(dst.surface, x, y, expected.surface, x, y));
+                }
+            }
+        }
+    }
+
+    // Copy with conversion between the surfaces with padding
+    TestSurface src(50, 40, PixelFormat::ARGB8888, 4);
+    TestSurface dst(60, 50, PixelFormat::RGB565_SWAP, 2);
+    Rect rect = {7, 3, 31, 29};
+    TEST_ASSERT_TRUE(blitter.copy(src.surface, rect, dst.surface, 11, 13));
+    for (int j = 0; j < rect.height; j++) {
+        uint8_t expected[2] = {};
+        for (int i = 0; i < rect.width; i++) {
+            PixelConverter converter({.src_format = PixelFormat::ARGB8888, .dst_format = PixelFormat::RGB565_SWAP});
+            converter.convert(src.surface.getPixel(rect.x + i, rect.y + j), expected, 1);
+            TEST_ASSERT_EQUAL_MEMORY(expected, dst.surface.getPixel(11 + i, 13 + j), 2);
+        }
+    }
+
+    // Overlapped copy in the same surface
+    TestSurface frame(32, 32, PixelFormat::RGB565);
+    TestSurface original = frame;
+    original.surface.data = original.buffer.data();
+    TEST_ASSERT_TRUE(blitter.copy(frame.surface, {2, 2, 20, 20}, frame.surface, 5, 6));
+    for (int j = 0; j < 20; j++) {
+        for (int i = 0; i < 20; i++) {
+            TEST_ASSERT_TRUE(is_same_pixel(original.surface, 2 + i, 2 + j, frame.surface, 5 + i, 6 + j));
+        }
+    }
+
+    // Invalid parameters
+    TEST_ASSERT_FALSE(blitter.fill(frame.surface, {30, 30, 3, 3}, 0));
+    TEST_ASSERT_FALSE(blitter.fill(frame.surface, {0, 0, 0, 3}, 0));
+    TEST_ASSERT_FALSE(blitter.copy(frame.surface, {0, 0, 4, 4}, dst.surface, 58, 0));
+    TEST_ASSERT_FALSE(blitter.rotate(frame.surface, {0, 0, 4, 4}, dst.surface, 0, 0, 90));
+    TEST_ASSERT_FALSE(blitter.rotate(frame.surface, {0, 0, 4, 4}, frame.surface, 0, 0, 45));
+}
+
+TEST_CASE("test blitter rotate", "[utils][blitter]")
+{
+    BlitterCPU blitter;
+
+    for (auto format : {PixelFormat::RGB565, PixelFormat::RGB888, PixelFormat::ARGB8888}) {
+        for (int degree : {0, 90, 180, 270}) {
+            bool is_swapped = (degree == 90) || (degree == 270);
+            TestSurface src(48, 40, format);
+            // The whole packed frames use `Rotator`, and the others use the per-pixel kernels
+            for (bool is_frame : {true, false}) {
+                int dst_width = (is_swapped ? src.surface.height : src.surface.width) + (is_frame ? 0 : 5);
+                int dst_height = (is_swapped ? src.surface.width : src.surface.height) + (is_frame ? 0 : 3);
+                TestSurface dst(dst_width, dst_height, format, is_frame ? 0 : 8);
+                Rect rect = {4, 8, 36, 28};
+                int x = 0;
+                int y = 0;
+                if (is_frame) {
+                    Rotator rotator({.width = src.surface.width, .height = src.surface.height, .degree = degree});
+                    int width = rect.width;
+                    int height = rect.height;
+                    x = rect.x;
+                    y = rect.y;
+                    rotator.rotateArea(x, y, width, height);
+                } else {
+                    x = 2;
+                    y = 1;
+                }
+                TEST_ASSERT_TRUE(blitter.rotate(src.surface, rect, dst.surface, x, y, degree));
+
+                for (int j = 0; j < rect.height; j++) {
+                    for (int i = 0; i < rect.width; i++) {
+                        int dst_x = x + i;
+                        int dst_y = y + j;
+                        if (degree == 90) {
+                            dst_x = x + j;
+                            dst_y = y + rect.width - 1 - i;
+                        } else if (degree == 180) {
+                            dst_x = x + rect.width - 1 - i;
+                            dst_y = y + rect.height - 1 - j;
+                        } else if (degree == 270) {
+                            dst_x = x + rect.height - 1 - j;
+                            dst_y = y + i;
+                        }
+                        TEST_ASSERT_TRUE(is_same_pixel(src.surface, rect.x + i, rect.y + j, dst.surface, dst_x, dst_y));
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("test blitter scale", "[utils][blitter]")
+{
+    BlitterCPU blitter;
+    TestSurface src(30, 20, PixelFormat::BGR888, 3);
+
+    const Rect dst_rects[] = {{1, 2, 60, 50}, {0, 0, 11, 7}, {5, 5, 30, 20}};
+    for (auto &dst_rect : dst_rects) {
+        TestSurface dst(70, 60, PixelFormat::BGR888, 1);
+        Rect src_rect = {2, 1, 25, 18};
+        TEST_ASSERT_TRUE(blitter.scale(src.surface, src_rect, dst.surface, dst_rect));
+        for (int j = 0; j < dst_rect.height; j++) {
+            for (int i = 0; i < dst_rect.width; i++) {
+                int src_x = src_rect.x + (2 * i + 1) * src_rect.width / (2 * dst_rect.width);
+                int src_y = src_rect.y + (2 * j + 1) * src_rect.height / (2 * dst_rect.height);
+                TEST_ASSERT_TRUE(is_same_pixel(src.surface, src_x, src_y, dst.surface, dst_rect.x + i, dst_rect.y + j));
+            }
+        }
+    }
+}
+
+TEST_CASE("test blitter blend", "[utils][blitter]")
+{
+    BlitterCPU blitter;
+
+    for (auto dst_format : {PixelFormat::RGB565, PixelFormat::BGR888, PixelFormat::ARGB8888}) {
+        for (int opa : {0, 128, 255}) {
+            TestSurface fg(20, 16, PixelFormat::ARGB8888, 4);
+            TestSurface dst(24, 20, dst_format, 2);
+            TestSurface original = dst;
+            original.surface.data = original.buffer.data();
+            // Cover the transparent and opaque pixels
+            *reinterpret_cast<uint32_t *>(fg.surface.getPixel(0, 0)) &= 0x00FFFFFF;
+            *reinterpret_cast<uint32_t *>(fg.surface.getPixel(1, 0)) |= 0xFF000000;
+
+            Rect rect = {1, 0, 17, 15};
+            TEST_ASSERT_TRUE(blitter.blend(fg.surface, rect, dst.surface, 3, 4, opa));
+            for (int j = 0; j < rect.height; j++) {
+                for (int i = 0; i < rect.width; i++) {
+                    uint32_t f = fg.readARGB(rect.x + i, rect.y + j);
+                    uint32_t b = original.readARGB(3 + i, 4 + j);
+                    uint32_t alpha = ((f >> 24) * opa + 127) / 255;
+                    uint32_t expected = 0;
+                    for (int shift : {0, 8, 16}) {
+                        uint32_t c = ((f >> shift) & 0xFF) * alpha + ((b >> shift) & 0xFF) * (255 - alpha);
+                        expected |= ((c + 127) / 255) << shift;
+                    }
+                    expected |= (alpha + ((b >> 24) * (255 - alpha) + 127) / 255) << 24;
+
+                    // Convert the expected color to the destination format
+                    TestSurface pixel(1, 1, dst_format);
+                    PixelConverter converter({.src_format = PixelFormat::ARGB8888, .dst_format = dst_format});
+                    converter.convert(reinterpret_cast<const uint8_t *>(&expected), pixel.surface.data, 1);
+                    if (alpha == 0) {
+                        TEST_ASSERT_TRUE(is_same_pixel(original.surface, 3 + i, 4 + j, dst.surface, 3 + i, 4 + j));
+                    } else {
+                        TEST_ASSERT_TRUE(is_same_pixel(pixel.surface, 0, 0, dst.surface, 3 + i, 4 + j));
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("test blitter benchmark", "[utils][blitter][benchmark]")
+{
+    BlitterCPU blitter;
+    TestSurface src(TEST_BENCHMARK_WIDTH, TEST_BENCHMARK_HEIGHT, PixelFormat::RGB565);
+    TestSurface src_argb(TEST_BENCHMARK_WIDTH, TEST_BENCHMARK_HEIGHT, PixelFormat::ARGB8888);
+    TestSurface dst(TEST_BENCHMARK_WIDTH, TEST_BENCHMARK_HEIGHT, PixelFormat::RGB565);
+    TestSurface dst_rotated(TEST_BENCHMARK_HEIGHT, TEST_BENCHMARK_WIDTH, PixelFormat::RGB565);
+    Rect full = {0, 0, TEST_BENCHMARK_WIDTH, TEST_BENCHMARK_HEIGHT};
+    Rect half = {0, 0, TEST_BENCHMARK_WIDTH / 2, TEST_BENCHMARK_HEIGHT / 2};
+    double pixels = static_cast<double>(TEST_BENCHMARK_WIDTH) * TEST_BENCHMARK_HEIGHT * TEST_BENCHMARK_LOOPS;
+
+    struct {
+        const char *name;
+        std::function<bool()> operation;
+    } operations[] = {
+        {"fill", [&]() { return blitter.fill(dst.surface, full, 0xFF336699); }},
+        {"copy", [&]() { return blitter.copy(src.surface, full, dst.surface, 0, 0); }},
+        {"convert", [&]() { return blitter.copy(src_argb.surface, full, dst.surface, 0, 0); }},
+        {"rotate 90", [&]() { return blitter.rotate(src.surface, full, dst_rotated.surface, 0, 0, 90); }},
+        {"scale 2x", [&]() { return blitter.scale(src.surface, half, dst.surface, full); }},
+        {"blend", [&]() { return blitter.blend(src_argb.surface, full, dst.surface, 0, 0, 200); }},
+    };
+
+    printf("Blit %dx%d RGB565, MPixel/s:\n", TEST_BENCHMARK_WIDTH, TEST_BENCHMARK_HEIGHT);
+    for (auto &operation : operations) {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < TEST_BENCHMARK_LOOPS; i++) {
+            TEST_ASSERT_TRUE(operation.operation());
+        }
+        std::chrono::duration<double, std::micro> elapsed_us = std::chrono::steady_clock::now() - start;
+        printf("%-10s %8.1f\n", operation.name, pixels / elapsed_us.count());
+    }
+}
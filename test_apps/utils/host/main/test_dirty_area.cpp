@@ -0,0 +1,148 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include "unity.h"
+#include "utils/esp_panel_utils_dirty_area.hpp"
+
+using namespace esp_panel::utils;
+
+#define TEST_FRAME_WIDTH        (360)
+#define TEST_FRAME_HEIGHT       (360)
+#define TEST_BENCHMARK_FRAMES   (10000)
+#define TEST_BENCHMARK_AREAS    (24)
+
+static DirtyAreaMerger::Config get_test_config(int x_align = 1, int y_align = 1)
+{
+    return DirtyAreaMerger::Config{
+        .width = TEST_FRAME_WIDTH,
+        .height = TEST_FRAME_HEIGHT,
+        .x_align = x_align,
+        .y_align = y_align,
+        .transfer_overhead_px = DirtyAreaMerger::TRANSFER_OVERHEAD_PX_DEFAULT,
+    };
+}
+
+static void check_area(const DirtyAreaMerger::Area &area, int x1, int y1, int x2, int y2)
+{
+    TEST_ASSERT_EQUAL_INT(x1, area.x1);
+    TEST_ASSERT_EQUAL_INT(y1, area.y1);
+    TEST_ASSERT_EQUAL_INT(x2, area.x2);
+    TEST_ASSERT_EQUAL_INT(y2, area.y2);
+}
+
+TEST_CASE("test dirty area merger to merge overlapping areas", "[utils][dirty_area]")
+{
+    DirtyAreaMerger merger(get_test_config());
+
+    TEST_ASSERT_TRUE(merger.add(0, 0, 10, 10));
+    TEST_ASSERT_TRUE(merger.add(5, 5, 10, 10));
+    TEST_ASSERT_EQUAL_INT(1, merger.getAreaNum());
+    check_area(merger.getArea(0), 0, 0, 15, 15);
+
+    // Far away, sending the bounding box costs more than another transfer
+    TEST_ASSERT_TRUE(merger.add(300, 300, 10, 10));
+    TEST_ASSERT_EQUAL_INT(2, merger.getAreaNum());
+
+    // Contained by the existing area
+    TEST_ASSERT_TRUE(merger.add(2, 2, 3, 3));
+    TEST_ASSERT_EQUAL_INT(2, merger.getAreaNum());
+
+    // Covers all, the existing areas should be merged in a chain
+    TEST_ASSERT_TRUE(merger.add(0, 0, TEST_FRAME_WIDTH, TEST_FRAME_HEIGHT));
+    TEST_ASSERT_EQUAL_INT(1, merger.getAreaNum());
+    check_area(merger.getArea(0), 0, 0, TEST_FRAME_WIDTH, TEST_FRAME_HEIGHT);
+
+    merger.reset();
+    TEST_ASSERT_EQUAL_INT(0, merger.getAreaNum());
+    TEST_ASSERT_EQUAL_UINT32(0, merger.getCost());
+}
+
+TEST_CASE("test dirty area merger to respect alignment and frame", "[utils][dirty_area]")
+{
+    DirtyAreaMerger merger(get_test_config(2, 4));
+
+    TEST_ASSERT_TRUE(merger.add(3, 3, 1, 1));
+    check_area(merger.getArea(0), 2, 0, 4, 4);
+
+    merger.reset();
+    TEST_ASSERT_TRUE(merger.add(TEST_FRAME_WIDTH - 2, TEST_FRAME_HEIGHT - 2, 10, 10));
+    check_area(merger.getArea(0), TEST_FRAME_WIDTH - 2, TEST_FRAME_HEIGHT - 4, TEST_FRAME_WIDTH, TEST_FRAME_HEIGHT);
+
+    TEST_ASSERT_FALSE(merger.add(TEST_FRAME_WIDTH, 0, 1, 1));
+    TEST_ASSERT_FALSE(merger.add(-1, 0, 1, 1));
+    TEST_ASSERT_FALSE(merger.add(0, 0, 0, 1));
+    TEST_ASSERT_EQUAL_INT(1, merger.getAreaNum());
+
+    TEST_ASSERT_FALSE(merger.setConfig(get_test_config(0, 1)));
+}
+
+TEST_CASE("test dirty area merger to keep areas within the limit", "[utils][dirty_area]")
+{
+    DirtyAreaMerger merger(get_test_config());
+    DirtyAreaMerger::Area bounding_box = {};
+
+    for (int i = 0; i < DirtyAreaMerger::AREA_MAX_NUM * 3; i++) {
+        int x = (i * 37) % (TEST_FRAME_WIDTH - 4);
+        int y = (i * 53) % (TEST_FRAME_HEIGHT - 4);
+        TEST_ASSERT_TRUE(merger.add(x, y, 4, 4));
+        bounding_box = bounding_box.getUnion({x, y, x + 4, y + 4});
+        TEST_ASSERT_LESS_OR_EQUAL_INT(DirtyAreaMerger::AREA_MAX_NUM, merger.getAreaNum());
+    }
+
+    // Every added area should still be covered
+    for (int i = 0; i < DirtyAreaMerger::AREA_MAX_NUM * 3; i++) {
+        DirtyAreaMerger::Area area = {
+            (i * 37) % (TEST_FRAME_WIDTH - 4), (i * 53) % (TEST_FRAME_HEIGHT - 4), 0, 0
+        };
+        area.x2 = area.x1 + 4;
+        area.y2 = area.y1 + 4;
+        bool is_covered = false;
+        for (auto &merged : merger) {
+            is_covered = is_covered || merged.isContain(area);
+        }
+        TEST_ASSERT_TRUE(is_covered);
+    }
+    TEST_ASSERT_TRUE(bounding_box.isContain(merger.getArea(0)));
+}
+
+TEST_CASE("test dirty area merger benchmark", "[utils][dirty_area][benchmark]")
+{
+    DirtyAreaMerger merger(get_test_config(2, 2));
+    uint64_t unmerged_cost = 0;
+    uint64_t merged_cost = 0;
+    uint64_t merged_num = 0;
+
+    srand(1);
+    auto start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < TEST_BENCHMARK_FRAMES; frame++) {
+        merger.reset();
+        // Clustered small invalidations, like the widgets updated by a UI frame
+        int cx = rand() % TEST_FRAME_WIDTH;
+        int cy = rand() % TEST_FRAME_HEIGHT;
+        for (int i = 0; i < TEST_BENCHMARK_AREAS; i++) {
+            int x = (cx + rand() % 64) % TEST_FRAME_WIDTH;
+            int y = (cy + rand() % 64) % TEST_FRAME_HEIGHT;
+            int w = 4 + rand() % 32;
+            int h = 4 + rand() % 16;
+            merger.add(x, y, w, h);
+            unmerged_cost += DirtyAreaMerger::TRANSFER_OVERHEAD_PX_DEFAULT + w * h;
+        }
+        merged_cost += merger.getCost();
+        merged_num += merger.getAreaNum();
+    }
+    auto elapsed_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                          std::chrono::steady_clock::now() - start
+                      ).count();
+
+    printf(
+        "Merged %d areas per frame into %.2f transfers, cost: %.1f%% of unmerged, time: %.2f us per frame\n",
+        TEST_BENCHMARK_AREAS, static_cast<double>(merged_num) / TEST_BENCHMARK_FRAMES,
+        100.0 * merged_cost / unmerged_cost, static_cast<double>(elapsed_us) / TEST_BENCHMARK_FRAMES
+    );
+    TEST_ASSERT_TRUE(merged_cost < unmerged_cost);
+}
@@ -0,0 +1,74 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+#include <cmath>
+#include "unity.h"
+#include "utils/esp_panel_utils_fade.hpp"
+
+using namespace esp_panel::utils;
+
+#define TEST_STEP_NUM   (50)
+
+TEST_CASE("Test fade lightness conversions", "[utils][fade]")
+{
+    TEST_ASSERT_TRUE(convertLightnessToLuminance(0) == 0);
+    TEST_ASSERT_TRUE(std::fabs(convertLightnessToLuminance(100) - 100) < 0.01f);
+    TEST_ASSERT_TRUE(convertLightnessToLuminance(150) == convertLightnessToLuminance(100));
+    // Mid-grey of CIE L*a*b*, L* = 50 is about 18.4% luminance
+    TEST_ASSERT_TRUE(std::fabs(convertLightnessToLuminance(50) - 18.42f) < 0.05f);
+
+    float last = -1;
+    for (int i = 0; i <= 1000; i++) {
+        float lightness = i / 10.0f;
+        float luminance = convertLightnessToLuminance(lightness);
+        TEST_ASSERT_TRUE(luminance > last);
+        TEST_ASSERT_TRUE(std::fabs(convertLuminanceToLightness(luminance) - lightness) < 0.01f);
+        last = luminance;
+    }
+}
+
+TEST_CASE("Test fade plan with linear curve", "[utils][fade]")
+{
+    FadePlan plan(20, 80, 6, FadeCurve::LINEAR);
+
+    TEST_ASSERT_EQUAL_INT(6, plan.getStepNum());
+    for (int i = 0; i <= 6; i++) {
+        TEST_ASSERT_TRUE(std::fabs(plan.getLevel(i) - (20 + i * 10)) < 0.001f);
+    }
+    TEST_ASSERT_TRUE(plan.getLevel(-1) == 20);
+    TEST_ASSERT_TRUE(plan.getLevel(7) == 80);
+
+    FadePlan plan_zero(30, 10, 0, FadeCurve::LINEAR);
+    TEST_ASSERT_EQUAL_INT(1, plan_zero.getStepNum());
+    TEST_ASSERT_TRUE(plan_zero.getLevel(1) == 10);
+}
+
+TEST_CASE("Test fade plan with gamma curve", "[utils][fade]")
+{
+    const float endpoints[][2] = {{0, 100}, {100, 0}, {5, 60}, {60, 5}, {42, 42}};
+
+    for (auto &endpoint : endpoints) {
+        float from = endpoint[0];
+        float to = endpoint[1];
+        FadePlan plan(from, to, TEST_STEP_NUM, FadeCurve::GAMMA);
+
+        TEST_ASSERT_TRUE(plan.getLevel(0) == from);
+        TEST_ASSERT_TRUE(plan.getLevel(TEST_STEP_NUM) == to);
+
+        // Monotonic, and the steps are uniform in lightness
+        float lightness_step = (convertLuminanceToLightness(to) - convertLuminanceToLightness(from)) / TEST_STEP_NUM;
+        for (int i = 1; i <= TEST_STEP_NUM; i++) {
+            float prev = plan.getLevel(i - 1);
+            float level = plan.getLevel(i);
+            TEST_ASSERT_TRUE((to >= from) ? (level >= prev) : (level <= prev));
+            float delta = convertLuminanceToLightness(level) - convertLuminanceToLightness(prev);
+            TEST_ASSERT_TRUE(std::fabs(delta - lightness_step) < 0.05f);
+        }
+    }
+
+    // The gamma curve stays dark longer than the linear one when rising
+    FadePlan gamma(0, 100, 2, FadeCurve::GAMMA);
+    TEST_ASSERT_TRUE(gamma.getLevel(1) < 20);
+}
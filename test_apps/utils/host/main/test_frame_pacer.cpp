@@ -0,0 +1,119 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+#include <cstdio>
+#include <cstdlib>
+#include "unity.h"
+#include "utils/esp_panel_utils_frame_pacer.hpp"
+
+using namespace esp_panel::utils;
+
+#define TEST_PERIOD_US              (16667)
+#define TEST_VSYNC_US               (1000000)
+#define TEST_FRAME_NUM              (1000)
+
+TEST_CASE("test frame pacer to learn the period", "[utils][frame_pacer]")
+{
+    FramePacer pacer;
+
+    TEST_ASSERT_FALSE(pacer.setConfig({.period_us = 1000}));
+    TEST_ASSERT_TRUE(pacer.setConfig({.margin_us = 500}));
+
+    // Not ready, start at once
+    auto plan = pacer.schedule(123);
+    TEST_ASSERT_FALSE(plan.is_paced);
+    TEST_ASSERT_EQUAL_UINT32(123, plan.start_us);
+
+    // The jitters are filtered, and the paused refreshes are ignored
+    uint32_t time_us = TEST_VSYNC_US;
+    for (int i = 0; i < 200; i++) {
+        time_us += TEST_PERIOD_US + ((i % 2) ? 40 : -40) + (((i % 50) == 25) ? 3 * TEST_PERIOD_US : 0);
+        pacer.notifyVsync(time_us);
+    }
+    TEST_ASSERT_TRUE(pacer.isReady());
+    TEST_ASSERT_UINT32_WITHIN(50, TEST_PERIOD_US, pacer.getPeriodUs());
+    TEST_ASSERT_EQUAL_UINT32(200, pacer.getVsyncNum());
+
+    // The stale vsync is not used
+    plan = pacer.schedule(time_us + 10 * TEST_PERIOD_US);
+    TEST_ASSERT_FALSE(plan.is_paced);
+}
+
+TEST_CASE("test frame pacer to start as late as possible", "[utils][frame_pacer]")
+{
+    FramePacer pacer({.margin_us = 1000, .period_us = TEST_PERIOD_US});
+    FramePacer::Plan plan;
+
+    pacer.notifyVsync(TEST_VSYNC_US);
+    pacer.notifyRender(plan, 0, 5000);
+    TEST_ASSERT_EQUAL_UINT32(5000, pacer.getRenderEstimateUs());
+
+    // Enough time before the next vsync
+    plan = pacer.schedule(TEST_VSYNC_US + 1000);
+    TEST_ASSERT_TRUE(plan.is_paced);
+    TEST_ASSERT_EQUAL_UINT32(TEST_VSYNC_US + TEST_PERIOD_US, plan.deadline_us);
+    TEST_ASSERT_EQUAL_UINT32(TEST_VSYNC_US + TEST_PERIOD_US - 6000, plan.start_us);
+
+    // Too late for the next vsync, aim at the one after it
+    plan = pacer.schedule(TEST_VSYNC_US + TEST_PERIOD_US - 3000);
+    TEST_ASSERT_EQUAL_UINT32(TEST_VSYNC_US + 2 * TEST_PERIOD_US, plan.deadline_us);
+    TEST_ASSERT_EQUAL_UINT32(TEST_VSYNC_US + 2 * TEST_PERIOD_US - 6000, plan.start_us);
+
+    // Before the last vsync
+    plan = pacer.schedule(TEST_VSYNC_US - 2 * TEST_PERIOD_US);
+    TEST_ASSERT_EQUAL_UINT32(TEST_VSYNC_US - TEST_PERIOD_US, plan.deadline_us);
+
+    // A long render time is kept for a while
+    pacer.notifyRender(plan, 0, 12000);
+    for (int i = 0; i < FramePacer::RENDER_HISTORY_NUM - 1; i++) {
+        pacer.notifyRender(plan, 0, 2000);
+        TEST_ASSERT_EQUAL_UINT32(12000, pacer.getRenderEstimateUs());
+    }
+    pacer.notifyRender(plan, 0, 2000);
+    TEST_ASSERT_EQUAL_UINT32(2000, pacer.getRenderEstimateUs());
+}
+
+TEST_CASE("test frame pacer with a render loop", "[utils][frame_pacer]")
+{
+    FramePacer pacer({.margin_us = 1000});
+    uint32_t next_vsync_us = TEST_VSYNC_US;
+    uint32_t now_us = TEST_VSYNC_US - TEST_PERIOD_US / 2;
+    uint32_t freshness_us = 0;
+    int spike_num = 0;
+
+    srand(1);
+    for (int i = 0; i < TEST_FRAME_NUM; i++) {
+        auto plan = pacer.schedule(now_us);
+        TEST_ASSERT_TRUE(static_cast<int32_t>(plan.start_us - now_us) >= 0);
+        // Simulate the vsync events during sleeping and rendering
+        uint32_t render_us = 3000 + rand() % 4000;
+        if ((i % 100) == 50) {
+            render_us += TEST_PERIOD_US / 2;
+            spike_num++;
+        }
+        uint32_t finish_us = plan.start_us + render_us;
+        while (static_cast<int32_t>(finish_us - next_vsync_us) >= 0) {
+            pacer.notifyVsync(next_vsync_us);
+            next_vsync_us += TEST_PERIOD_US;
+        }
+        pacer.notifyRender(plan, plan.start_us, finish_us);
+        if (plan.is_paced && (i >= TEST_FRAME_NUM / 2)) {
+            freshness_us += plan.deadline_us - plan.start_us;
+        }
+        now_us = finish_us;
+    }
+
+    printf(
+        "Frame pacer: %d/%d frames missed, average start %d us before the deadline\n",
+        static_cast<int>(pacer.getMissedNum()), static_cast<int>(pacer.getFrameNum()),
+        static_cast<int>(freshness_us / (TEST_FRAME_NUM / 2))
+    );
+    TEST_ASSERT_UINT32_WITHIN(1, TEST_PERIOD_US, pacer.getPeriodUs());
+    TEST_ASSERT_GREATER_THAN_INT(TEST_FRAME_NUM - 10, static_cast<int>(pacer.getFrameNum()));
+    // Only the spikes miss the deadlines
+    TEST_ASSERT_TRUE(pacer.getMissedNum() <= static_cast<uint32_t>(spike_num));
+    // Each frame starts close to its deadline
+    TEST_ASSERT_LESS_THAN_UINT32(TEST_PERIOD_US, freshness_us / (TEST_FRAME_NUM / 2));
+}
@@ -0,0 +1,189 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include "unity.h"
+#include "utils/esp_panel_utils_frame_sync.hpp"
+
+using namespace esp_panel::utils;
+
+#define TEST_FRAME_WIDTH            (200)
+#define TEST_FRAME_HEIGHT           (120)
+#define TEST_FRAME_NUM              (200)
+#define TEST_BENCHMARK_WIDTH        (1024)
+#define TEST_BENCHMARK_HEIGHT       (600)
+#define TEST_BENCHMARK_FRAMES       (100)
+
+struct TestArea {
+    int x;
+    int y;
+    int width;
+    int height;
+};
+
+static TestArea get_random_area(int frame_width, int frame_height, int max_size)
+{
+    TestArea area = {};
+    area.width = 1 + rand() % max_size;
+    area.height = 1 + rand() % max_size;
+    area.width = (area.width > frame_width) ? frame_width : area.width;
+    area.height = (area.height > frame_height) ? frame_height : area.height;
+    area.x = rand() % (frame_width - area.width + 1);
+    area.y = rand() % (frame_height - area.height + 1);
+
+    return area;
+}
+
+static void draw_area(uint8_t *buffer, int frame_width, const TestArea &area, int bytes_per_pixel, uint8_t value)
+{
+    for (int y = area.y; y < area.y + area.height; y++) {
+        memset(
+            buffer + (y * frame_width + area.x) * bytes_per_pixel, value + y, area.width * bytes_per_pixel
+        );
+    }
+}
+
+static void run_sync_frames(int buffer_num, int bytes_per_pixel, int tile_size)
+{
+    size_t size = TEST_FRAME_WIDTH * TEST_FRAME_HEIGHT * bytes_per_pixel;
+    std::vector<uint8_t> truth(size, 0);
+    std::vector<std::vector<uint8_t>> buffers(buffer_num, std::vector<uint8_t>(size, 0));
+    FrameBufferSync::Config config = {
+        .width = TEST_FRAME_WIDTH,
+        .height = TEST_FRAME_HEIGHT,
+        .bytes_per_pixel = bytes_per_pixel,
+        .buffer_num = buffer_num,
+        .tile_width = tile_size,
+        .tile_height = tile_size,
+    };
+    for (int i = 0; i < buffer_num; i++) {
+        config.buffers[i] = buffers[i].data();
+    }
+    FrameBufferSync sync(config);
+
+    srand(buffer_num * 100 + bytes_per_pixel * 10 + tile_size);
+    for (int frame = 0; frame < TEST_FRAME_NUM; frame++) {
+        int index = frame % buffer_num;
+        TestArea areas[4];
+        int area_num = 1 + rand() % 4;
+
+        TEST_ASSERT_TRUE(sync.beginFrame(index));
+        for (int i = 0; i < area_num; i++) {
+            // Sometimes redraw the whole frame
+            areas[i] = ((rand() % 20) == 0) ? TestArea{0, 0, TEST_FRAME_WIDTH, TEST_FRAME_HEIGHT} :
+                       get_random_area(TEST_FRAME_WIDTH, TEST_FRAME_HEIGHT, 64);
+            TEST_ASSERT_TRUE(sync.addDirtyArea(areas[i].x, areas[i].y, areas[i].width, areas[i].height));
+        }
+        TEST_ASSERT_TRUE(sync.syncFrame());
+        TEST_ASSERT_EQUAL_INT(0, sync.getStaleTileNum(index));
+        for (int i = 0; i < area_num; i++) {
+            draw_area(buffers[index].data(), TEST_FRAME_WIDTH, areas[i], bytes_per_pixel, frame);
+            draw_area(truth.data(), TEST_FRAME_WIDTH, areas[i], bytes_per_pixel, frame);
+        }
+        TEST_ASSERT_TRUE(sync.endFrame());
+
+        TEST_ASSERT_EQUAL_INT(index, sync.getLatestIndex());
+        TEST_ASSERT_EQUAL_MEMORY(truth.data(), buffers[index].data(), size);
+    }
+}
+
+TEST_CASE("test frame buffer sync to keep buffers up to date", "[utils][frame_sync]")
+{
+    for (int buffer_num = 2; buffer_num <= FrameBufferSync::BUFFER_NUM_MAX; buffer_num++) {
+        for (int bytes_per_pixel : {2, 3}) {
+            for (int tile_size : {16, FrameBufferSync::TILE_SIZE_DEFAULT, 48}) {
+                run_sync_frames(buffer_num, bytes_per_pixel, tile_size);
+            }
+        }
+    }
+}
+
+TEST_CASE("test frame buffer sync to copy only stale tiles", "[utils][frame_sync]")
+{
+    std::vector<uint8_t> buffers[2] = {
+        std::vector<uint8_t>(TEST_FRAME_WIDTH * TEST_FRAME_HEIGHT * 2),
+        std::vector<uint8_t>(TEST_FRAME_WIDTH * TEST_FRAME_HEIGHT * 2),
+    };
+    FrameBufferSync sync({
+        .width = TEST_FRAME_WIDTH,
+        .height = TEST_FRAME_HEIGHT,
+        .bytes_per_pixel = 2,
+        .buffer_num = 2,
+        .buffers = {buffers[0].data(), buffers[1].data()},
+        .tile_width = 32,
+        .tile_height = 32,
+    });
+    size_t copied_bytes = 0;
+
+    TEST_ASSERT_FALSE(sync.addDirtyArea(0, 0, 1, 1));
+    TEST_ASSERT_FALSE(sync.beginFrame(2));
+
+    // Nothing to copy for the first frame, the area touches 2x2 tiles
+    TEST_ASSERT_TRUE(sync.beginFrame(0));
+    TEST_ASSERT_FALSE(sync.beginFrame(1));
+    TEST_ASSERT_TRUE(sync.addDirtyArea(30, 30, 4, 4));
+    TEST_ASSERT_TRUE(sync.syncFrame(&copied_bytes));
+    TEST_ASSERT_TRUE(sync.endFrame());
+    TEST_ASSERT_EQUAL_UINT32(0, copied_bytes);
+    TEST_ASSERT_EQUAL_INT(4, sync.getStaleTileNum(1));
+
+    // The tile fully covered by the new area is skipped, the others are copied as two spans
+    TEST_ASSERT_TRUE(sync.beginFrame(1));
+    TEST_ASSERT_TRUE(sync.addDirtyArea(32, 32, 32, 32));
+    TEST_ASSERT_TRUE(sync.syncFrame(&copied_bytes));
+    TEST_ASSERT_TRUE(sync.endFrame());
+    TEST_ASSERT_EQUAL_UINT32(3 * 32 * 32 * 2, copied_bytes);
+    TEST_ASSERT_EQUAL_INT(0, sync.getStaleTileNum(1));
+    TEST_ASSERT_EQUAL_INT(1, sync.getStaleTileNum(0));
+
+    TEST_ASSERT_FALSE(sync.addDirtyArea(TEST_FRAME_WIDTH - 1, 0, 2, 1));
+}
+
+TEST_CASE("test frame buffer sync benchmark", "[utils][frame_sync][benchmark]")
+{
+    size_t size = TEST_BENCHMARK_WIDTH * TEST_BENCHMARK_HEIGHT * 2;
+    std::vector<uint8_t> buffers[2] = {std::vector<uint8_t>(size), std::vector<uint8_t>(size)};
+    FrameBufferSync sync({
+        .width = TEST_BENCHMARK_WIDTH,
+        .height = TEST_BENCHMARK_HEIGHT,
+        .bytes_per_pixel = 2,
+        .buffer_num = 2,
+        .buffers = {buffers[0].data(), buffers[1].data()},
+    });
+    size_t total_copied_bytes = 0;
+
+    srand(1);
+    auto start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < TEST_BENCHMARK_FRAMES; frame++) {
+        size_t copied_bytes = 0;
+        sync.beginFrame(frame % 2);
+        // A few widgets are updated every frame
+        for (int i = 0; i < 3; i++) {
+            TestArea area = get_random_area(TEST_BENCHMARK_WIDTH, TEST_BENCHMARK_HEIGHT, 160);
+            sync.addDirtyArea(area.x, area.y, area.width, area.height);
+        }
+        sync.syncFrame(&copied_bytes);
+        sync.endFrame();
+        total_copied_bytes += copied_bytes;
+    }
+    std::chrono::duration<double, std::micro> sync_us = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < TEST_BENCHMARK_FRAMES; frame++) {
+        memcpy(buffers[frame % 2].data(), buffers[(frame + 1) % 2].data(), size);
+    }
+    std::chrono::duration<double, std::micro> full_us = std::chrono::steady_clock::now() - start;
+
+    printf(
+        "Sync %dx%d: %.1f KB/frame in %.1f us, full copy: %.1f KB/frame in %.1f us\n", TEST_BENCHMARK_WIDTH,
+        TEST_BENCHMARK_HEIGHT, total_copied_bytes / 1024.0 / TEST_BENCHMARK_FRAMES,
+        sync_us.count() / TEST_BENCHMARK_FRAMES, size / 1024.0, full_us.count() / TEST_BENCHMARK_FRAMES
+    );
+    TEST_ASSERT_LESS_THAN_UINT32(size * TEST_BENCHMARK_FRAMES / 4, total_copied_bytes);
+}
@@ -0,0 +1,197 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+#include <atomic>
+#include <thread>
+#include "unity.h"
+#include "utils/esp_panel_utils_i2c_queue.hpp"
+
+using namespace esp_panel::utils;
+
+#define TEST_TOUCH_ADDR             (0x5D)
+#define TEST_BACKLIGHT_ADDR         (0x45)
+#define TEST_EXPANDER_ADDR          (0x20)
+#define TEST_THREAD_NUM             (3)
+#define TEST_TRANSACTION_NUM        (5000)
+
+using Priority = I2CQueue::Priority;
+using Transaction = I2CQueue::Transaction;
+
+static uint8_t test_read_buffer[8];
+
+static Transaction make_write(Priority priority, uint8_t address, uint8_t reg, uint8_t value, bool is_batchable)
+{
+    return {
+        .priority = priority,
+        .address = address,
+        .write_size = 2,
+        .write_data = {reg, value},
+        .is_batchable = is_batchable,
+    };
+}
+
+static Transaction make_read(Priority priority, uint8_t address, uint8_t reg)
+{
+    return {
+        .priority = priority,
+        .address = address,
+        .write_size = 1,
+        .write_data = {reg},
+        .read_buffer = test_read_buffer,
+        .read_size = sizeof(test_read_buffer),
+    };
+}
+
+TEST_CASE("test I2C queue to serve by priority", "[utils][i2c_queue]")
+{
+    I2CQueue queue({.starvation_limit = 0});
+    Transaction batch[I2CQueue::BATCH_NUM_MAX];
+
+    TEST_ASSERT_FALSE(queue.setConfig({.starvation_limit = -1}));
+    TEST_ASSERT_FALSE(queue.push({}));
+    TEST_ASSERT_FALSE(queue.push({.address = 0x80, .write_size = 1}));
+    TEST_ASSERT_FALSE(queue.push({.write_size = I2CQueue::WRITE_SIZE_MAX + 1}));
+    TEST_ASSERT_FALSE(queue.push({.read_size = 1}));
+    TEST_ASSERT_EQUAL_INT(0, queue.pop(batch, I2CQueue::BATCH_NUM_MAX));
+
+    TEST_ASSERT_TRUE(queue.push(make_write(Priority::BACKGROUND, TEST_BACKLIGHT_ADDR, 0x01, 1, false)));
+    TEST_ASSERT_TRUE(queue.push(make_write(Priority::NORMAL, TEST_EXPANDER_ADDR, 0x02, 2, false)));
+    TEST_ASSERT_TRUE(queue.push(make_read(Priority::URGENT, TEST_TOUCH_ADDR, 0x03)));
+    TEST_ASSERT_TRUE(queue.push(make_read(Priority::URGENT, TEST_TOUCH_ADDR, 0x04)));
+    TEST_ASSERT_EQUAL_INT(4, queue.getSize());
+
+    // By priority, and by the submitted order in the same priority
+    const uint8_t expected_regs[] = {0x03, 0x04, 0x02, 0x01};
+    for (auto reg : expected_regs) {
+        TEST_ASSERT_EQUAL_INT(1, queue.pop(batch, I2CQueue::BATCH_NUM_MAX));
+        TEST_ASSERT_EQUAL_UINT8(reg, batch[0].write_data[0]);
+    }
+    TEST_ASSERT_EQUAL_INT(0, queue.getSize());
+
+    // Full
+    for (int i = 0; i < I2CQueue::TRANSACTION_NUM_MAX; i++) {
+        TEST_ASSERT_TRUE(queue.push(make_write(Priority::BACKGROUND, TEST_BACKLIGHT_ADDR, 0x01, i, false)));
+    }
+    TEST_ASSERT_FALSE(queue.push(make_read(Priority::URGENT, TEST_TOUCH_ADDR, 0x01)));
+    TEST_ASSERT_EQUAL_UINT32(1, queue.getRejectedNum());
+    TEST_ASSERT_EQUAL_UINT32(4 + I2CQueue::TRANSACTION_NUM_MAX, queue.getPushedNum());
+}
+
+TEST_CASE("test I2C queue to batch the writes to the same device", "[utils][i2c_queue]")
+{
+    I2CQueue queue;
+    Transaction batch[I2CQueue::BATCH_NUM_MAX];
+
+    TEST_ASSERT_TRUE(queue.push(make_write(Priority::BACKGROUND, TEST_EXPANDER_ADDR, 0x01, 1, true)));
+    TEST_ASSERT_TRUE(queue.push(make_write(Priority::BACKGROUND, TEST_BACKLIGHT_ADDR, 0x01, 2, true)));
+    TEST_ASSERT_TRUE(queue.push(make_write(Priority::BACKGROUND, TEST_EXPANDER_ADDR, 0x02, 3, true)));
+    TEST_ASSERT_TRUE(queue.push(make_read(Priority::URGENT, TEST_TOUCH_ADDR, 0x10)));
+    TEST_ASSERT_TRUE(queue.push(make_read(Priority::BACKGROUND, TEST_EXPANDER_ADDR, 0x03)));
+    TEST_ASSERT_TRUE(queue.push(make_write(Priority::BACKGROUND, TEST_EXPANDER_ADDR, 0x04, 5, true)));
+
+    // The reads are never batched
+    TEST_ASSERT_EQUAL_INT(1, queue.pop(batch, I2CQueue::BATCH_NUM_MAX));
+    TEST_ASSERT_EQUAL_UINT8(TEST_TOUCH_ADDR, batch[0].address);
+
+    // The later writes are batched until a non-batchable transaction to the same device
+    TEST_ASSERT_EQUAL_INT(2, queue.pop(batch, I2CQueue::BATCH_NUM_MAX));
+    TEST_ASSERT_EQUAL_UINT8(TEST_EXPANDER_ADDR, batch[0].address);
+    TEST_ASSERT_EQUAL_UINT8(0x01, batch[0].write_data[0]);
+    TEST_ASSERT_EQUAL_UINT8(TEST_EXPANDER_ADDR, batch[1].address);
+    TEST_ASSERT_EQUAL_UINT8(0x02, batch[1].write_data[0]);
+    TEST_ASSERT_EQUAL_UINT32(1, queue.getBatchedNum());
+
+    TEST_ASSERT_EQUAL_INT(1, queue.pop(batch, I2CQueue::BATCH_NUM_MAX));
+    TEST_ASSERT_EQUAL_UINT8(TEST_BACKLIGHT_ADDR, batch[0].address);
+    TEST_ASSERT_EQUAL_INT(1, queue.pop(batch, I2CQueue::BATCH_NUM_MAX));
+    TEST_ASSERT_EQUAL_UINT8(0x03, batch[0].write_data[0]);
+    TEST_ASSERT_EQUAL_INT(1, queue.pop(batch, I2CQueue::BATCH_NUM_MAX));
+    TEST_ASSERT_EQUAL_UINT8(0x04, batch[0].write_data[0]);
+
+    // Limited by the array size
+    for (int i = 0; i < 5; i++) {
+        TEST_ASSERT_TRUE(queue.push(make_write(Priority::BACKGROUND, TEST_BACKLIGHT_ADDR, 0x10, i, true)));
+    }
+    TEST_ASSERT_EQUAL_INT(3, queue.pop(batch, 3));
+    TEST_ASSERT_EQUAL_UINT8(2, batch[2].write_data[1]);
+    TEST_ASSERT_EQUAL_INT(2, queue.pop(batch, I2CQueue::BATCH_NUM_MAX));
+    TEST_ASSERT_EQUAL_UINT8(4, batch[1].write_data[1]);
+}
+
+TEST_CASE("test I2C queue to bound the waiting of the low priorities", "[utils][i2c_queue]")
+{
+    I2CQueue queue({.starvation_limit = 3});
+    Transaction batch[I2CQueue::BATCH_NUM_MAX];
+    int served_num = 0;
+
+    TEST_ASSERT_TRUE(queue.push(make_write(Priority::BACKGROUND, TEST_BACKLIGHT_ADDR, 0x01, 0, false)));
+    // The touch keeps reading
+    while (true) {
+        TEST_ASSERT_TRUE(queue.push(make_read(Priority::URGENT, TEST_TOUCH_ADDR, 0x02)));
+        TEST_ASSERT_EQUAL_INT(1, queue.pop(batch, I2CQueue::BATCH_NUM_MAX));
+        served_num++;
+        if (batch[0].address == TEST_BACKLIGHT_ADDR) {
+            break;
+        }
+    }
+    TEST_ASSERT_EQUAL_INT(4, served_num);
+}
+
+TEST_CASE("test I2C queue with multiple threads", "[utils][i2c_queue]")
+{
+    I2CQueue queue;
+    std::atomic<int> done_num = 0;
+    std::atomic<int> popped_num = 0;
+    std::atomic<int> error_num = 0;
+
+    std::thread consumer([&]() {
+        Transaction batch[I2CQueue::BATCH_NUM_MAX];
+        std::array<int, TEST_THREAD_NUM> last_values;
+        last_values.fill(-1);
+        while ((done_num < TEST_THREAD_NUM) || (queue.getSize() > 0)) {
+            int num = queue.pop(batch, I2CQueue::BATCH_NUM_MAX);
+            for (int i = 0; i < num; i++) {
+                // The writes of each thread to its device keep the submitted order
+                int thread_id = batch[i].address - TEST_EXPANDER_ADDR;
+                int value = (batch[i].write_data[0] << 8) | batch[i].write_data[1];
+                if ((i > 0) && (batch[i].address != batch[0].address)) {
+                    error_num++;
+                }
+                if (value <= last_values[thread_id]) {
+                    error_num++;
+                }
+                last_values[thread_id] = value;
+            }
+            popped_num += num;
+            if (num == 0) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    std::array<std::thread, TEST_THREAD_NUM> producers;
+    for (int i = 0; i < TEST_THREAD_NUM; i++) {
+        producers[i] = std::thread([&, i]() {
+            for (int value = 0; value < TEST_TRANSACTION_NUM; value++) {
+                auto transaction = make_write(
+                                       static_cast<Priority>(i), TEST_EXPANDER_ADDR + i, value >> 8, value & 0xff,
+                                       (value % 3) != 0
+                                   );
+                while (!queue.push(transaction)) {
+                    std::this_thread::yield();
+                }
+            }
+            done_num++;
+        });
+    }
+    for (auto &producer : producers) {
+        producer.join();
+    }
+    consumer.join();
+
+    TEST_ASSERT_EQUAL_INT(0, error_num.load());
+    TEST_ASSERT_EQUAL_INT(TEST_THREAD_NUM * TEST_TRANSACTION_NUM, popped_num.load());
+    TEST_ASSERT_EQUAL_UINT32(TEST_THREAD_NUM * TEST_TRANSACTION_NUM, queue.getPushedNum());
+}
@@ -0,0 +1,133 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+#include <cstring>
+#include "unity.h"
+#include "utils/esp_panel_utils_latency.hpp"
+
+using namespace esp_panel::utils;
+using Stage = LatencyTracker::Stage;
+
+#define TEST_MS(ms)     ((ms) * 1000U)
+
+TEST_CASE("Test latency histogram buckets", "[utils][latency]")
+{
+    // Every value is within its bucket, and the buckets are continuous
+    for (uint32_t value = 0; value < 100000; value++) {
+        int index = LatencyHistogram::getBucketIndex(value);
+        TEST_ASSERT_TRUE(LatencyHistogram::getBucketLowerBound(index) <= value);
+        TEST_ASSERT_TRUE(LatencyHistogram::getBucketLowerBound(index + 1) > value);
+    }
+    TEST_ASSERT_EQUAL_INT(LatencyHistogram::BUCKETS_NUM - 1, LatencyHistogram::getBucketIndex(UINT32_MAX));
+    TEST_ASSERT_EQUAL_UINT32(
+        LatencyHistogram::VALUE_MAX_US + 1, LatencyHistogram::getBucketLowerBound(LatencyHistogram::BUCKETS_NUM)
+    );
+}
+
+TEST_CASE("Test latency histogram percentiles", "[utils][latency]")
+{
+    LatencyHistogram histogram;
+    TEST_ASSERT_EQUAL_UINT32(0, histogram.getPercentile(50));
+
+    for (uint32_t i = 1; i <= 100; i++) {
+        histogram.record(TEST_MS(i));
+    }
+    TEST_ASSERT_EQUAL_UINT32(100, histogram.getCount());
+    TEST_ASSERT_EQUAL_UINT32(TEST_MS(100), histogram.getMax());
+
+    // The results are the upper bounds of the buckets, within 25% of the exact values
+    uint32_t p50 = histogram.getPercentile(50);
+    uint32_t p99 = histogram.getPercentile(99);
+    TEST_ASSERT_TRUE((p50 >= TEST_MS(50)) && (p50 <= TEST_MS(50) * 5 / 4));
+    TEST_ASSERT_TRUE((p99 >= TEST_MS(99)) && (p99 <= TEST_MS(100)));
+    TEST_ASSERT_EQUAL_UINT32(TEST_MS(100), histogram.getPercentile(100));
+
+    histogram.reset();
+    TEST_ASSERT_EQUAL_UINT32(0, histogram.getCount());
+    TEST_ASSERT_EQUAL_UINT32(0, histogram.getMax());
+}
+
+TEST_CASE("Test latency tracker stages", "[utils][latency]")
+{
+    LatencyTracker tracker;
+
+    // The earliest touch before the submission is used
+    tracker.notifyTouch(TEST_MS(100));
+    tracker.notifyTouch(TEST_MS(105));
+    TEST_ASSERT_EQUAL_UINT32(0, tracker.notifySubmit(TEST_MS(110)));
+    // No touch for this frame
+    TEST_ASSERT_EQUAL_UINT32(1, tracker.notifySubmit(TEST_MS(115)));
+
+    tracker.notifyTransferDone(TEST_MS(120));
+    tracker.notifyTransferDone(TEST_MS(125));
+    // Spurious transfer done without a submitted frame
+    tracker.notifyTransferDone(TEST_MS(126));
+    tracker.notifyVsync(TEST_MS(130));
+
+    auto &touch_to_submit = tracker.getHistogram(Stage::TOUCH_TO_SUBMIT);
+    auto &submit_to_done = tracker.getHistogram(Stage::SUBMIT_TO_DONE);
+    auto &done_to_vsync = tracker.getHistogram(Stage::DONE_TO_VSYNC);
+    auto &touch_to_vsync = tracker.getHistogram(Stage::TOUCH_TO_VSYNC);
+    TEST_ASSERT_EQUAL_UINT32(1, touch_to_submit.getCount());
+    TEST_ASSERT_EQUAL_UINT32(TEST_MS(10), touch_to_submit.getMax());
+    TEST_ASSERT_EQUAL_UINT32(2, submit_to_done.getCount());
+    TEST_ASSERT_EQUAL_UINT32(TEST_MS(10), submit_to_done.getMax());
+    TEST_ASSERT_EQUAL_UINT32(2, done_to_vsync.getCount());
+    TEST_ASSERT_EQUAL_UINT32(TEST_MS(10), done_to_vsync.getMax());
+    TEST_ASSERT_EQUAL_UINT32(1, touch_to_vsync.getCount());
+    TEST_ASSERT_EQUAL_UINT32(TEST_MS(30), touch_to_vsync.getMax());
+    TEST_ASSERT_EQUAL_UINT32(0, tracker.getDroppedNum());
+
+    char line[128] = {};
+    TEST_ASSERT_TRUE(tracker.formatStage(Stage::TOUCH_TO_VSYNC, line, sizeof(line)) > 0);
+    TEST_ASSERT_NOT_NULL(strstr(line, "touch->vsync"));
+
+    tracker.reset();
+    TEST_ASSERT_EQUAL_UINT32(0, touch_to_vsync.getCount());
+}
+
+TEST_CASE("Test latency tracker with stale touches and dropped frames", "[utils][latency]")
+{
+    LatencyTracker tracker(TEST_MS(50));
+
+    // The touch is too old to cause the frame
+    tracker.notifyTouch(TEST_MS(100));
+    tracker.notifySubmit(TEST_MS(200));
+    TEST_ASSERT_EQUAL_UINT32(0, tracker.getHistogram(Stage::TOUCH_TO_SUBMIT).getCount());
+
+    // The frames without vsync are overwritten
+    for (int i = 0; i < LatencyTracker::FRAMES_MAX; i++) {
+        tracker.notifySubmit(TEST_MS(300 + i));
+    }
+    TEST_ASSERT_EQUAL_UINT32(1, tracker.getDroppedNum());
+
+    // The transfers continue from the oldest frame in the ring
+    tracker.notifyTransferDone(TEST_MS(400));
+    tracker.notifyVsync(TEST_MS(410));
+    TEST_ASSERT_EQUAL_UINT32(1, tracker.getHistogram(Stage::SUBMIT_TO_DONE).getCount());
+    TEST_ASSERT_EQUAL_UINT32(TEST_MS(100), tracker.getHistogram(Stage::SUBMIT_TO_DONE).getMax());
+
+    // The timestamps wrap around
+    tracker.notifyTouch(UINT32_MAX - TEST_MS(5) + 1);
+    tracker.notifySubmit(TEST_MS(5));
+    TEST_ASSERT_EQUAL_UINT32(TEST_MS(10), tracker.getHistogram(Stage::TOUCH_TO_SUBMIT).getMax());
+}
+
+TEST_CASE("Test latency tracker with cancelled frames", "[utils][latency]")
+{
+    LatencyTracker tracker;
+
+    uint32_t id = tracker.notifySubmit(TEST_MS(100));
+    tracker.notifySubmit(TEST_MS(110));
+    tracker.notifyCancel(id);
+
+    // The cancelled frame is skipped by the transfer done
+    tracker.notifyTransferDone(TEST_MS(115));
+    tracker.notifyVsync(TEST_MS(120));
+    TEST_ASSERT_EQUAL_UINT32(1, tracker.getHistogram(Stage::SUBMIT_TO_DONE).getCount());
+    TEST_ASSERT_EQUAL_UINT32(TEST_MS(5), tracker.getHistogram(Stage::SUBMIT_TO_DONE).getMax());
+    TEST_ASSERT_EQUAL_UINT32(1, tracker.getHistogram(Stage::DONE_TO_VSYNC).getCount());
+    TEST_ASSERT_EQUAL_UINT32(0, tracker.getDroppedNum());
+}
@@ -0,0 +1,201 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+#include "unity.h"
+#include "utils/esp_panel_utils_line_store.hpp"
+
+using namespace esp_panel::utils;
+
+#define TEST_FRAME_WIDTH            (200)
+#define TEST_FRAME_HEIGHT           (120)
+#define TEST_WRITE_NUM              (300)
+#define TEST_BENCHMARK_WIDTH        (800)
+#define TEST_BENCHMARK_HEIGHT       (480)
+#define TEST_BENCHMARK_LINES        (10)
+#define TEST_BENCHMARK_FRAMES       (50)
+
+static void fill_area(
+    std::vector<uint8_t> &area, int width, int height, int bytes_per_pixel, uint32_t color, bool is_noisy
+)
+{
+    area.resize(width * height * bytes_per_pixel);
+    for (int i = 0; i < width * height; i++) {
+        uint32_t pixel = is_noisy ? static_cast<uint32_t>(rand()) : color;
+        memcpy(area.data() + i * bytes_per_pixel, &pixel, bytes_per_pixel);
+    }
+}
+
+static void draw_truth(
+    std::vector<uint8_t> &truth, int x, int y, int width, int height, int bytes_per_pixel, const uint8_t *data
+)
+{
+    for (int i = 0; i < height; i++) {
+        memcpy(
+            truth.data() + ((y + i) * TEST_FRAME_WIDTH + x) * bytes_per_pixel, data + i * width * bytes_per_pixel,
+            width * bytes_per_pixel
+        );
+    }
+}
+
+static void run_write_areas(int bytes_per_pixel)
+{
+    size_t size = TEST_FRAME_WIDTH * TEST_FRAME_HEIGHT * bytes_per_pixel;
+    std::vector<uint8_t> truth(size, 0);
+    std::vector<uint8_t> frame(size, 0xAA);
+    std::vector<uint8_t> area;
+    CompressedLineStore store({
+        .width = TEST_FRAME_WIDTH,
+        .height = TEST_FRAME_HEIGHT,
+        .bytes_per_pixel = bytes_per_pixel,
+    });
+
+    srand(bytes_per_pixel);
+    for (int i = 0; i < TEST_WRITE_NUM; i++) {
+        // Sometimes write the whole lines
+        int width = ((rand() % 10) == 0) ? TEST_FRAME_WIDTH : 1 + rand() % 64;
+        int height = 1 + rand() % 32;
+        int x = rand() % (TEST_FRAME_WIDTH - width + 1);
+        int y = rand() % (TEST_FRAME_HEIGHT - height + 1);
+        fill_area(area, width, height, bytes_per_pixel, rand(), (rand() % 4) == 0);
+
+        TEST_ASSERT_TRUE(store.writeArea(x, y, width, height, area.data()));
+        draw_truth(truth, x, y, width, height, bytes_per_pixel, area.data());
+    }
+
+    // Read by different stripes, including the odd addresses
+    TEST_ASSERT_TRUE(store.readLines(0, TEST_FRAME_HEIGHT, frame.data()));
+    TEST_ASSERT_EQUAL_MEMORY(truth.data(), frame.data(), size);
+    std::vector<uint8_t> stripe(TEST_FRAME_WIDTH * 7 * bytes_per_pixel + 1);
+    for (int y = 0; y + 7 <= TEST_FRAME_HEIGHT; y += 7) {
+        TEST_ASSERT_TRUE(store.readLines(y, 7, stripe.data() + 1));
+        TEST_ASSERT_EQUAL_MEMORY(
+            truth.data() + y * TEST_FRAME_WIDTH * bytes_per_pixel, stripe.data() + 1, stripe.size() - 1
+        );
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, store.getRetiredNum());
+}
+
+TEST_CASE("test line store to keep the written areas", "[utils][line_store]")
+{
+    for (int bytes_per_pixel = 1; bytes_per_pixel <= 4; bytes_per_pixel++) {
+        run_write_areas(bytes_per_pixel);
+    }
+}
+
+TEST_CASE("test line store to compress static UI", "[utils][line_store]")
+{
+    CompressedLineStore store;
+    std::vector<uint8_t> area;
+    std::vector<uint8_t> line(TEST_FRAME_WIDTH * 2);
+
+    TEST_ASSERT_FALSE(store.setConfig({.width = 0, .height = 1}));
+    TEST_ASSERT_FALSE(store.writeArea(0, 0, 1, 1, line.data()));
+    TEST_ASSERT_TRUE(store.setConfig({.width = TEST_FRAME_WIDTH, .height = TEST_FRAME_HEIGHT}));
+    TEST_ASSERT_FALSE(store.writeArea(TEST_FRAME_WIDTH - 1, 0, 2, 1, line.data()));
+    TEST_ASSERT_FALSE(store.readLines(TEST_FRAME_HEIGHT - 1, 2, line.data()));
+
+    // The blank lines share one encoded line, which is one repeated run
+    TEST_ASSERT_EQUAL_UINT32(4, store.getEncodedSize());
+
+    // A background with a button, which has a border and a label
+    fill_area(area, TEST_FRAME_WIDTH, TEST_FRAME_HEIGHT, 2, 0x1234, false);
+    TEST_ASSERT_TRUE(store.writeArea(0, 0, TEST_FRAME_WIDTH, TEST_FRAME_HEIGHT, area.data()));
+    TEST_ASSERT_EQUAL_UINT32(4 * (TEST_FRAME_HEIGHT + 1), store.getEncodedSize());
+    fill_area(area, 80, 40, 2, 0xFFFF, false);
+    TEST_ASSERT_TRUE(store.writeArea(60, 40, 80, 40, area.data()));
+    fill_area(area, 60, 12, 2, 0, true);
+    TEST_ASSERT_TRUE(store.writeArea(70, 54, 60, 12, area.data()));
+
+    size_t size = TEST_FRAME_WIDTH * TEST_FRAME_HEIGHT * 2;
+    printf(
+        "Line store: %d bytes for %d bytes frame\n", static_cast<int>(store.getEncodedSize()), static_cast<int>(size)
+    );
+    TEST_ASSERT_LESS_THAN_UINT32(size / 8, store.getEncodedSize());
+
+    // The line is shared again after it's cleared
+    std::vector<uint8_t> blank(TEST_FRAME_WIDTH * 2, 0);
+    size_t last_size = store.getEncodedSize();
+    TEST_ASSERT_TRUE(store.writeArea(0, 0, TEST_FRAME_WIDTH, 1, blank.data()));
+    TEST_ASSERT_EQUAL_UINT32(last_size - 4, store.getEncodedSize());
+    TEST_ASSERT_TRUE(store.readLines(0, 1, line.data()));
+    TEST_ASSERT_EQUAL_MEMORY(blank.data(), line.data(), line.size());
+}
+
+TEST_CASE("test line store with a writer thread and a reader thread", "[utils][line_store]")
+{
+    CompressedLineStore store({.width = TEST_FRAME_WIDTH, .height = TEST_FRAME_HEIGHT});
+    std::atomic<bool> is_running = true;
+    std::atomic<int> error_num = 0;
+    std::atomic<int> read_num = 0;
+
+    // Every line is written by one color, so a line read during the writing should still be one color
+    std::thread reader([&]() {
+        std::vector<uint16_t> lines(TEST_FRAME_WIDTH * 8);
+        while (is_running) {
+            int y = rand() % (TEST_FRAME_HEIGHT - 8 + 1);
+            store.readLines(y, 8, reinterpret_cast<uint8_t *>(lines.data()));
+            for (int i = 0; i < 8; i++) {
+                for (int x = 1; x < TEST_FRAME_WIDTH; x++) {
+                    if (lines[i * TEST_FRAME_WIDTH + x] != lines[i * TEST_FRAME_WIDTH]) {
+                        error_num++;
+                        break;
+                    }
+                }
+            }
+            read_num++;
+        }
+    });
+
+    std::vector<uint8_t> area;
+    for (int i = 0; (i < TEST_WRITE_NUM * 10) || (read_num < 100); i++) {
+        int y = rand() % TEST_FRAME_HEIGHT;
+        fill_area(area, TEST_FRAME_WIDTH, 1, 2, 1 + i, false);
+        TEST_ASSERT_TRUE(store.writeArea(0, y, TEST_FRAME_WIDTH, 1, area.data()));
+    }
+    is_running = false;
+    reader.join();
+
+    TEST_ASSERT_EQUAL_INT(0, error_num.load());
+    store.collect();
+    TEST_ASSERT_EQUAL_UINT32(0, store.getRetiredNum());
+}
+
+TEST_CASE("test line store benchmark", "[utils][line_store][benchmark]")
+{
+    CompressedLineStore store({.width = TEST_BENCHMARK_WIDTH, .height = TEST_BENCHMARK_HEIGHT});
+    std::vector<uint8_t> area;
+    std::vector<uint8_t> stripe(TEST_BENCHMARK_WIDTH * TEST_BENCHMARK_LINES * 2);
+
+    // Background, a few cards and a noisy image
+    fill_area(area, TEST_BENCHMARK_WIDTH, TEST_BENCHMARK_HEIGHT, 2, 0x18C3, false);
+    store.writeArea(0, 0, TEST_BENCHMARK_WIDTH, TEST_BENCHMARK_HEIGHT, area.data());
+    for (int i = 0; i < 4; i++) {
+        fill_area(area, 160, 120, 2, 0xFFFF - i, false);
+        store.writeArea(20 + i * 190, 40, 160, 120, area.data());
+    }
+    fill_area(area, 120, 120, 2, 0, true);
+    store.writeArea(340, 300, 120, 120, area.data());
+
+    auto start = std::chrono::steady_clock::now();
+    for (int frame = 0; frame < TEST_BENCHMARK_FRAMES; frame++) {
+        for (int y = 0; y < TEST_BENCHMARK_HEIGHT; y += TEST_BENCHMARK_LINES) {
+            store.readLines(y, TEST_BENCHMARK_LINES, stripe.data());
+        }
+    }
+    std::chrono::duration<double, std::micro> read_us = std::chrono::steady_clock::now() - start;
+
+    printf(
+        "Line store %dx%d: %.1f KB, read %.1f us/frame\n", TEST_BENCHMARK_WIDTH, TEST_BENCHMARK_HEIGHT,
+        store.getEncodedSize() / 1024.0, read_us.count() / TEST_BENCHMARK_FRAMES
+    );
+    TEST_ASSERT_LESS_THAN_UINT32(TEST_BENCHMARK_WIDTH * TEST_BENCHMARK_HEIGHT * 2 / 8, store.getEncodedSize());
+}
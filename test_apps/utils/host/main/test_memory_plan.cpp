@@ -0,0 +1,133 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+#include "unity.h"
+#include "utils/esp_panel_utils_memory_plan.hpp"
+
+using namespace esp_panel::utils;
+
+#define TEST_H_RES      (800)
+#define TEST_V_RES      (480)
+#define TEST_FB_SIZE    (TEST_H_RES * TEST_V_RES * 2)
+
+static MemoryPlanner::Config get_test_config()
+{
+    return MemoryPlanner::Config{
+        .h_res = TEST_H_RES,
+        .v_res = TEST_V_RES,
+        .bits_per_pixel = 16,
+        .h_blank = 40,
+        .v_blank = 20,
+        .pclk_hz = 16 * 1000 * 1000,
+        .fb_num = 1,
+        .bounce_buffer_lines = -1,
+        .draw_buffer_lines = 20,
+        .draw_buffer_num = 2,
+        .gui_fps = 30,
+        .psram_bandwidth = 80 * 1000 * 1000,
+        .psram_free_size = 8 * 1024 * 1024,
+        .sram_free_size = 200 * 1024,
+        .headroom_min_percent = 20,
+    };
+}
+
+TEST_CASE("Test memory plan with draw buffers in SRAM", "[utils][memory_plan]")
+{
+    MemoryPlanner planner(get_test_config());
+    auto &plan = planner.getPlan();
+
+    TEST_ASSERT_TRUE(plan.is_feasible);
+    TEST_ASSERT_TRUE(plan.fb_in_psram);
+    TEST_ASSERT_EQUAL_INT(1, plan.fb_num);
+    TEST_ASSERT_EQUAL_INT(TEST_FB_SIZE, plan.fb_size);
+    TEST_ASSERT_EQUAL_INT(TEST_FB_SIZE, plan.psram_used_size);
+
+    // The peak scanout and the flushes are within the budget, so no bounce buffer is needed
+    TEST_ASSERT_EQUAL_INT(0, plan.bounce_buffer_size_px);
+    TEST_ASSERT_EQUAL_INT(32 * 1000 * 1000, plan.psram_read_rate);
+    TEST_ASSERT_EQUAL_INT(TEST_FB_SIZE * 30, plan.psram_write_rate);
+    TEST_ASSERT_EQUAL_INT(32, plan.headroom_percent);
+
+    TEST_ASSERT_FALSE(plan.draw_buffer_in_psram);
+    TEST_ASSERT_EQUAL_INT(TEST_H_RES * 20, plan.draw_buffer_size_px);
+    TEST_ASSERT_EQUAL_INT(2, plan.draw_buffer_num);
+    TEST_ASSERT_EQUAL_INT(TEST_H_RES * 20 * 2 * 2, plan.sram_used_size);
+    TEST_ASSERT_TRUE(plan.pclk_hz_max > 16 * 1000 * 1000);
+}
+
+TEST_CASE("Test memory plan to add bounce buffers for the bandwidth", "[utils][memory_plan]")
+{
+    // The anti-tearing mode renders into the frame buffers in PSRAM
+    auto config = get_test_config();
+    config.fb_num = 2;
+    config.draw_buffer_lines = 0;
+    MemoryPlanner planner(config);
+    auto &plan = planner.getPlan();
+
+    TEST_ASSERT_EQUAL_INT(TEST_H_RES * 10, plan.bounce_buffer_size_px);
+    TEST_ASSERT_EQUAL_INT(TEST_H_RES * 10 * 2 * 2, plan.sram_used_size);
+    TEST_ASSERT_EQUAL_INT(0, plan.draw_buffer_size_px);
+    TEST_ASSERT_EQUAL_INT(TEST_FB_SIZE * 2, plan.psram_used_size);
+    // Only the average rate is needed with the bounce buffers
+    TEST_ASSERT_TRUE(plan.psram_read_rate < 32 * 1000 * 1000);
+    TEST_ASSERT_EQUAL_INT(TEST_FB_SIZE * 30 * 2, plan.psram_write_rate);
+    TEST_ASSERT_FALSE(plan.is_feasible);
+
+    // The maximum pixel clock keeps the minimum headroom
+    config.pclk_hz = plan.pclk_hz_max;
+    config.bounce_buffer_lines = 10;
+    MemoryPlanner planner_max(config);
+    TEST_ASSERT_TRUE(planner_max.getPlan().is_feasible);
+    TEST_ASSERT_EQUAL_INT(20, planner_max.getPlan().headroom_percent);
+
+    // The lines are reduced to fit the SRAM and to divide the half frame
+    config.sram_free_size = TEST_H_RES * 7 * 2 * 2;
+    MemoryPlanner planner_small(config);
+    TEST_ASSERT_EQUAL_INT(TEST_H_RES * 6, planner_small.getPlan().bounce_buffer_size_px);
+}
+
+TEST_CASE("Test memory plan to place the draw buffers", "[utils][memory_plan]")
+{
+    // Shrink the draw buffers to fit the SRAM
+    auto config = get_test_config();
+    config.sram_free_size = TEST_H_RES * 2 * 2 * 15;
+    MemoryPlanner planner_shrink(config);
+    TEST_ASSERT_FALSE(planner_shrink.getPlan().draw_buffer_in_psram);
+    TEST_ASSERT_EQUAL_INT(TEST_H_RES * 15, planner_shrink.getPlan().draw_buffer_size_px);
+
+    // Fall back to PSRAM, which costs more bandwidth
+    config.sram_free_size = TEST_H_RES * 2 * 2 * 5;
+    MemoryPlanner planner_psram(config);
+    auto &plan = planner_psram.getPlan();
+    TEST_ASSERT_TRUE(plan.draw_buffer_in_psram);
+    TEST_ASSERT_EQUAL_INT(TEST_H_RES * 20, plan.draw_buffer_size_px);
+    TEST_ASSERT_EQUAL_INT(TEST_FB_SIZE + TEST_H_RES * 20 * 2 * 2, plan.psram_used_size);
+    TEST_ASSERT_EQUAL_INT(TEST_FB_SIZE * 30 * 2, plan.psram_write_rate);
+}
+
+TEST_CASE("Test memory plan without PSRAM", "[utils][memory_plan]")
+{
+    auto config = get_test_config();
+    config.h_res = 320;
+    config.v_res = 240;
+    config.pclk_hz = 0;
+    config.fb_num = 0;
+    config.psram_bandwidth = 0;
+    MemoryPlanner planner(config);
+    auto &plan = planner.getPlan();
+
+    TEST_ASSERT_TRUE(plan.is_feasible);
+    TEST_ASSERT_FALSE(plan.fb_in_psram);
+    TEST_ASSERT_EQUAL_INT(0, plan.psram_used_size);
+    TEST_ASSERT_EQUAL_INT(100, plan.headroom_percent);
+    TEST_ASSERT_EQUAL_INT(-1, plan.pclk_hz_max);
+
+    // The frame buffers don't fit the SRAM
+    config.fb_num = 1;
+    config.h_res = 800;
+    config.v_res = 480;
+    MemoryPlanner planner_fb(config);
+    TEST_ASSERT_FALSE(planner_fb.getPlan().is_feasible);
+}
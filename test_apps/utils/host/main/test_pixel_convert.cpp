@@ -0,0 +1,232 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include "unity.h"
+#include "utils/esp_panel_utils_pixel_convert.hpp"
+
+using namespace esp_panel::utils;
+
+#define TEST_PIXEL_NUM          (37)
+#define TEST_BENCHMARK_WIDTH    (800)
+#define TEST_BENCHMARK_HEIGHT   (480)
+#define TEST_BENCHMARK_LOOPS    (20)
+
+static const PixelFormat test_formats[] = {
+    PixelFormat::RGB565, PixelFormat::RGB565_SWAP, PixelFormat::RGB666, PixelFormat::RGB888, PixelFormat::BGR888,
+    PixelFormat::ARGB8888,
+};
+
+/**
+ * Per-pixel reference through 8-bit components, the lower bits are filled by replicating the upper bits
+ */
+static void convert_reference(const uint8_t *src, PixelFormat src_format, uint8_t *dst, PixelFormat dst_format, int num)
+{
+    int src_bytes = PixelConverter::getBytesPerPixel(src_format);
+    int dst_bytes = PixelConverter::getBytesPerPixel(dst_format);
+    for (int i = 0; i < num; i++) {
+        const uint8_t *from = src + i * src_bytes;
+        uint8_t *to = dst + i * dst_bytes;
+        int r = 0;
+        int g = 0;
+        int b = 0;
+        switch (src_format) {
+        case PixelFormat::RGB565:
+        case PixelFormat::RGB565_SWAP: {
+            int value = (src_format == PixelFormat::RGB565) ? (from[0] | (from[1] << 8)) : ((from[0] << 8) | from[1]);
+            r = ((value >> 11) << 3) | (value >> 13);
+            g = (((value >> 5) & 0x3F) << 2) | ((value >> 9) & 0x03);
+            b = ((value & 0x1F) << 3) | ((value >> 2) & 0x07);
+            break;
+        }
+        case PixelFormat::RGB666:
+            r = from[0] | (from[0] >> 6);
+            g = from[1] | (from[1] >> 6);
+            b = from[2] | (from[2] >> 6);
+            break;
+        case PixelFormat::RGB888:
+            r = from[0];
+            g = from[1];
+            b = from[2];
+            break;
+        default:
+            r = from[2];
+            g = from[1];
+            b = from[0];
+            break;
+        }
+        switch (dst_format) {
+        case PixelFormat::RGB565:
+        case PixelFormat::RGB565_SWAP: {
+            int value = ((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3);
+            to[0] = (dst_format == PixelFormat::RGB565) ? (value & 0xFF) : (value >> 8);
+            to[1] = (dst_format == PixelFormat::RGB565) ? (value >> 8) : (value & 0xFF);
+            break;
+        }
+        case PixelFormat::RGB666:
+            to[0] = r & 0xFC;
+            to[1] = g & 0xFC;
+            to[2] = b & 0xFC;
+            break;
+        case PixelFormat::RGB888:
+            to[0] = r;
+            to[1] = g;
+            to[2] = b;
+            break;
+        default:
+            to[0] = b;
+            to[1] = g;
+            to[2] = r;
+            if (dst_format == PixelFormat::ARGB8888) {
+                to[3] = 0xFF;
+            }
+            break;
+        }
+    }
+}
+
+static void fill_random(std::vector<uint8_t> &buffer, PixelFormat format)
+{
+    for (auto &byte : buffer) {
+        byte = rand() & 0xFF;
+    }
+    // Keep the source valid, so the round trips are exact
+    if (format == PixelFormat::RGB666) {
+        for (auto &byte : buffer) {
+            byte &= 0xFC;
+        }
+    }
+}
+
+TEST_CASE("test pixel converter for all formats", "[utils][pixel_convert]")
+{
+    // The offsets cover the register kernels and the per-pixel kernels of the unaligned buffers
+    for (int offset : {0, 1}) {
+        for (auto src_format : test_formats) {
+            for (auto dst_format : test_formats) {
+                PixelConverter converter({.src_format = src_format, .dst_format = dst_format});
+                std::vector<uint8_t> src(TEST_PIXEL_NUM * 4 + 4);
+                std::vector<uint8_t> dst(TEST_PIXEL_NUM * 4 + 4);
+                std::vector<uint8_t> expected(TEST_PIXEL_NUM * 4 + 4);
+                fill_random(src, src_format);
+
+                // The same formats are copied, including the alpha
+                if (src_format == dst_format) {
+                    memcpy(expected.data(), src.data() + offset, TEST_PIXEL_NUM * 4);
+                } else {
+                    convert_reference(src.data() + offset, src_format, expected.data(), dst_format, TEST_PIXEL_NUM);
+                }
+                TEST_ASSERT_TRUE(converter.convert(src.data() + offset, dst.data() + offset, TEST_PIXEL_NUM));
+                TEST_ASSERT_EQUAL_MEMORY(
+                    expected.data(), dst.data() + offset, TEST_PIXEL_NUM * PixelConverter::getBytesPerPixel(dst_format)
+                );
+                if (src_format == dst_format) {
+                    TEST_ASSERT_TRUE(converter.getLastKernel() == PixelConverter::Kernel::COPY);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("test pixel converter to use register kernels", "[utils][pixel_convert]")
+{
+    alignas(4) uint8_t src[16] = {0x12, 0x34, 0x56, 0x78};
+    alignas(4) uint8_t dst[16] = {};
+
+    PixelConverter converter({.src_format = PixelFormat::RGB565, .dst_format = PixelFormat::RGB565_SWAP});
+    TEST_ASSERT_TRUE(converter.convert(src, dst, 2));
+    TEST_ASSERT_TRUE(converter.getLastKernel() == PixelConverter::Kernel::SWAR);
+    TEST_ASSERT_EQUAL_HEX8(0x34, dst[0]);
+    TEST_ASSERT_EQUAL_HEX8(0x12, dst[1]);
+    TEST_ASSERT_EQUAL_HEX8(0x78, dst[2]);
+    TEST_ASSERT_EQUAL_HEX8(0x56, dst[3]);
+
+    // Less than a block of the register kernel
+    TEST_ASSERT_TRUE(converter.convert(src, dst, 1));
+    TEST_ASSERT_TRUE(converter.getLastKernel() == PixelConverter::Kernel::SCALAR);
+
+    // Unaligned buffers
+    TEST_ASSERT_TRUE(converter.convert(src + 2, dst, 2));
+    TEST_ASSERT_TRUE(converter.getLastKernel() == PixelConverter::Kernel::SCALAR);
+
+    TEST_ASSERT_TRUE(converter.setConfig({.src_format = PixelFormat::ARGB8888, .dst_format = PixelFormat::RGB888}));
+    TEST_ASSERT_TRUE(converter.convert(src, dst, 4));
+    TEST_ASSERT_TRUE(converter.getLastKernel() == PixelConverter::Kernel::SWAR);
+
+    TEST_ASSERT_TRUE(converter.setConfig({
+        .src_format = PixelFormat::ARGB8888, .dst_format = PixelFormat::RGB888, .enable_swar = false
+    }));
+    TEST_ASSERT_TRUE(converter.convert(src, dst, 4));
+    TEST_ASSERT_TRUE(converter.getLastKernel() == PixelConverter::Kernel::SCALAR);
+
+    TEST_ASSERT_FALSE(converter.setConfig({.src_format = PixelFormat::MAX}));
+    TEST_ASSERT_FALSE(converter.convert(nullptr, dst, 4));
+}
+
+TEST_CASE("test pixel converter in place", "[utils][pixel_convert]")
+{
+    const PixelFormat pairs[][2] = {
+        {PixelFormat::RGB565, PixelFormat::RGB565_SWAP},
+        {PixelFormat::BGR888, PixelFormat::RGB888},
+        {PixelFormat::RGB888, PixelFormat::RGB666},
+        {PixelFormat::ARGB8888, PixelFormat::RGB888},
+        {PixelFormat::ARGB8888, PixelFormat::RGB565},
+    };
+    for (auto &pair : pairs) {
+        std::vector<uint8_t> buffer(TEST_PIXEL_NUM * 4);
+        std::vector<uint8_t> expected(TEST_PIXEL_NUM * 4);
+        fill_random(buffer, pair[0]);
+
+        convert_reference(buffer.data(), pair[0], expected.data(), pair[1], TEST_PIXEL_NUM);
+        PixelConverter converter({.src_format = pair[0], .dst_format = pair[1]});
+        TEST_ASSERT_TRUE(converter.convert(buffer.data(), buffer.data(), TEST_PIXEL_NUM));
+        TEST_ASSERT_EQUAL_MEMORY(
+            expected.data(), buffer.data(), TEST_PIXEL_NUM * PixelConverter::getBytesPerPixel(pair[1])
+        );
+    }
+}
+
+TEST_CASE("test pixel converter benchmark", "[utils][pixel_convert][benchmark]")
+{
+    const PixelFormat pairs[][2] = {
+        {PixelFormat::RGB565, PixelFormat::RGB565_SWAP},
+        {PixelFormat::BGR888, PixelFormat::RGB888},
+        {PixelFormat::RGB888, PixelFormat::RGB666},
+        {PixelFormat::ARGB8888, PixelFormat::RGB888},
+        {PixelFormat::ARGB8888, PixelFormat::RGB565_SWAP},
+    };
+    int pixel_num = TEST_BENCHMARK_WIDTH * TEST_BENCHMARK_HEIGHT;
+    std::vector<uint32_t> src(pixel_num);
+    std::vector<uint32_t> dst(pixel_num);
+    auto src_data = reinterpret_cast<const uint8_t *>(src.data());
+    auto dst_data = reinterpret_cast<uint8_t *>(dst.data());
+    double pixels = static_cast<double>(pixel_num) * TEST_BENCHMARK_LOOPS;
+
+    printf("Convert %dx%d, MPixel/s (reference / converter):\n", TEST_BENCHMARK_WIDTH, TEST_BENCHMARK_HEIGHT);
+    for (auto &pair : pairs) {
+        PixelConverter converter({.src_format = pair[0], .dst_format = pair[1]});
+
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < TEST_BENCHMARK_LOOPS; i++) {
+            convert_reference(src_data, pair[0], dst_data, pair[1], pixel_num);
+        }
+        std::chrono::duration<double, std::micro> reference_us = std::chrono::steady_clock::now() - start;
+
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < TEST_BENCHMARK_LOOPS; i++) {
+            TEST_ASSERT_TRUE(converter.convert(src_data, dst_data, pixel_num));
+        }
+        std::chrono::duration<double, std::micro> converter_us = std::chrono::steady_clock::now() - start;
+
+        printf(
+            "%-8s -> %-11s %8.1f / %7.1f\n", PixelConverter::getFormatName(pair[0]),
+            PixelConverter::getFormatName(pair[1]), pixels / reference_us.count(), pixels / converter_us.count()
+        );
+    }
+}
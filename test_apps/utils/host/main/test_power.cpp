@@ -0,0 +1,127 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+#include "unity.h"
+#include "utils/esp_panel_utils_power.hpp"
+
+using namespace esp_panel::utils;
+using State = PowerPolicy::State;
+
+#define TEST_MS(ms)     ((ms) * 1000LL)
+#define TEST_START_US   TEST_MS(5000)
+
+static PowerPolicy::Config get_test_config()
+{
+    return PowerPolicy::Config{
+        .dim_timeout_ms = 1000,
+        .display_off_timeout_ms = 2000,
+        .touch_sleep_timeout_ms = 3000,
+        .static_timeout_ms = 100,
+        .active_frame_rate = 20,
+    };
+}
+
+TEST_CASE("Test power policy to enter the states by idle time", "[utils][power]")
+{
+    PowerPolicy policy(get_test_config());
+    policy.reset(TEST_START_US);
+
+    TEST_ASSERT_TRUE(policy.getState() == State::ACTIVE);
+    policy.update(TEST_START_US + TEST_MS(999));
+    TEST_ASSERT_TRUE(policy.getState() == State::ACTIVE);
+
+    TEST_ASSERT_TRUE(policy.update(TEST_START_US + TEST_MS(1000)));
+    TEST_ASSERT_TRUE(policy.getState() == State::DIMMED);
+    TEST_ASSERT_FALSE(policy.update(TEST_START_US + TEST_MS(1500)));
+
+    policy.update(TEST_START_US + TEST_MS(2000));
+    TEST_ASSERT_TRUE(policy.getState() == State::DISPLAY_OFF);
+
+    // A long gap goes to the deepest state directly
+    policy.reset(TEST_START_US);
+    policy.update(TEST_START_US + TEST_MS(10000));
+    TEST_ASSERT_TRUE(policy.getState() == State::TOUCH_SLEEP);
+    TEST_ASSERT_EQUAL_UINT32(0, policy.getStateEnterNum(State::DIMMED));
+    TEST_ASSERT_EQUAL_UINT32(1, policy.getStateEnterNum(State::TOUCH_SLEEP));
+
+    // Any activity returns to active
+    policy.notifyActivity(TEST_START_US + TEST_MS(10100));
+    TEST_ASSERT_TRUE(policy.update(TEST_START_US + TEST_MS(10200)));
+    TEST_ASSERT_TRUE(policy.getState() == State::ACTIVE);
+    TEST_ASSERT_EQUAL_UINT32(2, policy.getStateEnterNum(State::ACTIVE));
+}
+
+TEST_CASE("Test power policy to skip the disabled states", "[utils][power]")
+{
+    auto config = get_test_config();
+    config.dim_timeout_ms = 0;
+    config.touch_sleep_timeout_ms = 0;
+    PowerPolicy policy(config);
+    policy.reset(TEST_START_US);
+
+    policy.update(TEST_START_US + TEST_MS(1500));
+    TEST_ASSERT_TRUE(policy.getState() == State::ACTIVE);
+    policy.update(TEST_START_US + TEST_MS(100000));
+    TEST_ASSERT_TRUE(policy.getState() == State::DISPLAY_OFF);
+}
+
+TEST_CASE("Test power policy with the frames", "[utils][power]")
+{
+    PowerPolicy policy(get_test_config());
+    policy.reset(TEST_START_US);
+
+    // Static without frames
+    policy.update(TEST_START_US + TEST_MS(100));
+    TEST_ASSERT_TRUE(policy.isContentStatic());
+    policy.notifyFrames(TEST_START_US + TEST_MS(150));
+    TEST_ASSERT_TRUE(policy.update(TEST_START_US + TEST_MS(160)));
+    TEST_ASSERT_FALSE(policy.isContentStatic());
+
+    // A slow animation doesn't keep the display active
+    policy.reset(TEST_START_US);
+    int64_t now_us = TEST_START_US;
+    for (int i = 0; i < 150; i++) {
+        now_us += TEST_MS(100);
+        policy.notifyFrames(now_us);
+        policy.update(now_us);
+        TEST_ASSERT_FALSE(policy.isContentStatic());
+    }
+    TEST_ASSERT_EQUAL_INT(10, policy.getFrameRate());
+    TEST_ASSERT_TRUE(policy.getState() == State::TOUCH_SLEEP);
+
+    // A video keeps the display active
+    policy.reset(TEST_START_US);
+    now_us = TEST_START_US;
+    for (int i = 0; i < 300; i++) {
+        now_us += TEST_MS(20);
+        policy.notifyFrames(now_us);
+        policy.update(now_us);
+    }
+    TEST_ASSERT_EQUAL_INT(50, policy.getFrameRate());
+    TEST_ASSERT_TRUE(policy.getState() == State::ACTIVE);
+
+    // The rate drops to 0 after an empty window
+    policy.update(now_us + TEST_MS(2500));
+    TEST_ASSERT_EQUAL_INT(0, policy.getFrameRate());
+}
+
+TEST_CASE("Test power policy statistics", "[utils][power]")
+{
+    PowerPolicy policy(get_test_config());
+    policy.reset(TEST_START_US);
+
+    policy.update(TEST_START_US + TEST_MS(1000));
+    policy.update(TEST_START_US + TEST_MS(2000));
+    policy.notifyActivity(TEST_START_US + TEST_MS(2500));
+    policy.update(TEST_START_US + TEST_MS(2500));
+
+    int64_t now_us = TEST_START_US + TEST_MS(3000);
+    TEST_ASSERT_TRUE(policy.getStateTimeUs(State::ACTIVE, now_us) == TEST_MS(1500));
+    TEST_ASSERT_TRUE(policy.getStateTimeUs(State::DIMMED, now_us) == TEST_MS(1000));
+    TEST_ASSERT_TRUE(policy.getStateTimeUs(State::DISPLAY_OFF, now_us) == TEST_MS(500));
+    TEST_ASSERT_TRUE(policy.getStateTimeUs(State::TOUCH_SLEEP, now_us) == 0);
+    TEST_ASSERT_TRUE(policy.getStateTimeUs(State::MAX, now_us) == 0);
+    TEST_ASSERT_EQUAL_STRING("display-off", PowerPolicy::getStateName(State::DISPLAY_OFF));
+}
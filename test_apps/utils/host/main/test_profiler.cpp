@@ -0,0 +1,95 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include "unity.h"
+#include "utils/esp_panel_utils_profiler.hpp"
+
+using namespace esp_panel::utils;
+
+TEST_CASE("test profiler to record nested stages", "[utils][profiler]")
+{
+    Profiler profiler;
+    Profiler::Record records[8];
+    char line[128];
+
+    int board = profiler.begin("board_begin", Profiler::ARG_NONE, 1000);
+    int lcd = profiler.begin("lcd_begin", Profiler::ARG_NONE, 1100);
+    profiler.add("vendor_cmd", 0x11, 1200, 1300);
+    profiler.end(lcd, 1500);
+    int touch = profiler.begin("touch_begin", Profiler::ARG_NONE, 1500);
+    profiler.end(touch, 1600);
+    profiler.end(board, 1700);
+
+    TEST_ASSERT_EQUAL_INT(4, profiler.getRecordsNum());
+    TEST_ASSERT_EQUAL_INT(4, profiler.getRecords(records, 8));
+    const int expected_depths[] = {0, 1, 2, 1};
+    const int expected_durations[] = {700, 400, 100, 100};
+    for (int i = 0; i < 4; i++) {
+        TEST_ASSERT_EQUAL_INT(expected_depths[i], records[i].depth);
+        TEST_ASSERT_EQUAL_INT(expected_durations[i], static_cast<int>(records[i].getDurationUs()));
+    }
+    TEST_ASSERT_EQUAL_STRING("lcd_begin", records[1].name);
+    TEST_ASSERT_EQUAL_INT(0x11, records[2].arg);
+
+    Profiler::formatRecord(records[2], records[0].start_us, line, sizeof(line));
+    printf("%s\n", line);
+    TEST_ASSERT_NOT_NULL(strstr(line, "    vendor_cmd[0x11]"));
+    TEST_ASSERT_NOT_NULL(strstr(line, "+     200 us"));
+    TEST_ASSERT_NOT_NULL(strstr(line, "     100 us"));
+
+    // An unfinished stage is reported as it is
+    profiler.clear();
+    int unfinished = profiler.begin("unfinished", Profiler::ARG_NONE, 0);
+    TEST_ASSERT_EQUAL_INT(1, profiler.getRecords(records, 8));
+    TEST_ASSERT_EQUAL_INT(-1, static_cast<int>(records[0].getDurationUs()));
+    Profiler::formatRecord(records[0], 0, line, sizeof(line));
+    TEST_ASSERT_NOT_NULL(strstr(line, "unfinished"));
+    profiler.end(unfinished, 10);
+}
+
+TEST_CASE("test profiler to drop records beyond the capacity", "[utils][profiler]")
+{
+    Profiler profiler(2);
+    Profiler::Record records[2];
+
+    int outer = profiler.begin("outer", Profiler::ARG_NONE, 0);
+    profiler.add("first", Profiler::ARG_NONE, 0, 1);
+    // The dropped stage still keeps the depth of the nested ones
+    int dropped = profiler.begin("dropped", Profiler::ARG_NONE, 1);
+    TEST_ASSERT_EQUAL_INT(-1, dropped);
+    profiler.end(dropped, 2);
+    profiler.end(outer, 3);
+
+    TEST_ASSERT_EQUAL_INT(2, profiler.getRecords(records, 2));
+    TEST_ASSERT_EQUAL_INT(1, profiler.getDroppedNum());
+    TEST_ASSERT_EQUAL_INT(1, records[1].depth);
+    TEST_ASSERT_EQUAL_INT(3, static_cast<int>(records[0].getDurationUs()));
+
+    profiler.clear();
+    TEST_ASSERT_EQUAL_INT(0, profiler.getRecordsNum());
+    TEST_ASSERT_EQUAL_INT(0, profiler.getDroppedNum());
+    TEST_ASSERT_EQUAL_INT(0, profiler.begin("new", Profiler::ARG_NONE, 4));
+    profiler.end(0, 5);
+}
+
+TEST_CASE("test profiler to keep the depth per thread", "[utils][profiler]")
+{
+    Profiler profiler;
+    Profiler::Record records[4];
+
+    int board = profiler.begin("board", Profiler::ARG_NONE, 0);
+    std::thread thread([&profiler]() {
+        int task = profiler.begin("task", Profiler::ARG_NONE, 1);
+        profiler.end(task, 2);
+    });
+    thread.join();
+    profiler.end(board, 3);
+
+    TEST_ASSERT_EQUAL_INT(2, profiler.getRecords(records, 4));
+    TEST_ASSERT_EQUAL_INT(0, records[1].depth);
+}
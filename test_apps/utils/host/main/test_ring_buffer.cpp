@@ -0,0 +1,76 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+#include <cstdint>
+#include <thread>
+#include "unity.h"
+#include "utils/esp_panel_utils_ring_buffer.hpp"
+
+using namespace esp_panel::utils;
+
+#define TEST_THREAD_ITEMS   (200000)
+
+struct TestItem {
+    uint32_t sequence;
+    uint32_t check;
+};
+
+TEST_CASE("test ring buffer to push and pop in order", "[utils][ring_buffer]")
+{
+    RingBuffer<int, 4> ring;
+    int item = 0;
+
+    TEST_ASSERT_TRUE(ring.empty());
+    TEST_ASSERT_FALSE(ring.pop(item));
+    for (int i = 0; i < 4; i++) {
+        TEST_ASSERT_TRUE(ring.push(i));
+    }
+    TEST_ASSERT_FALSE(ring.push(4));
+    TEST_ASSERT_EQUAL_INT(4, ring.size());
+
+    // Wrap around the end of the buffer
+    for (int i = 0; i < 10; i++) {
+        TEST_ASSERT_TRUE(ring.pop(item));
+        TEST_ASSERT_EQUAL_INT(i, item);
+        TEST_ASSERT_TRUE(ring.push(i + 4));
+    }
+    TEST_ASSERT_EQUAL_INT(4, ring.size());
+
+    ring.clear();
+    TEST_ASSERT_TRUE(ring.empty());
+    TEST_ASSERT_FALSE(ring.pop(item));
+}
+
+TEST_CASE("test ring buffer with a producer thread and a consumer thread", "[utils][ring_buffer]")
+{
+    RingBuffer<TestItem, 16> ring;
+    uint32_t retry_num = 0;
+
+    std::thread producer([&]() {
+        for (uint32_t i = 0; i < TEST_THREAD_ITEMS; i++) {
+            while (!ring.push({i, ~i})) {
+                retry_num++;
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    uint32_t expected = 0;
+    TestItem item = {};
+    while (expected < TEST_THREAD_ITEMS) {
+        if (!ring.pop(item)) {
+            std::this_thread::yield();
+            continue;
+        }
+        // Every item should arrive once, in order and completely written
+        TEST_ASSERT_EQUAL_UINT32(expected, item.sequence);
+        TEST_ASSERT_EQUAL_UINT32(~expected, item.check);
+        expected++;
+    }
+    producer.join();
+
+    printf("Ring buffer passed %d items, producer retried %d times\n", TEST_THREAD_ITEMS, (int)retry_num);
+    TEST_ASSERT_TRUE(ring.empty());
+}
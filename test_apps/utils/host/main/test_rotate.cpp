@@ -0,0 +1,219 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "unity.h"
+#include "utils/esp_panel_utils_rotate.hpp"
+
+using namespace esp_panel::utils;
+
+#define TEST_BENCHMARK_WIDTH    (800)
+#define TEST_BENCHMARK_HEIGHT   (480)
+#define TEST_BENCHMARK_LOOPS    (20)
+
+static const int test_degrees[] = {0, 90, 180, 270};
+static const int test_bytes_per_pixel[] = {1, 2, 3, 4};
+
+/**
+ * Per-pixel reference, the same as `rotate_copy_pixel()` of the LVGL port
+ */
+static void rotate_reference(
+    const uint8_t *src, uint8_t *dst, int width, int height, int bytes_per_pixel, int degree, int x_start,
+    int y_start, int area_width, int area_height
+)
+{
+    for (int y = y_start; y < y_start + area_height; y++) {
+        for (int x = x_start; x < x_start + area_width; x++) {
+            int to_x = x;
+            int to_y = y;
+            int to_width = width;
+            switch (degree) {
+            case 90:
+                to_x = y;
+                to_y = width - 1 - x;
+                to_width = height;
+                break;
+            case 180:
+                to_x = width - 1 - x;
+                to_y = height - 1 - y;
+                break;
+            case 270:
+                to_x = height - 1 - y;
+                to_y = x;
+                to_width = height;
+                break;
+            default:
+                break;
+            }
+            memcpy(
+                dst + (to_y * to_width + to_x) * bytes_per_pixel, src + (y * width + x) * bytes_per_pixel,
+                bytes_per_pixel
+            );
+        }
+    }
+}
+
+static void check_rotate(
+    int width, int height, int bytes_per_pixel, int degree, int x_start, int y_start, int area_width,
+    int area_height, bool enable_swar
+)
+{
+    size_t size = width * height * bytes_per_pixel;
+    // Keep the buffers word aligned like the frame buffers
+    std::vector<uint32_t> src_words((size + 3) / 4);
+    std::vector<uint32_t> dst_words((size + 3) / 4, 0);
+    std::vector<uint32_t> expected_words((size + 3) / 4, 0);
+    uint8_t *src = reinterpret_cast<uint8_t *>(src_words.data());
+    for (size_t i = 0; i < size; i++) {
+        src[i] = (i * 131) ^ (i >> 8);
+    }
+
+    Rotator rotator({
+        .width = width,
+        .height = height,
+        .bytes_per_pixel = bytes_per_pixel,
+        .degree = degree,
+        .tile_size = Rotator::TILE_SIZE_DEFAULT,
+        .enable_swar = enable_swar,
+    });
+    TEST_ASSERT_TRUE(
+        rotator.copy(src, reinterpret_cast<uint8_t *>(dst_words.data()), x_start, y_start, area_width, area_height)
+    );
+    rotate_reference(
+        src, reinterpret_cast<uint8_t *>(expected_words.data()), width, height, bytes_per_pixel, degree, x_start,
+        y_start, area_width, area_height
+    );
+    if (memcmp(dst_words.data(), expected_words.data(), size) != 0) {
+        printf(
+            "Mismatch: %dx%d, %d bytes per pixel, %d degree, area(%d,%d,%d,%d), kernel(%d)\n", width, height,
+            bytes_per_pixel, degree, x_start, y_start, area_width, area_height,
+            static_cast<int>(rotator.getLastKernel())
+        );
+    }
+    TEST_ASSERT_EQUAL_MEMORY(expected_words.data(), dst_words.data(), size);
+}
+
+TEST_CASE("test rotator to match the per-pixel reference", "[utils][rotate]")
+{
+    for (int bytes_per_pixel : test_bytes_per_pixel) {
+        for (int degree : test_degrees) {
+            for (bool enable_swar : {false, true}) {
+                // Aligned full frame, multiple tiles with a partial one
+                check_rotate(104, 72, bytes_per_pixel, degree, 0, 0, 104, 72, enable_swar);
+                // Aligned area
+                check_rotate(104, 72, bytes_per_pixel, degree, 8, 4, 40, 36, enable_swar);
+                // Unaligned frame and area
+                check_rotate(37, 23, bytes_per_pixel, degree, 3, 5, 29, 17, enable_swar);
+            }
+        }
+    }
+}
+
+TEST_CASE("test rotator to select kernels and check parameters", "[utils][rotate]")
+{
+    std::vector<uint32_t> src(64 * 64);
+    std::vector<uint32_t> dst(64 * 64);
+    auto src_data = reinterpret_cast<const uint8_t *>(src.data());
+    auto dst_data = reinterpret_cast<uint8_t *>(dst.data());
+    Rotator rotator;
+
+    TEST_ASSERT_FALSE(rotator.copy(src_data, dst_data));
+    TEST_ASSERT_FALSE(rotator.setConfig({.width = 64, .height = 64, .bytes_per_pixel = 2, .degree = 45}));
+    TEST_ASSERT_FALSE(rotator.setConfig({.width = 64, .height = 64, .bytes_per_pixel = 5, .degree = 90}));
+    TEST_ASSERT_FALSE(
+        rotator.setConfig({.width = 64, .height = 64, .bytes_per_pixel = 2, .degree = 90, .tile_size = 6})
+    );
+
+    TEST_ASSERT_TRUE(rotator.setConfig({.width = 64, .height = 32, .bytes_per_pixel = 2, .degree = 90}));
+    TEST_ASSERT_EQUAL_INT(32, rotator.getDestWidth());
+    TEST_ASSERT_EQUAL_INT(64, rotator.getDestHeight());
+    TEST_ASSERT_TRUE(rotator.copy(src_data, dst_data));
+    TEST_ASSERT_EQUAL_INT(static_cast<int>(Rotator::Kernel::SWAR), static_cast<int>(rotator.getLastKernel()));
+    TEST_ASSERT_TRUE(rotator.copy(src_data, dst_data, 1, 0, 2, 2));
+    TEST_ASSERT_EQUAL_INT(static_cast<int>(Rotator::Kernel::SCALAR), static_cast<int>(rotator.getLastKernel()));
+    TEST_ASSERT_FALSE(rotator.copy(src_data, dst_data, 60, 0, 8, 8));
+    TEST_ASSERT_FALSE(rotator.copy(nullptr, dst_data));
+}
+
+TEST_CASE("test rotator to convert areas", "[utils][rotate]")
+{
+    const int width = 40;
+    const int height = 30;
+    const int x_start = 3;
+    const int y_start = 5;
+    const int area_width = 10;
+    const int area_height = 7;
+    std::vector<uint8_t> src(width * height, 0);
+    std::vector<uint8_t> dst(width * height, 0);
+    for (int y = y_start; y < y_start + area_height; y++) {
+        memset(src.data() + y * width + x_start, 1, area_width);
+    }
+
+    for (int degree : test_degrees) {
+        Rotator rotator({.width = width, .height = height, .bytes_per_pixel = 1, .degree = degree});
+        TEST_ASSERT_TRUE(rotator.copy(src.data(), dst.data()));
+
+        // The converted area should hold exactly the copied pixels
+        int x = x_start;
+        int y = y_start;
+        int w = area_width;
+        int h = area_height;
+        rotator.rotateArea(x, y, w, h);
+        int marked_num = 0;
+        for (int i = 0; i < rotator.getDestHeight(); i++) {
+            for (int j = 0; j < rotator.getDestWidth(); j++) {
+                bool is_inside = (j >= x) && (j < x + w) && (i >= y) && (i < y + h);
+                TEST_ASSERT_EQUAL_INT(is_inside ? 1 : 0, dst[i * rotator.getDestWidth() + j]);
+                marked_num += is_inside ? 1 : 0;
+            }
+        }
+        TEST_ASSERT_EQUAL_INT(area_width * area_height, marked_num);
+    }
+}
+
+TEST_CASE("test rotator benchmark", "[utils][rotate][benchmark]")
+{
+    size_t size = TEST_BENCHMARK_WIDTH * TEST_BENCHMARK_HEIGHT * 4;
+    std::vector<uint32_t> src(size / 4);
+    std::vector<uint32_t> dst(size / 4);
+    auto src_data = reinterpret_cast<const uint8_t *>(src.data());
+    auto dst_data = reinterpret_cast<uint8_t *>(dst.data());
+    double pixels = static_cast<double>(TEST_BENCHMARK_WIDTH) * TEST_BENCHMARK_HEIGHT * TEST_BENCHMARK_LOOPS;
+
+    printf("Rotate %dx%d, MPixel/s (reference / tiled):\n", TEST_BENCHMARK_WIDTH, TEST_BENCHMARK_HEIGHT);
+    printf("%-6s %18s %18s %18s %18s\n", "bpp", "0", "90", "180", "270");
+    for (int bytes_per_pixel : test_bytes_per_pixel) {
+        printf("%-6d", bytes_per_pixel * 8);
+        for (int degree : test_degrees) {
+            Rotator rotator({
+                .width = TEST_BENCHMARK_WIDTH,
+                .height = TEST_BENCHMARK_HEIGHT,
+                .bytes_per_pixel = bytes_per_pixel,
+                .degree = degree,
+            });
+
+            auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < TEST_BENCHMARK_LOOPS; i++) {
+                rotate_reference(
+                    src_data, dst_data, TEST_BENCHMARK_WIDTH, TEST_BENCHMARK_HEIGHT, bytes_per_pixel, degree, 0, 0,
+                    TEST_BENCHMARK_WIDTH, TEST_BENCHMARK_HEIGHT
+                );
+            }
+            std::chrono::duration<double, std::micro> reference_us = std::chrono::steady_clock::now() - start;
+
+            start = std::chrono::steady_clock::now();
+            for (int i = 0; i < TEST_BENCHMARK_LOOPS; i++) {
+                TEST_ASSERT_TRUE(rotator.copy(src_data, dst_data));
+            }
+            std::chrono::duration<double, std::micro> tiled_us = std::chrono::steady_clock::now() - start;
+
+            printf(" %8.1f / %7.1f", pixels / reference_us.count(), pixels / tiled_us.count());
+        }
+        printf("\n");
+    }
+}
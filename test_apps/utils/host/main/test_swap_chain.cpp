@@ -0,0 +1,140 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include "unity.h"
+#include "utils/esp_panel_utils_swap_chain.hpp"
+
+using namespace esp_panel::utils;
+
+#define TEST_FRAME_NUM              (20000)
+
+using PresentMode = SwapChain::PresentMode;
+
+TEST_CASE("test swap chain with FIFO mode", "[utils][swap_chain]")
+{
+    SwapChain chain;
+
+    TEST_ASSERT_FALSE(chain.setConfig({.buffer_num = 1}));
+    TEST_ASSERT_FALSE(chain.setConfig({.buffer_num = 4}));
+    TEST_ASSERT_FALSE(chain.setConfig({.buffer_num = 2, .front_index = 2}));
+    TEST_ASSERT_TRUE(chain.setConfig({.buffer_num = 3}));
+    TEST_ASSERT_EQUAL_INT(2, chain.getFreeNum());
+
+    // The front buffer is never acquired
+    int first = chain.acquire();
+    int second = chain.acquire();
+    TEST_ASSERT_EQUAL_INT(1, first);
+    TEST_ASSERT_EQUAL_INT(2, second);
+    TEST_ASSERT_EQUAL_INT(-1, chain.acquire());
+    TEST_ASSERT_FALSE(chain.present(0));
+
+    TEST_ASSERT_TRUE(chain.present(first));
+    TEST_ASSERT_EQUAL_INT(first, chain.getPendingIndex());
+    // Only one buffer can be pending
+    TEST_ASSERT_FALSE(chain.canPresent());
+    TEST_ASSERT_FALSE(chain.present(second));
+    TEST_ASSERT_EQUAL_INT(-1, chain.acquire());
+
+    TEST_ASSERT_TRUE(chain.notifyRefresh());
+    TEST_ASSERT_FALSE(chain.notifyRefresh());
+    TEST_ASSERT_EQUAL_INT(first, chain.getFrontIndex());
+    TEST_ASSERT_EQUAL_INT(0, chain.acquire());
+    TEST_ASSERT_TRUE(chain.present(second));
+    TEST_ASSERT_TRUE(chain.release(0));
+    TEST_ASSERT_FALSE(chain.release(0));
+    TEST_ASSERT_TRUE(chain.notifyRefresh());
+    TEST_ASSERT_EQUAL_INT(second, chain.getFrontIndex());
+    TEST_ASSERT_EQUAL_INT(2, chain.getFreeNum());
+    TEST_ASSERT_EQUAL_UINT32(2, chain.getShownNum());
+    TEST_ASSERT_EQUAL_UINT32(0, chain.getDroppedNum());
+}
+
+TEST_CASE("test swap chain with mailbox mode", "[utils][swap_chain]")
+{
+    SwapChain chain({.buffer_num = 3, .mode = PresentMode::MAILBOX});
+    int replaced_index = 0;
+
+    int first = chain.acquire();
+    TEST_ASSERT_TRUE(chain.present(first, &replaced_index));
+    TEST_ASSERT_EQUAL_INT(-1, replaced_index);
+
+    // The pending buffer is replaced, and released at the next refresh since it might have been latched
+    TEST_ASSERT_TRUE(chain.canPresent());
+    int second = chain.acquire();
+    TEST_ASSERT_TRUE(chain.present(second, &replaced_index));
+    TEST_ASSERT_EQUAL_INT(first, replaced_index);
+    TEST_ASSERT_EQUAL_INT(-1, chain.acquire());
+    TEST_ASSERT_EQUAL_UINT32(1, chain.getDroppedNum());
+
+    TEST_ASSERT_TRUE(chain.notifyRefresh());
+    TEST_ASSERT_EQUAL_INT(second, chain.getFrontIndex());
+    TEST_ASSERT_EQUAL_INT(2, chain.getFreeNum());
+    TEST_ASSERT_EQUAL_UINT32(1, chain.getShownNum());
+}
+
+static void run_with_refresh_thread(PresentMode mode, int buffer_num)
+{
+    SwapChain chain({.buffer_num = buffer_num, .mode = mode});
+    // Buffer switched to by the application and buffer scanned by the panel, the switch is latched by the refresh
+    std::atomic<int> switched_index = 0;
+    std::atomic<int> scanned_index = 0;
+    std::atomic<int> latched_num = 0;
+    std::atomic<bool> is_running = true;
+    std::atomic<int> error_num = 0;
+
+    // Simulate the refresh ISR, the last frame has been scanned before the event, and the switched buffer is latched
+    // right after it
+    std::thread refresher([&]() {
+        while (is_running) {
+            scanned_index = -1;
+            chain.notifyRefresh();
+            scanned_index = switched_index.load();
+            latched_num++;
+            std::this_thread::sleep_for(std::chrono::microseconds(20));
+        }
+    });
+
+    for (int i = 0; i < TEST_FRAME_NUM; i++) {
+        int index = -1;
+        while ((index = chain.acquire()) < 0) {
+            std::this_thread::yield();
+        }
+        // The acquired buffer should be neither scanned nor latched by the next refresh
+        if ((index == scanned_index) || (index == switched_index)) {
+            error_num++;
+        }
+        // Sometimes race with the refresh
+        if ((i % 3) == 0) {
+            for (int start = latched_num; start == latched_num;) {
+                std::this_thread::yield();
+            }
+        }
+        while (!chain.canPresent()) {
+            std::this_thread::yield();
+        }
+        switched_index = index;
+        TEST_ASSERT_TRUE(chain.present(index));
+    }
+    is_running = false;
+    refresher.join();
+
+    TEST_ASSERT_EQUAL_INT(0, error_num.load());
+    if (mode == PresentMode::FIFO) {
+        TEST_ASSERT_EQUAL_UINT32(0, chain.getDroppedNum());
+    }
+    TEST_ASSERT_EQUAL_UINT32(static_cast<uint32_t>(TEST_FRAME_NUM), chain.getShownNum() + chain.getDroppedNum() +
+                             ((chain.getPendingIndex() >= 0) ? 1 : 0));
+}
+
+TEST_CASE("test swap chain with a refresh thread", "[utils][swap_chain]")
+{
+    for (int buffer_num = 2; buffer_num <= SwapChain::BUFFER_NUM_MAX; buffer_num++) {
+        run_with_refresh_thread(PresentMode::FIFO, buffer_num);
+        run_with_refresh_thread(PresentMode::MAILBOX, buffer_num);
+    }
+}
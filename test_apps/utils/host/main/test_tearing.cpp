@@ -0,0 +1,149 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include "unity.h"
+#include "utils/esp_panel_utils_tearing.hpp"
+
+using namespace esp_panel::utils;
+
+#define TEST_HEIGHT                 (466)
+#define TEST_BLANK_LINES            (20)
+#define TEST_PERIOD_US              (16667)
+#define TEST_TE_US                  (1000000)
+#define TEST_SCHEDULE_NUM           (2000)
+
+using WriteOrder = TearingScheduler::WriteOrder;
+
+/**
+ * @brief Get the index of the scan period before which the line is written, `-1000` if the scan is in the writing
+ */
+static int get_scan_period(
+    const TearingScheduler::Config &config, uint32_t te_us, double start, double begin, double end, int line
+)
+{
+    int total_lines = config.height + config.blank_lines;
+    int te_line = (config.te_line < 0) ? config.height : config.te_line;
+    double line_time = static_cast<double>(TEST_PERIOD_US) / total_lines;
+    double scan = te_us + ((total_lines - te_line) % total_lines) * line_time + line * line_time;
+    int k = static_cast<int>(std::ceil((start + end - scan) / TEST_PERIOD_US));
+
+    return (scan + (k - 1) * TEST_PERIOD_US <= start + begin) ? k : -1000;
+}
+
+static void run_schedules(const TearingScheduler::Config &config, WriteOrder order)
+{
+    TearingScheduler scheduler(config);
+    int tear_free_num = 0;
+
+    TEST_ASSERT_FALSE(scheduler.isReady());
+    TEST_ASSERT_EQUAL_UINT32(123, scheduler.schedule(0, 10, 1000, 123, order).start_us);
+    for (int i = 0; i < 4; i++) {
+        scheduler.notifyTE(TEST_TE_US + i * TEST_PERIOD_US);
+    }
+    scheduler.notifyTransfer(40 * 1000, 1000);
+    TEST_ASSERT_TRUE(scheduler.isReady());
+    TEST_ASSERT_UINT32_WITHIN(1, TEST_PERIOD_US, scheduler.getPeriodUs());
+
+    uint32_t te_us = TEST_TE_US + 3 * TEST_PERIOD_US;
+    srand(static_cast<int>(order) + config.te_line);
+    for (int i = 0; i < TEST_SCHEDULE_NUM; i++) {
+        int height = 1 + rand() % TEST_HEIGHT;
+        int y_start = rand() % (TEST_HEIGHT - height + 1);
+        uint32_t bytes = height * (1 + rand() % 466) * 2;
+        uint32_t now_us = te_us + rand() % TEST_PERIOD_US;
+        auto plan = scheduler.schedule(y_start, height, bytes, now_us, order);
+
+        TEST_ASSERT_TRUE(static_cast<int32_t>(plan.start_us - now_us) >= 0);
+        TEST_ASSERT_TRUE(static_cast<int32_t>(plan.start_us - now_us) <= 2 * TEST_PERIOD_US);
+        if (!plan.is_tear_free) {
+            continue;
+        }
+        tear_free_num++;
+
+        // Every line should be written between the same two scans of it
+        double write_time = static_cast<double>(bytes) / height / scheduler.getBytesPerUs();
+        int period = 0;
+        for (int r = y_start; r < y_start + height; r++) {
+            double begin = (order == WriteOrder::TOP_TO_BOTTOM) ? (r - y_start) * write_time :
+                          (order == WriteOrder::BOTTOM_TO_TOP) ? (y_start + height - 1 - r) * write_time : 0;
+            double end = (order == WriteOrder::COLUMNS) ? height * write_time : begin + write_time;
+            int k = get_scan_period(config, te_us, plan.start_us, begin, end, r);
+            TEST_ASSERT_NOT_EQUAL(-1000, k);
+            if (r == y_start) {
+                period = k;
+            }
+            TEST_ASSERT_EQUAL_INT(period, k);
+        }
+    }
+    printf(
+        "Tearing order(%d), te_line(%d): %d/%d tear-free\n", static_cast<int>(order), config.te_line, tear_free_num,
+        TEST_SCHEDULE_NUM
+    );
+    TEST_ASSERT_GREATER_THAN_INT(TEST_SCHEDULE_NUM / 2, tear_free_num);
+    TEST_ASSERT_EQUAL_UINT32(static_cast<uint32_t>(TEST_SCHEDULE_NUM - tear_free_num), scheduler.getTearingNum());
+}
+
+TEST_CASE("test tearing scheduler to write between the scans", "[utils][tearing]")
+{
+    for (int te_line : {-1, 0, 200}) {
+        for (auto order : {WriteOrder::TOP_TO_BOTTOM, WriteOrder::BOTTOM_TO_TOP, WriteOrder::COLUMNS}) {
+            // The margin covers the rounding of the start time
+            run_schedules({
+                .height = TEST_HEIGHT,
+                .blank_lines = TEST_BLANK_LINES,
+                .te_line = te_line,
+                .margin_lines = 1,
+            }, order);
+        }
+    }
+}
+
+TEST_CASE("test tearing scheduler to learn the period and the speed", "[utils][tearing]")
+{
+    TearingScheduler scheduler;
+
+    TEST_ASSERT_FALSE(scheduler.setConfig({.height = 0}));
+    TEST_ASSERT_FALSE(scheduler.setConfig({.height = TEST_HEIGHT, .period_us = 1000}));
+    TEST_ASSERT_TRUE(scheduler.setConfig({.height = TEST_HEIGHT}));
+
+    // The jitters are filtered, and the missed signals are ignored
+    uint32_t time_us = TEST_TE_US;
+    for (int i = 0; i < 200; i++) {
+        time_us += TEST_PERIOD_US + ((i % 2) ? 50 : -50) + (((i % 50) == 25) ? TEST_PERIOD_US : 0);
+        scheduler.notifyTE(time_us);
+    }
+    TEST_ASSERT_UINT32_WITHIN(60, TEST_PERIOD_US, scheduler.getPeriodUs());
+
+    scheduler.notifyTransfer(10000, 1000);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 10.0f, scheduler.getBytesPerUs());
+    scheduler.notifyTransfer(20000, 1000);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 12.5f, scheduler.getBytesPerUs());
+
+    // The stale signal is not used
+    auto plan = scheduler.schedule(0, 10, 1000, time_us + 10 * TEST_PERIOD_US);
+    TEST_ASSERT_FALSE(plan.is_tear_free);
+    TEST_ASSERT_EQUAL_UINT32(time_us + 10 * TEST_PERIOD_US, plan.start_us);
+}
+
+TEST_CASE("test tearing scheduler to follow the scanline for slow bus", "[utils][tearing]")
+{
+    TearingScheduler scheduler({.height = TEST_HEIGHT, .margin_lines = 0, .period_us = TEST_PERIOD_US});
+
+    scheduler.notifyTE(TEST_TE_US);
+    // A full frame takes two periods
+    scheduler.notifyTransfer(TEST_HEIGHT * 466 * 2, 2 * TEST_PERIOD_US);
+    auto plan = scheduler.schedule(0, TEST_HEIGHT, TEST_HEIGHT * 466 * 2, TEST_TE_US + 100);
+    TEST_ASSERT_FALSE(plan.is_tear_free);
+    TEST_ASSERT_EQUAL_UINT32(1, scheduler.getTearingNum());
+    // The line `0` is scanned right after the TE signal, which is the start of the blanking without blank lines
+    TEST_ASSERT_UINT32_WITHIN(1, TEST_TE_US + TEST_PERIOD_US, plan.start_us);
+
+    // A small area is written right after it's scanned
+    plan = scheduler.schedule(TEST_HEIGHT / 2, 10, 10 * 466 * 2, TEST_TE_US + 100);
+    TEST_ASSERT_TRUE(plan.is_tear_free);
+}
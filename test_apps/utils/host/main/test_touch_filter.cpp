@@ -0,0 +1,156 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+#include <cstdio>
+#include <cstdlib>
+#include "unity.h"
+#include "utils/esp_panel_utils_touch_filter.hpp"
+
+using namespace esp_panel::utils;
+
+#define TEST_SAMPLE_INTERVAL_US (10 * 1000)
+
+/**
+ * Filter a single point in place
+ */
+static void process_point(TouchFilter &filter, int &x, int &y, int64_t timestamp_us)
+{
+    filter.process(&x, &y, 1, timestamp_us);
+}
+
+TEST_CASE("test touch filter to pass through without stages", "[utils][touch_filter]")
+{
+    TouchFilter filter;
+    int x[3] = {10, 200, 5};
+    int y[3] = {20, 100, 7};
+
+    filter.process(x, y, 3, 0);
+    TEST_ASSERT_EQUAL_INT(10, x[0]);
+    TEST_ASSERT_EQUAL_INT(100, y[1]);
+    filter.process(x, y, 3, TEST_SAMPLE_INTERVAL_US);
+    TEST_ASSERT_EQUAL_INT(200, x[1]);
+    TEST_ASSERT_EQUAL_INT(7, y[2]);
+
+    TEST_ASSERT_FALSE(filter.setConfig({.median_window = 4}));
+    TEST_ASSERT_FALSE(filter.setConfig({.median_window = TouchFilter::MEDIAN_WINDOW_MAX + 2}));
+    TEST_ASSERT_FALSE(filter.setConfig({.smooth_weight = 0}));
+    TEST_ASSERT_FALSE(filter.setConfig({.dead_zone = -1}));
+    TEST_ASSERT_FALSE(filter.setConfig({.reset_interval_ms = 0}));
+}
+
+TEST_CASE("test touch filter to remove spikes by median", "[utils][touch_filter]")
+{
+    TouchFilter filter({.median_window = 3});
+    const int inputs[] = {100, 100, 180, 100, 102, 104, 20, 106};
+    const int expected[] = {100, 100, 100, 100, 102, 102, 102, 104};
+
+    for (int i = 0; i < static_cast<int>(sizeof(inputs) / sizeof(inputs[0])); i++) {
+        int x = inputs[i];
+        int y = 50;
+        process_point(filter, x, y, i * TEST_SAMPLE_INTERVAL_US);
+        TEST_ASSERT_EQUAL_INT(expected[i], x);
+        TEST_ASSERT_EQUAL_INT(50, y);
+    }
+}
+
+TEST_CASE("test touch filter to reduce noise by smoothing", "[utils][touch_filter]")
+{
+    TouchFilter filter({.smooth_weight = TouchFilter::FIXED_ONE / 4});
+    long input_error = 0;
+    long output_error = 0;
+
+    srand(1);
+    for (int i = 0; i < 200; i++) {
+        int noise = rand() % 9 - 4;
+        int x = 300 + noise;
+        int y = 300;
+        process_point(filter, x, y, i * TEST_SAMPLE_INTERVAL_US);
+        if (i >= 20) {
+            input_error += abs(noise);
+            output_error += abs(x - 300);
+        }
+    }
+    TEST_ASSERT_TRUE(output_error * 2 < input_error);
+
+    // Converge to a new position
+    int x = 0;
+    int y = 0;
+    for (int i = 0; i < 40; i++) {
+        x = 400;
+        y = 300;
+        process_point(filter, x, y, (200 + i) * TEST_SAMPLE_INTERVAL_US);
+    }
+    TEST_ASSERT_INT_WITHIN(1, 400, x);
+}
+
+TEST_CASE("test touch filter to hold still points in the dead zone", "[utils][touch_filter]")
+{
+    TouchFilter filter({.dead_zone = 3});
+    const int jitters[] = {0, 2, -3, 1, 3, -2, 0};
+
+    for (int i = 0; i < static_cast<int>(sizeof(jitters) / sizeof(jitters[0])); i++) {
+        int x = 100 + jitters[i];
+        int y = 100 - jitters[i];
+        process_point(filter, x, y, i * TEST_SAMPLE_INTERVAL_US);
+        TEST_ASSERT_EQUAL_INT(100, x);
+        TEST_ASSERT_EQUAL_INT(100, y);
+    }
+
+    // The output is dragged by the edge of the zone when moving
+    int x = 110;
+    int y = 100;
+    process_point(filter, x, y, 10 * TEST_SAMPLE_INTERVAL_US);
+    TEST_ASSERT_EQUAL_INT(107, x);
+    TEST_ASSERT_EQUAL_INT(100, y);
+}
+
+TEST_CASE("test touch filter to predict moving points", "[utils][touch_filter]")
+{
+    const int prediction_ms = 20;
+    // 0.5 pixels per millisecond along X, 0.25 along Y
+    auto get_x = [](int64_t time_us) {
+        return static_cast<int>(50 + time_us / 2000);
+    };
+    auto get_y = [](int64_t time_us) {
+        return static_cast<int>(400 - time_us / 4000);
+    };
+
+    for (auto prediction : {TouchFilter::Prediction::LINEAR, TouchFilter::Prediction::ALPHA_BETA}) {
+        TouchFilter filter({.prediction = prediction, .prediction_ms = prediction_ms, .x_max = 480, .y_max = 480});
+        int x = 0;
+        int y = 0;
+        int64_t time_us = 0;
+        for (int i = 0; i < 60; i++) {
+            time_us = i * TEST_SAMPLE_INTERVAL_US;
+            x = get_x(time_us);
+            y = get_y(time_us);
+            process_point(filter, x, y, time_us);
+        }
+        int64_t future_us = time_us + prediction_ms * 1000;
+        printf(
+            "Prediction(%d): (%d, %d), expected (%d, %d)\n", static_cast<int>(prediction), x, y, get_x(future_us),
+            get_y(future_us)
+        );
+        TEST_ASSERT_INT_WITHIN(1, get_x(future_us), x);
+        TEST_ASSERT_INT_WITHIN(1, get_y(future_us), y);
+
+        // The prediction is clamped to the range
+        for (int i = 60; i < 120; i++) {
+            time_us = i * TEST_SAMPLE_INTERVAL_US;
+            x = 479;
+            y = 0;
+            process_point(filter, x, y, time_us);
+            TEST_ASSERT_TRUE((x >= 0) && (x < 480) && (y >= 0) && (y < 480));
+        }
+
+        // A released point restarts without the old velocity
+        filter.process(nullptr, nullptr, 0, time_us);
+        x = 200;
+        y = 200;
+        process_point(filter, x, y, time_us + TEST_SAMPLE_INTERVAL_US);
+        TEST_ASSERT_EQUAL_INT(200, x);
+        TEST_ASSERT_EQUAL_INT(200, y);
+    }
+}